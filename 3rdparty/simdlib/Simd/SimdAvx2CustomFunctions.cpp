@@ -0,0 +1,160 @@
+/*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdBase.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX2_ENABLE
+    namespace Avx2
+    {
+        // Columns [0, N4) are processed 4 by 4, [N4, N2) 2 by 2 and [N2, N) one by one
+        template <size_t N> void ComputeAtWA(const double * A, size_t rows, const double * w, double * dst)
+        {
+            const size_t N4 = N / 4 * 4;
+            const size_t N2 = N4 + (N - N4) / 2 * 2;
+            const size_t B4 = N4 / 4 > 0 ? N4 / 4 : 1;
+
+            // Only the blocks containing the upper triangle are accumulated
+            __m256d sum4[N][B4];
+            __m128d sum2[N];
+            double sum1[N];
+            for (size_t i = 0; i < N; i++) {
+                for (size_t b = 0; b < B4; b++) {
+                    sum4[i][b] = _mm256_setzero_pd();
+                }
+                sum2[i] = _mm_setzero_pd();
+                sum1[i] = 0;
+            }
+
+            for (size_t k = 0; k < rows; k++) {
+                const double * a = A + k*N;
+                const double wk = w ? w[k] : 1.0;
+
+                __m256d a4[B4];
+                for (size_t b = 0; b < N4 / 4; b++) {
+                    a4[b] = _mm256_loadu_pd(a + 4*b);
+                }
+                const __m128d a2 = N2 > N4 ? _mm_loadu_pd(a + N4) : _mm_setzero_pd();
+
+                for (size_t i = 0; i < N; i++) {
+                    const double wa = wk * a[i];
+                    const __m256d v_wa = _mm256_set1_pd(wa);
+                    for (size_t b = i / 4; b < N4 / 4; b++) {
+                        sum4[i][b] = _mm256_fmadd_pd(v_wa, a4[b], sum4[i][b]);
+                    }
+                    if (N2 > N4 && i < N2) {
+                        sum2[i] = _mm_fmadd_pd(_mm256_castpd256_pd128(v_wa), a2, sum2[i]);
+                    }
+                    if (N > N2) {
+                        sum1[i] += wa * a[N - 1];
+                    }
+                }
+            }
+
+            double AtA[N*N];
+            for (size_t i = 0; i < N; i++) {
+                for (size_t b = i / 4; b < N4 / 4; b++) {
+                    _mm256_storeu_pd(AtA + i*N + 4*b, sum4[i][b]);
+                }
+                if (N2 > N4 && i < N2) {
+                    _mm_storeu_pd(AtA + i*N + N4, sum2[i]);
+                }
+                if (N > N2) {
+                    AtA[i*N + N - 1] = sum1[i];
+                }
+            }
+            _mm256_zeroupper();
+
+            for (size_t i = 0; i < N; i++) {
+                for (size_t j = i; j < N; j++) {
+                    dst[i*N + j] = dst[j*N + i] = AtA[i*N + j];
+                }
+            }
+        }
+
+        void SimdComputeAtWA(const double * A, size_t rows, size_t cols, const double * w, double * dst)
+        {
+            switch (cols) {
+            case 3: ComputeAtWA<3>(A, rows, w, dst); break;
+            case 4: ComputeAtWA<4>(A, rows, w, dst); break;
+            case 6: ComputeAtWA<6>(A, rows, w, dst); break;
+            case 8: ComputeAtWA<8>(A, rows, w, dst); break;
+            default: Base::SimdComputeAtWA(A, rows, cols, w, dst); break;
+            }
+        }
+
+        template <size_t N> void ComputeAtWb(const double * A, size_t rows, const double * w, const double * b, double * dst)
+        {
+            const size_t N4 = N / 4 * 4;
+            const size_t N2 = N4 + (N - N4) / 2 * 2;
+            const size_t B4 = N4 / 4 > 0 ? N4 / 4 : 1;
+
+            __m256d sum4[B4];
+            for (size_t j = 0; j < B4; j++) {
+                sum4[j] = _mm256_setzero_pd();
+            }
+            __m128d sum2 = _mm_setzero_pd();
+            double sum1 = 0;
+
+            for (size_t k = 0; k < rows; k++) {
+                const double * a = A + k*N;
+                const double wb = w ? w[k] * b[k] : b[k];
+                const __m256d v_wb = _mm256_set1_pd(wb);
+                for (size_t j = 0; j < N4 / 4; j++) {
+                    sum4[j] = _mm256_fmadd_pd(_mm256_loadu_pd(a + 4*j), v_wb, sum4[j]);
+                }
+                if (N2 > N4) {
+                    sum2 = _mm_fmadd_pd(_mm_loadu_pd(a + N4), _mm256_castpd256_pd128(v_wb), sum2);
+                }
+                if (N > N2) {
+                    sum1 += a[N - 1] * wb;
+                }
+            }
+
+            for (size_t j = 0; j < N4 / 4; j++) {
+                _mm256_storeu_pd(dst + 4*j, sum4[j]);
+            }
+            if (N2 > N4) {
+                _mm_storeu_pd(dst + N4, sum2);
+            }
+            if (N > N2) {
+                dst[N - 1] = sum1;
+            }
+            _mm256_zeroupper();
+        }
+
+        void SimdComputeAtWb(const double * A, size_t rows, size_t cols, const double * w, const double * b, double * dst)
+        {
+            switch (cols) {
+            case 3: ComputeAtWb<3>(A, rows, w, b, dst); break;
+            case 4: ComputeAtWb<4>(A, rows, w, b, dst); break;
+            case 6: ComputeAtWb<6>(A, rows, w, b, dst); break;
+            case 8: ComputeAtWb<8>(A, rows, w, b, dst); break;
+            default: Base::SimdComputeAtWb(A, rows, cols, w, b, dst); break;
+            }
+        }
+    }
+#else
+    // Work arround to avoid warning: libvisp_simdlib.a(SimdAvx2CustomFunctions.cpp.o) has no symbols
+    void dummy_SimdAvx2CustomFunctions(){};
+#endif// SIMD_AVX2_ENABLE
+}
@@ -136,6 +136,10 @@ namespace Simd
                        const int * mapU, const int * mapV, const float * mapDu, const float * mapDv, unsigned char * dst);
 
         void SimdComputeJtR(const double * J, size_t rows, const double * R, double * dst);
+
+        void SimdComputeAtWA(const double * A, size_t rows, size_t cols, const double * w, double * dst);
+
+        void SimdComputeAtWb(const double * A, size_t rows, size_t cols, const double * w, const double * b, double * dst);
     }
 }
 #endif//__SimdBase_h__
@@ -262,5 +262,94 @@ namespace Simd
                 dst[i] = ssum;
             }
         }
+
+        template <size_t N> void ComputeAtWA(const double * A, size_t rows, const double * w, double * dst)
+        {
+            double sum[N][N] = {};
+            for (size_t k = 0; k < rows; k++) {
+                const double * a = A + k*N;
+                const double wk = w ? w[k] : 1.0;
+                for (size_t i = 0; i < N; i++) {
+                    const double wa = wk * a[i];
+                    for (size_t j = i; j < N; j++) {
+                        sum[i][j] += wa * a[j];
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < N; i++) {
+                for (size_t j = i; j < N; j++) {
+                    dst[i*N + j] = dst[j*N + i] = sum[i][j];
+                }
+            }
+        }
+
+        void SimdComputeAtWA(const double * A, size_t rows, size_t cols, const double * w, double * dst)
+        {
+            switch (cols) {
+            case 3: ComputeAtWA<3>(A, rows, w, dst); return;
+            case 4: ComputeAtWA<4>(A, rows, w, dst); return;
+            case 6: ComputeAtWA<6>(A, rows, w, dst); return;
+            case 8: ComputeAtWA<8>(A, rows, w, dst); return;
+            default: break;
+            }
+
+            for (size_t i = 0; i < cols*cols; i++) {
+                dst[i] = 0;
+            }
+            for (size_t k = 0; k < rows; k++) {
+                const double * a = A + k*cols;
+                const double wk = w ? w[k] : 1.0;
+                for (size_t i = 0; i < cols; i++) {
+                    const double wa = wk * a[i];
+                    for (size_t j = i; j < cols; j++) {
+                        dst[i*cols + j] += wa * a[j];
+                    }
+                }
+            }
+            for (size_t i = 0; i < cols; i++) {
+                for (size_t j = 0; j < i; j++) {
+                    dst[i*cols + j] = dst[j*cols + i];
+                }
+            }
+        }
+
+        template <size_t N> void ComputeAtWb(const double * A, size_t rows, const double * w, const double * b, double * dst)
+        {
+            double sum[N] = {};
+            for (size_t k = 0; k < rows; k++) {
+                const double * a = A + k*N;
+                const double wb = w ? w[k] * b[k] : b[k];
+                for (size_t i = 0; i < N; i++) {
+                    sum[i] += a[i] * wb;
+                }
+            }
+
+            for (size_t i = 0; i < N; i++) {
+                dst[i] = sum[i];
+            }
+        }
+
+        void SimdComputeAtWb(const double * A, size_t rows, size_t cols, const double * w, const double * b, double * dst)
+        {
+            switch (cols) {
+            case 3: ComputeAtWb<3>(A, rows, w, b, dst); return;
+            case 4: ComputeAtWb<4>(A, rows, w, b, dst); return;
+            case 6: ComputeAtWb<6>(A, rows, w, b, dst); return;
+            case 8: ComputeAtWb<8>(A, rows, w, b, dst); return;
+            default: break;
+            }
+
+            for (size_t i = 0; i < cols; i++) {
+                dst[i] = 0;
+            }
+            for (size_t k = 0; k < rows; k++) {
+                const double * a = A + k*cols;
+                const double wb = w ? w[k] * b[k] : b[k];
+                for (size_t i = 0; i < cols; i++) {
+                    dst[i] += a[i] * wb;
+                }
+            }
+        }
     }
 }
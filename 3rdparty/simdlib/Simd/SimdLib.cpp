@@ -896,3 +896,33 @@ SIMD_API void SimdComputeJtR(const double * J, size_t rows, const double * R, do
 #endif
         Base::SimdComputeJtR(J, rows, R, dst);
 }
+
+SIMD_API void SimdComputeAtWA(const double * A, size_t rows, size_t cols, const double * w, double * dst)
+{
+#ifdef SIMD_AVX2_ENABLE
+    if (Avx2::Enable && (cols == 3 || cols == 4 || cols == 6 || cols == 8))
+        Avx2::SimdComputeAtWA(A, rows, cols, w, dst);
+    else
+#endif
+#if defined(SIMD_NEON_ENABLE) && defined(SIMD_ARM64_ENABLE)
+    if (Neon::Enable && (cols == 3 || cols == 4 || cols == 6 || cols == 8))
+        Neon::SimdComputeAtWA(A, rows, cols, w, dst);
+    else
+#endif
+        Base::SimdComputeAtWA(A, rows, cols, w, dst);
+}
+
+SIMD_API void SimdComputeAtWb(const double * A, size_t rows, size_t cols, const double * w, const double * b, double * dst)
+{
+#ifdef SIMD_AVX2_ENABLE
+    if (Avx2::Enable && (cols == 3 || cols == 4 || cols == 6 || cols == 8))
+        Avx2::SimdComputeAtWb(A, rows, cols, w, b, dst);
+    else
+#endif
+#if defined(SIMD_NEON_ENABLE) && defined(SIMD_ARM64_ENABLE)
+    if (Neon::Enable && (cols == 3 || cols == 4 || cols == 6 || cols == 8))
+        Neon::SimdComputeAtWb(A, rows, cols, w, b, dst);
+    else
+#endif
+        Base::SimdComputeAtWb(A, rows, cols, w, b, dst);
+}
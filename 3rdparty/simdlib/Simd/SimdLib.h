@@ -1215,6 +1215,12 @@ extern "C"
     // vpMbTracker::computeJTR(const vpMatrix &interaction, const vpColVector &error, vpColVector &JTR)
     SIMD_API void SimdComputeJtR(const double * J, size_t rows, const double * R, double * dst);
 
+    // vpMatrix::AtA(), dst = A^T diag(w) A with w optional (NULL)
+    SIMD_API void SimdComputeAtWA(const double * A, size_t rows, size_t cols, const double * w, double * dst);
+
+    // vpMatrix::Atb(), dst = A^T diag(w) b with w optional (NULL)
+    SIMD_API void SimdComputeAtWb(const double * A, size_t rows, size_t cols, const double * w, const double * b, double * dst);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
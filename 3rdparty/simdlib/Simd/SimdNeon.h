@@ -95,6 +95,12 @@ namespace Simd
 
         void StretchGray2x2(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcStride,
             uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstStride);
+
+#ifdef SIMD_ARM64_ENABLE
+        void SimdComputeAtWA(const double * A, size_t rows, size_t cols, const double * w, double * dst);
+
+        void SimdComputeAtWb(const double * A, size_t rows, size_t cols, const double * w, const double * b, double * dst);
+#endif
     }
 #endif// SIMD_NEON_ENABLE
 }
@@ -0,0 +1,138 @@
+/*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdBase.h"
+
+namespace Simd
+{
+#if defined(SIMD_NEON_ENABLE) && defined(SIMD_ARM64_ENABLE)
+    namespace Neon
+    {
+        // Columns [0, N2) are processed 2 by 2 and the last one, if any, alone
+        template <size_t N> void ComputeAtWA(const double * A, size_t rows, const double * w, double * dst)
+        {
+            const size_t N2 = N / 2 * 2;
+
+            // Only the blocks containing the upper triangle are accumulated
+            float64x2_t sum2[N][N2 / 2];
+            double sum1[N];
+            for (size_t i = 0; i < N; i++) {
+                for (size_t b = 0; b < N2 / 2; b++) {
+                    sum2[i][b] = vdupq_n_f64(0);
+                }
+                sum1[i] = 0;
+            }
+
+            for (size_t k = 0; k < rows; k++) {
+                const double * a = A + k*N;
+                const double wk = w ? w[k] : 1.0;
+
+                float64x2_t a2[N2 / 2];
+                for (size_t b = 0; b < N2 / 2; b++) {
+                    a2[b] = vld1q_f64(a + 2*b);
+                }
+
+                for (size_t i = 0; i < N; i++) {
+                    const double wa = wk * a[i];
+                    const float64x2_t v_wa = vdupq_n_f64(wa);
+                    for (size_t b = i / 2; b < N2 / 2; b++) {
+                        sum2[i][b] = vfmaq_f64(sum2[i][b], v_wa, a2[b]);
+                    }
+                    if (N > N2) {
+                        sum1[i] += wa * a[N - 1];
+                    }
+                }
+            }
+
+            double AtA[N*N];
+            for (size_t i = 0; i < N; i++) {
+                for (size_t b = i / 2; b < N2 / 2; b++) {
+                    vst1q_f64(AtA + i*N + 2*b, sum2[i][b]);
+                }
+                if (N > N2) {
+                    AtA[i*N + N - 1] = sum1[i];
+                }
+            }
+
+            for (size_t i = 0; i < N; i++) {
+                for (size_t j = i; j < N; j++) {
+                    dst[i*N + j] = dst[j*N + i] = AtA[i*N + j];
+                }
+            }
+        }
+
+        void SimdComputeAtWA(const double * A, size_t rows, size_t cols, const double * w, double * dst)
+        {
+            switch (cols) {
+            case 3: ComputeAtWA<3>(A, rows, w, dst); break;
+            case 4: ComputeAtWA<4>(A, rows, w, dst); break;
+            case 6: ComputeAtWA<6>(A, rows, w, dst); break;
+            case 8: ComputeAtWA<8>(A, rows, w, dst); break;
+            default: Base::SimdComputeAtWA(A, rows, cols, w, dst); break;
+            }
+        }
+
+        template <size_t N> void ComputeAtWb(const double * A, size_t rows, const double * w, const double * b, double * dst)
+        {
+            const size_t N2 = N / 2 * 2;
+
+            float64x2_t sum2[N2 / 2];
+            for (size_t j = 0; j < N2 / 2; j++) {
+                sum2[j] = vdupq_n_f64(0);
+            }
+            double sum1 = 0;
+
+            for (size_t k = 0; k < rows; k++) {
+                const double * a = A + k*N;
+                const double wb = w ? w[k] * b[k] : b[k];
+                const float64x2_t v_wb = vdupq_n_f64(wb);
+                for (size_t j = 0; j < N2 / 2; j++) {
+                    sum2[j] = vfmaq_f64(sum2[j], vld1q_f64(a + 2*j), v_wb);
+                }
+                if (N > N2) {
+                    sum1 += a[N - 1] * wb;
+                }
+            }
+
+            for (size_t j = 0; j < N2 / 2; j++) {
+                vst1q_f64(dst + 2*j, sum2[j]);
+            }
+            if (N > N2) {
+                dst[N - 1] = sum1;
+            }
+        }
+
+        void SimdComputeAtWb(const double * A, size_t rows, size_t cols, const double * w, const double * b, double * dst)
+        {
+            switch (cols) {
+            case 3: ComputeAtWb<3>(A, rows, w, b, dst); break;
+            case 4: ComputeAtWb<4>(A, rows, w, b, dst); break;
+            case 6: ComputeAtWb<6>(A, rows, w, b, dst); break;
+            case 8: ComputeAtWb<8>(A, rows, w, b, dst); break;
+            default: Base::SimdComputeAtWb(A, rows, cols, w, b, dst); break;
+            }
+        }
+    }
+#else
+    // Work arround to avoid warning: libvisp_simdlib.a(SimdNeonCustomFunctions.cpp.o) has no symbols
+    void dummy_SimdNeonCustomFunctions(){};
+#endif// SIMD_NEON_ENABLE && SIMD_ARM64_ENABLE
+}
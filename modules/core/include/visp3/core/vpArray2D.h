@@ -144,12 +144,16 @@ public:
   //! Address of the first element of the data array
   Type *data;
 
+protected:
+  //! False when data and rowPtrs point to a fixed-size storage provided by a derived class
+  bool isMemoryOwner;
+
 public:
   /*!
   Basic constructor of a 2D array.
   Number of columns and rows are set to zero.
   */
-  vpArray2D<Type>() : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL) {}
+  vpArray2D<Type>() : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), isMemoryOwner(true) {}
 
   /*!
   Copy constructor of a 2D array.
@@ -158,7 +162,7 @@ public:
   #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
     vpArray2D<Type>()
   #else
-    rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+    rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), isMemoryOwner(true)
   #endif
   {
     resize(A.rowNum, A.colNum, false, false);
@@ -175,7 +179,7 @@ public:
   #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
       vpArray2D<Type>()
   #else
-      rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+      rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), isMemoryOwner(true)
   #endif
   {
     resize(r, c);
@@ -192,7 +196,7 @@ public:
   #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
       vpArray2D<Type>()
   #else
-      rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+      rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), isMemoryOwner(true)
   #endif
   {
     resize(r, c, false, false);
@@ -200,8 +204,14 @@ public:
   }
 
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-  vpArray2D<Type>(vpArray2D<Type> &&A) noexcept
+  vpArray2D<Type>(vpArray2D<Type> &&A) noexcept : vpArray2D<Type>()
   {
+    if (!A.isMemoryOwner) {
+      // The fixed-size storage of A cannot be stolen
+      *this = A;
+      return;
+    }
+
     rowNum = A.rowNum;
     colNum = A.colNum;
     rowPtrs = A.rowPtrs;
@@ -222,7 +232,7 @@ public:
   }
 
   explicit vpArray2D<Type>(unsigned int nrows, unsigned int ncols, const std::initializer_list<Type> &list)
-    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), isMemoryOwner(true)
   {
     if (nrows * ncols != static_cast<unsigned int>(list.size())) {
       std::ostringstream oss;
@@ -252,23 +262,66 @@ public:
   }
 #endif
 
+protected:
+  /*!
+  Constructor used by fixed-size derived classes, such as vpHomogeneousMatrix,
+  that hold their elements in their own storage. No memory is allocated and all
+  the elements are set to zero.
+
+  \param r : Array number of rows.
+  \param c : Array number of columns.
+  \param storage : Buffer of at least \e r x \e c elements.
+  \param rowStorage : Buffer of at least \e r row pointers.
+  */
+  vpArray2D<Type>(unsigned int r, unsigned int c, Type *storage, Type **rowStorage)
+    : rowNum(r), colNum(c), rowPtrs(rowStorage), dsize(r * c), data(storage), isMemoryOwner(false)
+  {
+    for (unsigned int i = 0; i < rowNum; i++) {
+      rowPtrs[i] = data + i * colNum;
+    }
+    memset(data, 0, (size_t)dsize * sizeof(Type));
+  }
+
+public:
   /*!
   Destructor that desallocate memory.
   */
   virtual ~vpArray2D<Type>()
   {
-    if (data != NULL) {
+    if (data != NULL && isMemoryOwner) {
       free(data);
-      data = NULL;
     }
+    data = NULL;
 
-    if (rowPtrs != NULL) {
+    if (rowPtrs != NULL && isMemoryOwner) {
       free(rowPtrs);
-      rowPtrs = NULL;
     }
+    rowPtrs = NULL;
     rowNum = colNum = dsize = 0;
   }
 
+private:
+  /*!
+  Copy the elements held in the fixed-size storage of a derived class to a
+  heap buffer that can then be reallocated. rowPtrs is reset and has to be
+  reallocated and updated by the caller.
+  */
+  void allocateOwnMemory()
+  {
+    Type *heapData = NULL;
+    if (dsize > 0) {
+      heapData = (Type *)malloc(dsize * sizeof(Type));
+      if (heapData == NULL) {
+        throw(vpException(vpException::memoryAllocationError, "Memory allocation error when allocating 2D array data"));
+      }
+      memcpy(heapData, data, (size_t)dsize * sizeof(Type));
+    }
+    data = heapData;
+    rowPtrs = NULL;
+    isMemoryOwner = true;
+  }
+
+public:
   /** @name Inherited functionalities from vpArray2D */
   //@{
 
@@ -322,6 +375,10 @@ public:
         colTmp = this->colNum;
       }
 
+      if (!isMemoryOwner) {
+        allocateOwnMemory();
+      }
+
       // Reallocation of this->data array
       this->dsize = nrows * ncols;
       this->data = (Type *)realloc(this->data, this->dsize * sizeof(Type));
@@ -390,9 +447,15 @@ public:
       throw vpException(vpException::dimensionError, oss.str());
     }
 
+    if (!isMemoryOwner && nrows != rowNum) {
+      allocateOwnMemory();
+    }
+
     rowNum = nrows;
     colNum = ncols;
-    rowPtrs = reinterpret_cast<Type **>(realloc(rowPtrs, nrows * sizeof(Type *)));
+    if (isMemoryOwner) {
+      rowPtrs = reinterpret_cast<Type **>(realloc(rowPtrs, nrows * sizeof(Type *)));
+    }
     // Update rowPtrs
     Type **t_ = rowPtrs;
     for (unsigned int i = 0; i < dsize; i += ncols) {
@@ -431,6 +494,11 @@ public:
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
   vpArray2D<Type> &operator=(vpArray2D<Type> &&other) noexcept
   {
+    if (!isMemoryOwner || !other.isMemoryOwner) {
+      // Fixed-size storage can neither be released nor stolen
+      return *this = other;
+    }
+
     if (this != &other) {
       free(data);
       free(rowPtrs);
@@ -59,10 +59,38 @@ int main()
   return 0;
 }
   \endcode
+
+  The SIMD kernels of ViSP do not test the hardware capabilities themselves:
+  they run at the SIMD level returned by getSimdLevel(). This level is the
+  highest instruction set supported by the CPU and the operating system,
+  detected once when the library is loaded. It can be lowered with the \c
+  VISP_SIMD environment variable, set to \c none, \c sse2, \c ssse3, \c
+  sse41, \c avx, \c avx2 or \c avx512, to compare the kernels without
+  rebuilding:
+  \code
+$ VISP_SIMD=sse2 ./perfGenericTracker
+  \endcode
+  A level higher than the one supported by the hardware is ignored. See
+  vpSimdDispatcher to register several versions of a kernel.
 */
 
 namespace vpCPUFeatures
 {
+/*!
+  SIMD instruction set levels, sorted so that a level includes all the
+  previous ones.
+*/
+typedef enum {
+  SIMD_NONE,   /*!< Scalar code only. */
+  SIMD_SSE2,   /*!< SSE2. */
+  SIMD_SSSE3,  /*!< SSE3 and SSSE3. */
+  SIMD_SSE41,  /*!< SSE4.1 and SSE4.2. */
+  SIMD_AVX,    /*!< AVX. */
+  SIMD_AVX2,   /*!< AVX2 and FMA3. */
+  SIMD_AVX512, /*!< AVX-512 F and BW. */
+  SIMD_LEVEL_COUNT
+} vpSimdLevel;
+
 VISP_EXPORT bool checkSSE2();
 VISP_EXPORT bool checkSSE3();
 VISP_EXPORT bool checkSSSE3();
@@ -70,7 +98,14 @@ VISP_EXPORT bool checkSSE41();
 VISP_EXPORT bool checkSSE42();
 VISP_EXPORT bool checkAVX();
 VISP_EXPORT bool checkAVX2();
+VISP_EXPORT bool checkPOPCNT();
 VISP_EXPORT void printCPUInfo();
+
+VISP_EXPORT bool checkSimdLevel(vpSimdLevel level);
+VISP_EXPORT vpSimdLevel getHardwareSimdLevel();
+VISP_EXPORT vpSimdLevel getSimdLevel();
+VISP_EXPORT const char *getSimdLevelName(vpSimdLevel level);
+VISP_EXPORT void setSimdLevel(vpSimdLevel level);
 }
 
 #endif
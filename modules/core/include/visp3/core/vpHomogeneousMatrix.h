@@ -265,6 +265,12 @@ public:
 
 protected:
   unsigned int m_index;
+
+private:
+  //! Fixed-size storage of the elements, which avoids any heap allocation
+  double m_storage[16];
+  //! Fixed-size storage of the row pointers
+  double *m_rowStorage[4];
 };
 
 #endif
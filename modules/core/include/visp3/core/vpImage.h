@@ -48,6 +48,7 @@
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpEndian.h>
 #include <visp3/core/vpException.h>
+#include <visp3/core/vpImageBufferPool.h>
 #include <visp3/core/vpImageException.h>
 #include <visp3/core/vpImagePoint.h>
 #include <visp3/core/vpRGBa.h>
@@ -60,6 +61,7 @@
 #include <iomanip> // std::setw
 #include <iostream>
 #include <math.h>
+#include <new>
 #include <string.h>
 
 // Visual Studio 2010 or previous is missing inttypes.h
@@ -349,6 +351,9 @@ public:
   //@}
 
 private:
+  static Type *allocateBitmap(unsigned int n);
+  static void releaseBitmap(Type *ptr, unsigned int n);
+
   unsigned int npixels; ///! number of pixel in the image
   unsigned int width;   ///! number of columns
   unsigned int height;  ///! number of rows
@@ -637,6 +642,31 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w, T
   std::fill(bitmap, bitmap + npixels, value);
 }
 
+/*!
+  Allocate a bitmap of \e n pixels from vpImageBufferPool, aligned on
+  vpImageBufferPool::getAlignment() bytes, and default-construct its pixels.
+*/
+template <class Type> Type *vpImage<Type>::allocateBitmap(unsigned int n)
+{
+  Type *ptr = static_cast<Type *>(vpImageBufferPool::allocate(static_cast<size_t>(n) * sizeof(Type)));
+  for (unsigned int i = 0; i < n; i++) {
+    new (ptr + i) Type;
+  }
+  return ptr;
+}
+
+/*!
+  Destroy the \e n pixels of a bitmap allocated with allocateBitmap() and
+  give it back to vpImageBufferPool.
+*/
+template <class Type> void vpImage<Type>::releaseBitmap(Type *ptr, unsigned int n)
+{
+  for (unsigned int i = 0; i < n; i++) {
+    ptr[i].~Type();
+  }
+  vpImageBufferPool::deallocate(ptr, static_cast<size_t>(n) * sizeof(Type));
+}
+
 /*!
   \relates vpImage
 */
@@ -654,7 +684,7 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
     if (bitmap != NULL) {
       vpDEBUG_TRACE(10, "Destruction bitmap[]");
       if (hasOwnership) {
-        delete[] bitmap;
+        releaseBitmap(bitmap, npixels);
       }
       bitmap = NULL;
     }
@@ -666,14 +696,10 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
   npixels = width * height;
 
   if (bitmap == NULL) {
-    bitmap = new Type[npixels];
+    bitmap = allocateBitmap(npixels);
     hasOwnership = true;
   }
 
-  if (bitmap == NULL) {
-    throw(vpException(vpException::memoryAllocationError, "cannot allocate bitmap "));
-  }
-
   if (row == NULL)
     row = new Type *[height];
   if (row == NULL) {
@@ -701,7 +727,7 @@ void vpImage<Type>::init(Type *const array, unsigned int h, unsigned int w, bool
   if ((copyData && ((h != this->height) || (w != this->width))) || !copyData) {
     if (bitmap != NULL) {
       if (hasOwnership) {
-        delete[] bitmap;
+        releaseBitmap(bitmap, npixels);
       }
       bitmap = NULL;
     }
@@ -715,11 +741,7 @@ void vpImage<Type>::init(Type *const array, unsigned int h, unsigned int w, bool
 
   if (copyData) {
     if (bitmap == NULL)
-      bitmap = new Type[npixels];
-
-    if (bitmap == NULL) {
-      throw(vpException(vpException::memoryAllocationError, "cannot allocate bitmap "));
-    }
+      bitmap = allocateBitmap(npixels);
 
     // Copy the image data
     memcpy(static_cast<void*>(bitmap), static_cast<void*>(array), (size_t)(npixels * sizeof(Type)));
@@ -834,7 +856,7 @@ template <class Type> void vpImage<Type>::destroy()
     //  vpERROR_TRACE("Deallocate bitmap memory %p",bitmap);
     //    vpDEBUG_TRACE(20,"Deallocate bitmap memory %p",bitmap);
     if (hasOwnership) {
-      delete[] bitmap;
+      releaseBitmap(bitmap, npixels);
     }
     bitmap = NULL;
   }
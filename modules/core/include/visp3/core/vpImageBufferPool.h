@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Aligned allocation and recycling of image bitmaps.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpImageBufferPool.h
+  \brief Aligned allocation and recycling of image bitmaps
+*/
+
+#ifndef vpImageBufferPool_H
+#define vpImageBufferPool_H
+
+#include <stddef.h>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpImageBufferPool
+
+  \ingroup group_core_image
+
+  \brief Allocator of the vpImage bitmaps, with an optional process-wide pool
+  of released buffers.
+
+  All the bitmaps owned by vpImage are allocated here and are aligned on
+  getAlignment() bytes, so that the SIMD kernels can use their aligned code
+  paths.
+
+  When the pool is enabled, a released bitmap is kept in a bucket indexed by
+  its size instead of being freed, and the next allocation of the same size
+  reuses it. Transient images that are rebuilt every frame with the same size
+  (filtering, conversions, pyramids, grabbers) then no longer hit the system
+  allocator. The pool is disabled by default. It is thread-safe and requires
+  C++11; without C++11, setEnabled() has no effect.
+
+  \code
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageBufferPool.h>
+
+int main()
+{
+  vpImageBufferPool::setEnabled(true);
+  for (int i = 0; i < 100; i++) {
+    vpImage<unsigned char> I(480, 640); // reuses the bitmap released at the previous iteration
+  }
+  std::cout << vpImageBufferPool::getNbHits() << " hits, " << vpImageBufferPool::getNbMisses() << " misses"
+            << std::endl;
+}
+  \endcode
+*/
+class VISP_EXPORT vpImageBufferPool
+{
+public:
+  static void *allocate(size_t size);
+  static void clear();
+  static void deallocate(void *ptr, size_t size);
+
+  //! Return the alignment in bytes of the allocated buffers.
+  static inline size_t getAlignment() { return 64; }
+  static size_t getCachedBytes();
+  static size_t getMaxCachedBytes();
+  static unsigned long getNbHits();
+  static unsigned long getNbMisses();
+  static bool isEnabled();
+  static void resetCounters();
+  static void setEnabled(bool enable);
+  static void setMaxCachedBytes(size_t maxCachedBytes);
+};
+
+#endif
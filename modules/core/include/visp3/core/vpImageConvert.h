@@ -52,6 +52,7 @@
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageView.h>
 // color
 #include <visp3/core/vpRGBa.h>
 
@@ -101,6 +102,11 @@
 
   \include tutorial-image-converter.cpp
 
+  The conversions of the camera stream formats (YUV, MONO16, Bayer) also
+  exist with the number of bytes between two rows of the source and of the
+  destination. They write into a destination allocated by the caller, use
+  SIMD instructions when available and convert the rows in parallel when
+  OpenMP is available.
 */
 class VISP_EXPORT vpImageConvert
 {
@@ -111,6 +117,7 @@ public:
 
   static void convert(const vpImage<unsigned char> &src, vpImage<vpRGBa> &dest);
   static void convert(const vpImage<vpRGBa> &src, vpImage<unsigned char> &dest, unsigned int nThreads=0);
+  static void convert(const vpImageView<const vpRGBa> &src, vpImage<unsigned char> &dest);
 
   static void convert(const vpImage<float> &src, vpImage<unsigned char> &dest);
   static void convert(const vpImage<unsigned char> &src, vpImage<float> &dest);
@@ -255,6 +262,46 @@ public:
   static void MONO16ToGrey(unsigned char *grey16, unsigned char *grey, unsigned int size);
   static void MONO16ToRGBa(unsigned char *grey16, unsigned char *rgba, unsigned int size);
 
+  static void YUYVToRGBa(const unsigned char *yuyv, unsigned int yuyvStride, unsigned char *rgba,
+                         unsigned int rgbaStride, unsigned int width, unsigned int height, unsigned int nThreads = 0);
+  static void YUYVToRGB(const unsigned char *yuyv, unsigned int yuyvStride, unsigned char *rgb, unsigned int rgbStride,
+                        unsigned int width, unsigned int height, unsigned int nThreads = 0);
+  static void YUYVToGrey(const unsigned char *yuyv, unsigned int yuyvStride, unsigned char *grey,
+                         unsigned int greyStride, unsigned int width, unsigned int height, unsigned int nThreads = 0);
+  static void YUV422ToRGBa(const unsigned char *yuv, unsigned int yuvStride, unsigned char *rgba,
+                           unsigned int rgbaStride, unsigned int width, unsigned int height,
+                           unsigned int nThreads = 0);
+  static void YUV422ToRGB(const unsigned char *yuv, unsigned int yuvStride, unsigned char *rgb, unsigned int rgbStride,
+                          unsigned int width, unsigned int height, unsigned int nThreads = 0);
+  static void YUV422ToGrey(const unsigned char *yuv, unsigned int yuvStride, unsigned char *grey,
+                           unsigned int greyStride, unsigned int width, unsigned int height,
+                           unsigned int nThreads = 0);
+  static void YUV420ToRGBa(const unsigned char *y, unsigned int yStride, const unsigned char *u, unsigned int uStride,
+                           const unsigned char *v, unsigned int vStride, unsigned char *rgba, unsigned int rgbaStride,
+                           unsigned int width, unsigned int height, unsigned int nThreads = 0);
+  static void YUV420ToRGB(const unsigned char *y, unsigned int yStride, const unsigned char *u, unsigned int uStride,
+                          const unsigned char *v, unsigned int vStride, unsigned char *rgb, unsigned int rgbStride,
+                          unsigned int width, unsigned int height, unsigned int nThreads = 0);
+  static void MONO16ToGrey(const unsigned char *grey16, unsigned int grey16Stride, unsigned char *grey,
+                           unsigned int greyStride, unsigned int width, unsigned int height,
+                           unsigned int nThreads = 0);
+  static void MONO16ToRGBa(const unsigned char *grey16, unsigned int grey16Stride, unsigned char *rgba,
+                           unsigned int rgbaStride, unsigned int width, unsigned int height,
+                           unsigned int nThreads = 0);
+
+  static void demosaicBGGRToRGBaBilinear(const unsigned char *bggr, unsigned int bggrStride, unsigned char *rgba,
+                                         unsigned int rgbaStride, unsigned int width, unsigned int height,
+                                         unsigned int nThreads = 0);
+  static void demosaicGBRGToRGBaBilinear(const unsigned char *gbrg, unsigned int gbrgStride, unsigned char *rgba,
+                                         unsigned int rgbaStride, unsigned int width, unsigned int height,
+                                         unsigned int nThreads = 0);
+  static void demosaicGRBGToRGBaBilinear(const unsigned char *grbg, unsigned int grbgStride, unsigned char *rgba,
+                                         unsigned int rgbaStride, unsigned int width, unsigned int height,
+                                         unsigned int nThreads = 0);
+  static void demosaicRGGBToRGBaBilinear(const unsigned char *rggb, unsigned int rggbStride, unsigned char *rgba,
+                                         unsigned int rgbaStride, unsigned int width, unsigned int height,
+                                         unsigned int nThreads = 0);
+
   static void HSVToRGBa(const double *hue, const double *saturation, const double *value, unsigned char *rgba,
                         unsigned int size);
   static void HSVToRGBa(const unsigned char *hue, const unsigned char *saturation, const unsigned char *value,
@@ -47,6 +47,7 @@
 
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImageView.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpRGBa.h>
@@ -63,14 +64,37 @@
 
   \brief  Various image filter, convolution, etc...
 
+  The separable filters with a vpImage<float>, vpImage<short> or
+  vpImage<unsigned char> output (sepFilter(), gaussianBlur(), getGradX(),
+  getGradY(), getGradXGauss2D(), getGradYGauss2D() and sobel()) are computed
+  by bands of rows, in parallel when OpenMP is available, with SSE2 row and
+  column passes. The short and unsigned char outputs are computed with
+  fixed-point arithmetic. The functions with a vpImage<double> output are
+  computed the same way in double precision. canny() is built on
+  gaussianBlur() and sobel() and does not require OpenCV.
+
+  These separable filters, as well as filter() with a vpMatrix kernel, also
+  accept a vpImageView<const unsigned char> input: a region of interest of a
+  larger image, or a buffer with padded rows, is then filtered without being
+  copied first. The border handling applies to the borders of the view.
 */
 class VISP_EXPORT vpImageFilter
 {
 public:
-#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
+  //! Handling of the pixels outside the image by the separable filters.
+  enum vpBorderType {
+    BORDER_REFLECT,   /*!< Mirror the image as filterX() and filterY() do: the first row (column) is not
+                           repeated (\f$I(-i) = I(i)\f$), the last one is (\f$I(n-1+i) = I(n-i)\f$). */
+    BORDER_REPLICATE, /*!< Repeat the first and last rows (columns). */
+    BORDER_ZERO       /*!< Set to 0 the output pixels for which the kernel is not fully inside the image, as
+                           getGradX() and getGradY() do. */
+  };
+
   static void canny(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ic, unsigned int gaussianFilterSize,
                     double thresholdCanny, unsigned int apertureSobel);
-#endif
+  static void canny(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ic, unsigned int gaussianFilterSize,
+                    double lowerThreshold, double upperThreshold, unsigned int apertureSobel,
+                    unsigned int nThreads = 0);
 
   /*!
    Apply a 1x3 derivative filter to an image pixel.
@@ -160,9 +184,32 @@ public:
 
   static void filter(const vpImage<unsigned char> &I, vpImage<double> &If, const vpMatrix &M,
                      bool convolve = false);
+  static void filter(const vpImageView<const unsigned char> &I, vpImage<double> &If, const vpMatrix &M,
+                     bool convolve = false);
 
   static void sepFilter(const vpImage<unsigned char> &I, vpImage<double> &If, const vpColVector &kernelH,
                         const vpColVector &kernelV);
+  static void sepFilter(const vpImage<unsigned char> &I, vpImage<float> &If, const float *kernelX,
+                        unsigned int sizeX, const float *kernelY, unsigned int sizeY,
+                        const vpBorderType &border = BORDER_REFLECT, unsigned int nThreads = 0);
+  static void sepFilter(const vpImage<float> &I, vpImage<float> &If, const float *kernelX, unsigned int sizeX,
+                        const float *kernelY, unsigned int sizeY, const vpBorderType &border = BORDER_REFLECT,
+                        unsigned int nThreads = 0);
+  static void sepFilter(const vpImage<unsigned char> &I, vpImage<short> &If, const float *kernelX,
+                        unsigned int sizeX, const float *kernelY, unsigned int sizeY,
+                        const vpBorderType &border = BORDER_REFLECT, unsigned int nThreads = 0);
+  static void sepFilter(const vpImage<unsigned char> &I, vpImage<unsigned char> &If, const float *kernelX,
+                        unsigned int sizeX, const float *kernelY, unsigned int sizeY,
+                        const vpBorderType &border = BORDER_REFLECT, unsigned int nThreads = 0);
+  static void sepFilter(const vpImageView<const unsigned char> &I, vpImage<float> &If, const float *kernelX,
+                        unsigned int sizeX, const float *kernelY, unsigned int sizeY,
+                        const vpBorderType &border = BORDER_REFLECT, unsigned int nThreads = 0);
+  static void sepFilter(const vpImageView<const unsigned char> &I, vpImage<short> &If, const float *kernelX,
+                        unsigned int sizeX, const float *kernelY, unsigned int sizeY,
+                        const vpBorderType &border = BORDER_REFLECT, unsigned int nThreads = 0);
+  static void sepFilter(const vpImageView<const unsigned char> &I, vpImage<unsigned char> &If, const float *kernelX,
+                        unsigned int sizeX, const float *kernelY, unsigned int sizeY,
+                        const vpBorderType &border = BORDER_REFLECT, unsigned int nThreads = 0);
 
   static void filter(const vpImage<unsigned char> &I, vpImage<double> &GI, const double *filter, unsigned int size);
   static void filter(const vpImage<double> &I, vpImage<double> &GI, const double *filter, unsigned int size);
@@ -645,6 +692,16 @@ public:
                            double sigma = 0., bool normalize = true);
   static void gaussianBlur(const vpImage<double> &I, vpImage<double> &GI, unsigned int size = 7, double sigma = 0.,
                            bool normalize = true);
+  static void gaussianBlur(const vpImage<unsigned char> &I, vpImage<float> &GI, unsigned int size = 7,
+                           double sigma = 0., bool normalize = true, unsigned int nThreads = 0);
+  static void gaussianBlur(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI, unsigned int size = 7,
+                           double sigma = 0., bool normalize = true, unsigned int nThreads = 0);
+  static void gaussianBlur(const vpImageView<const unsigned char> &I, vpImage<double> &GI, unsigned int size = 7,
+                           double sigma = 0., bool normalize = true);
+  static void gaussianBlur(const vpImageView<const unsigned char> &I, vpImage<float> &GI, unsigned int size = 7,
+                           double sigma = 0., bool normalize = true, unsigned int nThreads = 0);
+  static void gaussianBlur(const vpImageView<const unsigned char> &I, vpImage<unsigned char> &GI,
+                           unsigned int size = 7, double sigma = 0., bool normalize = true, unsigned int nThreads = 0);
   /*!
    Apply a 5x5 Gaussian filter to an image pixel.
 
@@ -676,18 +733,39 @@ public:
   static void getGradX(const vpImage<unsigned char> &I, vpImage<double> &dIx);
   static void getGradX(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter, unsigned int size);
   static void getGradX(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size);
+  static void getGradX(const vpImage<unsigned char> &I, vpImage<float> &dIx, const double *filter, unsigned int size,
+                       unsigned int nThreads = 0);
+  static void getGradX(const vpImageView<const unsigned char> &I, vpImage<float> &dIx, const double *filter,
+                       unsigned int size, unsigned int nThreads = 0);
   static void getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *gaussianKernel,
                               const double *gaussianDerivativeKernel, unsigned int size);
+  static void getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<float> &dIx, const double *gaussianKernel,
+                              const double *gaussianDerivativeKernel, unsigned int size, unsigned int nThreads = 0);
 
   // fonction renvoyant le gradient en Y de l'image I
   static void getGradY(const vpImage<unsigned char> &I, vpImage<double> &dIy);
   static void getGradY(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *filter, unsigned int size);
   static void getGradY(const vpImage<double> &I, vpImage<double> &dIy, const double *filter, unsigned int size);
+  static void getGradY(const vpImage<unsigned char> &I, vpImage<float> &dIy, const double *filter, unsigned int size,
+                       unsigned int nThreads = 0);
+  static void getGradY(const vpImageView<const unsigned char> &I, vpImage<float> &dIy, const double *filter,
+                       unsigned int size, unsigned int nThreads = 0);
   static void getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *gaussianKernel,
                               const double *gaussianDerivativeKernel, unsigned int size);
+  static void getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<float> &dIy, const double *gaussianKernel,
+                              const double *gaussianDerivativeKernel, unsigned int size, unsigned int nThreads = 0);
 
   static double getSobelKernelX(double *filter, unsigned int size);
   static double getSobelKernelY(double *filter, unsigned int size);
+
+  static void sobel(const vpImage<unsigned char> &I, vpImage<short> &dIx, vpImage<short> &dIy,
+                    unsigned int nThreads = 0);
+  static void sobel(const vpImage<unsigned char> &I, vpImage<float> &dIx, vpImage<float> &dIy, unsigned int size = 1,
+                    unsigned int nThreads = 0);
+  static void sobel(const vpImageView<const unsigned char> &I, vpImage<short> &dIx, vpImage<short> &dIy,
+                    unsigned int nThreads = 0);
+  static void sobel(const vpImageView<const unsigned char> &I, vpImage<float> &dIx, vpImage<float> &dIy,
+                    unsigned int size = 1, unsigned int nThreads = 0);
 };
 
 #endif
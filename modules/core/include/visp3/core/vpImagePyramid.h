@@ -0,0 +1,139 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Image pyramid with persistent level buffers.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpImagePyramid.h
+  \brief Image pyramid with persistent level buffers
+*/
+
+#ifndef vpImagePyramid_H
+#define vpImagePyramid_H
+
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+
+/*!
+  \class vpImagePyramid
+
+  \ingroup group_core_image
+
+  \brief Multi-resolution pyramid of a grayscale image, where each level is
+  half the size of the previous one.
+
+  The level buffers are kept between two calls to build(), so that rebuilding
+  the pyramid of a new image with the same size does not allocate any image
+  memory. Level 0 is not copied: it refers to the image passed to build(),
+  which must therefore outlive the use of the pyramid.
+
+  The same pyramid can be built once per frame and read by several trackers
+  that process the same image.
+
+  \code
+#include <iostream>
+#include <visp3/core/vpImagePyramid.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640, 0);
+  vpImagePyramid pyramid(vpImagePyramid::GAUSSIAN);
+
+  for (int frame = 0; frame < 10; frame++) {
+    // Acquire I ...
+    pyramid.build(I, 3); // No allocation after the first frame
+    const vpImage<unsigned char> &I_quarter = pyramid[2];
+    std::cout << I_quarter.getWidth() << "x" << I_quarter.getHeight() << std::endl;
+  }
+}
+  \endcode
+*/
+class VISP_EXPORT vpImagePyramid
+{
+public:
+  //! Filter used to compute a level from the previous one.
+  typedef enum {
+    SUBSAMPLING, /*!< Keep one pixel out of two, without smoothing. A level has a size
+                      of floor(w/2) x floor(h/2). */
+    BOX,         /*!< Average of each 2x2 block. A level has a size of
+                      ceil(w/2) x ceil(h/2). */
+    GAUSSIAN     /*!< 5x5 Gaussian smoothing (binomial kernel) then subsampling. A level
+                      has a size of ceil(w/2) x ceil(h/2). */
+  } vpPyramidFilterType;
+
+  explicit vpImagePyramid(const vpPyramidFilterType &filterType = SUBSAMPLING);
+
+  void build(const vpImage<unsigned char> &I, unsigned int nbLevels);
+
+  /*!
+    Return the filter used to compute the levels.
+  */
+  inline vpPyramidFilterType getFilterType() const { return m_filterType; }
+
+  const vpImage<unsigned char> &getLevel(unsigned int level) const;
+
+  /*!
+    Return the number of levels of the last built pyramid.
+  */
+  inline unsigned int getNbLevels() const { return m_nbLevels; }
+
+  /*!
+    Return the image at pyramid level \e level, 0 being the full resolution
+    image.
+
+    \sa getLevel()
+  */
+  inline const vpImage<unsigned char> &operator[](unsigned int level) const { return getLevel(level); }
+
+  /*!
+    Set the filter used to compute the levels. Takes effect at the next call
+    to build().
+  */
+  inline void setFilterType(const vpPyramidFilterType &filterType) { m_filterType = filterType; }
+
+  static void pyrDown(const vpImage<unsigned char> &I, vpImage<unsigned char> &Idown,
+                      const vpPyramidFilterType &filterType = SUBSAMPLING);
+
+private:
+  //! Filter used to compute a level from the previous one
+  vpPyramidFilterType m_filterType;
+  //! Number of levels of the last built pyramid
+  unsigned int m_nbLevels;
+  //! Full resolution image (level 0), not owned
+  const vpImage<unsigned char> *m_I0;
+  //! Buffers of levels 1 to n, kept across calls to build()
+  std::vector<vpImage<unsigned char> > m_levels;
+};
+
+#endif
@@ -54,6 +54,7 @@
 
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImageView.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpRect.h>
 #include <visp3/core/vpRectOriented.h>
@@ -156,6 +157,11 @@ public:
   static void resize(const vpImage<Type> &I, vpImage<Type> &Ires,
                      const vpImageInterpolationType &method = INTERPOLATION_NEAREST, unsigned int nThreads=0);
 
+  static void resize(const vpImageView<const unsigned char> &I, vpImage<unsigned char> &Ires,
+                     const vpImageInterpolationType &method = INTERPOLATION_NEAREST, unsigned int nThreads=0);
+  static void resize(const vpImageView<const vpRGBa> &I, vpImage<vpRGBa> &Ires,
+                     const vpImageInterpolationType &method = INTERPOLATION_NEAREST, unsigned int nThreads=0);
+
   static void templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
                                vpImage<double> &I_score, unsigned int step_u, unsigned int step_v,
                                bool useOptimized = true);
@@ -171,7 +177,13 @@ public:
   template <class Type>
   static void warpImage(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst,
                         const vpImageInterpolationType &interpolation=INTERPOLATION_NEAREST,
-                        bool fixedPointArithmetic=true, bool pixelCenter=false);
+                        bool fixedPointArithmetic=true, bool pixelCenter=false, unsigned int nThreads=0);
+  static void warpImage(const vpImageView<const unsigned char> &src, const vpMatrix &T, vpImage<unsigned char> &dst,
+                        const vpImageInterpolationType &interpolation=INTERPOLATION_NEAREST,
+                        bool fixedPointArithmetic=true, bool pixelCenter=false, unsigned int nThreads=0);
+  static void warpImage(const vpImageView<const vpRGBa> &src, const vpMatrix &T, vpImage<vpRGBa> &dst,
+                        const vpImageInterpolationType &interpolation=INTERPOLATION_NEAREST,
+                        bool fixedPointArithmetic=true, bool pixelCenter=false, unsigned int nThreads=0);
 
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
   /*!
@@ -228,6 +240,13 @@ private:
   static void warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst, bool affine, bool centerCorner, bool fixedPoint);
 
   static bool checkFixedPoint(unsigned int x, unsigned int y, const vpMatrix &T, bool affine);
+  static vpMatrix inverseWarp(const vpMatrix &T);
+
+  template <class Type>
+  static bool warpRemap(const vpImage<Type> &, const vpMatrix &, vpImage<Type> &, bool) { return false; }
+  static bool warpRemap(const vpImage<unsigned char> &src, const vpMatrix &T, vpImage<unsigned char> &dst,
+                        bool nearest);
+  static bool warpRemap(const vpImage<vpRGBa> &src, const vpMatrix &T, vpImage<vpRGBa> &dst, bool nearest);
 };
 
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
@@ -636,10 +655,11 @@ template <class Type> void *vpUndistortInternalType<Type>::vpUndistort_threaded(
   multiplication by a scalar" operators.
 
   Since this function is time consuming, if you want to undistort multiple images, you should rather
+  use vpImageUndistort, that computes a fixed-point remap table once and reuses its threads, or
   call initUndistortMap() once and then remap() to undistort the images.
   This will be less time consuming.
 
-  \sa initUndistortMap(), remap()
+  \sa vpImageUndistort, initUndistortMap(), remap()
 */
 template <class Type>
 void vpImageTools::undistort(const vpImage<Type> &I, const vpCameraParameters &cam, vpImage<Type> &undistI,
@@ -1244,11 +1264,20 @@ void vpImageTools::resize(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires,
   possible. Otherwise (e.g. the input image is too big) it fallbacks to the default implementation.
   \param pixelCenter : If true, pixel coordinates are at (0.5, 0.5), otherwise at (0,0). Fixed-point
   arithmetic cannot be used with `pixelCenter` option.
+  \param nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+
+  The rows of the output image are processed in parallel. For unsigned char and vpRGBa images with
+  fixed-point arithmetic, the source coordinates of a row are stepped from one pixel to the next with
+  SSE2 and the pixels are interpolated with 7-bit fixed-point weights.
+
+  \note To warp several images with the same transformation, vpImageWarpMap computes the source
+  coordinates only once.
 */
 template <class Type>
 void vpImageTools::warpImage(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst,
                              const vpImageInterpolationType &interpolation,
-                             bool fixedPointArithmetic, bool pixelCenter)
+                             bool fixedPointArithmetic, bool pixelCenter, unsigned int nThreads)
 {
   if ((T.getRows() != 2 && T.getRows() != 3) || T.getCols() != 3) {
     std::cerr << "Input transformation must be a (2x3) or (3x3) matrix." << std::endl;
@@ -1266,18 +1295,18 @@ void vpImageTools::warpImage(const vpImage<Type> &src, const vpMatrix &T, vpImag
     dst.resize(src.getHeight(), src.getWidth(), Type(0));
   }
 
-  vpMatrix M = T;
-  if (affine) {
-    double D = M[0][0] * M[1][1] - M[0][1] * M[1][0];
-    D = !vpMath::nul(D, std::numeric_limits<double>::epsilon()) ? 1.0 / D : 0;
-    double A11 = M[1][1] * D, A22 = M[0][0] * D;
-    M[0][0] = A11; M[0][1] *= -D;
-    M[1][0] *= -D; M[1][1] = A22;
-    double b1 = -M[0][0] * M[0][2] - M[0][1] * M[1][2];
-    double b2 = -M[1][0] * M[0][2] - M[1][1] * M[1][2];
-    M[0][2] = b1; M[1][2] = b2;
-  } else {
-    M = T.inverseByLU();
+  const vpMatrix M = inverseWarp(T);
+
+#if defined _OPENMP
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#else
+  (void)nThreads;
+#endif
+
+  if (fixedPointArithmetic && !pixelCenter && warpRemap(src, M, dst, interp_NN)) {
+    return;
   }
 
   if (fixedPointArithmetic && !pixelCenter) {
@@ -1319,9 +1348,13 @@ void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<T
     int32_t width_1_i32 = static_cast<int32_t>((src.getWidth() - 1) * precision) + 0x8000;
 
     if (affine) {
-      for (unsigned int i = 0; i < dst.getHeight(); i++) {
-        int32_t xi = a2_i32;
-        int32_t yi = a5_i32;
+#if defined _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int i_ = 0; i_ < static_cast<int>(dst.getHeight()); i_++) {
+        const unsigned int i = static_cast<unsigned int>(i_);
+        int32_t xi = a2_i32 + static_cast<int32_t>(i) * a1_i32;
+        int32_t yi = a5_i32 + static_cast<int32_t>(i) * a4_i32;
 
         for (unsigned int j = 0; j < dst.getWidth(); j++) {
           if (yi >= 0 && yi < height_1_i32 && xi >= 0 && xi < width_1_i32) {
@@ -1336,15 +1369,16 @@ void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<T
           xi += a0_i32;
           yi += a3_i32;
         }
-
-        a2_i32 += a1_i32;
-        a5_i32 += a4_i32;
       }
     } else {
-      for (unsigned int i = 0; i < dst.getHeight(); i++) {
-        int64_t xi = a2_i32;
-        int64_t yi = a5_i32;
-        int64_t wi = a8_i32;
+#if defined _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int i_ = 0; i_ < static_cast<int>(dst.getHeight()); i_++) {
+        const unsigned int i = static_cast<unsigned int>(i_);
+        int64_t xi = a2_i32 + static_cast<int64_t>(i) * a1_i32;
+        int64_t yi = a5_i32 + static_cast<int64_t>(i) * a4_i32;
+        int64_t wi = a8_i32 + static_cast<int64_t>(i) * a7_i32;
 
         for (unsigned int j = 0; j < dst.getWidth(); j++) {
           if (wi != 0 && yi >= 0 && yi <= (static_cast<int>(src.getHeight()) - 1)*wi &&
@@ -1363,10 +1397,6 @@ void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<T
           yi += a3_i32;
           wi += a6_i32;
         }
-
-        a2_i32 += a1_i32;
-        a5_i32 += a4_i32;
-        a8_i32 += a7_i32;
       }
     }
   } else {
@@ -1376,7 +1406,11 @@ void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<T
     double a7 = affine ? 0.0 : T[2][1];
     double a8 = affine ? 1.0 : T[2][2];
 
-    for (unsigned int i = 0; i < dst.getHeight(); i++) {
+#if defined _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i_ = 0; i_ < static_cast<int>(dst.getHeight()); i_++) {
+      const unsigned int i = static_cast<unsigned int>(i_);
       for (unsigned int j = 0; j < dst.getWidth(); j++) {
         double x = a0 * (centerCorner ? j + 0.5 : j) + a1 * (centerCorner ? i + 0.5 : i) + a2;
         double y = a3 * (centerCorner ? j + 0.5 : j) + a4 * (centerCorner ? i + 0.5 : i) + a5;
@@ -1423,9 +1457,13 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
     int64_t width_i64 = static_cast<int64_t>(src.getWidth() * precision);
 
     if (affine) {
-      for (unsigned int i = 0; i < dst.getHeight(); i++) {
-        int64_t xi_ = a2_i64;
-        int64_t yi_ = a5_i64;
+#if defined _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int i_ = 0; i_ < static_cast<int>(dst.getHeight()); i_++) {
+        const unsigned int i = static_cast<unsigned int>(i_);
+        int64_t xi_ = a2_i64 + static_cast<int64_t>(i) * a1_i64;
+        int64_t yi_ = a5_i64 + static_cast<int64_t>(i) * a4_i64;
 
         for (unsigned int j = 0; j < dst.getWidth(); j++) {
           if (yi_ >= 0 && yi_ < height_i64 && xi_ >= 0 && xi_ < width_i64) {
@@ -1468,15 +1506,16 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
           xi_ += a0_i64;
           yi_ += a3_i64;
         }
-
-        a2_i64 += a1_i64;
-        a5_i64 += a4_i64;
       }
     } else {
-      for (unsigned int i = 0; i < dst.getHeight(); i++) {
-        int64_t xi = a2_i64;
-        int64_t yi = a5_i64;
-        int64_t wi = a8_i64;
+#if defined _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int i_ = 0; i_ < static_cast<int>(dst.getHeight()); i_++) {
+        const unsigned int i = static_cast<unsigned int>(i_);
+        int64_t xi = a2_i64 + static_cast<int64_t>(i) * a1_i64;
+        int64_t yi = a5_i64 + static_cast<int64_t>(i) * a4_i64;
+        int64_t wi = a8_i64 + static_cast<int64_t>(i) * a7_i64;
 
         for (unsigned int j = 0; j < dst.getWidth(); j++) {
           if (wi != 0 && yi >= 0 && yi <= (static_cast<int>(src.getHeight()) - 1)*wi &&
@@ -1519,10 +1558,6 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
           yi += a3_i64;
           wi += a6_i64;
         }
-
-        a2_i64 += a1_i64;
-        a5_i64 += a4_i64;
-        a8_i64 += a7_i64;
       }
     }
   } else {
@@ -1532,7 +1567,11 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
     double a7 = affine ? 0.0 : T[2][1];
     double a8 = affine ? 1.0 : T[2][2];
 
-    for (unsigned int i = 0; i < dst.getHeight(); i++) {
+#if defined _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i_ = 0; i_ < static_cast<int>(dst.getHeight()); i_++) {
+      const unsigned int i = static_cast<unsigned int>(i_);
       for (unsigned int j = 0; j < dst.getWidth(); j++) {
         double x = a0 * (centerCorner ? j + 0.5 : j) + a1 * (centerCorner ? i + 0.5 : i) + a2;
         double y = a3 * (centerCorner ? j + 0.5 : j) + a4 * (centerCorner ? i + 0.5 : i) + a5;
@@ -1607,9 +1646,13 @@ void vpImageTools::warpLinear(const vpImage<vpRGBa> &src, const vpMatrix &T, vpI
     int64_t width_i64 = static_cast<int64_t>(src.getWidth() * precision);
 
     if (affine) {
-      for (unsigned int i = 0; i < dst.getHeight(); i++) {
-        int64_t xi = a2_i64;
-        int64_t yi = a5_i64;
+#if defined _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int i_ = 0; i_ < static_cast<int>(dst.getHeight()); i_++) {
+        const unsigned int i = static_cast<unsigned int>(i_);
+        int64_t xi = a2_i64 + static_cast<int64_t>(i) * a1_i64;
+        int64_t yi = a5_i64 + static_cast<int64_t>(i) * a4_i64;
 
         for (unsigned int j = 0; j < dst.getWidth(); j++) {
           if (yi >= 0 && yi < height_i64 && xi >= 0 && xi < width_i64) {
@@ -1682,15 +1725,16 @@ void vpImageTools::warpLinear(const vpImage<vpRGBa> &src, const vpMatrix &T, vpI
           xi += a0_i64;
           yi += a3_i64;
         }
-
-        a2_i64 += a1_i64;
-        a5_i64 += a4_i64;
       }
     } else {
-      for (unsigned int i = 0; i < dst.getHeight(); i++) {
-        int64_t xi = a2_i64;
-        int64_t yi = a5_i64;
-        int64_t wi = a8_i64;
+#if defined _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int i_ = 0; i_ < static_cast<int>(dst.getHeight()); i_++) {
+        const unsigned int i = static_cast<unsigned int>(i_);
+        int64_t xi = a2_i64 + static_cast<int64_t>(i) * a1_i64;
+        int64_t yi = a5_i64 + static_cast<int64_t>(i) * a4_i64;
+        int64_t wi = a8_i64 + static_cast<int64_t>(i) * a7_i64;
 
         for (unsigned int j = 0; j < dst.getWidth(); j++) {
           if (yi >= 0 && yi <= (static_cast<int>(src.getHeight()) - 1)*wi &&
@@ -1757,10 +1801,6 @@ void vpImageTools::warpLinear(const vpImage<vpRGBa> &src, const vpMatrix &T, vpI
           yi += a3_i64;
           wi += a6_i64;
         }
-
-        a2_i64 += a1_i64;
-        a5_i64 += a4_i64;
-        a8_i64 += a7_i64;
       }
     }
   } else {
@@ -1770,7 +1810,11 @@ void vpImageTools::warpLinear(const vpImage<vpRGBa> &src, const vpMatrix &T, vpI
     double a7 = affine ? 0.0 : T[2][1];
     double a8 = affine ? 1.0 : T[2][2];
 
-    for (unsigned int i = 0; i < dst.getHeight(); i++) {
+#if defined _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i_ = 0; i_ < static_cast<int>(dst.getHeight()); i_++) {
+      const unsigned int i = static_cast<unsigned int>(i_);
       for (unsigned int j = 0; j < dst.getWidth(); j++) {
         double x = a0 * (centerCorner ? j + 0.5 : j) + a1 * (centerCorner ? i + 0.5 : i) + a2;
         double y = a3 * (centerCorner ? j + 0.5 : j) + a4 * (centerCorner ? i + 0.5 : i) + a5;
@@ -0,0 +1,131 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Reusable image undistortion with a precomputed remap table.
+ *
+ *****************************************************************************/
+
+
+/*!
+  \file vpImageUndistort.h
+  \brief Reusable image undistortion with a precomputed remap table
+*/
+
+#ifndef vpImageUndistort_H
+#define vpImageUndistort_H
+
+#include <vector>
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+
+/*!
+  \class vpImageUndistort
+
+  \ingroup group_core_image
+
+  \brief Undistort a stream of images acquired by the same camera.
+
+  The remap table is computed once by init() for the projection model of the
+  camera parameters (perspective projection with or without distortion, or
+  Kannala-Brandt distortion). For each destination pixel it stores the offset
+  of the top-left source pixel used by the bilinear interpolation, and the two
+  interpolation weights quantized on 7 bits. undistort() then reduces to a
+  fixed-point bilinear gather over the table, vectorized with SSE2 when
+  available and split by bands of rows over a pool of threads that is created
+  once and kept alive for the lifetime of the object.
+
+  Compared to vpImageTools::undistort(), no pixel coordinate is recomputed and
+  no thread is created per image. Destination pixels whose source location
+  falls outside the image are set to 0.
+
+  \code
+#include <visp3/core/vpImageUndistort.h>
+
+int main()
+{
+  vpCameraParameters cam;
+  cam.initPersProjWithDistortion(600, 600, 320, 240, -0.2, 0.2);
+
+  vpImage<unsigned char> I(480, 640), Iundist;
+  vpImageUndistort undistort(cam, I.getWidth(), I.getHeight());
+  for (int i = 0; i < 100; i++) {
+    // acquire I
+    undistort.undistort(I, Iundist);
+  }
+}
+  \endcode
+
+  The pool of threads requires C++11. Without C++11, the bands are processed
+  with OpenMP if available.
+*/
+class VISP_EXPORT vpImageUndistort
+{
+public:
+  vpImageUndistort();
+  vpImageUndistort(const vpCameraParameters &cam, unsigned int width, unsigned int height, unsigned int nThreads = 0);
+  virtual ~vpImageUndistort();
+
+  //! Return the height of the images that can be undistorted.
+  inline unsigned int getHeight() const { return m_height; }
+  //! Return the number of threads used by undistort().
+  inline unsigned int getNbThreads() const { return m_nbThreads; }
+  //! Return the width of the images that can be undistorted.
+  inline unsigned int getWidth() const { return m_width; }
+
+  void init(const vpCameraParameters &cam, unsigned int width, unsigned int height);
+
+  void setNbThreads(unsigned int nThreads);
+
+  void undistort(const vpImage<unsigned char> &I, vpImage<unsigned char> &Iundist);
+  void undistort(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Iundist);
+
+private:
+  vpImageUndistort(const vpImageUndistort &);            // non copyable
+  vpImageUndistort &operator=(const vpImageUndistort &); // non copyable
+
+  class vpWorkerPool;
+  class vpRemapJob;
+
+  void run(vpRemapJob &job);
+
+  unsigned int m_width;
+  unsigned int m_height;
+  unsigned int m_nbThreads;
+  //! Offset of the top-left source pixel of each destination pixel, -1 if outside the source image
+  std::vector<int> m_offsets;
+  //! Horizontal weight in the low byte and vertical weight in the high byte, in [0, 128]
+  std::vector<unsigned short> m_weights;
+  vpWorkerPool *m_pool;
+};
+
+#endif
@@ -0,0 +1,285 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Non-owning strided view over an image.
+ *
+ *****************************************************************************/
+
+#ifndef vpImageView_h
+#define vpImageView_h
+
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpRect.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace vpImageViewDetail
+{
+// Pixel type without const qualifier, and byte type with the constness of the pixel type
+template <class Type> struct Traits {
+  typedef Type value_type;
+  typedef unsigned char byte_type;
+};
+template <class Type> struct Traits<const Type> {
+  typedef Type value_type;
+  typedef const unsigned char byte_type;
+};
+} // namespace vpImageViewDetail
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  \class vpImageView
+
+  \ingroup group_core_image
+
+  \brief Non-owning view over a rectangular area of an image whose rows are
+  separated by an arbitrary number of bytes (the step).
+
+  Contrary to vpImage, where the rows are always contiguous, a view can
+  describe a region of interest of a larger image or a camera buffer whose
+  rows are padded, without copying any pixel. The pixel at row \e i and
+  column \e j is located at address \e origin + \e i * \e step bytes + \e j.
+  The caller has to ensure that the viewed memory outlives the view.
+
+  A vpImageView<Type> gives write access to the pixels and can only be built
+  over non-constant memory. A vpImageView<const Type> is a read-only view,
+  that can also be built over a constant image; this is the type taken by the
+  functions that accept a view as input. A vpImageView<Type> is implicitly
+  converted to a vpImageView<const Type>.
+
+  \code
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpImageView.h>
+
+void process(const vpImage<unsigned char> &I)
+{
+  // 640x480 region of interest of a 4K image, no copy
+  vpImageView<const unsigned char> roi(I, vpRect(1000, 800, 640, 480));
+  unsigned char first = roi[0][0]; // I[800][1000]
+
+  // Resize and filter the region of interest without cropping it first
+  vpImage<unsigned char> Ires(240, 320);
+  vpImageTools::resize(roi, Ires, vpImageTools::INTERPOLATION_LINEAR);
+  vpImage<float> Iblur;
+  vpImageFilter::gaussianBlur(roi, Iblur);
+}
+  \endcode
+
+  A view over a cv::Mat whose rows are not continuous is obtained with
+  <tt>vpImageView<unsigned char>(mat.data, mat.rows, mat.cols, mat.step)</tt>.
+*/
+template <class Type> class vpImageView
+{
+  template <class OtherType> friend class vpImageView;
+
+public:
+  //! Pixel type without const qualifier.
+  typedef typename vpImageViewDetail::Traits<Type>::value_type value_type;
+
+  //! Default constructor: empty view.
+  vpImageView() : m_origin(NULL), m_height(0), m_width(0), m_step(0) {}
+
+  /*!
+    Create a view over existing memory.
+
+    \param origin : Address of the top left pixel.
+    \param height : Number of rows.
+    \param width : Number of columns.
+    \param step : Number of bytes between the beginning of two consecutive
+    rows. Must be at least \e width * sizeof(Type).
+  */
+  vpImageView(Type *origin, unsigned int height, unsigned int width, size_t step)
+    : m_origin(reinterpret_cast<byte_type *>(origin)), m_height(height), m_width(width), m_step(step)
+  {
+    if (step < width * sizeof(Type)) {
+      throw vpException(vpException::dimensionError, "Step (%d bytes) is lower than the row size (%d bytes)",
+                        static_cast<int>(step), static_cast<int>(width * sizeof(Type)));
+    }
+  }
+
+  //! Create a view over a whole image.
+  explicit vpImageView(vpImage<value_type> &I)
+    : m_origin(reinterpret_cast<byte_type *>(I.bitmap)), m_height(I.getHeight()), m_width(I.getWidth()),
+      m_step(I.getWidth() * sizeof(Type))
+  {
+  }
+
+  /*!
+    Create a view over a whole constant image. Only available for the
+    read-only views vpImageView<const Type>.
+  */
+  explicit vpImageView(const vpImage<value_type> &I)
+    : m_origin(toBytes(I.bitmap)), m_height(I.getHeight()), m_width(I.getWidth()),
+      m_step(I.getWidth() * sizeof(Type))
+  {
+  }
+
+  /*!
+    Create a view over a region of interest of an image. The region of
+    interest is clipped to the image.
+
+    \param I : Viewed image.
+    \param roi : Region of interest. Its top left corner is rounded down and
+    its size is rounded to the nearest integer.
+  */
+  vpImageView(vpImage<value_type> &I, const vpRect &roi) : m_origin(NULL), m_height(0), m_width(0), m_step(0)
+  {
+    *this = vpImageView<Type>(I).getView(roi);
+  }
+
+  /*!
+    Create a view over a region of interest of a constant image, as
+    vpImageView(vpImage<value_type> &, const vpRect &) does. Only available
+    for the read-only views vpImageView<const Type>.
+  */
+  vpImageView(const vpImage<value_type> &I, const vpRect &roi) : m_origin(NULL), m_height(0), m_width(0), m_step(0)
+  {
+    *this = vpImageView<Type>(I).getView(roi);
+  }
+
+  /*!
+    Copy constructor, that also converts a vpImageView<value_type> into a
+    read-only vpImageView<const value_type>.
+  */
+  vpImageView(const vpImageView<value_type> &view)
+    : m_origin(view.m_origin), m_height(view.m_height), m_width(view.m_width), m_step(view.m_step)
+  {
+  }
+
+  /*!
+    Copy assignment, that also assigns a vpImageView<value_type> to a
+    read-only vpImageView<const value_type>.
+  */
+  vpImageView &operator=(const vpImageView<value_type> &view)
+  {
+    m_origin = view.m_origin;
+    m_height = view.m_height;
+    m_width = view.m_width;
+    m_step = view.m_step;
+    return *this;
+  }
+
+  /*!
+    Return the view over a region of interest of this view, clipped to the
+    view.
+  */
+  vpImageView<Type> getView(const vpRect &roi) const
+  {
+    int top = static_cast<int>(std::floor(roi.getTop()));
+    int left = static_cast<int>(std::floor(roi.getLeft()));
+    int bottom = top + vpMath::round(roi.getHeight());
+    int right = left + vpMath::round(roi.getWidth());
+
+    top = (std::max)(0, (std::min)(top, static_cast<int>(m_height)));
+    left = (std::max)(0, (std::min)(left, static_cast<int>(m_width)));
+    bottom = (std::max)(top, (std::min)(bottom, static_cast<int>(m_height)));
+    right = (std::max)(left, (std::min)(right, static_cast<int>(m_width)));
+
+    vpImageView<Type> view;
+    if (bottom > top && right > left) {
+      view.m_origin = m_origin + static_cast<size_t>(top) * m_step + static_cast<size_t>(left) * sizeof(Type);
+      view.m_height = static_cast<unsigned int>(bottom - top);
+      view.m_width = static_cast<unsigned int>(right - left);
+      view.m_step = m_step;
+    }
+    return view;
+  }
+
+  //! Return the number of rows.
+  inline unsigned int getHeight() const { return m_height; }
+  //! Return the number of columns.
+  inline unsigned int getWidth() const { return m_width; }
+  //! Return the number of rows.
+  inline unsigned int getRows() const { return m_height; }
+  //! Return the number of columns.
+  inline unsigned int getCols() const { return m_width; }
+  //! Return the number of pixels.
+  inline unsigned int getSize() const { return m_height * m_width; }
+  //! Return the number of bytes between the beginning of two consecutive rows.
+  inline size_t getStep() const { return m_step; }
+
+  //! Return true if the view does not contain any pixel.
+  inline bool empty() const { return m_height == 0 || m_width == 0; }
+  //! Return true if there is no padding between the rows.
+  inline bool isContinuous() const { return m_step == m_width * sizeof(Type); }
+
+  //! Return the address of the first pixel of row \e i.
+  inline Type *operator[](unsigned int i) { return reinterpret_cast<Type *>(m_origin + i * m_step); }
+  //! Return the address of the first pixel of row \e i.
+  inline const Type *operator[](unsigned int i) const
+  {
+    return reinterpret_cast<const Type *>(m_origin + i * m_step);
+  }
+
+  //! Return the pixel at row \e i and column \e j.
+  inline value_type operator()(unsigned int i, unsigned int j) const { return (*this)[i][j]; }
+
+  /*!
+    Copy the viewed pixels into an image, which is resized to the size of the
+    view. The image must not overlap the view.
+  */
+  void copyTo(vpImage<value_type> &I) const
+  {
+    I.resize(m_height, m_width);
+    if (isContinuous()) {
+      if (!empty()) {
+        memcpy(static_cast<void *>(I.bitmap), m_origin, getSize() * sizeof(Type));
+      }
+    } else {
+      for (unsigned int i = 0; i < m_height; i++) {
+        memcpy(static_cast<void *>(I[i]), (*this)[i], m_width * sizeof(Type));
+      }
+    }
+  }
+
+private:
+  typedef typename vpImageViewDetail::Traits<Type>::byte_type byte_type;
+
+  // Does not compile for the views that give write access to the pixels
+  static inline byte_type *toBytes(const value_type *ptr) { return reinterpret_cast<byte_type *>(ptr); }
+
+  //! Address of the top left pixel
+  byte_type *m_origin;
+  //! Number of rows
+  unsigned int m_height;
+  //! Number of columns
+  unsigned int m_width;
+  //! Number of bytes between two rows
+  size_t m_step;
+};
+
+#endif
@@ -0,0 +1,119 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Precomputed warp of images by a fixed transformation.
+ *
+ *****************************************************************************/
+
+
+/*!
+  \file vpImageWarpMap.h
+  \brief Precomputed warp of images by a fixed transformation
+*/
+
+#ifndef vpImageWarpMap_H
+#define vpImageWarpMap_H
+
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpRGBa.h>
+
+/*!
+  \class vpImageWarpMap
+
+  \ingroup group_core_image
+
+  \brief Warp several images with the same affine or perspective transformation.
+
+  init() computes once, for each output pixel, the offset of its source pixel
+  and the fixed-point interpolation weights, as done row by row by
+  vpImageTools::warpImage() with fixed-point arithmetic. warp() then only
+  gathers and interpolates the source pixels, by bands of rows in parallel.
+
+  \code
+#include <visp3/core/vpImageWarpMap.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640), I_rectified;
+  vpMatrix H(3, 3);
+  H.eye();
+  H[0][2] = 10;
+
+  vpImageWarpMap map(H, I.getHeight(), I.getWidth(), 200, 200, vpImageTools::INTERPOLATION_LINEAR);
+  for (int i = 0; i < 100; i++) {
+    // acquire I
+    map.warp(I, I_rectified);
+  }
+}
+  \endcode
+*/
+class VISP_EXPORT vpImageWarpMap
+{
+public:
+  vpImageWarpMap();
+  vpImageWarpMap(const vpMatrix &T, unsigned int srcHeight, unsigned int srcWidth, unsigned int dstHeight,
+                 unsigned int dstWidth,
+                 const vpImageTools::vpImageInterpolationType &interpolation = vpImageTools::INTERPOLATION_LINEAR,
+                 bool pixelCenter = false);
+
+  //! Return the height of the warped images.
+  inline unsigned int getDstHeight() const { return m_dstHeight; }
+  //! Return the width of the warped images.
+  inline unsigned int getDstWidth() const { return m_dstWidth; }
+  //! Return the height of the images to warp.
+  inline unsigned int getSrcHeight() const { return m_srcHeight; }
+  //! Return the width of the images to warp.
+  inline unsigned int getSrcWidth() const { return m_srcWidth; }
+
+  void init(const vpMatrix &T, unsigned int srcHeight, unsigned int srcWidth, unsigned int dstHeight,
+            unsigned int dstWidth,
+            const vpImageTools::vpImageInterpolationType &interpolation = vpImageTools::INTERPOLATION_LINEAR,
+            bool pixelCenter = false);
+
+  void warp(const vpImage<unsigned char> &src, vpImage<unsigned char> &dst, unsigned int nThreads = 0) const;
+  void warp(const vpImage<vpRGBa> &src, vpImage<vpRGBa> &dst, unsigned int nThreads = 0) const;
+
+private:
+  unsigned int m_srcWidth;
+  unsigned int m_srcHeight;
+  unsigned int m_dstWidth;
+  unsigned int m_dstHeight;
+  //! Offset of the top-left source pixel of each output pixel, -1 if outside the source image
+  std::vector<int> m_offsets;
+  //! Horizontal weight in the low byte and vertical weight in the high byte
+  std::vector<unsigned short> m_weights;
+};
+
+#endif
@@ -438,6 +438,11 @@ vpMatrix M(R);
 
   vpMatrix AtA() const;
   void AtA(vpMatrix &B) const;
+  void AtA(const vpColVector &w, vpMatrix &B) const;
+
+  vpColVector Atb(const vpColVector &b) const;
+  void Atb(const vpColVector &b, vpColVector &c) const;
+  void Atb(const vpColVector &w, const vpColVector &b, vpColVector &c) const;
   //@}
 
   //-------------------------------------------------
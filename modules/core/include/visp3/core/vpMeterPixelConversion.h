@@ -83,6 +83,8 @@ public:
                              vpImagePoint &center_p, double &n20_p, double &n11_p, double &n02_p);
   static void convertLine(const vpCameraParameters &cam, const double &rho_m, const double &theta_m, double &rho_p,
                           double &theta_p);
+  static void convertPoints(const vpCameraParameters &cam, const double *x, const double *y, double *u, double *v,
+                            unsigned int n);
 
   /*!
 
@@ -271,27 +273,8 @@ public:
     \f$ v = y_d*p_y+v_0 \f$
     with \f$ r^2 = x^2+y^2 \f$
   */
-  inline static void convertPointWithKannalaBrandtDistortion(const vpCameraParameters &cam, const double &x, const double &y,
-                                                             double &u, double &v)
-  {
-    double r = sqrt(vpMath::sqr(x) + vpMath::sqr(y));
-    double theta = atan(r);
-
-    std::vector<double> k = cam.getKannalaBrandtDistortionCoefficients();
-
-    double theta2 = theta*theta, theta3 = theta2*theta, theta4 = theta2*theta2, theta5 = theta4*theta,
-          theta6 = theta3*theta3, theta7 = theta6*theta, theta8 = theta4*theta4, theta9 = theta8*theta;
-
-    double r_d = theta + k[0]*theta3 + k[1]*theta5 + k[2]*theta7 + k[3]*theta9;
-
-    double scale = (std::fabs(r) < std::numeric_limits<double>::epsilon()) ? 1.0 : r_d / r;
-
-    double x_d = x * scale;
-    double y_d = y * scale;
-
-    u = cam.px * x_d + cam.u0;
-    v = cam.py * y_d + cam.v0;
-  }
+  static void convertPointWithKannalaBrandtDistortion(const vpCameraParameters &cam, const double &x, const double &y,
+                                                      double &u, double &v);
 
   /*!
     Point coordinates conversion with Kannala-Brandt distortion from
@@ -317,23 +300,10 @@ public:
   inline static void convertPointWithKannalaBrandtDistortion(const vpCameraParameters &cam, const double &x, const double &y,
                                                              vpImagePoint &iP)
   {
-    double r = sqrt(vpMath::sqr(x) + vpMath::sqr(y));
-    double theta = atan(r);
-
-    std::vector<double> k = cam.getKannalaBrandtDistortionCoefficients();
-
-    double theta2 = theta*theta, theta3 = theta2*theta, theta4 = theta2*theta2, theta5 = theta4*theta,
-          theta6 = theta3*theta3, theta7 = theta6*theta, theta8 = theta4*theta4, theta9 = theta8*theta;
-
-    double r_d = theta + k[0]*theta3 + k[1]*theta5 + k[2]*theta7 + k[3]*theta9;
-
-    double scale = (std::fabs(r) < std::numeric_limits<double>::epsilon()) ? 1.0 : r_d / r;
-
-    double x_d = x * scale;
-    double y_d = y * scale;
-
-    iP.set_u(cam.px * x_d + cam.u0);
-    iP.set_v(cam.py * y_d + cam.v0);
+    double u, v;
+    convertPointWithKannalaBrandtDistortion(cam, x, y, u, v);
+    iP.set_u(u);
+    iP.set_v(v);
   }
 
 #endif // #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -81,6 +81,8 @@ public:
 
   static void convertMoment(const vpCameraParameters &cam, unsigned int order, const vpMatrix &moment_pixel,
                             vpMatrix &moment_meter);
+  static void convertPoints(const vpCameraParameters &cam, const double *u, const double *v, double *x, double *y,
+                            unsigned int n);
   /*!
     Point coordinates conversion from pixel coordinates
     \f$(u,v)\f$ to normalized coordinates \f$(x,y)\f$ in meter using ViSP camera parameters.
@@ -274,42 +276,8 @@ public:
     \f$ x   = x_d * scale \f$
     \f$ y   = y_d * scale \f$
   */
-  inline static void convertPointWithKannalaBrandtDistortion(const vpCameraParameters &cam, const double &u,
-                                                             const double &v, double &x, double &y)
-  {
-    double x_d = (u - cam.u0) / cam.px, y_d = (v - cam.v0) / cam.py;
-    double scale = 1.0;
-    double r_d = sqrt(vpMath::sqr(x_d) + vpMath::sqr(y_d));
-
-    r_d = std::min(std::max(-M_PI, r_d), M_PI); // FOV restricted to 180degrees.
-
-    std::vector<double> k = cam.getKannalaBrandtDistortionCoefficients();
-
-    const double EPS = 1e-8;
-    // Use Newton-Raphson method to solve for the angle theta
-    if (r_d > EPS)
-    {
-      // compensate distortion iteratively
-      double theta = r_d;
-
-      for (int j = 0; j < 10; j++)
-      {
-        double theta2 = theta*theta, theta4 = theta2*theta2, theta6 = theta4*theta2, theta8 = theta6*theta2;
-        double k0_theta2 = k[0] * theta2, k1_theta4 = k[1] * theta4, k2_theta6 = k[2] * theta6, k3_theta8 = k[3] * theta8;
-        /* new_theta = theta - theta_fix, theta_fix = f0(theta) / f0'(theta) */
-        double theta_fix = (theta * (1 + k0_theta2 + k1_theta4 + k2_theta6 + k3_theta8) - r_d) /
-                            (1 + 3*k0_theta2 + 5*k1_theta4 + 7*k2_theta6 + 9*k3_theta8);
-        theta = theta - theta_fix;
-        if (fabs(theta_fix) < EPS)
-            break;
-      }
-
-      scale = std::tan(theta) / r_d; // Scale of norm of (x,y) and (x_d, y_d)
-    }
-
-    x = x_d * scale;
-    y = y_d * scale;
-  }
+  static void convertPointWithKannalaBrandtDistortion(const vpCameraParameters &cam, const double &u, const double &v,
+                                                      double &x, double &y);
 
   /*!
     Point coordinates conversion with Kannala-Brandt distortion from pixel
@@ -333,38 +301,7 @@ public:
   inline static void convertPointWithKannalaBrandtDistortion(const vpCameraParameters &cam, const vpImagePoint &iP,
                                                              double &x, double &y)
   {
-    double x_d = (iP.get_u() - cam.u0) / cam.px, y_d = (iP.get_v() - cam.v0) / cam.py;
-    double scale = 1.0;
-    double r_d = sqrt(vpMath::sqr(x_d) + vpMath::sqr(y_d));
-
-    r_d = std::min(std::max(-M_PI, r_d), M_PI); // FOV restricted to 180degrees.
-
-    std::vector<double> k = cam.getKannalaBrandtDistortionCoefficients();
-
-    const double EPS = 1e-8;
-    // Use Newton-Raphson method to solve for the angle theta
-    if (r_d > EPS)
-    {
-      // compensate distortion iteratively
-      double theta = r_d;
-
-      for (int j = 0; j < 10; j++)
-      {
-        double theta2 = theta*theta, theta4 = theta2*theta2, theta6 = theta4*theta2, theta8 = theta6*theta2;
-        double k0_theta2 = k[0] * theta2, k1_theta4 = k[1] * theta4, k2_theta6 = k[2] * theta6, k3_theta8 = k[3] * theta8;
-        /* new_theta = theta - theta_fix, theta_fix = f0(theta) / f0'(theta) */
-        double theta_fix = (theta * (1 + k0_theta2 + k1_theta4 + k2_theta6 + k3_theta8) - r_d) /
-                            (1 + 3*k0_theta2 + 5*k1_theta4 + 7*k2_theta6 + 9*k3_theta8);
-        theta = theta - theta_fix;
-        if (fabs(theta_fix) < EPS)
-            break;
-      }
-
-      scale = std::tan(theta) / r_d; // Scale of norm of (x,y) and (x_d, y_d)
-    }
-
-    x = x_d * scale;
-    y = y_d * scale;
+    convertPointWithKannalaBrandtDistortion(cam, iP.get_u(), iP.get_v(), x, y);
   }
 #endif // #ifndef DOXYGEN_SHOULD_SKIP_THIS
   //@}
@@ -0,0 +1,120 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Precomputed normalized coordinates of the pixels of an image.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpPixelMeterMap.h
+  \brief Precomputed normalized coordinates of the pixels of an image
+*/
+
+#ifndef vpPixelMeterMap_H
+#define vpPixelMeterMap_H
+
+#include <vector>
+
+#include <visp3/core/vpCameraParameters.h>
+
+/*!
+  \class vpPixelMeterMap
+
+  \ingroup group_core_camera
+
+  \brief Look-up table of the normalized coordinates \f$(x,y)\f$ in meter of
+  each pixel of an image, for a fixed camera.
+
+  With the Kannala-Brandt model, the conversion from pixel to meter solves an
+  equation by Newton-Raphson for each point. init() computes the coordinates
+  of all the pixels once; convertPoints() then interpolates them bilinearly,
+  and convertPoint() reads the ones of an integer pixel. Points outside the
+  image are converted with vpPixelMeterConversion.
+
+  \code
+#include <visp3/core/vpPixelMeterMap.h>
+
+int main()
+{
+  std::vector<double> k(4, 0.01);
+  vpCameraParameters cam;
+  cam.initProjWithKannalaBrandtDistortion(300, 300, 320, 240, k);
+
+  vpPixelMeterMap map(cam, 480, 640);
+  std::vector<double> u(100, 100.5), v(100, 50.25), x(100), y(100);
+  for (int i = 0; i < 100; i++) {
+    // track u, v
+    map.convertPoints(&u[0], &v[0], &x[0], &y[0], 100);
+  }
+}
+  \endcode
+*/
+class VISP_EXPORT vpPixelMeterMap
+{
+public:
+  vpPixelMeterMap();
+  vpPixelMeterMap(const vpCameraParameters &cam, unsigned int height, unsigned int width);
+
+  /*!
+    Return the normalized coordinates of the pixel (i, j), which must be
+    inside the image.
+
+    \param[in] i : row of the pixel.
+    \param[in] j : column of the pixel.
+    \param[out] x : output coordinate in meter along image plane x-axis.
+    \param[out] y : output coordinate in meter along image plane y-axis.
+  */
+  inline void convertPoint(unsigned int i, unsigned int j, double &x, double &y) const
+  {
+    x = m_x[i * m_width + j];
+    y = m_y[i * m_width + j];
+  }
+  void convertPoints(const double *u, const double *v, double *x, double *y, unsigned int n) const;
+
+  //! Return the camera parameters of the table.
+  inline const vpCameraParameters &getCameraParameters() const { return m_cam; }
+  //! Return the height of the image.
+  inline unsigned int getHeight() const { return m_height; }
+  //! Return the width of the image.
+  inline unsigned int getWidth() const { return m_width; }
+
+  void init(const vpCameraParameters &cam, unsigned int height, unsigned int width);
+
+private:
+  vpCameraParameters m_cam;
+  unsigned int m_height;
+  unsigned int m_width;
+  //! Normalized coordinates of each pixel, row by row
+  std::vector<double> m_x;
+  std::vector<double> m_y;
+};
+
+#endif
@@ -0,0 +1,253 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Organized point cloud stored as contiguous X, Y, Z planes.
+ *
+ *****************************************************************************/
+
+#ifndef vpPointCloud_h
+#define vpPointCloud_h
+
+#include <vector>
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpException.h>
+
+/*!
+  \class vpPointCloud
+
+  \ingroup group_core_image
+
+  \brief Organized point cloud where the X, Y and Z coordinates are stored
+  in three contiguous planes of size width x height.
+
+  Compared to a std::vector<vpColVector>, where each 3D point is a separate
+  heap allocation, the coordinates of all the points are here stored in a
+  single memory block (structure of arrays). The point at row \e i and
+  column \e j of the depth image is located at index \e i * width + \e j in
+  each plane. Points without valid depth have a Z coordinate lower or equal
+  to 0.
+
+  The point cloud either owns its memory, or is a view over three planes
+  allocated elsewhere (for instance by a sensor SDK). In the latter case, no
+  copy is done and the caller has to ensure that the planes outlive the view.
+  Copying a view produces another view over the same planes.
+
+  \code
+#include <visp3/core/vpPointCloud.h>
+
+int main()
+{
+  // Owning point cloud
+  vpPointCloud<float> pointcloud(480, 640);
+  float *X = pointcloud.getX();
+  float *Y = pointcloud.getY();
+  float *Z = pointcloud.getZ();
+  for (unsigned int i = 0; i < pointcloud.getHeight(); i++) {
+    for (unsigned int j = 0; j < pointcloud.getWidth(); j++) {
+      unsigned int idx = i * pointcloud.getWidth() + j;
+      X[idx] = 0.f;
+      Y[idx] = 0.f;
+      Z[idx] = 1.f;
+    }
+  }
+
+  // Zero-copy view over the same data
+  vpPointCloud<float> view(X, Y, Z, pointcloud.getHeight(), pointcloud.getWidth());
+}
+  \endcode
+*/
+template <class Type> class vpPointCloud
+{
+public:
+  //! Default constructor: empty point cloud.
+  vpPointCloud() : m_data(), m_X(NULL), m_Y(NULL), m_Z(NULL), m_height(0), m_width(0), m_isView(false) {}
+
+  /*!
+    Create an owning point cloud with \e height x \e width points. All the
+    coordinates are set to 0, meaning that the points are invalid.
+  */
+  vpPointCloud(unsigned int height, unsigned int width)
+    : m_data(), m_X(NULL), m_Y(NULL), m_Z(NULL), m_height(0), m_width(0), m_isView(false)
+  {
+    resize(height, width);
+  }
+
+  /*!
+    Create a point cloud that is a view over existing X, Y and Z planes.
+    No memory is allocated nor copied.
+
+    \param X : Pointer to the \e height x \e width X coordinates.
+    \param Y : Pointer to the \e height x \e width Y coordinates.
+    \param Z : Pointer to the \e height x \e width Z coordinates.
+    \param height : Number of rows of the organized point cloud.
+    \param width : Number of columns of the organized point cloud.
+  */
+  vpPointCloud(Type *X, Type *Y, Type *Z, unsigned int height, unsigned int width)
+    : m_data(), m_X(X), m_Y(Y), m_Z(Z), m_height(height), m_width(width), m_isView(true)
+  {
+  }
+
+  //! Copy constructor. The data are copied, unless \e pointcloud is a view.
+  vpPointCloud(const vpPointCloud<Type> &pointcloud)
+    : m_data(), m_X(NULL), m_Y(NULL), m_Z(NULL), m_height(0), m_width(0), m_isView(false)
+  {
+    *this = pointcloud;
+  }
+
+  //! Copy operator. The data are copied, unless \e pointcloud is a view.
+  vpPointCloud<Type> &operator=(const vpPointCloud<Type> &pointcloud)
+  {
+    if (this != &pointcloud) {
+      m_height = pointcloud.m_height;
+      m_width = pointcloud.m_width;
+      m_isView = pointcloud.m_isView;
+      if (m_isView) {
+        m_data.clear();
+        m_X = pointcloud.m_X;
+        m_Y = pointcloud.m_Y;
+        m_Z = pointcloud.m_Z;
+      } else {
+        m_data = pointcloud.m_data;
+        updatePlanes();
+      }
+    }
+    return *this;
+  }
+
+  /*!
+    Fill the point cloud from a legacy vector of 3D points, each point being
+    a vpColVector containing at least the X, Y and Z coordinates.
+
+    \param pointcloud : Vector of \e height x \e width points.
+    \param height : Number of rows of the organized point cloud.
+    \param width : Number of columns of the organized point cloud.
+  */
+  void buildFrom(const std::vector<vpColVector> &pointcloud, unsigned int height, unsigned int width)
+  {
+    if (pointcloud.size() != static_cast<size_t>(height) * width) {
+      throw vpException(vpException::dimensionError, "Point cloud size (%d) is not equal to %dx%d",
+                        static_cast<int>(pointcloud.size()), height, width);
+    }
+
+    resize(height, width);
+    for (size_t i = 0; i < pointcloud.size(); i++) {
+      m_X[i] = static_cast<Type>(pointcloud[i][0]);
+      m_Y[i] = static_cast<Type>(pointcloud[i][1]);
+      m_Z[i] = static_cast<Type>(pointcloud[i][2]);
+    }
+  }
+
+  //! Return the height (number of rows) of the organized point cloud.
+  inline unsigned int getHeight() const { return m_height; }
+  //! Return the width (number of columns) of the organized point cloud.
+  inline unsigned int getWidth() const { return m_width; }
+  //! Return the number of points, that is width x height.
+  inline unsigned int size() const { return m_height * m_width; }
+
+  //! Return the plane of X coordinates.
+  inline Type *getX() { return m_X; }
+  //! Return the plane of X coordinates.
+  inline const Type *getX() const { return m_X; }
+  //! Return the plane of Y coordinates.
+  inline Type *getY() { return m_Y; }
+  //! Return the plane of Y coordinates.
+  inline const Type *getY() const { return m_Y; }
+  //! Return the plane of Z coordinates.
+  inline Type *getZ() { return m_Z; }
+  //! Return the plane of Z coordinates.
+  inline const Type *getZ() const { return m_Z; }
+
+  //! Return true if the point cloud does not own its data.
+  inline bool isView() const { return m_isView; }
+
+  /*!
+    Resize the point cloud. If the point cloud was a view, it becomes an
+    owning point cloud. The memory is reused when the number of points is
+    unchanged, otherwise all the coordinates are set to 0.
+  */
+  void resize(unsigned int height, unsigned int width)
+  {
+    size_t npts = static_cast<size_t>(height) * width;
+    if (m_isView || m_data.size() != 3 * npts) {
+      m_data.assign(3 * npts, Type(0));
+    }
+    m_height = height;
+    m_width = width;
+    m_isView = false;
+    updatePlanes();
+  }
+
+  /*!
+    Convert to the legacy representation where each point is a vpColVector
+    containing the X, Y, Z coordinates.
+  */
+  void toColVectors(std::vector<vpColVector> &pointcloud) const
+  {
+    pointcloud.resize(size());
+    for (size_t i = 0; i < pointcloud.size(); i++) {
+      pointcloud[i].resize(3, false);
+      pointcloud[i][0] = static_cast<double>(m_X[i]);
+      pointcloud[i][1] = static_cast<double>(m_Y[i]);
+      pointcloud[i][2] = static_cast<double>(m_Z[i]);
+    }
+  }
+
+private:
+  void updatePlanes()
+  {
+    if (m_data.empty()) {
+      m_X = m_Y = m_Z = NULL;
+    } else {
+      size_t npts = m_data.size() / 3;
+      m_X = &m_data[0];
+      m_Y = m_X + npts;
+      m_Z = m_Y + npts;
+    }
+  }
+
+  //! Storage of the X, Y, Z planes when the point cloud owns its data
+  std::vector<Type> m_data;
+  //! X coordinates
+  Type *m_X;
+  //! Y coordinates
+  Type *m_Y;
+  //! Z coordinates
+  Type *m_Z;
+  //! Number of rows
+  unsigned int m_height;
+  //! Number of columns
+  unsigned int m_width;
+  //! True if the planes are not owned by the point cloud
+  bool m_isView;
+};
+
+#endif
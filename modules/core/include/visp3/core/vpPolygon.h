@@ -42,6 +42,7 @@
 #define vpPolygon_h
 
 #include <list>
+#include <utility>
 #include <vector>
 
 #include <visp3/core/vpCameraParameters.h>
@@ -142,6 +143,7 @@ public:
                  unsigned int thickness = 1);
 
   bool isInside(const vpImagePoint &iP, const PointInPolygonMethod &method = PnPolyRayCasting) const;
+  void getRowSpans(int i, std::vector<std::pair<int, int> > &spans) const;
 
   void display(const vpImage<unsigned char> &I, const vpColor &color, unsigned int thickness = 1) const;
 
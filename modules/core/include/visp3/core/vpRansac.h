@@ -66,7 +66,7 @@
   pk at csse uwa edu au
   http://www.csse.uwa.edu.au/~pk
 
-  \sa vpHomography
+  \sa vpHomography, vpRansacEngine
 
  */
 template <class vpTransformation> class vpRansac
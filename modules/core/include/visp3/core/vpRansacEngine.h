@@ -0,0 +1,661 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Generic RANSAC estimator.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpRansacEngine.h
+  \brief Generic RANSAC estimator, templated on the model to fit.
+*/
+
+#ifndef vpRansacEngine_h
+#define vpRansacEngine_h
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpUniRand.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#endif
+
+/*!
+  \class vpRansacEngine
+  \ingroup group_core_robust
+
+  \brief Generic RANSAC \cite Fischler81 estimator, templated on the model to fit.
+
+  Unlike vpRansac, the data are not copied in a vpColVector: they are owned by the model, that scores a hypothesis
+  on a whole range of data at once. Moreover:
+  - the trials can be shared between several threads, see setNbThreads(),
+  - when the data come with a quality score, for instance the distance ratio of a match, the samples can be drawn
+    among the best data first with PROSAC \cite Chum05, see setScores(),
+  - the scoring of a hypothesis can be stopped as soon as it cannot beat the best one, or when the sequential
+    probability ratio test of \cite Chum08 decides that it is a bad hypothesis, see setScoring().
+
+  The Model class must provide:
+  \code
+class Model
+{
+public:
+  // Result of a fit, default constructible and copyable
+  typedef ... Hypothesis;
+
+  // Number of data
+  unsigned int getNbData() const;
+  // Number of data drawn at each trial
+  unsigned int getSampleSize() const;
+  // Number of the drawn data that must be inliers to get a good hypothesis, used to compute the number of trials
+  unsigned int getMinimalSampleSize() const;
+  // Maximum number of hypotheses computed from a sample
+  unsigned int getMaxNbHypotheses() const;
+  // True if the data "index" cannot be added to the "size" first data of "sample"
+  bool isDegenerate(const unsigned int *sample, unsigned int size, unsigned int index);
+  // Compute the hypotheses of a sample and return their number, 0 if the sample is rejected
+  unsigned int computeHypotheses(const unsigned int *sample, Hypothesis *hypotheses);
+  // Write the squared residuals of the data in [begin, end) in residuals[0, end - begin)
+  void computeResiduals(const Hypothesis &hypothesis, unsigned int begin, unsigned int end, double *residuals);
+  // Remove from the sorted indexes of the inliers those that must not be counted, for instance duplicated data
+  void filterInliers(std::vector<unsigned int> &inliers);
+};
+  \endcode
+
+  Each thread uses its own copy of the model, so that the model can keep buffers in its members. The data should
+  therefore be referenced rather than copied by the model.
+
+  \code
+  MyModel model(data);
+  vpRansacEngine<MyModel> ransac(model);
+  ransac.setThreshold(0.01);
+  ransac.setNbThreads(0); // As many threads as CPU cores
+  ransac.setScoring(vpRansacEngine<MyModel>::SPRT_SCORING);
+
+  MyModel::Hypothesis hypothesis;
+  std::vector<unsigned int> inliers;
+  if (ransac.estimate(hypothesis, inliers)) {
+    // Refine the hypothesis with the inliers
+  }
+  \endcode
+
+  \sa vpRansac
+*/
+template <class Model> class vpRansacEngine
+{
+public:
+  typedef typename Model::Hypothesis Hypothesis;
+
+  //! Scoring of the hypotheses.
+  typedef enum {
+    FULL_SCORING,       /*!< Every hypothesis is scored on all the data. */
+    PREEMPTIVE_SCORING, /*!< The scoring stops as soon as the hypothesis cannot beat the best one. The result is the
+                             same as with FULL_SCORING. */
+    SPRT_SCORING        /*!< Preemptive scoring, and the scoring also stops when the sequential probability ratio
+                             test \cite Chum08 rejects the hypothesis. A good hypothesis may be rejected, which is
+                             accounted for in the number of trials. */
+  } vpRansacScoring;
+
+  explicit vpRansacEngine(const Model &model);
+
+  bool estimate(Hypothesis &hypothesis, std::vector<unsigned int> &inliers);
+
+  static double computeSprtThreshold(double epsilon, double delta, double timeHypothesis,
+                                     double nbHypothesesPerSample);
+
+  /*!
+    Return the number of hypotheses scored by the last call to estimate().
+  */
+  unsigned int getNbHypotheses() const { return m_nbHypotheses; }
+
+  /*!
+    Return the number of inliers of the hypothesis found by the last call to estimate().
+  */
+  unsigned int getNbInliers() const { return m_nbInliers; }
+
+  /*!
+    Return the number of residuals computed by the last call to estimate().
+  */
+  double getNbScoredData() const { return m_nbScoredData; }
+
+  /*!
+    Return the number of trials of the last call to estimate(), including the trials whose sample is degenerate.
+  */
+  unsigned int getNbTrials() const { return m_nbTrials; }
+
+  /*!
+    Set the maximum number of trials.
+  */
+  void setMaxTrials(int maxTrials) { m_maxTrials = maxTrials; }
+
+  /*!
+    Stop as soon as a hypothesis has at least \e nbInliers inliers. By default, the estimation only stops when the
+    number of trials is reached.
+  */
+  void setNbInliersToReachConsensus(unsigned int nbInliers) { m_nbInliersConsensus = nbInliers; }
+
+  /*!
+    Set the number of threads that share the trials, 0 to use as many threads as CPU cores. Without C++11, the
+    estimation is always sequential. By default, one thread is used.
+  */
+  void setNbThreads(unsigned int nbThreads) { m_nbThreads = nbThreads; }
+
+  /*!
+    Reduce the number of trials so that, with the given probability, at least one sample free from outliers has been
+    drawn, according to the ratio of inliers of the best hypothesis. 0 keeps the maximum number of trials. Default is
+    0.99.
+  */
+  void setProbability(double probability) { m_probability = probability; }
+
+  void setScores(const std::vector<double> &scores);
+
+  /*!
+    Set how the hypotheses are scored. Default is FULL_SCORING.
+  */
+  void setScoring(const vpRansacScoring &scoring) { m_scoring = scoring; }
+
+  /*!
+    Set the seed of the random generator. The thread i uses the seed + i.
+  */
+  void setSeed(uint64_t seed) { m_seed = seed; }
+
+  /*!
+    Set the inlier threshold. A data is an inlier when its squared residual is below the square of the threshold.
+  */
+  void setThreshold(double threshold) { m_threshold = threshold; }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+private:
+  // Best hypothesis found by all the threads, and the shared trial budget
+  struct State {
+    State(int maxTrials_, unsigned int nbHypothesesPerSample_)
+      : nbTrials(0), maxTrials(maxTrials_), stop(false),
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+        mutex(),
+#endif
+        nbInliers(0), best(), inliers(), epsilon(0.1), delta(0.01), deltaSum(0), nbRejected(0), logA(0),
+        logInlier(0), logOutlier(0), nbHypothesesPerSample((std::max)(nbHypothesesPerSample_, 1u)),
+        nbHypotheses(0), nbScoredData(0), nbTrialsDone(0)
+    {
+      updateSprt();
+    }
+
+    // Wald's decision threshold A for the current epsilon and delta, the time to compute the hypotheses of a sample
+    // being set to the time to score 200 data
+    void updateSprt()
+    {
+      if (epsilon <= delta) {
+        logA = std::numeric_limits<double>::max();
+        logInlier = logOutlier = 0;
+        return;
+      }
+      logInlier = std::log(delta / epsilon);
+      logOutlier = std::log((1 - delta) / (1 - epsilon));
+      logA = std::log(computeSprtThreshold(epsilon, delta, 200.0, nbHypothesesPerSample));
+    }
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+    std::atomic<int> nbTrials;
+    std::atomic<int> maxTrials;
+    std::atomic<bool> stop;
+    std::mutex mutex;
+#else
+    int nbTrials;
+    int maxTrials;
+    bool stop;
+#endif
+    // Written under the mutex
+    unsigned int nbInliers;
+    Hypothesis best;
+    std::vector<unsigned int> inliers;
+    // Probability that a data is an inlier of a good hypothesis, and of a bad hypothesis
+    double epsilon, delta;
+    double deltaSum;
+    unsigned int nbRejected;
+    double logA, logInlier, logOutlier;
+    double nbHypothesesPerSample;
+    unsigned int nbHypotheses;
+    double nbScoredData;
+    unsigned int nbTrialsDone;
+  };
+
+  class Worker
+  {
+  public:
+    Worker(const vpRansacEngine &engine, State &state, unsigned int id)
+      : m_engine(&engine), m_state(&state), m_model(engine.m_model), m_rng(engine.m_seed + id),
+        m_sample(engine.m_model.getSampleSize()), m_used(), m_hypotheses(engine.m_model.getMaxNbHypotheses()),
+        m_residuals(engine.m_model.getNbData()), m_inliers(), m_nbHypotheses(0), m_nbScoredData(0), m_nbTrials(0)
+    {
+    }
+
+    void operator()()
+    {
+      while (!m_state->stop) {
+        const int trial = m_state->nbTrials++;
+        if (trial >= m_state->maxTrials) {
+          break;
+        }
+        m_nbTrials++;
+        if (!drawSample(trial)) {
+          continue;
+        }
+
+        const unsigned int nbHypotheses = m_model.computeHypotheses(&m_sample[0], &m_hypotheses[0]);
+        for (unsigned int i = 0; i < nbHypotheses && !m_state->stop; i++) {
+          score(m_hypotheses[i]);
+        }
+      }
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+#endif
+      m_state->nbHypotheses += m_nbHypotheses;
+      m_state->nbScoredData += m_nbScoredData;
+      m_state->nbTrialsDone += m_nbTrials;
+    }
+
+  private:
+    // Draw the sample uniformly, or with PROSAC among the data with the best scores
+    bool drawSample(int trial)
+    {
+      const unsigned int sampleSize = static_cast<unsigned int>(m_sample.size());
+      const unsigned int *order = m_engine->m_order.empty() ? NULL : &m_engine->m_order[0];
+      unsigned int poolSize = m_model.getNbData();
+      unsigned int size = 0;
+
+      if (order != NULL) {
+        // Smallest n such that T'_n >= t, with t the 1-based index of the trial. The sample contains the n-th data
+        // and sampleSize - 1 data of the n - 1 first ones. Beyond T'_N, the sampling is uniform.
+        const std::vector<unsigned int> &growth = m_engine->m_prosacGrowth;
+        const std::vector<unsigned int>::const_iterator it =
+            std::lower_bound(growth.begin(), growth.end(), static_cast<unsigned int>(trial) + 1);
+        if (it != growth.end()) {
+          poolSize = sampleSize + static_cast<unsigned int>(it - growth.begin()) - 1;
+          m_sample[size++] = order[poolSize];
+        }
+      }
+
+      m_used.clear();
+      while (size < sampleSize && m_used.size() < poolSize) {
+        unsigned int r = static_cast<unsigned int>(m_rng.uniform(0, static_cast<int>(poolSize)));
+        while (std::find(m_used.begin(), m_used.end(), r) != m_used.end()) {
+          // If already picked, pick another data randomly
+          r = static_cast<unsigned int>(m_rng.uniform(0, static_cast<int>(poolSize)));
+        }
+        m_used.push_back(r);
+
+        const unsigned int index = order != NULL ? order[r] : r;
+        if (!m_model.isDegenerate(&m_sample[0], size, index)) {
+          m_sample[size++] = index;
+        }
+      }
+
+      return size == sampleSize;
+    }
+
+    // Count the inliers block by block, and stop as soon as the hypothesis is rejected
+    void score(const Hypothesis &hypothesis)
+    {
+      const unsigned int nbData = static_cast<unsigned int>(m_residuals.size());
+      const unsigned int blockSize = 256;
+      const unsigned int nbBlocks = (nbData + blockSize - 1) / blockSize;
+      const double threshold2 = m_engine->m_threshold * m_engine->m_threshold;
+      const bool preemptive = m_engine->m_scoring != FULL_SCORING;
+      const bool sprt = m_engine->m_scoring == SPRT_SCORING;
+
+      unsigned int best;
+      double logA, logInlier, logOutlier;
+      {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+#endif
+        best = m_state->nbInliers;
+        logA = m_state->logA;
+        logInlier = m_state->logInlier;
+        logOutlier = m_state->logOutlier;
+      }
+
+      // The SPRT assumes that the data are scored in a random order
+      const unsigned int first = sprt ? static_cast<unsigned int>(m_rng.uniform(0, static_cast<int>(nbBlocks))) : 0;
+      double *residuals = &m_residuals[0];
+      unsigned int nbInliers = 0, nbScored = 0;
+      bool rejected = false, rejectedBySprt = false;
+      for (unsigned int b = 0; b < nbBlocks && !rejected; b++) {
+        const unsigned int begin = ((first + b) % nbBlocks) * blockSize;
+        const unsigned int end = (std::min)(begin + blockSize, nbData);
+        m_model.computeResiduals(hypothesis, begin, end, residuals + begin);
+        for (unsigned int i = begin; i < end; i++) {
+          nbInliers += residuals[i] < threshold2 ? 1 : 0;
+        }
+        nbScored += end - begin;
+
+        if (preemptive) {
+          if (nbInliers + (nbData - nbScored) <= best) {
+            rejected = true;
+          } else if (sprt && nbInliers * logInlier + (nbScored - nbInliers) * logOutlier > logA) {
+            rejected = rejectedBySprt = true;
+          }
+        }
+      }
+      m_nbHypotheses++;
+      m_nbScoredData += nbScored;
+
+      if (rejectedBySprt) {
+        updateDelta(nbInliers / static_cast<double>(nbScored));
+      }
+      if (rejected || nbInliers <= best) {
+        return;
+      }
+
+      m_inliers.clear();
+      for (unsigned int i = 0; i < nbData; i++) {
+        if (residuals[i] < threshold2) {
+          m_inliers.push_back(i);
+        }
+      }
+      m_model.filterInliers(m_inliers);
+      update(hypothesis);
+    }
+
+    // The ratio of inliers of the hypotheses rejected by the SPRT estimates delta
+    void updateDelta(double ratio)
+    {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+#endif
+      m_state->deltaSum += ratio;
+      m_state->nbRejected++;
+      m_state->delta = (std::max)(m_state->deltaSum / m_state->nbRejected, 1e-4);
+      m_state->updateSprt();
+    }
+
+    // Keep the hypothesis if it is the best one, and update the stopping criteria
+    void update(const Hypothesis &hypothesis)
+    {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+#endif
+      const unsigned int nbInliers = static_cast<unsigned int>(m_inliers.size());
+      if (nbInliers <= m_state->nbInliers) {
+        return;
+      }
+
+      m_state->nbInliers = nbInliers;
+      m_state->best = hypothesis;
+      m_state->inliers.swap(m_inliers);
+
+      const double inlierRatio = nbInliers / static_cast<double>(m_residuals.size());
+      double acceptance = 1.0;
+      if (m_engine->m_scoring == SPRT_SCORING) {
+        m_state->epsilon = inlierRatio;
+        m_state->updateSprt();
+        // A good hypothesis is rejected with a probability below 1 / A
+        acceptance = 1.0 - std::exp(-m_state->logA);
+      }
+
+      if (nbInliers >= m_engine->m_nbInliersConsensus) {
+        m_state->stop = true;
+      } else if (m_engine->m_probability > 0) {
+        const int nbTrials = computeNbTrials(m_engine->m_probability, inlierRatio, m_model.getMinimalSampleSize(),
+                                             acceptance, m_state->maxTrials);
+        if (nbTrials < m_state->maxTrials) {
+          m_state->maxTrials = nbTrials;
+        }
+      }
+    }
+
+    const vpRansacEngine *m_engine;
+    State *m_state;
+    Model m_model;
+    vpUniRand m_rng;
+    // Buffers reused by the trials
+    std::vector<unsigned int> m_sample;
+    std::vector<unsigned int> m_used;
+    std::vector<Hypothesis> m_hypotheses;
+    std::vector<double> m_residuals;
+    std::vector<unsigned int> m_inliers;
+    unsigned int m_nbHypotheses;
+    double m_nbScoredData;
+    unsigned int m_nbTrials;
+  };
+
+  struct CompareScores {
+    explicit CompareScores(const std::vector<double> &scores) : m_scores(&scores) {}
+    bool operator()(unsigned int i, unsigned int j) const { return (*m_scores)[i] > (*m_scores)[j]; }
+    const std::vector<double> *m_scores;
+  };
+
+  // Number of trials to draw, with the given probability, a sample free from outliers that is accepted
+  static int computeNbTrials(double probability, double inlierRatio, unsigned int sampleSize, double acceptance,
+                             int maxTrials)
+  {
+    const double good = std::pow(inlierRatio, static_cast<int>(sampleSize)) * acceptance;
+    if (good >= 1.0) {
+      return 1;
+    }
+    const double logBad = std::log(1.0 - good);
+    if (!(logBad < 0.0)) {
+      return maxTrials;
+    }
+    const double N = std::log((std::max)(1.0 - probability, std::numeric_limits<double>::epsilon())) / logBad;
+    return N < maxTrials ? static_cast<int>(std::ceil(N)) : maxTrials;
+  }
+
+  void computeProsacGrowth(unsigned int nbData, unsigned int sampleSize);
+
+  Model m_model;
+  double m_threshold;
+  int m_maxTrials;
+  unsigned int m_nbInliersConsensus;
+  double m_probability;
+  unsigned int m_nbThreads;
+  uint64_t m_seed;
+  vpRansacScoring m_scoring;
+  // Indexes of the data sorted by decreasing scores, and the PROSAC growth function T'_n for n >= sampleSize
+  std::vector<unsigned int> m_order;
+  std::vector<unsigned int> m_prosacGrowth;
+  unsigned int m_nbHypotheses;
+  unsigned int m_nbInliers;
+  double m_nbScoredData;
+  unsigned int m_nbTrials;
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+};
+
+/*!
+  Create an estimator for a model, with a threshold of 1, 1000 trials at most and a probability of 0.99.
+
+  \param model : The model to fit, which is copied by each thread.
+*/
+template <class Model>
+vpRansacEngine<Model>::vpRansacEngine(const Model &model)
+  : m_model(model), m_threshold(1.0), m_maxTrials(1000),
+    m_nbInliersConsensus(std::numeric_limits<unsigned int>::max()), m_probability(0.99), m_nbThreads(1), m_seed(0),
+    m_scoring(FULL_SCORING), m_order(), m_prosacGrowth(), m_nbHypotheses(0), m_nbInliers(0),
+    m_nbScoredData(0), m_nbTrials(0)
+{
+}
+
+/*!
+  Compute the decision threshold A of the sequential probability ratio test \cite Chum08, that rejects a hypothesis
+  as soon as the likelihood ratio of the scored data exceeds A. A is the fixed point of
+  \f[ A = \frac{t_M C}{m_S} + 1 + \ln A \f]
+  with \f$ C = (1 - \delta) \ln \frac{1 - \delta}{1 - \epsilon} + \delta \ln \frac{\delta}{\epsilon} \f$.
+  For instance, A is about 18 for \f$ \epsilon = 0.1 \f$, \f$ \delta = 0.01 \f$, \f$ t_M = 200 \f$ and
+  \f$ m_S = 1 \f$.
+
+  \param epsilon : Probability \f$ \epsilon \f$ that a data is an inlier of a good hypothesis.
+  \param delta : Probability \f$ \delta \f$ that a data is an inlier of a bad hypothesis, lower than \e epsilon.
+  \param timeHypothesis : Time \f$ t_M \f$ to compute the hypotheses of a sample, expressed as a number of scored
+  data.
+  \param nbHypothesesPerSample : Average number \f$ m_S \f$ of hypotheses computed from a sample.
+  \return The threshold A, or the largest double when \e epsilon is not greater than \e delta.
+*/
+template <class Model>
+double vpRansacEngine<Model>::computeSprtThreshold(double epsilon, double delta, double timeHypothesis,
+                                                   double nbHypothesesPerSample)
+{
+  if (epsilon <= delta) {
+    return std::numeric_limits<double>::max();
+  }
+  const double C = (1 - delta) * std::log((1 - delta) / (1 - epsilon)) + delta * std::log(delta / epsilon);
+  const double K = timeHypothesis * C / nbHypothesesPerSample;
+  double A = K + 1;
+  for (int i = 0; i < 10; i++) {
+    A = K + 1 + std::log(A);
+  }
+  return A;
+}
+
+/*!
+  Robustly fit the model to the data.
+
+  \param hypothesis : The hypothesis with the most inliers.
+  \param inliers : Sorted indexes of its inliers, once filtered by the model.
+  \return true if a hypothesis with at least one inlier has been found.
+*/
+template <class Model>
+bool vpRansacEngine<Model>::estimate(Hypothesis &hypothesis, std::vector<unsigned int> &inliers)
+{
+  const unsigned int nbData = m_model.getNbData();
+  const unsigned int sampleSize = m_model.getSampleSize();
+  if (sampleSize == 0 || nbData < sampleSize) {
+    throw(vpException(vpException::dimensionError, "Not enough data (%d) to draw samples of %d data", nbData,
+                      sampleSize));
+  }
+
+  unsigned int nbThreads = 1;
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  nbThreads = m_nbThreads;
+  if (nbThreads == 0) {
+    nbThreads = (std::max)(std::thread::hardware_concurrency(), 1u);
+  }
+#endif
+
+  State state(m_maxTrials, m_model.getMaxNbHypotheses());
+  if (nbThreads > 1) {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+    std::vector<Worker> workers;
+    workers.reserve(nbThreads);
+    for (unsigned int i = 0; i < nbThreads; i++) {
+      workers.push_back(Worker(*this, state, i));
+    }
+
+    std::vector<std::thread> threadpool;
+    for (size_t i = 0; i < workers.size(); i++) {
+      threadpool.push_back(std::thread(std::ref(workers[i])));
+    }
+    for (size_t i = 0; i < threadpool.size(); i++) {
+      threadpool[i].join();
+    }
+#endif
+  } else {
+    Worker worker(*this, state, 0);
+    worker();
+  }
+
+  m_nbHypotheses = state.nbHypotheses;
+  m_nbScoredData = state.nbScoredData;
+  m_nbTrials = state.nbTrialsDone;
+  m_nbInliers = state.nbInliers;
+  if (m_nbInliers > 0) {
+    hypothesis = state.best;
+  }
+  inliers.swap(state.inliers);
+
+  return m_nbInliers > 0;
+}
+
+/*!
+  Set the quality of the data, for instance the inverse of the distance ratio of matched keypoints. When the scores
+  are set, the samples are drawn with PROSAC \cite Chum05: the first samples come from the data with the highest
+  scores, and the set they are drawn from progressively grows to all the data. The data are sorted here, so that the
+  scores can be reused by several calls to estimate().
+
+  \param scores : One score per data, the higher the better. An empty vector restores the uniform sampling.
+  \exception vpException::dimensionError : If the number of scores differs from the number of data of the model.
+*/
+template <class Model> void vpRansacEngine<Model>::setScores(const std::vector<double> &scores)
+{
+  m_order.clear();
+  m_prosacGrowth.clear();
+  if (scores.empty()) {
+    return;
+  }
+
+  const unsigned int nbData = m_model.getNbData();
+  const unsigned int sampleSize = m_model.getSampleSize();
+  if (scores.size() != nbData) {
+    throw(vpException(vpException::dimensionError, "The number of scores (%d) differs from the number of data (%d)",
+                      static_cast<int>(scores.size()), nbData));
+  }
+
+  m_order.resize(nbData);
+  for (unsigned int i = 0; i < nbData; i++) {
+    m_order[i] = i;
+  }
+  std::stable_sort(m_order.begin(), m_order.end(), CompareScores(scores));
+  if (sampleSize > 0 && nbData >= sampleSize) {
+    computeProsacGrowth(nbData, sampleSize);
+  }
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+// PROSAC growth function of Chum and Matas, with T_N = 200000 as in the paper
+template <class Model> void vpRansacEngine<Model>::computeProsacGrowth(unsigned int nbData, unsigned int sampleSize)
+{
+  double Tn = 200000;
+  for (unsigned int i = 0; i < sampleSize; i++) {
+    Tn *= static_cast<double>(sampleSize - i) / (nbData - i);
+  }
+
+  m_prosacGrowth.resize(nbData - sampleSize + 1);
+  m_prosacGrowth[0] = 1;
+  for (unsigned int n = sampleSize; n < nbData; n++) {
+    const double Tn1 = Tn * (n + 1) / (n + 1 - sampleSize);
+    const double growth = m_prosacGrowth[n - sampleSize] + std::ceil(Tn1 - Tn);
+    m_prosacGrowth[n - sampleSize + 1] =
+        growth < std::numeric_limits<unsigned int>::max() ? static_cast<unsigned int>(growth)
+                                                          : std::numeric_limits<unsigned int>::max();
+    Tn = Tn1;
+  }
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
@@ -227,6 +227,12 @@ private:
 
 protected:
   unsigned int m_index;
+
+private:
+  //! Fixed-size storage of the elements, which avoids any heap allocation
+  double m_storage[9];
+  //! Fixed-size storage of the row pointers
+  double *m_rowStorage[3];
 };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
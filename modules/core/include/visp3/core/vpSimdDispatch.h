@@ -0,0 +1,181 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Runtime selection of the SIMD version of a kernel.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpSimdDispatch.h
+  \brief Runtime selection of the SIMD version of a kernel
+*/
+
+#ifndef _vpSimdDispatch_h_
+#define _vpSimdDispatch_h_
+
+#include <stddef.h>
+
+#include <visp3/core/vpCPUFeatures.h>
+
+/*
+ * VISP_SIMD_TARGET_<LEVEL> compiles a function for an instruction set that
+ * may be higher than the one of the compiler flags, so that several versions
+ * of a kernel live in the same translation unit. They are only defined when
+ * VISP_HAVE_SIMD_DISPATCH is set: x86 GCC >= 4.9 and Clang >= 3.8 use the
+ * target attribute, MSVC exposes all the intrinsics without flag. The AVX
+ * levels are disabled with MinGW, which does not align the 32-byte spills.
+ */
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#if (defined(__x86_64__) || defined(__i386__)) &&                                                                     \
+    ((defined(__clang__) && (__clang_major__ > 3 || (__clang_major__ == 3 && __clang_minor__ >= 8))) ||             \
+     (!defined(__clang__) && defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define VISP_HAVE_SIMD_DISPATCH 1
+#define VISP_SIMD_TARGET_SSE2 __attribute__((target("sse2")))
+#define VISP_SIMD_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define VISP_SIMD_TARGET_SSE41 __attribute__((target("sse4.1")))
+#if !defined(__MINGW32__)
+#define VISP_HAVE_SIMD_DISPATCH_AVX 1
+#define VISP_SIMD_TARGET_AVX __attribute__((target("avx")))
+#define VISP_SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#elif defined(_MSC_VER) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && (_MSC_VER >= 1700)
+#define VISP_HAVE_SIMD_DISPATCH 1
+#define VISP_HAVE_SIMD_DISPATCH_AVX 1
+#define VISP_SIMD_TARGET_SSE2
+#define VISP_SIMD_TARGET_SSSE3
+#define VISP_SIMD_TARGET_SSE41
+#define VISP_SIMD_TARGET_AVX
+#define VISP_SIMD_TARGET_AVX2
+#endif
+
+#if VISP_HAVE_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  \class vpSimdDispatcher
+
+  \ingroup group_core_cpu_features
+
+  \brief Table of the versions of a kernel compiled for several SIMD levels,
+  returning the best one for the current vpCPUFeatures::getSimdLevel().
+
+  The scalar version is mandatory; the other ones are optional and are
+  registered with add(). The versions for instruction sets above the compiler
+  flags are compiled with the VISP_SIMD_TARGET_* attributes and registered
+  only when VISP_HAVE_SIMD_DISPATCH is defined. As the SIMD level is detected
+  once when the library is loaded, a table is usually a static object of the
+  translation unit of the kernels:
+
+  \code
+#include <visp3/core/vpSimdDispatch.h>
+
+namespace
+{
+void scale(const float *src, float k, float *dst, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+    dst[i] = k * src[i];
+}
+
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+VISP_SIMD_TARGET_AVX2 void scale_avx2(const float *src, float k, float *dst, size_t n)
+{
+  size_t i = 0;
+  const __m256 vk = _mm256_set1_ps(k);
+  for (; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(vk, _mm256_loadu_ps(src + i)));
+  for (; i < n; i++)
+    dst[i] = k * src[i];
+}
+#endif
+
+typedef void (*ScaleFunc)(const float *, float, float *, size_t);
+const vpSimdDispatcher<ScaleFunc> scale_dispatcher = vpSimdDispatcher<ScaleFunc>(scale)
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+    .add(vpCPUFeatures::SIMD_AVX2, scale_avx2)
+#endif
+    ;
+}
+
+void scaleBuffer(const float *src, float k, float *dst, size_t n) { scale_dispatcher.get()(src, k, dst, n); }
+  \endcode
+*/
+template <typename Func> class vpSimdDispatcher
+{
+public:
+  /*!
+    Create a table whose only version is the scalar one.
+  */
+  explicit vpSimdDispatcher(Func scalarKernel)
+  {
+    for (int level = 0; level < vpCPUFeatures::SIMD_LEVEL_COUNT; level++) {
+      m_kernels[level] = NULL;
+    }
+    m_kernels[vpCPUFeatures::SIMD_NONE] = scalarKernel;
+  }
+
+  /*!
+    Register the version of the kernel for a SIMD level.
+  */
+  vpSimdDispatcher &add(vpCPUFeatures::vpSimdLevel level, Func kernel)
+  {
+    if (level > vpCPUFeatures::SIMD_NONE && level < vpCPUFeatures::SIMD_LEVEL_COUNT) {
+      m_kernels[level] = kernel;
+    }
+    return *this;
+  }
+
+  /*!
+    Return the version with the highest level lower than or equal to
+    vpCPUFeatures::getSimdLevel().
+  */
+  inline Func get() const { return m_kernels[getLevel(vpCPUFeatures::getSimdLevel())]; }
+
+  /*!
+    Return the level of the version returned by get() when the SIMD level is
+    \e maxLevel.
+  */
+  vpCPUFeatures::vpSimdLevel getLevel(vpCPUFeatures::vpSimdLevel maxLevel) const
+  {
+    int level = maxLevel < vpCPUFeatures::SIMD_LEVEL_COUNT ? maxLevel : vpCPUFeatures::SIMD_LEVEL_COUNT - 1;
+    while (level > vpCPUFeatures::SIMD_NONE && m_kernels[level] == NULL) {
+      level--;
+    }
+    return static_cast<vpCPUFeatures::vpSimdLevel>(level);
+  }
+
+private:
+  Func m_kernels[vpCPUFeatures::SIMD_LEVEL_COUNT];
+};
+
+#endif
@@ -123,7 +123,7 @@ public:
       Default constructor.
       The translation vector is initialized to zero.
     */
-  vpTranslationVector() : vpArray2D<double>(3, 1), m_index(0) {};
+  vpTranslationVector() : vpArray2D<double>(3, 1, m_storage, m_rowStorage), m_index(0) {};
   vpTranslationVector(double tx, double ty, double tz);
   vpTranslationVector(const vpTranslationVector &tv);
   explicit vpTranslationVector(const vpHomogeneousMatrix &M);
@@ -200,6 +200,12 @@ public:
 
 protected:
   unsigned int m_index; // index used for operator<< and operator, to fill a vector
+
+private:
+  //! Fixed-size storage of the elements, which avoids any heap allocation
+  double m_storage[3];
+  //! Fixed-size storage of the row pointers
+  double *m_rowStorage[3];
 };
 
 #endif
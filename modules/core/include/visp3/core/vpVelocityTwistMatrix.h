@@ -241,6 +241,12 @@ public:
   vp_deprecated void setIdentity();
 //@}
 #endif
+
+private:
+  //! Fixed-size storage of the elements, which avoids any heap allocation
+  double m_storage[36];
+  //! Fixed-size storage of the row pointers
+  double *m_rowStorage[6];
 };
 
 #endif
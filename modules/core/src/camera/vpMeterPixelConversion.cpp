@@ -42,11 +42,174 @@
   \brief meter to pixel conversion
 */
 
+#include <limits>
+
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/core/vpSimdDispatch.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Kernels of convertPoints() for the perspective projection. The parameters p
+// are u0, v0, px, py and kud. They use the same operations as the
+// convertPoint() functions.
+typedef void (*MeterPixelFunc)(const double *x, const double *y, double *u, double *v, unsigned int n,
+                               const double *p);
+
+void withoutDistortion_scalar(const double *x, const double *y, double *u, double *v, unsigned int n,
+                              const double *p)
+{
+  for (unsigned int i = 0; i < n; i++) {
+    u[i] = x[i] * p[2] + p[0];
+    v[i] = y[i] * p[3] + p[1];
+  }
+}
+
+void withDistortion_scalar(const double *x, const double *y, double *u, double *v, unsigned int n, const double *p)
+{
+  for (unsigned int i = 0; i < n; i++) {
+    const double r2 = 1. + p[4] * (x[i] * x[i] + y[i] * y[i]);
+    u[i] = p[0] + p[2] * x[i] * r2;
+    v[i] = p[1] + p[3] * y[i] * r2;
+  }
+}
+
+#if VISP_HAVE_SIMD_DISPATCH
+VISP_SIMD_TARGET_SSE2 void withoutDistortion_sse2(const double *x, const double *y, double *u, double *v,
+                                                  unsigned int n, const double *p)
+{
+  const __m128d u0 = _mm_set1_pd(p[0]), v0 = _mm_set1_pd(p[1]);
+  const __m128d px = _mm_set1_pd(p[2]), py = _mm_set1_pd(p[3]);
+  unsigned int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const __m128d ui = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(x + i), px), u0);
+    const __m128d vi = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(y + i), py), v0);
+    _mm_storeu_pd(u + i, ui);
+    _mm_storeu_pd(v + i, vi);
+  }
+  withoutDistortion_scalar(x + i, y + i, u + i, v + i, n - i, p);
+}
+
+VISP_SIMD_TARGET_SSE2 void withDistortion_sse2(const double *x, const double *y, double *u, double *v,
+                                               unsigned int n, const double *p)
+{
+  const __m128d u0 = _mm_set1_pd(p[0]), v0 = _mm_set1_pd(p[1]);
+  const __m128d px = _mm_set1_pd(p[2]), py = _mm_set1_pd(p[3]);
+  const __m128d kud = _mm_set1_pd(p[4]), one = _mm_set1_pd(1.);
+  unsigned int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const __m128d xi = _mm_loadu_pd(x + i), yi = _mm_loadu_pd(y + i);
+    const __m128d r2 = _mm_add_pd(one, _mm_mul_pd(kud, _mm_add_pd(_mm_mul_pd(xi, xi), _mm_mul_pd(yi, yi))));
+    _mm_storeu_pd(u + i, _mm_add_pd(u0, _mm_mul_pd(_mm_mul_pd(px, xi), r2)));
+    _mm_storeu_pd(v + i, _mm_add_pd(v0, _mm_mul_pd(_mm_mul_pd(py, yi), r2)));
+  }
+  withDistortion_scalar(x + i, y + i, u + i, v + i, n - i, p);
+}
+#endif
+
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+VISP_SIMD_TARGET_AVX void withoutDistortion_avx(const double *x, const double *y, double *u, double *v,
+                                                unsigned int n, const double *p)
+{
+  const __m256d u0 = _mm256_set1_pd(p[0]), v0 = _mm256_set1_pd(p[1]);
+  const __m256d px = _mm256_set1_pd(p[2]), py = _mm256_set1_pd(p[3]);
+  unsigned int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d ui = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(x + i), px), u0);
+    const __m256d vi = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(y + i), py), v0);
+    _mm256_storeu_pd(u + i, ui);
+    _mm256_storeu_pd(v + i, vi);
+  }
+  withoutDistortion_scalar(x + i, y + i, u + i, v + i, n - i, p);
+}
+
+VISP_SIMD_TARGET_AVX void withDistortion_avx(const double *x, const double *y, double *u, double *v, unsigned int n,
+                                             const double *p)
+{
+  const __m256d u0 = _mm256_set1_pd(p[0]), v0 = _mm256_set1_pd(p[1]);
+  const __m256d px = _mm256_set1_pd(p[2]), py = _mm256_set1_pd(p[3]);
+  const __m256d kud = _mm256_set1_pd(p[4]), one = _mm256_set1_pd(1.);
+  unsigned int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d xi = _mm256_loadu_pd(x + i), yi = _mm256_loadu_pd(y + i);
+    const __m256d r2 =
+        _mm256_add_pd(one, _mm256_mul_pd(kud, _mm256_add_pd(_mm256_mul_pd(xi, xi), _mm256_mul_pd(yi, yi))));
+    _mm256_storeu_pd(u + i, _mm256_add_pd(u0, _mm256_mul_pd(_mm256_mul_pd(px, xi), r2)));
+    _mm256_storeu_pd(v + i, _mm256_add_pd(v0, _mm256_mul_pd(_mm256_mul_pd(py, yi), r2)));
+  }
+  withDistortion_scalar(x + i, y + i, u + i, v + i, n - i, p);
+}
+#endif
+
+const vpSimdDispatcher<MeterPixelFunc> withoutDistortion_dispatcher =
+    vpSimdDispatcher<MeterPixelFunc>(withoutDistortion_scalar)
+#if VISP_HAVE_SIMD_DISPATCH
+        .add(vpCPUFeatures::SIMD_SSE2, withoutDistortion_sse2)
+#endif
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+        .add(vpCPUFeatures::SIMD_AVX, withoutDistortion_avx)
+#endif
+    ;
+
+const vpSimdDispatcher<MeterPixelFunc> withDistortion_dispatcher = vpSimdDispatcher<MeterPixelFunc>(withDistortion_scalar)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, withDistortion_sse2)
+#endif
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+    .add(vpCPUFeatures::SIMD_AVX, withDistortion_avx)
+#endif
+    ;
+
+// Distort the normalized coordinates (x, y) with the Kannala-Brandt model:
+// r_d = theta + k0 theta^3 + k1 theta^5 + k2 theta^7 + k3 theta^9 with theta = atan(r)
+void distortKannalaBrandt(const std::vector<double> &k, double x, double y, double &x_d, double &y_d)
+{
+  double r = sqrt(vpMath::sqr(x) + vpMath::sqr(y));
+  double theta = atan(r);
+
+  double theta2 = theta * theta, theta3 = theta2 * theta, theta4 = theta2 * theta2, theta5 = theta4 * theta,
+         theta6 = theta3 * theta3, theta7 = theta6 * theta, theta8 = theta4 * theta4, theta9 = theta8 * theta;
+
+  double r_d = theta + k[0] * theta3 + k[1] * theta5 + k[2] * theta7 + k[3] * theta9;
+
+  double scale = (std::fabs(r) < std::numeric_limits<double>::epsilon()) ? 1.0 : r_d / r;
+
+  x_d = x * scale;
+  y_d = y * scale;
+}
+
+// Kernel of convertPoints(), with the coefficients read once
+void withKannalaBrandtDistortion(const vpCameraParameters &cam, const double *x, const double *y, double *u,
+                                 double *v, unsigned int n)
+{
+  const std::vector<double> k = cam.getKannalaBrandtDistortionCoefficients();
+  const double u0 = cam.get_u0(), v0 = cam.get_v0(), px = cam.get_px(), py = cam.get_py();
+
+  for (unsigned int i = 0; i < n; i++) {
+    double x_d, y_d;
+    distortKannalaBrandt(k, x[i], y[i], x_d, y_d);
+    u[i] = px * x_d + u0;
+    v[i] = py * y_d + v0;
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+void vpMeterPixelConversion::convertPointWithKannalaBrandtDistortion(const vpCameraParameters &cam, const double &x,
+                                                                     const double &y, double &u, double &v)
+{
+  double x_d, y_d;
+  distortKannalaBrandt(cam.getKannalaBrandtDistortionCoefficients(), x, y, x_d, y_d);
+
+  u = cam.px * x_d + cam.u0;
+  v = cam.py * y_d + cam.v0;
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
 
 /*!
    Line parameters conversion from normalized coordinates \f$(\rho_m,\theta_m)\f$ expressed in the image plane
@@ -186,6 +349,40 @@ void vpMeterPixelConversion::convertEllipse(const vpCameraParameters &cam,
   n02_p = n02_m * vpMath::sqr(cam.get_py());
 }
 
+/*!
+  Point coordinates conversion of an array of points from normalized
+  coordinates \f$(x,y)\f$ in meter in the image plane to pixel coordinates
+  \f$(u,v)\f$ using ViSP camera parameters. The results are the ones of
+  convertPoint(), but the perspective projections are computed with the SIMD
+  level of vpCPUFeatures and the Kannala-Brandt coefficients are read once for
+  all the points.
+
+  \param[in] cam : camera parameters.
+  \param[in] x : input coordinates in meter along image plane x-axis.
+  \param[in] y : input coordinates in meter along image plane y-axis.
+  \param[out] u : output coordinates in pixels along image horizontal axis.
+  It may be the same buffer as \e x.
+  \param[out] v : output coordinates in pixels along image vertical axis. It
+  may be the same buffer as \e y.
+  \param[in] n : number of points.
+*/
+void vpMeterPixelConversion::convertPoints(const vpCameraParameters &cam, const double *x, const double *y, double *u,
+                                           double *v, unsigned int n)
+{
+  const double p[5] = {cam.u0, cam.v0, cam.px, cam.py, cam.kud};
+  switch (cam.projModel) {
+  case vpCameraParameters::perspectiveProjWithoutDistortion:
+    withoutDistortion_dispatcher.get()(x, y, u, v, n, p);
+    break;
+  case vpCameraParameters::perspectiveProjWithDistortion:
+    withDistortion_dispatcher.get()(x, y, u, v, n, p);
+    break;
+  case vpCameraParameters::ProjWithKannalaBrandtDistortion:
+    withKannalaBrandtDistortion(cam, x, y, u, v, n);
+    break;
+  }
+}
+
 #if VISP_HAVE_OPENCV_VERSION >= 0x020300
 /*!
    Line parameters conversion from normalized coordinates \f$(\rho_m,\theta_m)\f$ expressed in the image plane
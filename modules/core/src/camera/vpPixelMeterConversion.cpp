@@ -46,6 +46,169 @@
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpSimdDispatch.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Kernels of convertPoints() for the perspective projection. The parameters p
+// are u0, v0, 1/px, 1/py and kdu. They use the same operations as the
+// convertPoint() functions.
+typedef void (*PixelMeterFunc)(const double *u, const double *v, double *x, double *y, unsigned int n,
+                               const double *p);
+
+void withoutDistortion_scalar(const double *u, const double *v, double *x, double *y, unsigned int n,
+                              const double *p)
+{
+  for (unsigned int i = 0; i < n; i++) {
+    x[i] = (u[i] - p[0]) * p[2];
+    y[i] = (v[i] - p[1]) * p[3];
+  }
+}
+
+void withDistortion_scalar(const double *u, const double *v, double *x, double *y, unsigned int n, const double *p)
+{
+  for (unsigned int i = 0; i < n; i++) {
+    const double r2 = 1. + p[4] * (vpMath::sqr((u[i] - p[0]) * p[2]) + vpMath::sqr((v[i] - p[1]) * p[3]));
+    x[i] = (u[i] - p[0]) * r2 * p[2];
+    y[i] = (v[i] - p[1]) * r2 * p[3];
+  }
+}
+
+#if VISP_HAVE_SIMD_DISPATCH
+VISP_SIMD_TARGET_SSE2 void withoutDistortion_sse2(const double *u, const double *v, double *x, double *y,
+                                                  unsigned int n, const double *p)
+{
+  const __m128d u0 = _mm_set1_pd(p[0]), v0 = _mm_set1_pd(p[1]);
+  const __m128d inv_px = _mm_set1_pd(p[2]), inv_py = _mm_set1_pd(p[3]);
+  unsigned int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const __m128d xi = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(u + i), u0), inv_px);
+    const __m128d yi = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(v + i), v0), inv_py);
+    _mm_storeu_pd(x + i, xi);
+    _mm_storeu_pd(y + i, yi);
+  }
+  withoutDistortion_scalar(u + i, v + i, x + i, y + i, n - i, p);
+}
+
+VISP_SIMD_TARGET_SSE2 void withDistortion_sse2(const double *u, const double *v, double *x, double *y,
+                                               unsigned int n, const double *p)
+{
+  const __m128d u0 = _mm_set1_pd(p[0]), v0 = _mm_set1_pd(p[1]);
+  const __m128d inv_px = _mm_set1_pd(p[2]), inv_py = _mm_set1_pd(p[3]);
+  const __m128d kdu = _mm_set1_pd(p[4]), one = _mm_set1_pd(1.);
+  unsigned int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const __m128d du = _mm_sub_pd(_mm_loadu_pd(u + i), u0), dv = _mm_sub_pd(_mm_loadu_pd(v + i), v0);
+    const __m128d xd = _mm_mul_pd(du, inv_px), yd = _mm_mul_pd(dv, inv_py);
+    const __m128d r2 = _mm_add_pd(one, _mm_mul_pd(kdu, _mm_add_pd(_mm_mul_pd(xd, xd), _mm_mul_pd(yd, yd))));
+    _mm_storeu_pd(x + i, _mm_mul_pd(_mm_mul_pd(du, r2), inv_px));
+    _mm_storeu_pd(y + i, _mm_mul_pd(_mm_mul_pd(dv, r2), inv_py));
+  }
+  withDistortion_scalar(u + i, v + i, x + i, y + i, n - i, p);
+}
+#endif
+
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+VISP_SIMD_TARGET_AVX void withoutDistortion_avx(const double *u, const double *v, double *x, double *y,
+                                                unsigned int n, const double *p)
+{
+  const __m256d u0 = _mm256_set1_pd(p[0]), v0 = _mm256_set1_pd(p[1]);
+  const __m256d inv_px = _mm256_set1_pd(p[2]), inv_py = _mm256_set1_pd(p[3]);
+  unsigned int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d xi = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(u + i), u0), inv_px);
+    const __m256d yi = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(v + i), v0), inv_py);
+    _mm256_storeu_pd(x + i, xi);
+    _mm256_storeu_pd(y + i, yi);
+  }
+  withoutDistortion_scalar(u + i, v + i, x + i, y + i, n - i, p);
+}
+
+VISP_SIMD_TARGET_AVX void withDistortion_avx(const double *u, const double *v, double *x, double *y, unsigned int n,
+                                             const double *p)
+{
+  const __m256d u0 = _mm256_set1_pd(p[0]), v0 = _mm256_set1_pd(p[1]);
+  const __m256d inv_px = _mm256_set1_pd(p[2]), inv_py = _mm256_set1_pd(p[3]);
+  const __m256d kdu = _mm256_set1_pd(p[4]), one = _mm256_set1_pd(1.);
+  unsigned int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d du = _mm256_sub_pd(_mm256_loadu_pd(u + i), u0), dv = _mm256_sub_pd(_mm256_loadu_pd(v + i), v0);
+    const __m256d xd = _mm256_mul_pd(du, inv_px), yd = _mm256_mul_pd(dv, inv_py);
+    const __m256d r2 =
+        _mm256_add_pd(one, _mm256_mul_pd(kdu, _mm256_add_pd(_mm256_mul_pd(xd, xd), _mm256_mul_pd(yd, yd))));
+    _mm256_storeu_pd(x + i, _mm256_mul_pd(_mm256_mul_pd(du, r2), inv_px));
+    _mm256_storeu_pd(y + i, _mm256_mul_pd(_mm256_mul_pd(dv, r2), inv_py));
+  }
+  withDistortion_scalar(u + i, v + i, x + i, y + i, n - i, p);
+}
+#endif
+
+const vpSimdDispatcher<PixelMeterFunc> withoutDistortion_dispatcher =
+    vpSimdDispatcher<PixelMeterFunc>(withoutDistortion_scalar)
+#if VISP_HAVE_SIMD_DISPATCH
+        .add(vpCPUFeatures::SIMD_SSE2, withoutDistortion_sse2)
+#endif
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+        .add(vpCPUFeatures::SIMD_AVX, withoutDistortion_avx)
+#endif
+    ;
+
+const vpSimdDispatcher<PixelMeterFunc> withDistortion_dispatcher = vpSimdDispatcher<PixelMeterFunc>(withDistortion_scalar)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, withDistortion_sse2)
+#endif
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+    .add(vpCPUFeatures::SIMD_AVX, withDistortion_avx)
+#endif
+    ;
+
+// Undistort the normalized coordinates (x_d, y_d) with the Kannala-Brandt model: the angle theta of
+// r_d = theta + k0 theta^3 + k1 theta^5 + k2 theta^7 + k3 theta^9 is found with the Newton-Raphson method
+void undistortKannalaBrandt(const std::vector<double> &k, double x_d, double y_d, double &x, double &y)
+{
+  double scale = 1.0;
+  double r_d = sqrt(vpMath::sqr(x_d) + vpMath::sqr(y_d));
+
+  r_d = std::min(std::max(-M_PI, r_d), M_PI); // FOV restricted to 180degrees.
+
+  const double EPS = 1e-8;
+  if (r_d > EPS) {
+    // compensate distortion iteratively
+    double theta = r_d;
+
+    for (int j = 0; j < 10; j++) {
+      double theta2 = theta * theta, theta4 = theta2 * theta2, theta6 = theta4 * theta2, theta8 = theta6 * theta2;
+      double k0_theta2 = k[0] * theta2, k1_theta4 = k[1] * theta4, k2_theta6 = k[2] * theta6,
+             k3_theta8 = k[3] * theta8;
+      /* new_theta = theta - theta_fix, theta_fix = f0(theta) / f0'(theta) */
+      double theta_fix = (theta * (1 + k0_theta2 + k1_theta4 + k2_theta6 + k3_theta8) - r_d) /
+                         (1 + 3 * k0_theta2 + 5 * k1_theta4 + 7 * k2_theta6 + 9 * k3_theta8);
+      theta = theta - theta_fix;
+      if (fabs(theta_fix) < EPS)
+        break;
+    }
+
+    scale = std::tan(theta) / r_d; // Scale of norm of (x,y) and (x_d, y_d)
+  }
+
+  x = x_d * scale;
+  y = y_d * scale;
+}
+
+// Kernel of convertPoints(), with the coefficients read once
+void withKannalaBrandtDistortion(const vpCameraParameters &cam, const double *u, const double *v, double *x,
+                                 double *y, unsigned int n)
+{
+  const std::vector<double> k = cam.getKannalaBrandtDistortionCoefficients();
+  const double u0 = cam.get_u0(), v0 = cam.get_v0(), px = cam.get_px(), py = cam.get_py();
+
+  for (unsigned int i = 0; i < n; i++) {
+    undistortKannalaBrandt(k, (u[i] - u0) / px, (v[i] - v0) / py, x[i], y[i]);
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
 
 /*!
  * Convert ellipse parameters (ie ellipse center and normalized centered moments)
@@ -171,6 +334,50 @@ void vpPixelMeterConversion::convertMoment(const vpCameraParameters &cam,
         }
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+void vpPixelMeterConversion::convertPointWithKannalaBrandtDistortion(const vpCameraParameters &cam, const double &u,
+                                                                     const double &v, double &x, double &y)
+{
+  undistortKannalaBrandt(cam.getKannalaBrandtDistortionCoefficients(), (u - cam.u0) / cam.px, (v - cam.v0) / cam.py, x,
+                         y);
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Point coordinates conversion of an array of points from pixel coordinates
+  \f$(u,v)\f$ to normalized coordinates \f$(x,y)\f$ in meter using ViSP
+  camera parameters. The results are the ones of convertPoint(), but the
+  perspective projections are computed with the SIMD level of vpCPUFeatures
+  and the Kannala-Brandt coefficients are read once for all the points.
+
+  \param[in] cam : camera parameters.
+  \param[in] u : input coordinates in pixels along image horizontal axis.
+  \param[in] v : input coordinates in pixels along image vertical axis.
+  \param[out] x : output coordinates in meter along image plane x-axis. It
+  may be the same buffer as \e u.
+  \param[out] y : output coordinates in meter along image plane y-axis. It
+  may be the same buffer as \e v.
+  \param[in] n : number of points.
+
+  \sa vpPixelMeterMap to convert many points with the same distorted camera.
+*/
+void vpPixelMeterConversion::convertPoints(const vpCameraParameters &cam, const double *u, const double *v, double *x,
+                                           double *y, unsigned int n)
+{
+  const double p[5] = {cam.u0, cam.v0, cam.inv_px, cam.inv_py, cam.kdu};
+  switch (cam.projModel) {
+  case vpCameraParameters::perspectiveProjWithoutDistortion:
+    withoutDistortion_dispatcher.get()(u, v, x, y, n, p);
+    break;
+  case vpCameraParameters::perspectiveProjWithDistortion:
+    withDistortion_dispatcher.get()(u, v, x, y, n, p);
+    break;
+  case vpCameraParameters::ProjWithKannalaBrandtDistortion:
+    withKannalaBrandtDistortion(cam, u, v, x, y, n);
+    break;
+  }
+}
+
 #if VISP_HAVE_OPENCV_VERSION >= 0x020300
 /*!
  * Convert ellipse parameters (ie ellipse center and normalized centered moments)
@@ -0,0 +1,123 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Precomputed normalized coordinates of the pixels of an image.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpPixelMeterMap.cpp
+  \brief Precomputed normalized coordinates of the pixels of an image
+*/
+
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpPixelMeterMap.h>
+
+/*!
+  Create an empty table: convertPoints() then uses vpPixelMeterConversion
+  with the default camera parameters.
+*/
+vpPixelMeterMap::vpPixelMeterMap() : m_cam(), m_height(0), m_width(0), m_x(), m_y() {}
+
+/*!
+  Create the table of a camera, see init().
+*/
+vpPixelMeterMap::vpPixelMeterMap(const vpCameraParameters &cam, unsigned int height, unsigned int width)
+  : m_cam(), m_height(0), m_width(0), m_x(), m_y()
+{
+  init(cam, height, width);
+}
+
+/*!
+  Convert an array of points from pixel coordinates \f$(u,v)\f$ to normalized
+  coordinates \f$(x,y)\f$ in meter. Inside the image, the coordinates are
+  bilinearly interpolated from the table, which is exact for a camera without
+  distortion; outside, they are computed by vpPixelMeterConversion.
+
+  \param[in] u : input coordinates in pixels along image horizontal axis.
+  \param[in] v : input coordinates in pixels along image vertical axis.
+  \param[out] x : output coordinates in meter along image plane x-axis.
+  \param[out] y : output coordinates in meter along image plane y-axis.
+  \param[in] n : number of points.
+*/
+void vpPixelMeterMap::convertPoints(const double *u, const double *v, double *x, double *y, unsigned int n) const
+{
+  const double maxU = static_cast<double>(m_width) - 1, maxV = static_cast<double>(m_height) - 1;
+  for (unsigned int k = 0; k < n; k++) {
+    const double uk = u[k], vk = v[k];
+    if (!(uk >= 0 && vk >= 0 && uk <= maxU && vk <= maxV) || m_width < 2 || m_height < 2) {
+      vpPixelMeterConversion::convertPoint(m_cam, uk, vk, x[k], y[k]);
+      continue;
+    }
+
+    unsigned int j = static_cast<unsigned int>(uk), i = static_cast<unsigned int>(vk);
+    j = j < m_width - 1 ? j : m_width - 2;
+    i = i < m_height - 1 ? i : m_height - 2;
+    const double a = uk - j, b = vk - i;
+    const size_t idx = static_cast<size_t>(i) * m_width + j;
+
+    const double *x0 = &m_x[idx], *x1 = x0 + m_width;
+    const double *y0 = &m_y[idx], *y1 = y0 + m_width;
+    x[k] = (1 - b) * ((1 - a) * x0[0] + a * x0[1]) + b * ((1 - a) * x1[0] + a * x1[1]);
+    y[k] = (1 - b) * ((1 - a) * y0[0] + a * y0[1]) + b * ((1 - a) * y1[0] + a * y1[1]);
+  }
+}
+
+/*!
+  Compute the normalized coordinates of each pixel of an image. Nothing is
+  done when the camera parameters and the image size did not change.
+
+  \param[in] cam : camera parameters.
+  \param[in] height : image height.
+  \param[in] width : image width.
+*/
+void vpPixelMeterMap::init(const vpCameraParameters &cam, unsigned int height, unsigned int width)
+{
+  if (height == m_height && width == m_width && cam == m_cam && m_x.size() == static_cast<size_t>(height) * width) {
+    return;
+  }
+
+  m_cam = cam;
+  m_height = height;
+  m_width = width;
+  m_x.resize(static_cast<size_t>(height) * width);
+  m_y.resize(m_x.size());
+
+  std::vector<double> u(width);
+  for (unsigned int j = 0; j < width; j++) {
+    u[j] = j;
+  }
+  for (unsigned int i = 0; i < height && width > 0; i++) {
+    const std::vector<double> v(width, static_cast<double>(i));
+    vpPixelMeterConversion::convertPoints(cam, &u[0], &v[0], &m_x[static_cast<size_t>(i) * width],
+                                          &m_y[static_cast<size_t>(i) * width], width);
+  }
+}
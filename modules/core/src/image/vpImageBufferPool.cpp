@@ -0,0 +1,327 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Aligned allocation and recycling of image bitmaps.
+ *
+ *****************************************************************************/
+
+#include <map>
+#include <vector>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageBufferPool.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <atomic>
+#include <mutex>
+#endif
+
+#include <Simd/SimdLib.h>
+
+namespace
+{
+// Round the requested size to the alignment, which also gives the bucket of the buffer
+inline size_t getBucketSize(size_t size)
+{
+  const size_t alignment = vpImageBufferPool::getAlignment();
+  return size == 0 ? alignment : (size + alignment - 1) / alignment * alignment;
+}
+
+struct vpImageBufferPoolState {
+  vpImageBufferPoolState()
+    : m_buckets(), m_cachedBytes(0), m_maxCachedBytes(256 * 1024 * 1024), m_nbHits(0), m_nbMisses(0),
+      m_enabled(false)
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+      , m_mutex()
+#endif
+  {
+  }
+
+  ~vpImageBufferPoolState() { clear(); }
+
+  void clear()
+  {
+    for (std::map<size_t, std::vector<void *> >::iterator it = m_buckets.begin(); it != m_buckets.end(); ++it) {
+      for (size_t i = 0; i < it->second.size(); i++) {
+        SimdFree(it->second[i]);
+      }
+    }
+    m_buckets.clear();
+    m_cachedBytes = 0;
+  }
+
+  //! Released buffers, by size
+  std::map<size_t, std::vector<void *> > m_buckets;
+  //! Total size of the released buffers
+  size_t m_cachedBytes;
+  //! Maximal total size of the released buffers, read without the mutex
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  std::atomic<size_t> m_maxCachedBytes;
+#else
+  size_t m_maxCachedBytes;
+#endif
+  //! Number of allocations served by a released buffer
+  unsigned long m_nbHits;
+  //! Number of allocations that required a new buffer while the pool is enabled
+  unsigned long m_nbMisses;
+  //! If true, the released buffers are kept. Read without the mutex, and again once it is locked
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  std::atomic<bool> m_enabled;
+  std::mutex m_mutex;
+#else
+  bool m_enabled;
+#endif
+};
+
+// Constructed on first use, so that images with static storage duration can use the pool
+vpImageBufferPoolState &getState()
+{
+  static vpImageBufferPoolState state;
+  return state;
+}
+
+void *allocateAligned(size_t size)
+{
+  void *ptr = SimdAllocate(size, vpImageBufferPool::getAlignment());
+  if (ptr == NULL) {
+    throw vpException(vpException::memoryAllocationError, "Cannot allocate %d bytes", static_cast<int>(size));
+  }
+  return ptr;
+}
+} // namespace
+
+/*!
+  Allocate a buffer of at least \e size bytes, aligned on getAlignment() bytes. When the pool is
+  enabled, a released buffer of the same size is reused if any.
+
+  \param size : Size of the buffer in bytes.
+  \return The buffer, to be released with deallocate().
+
+  \exception vpException::memoryAllocationError : When the memory cannot be allocated.
+*/
+void *vpImageBufferPool::allocate(size_t size)
+{
+  const size_t bucketSize = getBucketSize(size);
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpImageBufferPoolState &state = getState();
+  // The disabled pool does not take the mutex
+  if (state.m_enabled.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    if (state.m_enabled) {
+      std::map<size_t, std::vector<void *> >::iterator it = state.m_buckets.find(bucketSize);
+      if (it != state.m_buckets.end() && !it->second.empty()) {
+        void *ptr = it->second.back();
+        it->second.pop_back();
+        state.m_cachedBytes -= bucketSize;
+        state.m_nbHits++;
+        return ptr;
+      }
+      state.m_nbMisses++;
+    }
+  }
+#endif
+
+  return allocateAligned(bucketSize);
+}
+
+/*!
+  Free all the buffers kept by the pool. The counters are not reset.
+*/
+void vpImageBufferPool::clear()
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpImageBufferPoolState &state = getState();
+  std::lock_guard<std::mutex> lock(state.m_mutex);
+  state.clear();
+#endif
+}
+
+/*!
+  Release a buffer returned by allocate(). When the pool is enabled and does not exceed
+  getMaxCachedBytes(), the buffer is kept for a next allocation of the same size.
+
+  \param ptr : Buffer to release. Nothing is done if NULL.
+  \param size : Size that was requested to allocate() for this buffer.
+*/
+void vpImageBufferPool::deallocate(void *ptr, size_t size)
+{
+  if (ptr == NULL) {
+    return;
+  }
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  const size_t bucketSize = getBucketSize(size);
+  vpImageBufferPoolState &state = getState();
+  // The disabled pool, or a buffer larger than the pool, does not take the mutex
+  if (state.m_enabled.load(std::memory_order_relaxed) &&
+      bucketSize <= state.m_maxCachedBytes.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    if (state.m_enabled && state.m_cachedBytes + bucketSize <= state.m_maxCachedBytes) {
+      state.m_buckets[bucketSize].push_back(ptr);
+      state.m_cachedBytes += bucketSize;
+      return;
+    }
+  }
+#else
+  (void)size;
+#endif
+
+  SimdFree(ptr);
+}
+
+/*!
+  Return the total size in bytes of the buffers kept by the pool.
+*/
+size_t vpImageBufferPool::getCachedBytes()
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpImageBufferPoolState &state = getState();
+  std::lock_guard<std::mutex> lock(state.m_mutex);
+  return state.m_cachedBytes;
+#else
+  return 0;
+#endif
+}
+
+/*!
+  Return the maximal total size in bytes of the buffers kept by the pool.
+
+  \sa setMaxCachedBytes()
+*/
+size_t vpImageBufferPool::getMaxCachedBytes()
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpImageBufferPoolState &state = getState();
+  std::lock_guard<std::mutex> lock(state.m_mutex);
+  return state.m_maxCachedBytes;
+#else
+  return 0;
+#endif
+}
+
+/*!
+  Return the number of allocations that reused a released buffer.
+
+  \sa getNbMisses(), resetCounters()
+*/
+unsigned long vpImageBufferPool::getNbHits()
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpImageBufferPoolState &state = getState();
+  std::lock_guard<std::mutex> lock(state.m_mutex);
+  return state.m_nbHits;
+#else
+  return 0;
+#endif
+}
+
+/*!
+  Return the number of allocations done while the pool is enabled that did not find a released
+  buffer of the requested size.
+
+  \sa getNbHits(), resetCounters()
+*/
+unsigned long vpImageBufferPool::getNbMisses()
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpImageBufferPoolState &state = getState();
+  std::lock_guard<std::mutex> lock(state.m_mutex);
+  return state.m_nbMisses;
+#else
+  return 0;
+#endif
+}
+
+/*!
+  Return true if the released buffers are kept for reuse.
+
+  \sa setEnabled()
+*/
+bool vpImageBufferPool::isEnabled()
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpImageBufferPoolState &state = getState();
+  std::lock_guard<std::mutex> lock(state.m_mutex);
+  return state.m_enabled;
+#else
+  return false;
+#endif
+}
+
+/*!
+  Reset the hit and miss counters.
+*/
+void vpImageBufferPool::resetCounters()
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpImageBufferPoolState &state = getState();
+  std::lock_guard<std::mutex> lock(state.m_mutex);
+  state.m_nbHits = 0;
+  state.m_nbMisses = 0;
+#endif
+}
+
+/*!
+  Enable or disable the pool. Disabling the pool frees the buffers it keeps.
+
+  \param enable : If true, the released buffers are kept for reuse.
+*/
+void vpImageBufferPool::setEnabled(bool enable)
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpImageBufferPoolState &state = getState();
+  std::lock_guard<std::mutex> lock(state.m_mutex);
+  state.m_enabled = enable;
+  if (!enable) {
+    state.clear();
+  }
+#else
+  (void)enable;
+#endif
+}
+
+/*!
+  Set the maximal total size of the buffers kept by the pool, 256 MB by default. A released
+  buffer that would exceed this size is freed.
+
+  \param maxCachedBytes : Maximal size in bytes.
+*/
+void vpImageBufferPool::setMaxCachedBytes(size_t maxCachedBytes)
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpImageBufferPoolState &state = getState();
+  std::lock_guard<std::mutex> lock(state.m_mutex);
+  state.m_maxCachedBytes = maxCachedBytes;
+#else
+  (void)maxCachedBytes;
+#endif
+}
@@ -92,6 +92,23 @@ void vpImageConvert::convert(const vpImage<vpRGBa> &src, vpImage<unsigned char>
              src.getHeight(), nThreads);
 }
 
+/*!
+  Convert a view over a vpImage\<vpRGBa\>, for instance a region of interest of a larger
+  image, to a vpImage\<unsigned char\> without copying the viewed pixels first.
+  \param src : source view
+  \param dest : destination image, resized to the size of the view
+*/
+void vpImageConvert::convert(const vpImageView<const vpRGBa> &src, vpImage<unsigned char> &dest)
+{
+  dest.resize(src.getHeight(), src.getWidth());
+  if (src.empty()) {
+    return;
+  }
+
+  SimdRgbaToGray(reinterpret_cast<const uint8_t *>(src[0]), src.getWidth(), src.getHeight(), src.getStep(),
+                 dest.bitmap, dest.getWidth());
+}
+
 /*!
   Convert a vpImage\<float\> to a vpImage\<unsigend char\> by renormalizing
   between 0 and 255.
@@ -764,11 +781,11 @@ void vpImageConvert::convert(const cv::Mat &src, vpImage<unsigned char> &dest, b
     } else {
       if (flip) {
         for (unsigned int i = 0; i < dest.getRows(); ++i) {
-          memcpy(dest.bitmap + i * dest.getCols(), src.data + (dest.getRows() - i - 1) * src.step1(), (size_t)src.step);
+          memcpy(dest.bitmap + i * dest.getCols(), src.data + (dest.getRows() - i - 1) * src.step1(), (size_t)src.cols);
         }
       } else {
         for (unsigned int i = 0; i < dest.getRows(); ++i) {
-          memcpy(dest.bitmap + i * dest.getCols(), src.data + i * src.step1(), (size_t)src.step);
+          memcpy(dest.bitmap + i * dest.getCols(), src.data + i * src.step1(), (size_t)src.cols);
         }
       }
     }
@@ -1189,121 +1206,6 @@ void vpImageConvert::convert(const yarp::sig::ImageOf<yarp::sig::PixelRgb> *src,
 
 #endif
 
-#define vpSAT(c)                                                                                                       \
-  if (c & (~255)) {                                                                                                    \
-    if (c < 0)                                                                                                         \
-      c = 0;                                                                                                           \
-    else                                                                                                               \
-      c = 255;                                                                                                         \
-  }
-/*!
-  Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...) to RGB32.
-  Destination rgba memory area has to be allocated before.
-
-  The alpha component of the converted image is set to vpRGBa::alpha_default.
-
-  \sa YUV422ToRGBa()
-*/
-void vpImageConvert::YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height)
-{
-  unsigned char *s;
-  unsigned char *d;
-  int w, h;
-  int r, g, b, cr, cg, cb, y1, y2;
-
-  h = (int)height;
-  w = (int)width;
-  s = yuyv;
-  d = rgba;
-  while (h--) {
-    int c = w >> 1;
-    while (c--) {
-      y1 = *s++;
-      cb = ((*s - 128) * 454) >> 8;
-      cg = (*s++ - 128) * 88;
-      y2 = *s++;
-      cr = ((*s - 128) * 359) >> 8;
-      cg = (cg + (*s++ - 128) * 183) >> 8;
-
-      r = y1 + cr;
-      b = y1 + cb;
-      g = y1 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-      *d++ = vpRGBa::alpha_default;
-
-      r = y2 + cr;
-      b = y2 + cb;
-      g = y2 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-      *d++ = vpRGBa::alpha_default;
-    }
-  }
-}
-
-/*!
-  Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...)
-  to RGB24. Destination rgb memory area has to be allocated before.
-
-  \sa YUV422ToRGB()
-*/
-void vpImageConvert::YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned int width, unsigned int height)
-{
-  unsigned char *s;
-  unsigned char *d;
-  int h, w;
-  int r, g, b, cr, cg, cb, y1, y2;
-
-  h = (int)height;
-  w = (int)width;
-  s = yuyv;
-  d = rgb;
-  while (h--) {
-    int c = w >> 1;
-    while (c--) {
-      y1 = *s++;
-      cb = ((*s - 128) * 454) >> 8;
-      cg = (*s++ - 128) * 88;
-      y2 = *s++;
-      cr = ((*s - 128) * 359) >> 8;
-      cg = (cg + (*s++ - 128) * 183) >> 8;
-
-      r = y1 + cr;
-      b = y1 + cb;
-      g = y1 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-
-      r = y2 + cr;
-      b = y2 + cb;
-      g = y2 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-    }
-  }
-}
-
 /*!
   Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...)
   to grey. Destination rgb memory area has to be allocated before.
@@ -1312,13 +1214,7 @@ void vpImageConvert::YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned
 */
 void vpImageConvert::YUYVToGrey(unsigned char *yuyv, unsigned char *grey, unsigned int size)
 {
-  unsigned int i = 0, j = 0;
-
-  while (j < size * 2) {
-    grey[i++] = yuyv[j];
-    grey[i++] = yuyv[j + 2];
-    j += 4;
-  }
+  YUYVToGrey(yuyv, 2 * size, grey, size, size, 1, 1);
 }
 
 /*!
@@ -1488,90 +1384,7 @@ void vpImageConvert::YUV411ToRGBa(unsigned char *yuv, unsigned char *rgba, unsig
 */
 void vpImageConvert::YUV422ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size)
 {
-
-#if 1
-  //  std::cout << "call optimized convertYUV422ToRGBa()" << std::endl;
-  for (unsigned int i = size / 2; i; i--) {
-    int U = (int)((*yuv++ - 128) * 0.354);
-    int U5 = 5 * U;
-    int Y0 = *yuv++;
-    int V = (int)((*yuv++ - 128) * 0.707);
-    int V2 = 2 * V;
-    int Y1 = *yuv++;
-    int UV = -U - V;
-
-    //---
-    int R = Y0 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    int G = Y0 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    int B = Y0 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgba++ = (unsigned char)R;
-    *rgba++ = (unsigned char)G;
-    *rgba++ = (unsigned char)B;
-    *rgba++ = vpRGBa::alpha_default;
-
-    //---
-    R = Y1 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    G = Y1 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    B = Y1 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgba++ = (unsigned char)R;
-    *rgba++ = (unsigned char)G;
-    *rgba++ = (unsigned char)B;
-    *rgba++ = vpRGBa::alpha_default;
-  }
-
-#else
-  // tres tres lent ....
-  unsigned int i = 0, j = 0;
-  unsigned char r, g, b;
-
-  while (j < size * 2) {
-
-    YUVToRGB(yuv[j + 1], yuv[j], yuv[j + 2], r, g, b);
-    rgba[i] = r;
-    rgba[i + 1] = g;
-    rgba[i + 2] = b;
-    rgba[i + 3] = vpRGBa::alpha_default;
-    i += 4;
-
-    YUVToRGB(yuv[j + 3], yuv[j], yuv[j + 2], r, g, b);
-    rgba[i] = r;
-    rgba[i + 1] = g;
-    rgba[i + 2] = b;
-    rgba[i + 3] = vpRGBa::alpha_default;
-    i += 4;
-    j += 4;
-  }
-#endif
+  YUV422ToRGBa(yuv, 2 * size, rgba, 4 * size, size, 1, 1);
 }
 
 /*!
@@ -1601,85 +1414,7 @@ void vpImageConvert::YUV411ToGrey(unsigned char *yuv, unsigned char *grey, unsig
 */
 void vpImageConvert::YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size)
 {
-#if 1
-  //  std::cout << "call optimized convertYUV422ToRGB()" << std::endl;
-  for (unsigned int i = size / 2; i; i--) {
-    int U = (int)((*yuv++ - 128) * 0.354);
-    int U5 = 5 * U;
-    int Y0 = *yuv++;
-    int V = (int)((*yuv++ - 128) * 0.707);
-    int V2 = 2 * V;
-    int Y1 = *yuv++;
-    int UV = -U - V;
-
-    //---
-    int R = Y0 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    int G = Y0 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    int B = Y0 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgb++ = (unsigned char)R;
-    *rgb++ = (unsigned char)G;
-    *rgb++ = (unsigned char)B;
-
-    //---
-    R = Y1 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    G = Y1 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    B = Y1 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgb++ = (unsigned char)R;
-    *rgb++ = (unsigned char)G;
-    *rgb++ = (unsigned char)B;
-  }
-
-#else
-  // tres tres lent ....
-  unsigned int i = 0, j = 0;
-  unsigned char r, g, b;
-
-  while (j < size * 2) {
-
-    YUVToRGB(yuv[j + 1], yuv[j], yuv[j + 2], r, g, b);
-    rgb[i] = r;
-    rgb[i + 1] = g;
-    rgb[i + 2] = b;
-    i += 3;
-
-    YUVToRGB(yuv[j + 3], yuv[j], yuv[j + 2], r, g, b);
-    rgb[i] = r;
-    rgb[i + 1] = g;
-    rgb[i + 2] = b;
-    i += 3;
-    j += 4;
-  }
-#endif
+  YUV422ToRGB(yuv, 2 * size, rgb, 3 * size, size, 1, 1);
 }
 
 /*!
@@ -1690,13 +1425,7 @@ void vpImageConvert::YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigne
 */
 void vpImageConvert::YUV422ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size)
 {
-  unsigned int i = 0, j = 0;
-
-  while (j < size * 2) {
-    grey[i++] = yuv[j + 1];
-    grey[i++] = yuv[j + 3];
-    j += 4;
-  }
+  YUV422ToGrey(yuv, 2 * size, grey, size, size, 1, 1);
 }
 
 /*!
@@ -1845,269 +1574,33 @@ void vpImageConvert::YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigne
     i += 3;
     // TRACE("r= %d g=%d b=%d", r, g, b);
 
-    j += 6;
-  }
-#endif
-}
-
-/*!
-  Convert YUV420 [Y(NxM), U(N/2xM/2), V(N/2xM/2)] image into RGBa image.
-
-  The alpha component of the converted image is set to vpRGBa::alpha_default.
-*/
-void vpImageConvert::YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
-{
-  //  std::cout << "call optimized ConvertYUV420ToRGBa()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  unsigned int size = width * height;
-  unsigned char *iU = yuv + size;
-  unsigned char *iV = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba + 4 * width - 7;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba - 4 * width + 1;
-    }
-    yuv += width;
-    rgba += 4 * width;
-  }
-}
-
-/*!
-  Convert YUV420 [Y(NxM), U(N/2xM/2), V(N/2xM/2)] image into RGB image.
-*/
-void vpImageConvert::YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height)
-{
-  //  std::cout << "call optimized ConvertYUV420ToRGB()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  unsigned int size = width * height;
-  unsigned char *iU = yuv + size;
-  unsigned char *iV = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb + 3 * width - 5;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
+    j += 6;
+  }
+#endif
+}
 
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
+/*!
+  Convert YUV420 [Y(NxM), U(N/2xM/2), V(N/2xM/2)] image into RGBa image.
 
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb - 3 * width + 1;
-    }
-    yuv += width;
-    rgb += 3 * width;
-  }
+  The alpha component of the converted image is set to vpRGBa::alpha_default.
+*/
+void vpImageConvert::YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
+{
+  // Odd last row and column are not converted
+  unsigned int size = width * height;
+  YUV420ToRGBa(yuv, width, yuv + size, width / 2, yuv + 5 * size / 4, width / 2, rgba, 4 * width, width & ~1u,
+               height & ~1u, 1);
+}
+
+/*!
+  Convert YUV420 [Y(NxM), U(N/2xM/2), V(N/2xM/2)] image into RGB image.
+*/
+void vpImageConvert::YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height)
+{
+  // Odd last row and column are not converted
+  unsigned int size = width * height;
+  YUV420ToRGB(yuv, width, yuv + size, width / 2, yuv + 5 * size / 4, width / 2, rgb, 3 * width, width & ~1u,
+              height & ~1u, 1);
 }
 
 /*!
@@ -2224,130 +1717,10 @@ void vpImageConvert::YUV444ToGrey(unsigned char *yuv, unsigned char *grey, unsig
 */
 void vpImageConvert::YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
 {
-  //  std::cout << "call optimized ConvertYV12ToRGBa()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
+  // Odd last row and column are not converted
   unsigned int size = width * height;
-  unsigned char *iV = yuv + size;
-  unsigned char *iU = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = 0;
-      rgba = rgba + 4 * width - 7;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba - 4 * width + 1;
-    }
-    yuv += width;
-    rgba += 4 * width;
-  }
+  YUV420ToRGBa(yuv, width, yuv + 5 * size / 4, width / 2, yuv + size, width / 2, rgba, 4 * width, width & ~1u,
+               height & ~1u, 1);
 }
 
 /*!
@@ -2355,126 +1728,10 @@ void vpImageConvert::YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigne
 */
 void vpImageConvert::YV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int height, unsigned int width)
 {
-  //  std::cout << "call optimized ConvertYV12ToRGB()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
+  // Odd last row and column are not converted
   unsigned int size = width * height;
-  unsigned char *iV = yuv + size;
-  unsigned char *iU = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb + 3 * width - 5;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb - 3 * width + 1;
-    }
-    yuv += width;
-    rgb += 3 * width;
-  }
+  YUV420ToRGB(yuv, width, yuv + 5 * size / 4, width / 2, yuv + size, width / 2, rgb, 3 * width, width & ~1u,
+              height & ~1u, 1);
 }
 
 /*!
@@ -4086,13 +3343,7 @@ void vpImageConvert::merge(const vpImage<unsigned char> *R, const vpImage<unsign
 */
 void vpImageConvert::MONO16ToGrey(unsigned char *grey16, unsigned char *grey, unsigned int size)
 {
-  int i = (((int)size) << 1) - 1;
-  int j = (int)size - 1;
-
-  while (i >= 0) {
-    int y = grey16[i--];
-    grey[j--] = static_cast<unsigned char>((y + (grey16[i--] << 8)) >> 8);
-  }
+  MONO16ToGrey(grey16, 2 * size, grey, size, size, 1, 1);
 }
 
 /*!
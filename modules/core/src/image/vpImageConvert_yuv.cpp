@@ -0,0 +1,797 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Stride-aware conversions of camera stream formats (YUV, MONO16, Bayer).
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpImageConvert_yuv.cpp
+  \brief Stride-aware conversions of camera stream formats (YUV, MONO16, Bayer)
+*/
+
+#include <algorithm>
+#include <string.h>
+
+#if defined _OPENMP
+#include <omp.h>
+#endif
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpSimdDispatch.h>
+#include <Simd/SimdLib.hpp>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Row kernels. The packed 4:2:2 ones read ceil(width / 2) macro-pixels.
+typedef void (*PackedRowFunc)(const unsigned char *src, unsigned char *dst, unsigned int width);
+typedef void (*PlanarRowFunc)(const unsigned char *y, const unsigned char *u, const unsigned char *v,
+                              unsigned char *rgba, unsigned int width);
+
+// Number of pixels converted to RGBa on the stack before the RGB packing
+const unsigned int rgbChunk = 256;
+
+inline unsigned char saturate(int c) { return static_cast<unsigned char>(c < 0 ? 0 : (c > 255 ? 255 : c)); }
+
+inline void storeRGBa(unsigned char *d, int y, int dr, int dg, int db)
+{
+  d[0] = saturate(y + dr);
+  d[1] = saturate(y + dg);
+  d[2] = saturate(y + db);
+  d[3] = vpRGBa::alpha_default;
+}
+
+// Chroma offsets of YUYVToRGBa()
+inline void chromaYUYV(int u, int v, int &dr, int &dg, int &db)
+{
+  db = ((u - 128) * 454) >> 8;
+  dg = -(((u - 128) * 88 + (v - 128) * 183) >> 8);
+  dr = ((v - 128) * 359) >> 8;
+}
+
+// Chroma offsets of YUV422ToRGBa(), YUV420ToRGBa() and YV12ToRGBa()
+inline void chromaYUV(int u, int v, int &dr, int &dg, int &db)
+{
+  int U = (int)((u - 128) * 0.354);
+  int V = (int)((v - 128) * 0.707);
+  dr = 2 * V;
+  dg = -U - V;
+  db = 5 * U;
+}
+
+void yuyvToRGBa_scalar(const unsigned char *s, unsigned char *d, unsigned int width)
+{
+  for (unsigned int j = 0; j < width; j += 2, s += 4, d += 8) {
+    int dr, dg, db;
+    chromaYUYV(s[1], s[3], dr, dg, db);
+    storeRGBa(d, s[0], dr, dg, db);
+    if (j + 1 < width) {
+      storeRGBa(d + 4, s[2], dr, dg, db);
+    }
+  }
+}
+
+void uyvyToRGBa_scalar(const unsigned char *s, unsigned char *d, unsigned int width)
+{
+  for (unsigned int j = 0; j < width; j += 2, s += 4, d += 8) {
+    int dr, dg, db;
+    chromaYUV(s[0], s[2], dr, dg, db);
+    storeRGBa(d, s[1], dr, dg, db);
+    if (j + 1 < width) {
+      storeRGBa(d + 4, s[3], dr, dg, db);
+    }
+  }
+}
+
+void planarToRGBa_scalar(const unsigned char *y, const unsigned char *u, const unsigned char *v, unsigned char *d,
+                         unsigned int width)
+{
+  for (unsigned int j = 0; j < width; j += 2, d += 8) {
+    int dr, dg, db;
+    chromaYUV(*u++, *v++, dr, dg, db);
+    storeRGBa(d, y[j], dr, dg, db);
+    if (j + 1 < width) {
+      storeRGBa(d + 4, y[j + 1], dr, dg, db);
+    }
+  }
+}
+
+// Every other byte of the row, starting from the first (YUYV luminance, MONO16 most significant byte) or the
+// second one (UYVY luminance)
+template <unsigned int offset> void oddEvenBytes_scalar(const unsigned char *s, unsigned char *d, unsigned int width)
+{
+  for (unsigned int j = 0; j < width; j++) {
+    d[j] = s[2 * j + offset];
+  }
+}
+
+void mono16ToRGBa_scalar(const unsigned char *s, unsigned char *d, unsigned int width)
+{
+  for (unsigned int j = 0; j < width; j++, d += 4) {
+    d[0] = d[1] = d[2] = s[2 * j];
+    d[3] = vpRGBa::alpha_default;
+  }
+}
+
+#if VISP_HAVE_SIMD_DISPATCH
+// The kernels compute the chroma offsets of 4 macro-pixels with the integer expressions of the scalar code, so
+// that the results are the same. uv holds u0 v0 u1 v1 u2 v2 u3 v3 minus 128 on 16 bits, and the offsets of each
+// macro-pixel are duplicated for its two pixels.
+VISP_SIMD_TARGET_SSE2 inline __m128i duplicate32(__m128i x)
+{
+  const __m128i x16 = _mm_packs_epi32(x, x);
+  return _mm_unpacklo_epi16(x16, x16);
+}
+
+VISP_SIMD_TARGET_SSE2 inline void chromaYUYV_sse2(__m128i uv, __m128i &dr, __m128i &dg, __m128i &db)
+{
+  // _mm_madd_epi16() computes u * w_u + v * w_v on 32 bits, as the scalar code does
+  dr = _mm_srai_epi32(_mm_madd_epi16(uv, _mm_set1_epi32(359 << 16)), 8);
+  db = _mm_srai_epi32(_mm_madd_epi16(uv, _mm_set1_epi32(454)), 8);
+  dg = _mm_srai_epi32(_mm_madd_epi16(uv, _mm_set1_epi32(88 | (183 << 16))), 8);
+  dr = duplicate32(dr);
+  db = duplicate32(db);
+  dg = _mm_sub_epi16(_mm_setzero_si128(), duplicate32(dg));
+}
+
+VISP_SIMD_TARGET_SSE2 inline void chromaYUV_sse2(__m128i uv, __m128i &dr, __m128i &dg, __m128i &db)
+{
+  // (int)(x * 0.354) and (int)(x * 0.707) are truncated toward zero: for |x| <= 128 they are equal to
+  // sign(x) * ((|x| * 11600) >> 15) and sign(x) * ((|x| * 23167) >> 15)
+  const __m128i sign = _mm_srai_epi16(uv, 15);
+  __m128i q = _mm_sub_epi16(_mm_xor_si128(uv, sign), sign);
+  q = _mm_mulhi_epu16(q, _mm_set1_epi32((2 * 11600) | static_cast<int>(static_cast<unsigned int>(2 * 23167) << 16)));
+  q = _mm_sub_epi16(_mm_xor_si128(q, sign), sign);
+  const __m128i U = _mm_srai_epi32(_mm_slli_epi32(q, 16), 16);
+  const __m128i V = _mm_srai_epi32(q, 16);
+  dr = duplicate32(_mm_slli_epi32(V, 1));
+  dg = duplicate32(_mm_sub_epi32(_mm_setzero_si128(), _mm_add_epi32(U, V)));
+  db = duplicate32(_mm_add_epi32(_mm_slli_epi32(U, 2), U));
+}
+
+// Store 8 RGBa pixels from the luminance and the chroma offsets on 16 bits
+VISP_SIMD_TARGET_SSE2 inline void storeRGBa_sse2(unsigned char *d, __m128i y, __m128i dr, __m128i dg, __m128i db)
+{
+  const __m128i r = _mm_packus_epi16(_mm_add_epi16(y, dr), _mm_setzero_si128());
+  const __m128i g = _mm_packus_epi16(_mm_add_epi16(y, dg), _mm_setzero_si128());
+  const __m128i b = _mm_packus_epi16(_mm_add_epi16(y, db), _mm_setzero_si128());
+  const __m128i a = _mm_set1_epi8(static_cast<char>(vpRGBa::alpha_default));
+  const __m128i rg = _mm_unpacklo_epi8(r, g);
+  const __m128i ba = _mm_unpacklo_epi8(b, a);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(d), _mm_unpacklo_epi16(rg, ba));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(d + 16), _mm_unpackhi_epi16(rg, ba));
+}
+
+VISP_SIMD_TARGET_SSE2 void yuyvToRGBa_sse2(const unsigned char *s, unsigned char *d, unsigned int width)
+{
+  const __m128i mask = _mm_set1_epi16(0xFF);
+  const __m128i c128 = _mm_set1_epi16(128);
+  unsigned int j = 0;
+  for (; j + 8 <= width; j += 8) {
+    const __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 2 * j));
+    __m128i dr, dg, db;
+    chromaYUYV_sse2(_mm_sub_epi16(_mm_srli_epi16(src, 8), c128), dr, dg, db);
+    storeRGBa_sse2(d + 4 * j, _mm_and_si128(src, mask), dr, dg, db);
+  }
+  yuyvToRGBa_scalar(s + 2 * j, d + 4 * j, width - j);
+}
+
+VISP_SIMD_TARGET_SSE2 void uyvyToRGBa_sse2(const unsigned char *s, unsigned char *d, unsigned int width)
+{
+  const __m128i mask = _mm_set1_epi16(0xFF);
+  const __m128i c128 = _mm_set1_epi16(128);
+  unsigned int j = 0;
+  for (; j + 8 <= width; j += 8) {
+    const __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 2 * j));
+    __m128i dr, dg, db;
+    chromaYUV_sse2(_mm_sub_epi16(_mm_and_si128(src, mask), c128), dr, dg, db);
+    storeRGBa_sse2(d + 4 * j, _mm_srli_epi16(src, 8), dr, dg, db);
+  }
+  uyvyToRGBa_scalar(s + 2 * j, d + 4 * j, width - j);
+}
+
+VISP_SIMD_TARGET_SSE2 void planarToRGBa_sse2(const unsigned char *y, const unsigned char *u, const unsigned char *v,
+                                             unsigned char *d, unsigned int width)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i c128 = _mm_set1_epi16(128);
+  unsigned int j = 0;
+  for (; j + 8 <= width; j += 8) {
+    int u4, v4;
+    memcpy(&u4, u + j / 2, sizeof(int));
+    memcpy(&v4, v + j / 2, sizeof(int));
+    const __m128i uv = _mm_unpacklo_epi8(_mm_unpacklo_epi8(_mm_cvtsi32_si128(u4), _mm_cvtsi32_si128(v4)), zero);
+    const __m128i y16 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(y + j)), zero);
+    __m128i dr, dg, db;
+    chromaYUV_sse2(_mm_sub_epi16(uv, c128), dr, dg, db);
+    storeRGBa_sse2(d + 4 * j, y16, dr, dg, db);
+  }
+  planarToRGBa_scalar(y + j, u + j / 2, v + j / 2, d + 4 * j, width - j);
+}
+
+template <unsigned int offset>
+VISP_SIMD_TARGET_SSE2 void oddEvenBytes_sse2(const unsigned char *s, unsigned char *d, unsigned int width)
+{
+  const __m128i mask = _mm_set1_epi16(0xFF);
+  unsigned int j = 0;
+  for (; j + 16 <= width; j += 16) {
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 2 * j));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 2 * j + 16));
+    if (offset == 0) {
+      lo = _mm_and_si128(lo, mask);
+      hi = _mm_and_si128(hi, mask);
+    } else {
+      lo = _mm_srli_epi16(lo, 8);
+      hi = _mm_srli_epi16(hi, 8);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(d + j), _mm_packus_epi16(lo, hi));
+  }
+  oddEvenBytes_scalar<offset>(s + 2 * j, d + j, width - j);
+}
+
+VISP_SIMD_TARGET_SSE2 void mono16ToRGBa_sse2(const unsigned char *s, unsigned char *d, unsigned int width)
+{
+  const __m128i mask = _mm_set1_epi16(0xFF);
+  const __m128i a = _mm_set1_epi8(static_cast<char>(vpRGBa::alpha_default));
+  unsigned int j = 0;
+  for (; j + 8 <= width; j += 8) {
+    const __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 2 * j));
+    const __m128i g = _mm_packus_epi16(_mm_and_si128(src, mask), _mm_setzero_si128());
+    const __m128i gg = _mm_unpacklo_epi8(g, g);
+    const __m128i ga = _mm_unpacklo_epi8(g, a);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(d + 4 * j), _mm_unpacklo_epi16(gg, ga));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(d + 4 * j + 16), _mm_unpackhi_epi16(gg, ga));
+  }
+  mono16ToRGBa_scalar(s + 2 * j, d + 4 * j, width - j);
+}
+#endif
+
+const vpSimdDispatcher<PackedRowFunc> yuyvToRGBa = vpSimdDispatcher<PackedRowFunc>(yuyvToRGBa_scalar)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, yuyvToRGBa_sse2)
+#endif
+    ;
+
+const vpSimdDispatcher<PackedRowFunc> uyvyToRGBa = vpSimdDispatcher<PackedRowFunc>(uyvyToRGBa_scalar)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, uyvyToRGBa_sse2)
+#endif
+    ;
+
+const vpSimdDispatcher<PlanarRowFunc> planarToRGBa = vpSimdDispatcher<PlanarRowFunc>(planarToRGBa_scalar)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, planarToRGBa_sse2)
+#endif
+    ;
+
+const vpSimdDispatcher<PackedRowFunc> evenBytes = vpSimdDispatcher<PackedRowFunc>(oddEvenBytes_scalar<0>)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, oddEvenBytes_sse2<0>)
+#endif
+    ;
+
+const vpSimdDispatcher<PackedRowFunc> oddBytes = vpSimdDispatcher<PackedRowFunc>(oddEvenBytes_scalar<1>)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, oddEvenBytes_sse2<1>)
+#endif
+    ;
+
+const vpSimdDispatcher<PackedRowFunc> mono16ToRGBa = vpSimdDispatcher<PackedRowFunc>(mono16ToRGBa_scalar)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, mono16ToRGBa_sse2)
+#endif
+    ;
+
+// Convert a packed 4:2:2 row to RGB through a RGBa buffer on the stack
+void packedRowToRGB(PackedRowFunc toRGBa, const unsigned char *src, unsigned char *rgb, unsigned int width)
+{
+  unsigned char rgba[4 * rgbChunk];
+  for (unsigned int j = 0; j < width; j += rgbChunk) {
+    const unsigned int n = std::min(rgbChunk, width - j);
+    toRGBa(src + 2 * j, rgba, n);
+    SimdBgraToBgr(rgba, n, 1, 4 * n, rgb + 3 * j, 3 * n);
+  }
+}
+
+void planarRowToRGB(PlanarRowFunc toRGBa, const unsigned char *y, const unsigned char *u, const unsigned char *v,
+                    unsigned char *rgb, unsigned int width)
+{
+  unsigned char rgba[4 * rgbChunk];
+  for (unsigned int j = 0; j < width; j += rgbChunk) {
+    const unsigned int n = std::min(rgbChunk, width - j);
+    toRGBa(y + j, u + j / 2, v + j / 2, rgba, n);
+    SimdBgraToBgr(rgba, n, 1, 4 * n, rgb + 3 * j, 3 * n);
+  }
+}
+
+// Bilinear demosaicing of the pixels [j0, j1) of a row, whose previous and next rows are up and down. rx is the
+// column of the red pixels. The borders are mirrored, which keeps the parity of the pattern.
+void demosaicBilinearRow_scalar(const unsigned char *up, const unsigned char *cur, const unsigned char *down,
+                                unsigned char *rgba, unsigned int j0, unsigned int j1, unsigned int width,
+                                bool redRow, unsigned int rx)
+{
+  for (unsigned int j = j0; j < j1; j++) {
+    const unsigned int l = j > 0 ? j - 1 : 1;
+    const unsigned int r = j + 1 < width ? j + 1 : width - 2;
+    const bool redCol = (j & 1) == rx;
+    unsigned char *d = rgba + 4 * j;
+
+    if (redRow == redCol) {
+      // Red or blue pixel: green from the 4 neighbors, the other color from the 4 diagonals
+      const unsigned char cross = static_cast<unsigned char>((up[j] + down[j] + cur[l] + cur[r] + 2) >> 2);
+      const unsigned char diag = static_cast<unsigned char>((up[l] + up[r] + down[l] + down[r] + 2) >> 2);
+      d[0] = redRow ? cur[j] : diag;
+      d[1] = cross;
+      d[2] = redRow ? diag : cur[j];
+    } else {
+      // Green pixel: the color of the row from the horizontal neighbors, the other from the vertical ones
+      const unsigned char hor = static_cast<unsigned char>((cur[l] + cur[r] + 1) >> 1);
+      const unsigned char ver = static_cast<unsigned char>((up[j] + down[j] + 1) >> 1);
+      d[0] = redRow ? hor : ver;
+      d[1] = cur[j];
+      d[2] = redRow ? ver : hor;
+    }
+    d[3] = vpRGBa::alpha_default;
+  }
+}
+
+void demosaicBilinear_scalar(const unsigned char *up, const unsigned char *cur, const unsigned char *down,
+                             unsigned char *rgba, unsigned int width, bool redRow, unsigned int rx)
+{
+  demosaicBilinearRow_scalar(up, cur, down, rgba, 0, width, width, redRow, rx);
+}
+
+#if VISP_HAVE_SIMD_DISPATCH
+VISP_SIMD_TARGET_SSE2 inline __m128i load8(const unsigned char *p)
+{
+  return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)), _mm_setzero_si128());
+}
+
+VISP_SIMD_TARGET_SSE2 inline __m128i blend(__m128i mask, __m128i a, __m128i b)
+{
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// The interior of the row is processed 8 pixels at a time, starting from an even column, with the sums of the
+// scalar code on 16 bits
+VISP_SIMD_TARGET_SSE2 void demosaicBilinear_sse2(const unsigned char *up, const unsigned char *cur,
+                                                 const unsigned char *down, unsigned char *rgba, unsigned int width,
+                                                 bool redRow, unsigned int rx)
+{
+  // Lanes of the columns whose color is the one of the row (red or blue), the other ones are green
+  const unsigned int rowColorCol = redRow ? rx : 1 - rx;
+  const __m128i rowColorMask =
+      rowColorCol == 0 ? _mm_set1_epi32(0xFFFF) : _mm_set1_epi32(static_cast<int>(0xFFFF0000u));
+  const __m128i one = _mm_set1_epi16(1);
+  const __m128i two = _mm_set1_epi16(2);
+
+  const unsigned int j0 = std::min(2u, width);
+  demosaicBilinearRow_scalar(up, cur, down, rgba, 0, j0, width, redRow, rx);
+  unsigned int j = j0;
+  for (; j + 9 <= width; j += 8) {
+    const __m128i c = load8(cur + j), cl = load8(cur + j - 1), cr = load8(cur + j + 1);
+    const __m128i u = load8(up + j), ul = load8(up + j - 1), ur = load8(up + j + 1);
+    const __m128i d = load8(down + j), dl = load8(down + j - 1), dr = load8(down + j + 1);
+
+    const __m128i vsum = _mm_add_epi16(u, d);
+    const __m128i hsum = _mm_add_epi16(cl, cr);
+    const __m128i cross = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(vsum, hsum), two), 2);
+    const __m128i diag =
+        _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(_mm_add_epi16(ul, ur), _mm_add_epi16(dl, dr)), two), 2);
+    const __m128i hor = _mm_srli_epi16(_mm_add_epi16(hsum, one), 1);
+    const __m128i ver = _mm_srli_epi16(_mm_add_epi16(vsum, one), 1);
+
+    const __m128i rowColor = blend(rowColorMask, c, hor);
+    const __m128i green = blend(rowColorMask, cross, c);
+    const __m128i otherColor = blend(rowColorMask, diag, ver);
+    if (redRow) {
+      storeRGBa_sse2(rgba + 4 * j, _mm_setzero_si128(), rowColor, green, otherColor);
+    } else {
+      storeRGBa_sse2(rgba + 4 * j, _mm_setzero_si128(), otherColor, green, rowColor);
+    }
+  }
+  demosaicBilinearRow_scalar(up, cur, down, rgba, j, width, width, redRow, rx);
+}
+#endif
+
+typedef void (*DemosaicRowFunc)(const unsigned char *up, const unsigned char *cur, const unsigned char *down,
+                                unsigned char *rgba, unsigned int width, bool redRow, unsigned int rx);
+
+const vpSimdDispatcher<DemosaicRowFunc> demosaicBilinearRow =
+    vpSimdDispatcher<DemosaicRowFunc>(demosaicBilinear_scalar)
+#if VISP_HAVE_SIMD_DISPATCH
+        .add(vpCPUFeatures::SIMD_SSE2, demosaicBilinear_sse2)
+#endif
+    ;
+
+void demosaicBilinear(const unsigned char *bayer, unsigned int bayerStride, unsigned char *rgba,
+                      unsigned int rgbaStride, unsigned int width, unsigned int height, unsigned int rx,
+                      unsigned int ry, unsigned int nThreads)
+{
+  if (width < 2 || height < 2) {
+    throw(vpException(vpException::dimensionError,
+                      "Bayer demosaicing of a %ux%u image: the size should be at least 2x2", width, height));
+  }
+
+  const DemosaicRowFunc rowFunc = demosaicBilinearRow.get();
+#if defined _OPENMP
+  if (nThreads > 1) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for schedule(static) if (nThreads != 1)
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < static_cast<int>(height); i++) {
+    // Mirrored rows at the borders
+    const unsigned char *up = bayer + (i > 0 ? i - 1 : 1) * bayerStride;
+    const unsigned char *down = bayer + (i + 1 < static_cast<int>(height) ? i + 1 : height - 2) * bayerStride;
+    rowFunc(up, bayer + i * bayerStride, down, rgba + i * rgbaStride, width, (static_cast<unsigned int>(i) & 1) == ry,
+            rx);
+  }
+}
+
+// Run one packed row kernel on all the rows of the image
+void convertPackedRows(PackedRowFunc rowFunc, bool toRGB, const unsigned char *src, unsigned int srcStride,
+                       unsigned char *dst, unsigned int dstStride, unsigned int width, unsigned int height,
+                       unsigned int nThreads)
+{
+#if defined _OPENMP
+  if (nThreads > 1) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for schedule(static) if (nThreads != 1)
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < static_cast<int>(height); i++) {
+    if (toRGB) {
+      packedRowToRGB(rowFunc, src + i * srcStride, dst + i * dstStride, width);
+    } else {
+      rowFunc(src + i * srcStride, dst + i * dstStride, width);
+    }
+  }
+}
+
+// Convert the last pixel of the rows of a YUYV image of odd width with 2 * width bytes per row. It is stored as
+// (y u) and uses the v of the previous macro-pixel, or 128 when the width is 1.
+void yuyvLastPixels(const unsigned char *yuyv, unsigned char *dst, unsigned int pixelSize, unsigned int width,
+                    unsigned int height)
+{
+  for (unsigned int i = 0; i < height; i++) {
+    const unsigned char *s = yuyv + 2 * (i + 1) * width - 2;
+    int dr, dg, db;
+    chromaYUYV(s[1], width > 1 ? s[-1] : 128, dr, dg, db);
+    unsigned char rgba[4];
+    storeRGBa(rgba, s[0], dr, dg, db);
+    memcpy(dst + ((i + 1) * width - 1) * pixelSize, rgba, pixelSize);
+  }
+}
+
+void convertPlanarRows(PlanarRowFunc rowFunc, bool toRGB, const unsigned char *y, unsigned int yStride,
+                       const unsigned char *u, unsigned int uStride, const unsigned char *v, unsigned int vStride,
+                       unsigned char *dst, unsigned int dstStride, unsigned int width, unsigned int height,
+                       unsigned int nThreads)
+{
+#if defined _OPENMP
+  if (nThreads > 1) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for schedule(static) if (nThreads != 1)
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < static_cast<int>(height); i++) {
+    const unsigned char *yRow = y + i * yStride;
+    const unsigned char *uRow = u + (i / 2) * uStride;
+    const unsigned char *vRow = v + (i / 2) * vStride;
+    if (toRGB) {
+      planarRowToRGB(rowFunc, yRow, uRow, vRow, dst + i * dstStride, width);
+    } else {
+      rowFunc(yRow, uRow, vRow, dst + i * dstStride, width);
+    }
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...) to RGB32.
+  Destination rgba memory area has to be allocated before.
+
+  The rows hold 2 * width bytes: when the width is odd, the last pixel of a row
+  is stored as (y u) and uses the v of the previous macro-pixel.
+
+  The alpha component of the converted image is set to vpRGBa::alpha_default.
+
+  \sa YUV422ToRGBa()
+*/
+void vpImageConvert::YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height)
+{
+  YUYVToRGBa(yuyv, 2 * width, rgba, 4 * width, width & ~1u, height, 1);
+  if (width % 2) {
+    yuyvLastPixels(yuyv, rgba, 4, width, height);
+  }
+}
+
+/*!
+  Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...)
+  to RGB24. Destination rgb memory area has to be allocated before.
+
+  The rows hold 2 * width bytes, see YUYVToRGBa(unsigned char *, unsigned char *, unsigned int, unsigned int)
+  for an odd width.
+
+  \sa YUV422ToRGB()
+*/
+void vpImageConvert::YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned int width, unsigned int height)
+{
+  YUYVToRGB(yuyv, 2 * width, rgb, 3 * width, width & ~1u, height, 1);
+  if (width % 2) {
+    yuyvLastPixels(yuyv, rgb, 3, width, height);
+  }
+}
+
+/*!
+  Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...) to RGBa,
+  with the same coefficients as YUYVToRGBa(unsigned char *, unsigned char *, unsigned int, unsigned int).
+
+  The rows of the source and of the destination may be padded, and the
+  destination can be the bitmap of an existing image, so that the frames of a
+  camera stream are converted without any memory allocation. The rows are
+  converted with SIMD instructions when available (see
+  vpCPUFeatures::getSimdLevel()), and in parallel when OpenMP is available.
+
+  The alpha component of the converted image is set to vpRGBa::alpha_default.
+
+  \param yuyv : Source image. Each row holds ceil(width / 2) macro-pixels.
+  \param yuyvStride : Number of bytes between two rows of the source.
+  \param rgba : Destination image, allocated by the caller.
+  \param rgbaStride : Number of bytes between two rows of the destination.
+  \param width : Number of pixels of a row.
+  \param height : Number of rows.
+  \param nThreads : Number of threads, 0 to use the OpenMP default, 1 to run
+  in the calling thread.
+*/
+void vpImageConvert::YUYVToRGBa(const unsigned char *yuyv, unsigned int yuyvStride, unsigned char *rgba,
+                                unsigned int rgbaStride, unsigned int width, unsigned int height,
+                                unsigned int nThreads)
+{
+  convertPackedRows(yuyvToRGBa.get(), false, yuyv, yuyvStride, rgba, rgbaStride, width, height, nThreads);
+}
+
+/*!
+  Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...) to RGB.
+
+  \sa YUYVToRGBa(const unsigned char *, unsigned int, unsigned char *, unsigned int, unsigned int, unsigned int,
+  unsigned int) for the parameters.
+*/
+void vpImageConvert::YUYVToRGB(const unsigned char *yuyv, unsigned int yuyvStride, unsigned char *rgb,
+                               unsigned int rgbStride, unsigned int width, unsigned int height, unsigned int nThreads)
+{
+  convertPackedRows(yuyvToRGBa.get(), true, yuyv, yuyvStride, rgb, rgbStride, width, height, nThreads);
+}
+
+/*!
+  Extract the luminance of an image in YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...).
+
+  \sa YUYVToRGBa(const unsigned char *, unsigned int, unsigned char *, unsigned int, unsigned int, unsigned int,
+  unsigned int) for the parameters.
+*/
+void vpImageConvert::YUYVToGrey(const unsigned char *yuyv, unsigned int yuyvStride, unsigned char *grey,
+                                unsigned int greyStride, unsigned int width, unsigned int height,
+                                unsigned int nThreads)
+{
+  convertPackedRows(evenBytes.get(), false, yuyv, yuyvStride, grey, greyStride, width, height, nThreads);
+}
+
+/*!
+  Convert an image from YUV 4:2:2 (u01 y0 v01 y1 u23 y2 v23 y3 ...) to RGBa,
+  with the same coefficients as YUV422ToRGBa(unsigned char *, unsigned char *, unsigned int).
+
+  \sa YUYVToRGBa(const unsigned char *, unsigned int, unsigned char *, unsigned int, unsigned int, unsigned int,
+  unsigned int) for the parameters.
+*/
+void vpImageConvert::YUV422ToRGBa(const unsigned char *yuv, unsigned int yuvStride, unsigned char *rgba,
+                                  unsigned int rgbaStride, unsigned int width, unsigned int height,
+                                  unsigned int nThreads)
+{
+  convertPackedRows(uyvyToRGBa.get(), false, yuv, yuvStride, rgba, rgbaStride, width, height, nThreads);
+}
+
+/*!
+  Convert an image from YUV 4:2:2 (u01 y0 v01 y1 u23 y2 v23 y3 ...) to RGB.
+
+  \sa YUYVToRGBa(const unsigned char *, unsigned int, unsigned char *, unsigned int, unsigned int, unsigned int,
+  unsigned int) for the parameters.
+*/
+void vpImageConvert::YUV422ToRGB(const unsigned char *yuv, unsigned int yuvStride, unsigned char *rgb,
+                                 unsigned int rgbStride, unsigned int width, unsigned int height,
+                                 unsigned int nThreads)
+{
+  convertPackedRows(uyvyToRGBa.get(), true, yuv, yuvStride, rgb, rgbStride, width, height, nThreads);
+}
+
+/*!
+  Extract the luminance of an image in YUV 4:2:2 (u01 y0 v01 y1 u23 y2 v23 y3 ...).
+
+  \sa YUYVToRGBa(const unsigned char *, unsigned int, unsigned char *, unsigned int, unsigned int, unsigned int,
+  unsigned int) for the parameters.
+*/
+void vpImageConvert::YUV422ToGrey(const unsigned char *yuv, unsigned int yuvStride, unsigned char *grey,
+                                  unsigned int greyStride, unsigned int width, unsigned int height,
+                                  unsigned int nThreads)
+{
+  convertPackedRows(oddBytes.get(), false, yuv, yuvStride, grey, greyStride, width, height, nThreads);
+}
+
+/*!
+  Convert a planar YUV 4:2:0 image to RGBa, with the same coefficients as
+  YUV420ToRGBa(unsigned char *, unsigned char *, unsigned int, unsigned int).
+
+  The three planes are given separately, so that I420 and YV12 buffers, or
+  planes with padded rows, are converted without copy. The chroma planes have
+  ceil(width / 2) x ceil(height / 2) pixels. The rows are converted with SIMD
+  instructions when available, and in parallel when OpenMP is available.
+
+  The alpha component of the converted image is set to vpRGBa::alpha_default.
+
+  \param y, u, v : Luminance and chroma planes.
+  \param yStride, uStride, vStride : Number of bytes between two rows of each plane.
+  \param rgba : Destination image, allocated by the caller.
+  \param rgbaStride : Number of bytes between two rows of the destination.
+  \param width : Number of pixels of a row.
+  \param height : Number of rows.
+  \param nThreads : Number of threads, 0 to use the OpenMP default, 1 to run
+  in the calling thread.
+*/
+void vpImageConvert::YUV420ToRGBa(const unsigned char *y, unsigned int yStride, const unsigned char *u,
+                                  unsigned int uStride, const unsigned char *v, unsigned int vStride,
+                                  unsigned char *rgba, unsigned int rgbaStride, unsigned int width,
+                                  unsigned int height, unsigned int nThreads)
+{
+  convertPlanarRows(planarToRGBa.get(), false, y, yStride, u, uStride, v, vStride, rgba, rgbaStride, width, height,
+                    nThreads);
+}
+
+/*!
+  Convert a planar YUV 4:2:0 image to RGB.
+
+  \sa YUV420ToRGBa(const unsigned char *, unsigned int, const unsigned char *, unsigned int, const unsigned char *,
+  unsigned int, unsigned char *, unsigned int, unsigned int, unsigned int, unsigned int) for the parameters.
+*/
+void vpImageConvert::YUV420ToRGB(const unsigned char *y, unsigned int yStride, const unsigned char *u,
+                                 unsigned int uStride, const unsigned char *v, unsigned int vStride,
+                                 unsigned char *rgb, unsigned int rgbStride, unsigned int width, unsigned int height,
+                                 unsigned int nThreads)
+{
+  convertPlanarRows(planarToRGBa.get(), true, y, yStride, u, uStride, v, vStride, rgb, rgbStride, width, height,
+                    nThreads);
+}
+
+/*!
+  Convert a big-endian MONO16 image (two bytes per pixel) to grey, keeping
+  the most significant byte as MONO16ToGrey(unsigned char *, unsigned char *, unsigned int) does.
+
+  The conversion can be done in place.
+
+  \sa YUYVToRGBa(const unsigned char *, unsigned int, unsigned char *, unsigned int, unsigned int, unsigned int,
+  unsigned int) for the parameters.
+*/
+void vpImageConvert::MONO16ToGrey(const unsigned char *grey16, unsigned int grey16Stride, unsigned char *grey,
+                                  unsigned int greyStride, unsigned int width, unsigned int height,
+                                  unsigned int nThreads)
+{
+  if (grey16 == grey) {
+    // The rows have to be converted in order not to overwrite the next ones
+    nThreads = 1;
+  }
+  convertPackedRows(evenBytes.get(), false, grey16, grey16Stride, grey, greyStride, width, height, nThreads);
+}
+
+/*!
+  Convert a big-endian MONO16 image (two bytes per pixel) to RGBa.
+
+  The alpha component of the converted image is set to vpRGBa::alpha_default.
+
+  \sa YUYVToRGBa(const unsigned char *, unsigned int, unsigned char *, unsigned int, unsigned int, unsigned int,
+  unsigned int) for the parameters.
+*/
+void vpImageConvert::MONO16ToRGBa(const unsigned char *grey16, unsigned int grey16Stride, unsigned char *rgba,
+                                  unsigned int rgbaStride, unsigned int width, unsigned int height,
+                                  unsigned int nThreads)
+{
+  convertPackedRows(mono16ToRGBa.get(), false, grey16, grey16Stride, rgba, rgbaStride, width, height, nThreads);
+}
+
+/*!
+  Bilinear demosaicing of a Bayer image whose first row starts with B G, to RGBa.
+
+  Each missing color is the mean of the 2 or 4 nearest pixels of that color.
+  The image is mirrored at the borders. The rows are processed in parallel
+  when OpenMP is available.
+
+  The alpha component of the converted image is set to vpRGBa::alpha_default.
+
+  \param bggr : Raw Bayer image.
+  \param bggrStride : Number of bytes between two rows of the Bayer image.
+  \param rgba : Destination image, allocated by the caller.
+  \param rgbaStride : Number of bytes between two rows of the destination.
+  \param width : Number of pixels of a row, at least 2.
+  \param height : Number of rows, at least 2.
+  \param nThreads : Number of threads, 0 to use the OpenMP default, 1 to run
+  in the calling thread.
+
+  \exception vpException::dimensionError : If the image is smaller than 2x2.
+*/
+void vpImageConvert::demosaicBGGRToRGBaBilinear(const unsigned char *bggr, unsigned int bggrStride,
+                                                unsigned char *rgba, unsigned int rgbaStride, unsigned int width,
+                                                unsigned int height, unsigned int nThreads)
+{
+  demosaicBilinear(bggr, bggrStride, rgba, rgbaStride, width, height, 1, 1, nThreads);
+}
+
+/*!
+  Bilinear demosaicing of a Bayer image whose first row starts with G B, to RGBa.
+
+  \sa demosaicBGGRToRGBaBilinear() for the parameters.
+*/
+void vpImageConvert::demosaicGBRGToRGBaBilinear(const unsigned char *gbrg, unsigned int gbrgStride,
+                                                unsigned char *rgba, unsigned int rgbaStride, unsigned int width,
+                                                unsigned int height, unsigned int nThreads)
+{
+  demosaicBilinear(gbrg, gbrgStride, rgba, rgbaStride, width, height, 0, 1, nThreads);
+}
+
+/*!
+  Bilinear demosaicing of a Bayer image whose first row starts with G R, to RGBa.
+
+  \sa demosaicBGGRToRGBaBilinear() for the parameters.
+*/
+void vpImageConvert::demosaicGRBGToRGBaBilinear(const unsigned char *grbg, unsigned int grbgStride,
+                                                unsigned char *rgba, unsigned int rgbaStride, unsigned int width,
+                                                unsigned int height, unsigned int nThreads)
+{
+  demosaicBilinear(grbg, grbgStride, rgba, rgbaStride, width, height, 1, 0, nThreads);
+}
+
+/*!
+  Bilinear demosaicing of a Bayer image whose first row starts with R G, to RGBa.
+
+  \sa demosaicBGGRToRGBaBilinear() for the parameters.
+*/
+void vpImageConvert::demosaicRGGBToRGBaBilinear(const unsigned char *rggb, unsigned int rggbStride,
+                                                unsigned char *rgba, unsigned int rgbaStride, unsigned int width,
+                                                unsigned int height, unsigned int nThreads)
+{
+  demosaicBilinear(rggb, rggbStride, rgba, rgbaStride, width, height, 0, 0, nThreads);
+}
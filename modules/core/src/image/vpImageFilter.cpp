@@ -36,6 +36,12 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <vector>
+
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpRGBa.h>
@@ -47,6 +53,565 @@
 #include <cv.h>
 #endif
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#if defined _OPENMP
+#include <omp.h>
+#endif
+
+#define USE_SSE_CODE 1
+#if VISP_HAVE_SSE2 && USE_SSE_CODE
+#define USE_SSE 1
+#else
+#define USE_SSE 0
+#endif
+
+namespace
+{
+// Number of rows filtered at once by a thread
+const int bandHeight = 64;
+
+// Index of the pixel used for the index idx along an axis of n pixels
+inline int borderIndex(int idx, int n, const vpImageFilter::vpBorderType &border)
+{
+  if (idx < 0) {
+    idx = border == vpImageFilter::BORDER_REPLICATE ? 0 : -idx;
+  } else if (idx >= n) {
+    idx = border == vpImageFilter::BORDER_REPLICATE ? n - 1 : 2 * n - idx - 1;
+  }
+  return (std::max)(0, (std::min)(idx, n - 1));
+}
+
+// dst[j] += k * src[j]
+inline void axpy(float *dst, const float *src, float k, int n, bool checkSSE2)
+{
+  int j = 0;
+#if USE_SSE
+  if (checkSSE2) {
+    const __m128 vk = _mm_set1_ps(k);
+    for (; j <= n - 4; j += 4) {
+      _mm_storeu_ps(dst + j, _mm_add_ps(_mm_loadu_ps(dst + j), _mm_mul_ps(vk, _mm_loadu_ps(src + j))));
+    }
+  }
+#else
+  (void)checkSSE2;
+#endif
+  for (; j < n; j++) {
+    dst[j] += k * src[j];
+  }
+}
+
+inline void axpy(double *dst, const double *src, double k, int n, bool checkSSE2)
+{
+  int j = 0;
+#if USE_SSE
+  if (checkSSE2) {
+    const __m128d vk = _mm_set1_pd(k);
+    for (; j <= n - 2; j += 2) {
+      _mm_storeu_pd(dst + j, _mm_add_pd(_mm_loadu_pd(dst + j), _mm_mul_pd(vk, _mm_loadu_pd(src + j))));
+    }
+  }
+#else
+  (void)checkSSE2;
+#endif
+  for (; j < n; j++) {
+    dst[j] += k * src[j];
+  }
+}
+
+// dst[j] += k * src[j], the caller ensures that no overflow occurs
+inline void axpy(short *dst, const short *src, short k, int n, bool checkSSE2)
+{
+  int j = 0;
+#if USE_SSE
+  if (checkSSE2) {
+    const __m128i vk = _mm_set1_epi16(k);
+    for (; j <= n - 8; j += 8) {
+      const __m128i vsrc = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + j));
+      const __m128i vdst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + j));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j), _mm_add_epi16(vdst, _mm_mullo_epi16(vsrc, vk)));
+    }
+  }
+#else
+  (void)checkSSE2;
+#endif
+  for (; j < n; j++) {
+    dst[j] = static_cast<short>(dst[j] + k * src[j]);
+  }
+}
+
+// acc[j] += k0 * src0[j] + k1 * src1[j]
+inline void axpy2(int *acc, const short *src0, short k0, const short *src1, short k1, int n, bool checkSSE2)
+{
+  int j = 0;
+#if USE_SSE
+  if (checkSSE2) {
+    const __m128i vk = _mm_set_epi16(k1, k0, k1, k0, k1, k0, k1, k0);
+    for (; j <= n - 8; j += 8) {
+      const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src0 + j));
+      const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + j));
+      __m128i *dst = reinterpret_cast<__m128i *>(acc + j);
+      _mm_storeu_si128(dst, _mm_add_epi32(_mm_loadu_si128(dst), _mm_madd_epi16(_mm_unpacklo_epi16(v0, v1), vk)));
+      _mm_storeu_si128(dst + 1,
+                       _mm_add_epi32(_mm_loadu_si128(dst + 1), _mm_madd_epi16(_mm_unpackhi_epi16(v0, v1), vk)));
+    }
+  }
+#else
+  (void)checkSSE2;
+#endif
+  for (; j < n; j++) {
+    acc[j] += k0 * src0[j] + k1 * src1[j];
+  }
+}
+
+bool useSSE2()
+{
+#if USE_SSE
+  return vpCPUFeatures::checkSimdLevel(vpCPUFeatures::SIMD_SSE2);
+#else
+  return false;
+#endif
+}
+
+void checkKernelSize(unsigned int size)
+{
+  if (size % 2 != 1) {
+    throw(vpImageException(vpImageException::incorrectInitializationError, "Bad separable filter size"));
+  }
+}
+
+// Separable filter computed in floating point with type T
+template <typename T> class vpFloatingPointSepFilter
+{
+public:
+  typedef T RowType;
+  typedef T AccType;
+
+  vpFloatingPointSepFilter(const T *kernelX, unsigned int sizeX, const T *kernelY, unsigned int sizeY)
+    : m_kernelX(kernelX, kernelX + sizeX), m_kernelY(kernelY, kernelY + sizeY), m_checkSSE2(useSSE2())
+  {
+    checkKernelSize(sizeX);
+    checkKernelSize(sizeY);
+  }
+
+  int getSizeX() const { return static_cast<int>(m_kernelX.size()); }
+  int getSizeY() const { return static_cast<int>(m_kernelY.size()); }
+
+  template <typename InType> static inline T toRow(const InType &value) { return static_cast<T>(value); }
+
+  void filterRow(const T *src, T *dst, int width) const
+  {
+    std::fill(dst, dst + width, T(0));
+    for (size_t k = 0; k < m_kernelX.size(); k++) {
+      if (m_kernelX[k] != T(0)) {
+        axpy(dst, src + k, m_kernelX[k], width, m_checkSSE2);
+      }
+    }
+  }
+
+  template <typename OutType> void filterColumn(const T *const *rows, T *acc, OutType *dst, int width) const
+  {
+    std::fill(acc, acc + width, T(0));
+    for (size_t k = 0; k < m_kernelY.size(); k++) {
+      if (m_kernelY[k] != T(0)) {
+        axpy(acc, rows[k], m_kernelY[k], width, m_checkSSE2);
+      }
+    }
+    for (int j = 0; j < width; j++) {
+      dst[j] = static_cast<OutType>(acc[j]);
+    }
+  }
+
+private:
+  std::vector<T> m_kernelX;
+  std::vector<T> m_kernelY;
+  bool m_checkSSE2;
+};
+
+// Separable filter of an unsigned char image computed in fixed point: the horizontal pass is done
+// with short values, the vertical one with int values
+class vpFixedPointSepFilter
+{
+public:
+  typedef short RowType;
+  typedef int AccType;
+
+  vpFixedPointSepFilter(const float *kernelX, unsigned int sizeX, const float *kernelY, unsigned int sizeY)
+    : m_kernelX(), m_kernelY(), m_shiftX(0), m_shiftY(0), m_checkSSE2(useSSE2())
+  {
+    checkKernelSize(sizeX);
+    checkKernelSize(sizeY);
+    m_kernelX = quantize(kernelX, sizeX, UCHAR_MAX, m_shiftX);
+    // The horizontal pass output is in [SHRT_MIN, SHRT_MAX], bounding the coefficients sum by SHRT_MAX
+    // keeps the vertical pass in the int range
+    m_kernelY = quantize(kernelY, sizeY, 1, m_shiftY);
+  }
+
+  int getSizeX() const { return static_cast<int>(m_kernelX.size()); }
+  int getSizeY() const { return static_cast<int>(m_kernelY.size()); }
+
+  static inline short toRow(unsigned char value) { return value; }
+
+  void filterRow(const short *src, short *dst, int width) const
+  {
+    std::fill(dst, dst + width, short(0));
+    for (size_t k = 0; k < m_kernelX.size(); k++) {
+      if (m_kernelX[k] != 0) {
+        axpy(dst, src + k, m_kernelX[k], width, m_checkSSE2);
+      }
+    }
+  }
+
+  template <typename OutType> void filterColumn(const short *const *rows, int *acc, OutType *dst, int width) const
+  {
+    std::fill(acc, acc + width, 0);
+    size_t k = 0;
+    for (; k + 1 < m_kernelY.size(); k += 2) {
+      axpy2(acc, rows[k], m_kernelY[k], rows[k + 1], m_kernelY[k + 1], width, m_checkSSE2);
+    }
+    if (k < m_kernelY.size()) {
+      axpy2(acc, rows[k], m_kernelY[k], rows[k], 0, width, m_checkSSE2);
+    }
+
+    const int shift = m_shiftX + m_shiftY;
+    const int delta = shift > 0 ? 1 << (shift - 1) : 0;
+    for (int j = 0; j < width; j++) {
+      dst[j] = vpMath::saturate<OutType>((acc[j] + delta) >> shift);
+    }
+  }
+
+private:
+  // Fixed-point kernel with the largest scale 2^shift, shift <= 14, for which filtering values in
+  // [-maxInput, maxInput] stays in the short range. The rounding error is put on the central coefficient
+  // so that the sum of the coefficients is kept.
+  static std::vector<short> quantize(const float *kernel, unsigned int size, int maxInput, int &shift)
+  {
+    double sum = 0.;
+    for (unsigned int k = 0; k < size; k++) {
+      sum += kernel[k];
+    }
+
+    std::vector<short> kernelFixed(size);
+    for (shift = 14; shift >= 0; shift--) {
+      const double scale = static_cast<double>(1 << shift);
+      int sumFixed = 0, sumAbsFixed = 0;
+      bool valid = true;
+      for (unsigned int k = 0; k < size && valid; k++) {
+        const double value = vpMath::round(kernel[k] * scale);
+        valid = std::fabs(value) * maxInput <= SHRT_MAX;
+        kernelFixed[k] = static_cast<short>(valid ? value : 0);
+        sumFixed += kernelFixed[k];
+      }
+      if (!valid) {
+        continue;
+      }
+
+      const double center = kernelFixed[size / 2] + vpMath::round(sum * scale) - sumFixed;
+      if (std::fabs(center) * maxInput > SHRT_MAX) {
+        continue;
+      }
+      kernelFixed[size / 2] = static_cast<short>(center);
+
+      for (unsigned int k = 0; k < size; k++) {
+        sumAbsFixed += std::abs(kernelFixed[k]);
+      }
+      if (sumAbsFixed * maxInput <= SHRT_MAX) {
+        return kernelFixed;
+      }
+    }
+
+    throw(vpImageException(vpImageException::incorrectInitializationError,
+                           "Filter coefficients too large for a fixed-point filtering"));
+  }
+
+  std::vector<short> m_kernelX;
+  std::vector<short> m_kernelY;
+  int m_shiftX;
+  int m_shiftY;
+  bool m_checkSSE2;
+};
+
+// Separable correlation of I with the kernels of filter, by bands of rows: each band filters
+// horizontally the rows it needs and then filters them vertically
+template <typename InType, typename OutType, class Filter>
+void sepFilterImpl(const vpImageView<const InType> &I, vpImage<OutType> &If, const Filter &filter,
+                   const vpImageFilter::vpBorderType &borderX, const vpImageFilter::vpBorderType &borderY,
+                   unsigned int nThreads)
+{
+  typedef typename Filter::RowType RowType;
+  typedef typename Filter::AccType AccType;
+
+  If.resize(I.getHeight(), I.getWidth());
+  const int height = static_cast<int>(I.getHeight());
+  const int width = static_cast<int>(I.getWidth());
+  const int halfX = filter.getSizeX() / 2;
+  const int halfY = filter.getSizeY() / 2;
+  const int nbBands = (height + bandHeight - 1) / bandHeight;
+
+#if defined _OPENMP
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for schedule(dynamic)
+#else
+  (void)nThreads;
+#endif
+  for (int band = 0; band < nbBands; band++) {
+    const int rowBegin = band * bandHeight;
+    const int rowEnd = (std::min)(rowBegin + bandHeight, height);
+    const int firstRow = rowBegin - halfY;
+    std::vector<RowType> padded(static_cast<size_t>(width + 2 * halfX));
+    std::vector<RowType> rows(static_cast<size_t>(rowEnd - rowBegin + 2 * halfY) * width);
+    std::vector<AccType> acc(static_cast<size_t>(width));
+    std::vector<const RowType *> window(static_cast<size_t>(filter.getSizeY()));
+
+    for (int r = firstRow; r < rowEnd + halfY; r++) {
+      const InType *src = I[static_cast<unsigned int>(borderIndex(r, height, borderY))];
+      for (int j = -halfX; j < 0; j++) {
+        padded[j + halfX] = Filter::toRow(src[borderIndex(j, width, borderX)]);
+      }
+      for (int j = 0; j < width; j++) {
+        padded[j + halfX] = Filter::toRow(src[j]);
+      }
+      for (int j = width; j < width + halfX; j++) {
+        padded[j + halfX] = Filter::toRow(src[borderIndex(j, width, borderX)]);
+      }
+      filter.filterRow(&padded[0], &rows[static_cast<size_t>(r - firstRow) * width], width);
+    }
+
+    for (int i = rowBegin; i < rowEnd; i++) {
+      OutType *dst = If[static_cast<unsigned int>(i)];
+      if (borderY == vpImageFilter::BORDER_ZERO && (i < halfY || i >= height - halfY)) {
+        std::fill(dst, dst + width, OutType(0));
+        continue;
+      }
+
+      for (size_t k = 0; k < window.size(); k++) {
+        window[k] = &rows[static_cast<size_t>(i - rowBegin + static_cast<int>(k)) * width];
+      }
+      filter.filterColumn(&window[0], &acc[0], dst, width);
+
+      if (borderX == vpImageFilter::BORDER_ZERO) {
+        std::fill(dst, dst + (std::min)(halfX, width), OutType(0));
+        std::fill(dst + (std::max)(width - halfX, 0), dst + width, OutType(0));
+      }
+    }
+  }
+}
+
+template <typename InType, typename OutType, class Filter>
+inline void sepFilterImpl(const vpImage<InType> &I, vpImage<OutType> &If, const Filter &filter,
+                          const vpImageFilter::vpBorderType &borderX, const vpImageFilter::vpBorderType &borderY,
+                          unsigned int nThreads)
+{
+  sepFilterImpl(vpImageView<const InType>(I), If, filter, borderX, borderY, nThreads);
+}
+
+// Full kernel of a symmetric filter given by its (size+1)/2 right coefficients, as returned by
+// vpImageFilter::getGaussianKernel()
+template <typename T> std::vector<T> getSymmetricKernel(const double *filter, unsigned int size)
+{
+  const unsigned int half = (size - 1) / 2;
+  std::vector<T> kernel(2 * half + 1);
+  for (unsigned int i = 0; i <= half; i++) {
+    kernel[half + i] = kernel[half - i] = static_cast<T>(filter[i]);
+  }
+  return kernel;
+}
+
+// Full kernel of an antisymmetric filter given by its (size+1)/2 right coefficients, as returned by
+// vpImageFilter::getGaussianDerivativeKernel()
+template <typename T> std::vector<T> getAntisymmetricKernel(const double *filter, unsigned int size)
+{
+  const unsigned int half = (size - 1) / 2;
+  std::vector<T> kernel(2 * half + 1, T(0));
+  for (unsigned int i = 1; i <= half; i++) {
+    kernel[half + i] = static_cast<T>(filter[i]);
+    kernel[half - i] = static_cast<T>(-filter[i]);
+  }
+  return kernel;
+}
+
+template <typename T> std::vector<T> getGaussianKernel(unsigned int size, double sigma, bool normalize)
+{
+  std::vector<double> fg((size + 1) / 2);
+  vpImageFilter::getGaussianKernel(&fg[0], size, sigma, normalize);
+  return getSymmetricKernel<T>(&fg[0], size);
+}
+
+// Kernel of the derivative filter used by getGradX() and getGradY() when no filter is given
+template <typename T> std::vector<T> getDefaultDerivativeKernel()
+{
+  const double filter[4] = {0., 2047. / 8418., 913. / 8418., 112. / 8418.};
+  return getAntisymmetricKernel<T>(filter, 7);
+}
+
+// 1D factors of the (2*size+1)x(2*size+1) Sobel kernel returned by vpImageFilter::getSobelKernelX(): the
+// derivative along X is computed with derivative, the smoothing along Y with smoothing
+void getSobelKernels(unsigned int size, std::vector<float> &derivative, std::vector<float> &smoothing)
+{
+  if (size == 0)
+    throw vpException(vpException::dimensionError, "Cannot get Sobel kernel of size 0!");
+  if (size > 20)
+    throw vpException(vpException::dimensionError, "Cannot get Sobel kernel of size > 20!");
+
+  const float derivative3[3] = {-1.f, 0.f, 1.f}, smoothing3[3] = {1.f, 2.f, 1.f};
+  derivative.assign(derivative3, derivative3 + 3);
+  smoothing.assign(smoothing3, smoothing3 + 3);
+  // Larger kernels are obtained by smoothing with [1 2 1], as in getSobelKernelY()
+  for (unsigned int i = 1; i < size; i++) {
+    std::vector<float> derivativeNext(derivative.size() + 2, 0.f), smoothingNext(smoothing.size() + 2, 0.f);
+    for (size_t k = 0; k < derivative.size(); k++) {
+      for (size_t l = 0; l < 3; l++) {
+        derivativeNext[k + l] += derivative[k] * smoothing3[l];
+        smoothingNext[k + l] += smoothing[k] * smoothing3[l];
+      }
+    }
+    derivative.swap(derivativeNext);
+    smoothing.swap(smoothingNext);
+  }
+}
+// |dx[j]| + |dy[j]|
+inline void absSum(const short *dx, const short *dy, short *mag, int n, bool checkSSE2)
+{
+  int j = 0;
+#if USE_SSE
+  if (checkSSE2) {
+    const __m128i zero = _mm_setzero_si128();
+    for (; j <= n - 8; j += 8) {
+      const __m128i vdx = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dx + j));
+      const __m128i vdy = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dy + j));
+      const __m128i absDx = _mm_max_epi16(vdx, _mm_sub_epi16(zero, vdx));
+      const __m128i absDy = _mm_max_epi16(vdy, _mm_sub_epi16(zero, vdy));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(mag + j), _mm_add_epi16(absDx, absDy));
+    }
+  }
+#else
+  (void)checkSSE2;
+#endif
+  for (; j < n; j++) {
+    mag[j] = static_cast<short>(std::abs(dx[j]) + std::abs(dy[j]));
+  }
+}
+
+inline void absSum(const float *dx, const float *dy, float *mag, int n, bool checkSSE2)
+{
+  int j = 0;
+#if USE_SSE
+  if (checkSSE2) {
+    const __m128 signMask = _mm_set1_ps(-0.f);
+    for (; j <= n - 4; j += 4) {
+      const __m128 absDx = _mm_andnot_ps(signMask, _mm_loadu_ps(dx + j));
+      const __m128 absDy = _mm_andnot_ps(signMask, _mm_loadu_ps(dy + j));
+      _mm_storeu_ps(mag + j, _mm_add_ps(absDx, absDy));
+    }
+  }
+#else
+  (void)checkSSE2;
+#endif
+  for (; j < n; j++) {
+    mag[j] = std::fabs(dx[j]) + std::fabs(dy[j]);
+  }
+}
+
+// Non-maximum suppression and hysteresis of the Canny detector on the gradients (dIx, dIy)
+template <typename GradType, typename MagType>
+void cannyEdges(const vpImage<GradType> &dIx, const vpImage<GradType> &dIy, double lowerThreshold,
+                double upperThreshold, vpImage<unsigned char> &Ic, unsigned int nThreads)
+{
+  const int height = static_cast<int>(dIx.getHeight());
+  const int width = static_cast<int>(dIx.getWidth());
+  const bool checkSSE2 = useSSE2();
+  const double tan22 = 0.41421356237, tan67 = 2.41421356237;
+  enum { NO_EDGE = 0, CANDIDATE = 1, EDGE = 255 };
+
+  // Gradient magnitude, with a null border
+  vpImage<MagType> mag(static_cast<unsigned int>(height + 2), static_cast<unsigned int>(width + 2), MagType(0));
+  Ic.resize(static_cast<unsigned int>(height), static_cast<unsigned int>(width));
+
+#if defined _OPENMP
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for schedule(static)
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < height; i++) {
+    absSum(dIx[static_cast<unsigned int>(i)], dIy[static_cast<unsigned int>(i)],
+           mag[static_cast<unsigned int>(i + 1)] + 1, width, checkSSE2);
+  }
+
+#if defined _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int i = 0; i < height; i++) {
+    const GradType *dx = dIx[static_cast<unsigned int>(i)];
+    const GradType *dy = dIy[static_cast<unsigned int>(i)];
+    const MagType *prev = mag[static_cast<unsigned int>(i)] + 1;
+    const MagType *cur = mag[static_cast<unsigned int>(i + 1)] + 1;
+    const MagType *next = mag[static_cast<unsigned int>(i + 2)] + 1;
+    unsigned char *edges = Ic[static_cast<unsigned int>(i)];
+
+    for (int j = 0; j < width; j++) {
+      const MagType m = cur[j];
+      edges[j] = NO_EDGE;
+      if (m <= lowerThreshold) {
+        continue;
+      }
+
+      const double ax = std::fabs(static_cast<double>(dx[j]));
+      const double ay = std::fabs(static_cast<double>(dy[j]));
+      bool isMax;
+      if (ay <= tan22 * ax) {
+        isMax = m > cur[j - 1] && m >= cur[j + 1];
+      } else if (ay >= tan67 * ax) {
+        isMax = m > prev[j] && m >= next[j];
+      } else if ((dx[j] > 0) == (dy[j] > 0)) {
+        isMax = m > prev[j - 1] && m > next[j + 1];
+      } else {
+        isMax = m > prev[j + 1] && m > next[j - 1];
+      }
+
+      if (isMax) {
+        edges[j] = m > upperThreshold ? EDGE : CANDIDATE;
+      }
+    }
+  }
+
+  // Hysteresis: the candidates connected to an edge are edges
+  std::vector<int> stack;
+  for (int idx = 0; idx < height * width; idx++) {
+    if (Ic.bitmap[idx] == EDGE) {
+      stack.push_back(idx);
+    }
+  }
+  while (!stack.empty()) {
+    const int idx = stack.back();
+    stack.pop_back();
+    const int i = idx / width, j = idx % width;
+    for (int di = -1; di <= 1; di++) {
+      for (int dj = -1; dj <= 1; dj++) {
+        const int ni = i + di, nj = j + dj;
+        if (ni >= 0 && ni < height && nj >= 0 && nj < width && Ic.bitmap[ni * width + nj] == CANDIDATE) {
+          Ic.bitmap[ni * width + nj] = EDGE;
+          stack.push_back(ni * width + nj);
+        }
+      }
+    }
+  }
+
+  for (int idx = 0; idx < height * width; idx++) {
+    if (Ic.bitmap[idx] == CANDIDATE) {
+      Ic.bitmap[idx] = NO_EDGE;
+    }
+  }
+}
+} // namespace
+
 /*!
   Apply a filter to an image.
   \param I : Image to filter
@@ -75,6 +640,20 @@
   Only pixels in the input image fully covered by the kernel are considered.
 */
 void vpImageFilter::filter(const vpImage<unsigned char> &I, vpImage<double> &If, const vpMatrix &M, bool convolve)
+{
+  filter(vpImageView<const unsigned char>(I), If, M, convolve);
+}
+
+/*!
+  Apply a filter to a view over an image, for instance a region of interest,
+  as filter(const vpImage<unsigned char> &, vpImage<double> &, const vpMatrix &, bool) does.
+  \param I : View to filter.
+  \param If : Filtered image, of the size of the view.
+  \param M : Filter kernel.
+  \param convolve : If true, perform a convolution otherwise a correlation.
+*/
+void vpImageFilter::filter(const vpImageView<const unsigned char> &I, vpImage<double> &If, const vpMatrix &M,
+                           bool convolve)
 {
   unsigned int size_y = M.getRows(), size_x = M.getCols();
   unsigned int half_size_y = size_y / 2, half_size_x = size_x / 2;
@@ -225,39 +804,178 @@ void vpImageFilter::filter(const vpImage<double> &I, vpImage<double> &Iu, vpImag
 void vpImageFilter::sepFilter(const vpImage<unsigned char> &I, vpImage<double> &If, const vpColVector &kernelH,
                               const vpColVector &kernelV)
 {
-  unsigned int size = kernelH.size();
-  unsigned int half_size = size / 2;
+  // Convolution kernels as odd-sized correlation kernels
+  std::vector<double> kernelX(kernelH.size() | 1, 0.), kernelY(kernelV.size() | 1, 0.);
+  for (unsigned int a = 0; a < kernelH.size(); a++) {
+    kernelX[kernelX.size() - 1 - a] = kernelH[a];
+  }
+  for (unsigned int a = 0; a < kernelV.size(); a++) {
+    kernelY[kernelY.size() - 1 - a] = kernelV[a];
+  }
 
-  If.resize(I.getHeight(), I.getWidth(), 0.0);
-  vpImage<double> I_filter(I.getHeight(), I.getWidth(), 0.0);
+  vpFloatingPointSepFilter<double> filter(&kernelX[0], static_cast<unsigned int>(kernelX.size()), &kernelY[0],
+                                          static_cast<unsigned int>(kernelY.size()));
+  sepFilterImpl(I, If, filter, BORDER_ZERO, BORDER_ZERO, 0);
+}
 
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = half_size; j < I.getWidth() - half_size; j++) {
-      double conv = 0.0;
-      for (unsigned int a = 0; a < kernelH.size(); a++) {
-        conv += kernelH[a] * I[i][j + half_size - a];
-      }
+/*!
+  Apply a separable filter, computed in single precision.
 
-      I_filter[i][j] = conv;
-    }
-  }
+  \f[
+    \textbf{I\_filtered} \left( u,v \right) =
+    \sum_{y=0}^{\textbf{sizeY}-1} \textbf{kernelY} \left( y \right)
+    \sum_{x=0}^{\textbf{sizeX}-1} \textbf{kernelX} \left( x \right) \times
+    \textbf{I} \left( u-\frac{\textbf{sizeX}}{2}+x, v-\frac{\textbf{sizeY}}{2}+y \right)
+  \f]
 
-  for (unsigned int i = half_size; i < I.getHeight() - half_size; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      double conv = 0.0;
-      for (unsigned int a = 0; a < kernelV.size(); a++) {
-        conv += kernelV[a] * I_filter[i + half_size - a][j];
-      }
+  \param I : Image to filter.
+  \param If : Filtered image.
+  \param kernelX : Kernel applied along the rows, of size \e sizeX.
+  \param sizeX : Size of \e kernelX. This value should be odd.
+  \param kernelY : Kernel applied along the columns, of size \e sizeY.
+  \param sizeY : Size of \e kernelY. This value should be odd.
+  \param border : Handling of the pixels outside the image.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::sepFilter(const vpImage<unsigned char> &I, vpImage<float> &If, const float *kernelX,
+                              unsigned int sizeX, const float *kernelY, unsigned int sizeY,
+                              const vpBorderType &border, unsigned int nThreads)
+{
+  sepFilter(vpImageView<const unsigned char>(I), If, kernelX, sizeX, kernelY, sizeY, border, nThreads);
+}
 
-      If[i][j] = conv;
-    }
-  }
+/*!
+  Apply a separable filter to a view over an image, computed in single precision as the vpImage version.
+  The borders of the view are handled as the borders of an image.
+
+  \param I : View to filter.
+  \param If : Filtered image, of the size of the view.
+  \param kernelX : Kernel applied along the rows, of size \e sizeX.
+  \param sizeX : Size of \e kernelX. This value should be odd.
+  \param kernelY : Kernel applied along the columns, of size \e sizeY.
+  \param sizeY : Size of \e kernelY. This value should be odd.
+  \param border : Handling of the pixels outside the view.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::sepFilter(const vpImageView<const unsigned char> &I, vpImage<float> &If,
+                              const float *kernelX, unsigned int sizeX, const float *kernelY, unsigned int sizeY,
+                              const vpBorderType &border, unsigned int nThreads)
+{
+  vpFloatingPointSepFilter<float> filter(kernelX, sizeX, kernelY, sizeY);
+  sepFilterImpl(I, If, filter, border, border, nThreads);
+}
+
+/*!
+  Apply a separable filter to a float image, computed in single precision.
+
+  \param I : Image to filter.
+  \param If : Filtered image.
+  \param kernelX : Kernel applied along the rows, of size \e sizeX.
+  \param sizeX : Size of \e kernelX. This value should be odd.
+  \param kernelY : Kernel applied along the columns, of size \e sizeY.
+  \param sizeY : Size of \e kernelY. This value should be odd.
+  \param border : Handling of the pixels outside the image.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+
+  \sa sepFilter(const vpImage<unsigned char> &, vpImage<float> &, const float *, unsigned int, const float *, unsigned int, const vpBorderType &, unsigned int)
+*/
+void vpImageFilter::sepFilter(const vpImage<float> &I, vpImage<float> &If, const float *kernelX, unsigned int sizeX,
+                              const float *kernelY, unsigned int sizeY, const vpBorderType &border,
+                              unsigned int nThreads)
+{
+  vpFloatingPointSepFilter<float> filter(kernelX, sizeX, kernelY, sizeY);
+  sepFilterImpl(I, If, filter, border, border, nThreads);
+}
+
+/*!
+  Apply a separable filter, computed in fixed point. The kernels are scaled by the largest power
+  of two that keeps the horizontal pass in 16 bits, and the result is rounded and saturated to the short
+  range. Integer kernels such as the Sobel ones give exact results.
+
+  \param I : Image to filter.
+  \param If : Filtered image.
+  \param kernelX : Kernel applied along the rows, of size \e sizeX.
+  \param sizeX : Size of \e kernelX. This value should be odd.
+  \param kernelY : Kernel applied along the columns, of size \e sizeY.
+  \param sizeY : Size of \e kernelY. This value should be odd.
+  \param border : Handling of the pixels outside the image.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+
+  \exception vpImageException::incorrectInitializationError : When the sum of the absolute values of
+  \e kernelX is larger than 128.
+*/
+void vpImageFilter::sepFilter(const vpImage<unsigned char> &I, vpImage<short> &If, const float *kernelX,
+                              unsigned int sizeX, const float *kernelY, unsigned int sizeY,
+                              const vpBorderType &border, unsigned int nThreads)
+{
+  sepFilter(vpImageView<const unsigned char>(I), If, kernelX, sizeX, kernelY, sizeY, border, nThreads);
+}
+
+/*!
+  Apply a separable filter to a view over an image, computed in fixed point as the vpImage version.
+  The borders of the view are handled as the borders of an image.
+
+  \param I : View to filter.
+  \param If : Filtered image, of the size of the view.
+  \param kernelX : Kernel applied along the rows, of size \e sizeX.
+  \param sizeX : Size of \e kernelX. This value should be odd.
+  \param kernelY : Kernel applied along the columns, of size \e sizeY.
+  \param sizeY : Size of \e kernelY. This value should be odd.
+  \param border : Handling of the pixels outside the view.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::sepFilter(const vpImageView<const unsigned char> &I, vpImage<short> &If,
+                              const float *kernelX, unsigned int sizeX, const float *kernelY, unsigned int sizeY,
+                              const vpBorderType &border, unsigned int nThreads)
+{
+  vpFixedPointSepFilter filter(kernelX, sizeX, kernelY, sizeY);
+  sepFilterImpl(I, If, filter, border, border, nThreads);
+}
+
+/*!
+  Apply a separable filter, computed in fixed point as the vpImage<short> version, the result being
+  saturated to [0, 255].
+
+  \param I : Image to filter.
+  \param If : Filtered image.
+  \param kernelX : Kernel applied along the rows, of size \e sizeX.
+  \param sizeX : Size of \e kernelX. This value should be odd.
+  \param kernelY : Kernel applied along the columns, of size \e sizeY.
+  \param sizeY : Size of \e kernelY. This value should be odd.
+  \param border : Handling of the pixels outside the image.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::sepFilter(const vpImage<unsigned char> &I, vpImage<unsigned char> &If, const float *kernelX,
+                              unsigned int sizeX, const float *kernelY, unsigned int sizeY,
+                              const vpBorderType &border, unsigned int nThreads)
+{
+  sepFilter(vpImageView<const unsigned char>(I), If, kernelX, sizeX, kernelY, sizeY, border, nThreads);
+}
+
+/*!
+  Apply a separable filter to a view over an image, computed in fixed point as the vpImage version.
+  The borders of the view are handled as the borders of an image.
+
+  \param I : View to filter.
+  \param If : Filtered image, of the size of the view.
+  \param kernelX : Kernel applied along the rows, of size \e sizeX.
+  \param sizeX : Size of \e kernelX. This value should be odd.
+  \param kernelY : Kernel applied along the columns, of size \e sizeY.
+  \param sizeY : Size of \e kernelY. This value should be odd.
+  \param border : Handling of the pixels outside the view.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::sepFilter(const vpImageView<const unsigned char> &I, vpImage<unsigned char> &If,
+                              const float *kernelX, unsigned int sizeX, const float *kernelY, unsigned int sizeY,
+                              const vpBorderType &border, unsigned int nThreads)
+{
+  vpFixedPointSepFilter filter(kernelX, sizeX, kernelY, sizeY);
+  sepFilterImpl(I, If, filter, border, border, nThreads);
 }
 
-#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
 /*!
   Apply the Canny edge operator on the image \e Isrc and return the resulting
-  image \e Ires.
+  image \e Ires. The same threshold is used for the hysteresis.
 
   The following example shows how to use the method:
 
@@ -268,7 +986,6 @@ void vpImageFilter::sepFilter(const vpImage<unsigned char> &I, vpImage<double> &
 
 int main()
 {
-#if VISP_HAVE_OPENCV_VERSION >= 0x020100 // Canny uses OpenCV >=2.1.0
   // Constants for the Canny operator.
   const unsigned int gaussianFilterSize = 5;
   const double thresholdCanny = 15;
@@ -282,7 +999,6 @@ int main()
 
   //Apply the Canny edge operator and set the Icanny image.
   vpImageFilter::canny(Isrc, Icanny, gaussianFilterSize, thresholdCanny, apertureSobel);
-#endif
  return (0);
 }
   \endcode
@@ -294,32 +1010,61 @@ int main()
   \param thresholdCanny : The threshold for the Canny operator. Only value
   greater than this value are marked as an edge).
   \param apertureSobel : Size of the mask for the Sobel operator (odd number).
+
+  \sa canny(const vpImage<unsigned char> &, vpImage<unsigned char> &, unsigned int, double, double, unsigned int, unsigned int)
 */
 void vpImageFilter::canny(const vpImage<unsigned char> &Isrc, vpImage<unsigned char> &Ires,
                           unsigned int gaussianFilterSize, double thresholdCanny,
                           unsigned int apertureSobel)
 {
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
-  IplImage *img_ipl = NULL;
-  vpImageConvert::convert(Isrc, img_ipl);
-  IplImage *edges_ipl;
-  edges_ipl = cvCreateImage(cvSize(img_ipl->width, img_ipl->height), img_ipl->depth, img_ipl->nChannels);
+  canny(Isrc, Ires, gaussianFilterSize, thresholdCanny, thresholdCanny, apertureSobel);
+}
 
-  cvSmooth(img_ipl, img_ipl, CV_GAUSSIAN, (int)gaussianFilterSize, (int)gaussianFilterSize, 0, 0);
-  cvCanny(img_ipl, edges_ipl, thresholdCanny, thresholdCanny, (int)apertureSobel);
+/*!
+  Apply the Canny edge operator on the image \e Isrc and return the resulting
+  image \e Ires.
 
-  vpImageConvert::convert(edges_ipl, Ires);
-  cvReleaseImage(&img_ipl);
-  cvReleaseImage(&edges_ipl);
-#else
-  cv::Mat img_cvmat, edges_cvmat;
-  vpImageConvert::convert(Isrc, img_cvmat);
-  cv::GaussianBlur(img_cvmat, img_cvmat, cv::Size((int)gaussianFilterSize, (int)gaussianFilterSize), 0, 0);
-  cv::Canny(img_cvmat, edges_cvmat, thresholdCanny, thresholdCanny, (int)apertureSobel);
-  vpImageConvert::convert(edges_cvmat, Ires);
-#endif
+  The image is first smoothed by a Gaussian filter, with the standard deviation
+  \f$ 0.3 ((\textbf{gaussianFilterSize} - 1) / 2 - 1) + 0.8 \f$ used by OpenCV, and its gradients are
+  computed by sobel(). The pixels whose gradient magnitude \f$ |I_x| + |I_y| \f$ is a local maximum
+  along the gradient direction and is greater than \e lowerThreshold are edge candidates. The
+  candidates greater than \e upperThreshold are edges, as well as the candidates connected to an
+  edge.
+
+  The smoothing, the gradients and the local maxima are computed in parallel if OpenMP is available.
+  \e Isrc and \e Ires may be the same image.
+
+  \param Isrc : Image to apply the Canny edge detector to.
+  \param Ires : Filtered image (255 means an edge, 0 otherwise).
+  \param gaussianFilterSize : The size of the mask of the Gaussian filter to
+  apply (an odd number).
+  \param lowerThreshold : Gradient magnitude above which a pixel is an edge if it is connected to an edge.
+  \param upperThreshold : Gradient magnitude above which a pixel is an edge.
+  \param apertureSobel : Size of the mask for the Sobel operator (3, 5, 7, ...).
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::canny(const vpImage<unsigned char> &Isrc, vpImage<unsigned char> &Ires,
+                          unsigned int gaussianFilterSize, double lowerThreshold, double upperThreshold,
+                          unsigned int apertureSobel, unsigned int nThreads)
+{
+  if (apertureSobel < 3 || apertureSobel % 2 != 1) {
+    throw(vpImageException(vpImageException::incorrectInitializationError, "Bad Sobel aperture size"));
+  }
+
+  const double sigma = 0.3 * ((gaussianFilterSize - 1) * 0.5 - 1) + 0.8;
+  vpImage<unsigned char> Iblur;
+  gaussianBlur(Isrc, Iblur, gaussianFilterSize, sigma, true, nThreads);
+
+  if (apertureSobel == 3) {
+    vpImage<short> dIx, dIy;
+    sobel(Iblur, dIx, dIy, nThreads);
+    cannyEdges<short, short>(dIx, dIy, lowerThreshold, upperThreshold, Ires, nThreads);
+  } else {
+    vpImage<float> dIx, dIy;
+    sobel(Iblur, dIx, dIy, apertureSobel / 2, nThreads);
+    cannyEdges<float, float>(dIx, dIy, lowerThreshold, upperThreshold, Ires, nThreads);
+  }
 }
-#endif
 
 /*!
   Apply a separable filter.
@@ -327,10 +1072,10 @@ void vpImageFilter::canny(const vpImage<unsigned char> &Isrc, vpImage<unsigned c
 void vpImageFilter::filter(const vpImage<unsigned char> &I, vpImage<double> &GI, const double *filter,
                            unsigned int size)
 {
-  vpImage<double> GIx;
-  filterX(I, GIx, filter, size);
-  filterY(GIx, GI, filter, size);
-  GIx.destroy();
+  const std::vector<double> kernel = getSymmetricKernel<double>(filter, size);
+  vpFloatingPointSepFilter<double> sepFilter(&kernel[0], static_cast<unsigned int>(kernel.size()), &kernel[0],
+                                             static_cast<unsigned int>(kernel.size()));
+  sepFilterImpl(I, GI, sepFilter, BORDER_REFLECT, BORDER_REFLECT, 0);
 }
 
 /*!
@@ -338,10 +1083,10 @@ void vpImageFilter::filter(const vpImage<unsigned char> &I, vpImage<double> &GI,
  */
 void vpImageFilter::filter(const vpImage<double> &I, vpImage<double> &GI, const double *filter, unsigned int size)
 {
-  vpImage<double> GIx;
-  filterX(I, GIx, filter, size);
-  filterY(GIx, GI, filter, size);
-  GIx.destroy();
+  const std::vector<double> kernel = getSymmetricKernel<double>(filter, size);
+  vpFloatingPointSepFilter<double> sepFilter(&kernel[0], static_cast<unsigned int>(kernel.size()), &kernel[0],
+                                             static_cast<unsigned int>(kernel.size()));
+  sepFilterImpl(I, GI, sepFilter, BORDER_REFLECT, BORDER_REFLECT, 0);
 }
 
 void vpImageFilter::filterX(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter,
@@ -482,13 +1227,24 @@ void vpImageFilter::filterY(const vpImage<double> &I, vpImage<double> &dIy, cons
 void vpImageFilter::gaussianBlur(const vpImage<unsigned char> &I, vpImage<double> &GI, unsigned int size, double sigma,
                                  bool normalize)
 {
-  double *fg = new double[(size + 1) / 2];
-  vpImageFilter::getGaussianKernel(fg, size, sigma, normalize);
-  vpImage<double> GIx;
-  vpImageFilter::filterX(I, GIx, fg, size);
-  vpImageFilter::filterY(GIx, GI, fg, size);
-  GIx.destroy();
-  delete[] fg;
+  gaussianBlur(vpImageView<const unsigned char>(I), GI, size, sigma, normalize);
+}
+
+/*!
+  Apply a Gaussian blur to a view over an image, computed as the vpImage version.
+  \param I : Input view.
+  \param GI : Filtered image, of the size of the view.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+*/
+void vpImageFilter::gaussianBlur(const vpImageView<const unsigned char> &I, vpImage<double> &GI, unsigned int size,
+                                 double sigma, bool normalize)
+{
+  const std::vector<double> kernel = ::getGaussianKernel<double>(size, sigma, normalize);
+  vpFloatingPointSepFilter<double> filter(&kernel[0], size, &kernel[0], size);
+  sepFilterImpl(I, GI, filter, BORDER_REFLECT, BORDER_REFLECT, 0);
 }
 
 /*!
@@ -528,13 +1284,82 @@ void vpImageFilter::gaussianBlur(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &GI,
 void vpImageFilter::gaussianBlur(const vpImage<double> &I, vpImage<double> &GI, unsigned int size, double sigma,
                                  bool normalize)
 {
-  double *fg = new double[(size + 1) / 2];
-  vpImageFilter::getGaussianKernel(fg, size, sigma, normalize);
-  vpImage<double> GIx;
-  vpImageFilter::filterX(I, GIx, fg, size);
-  vpImageFilter::filterY(GIx, GI, fg, size);
-  GIx.destroy();
-  delete[] fg;
+  const std::vector<double> kernel = ::getGaussianKernel<double>(size, sigma, normalize);
+  vpFloatingPointSepFilter<double> filter(&kernel[0], size, &kernel[0], size);
+  sepFilterImpl(I, GI, filter, BORDER_REFLECT, BORDER_REFLECT, 0);
+}
+
+/*!
+  Apply a Gaussian blur to an image, computed in single precision.
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+
+  \sa getGaussianKernel() to know which kernel is used.
+ */
+void vpImageFilter::gaussianBlur(const vpImage<unsigned char> &I, vpImage<float> &GI, unsigned int size, double sigma,
+                                 bool normalize, unsigned int nThreads)
+{
+  gaussianBlur(vpImageView<const unsigned char>(I), GI, size, sigma, normalize, nThreads);
+}
+
+/*!
+  Apply a Gaussian blur to a view over an image, computed as the vpImage version.
+  \param I : Input view.
+  \param GI : Filtered image, of the size of the view.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::gaussianBlur(const vpImageView<const unsigned char> &I, vpImage<float> &GI, unsigned int size,
+                                 double sigma, bool normalize, unsigned int nThreads)
+{
+  const std::vector<float> kernel = ::getGaussianKernel<float>(size, sigma, normalize);
+  vpFloatingPointSepFilter<float> filter(&kernel[0], size, &kernel[0], size);
+  sepFilterImpl(I, GI, filter, BORDER_REFLECT, BORDER_REFLECT, nThreads);
+}
+
+/*!
+  Apply a Gaussian blur to an image, computed in fixed point. The result may differ from the
+  floating-point versions by one or two gray levels.
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+
+  \sa getGaussianKernel() to know which kernel is used.
+ */
+void vpImageFilter::gaussianBlur(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI, unsigned int size,
+                                 double sigma, bool normalize, unsigned int nThreads)
+{
+  gaussianBlur(vpImageView<const unsigned char>(I), GI, size, sigma, normalize, nThreads);
+}
+
+/*!
+  Apply a Gaussian blur to a view over an image, computed as the vpImage version.
+  \param I : Input view.
+  \param GI : Filtered image, of the size of the view.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::gaussianBlur(const vpImageView<const unsigned char> &I, vpImage<unsigned char> &GI,
+                                 unsigned int size, double sigma, bool normalize, unsigned int nThreads)
+{
+  const std::vector<float> kernel = ::getGaussianKernel<float>(size, sigma, normalize);
+  vpFixedPointSepFilter filter(&kernel[0], size, &kernel[0], size);
+  sepFilterImpl(I, GI, filter, BORDER_REFLECT, BORDER_REFLECT, nThreads);
 }
 
 /*!
@@ -623,119 +1448,120 @@ void vpImageFilter::getGaussianDerivativeKernel(double *filter, unsigned int siz
 
 void vpImageFilter::getGradX(const vpImage<unsigned char> &I, vpImage<double> &dIx)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  // dIx=0;
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < 3; j++) {
-      dIx[i][j] = 0;
-    }
-    for (unsigned int j = 3; j < I.getWidth() - 3; j++) {
-      dIx[i][j] = vpImageFilter::derivativeFilterX(I, i, j);
-    }
-    for (unsigned int j = I.getWidth() - 3; j < I.getWidth(); j++) {
-      dIx[i][j] = 0;
-    }
-  }
+  const std::vector<double> kernel = getDefaultDerivativeKernel<double>();
+  const double identity = 1.;
+  vpFloatingPointSepFilter<double> filter(&kernel[0], static_cast<unsigned int>(kernel.size()), &identity, 1);
+  sepFilterImpl(I, dIx, filter, BORDER_ZERO, BORDER_ZERO, 0);
 }
 
 void vpImageFilter::getGradY(const vpImage<unsigned char> &I, vpImage<double> &dIy)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  // dIy=0;
-  for (unsigned int i = 0; i < 3; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
-  for (unsigned int i = 3; i < I.getHeight() - 3; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::derivativeFilterY(I, i, j);
-    }
-  }
-  for (unsigned int i = I.getHeight() - 3; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
+  const std::vector<double> kernel = getDefaultDerivativeKernel<double>();
+  const double identity = 1.;
+  vpFloatingPointSepFilter<double> filter(&identity, 1, &kernel[0], static_cast<unsigned int>(kernel.size()));
+  sepFilterImpl(I, dIy, filter, BORDER_ZERO, BORDER_ZERO, 0);
 }
 
 void vpImageFilter::getGradX(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter,
                              unsigned int size)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  //#pragma omp parallel for
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = 0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::derivativeFilterX(I, i, j, filter, size);
-    }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = 0;
-    }
-  }
+  const std::vector<double> kernel = getAntisymmetricKernel<double>(filter, size);
+  const double identity = 1.;
+  vpFloatingPointSepFilter<double> sepFilter(&kernel[0], static_cast<unsigned int>(kernel.size()), &identity, 1);
+  sepFilterImpl(I, dIx, sepFilter, BORDER_ZERO, BORDER_ZERO, 0);
 }
+
 void vpImageFilter::getGradX(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  // dIx=0;
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = 0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::derivativeFilterX(I, i, j, filter, size);
-    }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = 0;
-    }
-  }
+  const std::vector<double> kernel = getAntisymmetricKernel<double>(filter, size);
+  const double identity = 1.;
+  vpFloatingPointSepFilter<double> sepFilter(&kernel[0], static_cast<unsigned int>(kernel.size()), &identity, 1);
+  sepFilterImpl(I, dIx, sepFilter, BORDER_ZERO, BORDER_ZERO, 0);
+}
+
+/*!
+  Compute the gradient along X, in single precision. The columns for which the filter is not fully
+  inside the image are set to 0.
+  \param I : Input image.
+  \param dIx : Gradient along X.
+  \param filter : Derivative kernel which values should be computed using
+  vpImageFilter::getGaussianDerivativeKernel().
+  \param size : Size of the derivative kernel.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::getGradX(const vpImage<unsigned char> &I, vpImage<float> &dIx, const double *filter,
+                             unsigned int size, unsigned int nThreads)
+{
+  getGradX(vpImageView<const unsigned char>(I), dIx, filter, size, nThreads);
+}
+
+/*!
+  Compute the gradient along X of a view over an image, in single precision, as the vpImage version.
+  \param I : Input view.
+  \param dIx : Gradient along X, of the size of the view.
+  \param filter : Derivative kernel which values should be computed using
+  vpImageFilter::getGaussianDerivativeKernel().
+  \param size : Size of the derivative kernel.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::getGradX(const vpImageView<const unsigned char> &I, vpImage<float> &dIx, const double *filter,
+                             unsigned int size, unsigned int nThreads)
+{
+  const std::vector<float> kernel = getAntisymmetricKernel<float>(filter, size);
+  const float identity = 1.f;
+  vpFloatingPointSepFilter<float> sepFilter(&kernel[0], static_cast<unsigned int>(kernel.size()), &identity, 1);
+  sepFilterImpl(I, dIx, sepFilter, BORDER_ZERO, BORDER_ZERO, nThreads);
 }
 
 void vpImageFilter::getGradY(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *filter,
                              unsigned int size)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  //#pragma omp parallel for
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
-  //#pragma omp parallel for
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::derivativeFilterY(I, i, j, filter, size);
-    }
-  }
-  //#pragma omp parallel for
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
+  const std::vector<double> kernel = getAntisymmetricKernel<double>(filter, size);
+  const double identity = 1.;
+  vpFloatingPointSepFilter<double> sepFilter(&identity, 1, &kernel[0], static_cast<unsigned int>(kernel.size()));
+  sepFilterImpl(I, dIy, sepFilter, BORDER_ZERO, BORDER_ZERO, 0);
 }
 
 void vpImageFilter::getGradY(const vpImage<double> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  // dIy=0;
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::derivativeFilterY(I, i, j, filter, size);
-    }
-  }
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
+  const std::vector<double> kernel = getAntisymmetricKernel<double>(filter, size);
+  const double identity = 1.;
+  vpFloatingPointSepFilter<double> sepFilter(&identity, 1, &kernel[0], static_cast<unsigned int>(kernel.size()));
+  sepFilterImpl(I, dIy, sepFilter, BORDER_ZERO, BORDER_ZERO, 0);
+}
+
+/*!
+  Compute the gradient along Y, in single precision. The rows for which the filter is not fully
+  inside the image are set to 0.
+  \param I : Input image.
+  \param dIy : Gradient along Y.
+  \param filter : Derivative kernel which values should be computed using
+  vpImageFilter::getGaussianDerivativeKernel().
+  \param size : Size of the derivative kernel.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::getGradY(const vpImage<unsigned char> &I, vpImage<float> &dIy, const double *filter,
+                             unsigned int size, unsigned int nThreads)
+{
+  getGradY(vpImageView<const unsigned char>(I), dIy, filter, size, nThreads);
+}
+
+/*!
+  Compute the gradient along Y of a view over an image, in single precision, as the vpImage version.
+  \param I : Input view.
+  \param dIy : Gradient along Y, of the size of the view.
+  \param filter : Derivative kernel which values should be computed using
+  vpImageFilter::getGaussianDerivativeKernel().
+  \param size : Size of the derivative kernel.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::getGradY(const vpImageView<const unsigned char> &I, vpImage<float> &dIy, const double *filter,
+                             unsigned int size, unsigned int nThreads)
+{
+  const std::vector<float> kernel = getAntisymmetricKernel<float>(filter, size);
+  const float identity = 1.f;
+  vpFloatingPointSepFilter<float> sepFilter(&identity, 1, &kernel[0], static_cast<unsigned int>(kernel.size()));
+  sepFilterImpl(I, dIy, sepFilter, BORDER_ZERO, BORDER_ZERO, nThreads);
 }
 
 /*!
@@ -750,9 +1576,31 @@ void vpImageFilter::getGradY(const vpImage<double> &I, vpImage<double> &dIy, con
 void vpImageFilter::getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *gaussianKernel,
                                     const double *gaussianDerivativeKernel, unsigned int size)
 {
-  vpImage<double> GIy;
-  vpImageFilter::filterY(I, GIy, gaussianKernel, size);
-  vpImageFilter::getGradX(GIy, dIx, gaussianDerivativeKernel, size);
+  const std::vector<double> kernelX = getAntisymmetricKernel<double>(gaussianDerivativeKernel, size);
+  const std::vector<double> kernelY = getSymmetricKernel<double>(gaussianKernel, size);
+  vpFloatingPointSepFilter<double> filter(&kernelX[0], static_cast<unsigned int>(kernelX.size()), &kernelY[0],
+                                          static_cast<unsigned int>(kernelY.size()));
+  sepFilterImpl(I, dIx, filter, BORDER_ZERO, BORDER_REFLECT, 0);
+}
+
+/*!
+   Compute the gradient along X after applying a gaussian filter along Y, in single precision.
+   \param I : Input image
+   \param dIx : Gradient along X.
+   \param gaussianKernel : Gaussian kernel which values should be computed using vpImageFilter::getGaussianKernel().
+   \param gaussianDerivativeKernel : Gaussian derivative kernel which values should be computed using
+   vpImageFilter::getGaussianDerivativeKernel().
+   \param size : Size of the Gaussian and Gaussian derivative kernels.
+   \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+ */
+void vpImageFilter::getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<float> &dIx, const double *gaussianKernel,
+                                    const double *gaussianDerivativeKernel, unsigned int size, unsigned int nThreads)
+{
+  const std::vector<float> kernelX = getAntisymmetricKernel<float>(gaussianDerivativeKernel, size);
+  const std::vector<float> kernelY = getSymmetricKernel<float>(gaussianKernel, size);
+  vpFloatingPointSepFilter<float> filter(&kernelX[0], static_cast<unsigned int>(kernelX.size()), &kernelY[0],
+                                         static_cast<unsigned int>(kernelY.size()));
+  sepFilterImpl(I, dIx, filter, BORDER_ZERO, BORDER_REFLECT, nThreads);
 }
 
 /*!
@@ -767,9 +1615,31 @@ void vpImageFilter::getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<dou
 void vpImageFilter::getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *gaussianKernel,
                                     const double *gaussianDerivativeKernel, unsigned int size)
 {
-  vpImage<double> GIx;
-  vpImageFilter::filterX(I, GIx, gaussianKernel, size);
-  vpImageFilter::getGradY(GIx, dIy, gaussianDerivativeKernel, size);
+  const std::vector<double> kernelX = getSymmetricKernel<double>(gaussianKernel, size);
+  const std::vector<double> kernelY = getAntisymmetricKernel<double>(gaussianDerivativeKernel, size);
+  vpFloatingPointSepFilter<double> filter(&kernelX[0], static_cast<unsigned int>(kernelX.size()), &kernelY[0],
+                                          static_cast<unsigned int>(kernelY.size()));
+  sepFilterImpl(I, dIy, filter, BORDER_REFLECT, BORDER_ZERO, 0);
+}
+
+/*!
+   Compute the gradient along Y after applying a gaussian filter along X, in single precision.
+   \param I : Input image
+   \param dIy : Gradient along Y.
+   \param gaussianKernel : Gaussian kernel which values should be computed using vpImageFilter::getGaussianKernel().
+   \param gaussianDerivativeKernel : Gaussian derivative kernel which values should be computed using
+   vpImageFilter::getGaussianDerivativeKernel().
+   \param size : Size of the Gaussian and Gaussian derivative kernels.
+   \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+ */
+void vpImageFilter::getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<float> &dIy, const double *gaussianKernel,
+                                    const double *gaussianDerivativeKernel, unsigned int size, unsigned int nThreads)
+{
+  const std::vector<float> kernelX = getSymmetricKernel<float>(gaussianKernel, size);
+  const std::vector<float> kernelY = getAntisymmetricKernel<float>(gaussianDerivativeKernel, size);
+  vpFloatingPointSepFilter<float> filter(&kernelX[0], static_cast<unsigned int>(kernelX.size()), &kernelY[0],
+                                         static_cast<unsigned int>(kernelY.size()));
+  sepFilterImpl(I, dIy, filter, BORDER_REFLECT, BORDER_ZERO, nThreads);
 }
 
 // operation pour pyramide gaussienne
@@ -938,3 +1808,78 @@ double vpImageFilter::getSobelKernelY(double *filter, unsigned int size)
 
   return 1/16.0;
 }
+
+/*!
+  Compute the image gradients with the 3x3 Sobel kernels, in fixed point. The results are exact and
+  not normalized: they are the correlations with the kernels returned by getSobelKernelX() and
+  getSobelKernelY() with size = 1, that is in [-1020, 1020].
+
+  \param I : Input image.
+  \param dIx : Gradient along X.
+  \param dIy : Gradient along Y.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::sobel(const vpImage<unsigned char> &I, vpImage<short> &dIx, vpImage<short> &dIy,
+                          unsigned int nThreads)
+{
+  sobel(vpImageView<const unsigned char>(I), dIx, dIy, nThreads);
+}
+
+/*!
+  Compute the gradients of a view over an image with the 3x3 Sobel kernels, in fixed point, as
+  the vpImage version.
+
+  \param I : Input view.
+  \param dIx : Gradient along X, of the size of the view.
+  \param dIy : Gradient along Y, of the size of the view.
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::sobel(const vpImageView<const unsigned char> &I, vpImage<short> &dIx, vpImage<short> &dIy,
+                          unsigned int nThreads)
+{
+  std::vector<float> derivative, smoothing;
+  getSobelKernels(1, derivative, smoothing);
+  vpFixedPointSepFilter filterX(&derivative[0], 3, &smoothing[0], 3);
+  vpFixedPointSepFilter filterY(&smoothing[0], 3, &derivative[0], 3);
+  sepFilterImpl(I, dIx, filterX, BORDER_REFLECT, BORDER_REFLECT, nThreads);
+  sepFilterImpl(I, dIy, filterY, BORDER_REFLECT, BORDER_REFLECT, nThreads);
+}
+
+/*!
+  Compute the image gradients with the Sobel kernels, in single precision. The results are not
+  normalized: they are the correlations with the kernels returned by getSobelKernelX() and
+  getSobelKernelY().
+
+  \param I : Input image.
+  \param dIx : Gradient along X.
+  \param dIy : Gradient along Y.
+  \param size : Kernel size computed as: kernel_size = size*2 + 1 (max size is 20).
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::sobel(const vpImage<unsigned char> &I, vpImage<float> &dIx, vpImage<float> &dIy,
+                          unsigned int size, unsigned int nThreads)
+{
+  sobel(vpImageView<const unsigned char>(I), dIx, dIy, size, nThreads);
+}
+
+/*!
+  Compute the gradients of a view over an image with the Sobel kernels, in single precision, as
+  the vpImage version.
+
+  \param I : Input view.
+  \param dIx : Gradient along X, of the size of the view.
+  \param dIy : Gradient along Y, of the size of the view.
+  \param size : Kernel size computed as: kernel_size = size*2 + 1 (max size is 20).
+  \param nThreads : Number of threads to use if OpenMP is available (zero to use the default number of threads).
+*/
+void vpImageFilter::sobel(const vpImageView<const unsigned char> &I, vpImage<float> &dIx, vpImage<float> &dIy,
+                          unsigned int size, unsigned int nThreads)
+{
+  std::vector<float> derivative, smoothing;
+  getSobelKernels(size, derivative, smoothing);
+  const unsigned int kernelSize = static_cast<unsigned int>(derivative.size());
+  vpFloatingPointSepFilter<float> filterX(&derivative[0], kernelSize, &smoothing[0], kernelSize);
+  vpFloatingPointSepFilter<float> filterY(&smoothing[0], kernelSize, &derivative[0], kernelSize);
+  sepFilterImpl(I, dIx, filterX, BORDER_REFLECT, BORDER_REFLECT, nThreads);
+  sepFilterImpl(I, dIy, filterY, BORDER_REFLECT, BORDER_REFLECT, nThreads);
+}
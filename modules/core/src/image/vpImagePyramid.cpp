@@ -0,0 +1,134 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Image pyramid with persistent level buffers.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImagePyramid.h>
+#include <Simd/SimdLib.h>
+
+/*!
+  Create an empty pyramid.
+
+  \param filterType : Filter used to compute a level from the previous one.
+*/
+vpImagePyramid::vpImagePyramid(const vpPyramidFilterType &filterType)
+  : m_filterType(filterType), m_nbLevels(0), m_I0(NULL), m_levels()
+{
+}
+
+/*!
+  Build the pyramid of an image. The buffers of the levels are reused when
+  the image size and the filter type do not change between two calls.
+
+  \param I : Full resolution image, used as level 0 without copy. It must
+  remain valid as long as level 0 is accessed.
+  \param nbLevels : Number of levels, including the full resolution image.
+*/
+void vpImagePyramid::build(const vpImage<unsigned char> &I, unsigned int nbLevels)
+{
+  m_I0 = &I;
+  m_nbLevels = nbLevels;
+
+  // Never shrink the storage so that the level buffers stay allocated
+  if (nbLevels > 1 && m_levels.size() < nbLevels - 1) {
+    m_levels.resize(nbLevels - 1);
+  }
+
+  for (unsigned int i = 1; i < nbLevels; i++) {
+    pyrDown(i == 1 ? I : m_levels[i - 2], m_levels[i - 1], m_filterType);
+  }
+}
+
+/*!
+  Return the image at a given pyramid level.
+
+  \param level : Pyramid level, 0 being the full resolution image.
+  \return The image at the requested level.
+
+  \exception vpException::dimensionError : If \e level is not lower than
+  getNbLevels().
+*/
+const vpImage<unsigned char> &vpImagePyramid::getLevel(unsigned int level) const
+{
+  if (level >= m_nbLevels) {
+    throw vpException(vpException::dimensionError, "Pyramid level %d does not exist (%d levels)", level,
+                      m_nbLevels);
+  }
+
+  return level == 0 ? *m_I0 : m_levels[level - 1];
+}
+
+/*!
+  Compute an image twice smaller. \e Idown is only reallocated when its size
+  differs from the expected one.
+
+  \param I : Input image.
+  \param Idown : Downsampled image.
+  \param filterType : Filter applied before subsampling. The BOX and GAUSSIAN
+  filters are SIMD accelerated.
+*/
+void vpImagePyramid::pyrDown(const vpImage<unsigned char> &I, vpImage<unsigned char> &Idown,
+                             const vpPyramidFilterType &filterType)
+{
+  if (filterType == SUBSAMPLING) {
+    Idown.resize(I.getHeight() / 2, I.getWidth() / 2);
+    for (unsigned int i = 0; i < Idown.getHeight(); i++) {
+      const unsigned char *src = I[2 * i];
+      unsigned char *dst = Idown[i];
+      for (unsigned int j = 0; j < Idown.getWidth(); j++) {
+        dst[j] = src[2 * j];
+      }
+    }
+    return;
+  }
+
+  Idown.resize((I.getHeight() + 1) / 2, (I.getWidth() + 1) / 2);
+  if (I.getHeight() < 2 || I.getWidth() < 2) {
+    // Degenerated images: no neighbourhood to filter
+    for (unsigned int i = 0; i < Idown.getHeight(); i++) {
+      for (unsigned int j = 0; j < Idown.getWidth(); j++) {
+        Idown[i][j] = I[2 * i][2 * j];
+      }
+    }
+    return;
+  }
+
+  if (filterType == BOX) {
+    SimdReduceGray2x2(I.bitmap, I.getWidth(), I.getHeight(), I.getWidth(), Idown.bitmap, Idown.getWidth(),
+                      Idown.getHeight(), Idown.getWidth());
+  } else {
+    SimdReduceGray5x5(I.bitmap, I.getWidth(), I.getHeight(), I.getWidth(), Idown.bitmap, Idown.getWidth(),
+                      Idown.getHeight(), Idown.getWidth(), 1);
+  }
+}
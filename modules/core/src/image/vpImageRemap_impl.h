@@ -0,0 +1,366 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Fixed-point bilinear remapping shared by the image warping and undistortion.
+ *
+ *****************************************************************************/
+
+#ifndef vpImageRemap_impl_H
+#define vpImageRemap_impl_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpRGBa.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#define USE_SSE_CODE 1
+#if VISP_HAVE_SSE2 && USE_SSE_CODE
+#define USE_SSE 1
+#else
+#define USE_SSE 0
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*
+  A remap table stores for each destination pixel the offset of the top-left
+  source pixel used by the bilinear interpolation, or -1 if the destination
+  pixel has no source, and the horizontal and vertical weights of the
+  bottom-right source pixel, in [0, vp_remap_weight_one], packed in the low
+  and high bytes of an unsigned short.
+*/
+const int vp_remap_weight_bits = 7;
+const int vp_remap_weight_one = 1 << vp_remap_weight_bits;
+const int vp_remap_rounding_shift = 2 * vp_remap_weight_bits;
+
+/*
+  Integer part and weight of a coordinate x in [0, n), such that index + 1 < n.
+  A coordinate in [n - 1, n) uses the last pixel.
+*/
+inline void vp_remap_quantize(double x, int n, int &index, int &weight)
+{
+  index = static_cast<int>(x);
+  weight = vpMath::round((x - index) * vp_remap_weight_one);
+  if (weight == vp_remap_weight_one) {
+    index++;
+    weight = 0;
+  }
+  if (index >= n - 1) {
+    index = n - 2;
+    weight = vp_remap_weight_one;
+  }
+}
+
+/*
+  Bilinear interpolation of a grayscale row through a remap table, the source
+  rows being srcStride pixels apart. When fillOutside is true the pixels
+  without source are set to 0, otherwise they are left unchanged.
+*/
+inline void vp_remap_row(const unsigned char *src, int srcStride, const int *offsets, const unsigned short *weights,
+                         unsigned char *dst, int n, bool fillOutside, bool checkSSE2)
+{
+  const int one = vp_remap_weight_one, shift = vp_remap_rounding_shift;
+  int j = 0;
+#if USE_SSE
+  if (checkSSE2) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(one);
+    const __m128i oddLanes = _mm_set_epi16(-1, 0, -1, 0, -1, 0, -1, 0);
+    const __m128i rounding = _mm_set1_epi32(1 << (shift - 1));
+    short top[8], bottom[8];
+    for (; j + 4 <= n; j += 4) {
+      bool allInside = true;
+      for (int k = 0; k < 4; k++) {
+        const int offset = offsets[j + k];
+        if (offset >= 0) {
+          const unsigned char *p = src + offset;
+          top[2 * k] = p[0];
+          top[2 * k + 1] = p[1];
+          bottom[2 * k] = p[srcStride];
+          bottom[2 * k + 1] = p[srcStride + 1];
+        } else {
+          top[2 * k] = top[2 * k + 1] = bottom[2 * k] = bottom[2 * k + 1] = 0;
+          allInside = false;
+        }
+      }
+
+      // [fx0, fy0, fx1, fy1, fx2, fy2, fx3, fy3] expanded to [1 - fx0, fx0, 1 - fx1, fx1, ...] and the same for fy
+      const __m128i w = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(weights + j)), zero);
+      const __m128i fx = _mm_shufflehi_epi16(_mm_shufflelo_epi16(w, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 2, 0, 0));
+      const __m128i fy = _mm_shufflehi_epi16(_mm_shufflelo_epi16(w, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+      const __m128i wx = _mm_or_si128(_mm_and_si128(oddLanes, fx), _mm_andnot_si128(oddLanes, _mm_sub_epi16(ones, fx)));
+      const __m128i wy = _mm_or_si128(_mm_and_si128(oddLanes, fy), _mm_andnot_si128(oddLanes, _mm_sub_epi16(ones, fy)));
+
+      const __m128i t = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(top)), wx);
+      const __m128i b = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bottom)), wx);
+      const __m128i tb = _mm_packs_epi32(t, b);
+      __m128i v = _mm_madd_epi16(_mm_unpacklo_epi16(tb, _mm_srli_si128(tb, 8)), wy);
+      v = _mm_srai_epi32(_mm_add_epi32(v, rounding), shift);
+      v = _mm_packs_epi32(v, v);
+      const int packed = _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+      if (allInside || fillOutside) {
+        memcpy(dst + j, &packed, 4);
+      } else {
+        const unsigned char *values = reinterpret_cast<const unsigned char *>(&packed);
+        for (int k = 0; k < 4; k++) {
+          if (offsets[j + k] >= 0) {
+            dst[j + k] = values[k];
+          }
+        }
+      }
+    }
+  }
+#else
+  (void)checkSSE2;
+#endif
+  for (; j < n; j++) {
+    const int offset = offsets[j];
+    if (offset >= 0) {
+      const unsigned char *p = src + offset;
+      const int fx = weights[j] & 0xff, fy = weights[j] >> 8;
+      const int t = p[0] * (one - fx) + p[1] * fx;
+      const int b = p[srcStride] * (one - fx) + p[srcStride + 1] * fx;
+      dst[j] = static_cast<unsigned char>((t * (one - fy) + b * fy + (1 << (shift - 1))) >> shift);
+    } else if (fillOutside) {
+      dst[j] = 0;
+    }
+  }
+}
+
+/*
+  Bilinear interpolation of a color row through a remap table, the source rows
+  being srcStride pixels apart. When fillOutside is true the pixels without
+  source are set to 0, otherwise they are left unchanged.
+*/
+inline void vp_remap_row(const vpRGBa *src, int srcStride, const int *offsets, const unsigned short *weights,
+                         vpRGBa *dst, int n, bool fillOutside, bool checkSSE2)
+{
+  const int one = vp_remap_weight_one, shift = vp_remap_rounding_shift;
+  int j = 0;
+#if USE_SSE
+  if (checkSSE2) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rounding = _mm_set1_epi32(1 << (shift - 1));
+    for (; j < n; j++) {
+      const int offset = offsets[j];
+      if (offset < 0) {
+        if (fillOutside) {
+          dst[j] = vpRGBa(0, 0, 0, 0);
+        }
+        continue;
+      }
+      const int fx = weights[j] & 0xff, fy = weights[j] >> 8;
+      const __m128i wx = _mm_set1_epi32((fx << 16) | (one - fx));
+      const __m128i wy = _mm_set1_epi32((fy << 16) | (one - fy));
+
+      // Two adjacent pixels [r0, g0, b0, a0, r1, g1, b1, a1] interleaved as [r0, r1, g0, g1, b0, b1, a0, a1]
+      __m128i t = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + offset)), zero);
+      __m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + offset + srcStride)), zero);
+      t = _mm_madd_epi16(_mm_unpacklo_epi16(t, _mm_srli_si128(t, 8)), wx);
+      b = _mm_madd_epi16(_mm_unpacklo_epi16(b, _mm_srli_si128(b, 8)), wx);
+      const __m128i tb = _mm_packs_epi32(t, b);
+      __m128i v = _mm_madd_epi16(_mm_unpacklo_epi16(tb, _mm_srli_si128(tb, 8)), wy);
+      v = _mm_srai_epi32(_mm_add_epi32(v, rounding), shift);
+      v = _mm_packs_epi32(v, v);
+      const int packed = _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+      memcpy(reinterpret_cast<unsigned char *>(dst + j), &packed, 4);
+    }
+  }
+#else
+  (void)checkSSE2;
+#endif
+  for (; j < n; j++) {
+    const int offset = offsets[j];
+    if (offset >= 0) {
+      const unsigned char *p0 = reinterpret_cast<const unsigned char *>(src + offset);
+      const unsigned char *p1 = reinterpret_cast<const unsigned char *>(src + offset + srcStride);
+      unsigned char *q = reinterpret_cast<unsigned char *>(dst + j);
+      const int fx = weights[j] & 0xff, fy = weights[j] >> 8;
+      for (int c = 0; c < 4; c++) {
+        const int t = p0[c] * (one - fx) + p0[c + 4] * fx;
+        const int b = p1[c] * (one - fx) + p1[c + 4] * fx;
+        q[c] = static_cast<unsigned char>((t * (one - fy) + b * fy + (1 << (shift - 1))) >> shift);
+      }
+    } else if (fillOutside) {
+      dst[j] = vpRGBa(0, 0, 0, 0);
+    }
+  }
+}
+
+/*
+  Remap table of the destination row i of a warp, m being the 3x3 row-major
+  matrix that maps the destination pixels to the source pixels. The source
+  coordinates are stepped from one pixel to the next, four pixels at a time
+  with SSE2. With nearest neighbor interpolation the weights select the
+  nearest source pixel. With pixelCenter, the pixel coordinates are at their
+  center (0.5, 0.5) instead of their top-left corner. The offsets are computed
+  for source rows srcStride pixels apart.
+*/
+inline void vp_warp_row(const double *m, bool nearest, bool pixelCenter, unsigned int i, int dstWidth, int srcWidth,
+                        int srcHeight, int srcStride, int *offsets, unsigned short *weights, bool checkSSE2)
+{
+  const double half = pixelCenter ? 0.5 : 0.0;
+  // Source coordinates are shifted by 0.5 so that the nearest neighbor is obtained by truncation
+  const double shift = (nearest ? 0.5 : 0.0) - half;
+  const double v = i + half;
+  const double x0 = m[0] * half + m[1] * v + m[2];
+  const double y0 = m[3] * half + m[4] * v + m[5];
+  const double w0 = m[6] * half + m[7] * v + m[8];
+  const bool affine = m[6] == 0.0 && m[7] == 0.0 && m[8] == 1.0;
+  int j = 0;
+#if USE_SSE
+  if (checkSSE2) {
+    const __m128 dx = _mm_set1_ps(static_cast<float>(4 * m[0]));
+    const __m128 dy = _mm_set1_ps(static_cast<float>(4 * m[3]));
+    const __m128 dw = _mm_set1_ps(static_cast<float>(4 * m[6]));
+    __m128 x = _mm_setr_ps(static_cast<float>(x0), static_cast<float>(x0 + m[0]), static_cast<float>(x0 + 2 * m[0]),
+                           static_cast<float>(x0 + 3 * m[0]));
+    __m128 y = _mm_setr_ps(static_cast<float>(y0), static_cast<float>(y0 + m[3]), static_cast<float>(y0 + 2 * m[3]),
+                           static_cast<float>(y0 + 3 * m[3]));
+    __m128 w = _mm_setr_ps(static_cast<float>(w0), static_cast<float>(w0 + m[6]), static_cast<float>(w0 + 2 * m[6]),
+                           static_cast<float>(w0 + 3 * m[6]));
+    const __m128 zerof = _mm_setzero_ps();
+    const __m128 shiftf = _mm_set1_ps(static_cast<float>(shift));
+    const __m128 widthf = _mm_set1_ps(static_cast<float>(srcWidth));
+    const __m128 heightf = _mm_set1_ps(static_cast<float>(srcHeight));
+    const __m128 epsf = _mm_set1_ps(std::numeric_limits<float>::epsilon());
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 scalef = _mm_set1_ps(nearest ? 0.0f : static_cast<float>(vp_remap_weight_one));
+    const __m128i one = _mm_set1_epi32(vp_remap_weight_one);
+    const __m128i lastX = _mm_set1_epi32(srcWidth - 2), lastY = _mm_set1_epi32(srcHeight - 2);
+    const __m128i stride = _mm_set1_epi32(srcStride);
+    const __m128i bias32 = _mm_set1_epi32(0x8000);
+    const __m128i bias16 = _mm_set1_epi16(-0x8000);
+
+    for (; j + 4 <= dstWidth; j += 4) {
+      __m128 u = x, uv = y;
+      __m128 inside = _mm_cmpgt_ps(_mm_and_ps(w, absMask), epsf);
+      if (!affine) {
+        const __m128 inv_w = _mm_div_ps(_mm_set1_ps(1.0f), w);
+        u = _mm_mul_ps(u, inv_w);
+        uv = _mm_mul_ps(uv, inv_w);
+      }
+      u = _mm_add_ps(u, shiftf);
+      uv = _mm_add_ps(uv, shiftf);
+      inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(u, zerof), _mm_cmplt_ps(u, widthf)));
+      inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(uv, zerof), _mm_cmplt_ps(uv, heightf)));
+
+      // Truncation, the coordinates of the pixels inside being positive
+      __m128i ix = _mm_cvttps_epi32(u), iy = _mm_cvttps_epi32(uv);
+      __m128i fx = _mm_cvtps_epi32(_mm_mul_ps(_mm_sub_ps(u, _mm_cvtepi32_ps(ix)), scalef));
+      __m128i fy = _mm_cvtps_epi32(_mm_mul_ps(_mm_sub_ps(uv, _mm_cvtepi32_ps(iy)), scalef));
+
+      // A weight rounded to one moves to the next pixel, the last pixel is reached with a weight of one
+      __m128i carry = _mm_cmpeq_epi32(fx, one);
+      ix = _mm_sub_epi32(ix, carry);
+      fx = _mm_andnot_si128(carry, fx);
+      carry = _mm_cmpeq_epi32(fy, one);
+      iy = _mm_sub_epi32(iy, carry);
+      fy = _mm_andnot_si128(carry, fy);
+      __m128i last = _mm_cmpgt_epi32(ix, lastX);
+      ix = _mm_or_si128(_mm_and_si128(last, lastX), _mm_andnot_si128(last, ix));
+      fx = _mm_or_si128(_mm_and_si128(last, one), _mm_andnot_si128(last, fx));
+      last = _mm_cmpgt_epi32(iy, lastY);
+      iy = _mm_or_si128(_mm_and_si128(last, lastY), _mm_andnot_si128(last, iy));
+      fy = _mm_or_si128(_mm_and_si128(last, one), _mm_andnot_si128(last, fy));
+
+      // iy * srcStride + ix with 32-bit products of the even and odd lanes
+      const __m128i even = _mm_mul_epu32(iy, stride);
+      const __m128i odd = _mm_mul_epu32(_mm_srli_si128(iy, 4), stride);
+      const __m128i rows = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+      const __m128i mask = _mm_castps_si128(inside);
+      const __m128i offset = _mm_or_si128(_mm_and_si128(mask, _mm_add_epi32(rows, ix)), _mm_andnot_si128(mask, _mm_set1_epi32(-1)));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(offsets + j), offset);
+
+      // fx | fy << 8 narrowed to 16 bits
+      __m128i weight = _mm_and_si128(mask, _mm_or_si128(fx, _mm_slli_epi32(fy, 8)));
+      weight = _mm_sub_epi32(weight, bias32);
+      weight = _mm_add_epi16(_mm_packs_epi32(weight, weight), bias16);
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(weights + j), weight);
+
+      x = _mm_add_ps(x, dx);
+      y = _mm_add_ps(y, dy);
+      w = _mm_add_ps(w, dw);
+    }
+  }
+#else
+  (void)checkSSE2;
+#endif
+  for (; j < dstWidth; j++) {
+    const double x = x0 + j * m[0], y = y0 + j * m[3], w = w0 + j * m[6];
+    double u = x, uv = y;
+    bool inside = std::fabs(w) > std::numeric_limits<float>::epsilon();
+    if (inside && !affine) {
+      u /= w;
+      uv /= w;
+    }
+    u += shift;
+    uv += shift;
+    inside = inside && u >= 0 && u < srcWidth && uv >= 0 && uv < srcHeight;
+    if (!inside) {
+      offsets[j] = -1;
+      weights[j] = 0;
+      continue;
+    }
+
+    int ix, iy, fx, fy;
+    if (nearest) {
+      ix = (std::min)(static_cast<int>(u), srcWidth - 1);
+      iy = (std::min)(static_cast<int>(uv), srcHeight - 1);
+      fx = fy = 0;
+      if (ix == srcWidth - 1) {
+        ix--;
+        fx = vp_remap_weight_one;
+      }
+      if (iy == srcHeight - 1) {
+        iy--;
+        fy = vp_remap_weight_one;
+      }
+    } else {
+      vp_remap_quantize(u, srcWidth, ix, fx);
+      vp_remap_quantize(uv, srcHeight, iy, fy);
+    }
+    offsets[j] = iy * srcStride + ix;
+    weights[j] = static_cast<unsigned short>(fx | (fy << 8));
+  }
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
@@ -42,6 +42,108 @@
 
 #include <Simd/SimdLib.hpp>
 
+#include "vpImageRemap_impl.h"
+
+namespace
+{
+// Number of rows warped at once by a thread
+const int warpBandHeight = 32;
+
+// Warp by bands of rows, the remap table of a row being computed just before its interpolation. The step of
+// the source view has to be a multiple of the pixel size.
+template <class Type>
+void warpRemapImpl(const vpImageView<const Type> &src, const vpMatrix &T, vpImage<Type> &dst, bool nearest)
+{
+  double m[9] = {T[0][0], T[0][1], T[0][2], T[1][0], T[1][1], T[1][2], 0.0, 0.0, 1.0};
+  if (T.getRows() == 3) {
+    m[6] = T[2][0];
+    m[7] = T[2][1];
+    m[8] = T[2][2];
+  }
+
+  const int srcWidth = static_cast<int>(src.getWidth()), srcHeight = static_cast<int>(src.getHeight());
+  const int srcStride = static_cast<int>(src.getStep() / sizeof(Type));
+  const int dstWidth = static_cast<int>(dst.getWidth()), dstHeight = static_cast<int>(dst.getHeight());
+  const int nbBands = (dstHeight + warpBandHeight - 1) / warpBandHeight;
+  const bool checkSSE2 = vpCPUFeatures::checkSimdLevel(vpCPUFeatures::SIMD_SSE2);
+
+#if defined _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int band = 0; band < nbBands; band++) {
+    std::vector<int> offsets(static_cast<size_t>(dstWidth));
+    std::vector<unsigned short> weights(static_cast<size_t>(dstWidth));
+    const int rowEnd = (std::min)(dstHeight, (band + 1) * warpBandHeight);
+    for (int i = band * warpBandHeight; i < rowEnd; i++) {
+      vp_warp_row(m, nearest, false, static_cast<unsigned int>(i), dstWidth, srcWidth, srcHeight, srcStride,
+                  &offsets[0], &weights[0], checkSSE2);
+      vp_remap_row(src[0], srcStride, &offsets[0], &weights[0], dst[static_cast<unsigned int>(i)], dstWidth, false,
+                   checkSSE2);
+    }
+  }
+}
+
+// Warp of a view: with fixed-point arithmetic the view is remapped in place, otherwise it is warped on a copy
+template <class Type>
+void warpViewImpl(const vpImageView<const Type> &src, const vpMatrix &T, const vpMatrix &M, vpImage<Type> &dst,
+                  const vpImageTools::vpImageInterpolationType &interpolation, bool fixedPointArithmetic,
+                  bool pixelCenter, unsigned int nThreads)
+{
+  if (!fixedPointArithmetic || pixelCenter || src.getWidth() < 2 || src.getHeight() < 2 ||
+      src.getStep() % sizeof(Type) != 0) {
+    vpImage<Type> Icopy;
+    src.copyTo(Icopy);
+    vpImageTools::warpImage(Icopy, T, dst, interpolation, fixedPointArithmetic, pixelCenter, nThreads);
+    return;
+  }
+
+  if (dst.getSize() == 0) {
+    dst.resize(src.getHeight(), src.getWidth(), Type(0));
+  }
+
+#if defined _OPENMP
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#else
+  (void)nThreads;
+#endif
+
+  const bool nearest = interpolation != vpImageTools::INTERPOLATION_LINEAR;
+  warpRemapImpl(src, M, dst, nearest);
+}
+
+// Same sampling as vpImageTools::resizeNearest() on a strided view
+template <class Type>
+void resizeViewNearest(const vpImageView<const Type> &I, vpImage<Type> &Ires, unsigned int nThreads)
+{
+  const float scaleY = I.getHeight() / static_cast<float>(Ires.getHeight());
+  const float scaleX = I.getWidth() / static_cast<float>(Ires.getWidth());
+  const float half = 0.5f;
+  const int maxX = static_cast<int>(I.getWidth()) - 1;
+  const int maxY = static_cast<int>(I.getHeight()) - 1;
+
+#if defined _OPENMP
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for schedule(dynamic)
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
+    const int y = (std::max)(0, (std::min)(vpMath::round((i + half) * scaleY - half), maxY));
+    const Type *src = I[static_cast<unsigned int>(y)];
+    Type *dst = Ires[static_cast<unsigned int>(i)];
+
+    for (unsigned int j = 0; j < Ires.getWidth(); j++) {
+      const int x = (std::max)(0, (std::min)(vpMath::round((j + half) * scaleX - half), maxX));
+      dst[j] = src[x];
+    }
+  }
+}
+} // namespace
+
 /*!
   Change the look up table (LUT) of an image. Considering pixel gray
   level values \f$ l \f$ in the range \f$[A, B]\f$, this method allows
@@ -863,6 +965,77 @@ void vpImageTools::resizeSimdlib(const vpImage<unsigned char> &Isrc, unsigned in
   Simd::Resize(src, dst, method == INTERPOLATION_LINEAR ? SimdResizeMethodBilinear : SimdResizeMethodArea);
 }
 
+/*!
+  Resize a region of interest of an image, or an image whose rows are padded,
+  without copying it first.
+
+  \param I : Input view.
+  \param Ires : Output image, whose size gives the resized size.
+  \param method : Interpolation method. INTERPOLATION_CUBIC is done on a copy of the view.
+  \param nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+
+  \sa resize(const vpImage<Type> &, vpImage<Type> &, const vpImageInterpolationType &, unsigned int)
+*/
+void vpImageTools::resize(const vpImageView<const unsigned char> &I, vpImage<unsigned char> &Ires,
+                          const vpImageInterpolationType &method, unsigned int nThreads)
+{
+  if (I.getWidth() < 2 || I.getHeight() < 2 || Ires.getWidth() < 2 || Ires.getHeight() < 2) {
+    std::cerr << "Input or output image is too small!" << std::endl;
+    return;
+  }
+
+  if (method == INTERPOLATION_AREA || method == INTERPOLATION_LINEAR) {
+    typedef Simd::View<Simd::Allocator> View;
+    View src(I.getWidth(), I.getHeight(), I.getStep(), View::Gray8, const_cast<unsigned char *>(I[0]));
+    View dst(Ires.getWidth(), Ires.getHeight(), Ires.getWidth(), View::Gray8, Ires.bitmap);
+
+    Simd::Resize(src, dst, method == INTERPOLATION_LINEAR ? SimdResizeMethodBilinear : SimdResizeMethodArea);
+  } else if (method == INTERPOLATION_NEAREST) {
+    resizeViewNearest(I, Ires, nThreads);
+  } else {
+    vpImage<unsigned char> Icopy;
+    I.copyTo(Icopy);
+    resize(Icopy, Ires, method, nThreads);
+  }
+}
+
+/*!
+  Resize a region of interest of a color image, or an image whose rows are
+  padded, without copying it first.
+
+  \param I : Input view.
+  \param Ires : Output image, whose size gives the resized size.
+  \param method : Interpolation method. INTERPOLATION_CUBIC is done on a copy of the view.
+  \param nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+
+  \sa resize(const vpImage<Type> &, vpImage<Type> &, const vpImageInterpolationType &, unsigned int)
+*/
+void vpImageTools::resize(const vpImageView<const vpRGBa> &I, vpImage<vpRGBa> &Ires,
+                          const vpImageInterpolationType &method, unsigned int nThreads)
+{
+  if (I.getWidth() < 2 || I.getHeight() < 2 || Ires.getWidth() < 2 || Ires.getHeight() < 2) {
+    std::cerr << "Input or output image is too small!" << std::endl;
+    return;
+  }
+
+  if (method == INTERPOLATION_AREA || method == INTERPOLATION_LINEAR) {
+    typedef Simd::View<Simd::Allocator> View;
+    View src(I.getWidth(), I.getHeight(), I.getStep(), View::Bgra32,
+             reinterpret_cast<unsigned char *>(const_cast<vpRGBa *>(I[0])));
+    View dst(Ires.getWidth(), Ires.getHeight(), Ires.getWidth() * sizeof(vpRGBa), View::Bgra32, Ires.bitmap);
+
+    Simd::Resize(src, dst, method == INTERPOLATION_LINEAR ? SimdResizeMethodBilinear : SimdResizeMethodArea);
+  } else if (method == INTERPOLATION_NEAREST) {
+    resizeViewNearest(I, Ires, nThreads);
+  } else {
+    vpImage<vpRGBa> Icopy;
+    I.copyTo(Icopy);
+    resize(Icopy, Ires, method, nThreads);
+  }
+}
+
 bool vpImageTools::checkFixedPoint(unsigned int x, unsigned int y, const vpMatrix &T, bool affine)
 {
   double a0 = T[0][0];  double a1 = T[0][1];  double a2 = T[0][2];
@@ -878,3 +1051,123 @@ bool vpImageTools::checkFixedPoint(unsigned int x, unsigned int y, const vpMatri
   const double limit = 1 << 15;
   return (vpMath::abs(x2) < limit) && (vpMath::abs(y2) < limit);
 }
+
+// Transformation from the output to the input pixels of the warp of transformation T
+vpMatrix vpImageTools::inverseWarp(const vpMatrix &T)
+{
+  vpMatrix M = T;
+  if (T.getRows() == 2) {
+    double D = M[0][0] * M[1][1] - M[0][1] * M[1][0];
+    D = !vpMath::nul(D, std::numeric_limits<double>::epsilon()) ? 1.0 / D : 0;
+    double A11 = M[1][1] * D, A22 = M[0][0] * D;
+    M[0][0] = A11; M[0][1] *= -D;
+    M[1][0] *= -D; M[1][1] = A22;
+    double b1 = -M[0][0] * M[0][2] - M[0][1] * M[1][2];
+    double b2 = -M[1][0] * M[0][2] - M[1][1] * M[1][2];
+    M[0][2] = b1; M[1][2] = b2;
+  } else {
+    M = T.inverseByLU();
+  }
+  return M;
+}
+
+/*!
+  Warp with the fixed-point remap kernels, if the image is large enough.
+
+  \param src : Input image.
+  \param T : Transformation from the output to the input pixels.
+  \param dst : Output image, whose pixels without source are left unchanged.
+  \param nearest : Nearest neighbor interpolation if true, bilinear otherwise.
+  \return false if the generic implementation has to be used.
+*/
+bool vpImageTools::warpRemap(const vpImage<unsigned char> &src, const vpMatrix &T, vpImage<unsigned char> &dst,
+                             bool nearest)
+{
+  if (src.getWidth() < 2 || src.getHeight() < 2) {
+    return false;
+  }
+  warpRemapImpl(vpImageView<const unsigned char>(src), T, dst, nearest);
+  return true;
+}
+
+/*!
+  Warp with the fixed-point remap kernels, if the image is large enough.
+
+  \param src : Input image.
+  \param T : Transformation from the output to the input pixels.
+  \param dst : Output image, whose pixels without source are left unchanged.
+  \param nearest : Nearest neighbor interpolation if true, bilinear otherwise.
+  \return false if the generic implementation has to be used.
+*/
+bool vpImageTools::warpRemap(const vpImage<vpRGBa> &src, const vpMatrix &T, vpImage<vpRGBa> &dst, bool nearest)
+{
+  if (src.getWidth() < 2 || src.getHeight() < 2) {
+    return false;
+  }
+  warpRemapImpl(vpImageView<const vpRGBa>(src), T, dst, nearest);
+  return true;
+}
+
+/*!
+  Apply a warping (affine or perspective) transformation to a view over an image, for instance a region of
+  interest of a larger image or a buffer with padded rows, as the vpImage version of warpImage() does. With
+  fixed-point arithmetic and without `pixelCenter`, the view is warped without being copied first.
+
+  \param src : Input view.
+  \param T : Transformation / warping matrix, a `2x3` matrix for an affine transformation
+  or a `3x3` matrix for a perspective transformation (homography).
+  \param dst : Output image, if empty it will be of the same size than src and zero-initialized.
+  \param interpolation : Interpolation method (only INTERPOLATION_NEAREST and INTERPOLATION_LINEAR
+  are accepted, if INTERPOLATION_CUBIC is passed, INTERPOLATION_NEAREST will be used instead).
+  \param fixedPointArithmetic : If true and if `pixelCenter` is false, fixed-point arithmetic is used.
+  \param pixelCenter : If true, pixel coordinates are at (0.5, 0.5), otherwise at (0,0).
+  \param nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+*/
+void vpImageTools::warpImage(const vpImageView<const unsigned char> &src, const vpMatrix &T, vpImage<unsigned char> &dst,
+                             const vpImageInterpolationType &interpolation, bool fixedPointArithmetic,
+                             bool pixelCenter, unsigned int nThreads)
+{
+  if ((T.getRows() != 2 && T.getRows() != 3) || T.getCols() != 3) {
+    std::cerr << "Input transformation must be a (2x3) or (3x3) matrix." << std::endl;
+    return;
+  }
+
+  if (src.empty()) {
+    return;
+  }
+
+  warpViewImpl(src, T, inverseWarp(T), dst, interpolation, fixedPointArithmetic, pixelCenter, nThreads);
+}
+
+/*!
+  Apply a warping (affine or perspective) transformation to a view over an image, for instance a region of
+  interest of a larger image or a buffer with padded rows, as the vpImage version of warpImage() does. With
+  fixed-point arithmetic and without `pixelCenter`, the view is warped without being copied first.
+
+  \param src : Input view.
+  \param T : Transformation / warping matrix, a `2x3` matrix for an affine transformation
+  or a `3x3` matrix for a perspective transformation (homography).
+  \param dst : Output image, if empty it will be of the same size than src and zero-initialized.
+  \param interpolation : Interpolation method (only INTERPOLATION_NEAREST and INTERPOLATION_LINEAR
+  are accepted, if INTERPOLATION_CUBIC is passed, INTERPOLATION_NEAREST will be used instead).
+  \param fixedPointArithmetic : If true and if `pixelCenter` is false, fixed-point arithmetic is used.
+  \param pixelCenter : If true, pixel coordinates are at (0.5, 0.5), otherwise at (0,0).
+  \param nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+*/
+void vpImageTools::warpImage(const vpImageView<const vpRGBa> &src, const vpMatrix &T, vpImage<vpRGBa> &dst,
+                             const vpImageInterpolationType &interpolation, bool fixedPointArithmetic,
+                             bool pixelCenter, unsigned int nThreads)
+{
+  if ((T.getRows() != 2 && T.getRows() != 3) || T.getCols() != 3) {
+    std::cerr << "Input transformation must be a (2x3) or (3x3) matrix." << std::endl;
+    return;
+  }
+
+  if (src.empty()) {
+    return;
+  }
+
+  warpViewImpl(src, T, inverseWarp(T), dst, interpolation, fixedPointArithmetic, pixelCenter, nThreads);
+}
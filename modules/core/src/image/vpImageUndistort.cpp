@@ -0,0 +1,367 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Reusable image undistortion with a precomputed remap table.
+ *
+ *****************************************************************************/
+
+
+#include <cmath>
+#include <limits>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageUndistort.h>
+#include <visp3/core/vpMath.h>
+
+#include "vpImageRemap_impl.h"
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#if defined _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+unsigned int getDefaultNbThreads()
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  return (std::max)(1u, std::thread::hardware_concurrency());
+#elif defined _OPENMP
+  return static_cast<unsigned int>(omp_get_max_threads());
+#else
+  return 1;
+#endif
+}
+} // namespace
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+// Remapping of the rows of one image, split into bands
+class vpImageUndistort::vpRemapJob
+{
+public:
+  vpRemapJob(const vpImageUndistort &undistort, const void *src, void *dst, bool isColor)
+    : m_undistort(undistort), m_src(src), m_dst(dst), m_isColor(isColor),
+      m_checkSSE2(vpCPUFeatures::checkSimdLevel(vpCPUFeatures::SIMD_SSE2))
+  {
+  }
+
+  void processBand(unsigned int band, unsigned int nbBands) const
+  {
+    const unsigned int width = m_undistort.m_width, height = m_undistort.m_height;
+    const unsigned int rowBegin = band * height / nbBands, rowEnd = (band + 1) * height / nbBands;
+    for (unsigned int i = rowBegin; i < rowEnd; i++) {
+      const int *offsets = &m_undistort.m_offsets[i * width];
+      const unsigned short *weights = &m_undistort.m_weights[i * width];
+      if (m_isColor) {
+        vp_remap_row(static_cast<const vpRGBa *>(m_src), static_cast<int>(width), offsets, weights,
+                     static_cast<vpRGBa *>(m_dst) + i * width, static_cast<int>(width), true, m_checkSSE2);
+      } else {
+        vp_remap_row(static_cast<const unsigned char *>(m_src), static_cast<int>(width), offsets, weights,
+                     static_cast<unsigned char *>(m_dst) + i * width, static_cast<int>(width), true, m_checkSSE2);
+      }
+    }
+  }
+
+private:
+  vpRemapJob &operator=(const vpRemapJob &);
+
+  const vpImageUndistort &m_undistort;
+  const void *m_src;
+  void *m_dst;
+  bool m_isColor;
+  bool m_checkSSE2;
+};
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+// Threads waiting for a job, the calling thread processing the first band
+class vpImageUndistort::vpWorkerPool
+{
+public:
+  explicit vpWorkerPool(unsigned int nbWorkers)
+    : m_threads(), m_mutex(), m_start(), m_done(), m_job(NULL), m_generation(0), m_nbPending(0), m_stop(false)
+  {
+    for (unsigned int i = 0; i < nbWorkers; i++) {
+      m_threads.push_back(std::thread(&vpWorkerPool::loop, this, i + 1));
+    }
+  }
+
+  ~vpWorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_start.notify_all();
+    for (size_t i = 0; i < m_threads.size(); i++) {
+      m_threads[i].join();
+    }
+  }
+
+  void run(const vpRemapJob &job)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_job = &job;
+      m_nbPending = static_cast<unsigned int>(m_threads.size());
+      m_generation++;
+    }
+    m_start.notify_all();
+    job.processBand(0, getNbBands());
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_nbPending == 0; });
+    m_job = NULL;
+  }
+
+private:
+  unsigned int getNbBands() const { return static_cast<unsigned int>(m_threads.size()) + 1; }
+
+  void loop(unsigned int band)
+  {
+    unsigned int generation = 0;
+    for (;;) {
+      const vpRemapJob *job;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_start.wait(lock, [&] { return m_stop || m_generation != generation; });
+        if (m_stop) {
+          return;
+        }
+        generation = m_generation;
+        job = m_job;
+      }
+
+      job->processBand(band, getNbBands());
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (--m_nbPending == 0) {
+        m_done.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_start;
+  std::condition_variable m_done;
+  const vpRemapJob *m_job;
+  unsigned int m_generation;
+  unsigned int m_nbPending;
+  bool m_stop;
+};
+#endif
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor. init() has to be called before undistort().
+*/
+vpImageUndistort::vpImageUndistort()
+  : m_width(0), m_height(0), m_nbThreads(0), m_offsets(), m_weights(), m_pool(NULL)
+{
+  setNbThreads(0);
+}
+
+/*!
+  Build the remap table of the camera.
+
+  \param cam : Camera parameters, with or without distortion.
+  \param width, height : Size of the images to undistort.
+  \param nThreads : Number of threads used by undistort(), the calling thread included
+  (zero uses the number of hardware threads).
+*/
+vpImageUndistort::vpImageUndistort(const vpCameraParameters &cam, unsigned int width, unsigned int height,
+                                   unsigned int nThreads)
+  : m_width(0), m_height(0), m_nbThreads(0), m_offsets(), m_weights(), m_pool(NULL)
+{
+  setNbThreads(nThreads);
+  init(cam, width, height);
+}
+
+/*!
+  Destructor. Stop the threads.
+*/
+vpImageUndistort::~vpImageUndistort()
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  delete m_pool;
+#endif
+}
+
+/*!
+  Compute the remap table of the camera. For each destination pixel, the
+  location of the source pixel is given by the distortion model of \e cam.
+
+  \param cam : Camera parameters, with or without distortion.
+  \param width, height : Size of the images to undistort.
+
+  \exception vpException::dimensionError : If the image is smaller than 2x2.
+*/
+void vpImageUndistort::init(const vpCameraParameters &cam, unsigned int width, unsigned int height)
+{
+  if (width < 2 || height < 2) {
+    throw vpException(vpException::dimensionError, "Cannot undistort %ux%u images", height, width);
+  }
+
+  m_width = width;
+  m_height = height;
+  m_offsets.resize(width * height);
+  m_weights.resize(width * height);
+
+  const vpCameraParameters::vpCameraParametersProjType projModel = cam.get_projModel();
+  const double u0 = cam.get_u0(), v0 = cam.get_v0();
+  const double inv_px = 1.0 / cam.get_px(), inv_py = 1.0 / cam.get_py();
+  const double kud = projModel == vpCameraParameters::perspectiveProjWithDistortion ? cam.get_kud() : 0.0;
+  std::vector<double> k;
+  if (projModel == vpCameraParameters::ProjWithKannalaBrandtDistortion) {
+    k = cam.getKannalaBrandtDistortionCoefficients();
+    k.resize(4, 0.0);
+  }
+
+  for (unsigned int v = 0; v < height; v++) {
+    const double deltav = v - v0;
+    for (unsigned int u = 0; u < width; u++) {
+      const double deltau = u - u0;
+      double scale = 1.0;
+      if (projModel == vpCameraParameters::perspectiveProjWithDistortion) {
+        scale = 1.0 + kud * (vpMath::sqr(deltau * inv_px) + vpMath::sqr(deltav * inv_py));
+      } else if (projModel == vpCameraParameters::ProjWithKannalaBrandtDistortion) {
+        const double r = sqrt(vpMath::sqr(deltau * inv_px) + vpMath::sqr(deltav * inv_py));
+        if (r > std::numeric_limits<double>::epsilon()) {
+          const double theta = atan(r), theta2 = theta * theta;
+          scale = theta * (1 + theta2 * (k[0] + theta2 * (k[1] + theta2 * (k[2] + theta2 * k[3])))) / r;
+        }
+      }
+
+      // Location of the pixel in the distorted image
+      const double x = deltau * scale + u0, y = deltav * scale + v0;
+      const unsigned int idx = v * width + u;
+      if (x < 0 || y < 0 || x > width - 1 || y > height - 1) {
+        m_offsets[idx] = -1;
+        m_weights[idx] = 0;
+        continue;
+      }
+
+      int ix, iy, fx, fy;
+      vp_remap_quantize(x, static_cast<int>(width), ix, fx);
+      vp_remap_quantize(y, static_cast<int>(height), iy, fy);
+      m_offsets[idx] = iy * static_cast<int>(width) + ix;
+      m_weights[idx] = static_cast<unsigned short>(fx | (fy << 8));
+    }
+  }
+}
+
+/*!
+  Set the number of threads used by undistort(), the calling thread included.
+  The threads are created here and wait for the next images.
+
+  \param nThreads : Number of threads (zero uses the number of hardware threads).
+*/
+void vpImageUndistort::setNbThreads(unsigned int nThreads)
+{
+  m_nbThreads = nThreads > 0 ? nThreads : getDefaultNbThreads();
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  delete m_pool;
+  m_pool = m_nbThreads > 1 ? new vpWorkerPool(m_nbThreads - 1) : NULL;
+#endif
+}
+
+void vpImageUndistort::run(vpRemapJob &job)
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  if (m_pool != NULL) {
+    m_pool->run(job);
+    return;
+  }
+  job.processBand(0, 1);
+#else
+  const int nbBands = static_cast<int>(m_nbThreads);
+#if defined _OPENMP
+#pragma omp parallel for schedule(static) num_threads(nbBands)
+#endif
+  for (int band = 0; band < nbBands; band++) {
+    job.processBand(static_cast<unsigned int>(band), static_cast<unsigned int>(nbBands));
+  }
+#endif
+}
+
+/*!
+  Undistort a grayscale image.
+
+  \param I : Distorted image, of the size given to init().
+  \param Iundist : Undistorted image. It must not be \e I.
+
+  \exception vpException::notInitialized : If init() was not called.
+  \exception vpException::dimensionError : If the image size differs from the one of init().
+*/
+void vpImageUndistort::undistort(const vpImage<unsigned char> &I, vpImage<unsigned char> &Iundist)
+{
+  if (m_width == 0) {
+    throw vpException(vpException::notInitialized, "The remap table is not initialized");
+  }
+  if (I.getWidth() != m_width || I.getHeight() != m_height) {
+    throw vpException(vpException::dimensionError, "Cannot undistort a %ux%u image with a %ux%u remap table",
+                      I.getHeight(), I.getWidth(), m_height, m_width);
+  }
+
+  Iundist.resize(m_height, m_width);
+  vpRemapJob job(*this, I.bitmap, Iundist.bitmap, false);
+  run(job);
+}
+
+/*!
+  Undistort a color image.
+
+  \param I : Distorted image, of the size given to init().
+  \param Iundist : Undistorted image. It must not be \e I.
+
+  \exception vpException::notInitialized : If init() was not called.
+  \exception vpException::dimensionError : If the image size differs from the one of init().
+*/
+void vpImageUndistort::undistort(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Iundist)
+{
+  if (m_width == 0) {
+    throw vpException(vpException::notInitialized, "The remap table is not initialized");
+  }
+  if (I.getWidth() != m_width || I.getHeight() != m_height) {
+    throw vpException(vpException::dimensionError, "Cannot undistort a %ux%u image with a %ux%u remap table",
+                      I.getHeight(), I.getWidth(), m_height, m_width);
+  }
+
+  Iundist.resize(m_height, m_width);
+  vpRemapJob job(*this, I.bitmap, Iundist.bitmap, true);
+  run(job);
+}
@@ -0,0 +1,202 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Precomputed warp of images by a fixed transformation.
+ *
+ *****************************************************************************/
+
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageWarpMap.h>
+
+#include "vpImageRemap_impl.h"
+
+#if defined _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+// Apply the remap table to the rows of the image
+template <class Type>
+void warpImpl(const vpImage<Type> &src, vpImage<Type> &dst, const std::vector<int> &offsets,
+              const std::vector<unsigned short> &weights, unsigned int nThreads)
+{
+  const int width = static_cast<int>(dst.getWidth());
+  const bool checkSSE2 = vpCPUFeatures::checkSimdLevel(vpCPUFeatures::SIMD_SSE2);
+
+#if defined _OPENMP
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for schedule(static)
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < static_cast<int>(dst.getHeight()); i++) {
+    const size_t idx = static_cast<size_t>(i) * static_cast<size_t>(width);
+    vp_remap_row(src.bitmap, static_cast<int>(src.getWidth()), &offsets[idx], &weights[idx],
+                 dst[static_cast<unsigned int>(i)], width, false, checkSSE2);
+  }
+}
+} // namespace
+
+/*!
+  Default constructor. init() has to be called before warp().
+*/
+vpImageWarpMap::vpImageWarpMap()
+  : m_srcWidth(0), m_srcHeight(0), m_dstWidth(0), m_dstHeight(0), m_offsets(), m_weights()
+{
+}
+
+/*!
+  Compute the source location of the output pixels.
+
+  \param T : Transformation / warping matrix, a `2x3` matrix for an affine transformation
+  or a `3x3` matrix for a perspective transformation (homography), as in vpImageTools::warpImage().
+  \param srcHeight, srcWidth : Size of the images to warp.
+  \param dstHeight, dstWidth : Size of the warped images.
+  \param interpolation : INTERPOLATION_NEAREST or INTERPOLATION_LINEAR (INTERPOLATION_CUBIC is
+  replaced by INTERPOLATION_NEAREST).
+  \param pixelCenter : If true, pixel coordinates are at (0.5, 0.5), otherwise at (0,0).
+*/
+vpImageWarpMap::vpImageWarpMap(const vpMatrix &T, unsigned int srcHeight, unsigned int srcWidth,
+                               unsigned int dstHeight, unsigned int dstWidth,
+                               const vpImageTools::vpImageInterpolationType &interpolation, bool pixelCenter)
+  : m_srcWidth(0), m_srcHeight(0), m_dstWidth(0), m_dstHeight(0), m_offsets(), m_weights()
+{
+  init(T, srcHeight, srcWidth, dstHeight, dstWidth, interpolation, pixelCenter);
+}
+
+/*!
+  Compute the source location of the output pixels.
+
+  \param T : Transformation / warping matrix, a `2x3` matrix for an affine transformation
+  or a `3x3` matrix for a perspective transformation (homography), as in vpImageTools::warpImage().
+  \param srcHeight, srcWidth : Size of the images to warp.
+  \param dstHeight, dstWidth : Size of the warped images.
+  \param interpolation : INTERPOLATION_NEAREST or INTERPOLATION_LINEAR (INTERPOLATION_CUBIC is
+  replaced by INTERPOLATION_NEAREST).
+  \param pixelCenter : If true, pixel coordinates are at (0.5, 0.5), otherwise at (0,0).
+
+  \exception vpException::dimensionError : If \e T is not a 2x3 or 3x3 matrix, or if the images
+  to warp are smaller than 2x2.
+*/
+void vpImageWarpMap::init(const vpMatrix &T, unsigned int srcHeight, unsigned int srcWidth, unsigned int dstHeight,
+                          unsigned int dstWidth, const vpImageTools::vpImageInterpolationType &interpolation,
+                          bool pixelCenter)
+{
+  if ((T.getRows() != 2 && T.getRows() != 3) || T.getCols() != 3) {
+    throw vpException(vpException::dimensionError, "The warping matrix is %ux%u instead of 2x3 or 3x3", T.getRows(),
+                      T.getCols());
+  }
+  if (srcWidth < 2 || srcHeight < 2) {
+    throw vpException(vpException::dimensionError, "Cannot warp %ux%u images", srcHeight, srcWidth);
+  }
+
+  // Transformation from the output to the input pixels
+  vpMatrix H(3, 3);
+  H.eye();
+  for (unsigned int i = 0; i < T.getRows(); i++) {
+    for (unsigned int j = 0; j < 3; j++) {
+      H[i][j] = T[i][j];
+    }
+  }
+  H = H.inverseByLU();
+  double m[9] = {H[0][0], H[0][1], H[0][2], H[1][0], H[1][1], H[1][2], 0.0, 0.0, 1.0};
+  if (T.getRows() == 3) {
+    m[6] = H[2][0];
+    m[7] = H[2][1];
+    m[8] = H[2][2];
+  }
+
+  m_srcWidth = srcWidth;
+  m_srcHeight = srcHeight;
+  m_dstWidth = dstWidth;
+  m_dstHeight = dstHeight;
+  m_offsets.resize(static_cast<size_t>(dstWidth) * dstHeight);
+  m_weights.resize(static_cast<size_t>(dstWidth) * dstHeight);
+
+  const bool nearest = interpolation != vpImageTools::INTERPOLATION_LINEAR;
+  const bool checkSSE2 = vpCPUFeatures::checkSimdLevel(vpCPUFeatures::SIMD_SSE2);
+  for (unsigned int i = 0; i < dstHeight; i++) {
+    const size_t idx = static_cast<size_t>(i) * dstWidth;
+    vp_warp_row(m, nearest, pixelCenter, i, static_cast<int>(dstWidth), static_cast<int>(srcWidth),
+                static_cast<int>(srcHeight), static_cast<int>(srcWidth), &m_offsets[idx], &m_weights[idx], checkSSE2);
+  }
+}
+
+/*!
+  Warp a grayscale image.
+
+  \param src : Image to warp, of the size given to init().
+  \param dst : Warped image. If its size differs from the one given to init(), it is resized and
+  zero-initialized. The pixels without source are left unchanged.
+  \param nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+
+  \exception vpException::dimensionError : If the image size differs from the one of init().
+*/
+void vpImageWarpMap::warp(const vpImage<unsigned char> &src, vpImage<unsigned char> &dst, unsigned int nThreads) const
+{
+  if (src.getWidth() != m_srcWidth || src.getHeight() != m_srcHeight) {
+    throw vpException(vpException::dimensionError, "Cannot warp a %ux%u image with a map computed for %ux%u images",
+                      src.getHeight(), src.getWidth(), m_srcHeight, m_srcWidth);
+  }
+  if (dst.getWidth() != m_dstWidth || dst.getHeight() != m_dstHeight) {
+    dst.resize(m_dstHeight, m_dstWidth, 0);
+  }
+  warpImpl(src, dst, m_offsets, m_weights, nThreads);
+}
+
+/*!
+  Warp a color image.
+
+  \param src : Image to warp, of the size given to init().
+  \param dst : Warped image. If its size differs from the one given to init(), it is resized and
+  zero-initialized. The pixels without source are left unchanged.
+  \param nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+
+  \exception vpException::dimensionError : If the image size differs from the one of init().
+*/
+void vpImageWarpMap::warp(const vpImage<vpRGBa> &src, vpImage<vpRGBa> &dst, unsigned int nThreads) const
+{
+  if (src.getWidth() != m_srcWidth || src.getHeight() != m_srcHeight) {
+    throw vpException(vpException::dimensionError, "Cannot warp a %ux%u image with a map computed for %ux%u images",
+                      src.getHeight(), src.getWidth(), m_srcHeight, m_srcWidth);
+  }
+  if (dst.getWidth() != m_dstWidth || dst.getHeight() != m_dstHeight) {
+    dst.resize(m_dstHeight, m_dstWidth, vpRGBa(0, 0, 0, 0));
+  }
+  warpImpl(src, dst, m_offsets, m_weights, nThreads);
+}
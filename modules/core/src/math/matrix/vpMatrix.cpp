@@ -581,6 +581,13 @@ void vpMatrix::AtA(vpMatrix &B) const
   if ((B.rowNum != colNum) || (B.colNum != colNum))
     B.resize(colNum, colNum, false, false);
 
+  // Tall and skinny matrices, like the Nx6 interaction matrices, are faster
+  // to process with dedicated kernels than with Lapack
+  if (colNum <= 8) {
+    SimdComputeAtWA(data, rowNum, colNum, NULL, B.data);
+    return;
+  }
+
   // If available use Lapack only for large matrices
   bool useLapack = (rowNum > vpMatrix::m_lapack_min_size || colNum > vpMatrix::m_lapack_min_size);
 #if !(defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN) && !defined(VISP_HAVE_GSL))
@@ -635,6 +642,92 @@ vpMatrix vpMatrix::AtA() const
   return B;
 }
 
+/*!
+  Compute the weighted AtA operation such as \f$B = A^T W A\f$, where
+  \f$W = diag(w)\f$. This is the left-hand side of the normal equations of a
+  weighted least squares problem.
+
+  The result is placed in the parameter \e B, which is only reallocated if
+  its size is not the right one.
+
+  \param w : Weight vector, with as many elements as the number of rows of A.
+  \param B : The resulting \f$B = A^T W A\f$ matrix.
+
+  \sa AtA(vpMatrix &) const, Atb(const vpColVector &, const vpColVector &, vpColVector &) const
+*/
+void vpMatrix::AtA(const vpColVector &w, vpMatrix &B) const
+{
+  if (w.getRows() != rowNum) {
+    throw(vpException(vpException::dimensionError, "Cannot compute AtWA with a (%dx%d) matrix and a (%d) weight vector",
+                      rowNum, colNum, w.getRows()));
+  }
+
+  if ((B.rowNum != colNum) || (B.colNum != colNum))
+    B.resize(colNum, colNum, false, false);
+
+  SimdComputeAtWA(data, rowNum, colNum, w.data, B.data);
+}
+
+/*!
+  Compute the Atb operation such as \f$c = A^T b\f$.
+
+  \param b : Column vector, with as many elements as the number of rows of A.
+  \return \f$A^T b\f$
+
+  \sa Atb(const vpColVector &, vpColVector &) const
+*/
+vpColVector vpMatrix::Atb(const vpColVector &b) const
+{
+  vpColVector c;
+
+  Atb(b, c);
+
+  return c;
+}
+
+/*!
+  Compute the Atb operation such as \f$c = A^T b\f$ without computing the
+  transpose of A. This is the right-hand side of the normal equations of a
+  least squares problem.
+
+  \param b : Column vector, with as many elements as the number of rows of A.
+  \param c : The resulting \f$c = A^T b\f$ vector.
+
+  \sa AtA(vpMatrix &) const
+*/
+void vpMatrix::Atb(const vpColVector &b, vpColVector &c) const
+{
+  if (b.getRows() != rowNum) {
+    throw(vpException(vpException::dimensionError, "Cannot compute Atb with a (%dx%d) matrix and a (%d) vector", rowNum,
+                      colNum, b.getRows()));
+  }
+
+  c.resize(colNum, false);
+  SimdComputeAtWb(data, rowNum, colNum, NULL, b.data, c.data);
+}
+
+/*!
+  Compute the weighted Atb operation such as \f$c = A^T W b\f$, where
+  \f$W = diag(w)\f$.
+
+  \param w : Weight vector, with as many elements as the number of rows of A.
+  \param b : Column vector, with as many elements as the number of rows of A.
+  \param c : The resulting \f$c = A^T W b\f$ vector.
+
+  \sa AtA(const vpColVector &, vpMatrix &) const
+*/
+void vpMatrix::Atb(const vpColVector &w, const vpColVector &b, vpColVector &c) const
+{
+  if (b.getRows() != rowNum || w.getRows() != rowNum) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot compute AtWb with a (%dx%d) matrix, a (%d) weight vector and a (%d) vector", rowNum,
+                      colNum, w.getRows(), b.getRows()));
+  }
+
+  c.resize(colNum, false);
+  SimdComputeAtWb(data, rowNum, colNum, w.data, b.data, c.data);
+}
+
 /*!
   Copy operator that allows to convert on of the following container that
   inherit from vpArray2D such as vpMatrix, vpRotationMatrix,
@@ -86,7 +86,7 @@ void vpForceTwistMatrix::eye()
 /*!
   Initialize a force/torque twist transformation matrix to identity.
 */
-vpForceTwistMatrix::vpForceTwistMatrix() : vpArray2D<double>(6, 6) { eye(); }
+vpForceTwistMatrix::vpForceTwistMatrix() : vpArray2D<double>(6, 6, m_storage, m_rowStorage) { eye(); }
 
 /*!
 
@@ -95,7 +95,7 @@ vpForceTwistMatrix::vpForceTwistMatrix() : vpArray2D<double>(6, 6) { eye(); }
 
   \param F : Force/torque twist matrix used as initializer.
 */
-vpForceTwistMatrix::vpForceTwistMatrix(const vpForceTwistMatrix &F) : vpArray2D<double>(6, 6) { *this = F; }
+vpForceTwistMatrix::vpForceTwistMatrix(const vpForceTwistMatrix &F) : vpArray2D<double>(6, 6, m_storage, m_rowStorage) { *this = F; }
 
 /*!
 
@@ -126,7 +126,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpForceTwistMatrix &F) : vpArray2D<
   \f]
 
 */
-vpForceTwistMatrix::vpForceTwistMatrix(const vpHomogeneousMatrix &M, bool full) : vpArray2D<double>(6, 6)
+vpForceTwistMatrix::vpForceTwistMatrix(const vpHomogeneousMatrix &M, bool full) : vpArray2D<double>(6, 6, m_storage, m_rowStorage)
 {
   if (full)
     buildFrom(M);
@@ -154,7 +154,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpHomogeneousMatrix &M, bool full)
 
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t, const vpThetaUVector &thetau)
-  : vpArray2D<double>(6, 6)
+  : vpArray2D<double>(6, 6, m_storage, m_rowStorage)
 {
   buildFrom(t, thetau);
 }
@@ -176,7 +176,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t, const vpThe
   \param thetau : \f$\theta u\f$ rotation vector used to initialize \f$R\f$.
 
 */
-vpForceTwistMatrix::vpForceTwistMatrix(const vpThetaUVector &thetau) : vpArray2D<double>(6, 6) { buildFrom(thetau); }
+vpForceTwistMatrix::vpForceTwistMatrix(const vpThetaUVector &thetau) : vpArray2D<double>(6, 6, m_storage, m_rowStorage) { buildFrom(thetau); }
 
 /*!
 
@@ -198,7 +198,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpThetaUVector &thetau) : vpArray2D
 
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t, const vpRotationMatrix &R)
-  : vpArray2D<double>(6, 6)
+  : vpArray2D<double>(6, 6, m_storage, m_rowStorage)
 {
   buildFrom(t, R);
 }
@@ -220,7 +220,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t, const vpRot
   \param R : Rotation matrix.
 
 */
-vpForceTwistMatrix::vpForceTwistMatrix(const vpRotationMatrix &R) : vpArray2D<double>(6, 6) { buildFrom(R); }
+vpForceTwistMatrix::vpForceTwistMatrix(const vpRotationMatrix &R) : vpArray2D<double>(6, 6, m_storage, m_rowStorage) { buildFrom(R); }
 
 /*!
 
@@ -243,7 +243,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpRotationMatrix &R) : vpArray2D<do
   radians used to initialize \f$R\f$.
 */
 vpForceTwistMatrix::vpForceTwistMatrix(double tx, double ty, double tz, double tux, double tuy, double tuz)
-  : vpArray2D<double>(6, 6)
+  : vpArray2D<double>(6, 6, m_storage, m_rowStorage)
 {
   vpTranslationVector T(tx, ty, tz);
   vpThetaUVector tu(tux, tuy, tuz);
@@ -54,7 +54,7 @@
   rotation vector.
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpQuaternionVector &q)
-  : vpArray2D<double>(4, 4)
+  : vpArray2D<double>(4, 4, m_storage, m_rowStorage)
 {
   buildFrom(t, q);
   (*this)[3][3] = 1.;
@@ -63,20 +63,20 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpQ
 /*!
   Default constructor that initialize an homogeneous matrix as identity.
 */
-vpHomogeneousMatrix::vpHomogeneousMatrix() : vpArray2D<double>(4, 4), m_index(0) { eye(); }
+vpHomogeneousMatrix::vpHomogeneousMatrix() : vpArray2D<double>(4, 4, m_storage, m_rowStorage), m_index(0) { eye(); }
 
 /*!
   Copy constructor that initialize an homogeneous matrix from another
   homogeneous matrix.
 */
-vpHomogeneousMatrix::vpHomogeneousMatrix(const vpHomogeneousMatrix &M) : vpArray2D<double>(4, 4), m_index(0) { *this = M; }
+vpHomogeneousMatrix::vpHomogeneousMatrix(const vpHomogeneousMatrix &M) : vpArray2D<double>(4, 4, m_storage, m_rowStorage), m_index(0) { *this = M; }
 
 /*!
   Construct an homogeneous matrix from a translation vector and \f$\theta {\bf
   u}\f$ rotation vector.
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpThetaUVector &tu)
-  : vpArray2D<double>(4, 4), m_index(0)
+  : vpArray2D<double>(4, 4, m_storage, m_rowStorage), m_index(0)
 {
   buildFrom(t, tu);
   (*this)[3][3] = 1.;
@@ -87,7 +87,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpT
   matrix.
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpRotationMatrix &R)
-  : vpArray2D<double>(4, 4), m_index(0)
+  : vpArray2D<double>(4, 4, m_storage, m_rowStorage), m_index(0)
 {
   insert(R);
   insert(t);
@@ -97,7 +97,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpR
 /*!
   Construct an homogeneous matrix from a pose vector.
  */
-vpHomogeneousMatrix::vpHomogeneousMatrix(const vpPoseVector &p) : vpArray2D<double>(4, 4), m_index(0)
+vpHomogeneousMatrix::vpHomogeneousMatrix(const vpPoseVector &p) : vpArray2D<double>(4, 4, m_storage, m_rowStorage), m_index(0)
 {
   buildFrom(p[0], p[1], p[2], p[3], p[4], p[5]);
   (*this)[3][3] = 1.;
@@ -142,7 +142,7 @@ M:
 0  0  0  1
   \endcode
   */
-vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<float> &v) : vpArray2D<double>(4, 4), m_index(0)
+vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<float> &v) : vpArray2D<double>(4, 4, m_storage, m_rowStorage), m_index(0)
 {
   buildFrom(v);
   (*this)[3][3] = 1.;
@@ -187,7 +187,7 @@ N:
 0  0  0  1
   \endcode
  */
-vpHomogeneousMatrix::vpHomogeneousMatrix(const std::initializer_list<double> &list) : vpArray2D<double>(4, 4), m_index(0)
+vpHomogeneousMatrix::vpHomogeneousMatrix(const std::initializer_list<double> &list) : vpArray2D<double>(4, 4, m_storage, m_rowStorage), m_index(0)
 {
   if (list.size() == 12) {
     std::copy(list.begin(), list.end(), data);
@@ -258,7 +258,7 @@ M:
 0  0  0  1
   \endcode
   */
-vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<double> &v) : vpArray2D<double>(4, 4), m_index(0)
+vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<double> &v) : vpArray2D<double>(4, 4, m_storage, m_rowStorage), m_index(0)
 {
   buildFrom(v);
   (*this)[3][3] = 1.;
@@ -270,7 +270,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<double> &v) : vpArray
   u_z)^T\f$ rotation vector.
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(double tx, double ty, double tz, double tux, double tuy, double tuz)
-  : vpArray2D<double>(4, 4), m_index(0)
+  : vpArray2D<double>(4, 4, m_storage, m_rowStorage), m_index(0)
 {
   buildFrom(tx, ty, tz, tux, tuy, tuz);
   (*this)[3][3] = 1.;
@@ -54,7 +54,7 @@
   in meters.
 
 */
-vpTranslationVector::vpTranslationVector(double tx, double ty, double tz) : vpArray2D<double>(3, 1), m_index(0)
+vpTranslationVector::vpTranslationVector(double tx, double ty, double tz) : vpArray2D<double>(3, 1, m_storage, m_rowStorage), m_index(0)
 {
   (*this)[0] = tx;
   (*this)[1] = ty;
@@ -68,7 +68,7 @@ vpTranslationVector::vpTranslationVector(double tx, double ty, double tz) : vpAr
   \param M : Homogeneous matrix where translations are in meters.
 
 */
-vpTranslationVector::vpTranslationVector(const vpHomogeneousMatrix &M) : vpArray2D<double>(3, 1), m_index(0) { M.extract(*this); }
+vpTranslationVector::vpTranslationVector(const vpHomogeneousMatrix &M) : vpArray2D<double>(3, 1, m_storage, m_rowStorage), m_index(0) { M.extract(*this); }
 
 /*!
   Construct a translation vector \f$ \bf t \f$ from the translation contained
@@ -77,7 +77,7 @@ vpTranslationVector::vpTranslationVector(const vpHomogeneousMatrix &M) : vpArray
   \param p : Pose vector where translations are in meters.
 
 */
-vpTranslationVector::vpTranslationVector(const vpPoseVector &p) : vpArray2D<double>(3, 1), m_index(0)
+vpTranslationVector::vpTranslationVector(const vpPoseVector &p) : vpArray2D<double>(3, 1, m_storage, m_rowStorage), m_index(0)
 {
   (*this)[0] = p[0];
   (*this)[1] = p[1];
@@ -94,7 +94,11 @@ vpTranslationVector::vpTranslationVector(const vpPoseVector &p) : vpArray2D<doub
   vpTranslationVector t2(t1);    // t2 is now a copy of t1
   \endcode
 */
-vpTranslationVector::vpTranslationVector(const vpTranslationVector &tv) : vpArray2D<double>(tv), m_index(0) {}
+vpTranslationVector::vpTranslationVector(const vpTranslationVector &tv)
+  : vpArray2D<double>(3, 1, m_storage, m_rowStorage), m_index(0)
+{
+  *this = tv;
+}
 
 /*!
   Construct a translation vector \f$ \bf t \f$ from a 3-dimension column
@@ -110,7 +114,8 @@ vpTranslationVector::vpTranslationVector(const vpTranslationVector &tv) : vpArra
   \endcode
 
 */
-vpTranslationVector::vpTranslationVector(const vpColVector &v) : vpArray2D<double>(v), m_index(0)
+vpTranslationVector::vpTranslationVector(const vpColVector &v)
+  : vpArray2D<double>(3, 1, m_storage, m_rowStorage), m_index(0)
 {
   if (v.size() != 3) {
     throw(vpException(vpException::dimensionError,
@@ -118,6 +123,7 @@ vpTranslationVector::vpTranslationVector(const vpColVector &v) : vpArray2D<doubl
                       "%d-dimension column vector",
                       v.size()));
   }
+  memcpy(data, v.data, 3 * sizeof(double));
 }
 
 /*!
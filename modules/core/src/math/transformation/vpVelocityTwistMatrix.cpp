@@ -82,7 +82,7 @@ void vpVelocityTwistMatrix::eye()
 /*!
   Initialize a velocity twist transformation matrix as identity.
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix() : vpArray2D<double>(6, 6) { eye(); }
+vpVelocityTwistMatrix::vpVelocityTwistMatrix() : vpArray2D<double>(6, 6, m_storage, m_rowStorage) { eye(); }
 
 /*!
   Initialize a velocity twist transformation matrix from another velocity
@@ -90,7 +90,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix() : vpArray2D<double>(6, 6) { eye()
 
   \param V : Velocity twist matrix used as initializer.
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpVelocityTwistMatrix &V) : vpArray2D<double>(6, 6) { *this = V; }
+vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpVelocityTwistMatrix &V) : vpArray2D<double>(6, 6, m_storage, m_rowStorage) { *this = V; }
 
 /*!
 
@@ -110,7 +110,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpVelocityTwistMatrix &V) : v
   {\bf 0}_{3\times 3} & {\bf R} \end{array} \right] \f]
 
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpHomogeneousMatrix &M, bool full) : vpArray2D<double>(6, 6)
+vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpHomogeneousMatrix &M, bool full) : vpArray2D<double>(6, 6, m_storage, m_rowStorage)
 {
   if (full)
     buildFrom(M);
@@ -133,7 +133,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpHomogeneousMatrix &M, bool
 
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t, const vpThetaUVector &thetau)
-  : vpArray2D<double>(6, 6)
+  : vpArray2D<double>(6, 6, m_storage, m_rowStorage)
 {
   buildFrom(t, thetau);
 }
@@ -150,7 +150,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t, const
   vector \f$R\f$ .
 
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpThetaUVector &thetau) : vpArray2D<double>(6, 6)
+vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpThetaUVector &thetau) : vpArray2D<double>(6, 6, m_storage, m_rowStorage)
 {
   buildFrom(thetau);
 }
@@ -169,7 +169,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpThetaUVector &thetau) : vpA
 
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t, const vpRotationMatrix &R)
-  : vpArray2D<double>(6, 6)
+  : vpArray2D<double>(6, 6, m_storage, m_rowStorage)
 {
   buildFrom(t, R);
 }
@@ -185,7 +185,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t, const
   \param R : Rotation matrix.
 
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpRotationMatrix &R) : vpArray2D<double>(6, 6) { buildFrom(R); }
+vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpRotationMatrix &R) : vpArray2D<double>(6, 6, m_storage, m_rowStorage) { buildFrom(R); }
 
 /*!
 
@@ -203,7 +203,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpRotationMatrix &R) : vpArra
   radians used to initialize \f$R\f$.
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(double tx, double ty, double tz, double tux, double tuy, double tuz)
-  : vpArray2D<double>(6, 6)
+  : vpArray2D<double>(6, 6, m_storage, m_rowStorage)
 {
   vpTranslationVector t(tx, ty, tz);
   vpThetaUVector tu(tux, tuy, tuz);
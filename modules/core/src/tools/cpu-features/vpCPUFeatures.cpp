@@ -36,10 +36,73 @@
 #include "x86/cpu_x86.h"
 #include <visp3/core/vpCPUFeatures.h>
 
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
 namespace vpCPUFeatures
 {
 static const FeatureDetector::cpu_x86 cpu_features;
 
+namespace
+{
+const char *const simd_level_names[SIMD_LEVEL_COUNT] = {"none", "sse2", "ssse3", "sse41", "avx", "avx2", "avx512"};
+
+vpSimdLevel detectSimdLevel()
+{
+  if (!cpu_features.HW_SSE2) {
+    return SIMD_NONE;
+  }
+  if (!cpu_features.HW_SSE3 || !cpu_features.HW_SSSE3) {
+    return SIMD_SSE2;
+  }
+  if (!cpu_features.HW_SSE41 || !cpu_features.HW_SSE42) {
+    return SIMD_SSSE3;
+  }
+  // The AVX registers must also be saved by the operating system
+  if (!cpu_features.HW_AVX || !cpu_features.OS_AVX) {
+    return SIMD_SSE41;
+  }
+  if (!cpu_features.HW_AVX2 || !cpu_features.HW_FMA3) {
+    return SIMD_AVX;
+  }
+  if (!cpu_features.HW_AVX512_F || !cpu_features.HW_AVX512_BW || !cpu_features.OS_AVX512) {
+    return SIMD_AVX2;
+  }
+  return SIMD_AVX512;
+}
+
+// Level requested with the VISP_SIMD environment variable, clamped to the hardware one
+vpSimdLevel initSimdLevel(vpSimdLevel hardwareLevel)
+{
+  const char *env = std::getenv("VISP_SIMD");
+  if (env == NULL || *env == '\0') {
+    return hardwareLevel;
+  }
+
+  std::string name(env);
+  for (size_t i = 0; i < name.size(); i++) {
+    name[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(name[i])));
+  }
+  if (name == "sse4.1") {
+    name = "sse41";
+  }
+  for (int level = SIMD_NONE; level < SIMD_LEVEL_COUNT; level++) {
+    if (name == simd_level_names[level]) {
+      return level < hardwareLevel ? static_cast<vpSimdLevel>(level) : hardwareLevel;
+    }
+  }
+
+  std::cerr << "Warning: unknown SIMD level VISP_SIMD=" << env << ", using " << simd_level_names[hardwareLevel]
+            << std::endl;
+  return hardwareLevel;
+}
+
+const vpSimdLevel hardware_simd_level = detectSimdLevel();
+vpSimdLevel simd_level = initSimdLevel(hardware_simd_level);
+} // namespace
+
 bool checkSSE2() { return cpu_features.HW_SSE2; }
 
 bool checkSSE3() { return cpu_features.HW_SSE3; }
@@ -54,5 +117,57 @@ bool checkAVX() { return cpu_features.HW_AVX; }
 
 bool checkAVX2() { return cpu_features.HW_AVX2; }
 
-void printCPUInfo() { cpu_features.print(); }
+/*!
+  Return true if the CPU has the POPCNT instruction. It is not implied by a
+  SIMD level: some CPUs have SSE4.1 without POPCNT.
+*/
+bool checkPOPCNT() { return cpu_features.HW_POPCNT; }
+
+void printCPUInfo()
+{
+  cpu_features.print();
+  std::cout << "SIMD level used by ViSP: " << simd_level_names[simd_level] << std::endl;
+}
+
+/*!
+  Return true if the SIMD kernels of the given level can be used, that is if
+  \e level is lower than or equal to getSimdLevel().
+*/
+bool checkSimdLevel(vpSimdLevel level) { return level <= simd_level; }
+
+/*!
+  Return the highest SIMD level supported by the CPU and the operating system.
+*/
+vpSimdLevel getHardwareSimdLevel() { return hardware_simd_level; }
+
+/*!
+  Return the SIMD level used by the kernels of ViSP: the hardware one, unless
+  it was lowered by the \c VISP_SIMD environment variable or setSimdLevel().
+*/
+vpSimdLevel getSimdLevel() { return simd_level; }
+
+/*!
+  Return the name of a SIMD level, as accepted by the \c VISP_SIMD environment
+  variable.
+*/
+const char *getSimdLevelName(vpSimdLevel level)
+{
+  return level >= SIMD_NONE && level < SIMD_LEVEL_COUNT ? simd_level_names[level] : "unknown";
+}
+
+/*!
+  Set the SIMD level used by the kernels of ViSP, for instance to compare the
+  results or the speed of two levels. A level higher than
+  getHardwareSimdLevel() is clamped to the hardware one.
+
+  \warning This function is not thread-safe and must not be called while
+  other threads are running ViSP code.
+*/
+void setSimdLevel(vpSimdLevel level)
+{
+  if (level < SIMD_NONE) {
+    level = SIMD_NONE;
+  }
+  simd_level = level < hardware_simd_level ? level : hardware_simd_level;
+}
 } // namespace vpCPUFeatures
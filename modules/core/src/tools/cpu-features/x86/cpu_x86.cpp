@@ -154,6 +154,7 @@ void cpu_x86::detect_host()
     HW_SSSE3 = (info[2] & ((int)1 << 9)) != 0;
     HW_SSE41 = (info[2] & ((int)1 << 19)) != 0;
     HW_SSE42 = (info[2] & ((int)1 << 20)) != 0;
+    HW_POPCNT = (info[2] & ((int)1 << 23)) != 0;
     HW_AES = (info[2] & ((int)1 << 25)) != 0;
 
     HW_AVX = (info[2] & ((int)1 << 28)) != 0;
@@ -211,6 +212,7 @@ void cpu_x86::print() const
   print("    MMX         = ", HW_MMX);
   print("    x64         = ", HW_x64);
   print("    ABM         = ", HW_ABM);
+  print("    POPCNT      = ", HW_POPCNT);
   print("    RDRAND      = ", HW_RDRAND);
   print("    BMI1        = ", HW_BMI1);
   print("    BMI2        = ", HW_BMI2);
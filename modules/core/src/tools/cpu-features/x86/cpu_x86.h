@@ -37,6 +37,7 @@ struct cpu_x86 {
   bool HW_MMX;
   bool HW_x64;
   bool HW_ABM;
+  bool HW_POPCNT;
   bool HW_RDRAND;
   bool HW_BMI1;
   bool HW_BMI2;
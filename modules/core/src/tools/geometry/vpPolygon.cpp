@@ -38,6 +38,8 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <set>
 #include <visp3/core/vpDisplay.h>
@@ -369,6 +371,51 @@ bool vpPolygon::isInside(const vpImagePoint &ip, const PointInPolygonMethod &met
   return test;
 }
 
+/*!
+  Compute the horizontal spans of the pixels of the image row \e i that are
+  inside the polygon. This is equivalent to calling isInside() with the
+  PnPolyRayCasting method on each pixel (i, j) of the row, but the cost only
+  depends on the number of corners instead of the number of pixels.
+
+  \param i : Row (i-coordinate) of the pixels to rasterize.
+  \param spans : Sorted list of half-open intervals [jmin, jmax) of the pixel
+  columns inside the polygon. Empty if the row does not intersect the polygon.
+
+  \sa isInside()
+*/
+void vpPolygon::getRowSpans(int i, std::vector<std::pair<int, int> > &spans) const
+{
+  spans.clear();
+  if (_corners.size() < 3) {
+    return;
+  }
+
+  // Abscissa of the intersections between the row and the polygon edges,
+  // computed as in the PnPolyRayCasting test so that both agree exactly
+  const double v = static_cast<double>(i);
+  std::vector<double> crossings;
+  crossings.reserve(_corners.size());
+  for (size_t k = 0, l = _corners.size() - 1; k < _corners.size(); k++) {
+    if ((_corners[k].get_v() < v && _corners[l].get_v() >= v) || (_corners[l].get_v() < v && _corners[k].get_v() >= v)) {
+      crossings.push_back(v * m_PnPolyMultiples[k] + m_PnPolyConstants[k]);
+    }
+
+    l = k;
+  }
+  std::sort(crossings.begin(), crossings.end());
+
+  // Pixel j is inside when an odd number of crossings are strictly lower than j,
+  // that is when crossings[2n] < j <= crossings[2n+1]
+  const double bound = static_cast<double>(std::numeric_limits<int>::max() - 1);
+  for (size_t k = 0; k + 1 < crossings.size(); k += 2) {
+    int jmin = static_cast<int>(std::max(-bound, std::min(bound, std::floor(crossings[k])))) + 1;
+    int jmax = static_cast<int>(std::max(-bound, std::min(bound, std::floor(crossings[k + 1])))) + 1;
+    if (jmin < jmax) {
+      spans.push_back(std::make_pair(jmin, jmax));
+    }
+  }
+}
+
 void vpPolygon::precalcValuesPnPoly()
 {
   if (_corners.size() < 3) {
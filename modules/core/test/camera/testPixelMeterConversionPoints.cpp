@@ -0,0 +1,200 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the conversion of arrays of points between pixel and meter.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testPixelMeterConversionPoints.cpp
+
+  Test that the conversions of arrays of points between pixel and meter
+  coordinates give the results of the conversions of single points, for all
+  the projection models and SIMD levels.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpPixelMeterMap.h>
+
+namespace
+{
+std::vector<vpCameraParameters> getCameras()
+{
+  std::vector<vpCameraParameters> cameras(3);
+  cameras[0].initPersProjWithoutDistortion(600, 610, 320.5, 240.5);
+  cameras[1].initPersProjWithDistortion(600, 610, 320.5, 240.5, -0.12, 0.13);
+  std::vector<double> k(4);
+  k[0] = -0.02;
+  k[1] = 0.01;
+  k[2] = -0.004;
+  k[3] = 0.001;
+  cameras[2].initProjWithKannalaBrandtDistortion(300, 305, 320.5, 240.5, k);
+  return cameras;
+}
+
+// An odd number of points on a grid covering the image and beyond
+void getPixels(std::vector<double> &u, std::vector<double> &v)
+{
+  u.clear();
+  v.clear();
+  for (double i = -20.25; i < 500; i += 7.3) {
+    for (double j = -30.5; j < 680; j += 9.1) {
+      u.push_back(j);
+      v.push_back(i);
+    }
+  }
+  u.push_back(320.5);
+  v.push_back(240.5);
+}
+} // namespace
+
+TEST_CASE("Pixel to meter", "[vpPixelMeterConversion]")
+{
+  std::vector<double> u, v;
+  getPixels(u, v);
+  const unsigned int n = static_cast<unsigned int>(u.size());
+  const std::vector<vpCameraParameters> cameras = getCameras();
+  const vpCPUFeatures::vpSimdLevel level = vpCPUFeatures::getSimdLevel();
+
+  for (size_t c = 0; c < cameras.size(); c++) {
+    for (int l = vpCPUFeatures::SIMD_NONE; l <= level; l++) {
+      vpCPUFeatures::setSimdLevel(static_cast<vpCPUFeatures::vpSimdLevel>(l));
+      std::vector<double> x(n), y(n);
+      vpPixelMeterConversion::convertPoints(cameras[c], &u[0], &v[0], &x[0], &y[0], n);
+      for (unsigned int k = 0; k < n; k++) {
+        double xk = 0, yk = 0;
+        vpPixelMeterConversion::convertPoint(cameras[c], u[k], v[k], xk, yk);
+        CHECK(x[k] == Approx(xk).epsilon(1e-14).margin(1e-15));
+        CHECK(y[k] == Approx(yk).epsilon(1e-14).margin(1e-15));
+      }
+    }
+  }
+  vpCPUFeatures::setSimdLevel(level);
+
+  SECTION("In place")
+  {
+    std::vector<double> x(u), y(v), x_ref(u.size()), y_ref(v.size());
+    vpPixelMeterConversion::convertPoints(cameras[1], &u[0], &v[0], &x_ref[0], &y_ref[0], n);
+    vpPixelMeterConversion::convertPoints(cameras[1], &x[0], &y[0], &x[0], &y[0], n);
+    CHECK(x == x_ref);
+    CHECK(y == y_ref);
+  }
+}
+
+TEST_CASE("Meter to pixel", "[vpMeterPixelConversion]")
+{
+  std::vector<double> u, v;
+  getPixels(u, v);
+  const unsigned int n = static_cast<unsigned int>(u.size());
+  const std::vector<vpCameraParameters> cameras = getCameras();
+  const vpCPUFeatures::vpSimdLevel level = vpCPUFeatures::getSimdLevel();
+
+  for (size_t c = 0; c < cameras.size(); c++) {
+    std::vector<double> x(n), y(n);
+    vpPixelMeterConversion::convertPoints(cameras[c], &u[0], &v[0], &x[0], &y[0], n);
+    for (int l = vpCPUFeatures::SIMD_NONE; l <= level; l++) {
+      vpCPUFeatures::setSimdLevel(static_cast<vpCPUFeatures::vpSimdLevel>(l));
+      std::vector<double> u_proj(n), v_proj(n);
+      vpMeterPixelConversion::convertPoints(cameras[c], &x[0], &y[0], &u_proj[0], &v_proj[0], n);
+      for (unsigned int k = 0; k < n; k++) {
+        double uk = 0, vk = 0;
+        vpMeterPixelConversion::convertPoint(cameras[c], x[k], y[k], uk, vk);
+        CHECK(u_proj[k] == Approx(uk).epsilon(1e-14).margin(1e-10));
+        CHECK(v_proj[k] == Approx(vk).epsilon(1e-14).margin(1e-10));
+      }
+      // Round trip, except for the first model whose inverse distortion is approximated
+      if (c != 1) {
+        for (unsigned int k = 0; k < n; k++) {
+          CHECK(u_proj[k] == Approx(u[k]).epsilon(1e-14).margin(1e-6));
+          CHECK(v_proj[k] == Approx(v[k]).epsilon(1e-14).margin(1e-6));
+        }
+      }
+    }
+  }
+  vpCPUFeatures::setSimdLevel(level);
+}
+
+TEST_CASE("Look-up table", "[vpPixelMeterMap]")
+{
+  std::vector<double> u, v;
+  getPixels(u, v);
+  const unsigned int n = static_cast<unsigned int>(u.size());
+  const std::vector<vpCameraParameters> cameras = getCameras();
+
+  for (size_t c = 0; c < cameras.size(); c++) {
+    const vpPixelMeterMap map(cameras[c], 480, 640);
+    CHECK(map.getHeight() == 480);
+    CHECK(map.getWidth() == 640);
+
+    std::vector<double> x(n), y(n), u_proj(n), v_proj(n), u_ref(n), v_ref(n), x_ref(n), y_ref(n);
+    map.convertPoints(&u[0], &v[0], &x[0], &y[0], n);
+    vpMeterPixelConversion::convertPoints(cameras[c], &x[0], &y[0], &u_proj[0], &v_proj[0], n);
+    vpPixelMeterConversion::convertPoints(cameras[c], &u[0], &v[0], &x_ref[0], &y_ref[0], n);
+    vpMeterPixelConversion::convertPoints(cameras[c], &x_ref[0], &y_ref[0], &u_ref[0], &v_ref[0], n);
+    for (unsigned int k = 0; k < n; k++) {
+      // The interpolation error is less than 0.01 pixel
+      CHECK(u_proj[k] == Approx(u_ref[k]).margin(0.01));
+      CHECK(v_proj[k] == Approx(v_ref[k]).margin(0.01));
+    }
+
+    double xk = 0, yk = 0, xk_ref = 0, yk_ref = 0;
+    map.convertPoint(479, 639, xk, yk);
+    vpPixelMeterConversion::convertPoint(cameras[c], 639, 479, xk_ref, yk_ref);
+    CHECK(xk == Approx(xk_ref).epsilon(1e-14).margin(1e-15));
+    CHECK(yk == Approx(yk_ref).epsilon(1e-14).margin(1e-15));
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
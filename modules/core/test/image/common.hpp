@@ -620,6 +620,101 @@ void BGRaToRGBaRef(unsigned char *bgra, unsigned char *rgba, unsigned int width,
   }
 }
 
+unsigned char saturateRef(int c)
+{
+  if (c & (~255)) {
+    c = c < 0 ? 0 : 255;
+  }
+  return static_cast<unsigned char>(c);
+}
+
+void YUYVToRGBaRef(const unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height)
+{
+  for (unsigned int i = 0; i < height * width / 2; i++, yuyv += 4) {
+    int cb = ((yuyv[1] - 128) * 454) >> 8;
+    int cg = ((yuyv[1] - 128) * 88 + (yuyv[3] - 128) * 183) >> 8;
+    int cr = ((yuyv[3] - 128) * 359) >> 8;
+    for (int k = 0; k < 2; k++) {
+      int y = yuyv[2 * k];
+      *rgba++ = saturateRef(y + cr);
+      *rgba++ = saturateRef(y - cg);
+      *rgba++ = saturateRef(y + cb);
+      *rgba++ = vpRGBa::alpha_default;
+    }
+  }
+}
+
+void YUVToRGBaRef(int y, int u, int v, unsigned char *rgba)
+{
+  int U = (int)((u - 128) * 0.354);
+  int V = (int)((v - 128) * 0.707);
+  rgba[0] = saturateRef(y + 2 * V);
+  rgba[1] = saturateRef(y - U - V);
+  rgba[2] = saturateRef(y + 5 * U);
+  rgba[3] = vpRGBa::alpha_default;
+}
+
+void YUV422ToRGBaRef(const unsigned char *yuv, unsigned char *rgba, unsigned int size)
+{
+  for (unsigned int i = 0; i < size / 2; i++, yuv += 4, rgba += 8) {
+    YUVToRGBaRef(yuv[1], yuv[0], yuv[2], rgba);
+    YUVToRGBaRef(yuv[3], yuv[0], yuv[2], rgba + 4);
+  }
+}
+
+void YUV420ToRGBaRef(const unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
+{
+  const unsigned char *u = yuv + width * height;
+  const unsigned char *v = u + width * height / 4;
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      unsigned int c = (i / 2) * (width / 2) + j / 2;
+      YUVToRGBaRef(yuv[i * width + j], u[c], v[c], rgba + 4 * (i * width + j));
+    }
+  }
+}
+
+void MONO16ToGreyRef(const unsigned char *grey16, unsigned char *grey, unsigned int size)
+{
+  for (unsigned int i = 0; i < size; i++) {
+    grey[i] = static_cast<unsigned char>((grey16[2 * i + 1] + (grey16[2 * i] << 8)) >> 8);
+  }
+}
+
+// Color (0: red, 1: green, 2: blue) of a Bayer pixel; (rx, ry) is the position of the red pixel in the 2x2 pattern
+int bayerColorRef(int i, int j, int rx, int ry)
+{
+  bool redRow = (i % 2) == ry, redCol = (j % 2) == rx;
+  return redRow == redCol ? (redRow ? 0 : 2) : 1;
+}
+
+// Bilinear demosaicing: each missing color is the mean of the neighbors of that color, with mirrored borders
+void demosaicBilinearRef(const unsigned char *bayer, unsigned char *rgba, int width, int height, int rx, int ry)
+{
+  for (int i = 0; i < height; i++) {
+    for (int j = 0; j < width; j++) {
+      int own = bayerColorRef(i, j, rx, ry);
+      int sum[3] = {0, 0, 0}, count[3] = {0, 0, 0};
+      for (int di = -1; di <= 1; di++) {
+        for (int dj = -1; dj <= 1; dj++) {
+          int ii = i + di < 0 ? 1 : (i + di >= height ? height - 2 : i + di);
+          int jj = j + dj < 0 ? 1 : (j + dj >= width ? width - 2 : j + dj);
+          int color = bayerColorRef(ii, jj, rx, ry);
+          if (color != own) {
+            sum[color] += bayer[ii * width + jj];
+            count[color]++;
+          }
+        }
+      }
+      for (int c = 0; c < 3; c++) {
+        rgba[4 * (i * width + j) + c] = c == own ? bayer[i * width + j]
+                                                 : static_cast<unsigned char>((sum[c] + count[c] / 2) / count[c]);
+      }
+      rgba[4 * (i * width + j) + 3] = vpRGBa::alpha_default;
+    }
+  }
+}
+
 #if VISP_HAVE_OPENCV_VERSION >= 0x020101
 void fill(cv::Mat& img)
 {
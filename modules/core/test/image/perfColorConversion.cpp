@@ -286,6 +286,105 @@ TEST_CASE("Benchmark bgra to rgba (ViSP)", "[benchmark]") {
 }
 #endif
 
+// Camera stream formats, with the size of the color image
+TEST_CASE("Benchmark yuyv to rgba (naive code)", "[benchmark]") {
+  vpImage<vpRGBa> I;
+  vpImageIo::read(I, imagePathColor);
+  std::vector<unsigned char> yuyv(I.getSize() * 2, 128);
+
+  BENCHMARK("Benchmark yuyv to rgba (naive code)") {
+    common_tools::YUYVToRGBaRef(yuyv.data(), reinterpret_cast<unsigned char *>(I.bitmap), I.getWidth(),
+                                I.getHeight());
+    return I;
+  };
+}
+
+TEST_CASE("Benchmark yuyv to rgba (ViSP)", "[benchmark]") {
+  vpImage<vpRGBa> I;
+  vpImageIo::read(I, imagePathColor);
+  std::vector<unsigned char> yuyv(I.getSize() * 2, 128);
+
+  BENCHMARK("Benchmark yuyv to rgba (ViSP)") {
+    vpImageConvert::YUYVToRGBa(yuyv.data(), 2 * I.getWidth(), reinterpret_cast<unsigned char *>(I.bitmap),
+                               4 * I.getWidth(), I.getWidth(), I.getHeight(), nThreads);
+    return I;
+  };
+}
+
+TEST_CASE("Benchmark yuv420 to rgba (naive code)", "[benchmark]") {
+  vpImage<vpRGBa> I;
+  vpImageIo::read(I, imagePathColor);
+  std::vector<unsigned char> yuv(I.getSize() * 3 / 2, 128);
+
+  BENCHMARK("Benchmark yuv420 to rgba (naive code)") {
+    common_tools::YUV420ToRGBaRef(yuv.data(), reinterpret_cast<unsigned char *>(I.bitmap), I.getWidth(),
+                                  I.getHeight());
+    return I;
+  };
+}
+
+TEST_CASE("Benchmark yuv420 to rgba (ViSP)", "[benchmark]") {
+  vpImage<vpRGBa> I;
+  vpImageIo::read(I, imagePathColor);
+  std::vector<unsigned char> yuv(I.getSize() * 3 / 2, 128);
+  const unsigned int w = I.getWidth(), size = I.getSize();
+
+  BENCHMARK("Benchmark yuv420 to rgba (ViSP)") {
+    vpImageConvert::YUV420ToRGBa(yuv.data(), w, yuv.data() + size, (w + 1) / 2, yuv.data() + 5 * size / 4,
+                                 (w + 1) / 2, reinterpret_cast<unsigned char *>(I.bitmap), 4 * w, w, I.getHeight(),
+                                 nThreads);
+    return I;
+  };
+}
+
+TEST_CASE("Benchmark yuv422 to gray (ViSP)", "[benchmark]") {
+  vpImage<unsigned char> I;
+  vpImageIo::read(I, imagePathGray);
+  std::vector<unsigned char> yuv(I.getSize() * 2, 128);
+
+  BENCHMARK("Benchmark yuv422 to gray (ViSP)") {
+    vpImageConvert::YUV422ToGrey(yuv.data(), 2 * I.getWidth(), I.bitmap, I.getWidth(), I.getWidth(), I.getHeight(),
+                                 nThreads);
+    return I;
+  };
+}
+
+TEST_CASE("Benchmark mono16 to gray (naive code)", "[benchmark]") {
+  vpImage<unsigned char> I;
+  vpImageIo::read(I, imagePathGray);
+  std::vector<unsigned char> grey16(I.getSize() * 2, 128);
+
+  BENCHMARK("Benchmark mono16 to gray (naive code)") {
+    common_tools::MONO16ToGreyRef(grey16.data(), I.bitmap, I.getSize());
+    return I;
+  };
+}
+
+TEST_CASE("Benchmark mono16 to gray (ViSP)", "[benchmark]") {
+  vpImage<unsigned char> I;
+  vpImageIo::read(I, imagePathGray);
+  std::vector<unsigned char> grey16(I.getSize() * 2, 128);
+
+  BENCHMARK("Benchmark mono16 to gray (ViSP)") {
+    vpImageConvert::MONO16ToGrey(grey16.data(), 2 * I.getWidth(), I.bitmap, I.getWidth(), I.getWidth(),
+                                 I.getHeight(), nThreads);
+    return I;
+  };
+}
+
+TEST_CASE("Benchmark bayer to rgba (ViSP)", "[benchmark]") {
+  vpImage<unsigned char> I;
+  vpImageIo::read(I, imagePathGray);
+  vpImage<vpRGBa> I_color(I.getHeight(), I.getWidth());
+
+  BENCHMARK("Benchmark bayer to rgba (ViSP)") {
+    vpImageConvert::demosaicRGGBToRGBaBilinear(I.bitmap, I.getWidth(),
+                                               reinterpret_cast<unsigned char *>(I_color.bitmap),
+                                               4 * I.getWidth(), I.getWidth(), I.getHeight(), nThreads);
+    return I_color;
+  };
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session; // There must be exactly one instance
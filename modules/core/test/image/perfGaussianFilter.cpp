@@ -119,6 +119,82 @@ TEST_CASE("vpImageFilter::gaussianBlur", "[benchmark]") {
   }
 }
 
+TEST_CASE("vpImageFilter separable filters", "[benchmark]") {
+  vpImage<unsigned char> I;
+  vpImageIo::read(I, imagePath);
+
+  const unsigned int kernelSize = 7;
+  const double sigma = 5.0;
+
+  SECTION("gaussianBlur")
+  {
+    vpImage<float> I_blur_float;
+    BENCHMARK("Benchmark vpImageFilter::gaussianBlur uchar -> float") {
+      vpImageFilter::gaussianBlur(I, I_blur_float, kernelSize, sigma);
+      return I_blur_float;
+    };
+
+    vpImage<unsigned char> I_blur_uchar;
+    BENCHMARK("Benchmark vpImageFilter::gaussianBlur uchar -> uchar (fixed point)") {
+      vpImageFilter::gaussianBlur(I, I_blur_uchar, kernelSize, sigma);
+      return I_blur_uchar;
+    };
+  }
+
+  SECTION("Gaussian gradients")
+  {
+    double fg[(kernelSize + 1) / 2], fgd[(kernelSize + 1) / 2];
+    vpImageFilter::getGaussianKernel(fg, kernelSize);
+    vpImageFilter::getGaussianDerivativeKernel(fgd, kernelSize);
+
+    vpImage<double> dIx, dIy;
+    BENCHMARK("Benchmark vpImageFilter::getGradXGauss2D + getGradYGauss2D double") {
+      vpImageFilter::getGradXGauss2D(I, dIx, fg, fgd, kernelSize);
+      vpImageFilter::getGradYGauss2D(I, dIy, fg, fgd, kernelSize);
+      return dIy;
+    };
+
+    vpImage<float> dIx_float, dIy_float;
+    BENCHMARK("Benchmark vpImageFilter::getGradXGauss2D + getGradYGauss2D float") {
+      vpImageFilter::getGradXGauss2D(I, dIx_float, fg, fgd, kernelSize);
+      vpImageFilter::getGradYGauss2D(I, dIy_float, fg, fgd, kernelSize);
+      return dIy_float;
+    };
+
+    vpImage<double> GIx, GIy;
+    BENCHMARK("Benchmark per-pixel filterX/filterY + derivativeFilterX/Y double") {
+      vpImageFilter::filterY(I, GIy, fg, kernelSize);
+      vpImageFilter::filterX(I, GIx, fg, kernelSize);
+      for (unsigned int i = 0; i < I.getHeight(); i++) {
+        for (unsigned int j = (kernelSize - 1) / 2; j < I.getWidth() - (kernelSize - 1) / 2; j++) {
+          dIx[i][j] = vpImageFilter::derivativeFilterX(GIy, i, j, fgd, kernelSize);
+        }
+      }
+      for (unsigned int i = (kernelSize - 1) / 2; i < I.getHeight() - (kernelSize - 1) / 2; i++) {
+        for (unsigned int j = 0; j < I.getWidth(); j++) {
+          dIy[i][j] = vpImageFilter::derivativeFilterY(GIx, i, j, fgd, kernelSize);
+        }
+      }
+      return dIy;
+    };
+  }
+
+  SECTION("Sobel")
+  {
+    vpImage<short> dIx, dIy;
+    BENCHMARK("Benchmark vpImageFilter::sobel short (fixed point)") {
+      vpImageFilter::sobel(I, dIx, dIy);
+      return dIy;
+    };
+
+    vpImage<float> dIx_float, dIy_float;
+    BENCHMARK("Benchmark vpImageFilter::sobel float") {
+      vpImageFilter::sobel(I, dIx_float, dIy_float);
+      return dIy_float;
+    };
+  }
+}
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020101)
 TEST_CASE("Gaussian filter (OpenCV)", "[benchmark]") {
   SECTION("unsigned char")
@@ -144,6 +220,18 @@ TEST_CASE("Gaussian filter (OpenCV)", "[benchmark]") {
       return img_blur;
     };
   }
+
+  SECTION("Sobel")
+  {
+    cv::Mat img, img_dx, img_dy;
+    img = cv::imread(imagePath, cv::IMREAD_GRAYSCALE);
+
+    BENCHMARK("Benchmark Sobel filter short (OpenCV)") {
+      cv::Sobel(img, img_dx, CV_16S, 1, 0);
+      cv::Sobel(img, img_dy, CV_16S, 0, 1);
+      return img_dy;
+    };
+  }
 }
 #endif
 
@@ -42,6 +42,7 @@
 
 #include <visp3/core/vpIoTools.h>
 #include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpImageWarpMap.h>
 #include <visp3/io/vpImageIo.h>
 
 namespace {
@@ -84,6 +85,30 @@ TEST_CASE("Benchmark affine warp on grayscale image", "[benchmark]") {
     return I_affine;
   };
 
+  BENCHMARK("Benchmark affine warp (fixed-point, 1 thread) (NN)") {
+    vpImageTools::warpImage(I, M, I_affine, vpImageTools::INTERPOLATION_NEAREST, true, false, 1);
+    return I_affine;
+  };
+
+  BENCHMARK("Benchmark affine warp (fixed-point, 1 thread) (bilinear)") {
+    vpImageTools::warpImage(I, M, I_affine, vpImageTools::INTERPOLATION_LINEAR, true, false, 1);
+    return I_affine;
+  };
+
+  vpImageWarpMap map_NN(M, I.getHeight(), I.getWidth(), I_affine.getHeight(), I_affine.getWidth(),
+                        vpImageTools::INTERPOLATION_NEAREST);
+  BENCHMARK("Benchmark affine warp (precomputed map) (NN)") {
+    map_NN.warp(I, I_affine);
+    return I_affine;
+  };
+
+  vpImageWarpMap map_linear(M, I.getHeight(), I.getWidth(), I_affine.getHeight(), I_affine.getWidth(),
+                            vpImageTools::INTERPOLATION_LINEAR);
+  BENCHMARK("Benchmark affine warp (precomputed map) (bilinear)") {
+    map_linear.warp(I, I_affine);
+    return I_affine;
+  };
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
   cv::Mat img, img_affine;
   vpImageConvert::convert(I, img);
@@ -144,6 +169,30 @@ TEST_CASE("Benchmark affine warp on color image", "[benchmark]") {
     return I_affine;
   };
 
+  BENCHMARK("Benchmark affine warp (fixed-point, 1 thread) (NN)") {
+    vpImageTools::warpImage(I, M, I_affine, vpImageTools::INTERPOLATION_NEAREST, true, false, 1);
+    return I_affine;
+  };
+
+  BENCHMARK("Benchmark affine warp (fixed-point, 1 thread) (bilinear)") {
+    vpImageTools::warpImage(I, M, I_affine, vpImageTools::INTERPOLATION_LINEAR, true, false, 1);
+    return I_affine;
+  };
+
+  vpImageWarpMap map_NN(M, I.getHeight(), I.getWidth(), I_affine.getHeight(), I_affine.getWidth(),
+                        vpImageTools::INTERPOLATION_NEAREST);
+  BENCHMARK("Benchmark affine warp (precomputed map) (NN)") {
+    map_NN.warp(I, I_affine);
+    return I_affine;
+  };
+
+  vpImageWarpMap map_linear(M, I.getHeight(), I.getWidth(), I_affine.getHeight(), I_affine.getWidth(),
+                            vpImageTools::INTERPOLATION_LINEAR);
+  BENCHMARK("Benchmark affine warp (precomputed map) (bilinear)") {
+    map_linear.warp(I, I_affine);
+    return I_affine;
+  };
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
   cv::Mat img, img_affine;
   vpImageConvert::convert(I, img);
@@ -204,6 +253,30 @@ TEST_CASE("Benchmark perspective warp on grayscale image", "[benchmark]") {
     return I_perspective;
   };
 
+  BENCHMARK("Benchmark perspective warp (fixed-point, 1 thread) (NN)") {
+    vpImageTools::warpImage(I, M, I_perspective, vpImageTools::INTERPOLATION_NEAREST, true, false, 1);
+    return I_perspective;
+  };
+
+  BENCHMARK("Benchmark perspective warp (fixed-point, 1 thread) (bilinear)") {
+    vpImageTools::warpImage(I, M, I_perspective, vpImageTools::INTERPOLATION_LINEAR, true, false, 1);
+    return I_perspective;
+  };
+
+  vpImageWarpMap map_NN(M, I.getHeight(), I.getWidth(), I_perspective.getHeight(), I_perspective.getWidth(),
+                        vpImageTools::INTERPOLATION_NEAREST);
+  BENCHMARK("Benchmark perspective warp (precomputed map) (NN)") {
+    map_NN.warp(I, I_perspective);
+    return I_perspective;
+  };
+
+  vpImageWarpMap map_linear(M, I.getHeight(), I.getWidth(), I_perspective.getHeight(), I_perspective.getWidth(),
+                            vpImageTools::INTERPOLATION_LINEAR);
+  BENCHMARK("Benchmark perspective warp (precomputed map) (bilinear)") {
+    map_linear.warp(I, I_perspective);
+    return I_perspective;
+  };
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
   cv::Mat img, img_perspective;
   vpImageConvert::convert(I, img);
@@ -264,6 +337,30 @@ TEST_CASE("Benchmark perspective warp on color image", "[benchmark]") {
     return I_perspective;
   };
 
+  BENCHMARK("Benchmark perspective warp (fixed-point, 1 thread) (NN)") {
+    vpImageTools::warpImage(I, M, I_perspective, vpImageTools::INTERPOLATION_NEAREST, true, false, 1);
+    return I_perspective;
+  };
+
+  BENCHMARK("Benchmark perspective warp (fixed-point, 1 thread) (bilinear)") {
+    vpImageTools::warpImage(I, M, I_perspective, vpImageTools::INTERPOLATION_LINEAR, true, false, 1);
+    return I_perspective;
+  };
+
+  vpImageWarpMap map_NN(M, I.getHeight(), I.getWidth(), I_perspective.getHeight(), I_perspective.getWidth(),
+                        vpImageTools::INTERPOLATION_NEAREST);
+  BENCHMARK("Benchmark perspective warp (precomputed map) (NN)") {
+    map_NN.warp(I, I_perspective);
+    return I_perspective;
+  };
+
+  vpImageWarpMap map_linear(M, I.getHeight(), I.getWidth(), I_perspective.getHeight(), I_perspective.getWidth(),
+                            vpImageTools::INTERPOLATION_LINEAR);
+  BENCHMARK("Benchmark perspective warp (precomputed map) (bilinear)") {
+    map_linear.warp(I, I_perspective);
+    return I_perspective;
+  };
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
   cv::Mat img, img_perspective;
   vpImageConvert::convert(I, img);
@@ -44,7 +44,10 @@
 #if defined(VISP_HAVE_CATCH2)
 #define CATCH_CONFIG_RUNNER
 #include <catch.hpp>
+#include <string.h>
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpUniRand.h>
 #include "common.hpp"
 
 static const double maxMeanPixelError = 1.0;
@@ -174,6 +177,306 @@ TEST_CASE("Split <==> Merge conversion", "[image_conversion]") {
   CHECK((rgba == rgba_ref));
 }
 
+namespace
+{
+void fillRandom(std::vector<unsigned char> &buffer)
+{
+  vpUniRand rng;
+  for (size_t i = 0; i < buffer.size(); i++) {
+    buffer[i] = static_cast<unsigned char>(rng.next() & 0xFF);
+  }
+}
+
+// Copy rows of rowSize bytes in a buffer whose rows have stride bytes
+std::vector<unsigned char> padRows(const unsigned char *src, unsigned int rowSize, unsigned int rows,
+                                   unsigned int stride)
+{
+  std::vector<unsigned char> dst(rows * stride, 0);
+  for (unsigned int i = 0; i < rows; i++) {
+    std::copy(src + i * rowSize, src + (i + 1) * rowSize, dst.begin() + i * stride);
+  }
+  return dst;
+}
+
+// Check the first width pixels of each row of an image wider than the reference
+bool equalRows(const vpImage<vpRGBa> &I, const vpImage<vpRGBa> &I_ref)
+{
+  for (unsigned int i = 0; i < I_ref.getHeight(); i++) {
+    if (memcmp(I[i], I_ref[i], I_ref.getWidth() * sizeof(vpRGBa)) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The SIMD levels to test: scalar code and the current level
+std::vector<vpCPUFeatures::vpSimdLevel> simdLevels()
+{
+  std::vector<vpCPUFeatures::vpSimdLevel> levels;
+  levels.push_back(vpCPUFeatures::SIMD_NONE);
+  if (vpCPUFeatures::getSimdLevel() != vpCPUFeatures::SIMD_NONE) {
+    levels.push_back(vpCPUFeatures::getSimdLevel());
+  }
+  return levels;
+}
+
+const unsigned int yuvWidth = 222;
+} // namespace
+
+TEST_CASE("YUYV to RGBa, RGB and Gray conversion", "[image_conversion]") {
+  std::vector<unsigned char> yuyv(yuvWidth * height * 2);
+  fillRandom(yuyv);
+
+  vpImage<vpRGBa> rgba_ref(height, yuvWidth);
+  common_tools::YUYVToRGBaRef(yuyv.data(), reinterpret_cast<unsigned char *>(rgba_ref.bitmap), yuvWidth, height);
+  std::vector<unsigned char> rgb_ref(yuvWidth * height * 3);
+  vpImageConvert::RGBaToRGB(reinterpret_cast<unsigned char *>(rgba_ref.bitmap), rgb_ref.data(), rgba_ref.getSize());
+  std::vector<unsigned char> gray_ref(yuvWidth * height);
+  for (size_t i = 0; i < gray_ref.size(); i++) {
+    gray_ref[i] = yuyv[2 * i];
+  }
+
+  const vpCPUFeatures::vpSimdLevel level = vpCPUFeatures::getSimdLevel();
+  const std::vector<vpCPUFeatures::vpSimdLevel> levels = simdLevels();
+  for (size_t l = 0; l < levels.size(); l++) {
+    vpCPUFeatures::setSimdLevel(levels[l]);
+
+    vpImage<vpRGBa> rgba(height, yuvWidth);
+    vpImageConvert::YUYVToRGBa(yuyv.data(), reinterpret_cast<unsigned char *>(rgba.bitmap), yuvWidth, height);
+    CHECK((rgba == rgba_ref));
+
+    // Padded source and destination rows, several threads
+    const unsigned int stride = 2 * yuvWidth + 10;
+    std::vector<unsigned char> yuyv_padded = padRows(yuyv.data(), 2 * yuvWidth, height, stride);
+    vpImage<vpRGBa> rgba_padded(height, yuvWidth + 3);
+    vpImageConvert::YUYVToRGBa(yuyv_padded.data(), stride, reinterpret_cast<unsigned char *>(rgba_padded.bitmap),
+                               4 * rgba_padded.getWidth(), yuvWidth, height, 2);
+    CHECK(equalRows(rgba_padded, rgba_ref));
+
+    std::vector<unsigned char> rgb(yuvWidth * height * 3);
+    vpImageConvert::YUYVToRGB(yuyv.data(), rgb.data(), yuvWidth, height);
+    CHECK((rgb == rgb_ref));
+    vpImageConvert::YUYVToRGB(yuyv_padded.data(), stride, rgb.data(), 3 * yuvWidth, yuvWidth, height);
+    CHECK((rgb == rgb_ref));
+
+    std::vector<unsigned char> gray(yuvWidth * height);
+    vpImageConvert::YUYVToGrey(yuyv.data(), gray.data(), yuvWidth * height);
+    CHECK((gray == gray_ref));
+    vpImageConvert::YUYVToGrey(yuyv_padded.data(), stride, gray.data(), yuvWidth, yuvWidth, height);
+    CHECK((gray == gray_ref));
+  }
+  vpCPUFeatures::setSimdLevel(level);
+}
+
+TEST_CASE("YUYV of odd width to RGBa and RGB conversion", "[image_conversion]") {
+  // Rows of 2 * width bytes: the last pixel is stored as (y u) and uses the v of the previous macro-pixel
+  const unsigned int oddWidth = yuvWidth + 1;
+  std::vector<unsigned char> yuyv(oddWidth * height * 2);
+  fillRandom(yuyv);
+
+  vpImage<vpRGBa> rgba_ref(height, oddWidth);
+  for (unsigned int i = 0; i < height; i++) {
+    const unsigned char *s = &yuyv[2 * i * oddWidth];
+    common_tools::YUYVToRGBaRef(s, reinterpret_cast<unsigned char *>(rgba_ref[i]), oddWidth - 1, 1);
+    const unsigned char last[4] = {s[2 * oddWidth - 2], s[2 * oddWidth - 1], s[2 * oddWidth - 2],
+                                   s[2 * oddWidth - 3]};
+    unsigned char rgba_last[8];
+    common_tools::YUYVToRGBaRef(last, rgba_last, 2, 1);
+    rgba_ref[i][oddWidth - 1] = vpRGBa(rgba_last[0], rgba_last[1], rgba_last[2], rgba_last[3]);
+  }
+  std::vector<unsigned char> rgb_ref(oddWidth * height * 3);
+  vpImageConvert::RGBaToRGB(reinterpret_cast<unsigned char *>(rgba_ref.bitmap), rgb_ref.data(), rgba_ref.getSize());
+
+  const vpCPUFeatures::vpSimdLevel level = vpCPUFeatures::getSimdLevel();
+  const std::vector<vpCPUFeatures::vpSimdLevel> levels = simdLevels();
+  for (size_t l = 0; l < levels.size(); l++) {
+    vpCPUFeatures::setSimdLevel(levels[l]);
+
+    vpImage<vpRGBa> rgba(height, oddWidth);
+    vpImageConvert::YUYVToRGBa(yuyv.data(), reinterpret_cast<unsigned char *>(rgba.bitmap), oddWidth, height);
+    CHECK((rgba == rgba_ref));
+
+    std::vector<unsigned char> rgb(oddWidth * height * 3);
+    vpImageConvert::YUYVToRGB(yuyv.data(), rgb.data(), oddWidth, height);
+    CHECK((rgb == rgb_ref));
+  }
+  vpCPUFeatures::setSimdLevel(level);
+}
+
+TEST_CASE("YUV422 to RGBa, RGB and Gray conversion", "[image_conversion]") {
+  std::vector<unsigned char> yuv(yuvWidth * height * 2);
+  fillRandom(yuv);
+
+  vpImage<vpRGBa> rgba_ref(height, yuvWidth);
+  common_tools::YUV422ToRGBaRef(yuv.data(), reinterpret_cast<unsigned char *>(rgba_ref.bitmap), rgba_ref.getSize());
+  std::vector<unsigned char> rgb_ref(yuvWidth * height * 3);
+  vpImageConvert::RGBaToRGB(reinterpret_cast<unsigned char *>(rgba_ref.bitmap), rgb_ref.data(), rgba_ref.getSize());
+  std::vector<unsigned char> gray_ref(yuvWidth * height);
+  for (size_t i = 0; i < gray_ref.size(); i++) {
+    gray_ref[i] = yuv[2 * i + 1];
+  }
+
+  const vpCPUFeatures::vpSimdLevel level = vpCPUFeatures::getSimdLevel();
+  const std::vector<vpCPUFeatures::vpSimdLevel> levels = simdLevels();
+  for (size_t l = 0; l < levels.size(); l++) {
+    vpCPUFeatures::setSimdLevel(levels[l]);
+
+    vpImage<vpRGBa> rgba(height, yuvWidth);
+    vpImageConvert::YUV422ToRGBa(yuv.data(), reinterpret_cast<unsigned char *>(rgba.bitmap), rgba.getSize());
+    CHECK((rgba == rgba_ref));
+
+    const unsigned int stride = 2 * yuvWidth + 6;
+    std::vector<unsigned char> yuv_padded = padRows(yuv.data(), 2 * yuvWidth, height, stride);
+    vpImage<vpRGBa> rgba_padded(height, yuvWidth + 1);
+    vpImageConvert::YUV422ToRGBa(yuv_padded.data(), stride, reinterpret_cast<unsigned char *>(rgba_padded.bitmap),
+                                 4 * rgba_padded.getWidth(), yuvWidth, height, 2);
+    CHECK(equalRows(rgba_padded, rgba_ref));
+
+    std::vector<unsigned char> rgb(yuvWidth * height * 3);
+    vpImageConvert::YUV422ToRGB(yuv.data(), rgb.data(), yuvWidth * height);
+    CHECK((rgb == rgb_ref));
+    vpImageConvert::YUV422ToRGB(yuv_padded.data(), stride, rgb.data(), 3 * yuvWidth, yuvWidth, height);
+    CHECK((rgb == rgb_ref));
+
+    std::vector<unsigned char> gray(yuvWidth * height);
+    vpImageConvert::YUV422ToGrey(yuv.data(), gray.data(), yuvWidth * height);
+    CHECK((gray == gray_ref));
+    vpImageConvert::YUV422ToGrey(yuv_padded.data(), stride, gray.data(), yuvWidth, yuvWidth, height);
+    CHECK((gray == gray_ref));
+  }
+  vpCPUFeatures::setSimdLevel(level);
+}
+
+TEST_CASE("YUV420 and YV12 to RGBa and RGB conversion", "[image_conversion]") {
+  const unsigned int h = 150;
+  const unsigned int size = yuvWidth * h;
+  std::vector<unsigned char> yuv(size * 3 / 2);
+  fillRandom(yuv);
+
+  vpImage<vpRGBa> rgba_ref(h, yuvWidth);
+  common_tools::YUV420ToRGBaRef(yuv.data(), reinterpret_cast<unsigned char *>(rgba_ref.bitmap), yuvWidth, h);
+  std::vector<unsigned char> rgb_ref(size * 3);
+  vpImageConvert::RGBaToRGB(reinterpret_cast<unsigned char *>(rgba_ref.bitmap), rgb_ref.data(), size);
+
+  // Same image in YV12: the chroma planes are swapped
+  std::vector<unsigned char> yv12(yuv);
+  std::copy(yuv.begin() + size, yuv.begin() + 5 * size / 4, yv12.begin() + 5 * size / 4);
+  std::copy(yuv.begin() + 5 * size / 4, yuv.end(), yv12.begin() + size);
+
+  const vpCPUFeatures::vpSimdLevel level = vpCPUFeatures::getSimdLevel();
+  const std::vector<vpCPUFeatures::vpSimdLevel> levels = simdLevels();
+  for (size_t l = 0; l < levels.size(); l++) {
+    vpCPUFeatures::setSimdLevel(levels[l]);
+
+    vpImage<vpRGBa> rgba(h, yuvWidth);
+    vpImageConvert::YUV420ToRGBa(yuv.data(), reinterpret_cast<unsigned char *>(rgba.bitmap), yuvWidth, h);
+    CHECK((rgba == rgba_ref));
+    vpImageConvert::YV12ToRGBa(yv12.data(), reinterpret_cast<unsigned char *>(rgba.bitmap), yuvWidth, h);
+    CHECK((rgba == rgba_ref));
+
+    std::vector<unsigned char> rgb(size * 3);
+    vpImageConvert::YUV420ToRGB(yuv.data(), rgb.data(), yuvWidth, h);
+    CHECK((rgb == rgb_ref));
+    // The height is given before the width
+    vpImageConvert::YV12ToRGB(yv12.data(), rgb.data(), h, yuvWidth);
+    CHECK((rgb == rgb_ref));
+
+    // Separate planes with padded rows
+    std::vector<unsigned char> y_plane = padRows(yuv.data(), yuvWidth, h, yuvWidth + 18);
+    std::vector<unsigned char> u_plane = padRows(yuv.data() + size, yuvWidth / 2, h / 2, yuvWidth / 2 + 5);
+    std::vector<unsigned char> v_plane = padRows(yuv.data() + 5 * size / 4, yuvWidth / 2, h / 2, yuvWidth / 2 + 7);
+    vpImage<vpRGBa> rgba_padded(h, yuvWidth + 2);
+    vpImageConvert::YUV420ToRGBa(y_plane.data(), yuvWidth + 18, u_plane.data(), yuvWidth / 2 + 5, v_plane.data(),
+                                 yuvWidth / 2 + 7, reinterpret_cast<unsigned char *>(rgba_padded.bitmap),
+                                 4 * rgba_padded.getWidth(), yuvWidth, h, 2);
+    CHECK(equalRows(rgba_padded, rgba_ref));
+    vpImageConvert::YUV420ToRGB(y_plane.data(), yuvWidth + 18, u_plane.data(), yuvWidth / 2 + 5, v_plane.data(),
+                                yuvWidth / 2 + 7, rgb.data(), 3 * yuvWidth, yuvWidth, h);
+    CHECK((rgb == rgb_ref));
+  }
+  vpCPUFeatures::setSimdLevel(level);
+}
+
+TEST_CASE("MONO16 to Gray and RGBa conversion", "[image_conversion]") {
+  std::vector<unsigned char> grey16(width * height * 2);
+  fillRandom(grey16);
+
+  vpImage<unsigned char> gray_ref(height, width);
+  common_tools::MONO16ToGreyRef(grey16.data(), gray_ref.bitmap, gray_ref.getSize());
+  vpImage<vpRGBa> rgba_ref;
+  vpImageConvert::convert(gray_ref, rgba_ref);
+
+  const vpCPUFeatures::vpSimdLevel level = vpCPUFeatures::getSimdLevel();
+  const std::vector<vpCPUFeatures::vpSimdLevel> levels = simdLevels();
+  for (size_t l = 0; l < levels.size(); l++) {
+    vpCPUFeatures::setSimdLevel(levels[l]);
+
+    vpImage<unsigned char> gray(height, width);
+    vpImageConvert::MONO16ToGrey(grey16.data(), gray.bitmap, gray.getSize());
+    CHECK((gray == gray_ref));
+    vpImageConvert::MONO16ToGrey(grey16.data(), 2 * width, gray.bitmap, width, width, height);
+    CHECK((gray == gray_ref));
+
+    vpImage<vpRGBa> rgba(height, width);
+    vpImageConvert::MONO16ToRGBa(grey16.data(), reinterpret_cast<unsigned char *>(rgba.bitmap), rgba.getSize());
+    CHECK((rgba == rgba_ref));
+    vpImageConvert::MONO16ToRGBa(grey16.data(), 2 * width, reinterpret_cast<unsigned char *>(rgba.bitmap),
+                                 4 * width, width, height, 2);
+    CHECK((rgba == rgba_ref));
+
+    // In place conversion
+    std::vector<unsigned char> buffer(grey16);
+    vpImageConvert::MONO16ToGrey(buffer.data(), 2 * width, buffer.data(), width, width, height);
+    CHECK(std::equal(gray_ref.bitmap, gray_ref.bitmap + gray_ref.getSize(), buffer.begin()));
+  }
+  vpCPUFeatures::setSimdLevel(level);
+}
+
+TEST_CASE("Bayer demosaicing", "[image_conversion]") {
+  std::vector<unsigned char> bayer(width * height);
+  fillRandom(bayer);
+  const unsigned int stride = width + 9;
+  std::vector<unsigned char> bayer_padded = padRows(bayer.data(), width, height, stride);
+
+  // Position of the red pixel in the 2x2 pattern of BGGR, GBRG, GRBG and RGGB
+  const int rx[4] = {1, 0, 1, 0}, ry[4] = {1, 1, 0, 0};
+  for (int p = 0; p < 4; p++) {
+    vpImage<vpRGBa> rgba_ref(height, width);
+    common_tools::demosaicBilinearRef(bayer.data(), reinterpret_cast<unsigned char *>(rgba_ref.bitmap), width,
+                                      height, rx[p], ry[p]);
+
+    vpImage<vpRGBa> rgba(height, width);
+    unsigned char *dst = reinterpret_cast<unsigned char *>(rgba.bitmap);
+    switch (p) {
+    case 0:
+      vpImageConvert::demosaicBGGRToRGBaBilinear(bayer_padded.data(), stride, dst, 4 * width, width, height);
+      break;
+    case 1:
+      vpImageConvert::demosaicGBRGToRGBaBilinear(bayer_padded.data(), stride, dst, 4 * width, width, height);
+      break;
+    case 2:
+      vpImageConvert::demosaicGRBGToRGBaBilinear(bayer_padded.data(), stride, dst, 4 * width, width, height);
+      break;
+    default:
+      vpImageConvert::demosaicRGGBToRGBaBilinear(bayer_padded.data(), stride, dst, 4 * width, width, height, 1);
+      break;
+    }
+    CHECK((rgba == rgba_ref));
+  }
+
+  // A constant image stays constant
+  std::vector<unsigned char> flat(16 * 9, 100);
+  vpImage<vpRGBa> rgba(9, 16);
+  vpImageConvert::demosaicRGGBToRGBaBilinear(flat.data(), 16, reinterpret_cast<unsigned char *>(rgba.bitmap), 4 * 16,
+                                             16, 9);
+  CHECK((rgba == vpImage<vpRGBa>(9, 16, vpRGBa(100, 100, 100, vpRGBa::alpha_default))));
+
+  CHECK_THROWS_AS(vpImageConvert::demosaicRGGBToRGBaBilinear(flat.data(), 16,
+                                                             reinterpret_cast<unsigned char *>(rgba.bitmap), 4 * 16,
+                                                             16, 1),
+                  vpException);
+}
+
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
 TEST_CASE("OpenCV Mat <==> vpImage conversion", "[image_conversion]") {
 
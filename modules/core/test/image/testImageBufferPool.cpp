@@ -0,0 +1,151 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpImageBufferPool.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageBufferPool.cpp
+
+  Test that the vpImage bitmaps are aligned and that the buffer pool reuses
+  the released bitmaps.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageBufferPool.h>
+
+namespace
+{
+template <class Type> bool isAligned(const vpImage<Type> &I)
+{
+  return reinterpret_cast<size_t>(I.bitmap) % vpImageBufferPool::getAlignment() == 0;
+}
+} // namespace
+
+TEST_CASE("Bitmap alignment", "[vpImageBufferPool]")
+{
+  const unsigned int sizes[] = {1, 3, 17, 63, 480};
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    vpImage<unsigned char> I(sizes[i], sizes[i] + 1);
+    vpImage<vpRGBa> Irgba(sizes[i], sizes[i] + 1);
+    vpImage<double> Id(sizes[i], sizes[i] + 1);
+    CHECK(isAligned(I));
+    CHECK(isAligned(Irgba));
+    CHECK(isAligned(Id));
+
+    I.resize(sizes[i] + 2, sizes[i]);
+    CHECK(isAligned(I));
+
+    vpImage<vpRGBa> Icopy(Irgba);
+    CHECK(isAligned(Icopy));
+  }
+}
+
+TEST_CASE("Pixels construction", "[vpImageBufferPool]")
+{
+  vpImageBufferPool::setEnabled(true);
+  {
+    vpImage<vpRGBa> I(20, 30, vpRGBa(1, 2, 3, 4));
+  }
+  vpImage<vpRGBa> I;
+  I.resize(20, 30);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    CHECK(I.bitmap[i].R == 0);
+    CHECK(I.bitmap[i].G == 0);
+    CHECK(I.bitmap[i].B == 0);
+    CHECK(I.bitmap[i].A == vpRGBa::alpha_default);
+  }
+  vpImageBufferPool::setEnabled(false);
+}
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+TEST_CASE("Buffer reuse", "[vpImageBufferPool]")
+{
+  vpImageBufferPool::setEnabled(true);
+  vpImageBufferPool::resetCounters();
+
+  const int nbIterations = 10;
+  for (int i = 0; i < nbIterations; i++) {
+    vpImage<unsigned char> I(480, 640, 128);
+    vpImage<unsigned char> I_half(240, 320);
+  }
+  // Only the first iteration allocates
+  CHECK(vpImageBufferPool::getNbMisses() == 2);
+  CHECK(vpImageBufferPool::getNbHits() == 2 * (nbIterations - 1));
+  CHECK(vpImageBufferPool::getCachedBytes() == 480 * 640 + 240 * 320);
+
+  SECTION("Maximal cached size")
+  {
+    vpImageBufferPool::clear();
+    vpImageBufferPool::setMaxCachedBytes(1000);
+    {
+      vpImage<unsigned char> I(480, 640);
+    }
+    CHECK(vpImageBufferPool::getCachedBytes() == 0);
+    vpImageBufferPool::setMaxCachedBytes(256 * 1024 * 1024);
+  }
+
+  vpImageBufferPool::setEnabled(false);
+  CHECK(vpImageBufferPool::getCachedBytes() == 0);
+
+  vpImageBufferPool::resetCounters();
+  {
+    vpImage<unsigned char> I(480, 640);
+  }
+  CHECK(vpImageBufferPool::getNbHits() == 0);
+  CHECK(vpImageBufferPool::getNbMisses() == 0);
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
@@ -0,0 +1,220 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the Canny edge detector of vpImageFilter.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageFilterCanny.cpp
+
+  Test the native Canny edge detector of vpImageFilter on synthetic images,
+  and compare it to the OpenCV one when available.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageFilter.h>
+
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#include <opencv2/imgproc/imgproc.hpp>
+#endif
+
+namespace
+{
+// Dark image with a bright rectangle [top, bottom) x [left, right)
+vpImage<unsigned char> createRectangle(unsigned int height, unsigned int width, unsigned int top, unsigned int left,
+                                       unsigned int bottom, unsigned int right, unsigned char value)
+{
+  vpImage<unsigned char> I(height, width, 20);
+  for (unsigned int i = top; i < bottom; i++) {
+    for (unsigned int j = left; j < right; j++) {
+      I[i][j] = value;
+    }
+  }
+  return I;
+}
+
+bool isEqual(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2)
+{
+  return I1.getHeight() == I2.getHeight() && I1.getWidth() == I2.getWidth() &&
+         std::equal(I1.bitmap, I1.bitmap + I1.getSize(), I2.bitmap);
+}
+
+unsigned int countEdges(const vpImage<unsigned char> &Ic)
+{
+  unsigned int nbEdges = 0;
+  for (unsigned int i = 0; i < Ic.getSize(); i++) {
+    nbEdges += Ic.bitmap[i] == 255 ? 1 : 0;
+  }
+  return nbEdges;
+}
+} // namespace
+
+TEST_CASE("Rectangle edges", "[vpImageFilter]")
+{
+  const vpImage<unsigned char> I = createRectangle(120, 160, 30, 40, 90, 120, 220);
+  vpImage<unsigned char> Ic;
+  vpImageFilter::canny(I, Ic, 5, 50, 3);
+
+  REQUIRE(Ic.getHeight() == I.getHeight());
+  REQUIRE(Ic.getWidth() == I.getWidth());
+
+  // Edges are thin and close to the rectangle border
+  unsigned int nbEdges = 0;
+  for (unsigned int i = 0; i < Ic.getHeight(); i++) {
+    for (unsigned int j = 0; j < Ic.getWidth(); j++) {
+      if (Ic[i][j] == 255) {
+        nbEdges++;
+        const unsigned int distRow = (std::min)(vpMath::abs(static_cast<int>(i) - 30), vpMath::abs(static_cast<int>(i) - 89));
+        const unsigned int distCol = (std::min)(vpMath::abs(static_cast<int>(j) - 40), vpMath::abs(static_cast<int>(j) - 119));
+        CHECK((std::min)(distRow, distCol) <= 1);
+      } else {
+        CHECK(Ic[i][j] == 0);
+      }
+    }
+  }
+  const unsigned int perimeter = 2 * (60 + 80);
+  CHECK(nbEdges >= perimeter - 8);
+  CHECK(nbEdges <= perimeter + 8);
+
+  SECTION("Thresholds")
+  {
+    vpImageFilter::canny(I, Ic, 5, 5000, 3);
+    CHECK(countEdges(Ic) == 0);
+  }
+
+  SECTION("In place and threads")
+  {
+    vpImage<unsigned char> Ic_1, Ic_inplace(I);
+    vpImageFilter::canny(I, Ic_1, 5, 50, 50, 3, 1);
+    vpImageFilter::canny(Ic_inplace, Ic_inplace, 5, 50, 50, 3, 4);
+    CHECK(isEqual(Ic_1, Ic));
+    CHECK(isEqual(Ic_inplace, Ic));
+  }
+
+  SECTION("Sobel apertures")
+  {
+    for (unsigned int aperture = 5; aperture <= 7; aperture += 2) {
+      vpImageFilter::canny(I, Ic, 5, 50 * aperture * aperture, 3 * 50 * aperture * aperture, aperture);
+      CHECK(countEdges(Ic) >= perimeter - 8);
+      CHECK(countEdges(Ic) <= perimeter + 8);
+    }
+    CHECK_THROWS_AS(vpImageFilter::canny(I, Ic, 5, 50, 4), vpImageException);
+  }
+}
+
+TEST_CASE("Hysteresis", "[vpImageFilter]")
+{
+  // Vertical step whose contrast drops from 150 to 40 along the edge
+  vpImage<unsigned char> I(100, 100, 50);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 50; j < I.getWidth(); j++) {
+      I[i][j] = static_cast<unsigned char>(200 - (110 * i) / (I.getHeight() - 1));
+    }
+  }
+  // Weak isolated step
+  for (unsigned int i = 70; i < 90; i++) {
+    for (unsigned int j = 10; j < 30; j++) {
+      I[i][j] = 90;
+    }
+  }
+
+  vpImage<unsigned char> Ic;
+  vpImageFilter::canny(I, Ic, 3, 100, 400, 3);
+  // The weak part of the step is connected to its strong part, the weak square is not
+  unsigned int nbStepEdges = 0, nbIsolatedEdges = 0;
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 45; j < 55; j++) {
+      nbStepEdges += Ic[i][j] == 255 ? 1 : 0;
+    }
+    for (unsigned int j = 0; j < 40; j++) {
+      nbIsolatedEdges += Ic[i][j] == 255 ? 1 : 0;
+    }
+  }
+  CHECK(nbStepEdges >= 95);
+  CHECK(nbIsolatedEdges == 0);
+
+  vpImageFilter::canny(I, Ic, 3, 100, 100, 3);
+  CHECK(countEdges(Ic) > nbStepEdges);
+}
+
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+TEST_CASE("Comparison with OpenCV", "[vpImageFilter]")
+{
+  vpImage<unsigned char> I(120, 160);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = static_cast<unsigned char>(127 + 100 * std::sin(i / 6.0) * std::cos(j / 9.0));
+    }
+  }
+
+  vpImage<unsigned char> Ic;
+  vpImageFilter::canny(I, Ic, 3, 80, 160, 3);
+
+  cv::Mat img, img_blur, edges;
+  vpImageConvert::convert(I, img);
+  cv::GaussianBlur(img, img_blur, cv::Size(3, 3), 0, 0);
+  cv::Canny(img_blur, edges, 80, 160, 3);
+  vpImage<unsigned char> Ic_cv;
+  vpImageConvert::convert(edges, Ic_cv);
+
+  unsigned int nbDiff = 0;
+  for (unsigned int i = 0; i < Ic.getSize(); i++) {
+    nbDiff += Ic.bitmap[i] != Ic_cv.bitmap[i] ? 1 : 0;
+  }
+  // The blur rounding may move a few edges
+  CHECK(nbDiff <= countEdges(Ic_cv) / 20);
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
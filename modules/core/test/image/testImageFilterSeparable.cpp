@@ -0,0 +1,316 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the separable filters of vpImageFilter.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageFilterSeparable.cpp
+
+  Test that the separable filters of vpImageFilter give the same results as
+  the per-pixel filters, for the double, float and fixed-point outputs.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+vpImage<unsigned char> createImage(unsigned int height, unsigned int width)
+{
+  vpUniRand rng(42);
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      // Smooth pattern with noise, to get large and small gradients
+      I[i][j] = static_cast<unsigned char>(vpMath::saturate<unsigned char>(
+          static_cast<int>(127 + 100 * std::sin(i / 7.0) * std::cos(j / 11.0) + rng.uniform(-20, 20))));
+    }
+  }
+  return I;
+}
+
+template <class Type1, class Type2> double maxDifference(const vpImage<Type1> &I1, const vpImage<Type2> &I2)
+{
+  REQUIRE(I1.getHeight() == I2.getHeight());
+  REQUIRE(I1.getWidth() == I2.getWidth());
+  double maxDiff = 0;
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    maxDiff = (std::max)(maxDiff, std::fabs(static_cast<double>(I1.bitmap[i]) - static_cast<double>(I2.bitmap[i])));
+  }
+  return maxDiff;
+}
+} // namespace
+
+TEST_CASE("Gaussian blur", "[vpImageFilter]")
+{
+  vpImage<unsigned char> I = createImage(131, 157);
+  const unsigned int size = 7;
+  const double sigma = 2.0;
+
+  vpImage<double> GI;
+  vpImageFilter::gaussianBlur(I, GI, size, sigma);
+
+  SECTION("Per-pixel filters")
+  {
+    double fg[(size + 1) / 2];
+    vpImageFilter::getGaussianKernel(fg, size, sigma);
+    vpImage<double> GIx, GI_ref;
+    vpImageFilter::filterX(I, GIx, fg, size);
+    vpImageFilter::filterY(GIx, GI_ref, fg, size);
+    CHECK(maxDifference(GI, GI_ref) < 1e-9);
+
+    vpImage<double> GI_double;
+    vpImageFilter::gaussianBlur(GIx, GI_double, size, sigma);
+    vpImageFilter::filterX(GIx, GI_ref, fg, size);
+    vpImageFilter::filterY(GI_ref, GIx, fg, size);
+    CHECK(maxDifference(GI_double, GIx) < 1e-9);
+  }
+
+  SECTION("Float")
+  {
+    vpImage<float> GI_float;
+    vpImageFilter::gaussianBlur(I, GI_float, size, sigma);
+    CHECK(maxDifference(GI, GI_float) < 1e-3);
+  }
+
+  SECTION("Fixed point")
+  {
+    vpImage<unsigned char> GI_uchar;
+    vpImageFilter::gaussianBlur(I, GI_uchar, size, sigma);
+    CHECK(maxDifference(GI, GI_uchar) <= 2.0);
+  }
+
+  SECTION("Threads")
+  {
+    vpImage<float> GI_1, GI_4;
+    vpImageFilter::gaussianBlur(I, GI_1, size, sigma, true, 1);
+    vpImageFilter::gaussianBlur(I, GI_4, size, sigma, true, 4);
+    CHECK(maxDifference(GI_1, GI_4) == 0.0);
+  }
+}
+
+TEST_CASE("Gradients", "[vpImageFilter]")
+{
+  vpImage<unsigned char> I = createImage(97, 123);
+  const unsigned int size = 5;
+  double fg[(size + 1) / 2], fgd[(size + 1) / 2];
+  vpImageFilter::getGaussianKernel(fg, size);
+  vpImageFilter::getGaussianDerivativeKernel(fgd, size);
+  const unsigned int half = (size - 1) / 2;
+
+  SECTION("Derivative filters")
+  {
+    vpImage<double> dIx, dIy;
+    vpImageFilter::getGradX(I, dIx, fgd, size);
+    vpImageFilter::getGradY(I, dIy, fgd, size);
+    vpImage<double> dIx_ref(I.getHeight(), I.getWidth(), 0), dIy_ref(I.getHeight(), I.getWidth(), 0);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = half; j < I.getWidth() - half; j++) {
+        dIx_ref[i][j] = vpImageFilter::derivativeFilterX(I, i, j, fgd, size);
+      }
+    }
+    for (unsigned int i = half; i < I.getHeight() - half; i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        dIy_ref[i][j] = vpImageFilter::derivativeFilterY(I, i, j, fgd, size);
+      }
+    }
+    CHECK(maxDifference(dIx, dIx_ref) < 1e-9);
+    CHECK(maxDifference(dIy, dIy_ref) < 1e-9);
+
+    vpImage<float> dIx_float, dIy_float;
+    vpImageFilter::getGradX(I, dIx_float, fgd, size);
+    vpImageFilter::getGradY(I, dIy_float, fgd, size);
+    CHECK(maxDifference(dIx, dIx_float) < 1e-3);
+    CHECK(maxDifference(dIy, dIy_float) < 1e-3);
+
+    vpImageFilter::getGradX(I, dIx);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 3; j < I.getWidth() - 3; j++) {
+        dIx_ref[i][j] = vpImageFilter::derivativeFilterX(I, i, j);
+      }
+      dIx_ref[i][2] = dIx_ref[i][I.getWidth() - 3] = 0;
+    }
+    CHECK(maxDifference(dIx, dIx_ref) < 1e-9);
+  }
+
+  SECTION("Gaussian derivative filters")
+  {
+    vpImage<double> dIx, dIy;
+    vpImageFilter::getGradXGauss2D(I, dIx, fg, fgd, size);
+    vpImageFilter::getGradYGauss2D(I, dIy, fg, fgd, size);
+
+    vpImage<double> GIx, GIy;
+    vpImageFilter::filterY(I, GIy, fg, size);
+    vpImageFilter::filterX(I, GIx, fg, size);
+    vpImage<double> dIx_ref(I.getHeight(), I.getWidth(), 0), dIy_ref(I.getHeight(), I.getWidth(), 0);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = half; j < I.getWidth() - half; j++) {
+        dIx_ref[i][j] = vpImageFilter::derivativeFilterX(GIy, i, j, fgd, size);
+      }
+    }
+    for (unsigned int i = half; i < I.getHeight() - half; i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        dIy_ref[i][j] = vpImageFilter::derivativeFilterY(GIx, i, j, fgd, size);
+      }
+    }
+    CHECK(maxDifference(dIx, dIx_ref) < 1e-9);
+    CHECK(maxDifference(dIy, dIy_ref) < 1e-9);
+
+    vpImage<float> dIx_float, dIy_float;
+    vpImageFilter::getGradXGauss2D(I, dIx_float, fg, fgd, size);
+    vpImageFilter::getGradYGauss2D(I, dIy_float, fg, fgd, size);
+    CHECK(maxDifference(dIx, dIx_float) < 1e-3);
+    CHECK(maxDifference(dIy, dIy_float) < 1e-3);
+  }
+
+  SECTION("Sobel")
+  {
+    vpImage<short> dIx, dIy;
+    vpImageFilter::sobel(I, dIx, dIy);
+    vpImage<float> dIx_float, dIy_float;
+    vpImageFilter::sobel(I, dIx_float, dIy_float);
+    CHECK(maxDifference(dIx, dIx_float) == 0.0);
+    CHECK(maxDifference(dIy, dIy_float) == 0.0);
+
+    for (unsigned int sobelSize = 1; sobelSize <= 4; sobelSize++) {
+      const unsigned int kernelSize = 2 * sobelSize + 1;
+      vpMatrix sobelX(kernelSize, kernelSize), sobelY(kernelSize, kernelSize);
+      vpImageFilter::getSobelKernelX(sobelX.data, sobelSize);
+      vpImageFilter::getSobelKernelY(sobelY.data, sobelSize);
+      vpImageFilter::sobel(I, dIx_float, dIy_float, sobelSize);
+
+      double maxDiffX = 0, maxDiffY = 0;
+      for (unsigned int i = sobelSize; i < I.getHeight() - sobelSize; i++) {
+        for (unsigned int j = sobelSize; j < I.getWidth() - sobelSize; j++) {
+          double gx = 0, gy = 0;
+          for (unsigned int a = 0; a < kernelSize; a++) {
+            for (unsigned int b = 0; b < kernelSize; b++) {
+              gx += sobelX[a][b] * I[i + a - sobelSize][j + b - sobelSize];
+              gy += sobelY[a][b] * I[i + a - sobelSize][j + b - sobelSize];
+            }
+          }
+          maxDiffX = (std::max)(maxDiffX, std::fabs(gx - dIx_float[i][j]));
+          maxDiffY = (std::max)(maxDiffY, std::fabs(gy - dIy_float[i][j]));
+        }
+      }
+      CHECK(maxDiffX < 1e-2);
+      CHECK(maxDiffY < 1e-2);
+    }
+  }
+}
+
+TEST_CASE("Separable filter", "[vpImageFilter]")
+{
+  vpImage<unsigned char> I = createImage(64, 80);
+
+  SECTION("Convolution with vpColVector kernels")
+  {
+    vpColVector kernelH(3), kernelV(3);
+    kernelH[0] = 1; kernelH[1] = 0; kernelH[2] = -1;
+    kernelV[0] = 1; kernelV[1] = 2; kernelV[2] = 1;
+    vpImage<double> If;
+    vpImageFilter::sepFilter(I, If, kernelH, kernelV);
+
+    vpImage<short> dIx, dIy;
+    vpImageFilter::sobel(I, dIx, dIy);
+    // The convolution with the flipped derivative is the Sobel correlation, with a zero border
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        const bool border = i == 0 || j == 0 || i == I.getHeight() - 1 || j == I.getWidth() - 1;
+        CHECK(If[i][j] == (border ? 0 : dIx[i][j]));
+      }
+    }
+  }
+
+  SECTION("Border types")
+  {
+    const float kernel[3] = {0.25f, 0.5f, 0.25f};
+    vpImage<float> If_reflect, If_replicate, If_zero;
+    vpImageFilter::sepFilter(I, If_reflect, kernel, 3, kernel, 3, vpImageFilter::BORDER_REFLECT);
+    vpImageFilter::sepFilter(I, If_replicate, kernel, 3, kernel, 3, vpImageFilter::BORDER_REPLICATE);
+    vpImageFilter::sepFilter(I, If_zero, kernel, 3, kernel, 3, vpImageFilter::BORDER_ZERO);
+
+    const float rowFiltered = 0.25f * I[0][1] + 0.5f * I[0][0] + 0.25f * I[0][1];
+    CHECK(If_reflect[0][0] == Approx(0.5f * rowFiltered + 0.5f * (0.25f * I[1][1] + 0.5f * I[1][0] + 0.25f * I[1][1])));
+    const float last = I[0][I.getWidth() - 1];
+    CHECK(If_replicate[0][I.getWidth() - 1] ==
+          Approx(0.75f * (0.25f * I[0][I.getWidth() - 2] + 0.75f * last) +
+                 0.25f * (0.25f * I[1][I.getWidth() - 2] + 0.75f * I[1][I.getWidth() - 1])));
+    CHECK(If_zero[0][5] == 0.f);
+    CHECK(If_zero[5][0] == 0.f);
+    CHECK(If_zero[5][5] == Approx(If_reflect[5][5]));
+  }
+
+  SECTION("Small images")
+  {
+    vpImage<unsigned char> I_small = createImage(2, 3);
+    vpImage<float> If;
+    vpImage<unsigned char> If_uchar;
+    vpImageFilter::gaussianBlur(I_small, If, 7);
+    vpImageFilter::gaussianBlur(I_small, If_uchar, 7);
+    CHECK(If.getHeight() == 2);
+    CHECK(If.getWidth() == 3);
+    CHECK(maxDifference(If, If_uchar) <= 2.0);
+  }
+
+  SECTION("Bad kernel size")
+  {
+    const float kernel[2] = {0.5f, 0.5f};
+    vpImage<float> If;
+    CHECK_THROWS_AS(vpImageFilter::sepFilter(I, If, kernel, 2, kernel, 2), vpImageException);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
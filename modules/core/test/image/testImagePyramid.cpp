@@ -0,0 +1,160 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test image pyramid.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImagePyramid.cpp
+
+  Test vpImagePyramid levels and the reuse of their buffers.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImagePyramid.h>
+
+namespace
+{
+void fillImage(vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = static_cast<unsigned char>((i * 7 + j * 13 + (i * j) % 5) % 256);
+    }
+  }
+}
+}
+
+TEST_CASE("Subsampling pyramid", "[vpImagePyramid]")
+{
+  vpImage<unsigned char> I(121, 163);
+  fillImage(I);
+
+  vpImagePyramid pyramid;
+  pyramid.build(I, 3);
+  REQUIRE(pyramid.getNbLevels() == 3);
+  CHECK(&pyramid[0] == &I);
+  CHECK_THROWS_AS(pyramid.getLevel(3), vpException);
+
+  for (unsigned int lvl = 1; lvl < 3; lvl++) {
+    unsigned int scale = 1 << lvl;
+    const vpImage<unsigned char> &I_lvl = pyramid[lvl];
+    REQUIRE(I_lvl.getHeight() == I.getHeight() / scale);
+    REQUIRE(I_lvl.getWidth() == I.getWidth() / scale);
+    for (unsigned int i = 0; i < I_lvl.getHeight(); i++) {
+      for (unsigned int j = 0; j < I_lvl.getWidth(); j++) {
+        CHECK(I_lvl[i][j] == I[i * scale][j * scale]);
+      }
+    }
+  }
+}
+
+TEST_CASE("Box pyramid", "[vpImagePyramid]")
+{
+  vpImage<unsigned char> I(120, 162);
+  fillImage(I);
+
+  vpImage<unsigned char> I_down;
+  vpImagePyramid::pyrDown(I, I_down, vpImagePyramid::BOX);
+  REQUIRE(I_down.getHeight() == 60);
+  REQUIRE(I_down.getWidth() == 81);
+  for (unsigned int i = 0; i < I_down.getHeight(); i++) {
+    for (unsigned int j = 0; j < I_down.getWidth(); j++) {
+      int sum = I[2 * i][2 * j] + I[2 * i][2 * j + 1] + I[2 * i + 1][2 * j] + I[2 * i + 1][2 * j + 1];
+      CHECK(I_down[i][j] == (sum + 2) / 4);
+    }
+  }
+}
+
+TEST_CASE("Gaussian pyramid", "[vpImagePyramid]")
+{
+  // A constant image is not modified by the smoothing
+  vpImage<unsigned char> I(97, 131, 100);
+  vpImagePyramid pyramid(vpImagePyramid::GAUSSIAN);
+  pyramid.build(I, 4);
+
+  for (unsigned int lvl = 1; lvl < 4; lvl++) {
+    const vpImage<unsigned char> &I_lvl = pyramid[lvl];
+    CHECK(I_lvl.getHeight() == (pyramid[lvl - 1].getHeight() + 1) / 2);
+    CHECK(I_lvl.getWidth() == (pyramid[lvl - 1].getWidth() + 1) / 2);
+    for (unsigned int i = 0; i < I_lvl.getSize(); i++) {
+      CHECK(I_lvl.bitmap[i] == 100);
+    }
+  }
+}
+
+TEST_CASE("Pyramid buffers reuse", "[vpImagePyramid]")
+{
+  vpImage<unsigned char> I(240, 320);
+  fillImage(I);
+
+  vpImagePyramid pyramid(vpImagePyramid::BOX);
+  pyramid.build(I, 3);
+  const unsigned char *bitmap1 = pyramid[1].bitmap;
+  const unsigned char *bitmap2 = pyramid[2].bitmap;
+
+  vpImage<unsigned char> I2(240, 320, 50);
+  pyramid.build(I2, 3);
+  CHECK(&pyramid[0] == &I2);
+  CHECK(pyramid[1].bitmap == bitmap1);
+  CHECK(pyramid[2].bitmap == bitmap2);
+  CHECK(pyramid[2][10][10] == 50);
+
+  // Using less levels keeps the buffers of the deeper levels
+  pyramid.build(I, 2);
+  CHECK(pyramid.getNbLevels() == 2);
+  pyramid.build(I, 3);
+  CHECK(pyramid[2].bitmap == bitmap2);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
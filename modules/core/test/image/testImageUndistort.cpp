@@ -0,0 +1,197 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the reusable image undistortion.
+ *
+ *****************************************************************************/
+
+
+/*!
+  \example testImageUndistort.cpp
+
+  Test vpImageUndistort against vpImageTools::initUndistortMap() and
+  vpImageTools::remap() for the different camera models.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpImageUndistort.h>
+
+namespace
+{
+vpImage<unsigned char> createImage(unsigned int height, unsigned int width)
+{
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      I[i][j] = static_cast<unsigned char>(127 + 100 * std::sin(i / 7.0) * std::cos(j / 5.0) + (i * 13 + j * 7) % 20);
+    }
+  }
+  return I;
+}
+
+bool isEqual(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2)
+{
+  return I1.getHeight() == I2.getHeight() && I1.getWidth() == I2.getWidth() &&
+         std::equal(I1.bitmap, I1.bitmap + I1.getSize(), I2.bitmap);
+}
+
+// Largest difference with the legacy remap, on the pixels whose source location is inside the image
+int maxDifference(const vpImage<unsigned char> &I, const vpCameraParameters &cam, const vpImage<unsigned char> &Iundist)
+{
+  vpArray2D<int> mapU, mapV;
+  vpArray2D<float> mapDu, mapDv;
+  vpImageTools::initUndistortMap(cam, I.getWidth(), I.getHeight(), mapU, mapV, mapDu, mapDv);
+  vpImage<unsigned char> Iref;
+  vpImageTools::remap(I, mapU, mapV, mapDu, mapDv, Iref);
+
+  int maxDiff = 0;
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      if (mapU[i][j] >= 0 && mapV[i][j] >= 0 && mapU[i][j] < static_cast<int>(I.getWidth()) - 1 &&
+          mapV[i][j] < static_cast<int>(I.getHeight()) - 1 && mapDu[i][j] >= 0 && mapDv[i][j] >= 0) {
+        maxDiff = (std::max)(maxDiff, vpMath::abs(Iundist[i][j] - Iref[i][j]));
+      }
+    }
+  }
+  return maxDiff;
+}
+} // namespace
+
+TEST_CASE("Camera models", "[vpImageUndistort]")
+{
+  // Odd width to also run the scalar tail of the vectorized loop
+  const vpImage<unsigned char> I = createImage(121, 163);
+  vpImage<unsigned char> Iundist;
+
+  SECTION("Without distortion")
+  {
+    vpCameraParameters cam(200, 200, 81, 60);
+    vpImageUndistort undistort(cam, I.getWidth(), I.getHeight());
+    undistort.undistort(I, Iundist);
+    CHECK(isEqual(Iundist, I));
+  }
+
+  SECTION("Radial distortion")
+  {
+    vpCameraParameters cam;
+    cam.initPersProjWithDistortion(200, 210, 83, 58, 0.25, -0.25);
+    vpImageUndistort undistort(cam, I.getWidth(), I.getHeight());
+    undistort.undistort(I, Iundist);
+    CHECK(maxDifference(I, cam, Iundist) <= 2);
+    // The corners of the undistorted image come from outside the distorted one
+    CHECK(Iundist[0][0] == 0);
+  }
+
+  SECTION("Kannala-Brandt distortion")
+  {
+    vpCameraParameters cam;
+    std::vector<double> coefs;
+    coefs.push_back(-0.01);
+    coefs.push_back(0.02);
+    coefs.push_back(-0.005);
+    coefs.push_back(0.001);
+    cam.initProjWithKannalaBrandtDistortion(150, 150, 81, 60, coefs);
+    vpImageUndistort undistort(cam, I.getWidth(), I.getHeight());
+    undistort.undistort(I, Iundist);
+    CHECK(maxDifference(I, cam, Iundist) <= 2);
+  }
+}
+
+TEST_CASE("Threads and color images", "[vpImageUndistort]")
+{
+  const vpImage<unsigned char> I = createImage(97, 131);
+  vpCameraParameters cam;
+  cam.initPersProjWithDistortion(180, 180, 65, 48, 0.2, -0.2);
+
+  vpImageUndistort undistort(cam, I.getWidth(), I.getHeight(), 1);
+  CHECK(undistort.getNbThreads() == 1);
+  vpImage<unsigned char> Iundist;
+  undistort.undistort(I, Iundist);
+
+  for (unsigned int nThreads = 2; nThreads <= 5; nThreads++) {
+    undistort.setNbThreads(nThreads);
+    vpImage<unsigned char> Iundist_threads;
+    for (int iter = 0; iter < 3; iter++) {
+      undistort.undistort(I, Iundist_threads);
+      CHECK(isEqual(Iundist_threads, Iundist));
+    }
+  }
+
+  // Every channel of a color image is interpolated as a grayscale image
+  vpImage<vpRGBa> I_color(I.getHeight(), I.getWidth()), Iundist_color;
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I_color.bitmap[i] = vpRGBa(I.bitmap[i], static_cast<unsigned char>(255 - I.bitmap[i]), I.bitmap[i], 255);
+  }
+  undistort.undistort(I_color, Iundist_color);
+  bool sameChannels = true;
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    const vpRGBa &rgba = Iundist_color.bitmap[i];
+    sameChannels = sameChannels && rgba.R == Iundist.bitmap[i] && rgba.B == Iundist.bitmap[i];
+  }
+  CHECK(sameChannels);
+}
+
+TEST_CASE("Invalid sizes", "[vpImageUndistort]")
+{
+  const vpImage<unsigned char> I = createImage(20, 30);
+  vpImage<unsigned char> Iundist;
+
+  vpImageUndistort undistort;
+  CHECK_THROWS_AS(undistort.undistort(I, Iundist), vpException);
+
+  undistort.init(vpCameraParameters(50, 50, 15, 10), 31, 20);
+  CHECK_THROWS_AS(undistort.undistort(I, Iundist), vpException);
+  CHECK_THROWS_AS(undistort.init(vpCameraParameters(), 1, 20), vpException);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
@@ -0,0 +1,265 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpImageView.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageView.cpp
+
+  Test that processing a vpImageView over a region of interest gives the same
+  result as processing the cropped image.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpImageView.h>
+
+namespace
+{
+template <class Type> void checkEqual(const vpImage<Type> &I1, const vpImage<Type> &I2)
+{
+  REQUIRE(I1.getHeight() == I2.getHeight());
+  REQUIRE(I1.getWidth() == I2.getWidth());
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    CHECK(I1.bitmap[i] == I2.bitmap[i]);
+  }
+}
+
+template <> void checkEqual(const vpImage<vpRGBa> &I1, const vpImage<vpRGBa> &I2)
+{
+  REQUIRE(I1.getHeight() == I2.getHeight());
+  REQUIRE(I1.getWidth() == I2.getWidth());
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    CHECK(I1.bitmap[i].R == I2.bitmap[i].R);
+    CHECK(I1.bitmap[i].G == I2.bitmap[i].G);
+    CHECK(I1.bitmap[i].B == I2.bitmap[i].B);
+    CHECK(I1.bitmap[i].A == I2.bitmap[i].A);
+  }
+}
+} // namespace
+
+TEST_CASE("View geometry", "[vpImageView]")
+{
+  vpImage<unsigned char> I(48, 64);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(i * 7);
+  }
+
+  vpImageView<unsigned char> full(I);
+  CHECK(full.getHeight() == I.getHeight());
+  CHECK(full.getWidth() == I.getWidth());
+  CHECK(full.isContinuous());
+
+  vpImageView<unsigned char> roi(I, vpRect(10, 5, 20, 12));
+  CHECK(roi.getHeight() == 12);
+  CHECK(roi.getWidth() == 20);
+  CHECK(roi.getStep() == I.getWidth());
+  CHECK_FALSE(roi.isContinuous());
+  CHECK(roi[0] == &I[5][10]);
+  CHECK(roi(11, 19) == I[16][29]);
+
+  SECTION("Nested view")
+  {
+    vpImageView<unsigned char> sub = roi.getView(vpRect(2, 3, 4, 5));
+    CHECK(sub[0] == &I[8][12]);
+    CHECK(sub.getHeight() == 5);
+    CHECK(sub.getWidth() == 4);
+  }
+
+  SECTION("Clipping")
+  {
+    vpImageView<unsigned char> clipped(I, vpRect(-5, 40, 30, 30));
+    CHECK(clipped[0] == &I[40][0]);
+    CHECK(clipped.getHeight() == 8);
+    CHECK(clipped.getWidth() == 25);
+    CHECK(vpImageView<unsigned char>(I, vpRect(100, 100, 10, 10)).empty());
+  }
+
+  SECTION("Copy")
+  {
+    vpImage<unsigned char> Iroi, Icrop;
+    roi.copyTo(Iroi);
+    vpImageTools::crop(I, vpRect(10, 5, 20, 12), Icrop);
+    checkEqual(Iroi, Icrop);
+  }
+
+  SECTION("Padded buffer")
+  {
+    std::vector<unsigned char> buffer(10 * 16, 0);
+    vpImageView<unsigned char> padded(&buffer[0], 10, 13, 16);
+    padded[9][12] = 42;
+    CHECK(buffer[9 * 16 + 12] == 42);
+    CHECK_THROWS_AS(vpImageView<unsigned char>(&buffer[0], 10, 17, 16), vpException);
+  }
+
+  SECTION("Read-only view")
+  {
+    const vpImage<unsigned char> &I_const = I;
+    vpImageView<const unsigned char> const_roi(I_const, vpRect(10, 5, 20, 12));
+    CHECK(const_roi[0] == &I[5][10]);
+    CHECK(const_roi(11, 19) == I[16][29]);
+
+    vpImageView<const unsigned char> converted = roi;
+    CHECK(converted[0] == roi[0]);
+    CHECK(converted.getStep() == roi.getStep());
+  }
+}
+
+TEST_CASE("Processing of a region of interest", "[vpImageView]")
+{
+  vpImage<vpRGBa> I(120, 160);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = vpRGBa(static_cast<unsigned char>(i * 3 + j), static_cast<unsigned char>(i * j),
+                       static_cast<unsigned char>(255 - j), 255);
+    }
+  }
+  vpImage<unsigned char> I_grey;
+  vpImageConvert::convert(I, I_grey);
+
+  const vpRect roi(17, 23, 101, 77);
+  vpImage<vpRGBa> I_crop;
+  vpImage<unsigned char> I_grey_crop;
+  vpImageTools::crop(I, roi, I_crop);
+  vpImageTools::crop(I_grey, roi, I_grey_crop);
+  vpImageView<vpRGBa> view(I, roi);
+  vpImageView<unsigned char> view_grey(I_grey, roi);
+
+  SECTION("Grey conversion")
+  {
+    vpImage<unsigned char> I_grey_view;
+    vpImageConvert::convert(view, I_grey_view);
+    checkEqual(I_grey_view, I_grey_crop);
+  }
+
+  SECTION("Resize")
+  {
+    vpImageTools::vpImageInterpolationType methods[] = {
+        vpImageTools::INTERPOLATION_NEAREST, vpImageTools::INTERPOLATION_LINEAR, vpImageTools::INTERPOLATION_AREA,
+        vpImageTools::INTERPOLATION_CUBIC};
+    for (size_t k = 0; k < sizeof(methods) / sizeof(methods[0]); k++) {
+      vpImage<unsigned char> Ires_grey_crop(31, 47), Ires_grey_view(31, 47);
+      vpImageTools::resize(I_grey_crop, Ires_grey_crop, methods[k]);
+      vpImageTools::resize(view_grey, Ires_grey_view, methods[k]);
+      checkEqual(Ires_grey_view, Ires_grey_crop);
+
+      vpImage<vpRGBa> Ires_crop(31, 47), Ires_view(31, 47);
+      vpImageTools::resize(I_crop, Ires_crop, methods[k]);
+      vpImageTools::resize(view, Ires_view, methods[k]);
+      checkEqual(Ires_view, Ires_crop);
+    }
+  }
+
+  SECTION("Filtering")
+  {
+    vpImage<unsigned char> Iblur_crop, Iblur_view;
+    vpImageFilter::gaussianBlur(I_grey_crop, Iblur_crop, 5);
+    vpImageFilter::gaussianBlur(view_grey, Iblur_view, 5);
+    checkEqual(Iblur_view, Iblur_crop);
+
+    vpImage<float> Iblurf_crop, Iblurf_view;
+    vpImageFilter::gaussianBlur(I_grey_crop, Iblurf_crop, 7, 1.5, true, 1);
+    vpImageFilter::gaussianBlur(view_grey, Iblurf_view, 7, 1.5, true, 3);
+    checkEqual(Iblurf_view, Iblurf_crop);
+
+    vpImage<short> dIx_crop, dIy_crop, dIx_view, dIy_view;
+    vpImageFilter::sobel(I_grey_crop, dIx_crop, dIy_crop);
+    vpImageFilter::sobel(view_grey, dIx_view, dIy_view);
+    checkEqual(dIx_view, dIx_crop);
+    checkEqual(dIy_view, dIy_crop);
+
+    vpMatrix M(3, 3);
+    M[0][0] = M[2][2] = 1;
+    M[0][2] = M[2][0] = -1;
+    M[1][1] = 2;
+    vpImage<double> If_crop, If_view;
+    vpImageFilter::filter(I_grey_crop, If_crop, M);
+    vpImageFilter::filter(view_grey, If_view, M);
+    checkEqual(If_view, If_crop);
+  }
+
+  SECTION("Warp")
+  {
+    vpMatrix T(2, 3);
+    T[0][0] = std::cos(0.2);
+    T[0][1] = -std::sin(0.2);
+    T[1][0] = std::sin(0.2);
+    T[1][1] = std::cos(0.2);
+    T[0][2] = 5.5;
+    T[1][2] = -3.25;
+
+    vpImageTools::vpImageInterpolationType methods[] = {vpImageTools::INTERPOLATION_NEAREST,
+                                                        vpImageTools::INTERPOLATION_LINEAR};
+    for (size_t k = 0; k < sizeof(methods) / sizeof(methods[0]); k++) {
+      vpImage<unsigned char> Iwarp_grey_crop(70, 90), Iwarp_grey_view(70, 90);
+      vpImageTools::warpImage(I_grey_crop, T, Iwarp_grey_crop, methods[k], true);
+      vpImageTools::warpImage(view_grey, T, Iwarp_grey_view, methods[k], true);
+      checkEqual(Iwarp_grey_view, Iwarp_grey_crop);
+
+      vpImage<vpRGBa> Iwarp_crop(70, 90), Iwarp_view(70, 90);
+      vpImageTools::warpImage(I_crop, T, Iwarp_crop, methods[k], true);
+      vpImageTools::warpImage(view, T, Iwarp_view, methods[k], true);
+      checkEqual(Iwarp_view, Iwarp_crop);
+
+      // Floating point path, that copies the view
+      vpImageTools::warpImage(I_grey_crop, T, Iwarp_grey_crop, methods[k], false);
+      vpImageTools::warpImage(view_grey, T, Iwarp_grey_view, methods[k], false);
+      checkEqual(Iwarp_grey_view, Iwarp_grey_crop);
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
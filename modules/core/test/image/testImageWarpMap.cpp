@@ -0,0 +1,208 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the fixed-point and precomputed image warping.
+ *
+ *****************************************************************************/
+
+
+/*!
+  \example testImageWarpMap.cpp
+
+  Compare the fixed-point vpImageTools::warpImage() and vpImageWarpMap with
+  the floating-point warping.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpImageWarpMap.h>
+
+namespace
+{
+vpImage<unsigned char> createImage(unsigned int height, unsigned int width)
+{
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      I[i][j] = static_cast<unsigned char>(127 + 100 * std::sin(i / 9.0) * std::cos(j / 7.0));
+    }
+  }
+  return I;
+}
+
+vpMatrix createAffine()
+{
+  vpMatrix M(2, 3);
+  M[0][0] = 0.9;
+  M[0][1] = -0.2;
+  M[0][2] = 15.3;
+  M[1][0] = 0.25;
+  M[1][1] = 1.1;
+  M[1][2] = -8.7;
+  return M;
+}
+
+vpMatrix createHomography()
+{
+  vpMatrix M(3, 3);
+  M[0][0] = 0.95;
+  M[0][1] = 0.1;
+  M[0][2] = 12.0;
+  M[1][0] = -0.05;
+  M[1][1] = 1.05;
+  M[1][2] = 5.5;
+  M[2][0] = 4e-4;
+  M[2][1] = -2e-4;
+  M[2][2] = 1.0;
+  return M;
+}
+
+bool isEqual(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2)
+{
+  return I1.getHeight() == I2.getHeight() && I1.getWidth() == I2.getWidth() &&
+         std::equal(I1.bitmap, I1.bitmap + I1.getSize(), I2.bitmap);
+}
+
+// Ratio of pixels that differ by less than the threshold
+double ratioClose(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2, int threshold)
+{
+  unsigned int nbClose = 0;
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    nbClose += vpMath::abs(I1.bitmap[i] - I2.bitmap[i]) <= threshold ? 1 : 0;
+  }
+  return nbClose / static_cast<double>(I1.getSize());
+}
+} // namespace
+
+TEST_CASE("Fixed-point warping", "[warp]")
+{
+  // Odd width to also run the scalar tail of the vectorized loops
+  const vpImage<unsigned char> I = createImage(131, 173);
+  const vpMatrix transformations[] = {createAffine(), createHomography()};
+
+  for (size_t t = 0; t < 2; t++) {
+    vpImage<unsigned char> I_ref(I.getHeight(), I.getWidth(), 0), I_fixed(I.getHeight(), I.getWidth(), 0);
+    vpImageTools::warpImage(I, transformations[t], I_ref, vpImageTools::INTERPOLATION_LINEAR, false);
+    vpImageTools::warpImage(I, transformations[t], I_fixed, vpImageTools::INTERPOLATION_LINEAR, true);
+    CHECK(ratioClose(I_ref, I_fixed, 1) > 0.995);
+
+    vpImageTools::warpImage(I, transformations[t], I_ref, vpImageTools::INTERPOLATION_NEAREST, false);
+    vpImageTools::warpImage(I, transformations[t], I_fixed, vpImageTools::INTERPOLATION_NEAREST, true);
+    CHECK(ratioClose(I_ref, I_fixed, 0) > 0.995);
+
+    // The rows are independent
+    vpImage<unsigned char> I_thread(I.getHeight(), I.getWidth(), 0), I_threads(I.getHeight(), I.getWidth(), 0);
+    vpImageTools::warpImage(I, transformations[t], I_thread, vpImageTools::INTERPOLATION_LINEAR, true, false, 1);
+    vpImageTools::warpImage(I, transformations[t], I_threads, vpImageTools::INTERPOLATION_LINEAR, true, false, 3);
+    CHECK(isEqual(I_threads, I_thread));
+  }
+
+  SECTION("Pixels without source are left unchanged")
+  {
+    vpImage<unsigned char> I_warped(I.getHeight(), I.getWidth(), 42);
+    vpImageTools::warpImage(I, createHomography(), I_warped, vpImageTools::INTERPOLATION_LINEAR);
+    // The homography moves the image to the bottom right
+    CHECK(I_warped[0][0] == 42);
+    CHECK(I_warped[I.getHeight() / 2][I.getWidth() / 2] != 42);
+  }
+}
+
+TEST_CASE("Precomputed warping", "[warp]")
+{
+  const vpImage<unsigned char> I = createImage(131, 173);
+  const vpMatrix H = createHomography();
+
+  vpImageWarpMap map(H, I.getHeight(), I.getWidth(), 90, 111);
+  CHECK(map.getDstHeight() == 90);
+  CHECK(map.getDstWidth() == 111);
+
+  vpImage<unsigned char> I_map, I_fixed(90, 111, 0), I_ref(90, 111, 0);
+  map.warp(I, I_map);
+  vpImageTools::warpImage(I, H, I_fixed, vpImageTools::INTERPOLATION_LINEAR, true);
+  vpImageTools::warpImage(I, H, I_ref, vpImageTools::INTERPOLATION_LINEAR, false);
+  CHECK(isEqual(I_map, I_fixed));
+  CHECK(ratioClose(I_map, I_ref, 1) > 0.995);
+
+  SECTION("Pixel center")
+  {
+    vpImageWarpMap map_center(H, I.getHeight(), I.getWidth(), 90, 111, vpImageTools::INTERPOLATION_LINEAR, true);
+    vpImage<unsigned char> I_center;
+    map_center.warp(I, I_center);
+    I_ref = 0;
+    vpImageTools::warpImage(I, H, I_ref, vpImageTools::INTERPOLATION_LINEAR, false, true);
+    CHECK(ratioClose(I_center, I_ref, 1) > 0.99);
+  }
+
+  SECTION("Color images")
+  {
+    vpImage<vpRGBa> I_color(I.getHeight(), I.getWidth()), I_color_map;
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      I_color.bitmap[i] = vpRGBa(I.bitmap[i], I.bitmap[i], I.bitmap[i], 255);
+    }
+    map.warp(I_color, I_color_map, 2);
+    bool sameChannels = true;
+    for (unsigned int i = 0; i < I_map.getSize(); i++) {
+      sameChannels = sameChannels && I_color_map.bitmap[i].R == I_map.bitmap[i] &&
+                     I_color_map.bitmap[i].G == I_map.bitmap[i] && I_color_map.bitmap[i].B == I_map.bitmap[i];
+    }
+    CHECK(sameChannels);
+  }
+
+  SECTION("Invalid sizes")
+  {
+    const vpImage<unsigned char> I_small(10, 10);
+    CHECK_THROWS_AS(map.warp(I_small, I_map), vpException);
+    CHECK_THROWS_AS(map.init(vpMatrix(3, 2), 10, 10, 10, 10), vpException);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
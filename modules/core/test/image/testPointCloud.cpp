@@ -0,0 +1,148 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test organized point cloud.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testPointCloud.cpp
+
+  Test vpPointCloud storage, views and conversion from/to std::vector<vpColVector>.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpPointCloud.h>
+
+TEST_CASE("Point cloud storage", "[vpPointCloud]")
+{
+  const unsigned int height = 3, width = 4;
+  vpPointCloud<float> pointcloud(height, width);
+  CHECK(pointcloud.getHeight() == height);
+  CHECK(pointcloud.getWidth() == width);
+  CHECK(pointcloud.size() == height * width);
+  CHECK_FALSE(pointcloud.isView());
+
+  // Planes are contiguous
+  CHECK(pointcloud.getY() == pointcloud.getX() + height * width);
+  CHECK(pointcloud.getZ() == pointcloud.getY() + height * width);
+
+  for (unsigned int i = 0; i < pointcloud.size(); i++) {
+    pointcloud.getX()[i] = static_cast<float>(i);
+    pointcloud.getY()[i] = static_cast<float>(2 * i);
+    pointcloud.getZ()[i] = static_cast<float>(3 * i);
+  }
+
+  SECTION("Deep copy")
+  {
+    vpPointCloud<float> copy(pointcloud);
+    CHECK_FALSE(copy.isView());
+    CHECK(copy.getX() != pointcloud.getX());
+    for (unsigned int i = 0; i < copy.size(); i++) {
+      CHECK(copy.getX()[i] == pointcloud.getX()[i]);
+      CHECK(copy.getY()[i] == pointcloud.getY()[i]);
+      CHECK(copy.getZ()[i] == pointcloud.getZ()[i]);
+    }
+  }
+
+  SECTION("Resize with the same number of points keeps the memory")
+  {
+    const float *X = pointcloud.getX();
+    pointcloud.resize(width, height);
+    CHECK(pointcloud.getX() == X);
+    CHECK(pointcloud.getZ()[5] == 15.f);
+  }
+
+  SECTION("Conversion to and from std::vector<vpColVector>")
+  {
+    std::vector<vpColVector> legacy;
+    pointcloud.toColVectors(legacy);
+    REQUIRE(legacy.size() == pointcloud.size());
+
+    vpPointCloud<double> pointcloud_d;
+    pointcloud_d.buildFrom(legacy, height, width);
+    for (unsigned int i = 0; i < pointcloud_d.size(); i++) {
+      CHECK(pointcloud_d.getX()[i] == Approx(i));
+      CHECK(pointcloud_d.getY()[i] == Approx(2 * i));
+      CHECK(pointcloud_d.getZ()[i] == Approx(3 * i));
+    }
+
+    CHECK_THROWS_AS(pointcloud_d.buildFrom(legacy, height + 1, width), vpException);
+  }
+}
+
+TEST_CASE("Point cloud view", "[vpPointCloud]")
+{
+  std::vector<double> X(6, 1.0), Y(6, 2.0), Z(6, 3.0);
+  vpPointCloud<double> view(&X[0], &Y[0], &Z[0], 2, 3);
+  CHECK(view.isView());
+  CHECK(view.getX() == &X[0]);
+  CHECK(view.getY() == &Y[0]);
+  CHECK(view.getZ() == &Z[0]);
+
+  // Writing through the view modifies the user buffers
+  view.getZ()[4] = 0.0;
+  CHECK(Z[4] == 0.0);
+
+  // Copying a view gives a view on the same buffers
+  vpPointCloud<double> view2 = view;
+  CHECK(view2.isView());
+  CHECK(view2.getX() == &X[0]);
+
+  // Resizing a view makes it own its data
+  view2.resize(2, 3);
+  CHECK_FALSE(view2.isView());
+  CHECK(view2.getX() != &X[0]);
+  CHECK(X[0] == 1.0);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
@@ -616,6 +616,91 @@ TEST_CASE("Benchmark AtA", "[benchmark]") {
   }
 }
 
+TEST_CASE("Benchmark weighted AtA and Atb for tall matrices", "[benchmark]") {
+  // Sanity checks against the naive code, for the dedicated and the generic kernels
+  for (unsigned int cols = 1; cols <= 9; cols++) {
+    const unsigned int rows = 101;
+    vpMatrix A = generateRandomMatrix(rows, cols);
+    vpColVector w = generateRandomVector(rows, 0, 1);
+    vpColVector b = generateRandomVector(rows);
+
+    vpMatrix W(rows, rows);
+    for (unsigned int i = 0; i < rows; i++) {
+      W[i][i] = w[i];
+    }
+
+    vpMatrix AtA;
+    A.AtA(AtA);
+    REQUIRE(equalMatrix(AtA, AtA_regular(A)));
+
+    vpMatrix AtWA;
+    A.AtA(w, AtWA);
+    REQUIRE(equalMatrix(AtWA, dgemm_regular(A.t(), W * A)));
+
+    vpColVector Atb, AtWb;
+    A.Atb(b, Atb);
+    A.Atb(w, b, AtWb);
+    REQUIRE(equalMatrix(Atb, dgemv_regular(A.t(), b)));
+    REQUIRE(equalMatrix(AtWb, dgemv_regular(A.t(), W * b)));
+  }
+
+  if (runBenchmark || runBenchmarkAll) {
+    std::vector<std::pair<int, int>> sizes = { {500, 3}, {2000, 4}, {2000, 6}, {20000, 6}, {2000, 8} };
+
+    for (auto sz : sizes) {
+      vpMatrix A = generateRandomMatrix(sz.first, sz.second);
+      vpColVector w = generateRandomVector(sz.first, 0, 1);
+      vpColVector b = generateRandomVector(sz.first);
+
+      std::ostringstream oss;
+      oss << "(" << A.getRows() << "x" << A.getCols() << ") - Naive code AtA";
+      vpMatrix AtA, AtA_true;
+      BENCHMARK(oss.str().c_str()) {
+        AtA_true = AtA_regular(A);
+        return AtA_true;
+      };
+
+      oss.str("");
+      oss << "(" << A.getRows() << "x" << A.getCols() << ") - ViSP AtA";
+      BENCHMARK(oss.str().c_str()) {
+        A.AtA(AtA);
+        return AtA;
+      };
+      REQUIRE(equalMatrix(AtA, AtA_true));
+
+      oss.str("");
+      oss << "(" << A.getRows() << "x" << A.getCols() << ") - ViSP weighted AtA";
+      BENCHMARK(oss.str().c_str()) {
+        A.AtA(w, AtA);
+        return AtA;
+      };
+
+      oss.str("");
+      oss << "(" << A.getRows() << "x" << A.getCols() << ") - Naive code Atb";
+      vpColVector Atb, Atb_true;
+      BENCHMARK(oss.str().c_str()) {
+        Atb_true = dgemv_regular(A.t(), b);
+        return Atb_true;
+      };
+
+      oss.str("");
+      oss << "(" << A.getRows() << "x" << A.getCols() << ") - ViSP Atb";
+      BENCHMARK(oss.str().c_str()) {
+        A.Atb(b, Atb);
+        return Atb;
+      };
+      REQUIRE(equalMatrix(Atb, Atb_true));
+
+      oss.str("");
+      oss << "(" << A.getRows() << "x" << A.getCols() << ") - ViSP weighted Atb";
+      BENCHMARK(oss.str().c_str()) {
+        A.Atb(w, b, Atb);
+        return Atb;
+      };
+    }
+  }
+}
+
 TEST_CASE("Benchmark AAt", "[benchmark]") {
   if (runBenchmark || runBenchmarkAll) {
     std::vector<std::pair<int, int>> sizes = { {3, 3}, {6, 6}, {8, 8}, {10, 10}, {20, 20}, {6, 200}, {200, 6} };//, {207, 119}, {83, 201}, {600, 400}, {400, 600} };
@@ -0,0 +1,222 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark rigid transformation operations.
+ *
+ *****************************************************************************/
+
+
+/*!
+  \example perfTransformationOperations.cpp
+
+  Benchmark construction, composition and inversion of the fixed-size rigid
+  transformation types: vpHomogeneousMatrix, vpRotationMatrix,
+  vpTranslationVector and vpVelocityTwistMatrix.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpVelocityTwistMatrix.h>
+
+namespace
+{
+static bool g_runBenchmark = false;
+
+void checkEqual(const vpArray2D<double> &A, const vpArray2D<double> &B)
+{
+  REQUIRE(A.getRows() == B.getRows());
+  REQUIRE(A.getCols() == B.getCols());
+  for (unsigned int i = 0; i < A.getRows(); i++) {
+    for (unsigned int j = 0; j < A.getCols(); j++) {
+      CHECK(A[i][j] == B[i][j]);
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("Fixed-size storage", "[transformation]")
+{
+  const vpHomogeneousMatrix M(0.1, -0.2, 0.3, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(30));
+
+  SECTION("Copy")
+  {
+    vpHomogeneousMatrix M2(M);
+    CHECK(M2.data != M.data);
+    checkEqual(M2, M);
+
+    std::vector<vpHomogeneousMatrix> vec(10, M);
+    vec.resize(100);
+    checkEqual(vec[9], M);
+    checkEqual(vec[99], vpHomogeneousMatrix());
+  }
+
+  SECTION("Move through the base class")
+  {
+    vpHomogeneousMatrix M2(M);
+    vpArray2D<double> A(std::move(static_cast<vpArray2D<double> &>(M2)));
+    checkEqual(A, M);
+    checkEqual(M2, M);
+
+    vpArray2D<double> B(2, 2);
+    B = std::move(static_cast<vpArray2D<double> &>(M2));
+    checkEqual(B, M);
+  }
+
+  SECTION("Resize and reshape through the base class")
+  {
+    vpHomogeneousMatrix M2(M);
+    vpArray2D<double> &A = M2;
+    A.reshape(2, 8);
+    CHECK(A.getRows() == 2);
+    CHECK(A[1][0] == M[2][0]);
+
+    A.resize(5, 5, false);
+    CHECK(A[1][1] == M[2][1]);
+    CHECK(A[4][4] == 0.);
+  }
+
+  SECTION("Conversions")
+  {
+    vpRotationMatrix R(M);
+    vpTranslationVector t(M);
+    vpVelocityTwistMatrix V(M);
+    checkEqual(vpHomogeneousMatrix(t, R), M);
+    checkEqual(vpTranslationVector(vpColVector(t)), t);
+    CHECK_THROWS_AS(vpTranslationVector(vpColVector(4)), vpException);
+    checkEqual(vpVelocityTwistMatrix(t, R), V);
+  }
+}
+
+TEST_CASE("Benchmark rigid transformations", "[benchmark]")
+{
+  if (g_runBenchmark) {
+    const vpHomogeneousMatrix M1(0.1, -0.2, 0.3, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(30));
+    const vpHomogeneousMatrix M2(-0.4, 0.5, 1.2, vpMath::rad(-5), vpMath::rad(15), vpMath::rad(45));
+
+    BENCHMARK("vpHomogeneousMatrix construction")
+    {
+      vpHomogeneousMatrix M(0.1, -0.2, 0.3, 0.4, 0.5, 0.6);
+      return M[0][3];
+    };
+
+    BENCHMARK("vpHomogeneousMatrix copy")
+    {
+      vpHomogeneousMatrix M(M1);
+      return M[0][3];
+    };
+
+    BENCHMARK("vpHomogeneousMatrix composition")
+    {
+      vpHomogeneousMatrix M = M1 * M2;
+      return M[0][3];
+    };
+
+    BENCHMARK("vpHomogeneousMatrix inverse")
+    {
+      vpHomogeneousMatrix M = M1.inverse();
+      return M[0][3];
+    };
+
+    const vpRotationMatrix R1(M1), R2(M2);
+    BENCHMARK("vpRotationMatrix composition")
+    {
+      vpRotationMatrix R = R1 * R2;
+      return R[0][0];
+    };
+
+    const vpTranslationVector t1(M1), t2(M2);
+    BENCHMARK("vpTranslationVector sum")
+    {
+      vpTranslationVector t = t1 + t2;
+      return t[0];
+    };
+
+    BENCHMARK("vpVelocityTwistMatrix construction")
+    {
+      vpVelocityTwistMatrix V(M1);
+      return V[0][0];
+    };
+
+    const vpVelocityTwistMatrix V1(M1), V2(M2);
+    BENCHMARK("vpVelocityTwistMatrix composition")
+    {
+      vpVelocityTwistMatrix V = V1 * V2;
+      return V[0][0];
+    };
+
+    // Same composition with a heap allocated vpMatrix, for reference
+    const vpMatrix A1(M1), A2(M2);
+    BENCHMARK("vpMatrix 4x4 product")
+    {
+      vpMatrix A = A1 * A2;
+      return A[0][3];
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(g_runBenchmark)  // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark?");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
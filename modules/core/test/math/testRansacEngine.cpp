@@ -0,0 +1,385 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the generic RANSAC estimator.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testRansacEngine.cpp
+
+  Test vpRansacEngine on 2D line fitting, with the uniform and PROSAC samplings,
+  the full, preemptive and SPRT scorings, and several threads. With --benchmark,
+  compare the trials per second and the time to reach the consensus.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <algorithm>
+#include <iomanip>
+
+#include <visp3/core/vpGaussRand.h>
+#include <visp3/core/vpRansacEngine.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+static bool g_runBenchmark = false;
+
+// Line a x + b y + c = 0 with a^2 + b^2 = 1 fitted to 2D points
+class LineModel
+{
+public:
+  struct Hypothesis {
+    Hypothesis() : a(0), b(0), c(0) {}
+    double a, b, c;
+  };
+
+  LineModel(const std::vector<double> &x, const std::vector<double> &y) : m_x(&x), m_y(&y) {}
+
+  unsigned int getNbData() const { return static_cast<unsigned int>(m_x->size()); }
+  unsigned int getSampleSize() const { return 2; }
+  unsigned int getMinimalSampleSize() const { return 2; }
+  unsigned int getMaxNbHypotheses() const { return 1; }
+
+  bool isDegenerate(const unsigned int *sample, unsigned int size, unsigned int index) const
+  {
+    for (unsigned int i = 0; i < size; i++) {
+      const double dx = (*m_x)[index] - (*m_x)[sample[i]], dy = (*m_y)[index] - (*m_y)[sample[i]];
+      if (dx * dx + dy * dy < 1e-12) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  unsigned int computeHypotheses(const unsigned int *sample, Hypothesis *hypotheses) const
+  {
+    const double x0 = (*m_x)[sample[0]], y0 = (*m_y)[sample[0]];
+    const double dx = (*m_x)[sample[1]] - x0, dy = (*m_y)[sample[1]] - y0;
+    const double norm = std::sqrt(dx * dx + dy * dy);
+    hypotheses[0].a = -dy / norm;
+    hypotheses[0].b = dx / norm;
+    hypotheses[0].c = -(hypotheses[0].a * x0 + hypotheses[0].b * y0);
+    return 1;
+  }
+
+  void computeResiduals(const Hypothesis &h, unsigned int begin, unsigned int end, double *residuals) const
+  {
+    const double *x = &(*m_x)[0], *y = &(*m_y)[0];
+    for (unsigned int i = begin; i < end; i++) {
+      const double d = h.a * x[i] + h.b * y[i] + h.c;
+      residuals[i - begin] = d * d;
+    }
+  }
+
+  void filterInliers(std::vector<unsigned int> &) const {}
+
+private:
+  const std::vector<double> *m_x, *m_y;
+};
+
+// Points of the line y = 0.5 x + 0.2 with a small noise, and uniform outliers. The scores of the inliers are
+// higher on average.
+struct LineData {
+  LineData(unsigned int n, double outlierRatio) : x(n), y(n), scores(n), isInlier(n)
+  {
+    vpUniRand rng(12);
+    vpGaussRand noise(0.001, 0, 12);
+    for (unsigned int i = 0; i < n; i++) {
+      x[i] = rng.uniform(-1.0, 1.0);
+      isInlier[i] = rng.uniform(0.0, 1.0) >= outlierRatio;
+      y[i] = isInlier[i] ? 0.5 * x[i] + 0.2 + noise() : rng.uniform(-1.0, 1.0);
+      scores[i] = rng.uniform(0.0, 1.0) + (isInlier[i] ? 0.5 : 0.0);
+    }
+  }
+
+  unsigned int nbInliers() const
+  {
+    return static_cast<unsigned int>(std::count(isInlier.begin(), isInlier.end(), true));
+  }
+
+  std::vector<double> x, y, scores;
+  std::vector<bool> isInlier;
+};
+
+void checkLine(const LineModel::Hypothesis &h)
+{
+  // Same line as -0.5 x + y - 0.2 = 0 normalized
+  const double norm = std::sqrt(1.25);
+  const double s = h.b > 0 ? 1.0 : -1.0;
+  CHECK(s * h.a == Approx(-0.5 / norm).margin(0.01));
+  CHECK(s * h.b == Approx(1.0 / norm).margin(0.01));
+  CHECK(s * h.c == Approx(-0.2 / norm).margin(0.01));
+}
+} // namespace
+
+TEST_CASE("Line fitting", "[ransac]")
+{
+  const LineData data(2000, 0.6);
+  const LineModel model(data.x, data.y);
+  const vpRansacEngine<LineModel>::vpRansacScoring scorings[] = {vpRansacEngine<LineModel>::FULL_SCORING,
+                                                                  vpRansacEngine<LineModel>::PREEMPTIVE_SCORING,
+                                                                  vpRansacEngine<LineModel>::SPRT_SCORING};
+
+  for (int prosac = 0; prosac < 2; prosac++) {
+    for (int s = 0; s < 3; s++) {
+      for (unsigned int nbThreads = 1; nbThreads <= 4; nbThreads *= 4) {
+        INFO("prosac: " << prosac << " ; scoring: " << s << " ; threads: " << nbThreads);
+        vpRansacEngine<LineModel> ransac(model);
+        ransac.setThreshold(0.005);
+        ransac.setNbThreads(nbThreads);
+        ransac.setScoring(scorings[s]);
+        if (prosac == 1) {
+          ransac.setScores(data.scores);
+        }
+
+        LineModel::Hypothesis line;
+        std::vector<unsigned int> inliers;
+        REQUIRE(ransac.estimate(line, inliers));
+        checkLine(line);
+
+        CHECK(ransac.getNbInliers() == inliers.size());
+        CHECK(inliers.size() > 95 * data.nbInliers() / 100);
+        unsigned int nbOutliers = 0;
+        for (size_t i = 0; i < inliers.size(); i++) {
+          nbOutliers += data.isInlier[inliers[i]] ? 0 : 1;
+          if (i > 0) {
+            CHECK(inliers[i - 1] < inliers[i]);
+          }
+        }
+        // Outliers close to the line are accepted
+        CHECK(nbOutliers < inliers.size() / 50);
+
+        // The adaptive number of trials for 40% of inliers and samples of 2 points is about 27
+        CHECK(ransac.getNbTrials() < 100);
+      }
+    }
+  }
+}
+
+TEST_CASE("Scorings", "[ransac]")
+{
+  const LineData data(5000, 0.7);
+  const LineModel model(data.x, data.y);
+
+  vpRansacEngine<LineModel> ransac(model);
+  ransac.setThreshold(0.005);
+  ransac.setProbability(0);
+  ransac.setMaxTrials(200);
+
+  LineModel::Hypothesis full, preemptive, sprt;
+  std::vector<unsigned int> inliersFull, inliersPreemptive, inliersSprt;
+  ransac.setScoring(vpRansacEngine<LineModel>::FULL_SCORING);
+  REQUIRE(ransac.estimate(full, inliersFull));
+  const double nbScoredFull = ransac.getNbScoredData();
+  CHECK(nbScoredFull == 200.0 * 5000);
+
+  // The preemptive scoring gives the same result with less residuals
+  ransac.setScoring(vpRansacEngine<LineModel>::PREEMPTIVE_SCORING);
+  REQUIRE(ransac.estimate(preemptive, inliersPreemptive));
+  CHECK(inliersPreemptive == inliersFull);
+  CHECK(preemptive.a == full.a);
+  CHECK(preemptive.b == full.b);
+  CHECK(preemptive.c == full.c);
+  const double nbScoredPreemptive = ransac.getNbScoredData();
+  CHECK(nbScoredPreemptive < nbScoredFull);
+
+  // The SPRT rejects most bad hypotheses after a few blocks
+  ransac.setScoring(vpRansacEngine<LineModel>::SPRT_SCORING);
+  REQUIRE(ransac.estimate(sprt, inliersSprt));
+  checkLine(sprt);
+  CHECK(ransac.getNbScoredData() < nbScoredPreemptive);
+}
+
+TEST_CASE("SPRT threshold", "[ransac]")
+{
+  // Values of Chum and Matas for a single hypothesis per sample and t_M = 200
+  const double A = vpRansacEngine<LineModel>::computeSprtThreshold(0.1, 0.01, 200.0, 1.0);
+  CHECK(A == Approx(18.2).margin(0.1));
+  CHECK(A == Approx(200.0 * 0.0713312 + 1 + std::log(A)).epsilon(1e-4));
+
+  // The threshold decreases with the number of hypotheses per sample
+  CHECK(vpRansacEngine<LineModel>::computeSprtThreshold(0.1, 0.01, 200.0, 4.0) < A);
+  CHECK(vpRansacEngine<LineModel>::computeSprtThreshold(0.01, 0.1, 200.0, 1.0) ==
+        std::numeric_limits<double>::max());
+}
+
+TEST_CASE("PROSAC sampling", "[ransac]")
+{
+  // Only the 300 best scored points are inliers: the first PROSAC samples are drawn among them
+  LineData data(10000, 0.97);
+  for (size_t i = 0; i < data.scores.size(); i++) {
+    data.scores[i] = data.isInlier[i] ? 1.0 + data.scores[i] : data.scores[i];
+  }
+  const LineModel model(data.x, data.y);
+
+  vpRansacEngine<LineModel> ransac(model);
+  ransac.setThreshold(0.005);
+  ransac.setMaxTrials(10000);
+  ransac.setNbInliersToReachConsensus(95 * data.nbInliers() / 100);
+  ransac.setScores(data.scores);
+
+  LineModel::Hypothesis line;
+  std::vector<unsigned int> inliers;
+  REQUIRE(ransac.estimate(line, inliers));
+  checkLine(line);
+  CHECK(ransac.getNbTrials() < 10);
+
+  // With 3% of inliers, the uniform sampling needs about 1000 trials
+  ransac.setScores(std::vector<double>());
+  REQUIRE(ransac.estimate(line, inliers));
+  checkLine(line);
+  CHECK(ransac.getNbTrials() > 10);
+}
+
+TEST_CASE("Invalid inputs", "[ransac]")
+{
+  const LineData data(10, 0.5);
+  const LineModel model(data.x, data.y);
+  vpRansacEngine<LineModel> ransac(model);
+  LineModel::Hypothesis line;
+  std::vector<unsigned int> inliers;
+
+  CHECK_THROWS_AS(ransac.setScores(std::vector<double>(5, 1.0)), vpException);
+
+  const std::vector<double> one(1, 0.0);
+  const LineModel tooSmall(one, one);
+  vpRansacEngine<LineModel> ransac2(tooSmall);
+  CHECK_THROWS_AS(ransac2.estimate(line, inliers), vpException);
+}
+
+TEST_CASE("Benchmark RANSAC", "[benchmark]")
+{
+  if (g_runBenchmark) {
+    const LineData data(20000, 0.9);
+    const LineModel model(data.x, data.y);
+    const unsigned int consensus = 95 * data.nbInliers() / 100;
+
+    const char *samplings[] = {"uniform", "PROSAC"};
+    const char *scorings[] = {"full", "preemptive", "SPRT"};
+    std::cout << std::setw(10) << "sampling" << std::setw(12) << "scoring" << std::setw(10) << "threads"
+              << std::setw(10) << "trials" << std::setw(14) << "trials/s" << std::setw(12) << "time (ms)"
+              << std::endl;
+    for (int prosac = 0; prosac < 2; prosac++) {
+      for (int s = 0; s < 3; s++) {
+        for (unsigned int nbThreads = 1; nbThreads <= 4; nbThreads *= 2) {
+          vpRansacEngine<LineModel> ransac(model);
+          ransac.setThreshold(0.005);
+          ransac.setMaxTrials(100000);
+          ransac.setProbability(0);
+          ransac.setNbInliersToReachConsensus(consensus);
+          ransac.setNbThreads(nbThreads);
+          ransac.setScoring(static_cast<vpRansacEngine<LineModel>::vpRansacScoring>(s));
+          if (prosac == 1) {
+            ransac.setScores(data.scores);
+          }
+
+          // Time to reach the consensus, averaged on several seeds
+          const int nbRuns = 20;
+          unsigned int nbTrials = 0;
+          LineModel::Hypothesis line;
+          std::vector<unsigned int> inliers;
+          const double t = vpTime::measureTimeMs();
+          for (int run = 0; run < nbRuns; run++) {
+            ransac.setSeed(static_cast<uint64_t>(run));
+            ransac.estimate(line, inliers);
+            nbTrials += ransac.getNbTrials();
+          }
+          const double elapsed = (vpTime::measureTimeMs() - t) / nbRuns;
+
+          std::cout << std::setw(10) << samplings[prosac] << std::setw(12) << scorings[s] << std::setw(10)
+                    << nbThreads << std::setw(10) << nbTrials / nbRuns << std::setw(14)
+                    << static_cast<int>(1000.0 * nbTrials / nbRuns / elapsed) << std::setw(12) << elapsed
+                    << std::endl;
+        }
+      }
+    }
+
+    vpRansacEngine<LineModel> ransac(model);
+    ransac.setThreshold(0.005);
+    ransac.setMaxTrials(1000);
+    ransac.setProbability(0);
+    LineModel::Hypothesis line;
+    std::vector<unsigned int> inliers;
+
+    BENCHMARK("1000 trials, 20000 points, full scoring")
+    {
+      ransac.setScoring(vpRansacEngine<LineModel>::FULL_SCORING);
+      return ransac.estimate(line, inliers);
+    };
+
+    BENCHMARK("1000 trials, 20000 points, SPRT scoring")
+    {
+      ransac.setScoring(vpRansacEngine<LineModel>::SPRT_SCORING);
+      return ransac.estimate(line, inliers);
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(g_runBenchmark)  // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark?");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the runtime selection of the SIMD kernels.
+ *
+ *****************************************************************************/
+
+
+/*!
+  \example testSimdDispatch.cpp
+
+  Test the SIMD levels of vpCPUFeatures and the kernel selection of
+  vpSimdDispatcher.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <cstring>
+
+#include <visp3/core/vpSimdDispatch.h>
+
+namespace
+{
+int kernel_none() { return vpCPUFeatures::SIMD_NONE; }
+int kernel_sse2() { return vpCPUFeatures::SIMD_SSE2; }
+int kernel_avx2() { return vpCPUFeatures::SIMD_AVX2; }
+
+typedef int (*KernelFunc)();
+} // namespace
+
+TEST_CASE("SIMD levels", "[vpCPUFeatures]")
+{
+  const vpCPUFeatures::vpSimdLevel hardwareLevel = vpCPUFeatures::getHardwareSimdLevel();
+  const vpCPUFeatures::vpSimdLevel level = vpCPUFeatures::getSimdLevel();
+  CHECK(level <= hardwareLevel);
+  CHECK(vpCPUFeatures::checkSSE2() == (hardwareLevel >= vpCPUFeatures::SIMD_SSE2));
+  CHECK(std::strcmp(vpCPUFeatures::getSimdLevelName(vpCPUFeatures::SIMD_AVX2), "avx2") == 0);
+
+  vpCPUFeatures::setSimdLevel(vpCPUFeatures::SIMD_NONE);
+  CHECK(vpCPUFeatures::getSimdLevel() == vpCPUFeatures::SIMD_NONE);
+  CHECK(vpCPUFeatures::checkSimdLevel(vpCPUFeatures::SIMD_NONE));
+  CHECK_FALSE(vpCPUFeatures::checkSimdLevel(vpCPUFeatures::SIMD_SSE2));
+
+  // A level above the hardware one is clamped
+  vpCPUFeatures::setSimdLevel(vpCPUFeatures::SIMD_AVX512);
+  CHECK(vpCPUFeatures::getSimdLevel() == hardwareLevel);
+
+  vpCPUFeatures::setSimdLevel(level);
+}
+
+TEST_CASE("Kernel selection", "[vpSimdDispatcher]")
+{
+  const vpCPUFeatures::vpSimdLevel level = vpCPUFeatures::getSimdLevel();
+  const vpSimdDispatcher<KernelFunc> dispatcher = vpSimdDispatcher<KernelFunc>(kernel_none)
+                                                      .add(vpCPUFeatures::SIMD_SSE2, kernel_sse2)
+                                                      .add(vpCPUFeatures::SIMD_AVX2, kernel_avx2);
+
+  CHECK(dispatcher.getLevel(vpCPUFeatures::SIMD_NONE) == vpCPUFeatures::SIMD_NONE);
+  CHECK(dispatcher.getLevel(vpCPUFeatures::SIMD_SSE2) == vpCPUFeatures::SIMD_SSE2);
+  CHECK(dispatcher.getLevel(vpCPUFeatures::SIMD_AVX) == vpCPUFeatures::SIMD_SSE2);
+  CHECK(dispatcher.getLevel(vpCPUFeatures::SIMD_AVX512) == vpCPUFeatures::SIMD_AVX2);
+
+  for (int l = vpCPUFeatures::SIMD_NONE; l <= level; l++) {
+    vpCPUFeatures::setSimdLevel(static_cast<vpCPUFeatures::vpSimdLevel>(l));
+    CHECK(dispatcher.get()() == dispatcher.getLevel(static_cast<vpCPUFeatures::vpSimdLevel>(l)));
+  }
+  vpCPUFeatures::setSimdLevel(level);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
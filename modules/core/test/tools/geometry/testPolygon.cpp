@@ -47,6 +47,7 @@
 
 #include <math.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -180,6 +181,37 @@ int main(int argc, const char **argv)
     std::vector<vpImagePoint> vec3;
     vpPolygon p3(vec3);
 
+    // Check that the row spans match the ray casting point in polygon test
+    std::vector<vpPolygon> polygons;
+    polygons.push_back(p1);
+    polygons.push_back(p2);
+    polygons.push_back(p3);
+    std::vector<vpImagePoint> vec_subpixel;
+    vec_subpixel.push_back(vpImagePoint(-10.5, 320.25));
+    vec_subpixel.push_back(vpImagePoint(470.75, 650.5));
+    vec_subpixel.push_back(vpImagePoint(240.0, 320.0));
+    vec_subpixel.push_back(vpImagePoint(400.3, -20.7));
+    polygons.push_back(vpPolygon(vec_subpixel));
+    std::vector<std::pair<int, int> > spans;
+    for (size_t k = 0; k < polygons.size(); k++) {
+      for (int i = 0; i < (int)I.getHeight(); i++) {
+        polygons[k].getRowSpans(i, spans);
+        std::vector<bool> inside((size_t)I.getWidth(), false);
+        for (size_t s = 0; s < spans.size(); s++) {
+          for (int j = std::max(0, spans[s].first); j < std::min((int)I.getWidth(), spans[s].second); j++) {
+            inside[(size_t)j] = true;
+          }
+        }
+        for (int j = 0; j < (int)I.getWidth(); j++) {
+          if (inside[(size_t)j] != polygons[k].isInside(vpImagePoint(i, j), vpPolygon::PnPolyRayCasting)) {
+            std::cerr << "Polygon " << k + 1 << ": row spans and isInside() differ at (" << i << ", " << j << ")"
+                      << std::endl;
+            return 1;
+          }
+        }
+      }
+    }
+
 #if defined VISP_HAVE_X11
     vpDisplayX display;
 #elif defined VISP_HAVE_GTK
@@ -49,6 +49,7 @@
 
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpImage.h>
+#include <visp3/core/vpPointCloud.h>
 
 /*!
   \class vpRealSense2
@@ -297,6 +298,8 @@ public:
   void acquire(unsigned char *const data_image, unsigned char *const data_depth,
                std::vector<vpColVector> *const data_pointCloud, unsigned char *const data_infrared1,
                unsigned char *const data_infrared2, rs2::align *const align_to, double *ts=NULL);
+  void acquire(unsigned char *const data_image, unsigned char *const data_depth,
+               vpPointCloud<float> &pointcloud, rs2::align *const align_to = NULL, double *ts=NULL);
 #if (RS2_API_VERSION > ((2 * 10000) + (31 * 100) + 0))
   void acquire(vpImage<unsigned char> *left, vpImage<unsigned char> *right, double *ts = NULL);
   void acquire(vpImage<unsigned char> *left, vpImage<unsigned char> *right, vpHomogeneousMatrix *cMw,
@@ -393,6 +396,7 @@ protected:
   void getGreyFrame(const rs2::frame &frame, vpImage<unsigned char> &grey);
   void getNativeFrameData(const rs2::frame &frame, unsigned char *const data);
   void getPointcloud(const rs2::depth_frame &depth_frame, std::vector<vpColVector> &pointcloud);
+  void getPointcloud(const rs2::depth_frame &depth_frame, vpPointCloud<float> &pointcloud);
 #ifdef VISP_HAVE_PCL
   void getPointcloud(const rs2::depth_frame &depth_frame, pcl::PointCloud<pcl::PointXYZ>::Ptr &pointcloud);
   void getPointcloud(const rs2::depth_frame &depth_frame, const rs2::frame &color_frame,
@@ -231,6 +231,45 @@ void vpRealSense2::acquire(unsigned char *const data_image, unsigned char *const
   }
 }
 
+/*!
+  Acquire data from RealSense device, the point cloud being stored as contiguous X, Y, Z planes.
+  \param data_image : Color image buffer or NULL if not wanted.
+  \param data_depth : Depth image buffer or NULL if not wanted.
+  \param pointcloud : Organized point cloud. If it is a view with the size of the depth stream, the
+  coordinates are written in place in the viewed buffers, otherwise the point cloud is resized. No memory
+  is allocated once the point cloud has the right size.
+  \param align_to : Align to a reference stream or NULL if not wanted.
+  Only depth and color streams can be aligned.
+  \param ts : Data timestamp or NULL if not wanted.
+ */
+void vpRealSense2::acquire(unsigned char *const data_image, unsigned char *const data_depth,
+                           vpPointCloud<float> &pointcloud, rs2::align *const align_to, double *ts)
+{
+  auto data = m_pipe.wait_for_frames();
+  if (align_to != NULL) {
+#if (RS2_API_VERSION > ((2 * 10000) + (9 * 100) + 0))
+    data = align_to->process(data);
+#else
+    data = align_to->proccess(data);
+#endif
+  }
+
+  if (data_image != NULL) {
+    auto color_frame = data.get_color_frame();
+    getNativeFrameData(color_frame, data_image);
+  }
+
+  auto depth_frame = data.get_depth_frame();
+  if (data_depth != NULL) {
+    getNativeFrameData(depth_frame, data_depth);
+  }
+  getPointcloud(depth_frame, pointcloud);
+
+  if (ts != NULL) {
+    *ts = data.get_timestamp();
+  }
+}
+
 #if (RS2_API_VERSION > ((2 * 10000) + (31 * 100) + 0))
 /*!
   Acquire timestamped greyscale images from T265 RealSense device at 30Hz.
@@ -883,6 +922,57 @@ void vpRealSense2::getPointcloud(const rs2::depth_frame &depth_frame, std::vecto
 }
 
 
+void vpRealSense2::getPointcloud(const rs2::depth_frame &depth_frame, vpPointCloud<float> &pointcloud)
+{
+  if (m_depthScale <= std::numeric_limits<float>::epsilon()) {
+    std::stringstream ss;
+    ss << "Error, depth scale <= 0: " << m_depthScale;
+    throw vpException(vpException::fatalError, ss.str());
+  }
+
+  auto vf = depth_frame.as<rs2::video_frame>();
+  const int width = vf.get_width();
+  const int height = vf.get_height();
+  if (pointcloud.getWidth() != static_cast<unsigned int>(width) ||
+      pointcloud.getHeight() != static_cast<unsigned int>(height)) {
+    pointcloud.resize(static_cast<unsigned int>(height), static_cast<unsigned int>(width));
+  }
+  float *const X = pointcloud.getX();
+  float *const Y = pointcloud.getY();
+  float *const Z = pointcloud.getZ();
+
+  const uint16_t *p_depth_frame = reinterpret_cast<const uint16_t *>(depth_frame.get_data());
+  const rs2_intrinsics depth_intrinsics = depth_frame.get_profile().as<rs2::video_stream_profile>().get_intrinsics();
+
+  // Multi-threading if OpenMP
+  // Concurrent writes at different locations are safe
+  #pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < height; i++) {
+    auto depth_pixel_index = i * width;
+
+    for (int j = 0; j < width; j++, depth_pixel_index++) {
+      if (p_depth_frame[depth_pixel_index] == 0) {
+        X[depth_pixel_index] = Y[depth_pixel_index] = Z[depth_pixel_index] = m_invalidDepthValue;
+        continue;
+      }
+
+      // Get the depth value of the current pixel
+      auto pixels_distance = m_depthScale * p_depth_frame[depth_pixel_index];
+
+      float points[3];
+      const float pixel[] = {(float)j, (float)i};
+      rs2_deproject_pixel_to_point(points, &depth_intrinsics, pixel, pixels_distance);
+
+      if (pixels_distance > m_max_Z)
+        points[0] = points[1] = points[2] = m_invalidDepthValue;
+
+      X[depth_pixel_index] = points[0];
+      Y[depth_pixel_index] = points[1];
+      Z[depth_pixel_index] = points[2];
+    }
+  }
+}
+
 #ifdef VISP_HAVE_PCL
 void vpRealSense2::getPointcloud(const rs2::depth_frame &depth_frame, pcl::PointCloud<pcl::PointXYZ>::Ptr &pointcloud)
 {
@@ -0,0 +1,188 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Native KLT (Kanade-Lucas-Tomasi) feature tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpKltTracker.h
+
+  \brief Native KLT (Kanade-Lucas-Tomasi) feature tracker working on vpImage.
+*/
+
+#ifndef vpKltTracker_h
+#define vpKltTracker_h
+
+#include <vector>
+
+#include <visp3/core/vpColor.h>
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImagePoint.h>
+#include <visp3/core/vpImagePyramid.h>
+
+/*!
+  \class vpKltTracker
+
+  \ingroup module_klt
+
+  \brief KLT (Kanade-Lucas-Tomasi) feature tracker implemented on vpImage,
+  that does not require OpenCV.
+
+  The features are detected with the Shi-Tomasi minimal eigenvalue criterion
+  (or the Harris response, see setUseHarris()), then refined to sub-pixel
+  accuracy. They are tracked with the iterative pyramidal Lucas-Kanade method:
+  the images are interpolated with integer bilinear weights, the window sums
+  use the SIMD level of vpCPUFeatures, and the features are processed in
+  parallel when OpenMP is available.
+
+  The parameters and the behavior are the ones of vpKltOpencv, so that one
+  class can replace the other. The main difference is that the features are
+  given as vpImagePoint.
+
+  The pyramid of the current image can be built elsewhere and shared, for
+  instance with the one of the edge tracker, by calling track(const
+  vpImagePyramid &) instead of track(const vpImage<unsigned char> &). In that
+  case a vpImagePyramid::GAUSSIAN pyramid should be used.
+
+  \code
+#include <visp3/klt/vpKltTracker.h>
+
+void trackSequence(const std::vector<vpImage<unsigned char> > &sequence)
+{
+  vpKltTracker tracker;
+  tracker.setMaxFeatures(200);
+  tracker.setWindowSize(10);
+  tracker.setPyramidLevels(3);
+  tracker.initTracking(sequence[0]);
+
+  for (size_t k = 1; k < sequence.size(); k++) {
+    tracker.track(sequence[k]);
+    std::cout << tracker.getNbFeatures() << " features tracked" << std::endl;
+  }
+}
+  \endcode
+*/
+class VISP_EXPORT vpKltTracker
+{
+public:
+  vpKltTracker();
+
+  void addFeature(const float &x, const float &y);
+  void addFeature(const long &id, const float &x, const float &y);
+
+  void display(const vpImage<unsigned char> &I, const vpColor &color = vpColor::red, unsigned int thickness = 1);
+  void display(const vpImage<vpRGBa> &I, const vpColor &color = vpColor::red, unsigned int thickness = 1);
+
+  //! Get the size of the averaging block used to detect the features.
+  int getBlockSize() const { return m_blockSize; }
+  void getFeature(const int &index, long &id, float &x, float &y) const;
+  //! Get the list of current features.
+  const std::vector<vpImagePoint> &getFeatures() const { return m_points[1]; }
+  //! Get the unique id of each feature.
+  const std::vector<long> &getFeaturesId() const { return m_points_id; }
+  //! Get the free parameter of the Harris detector.
+  double getHarrisFreeParameter() const { return m_harris_k; }
+  //! Get the maximum number of features to track in the image.
+  int getMaxFeatures() const { return m_maxCount; }
+  //! Get the minimal Euclidean distance between detected corners during
+  //! initialization.
+  double getMinDistance() const { return m_minDistance; }
+  //! Get the minimal eigenvalue threshold used to reject a feature during the tracking.
+  double getMinEigThreshold() const { return m_minEigThreshold; }
+  //! Get the number of current features.
+  int getNbFeatures() const { return (int)m_points[1].size(); }
+  //! Get the number of previous features.
+  int getNbPrevFeatures() const { return (int)m_points[0].size(); }
+  //! Get the number of threads used to track the features, 0 for the OpenMP default.
+  unsigned int getNbThreads() const { return m_nbThreads; }
+  //! Get the list of previous features.
+  const std::vector<vpImagePoint> &getPrevFeatures() const { return m_points[0]; }
+  //! Get the maximal pyramid level.
+  int getPyramidLevels() const { return m_pyrMaxLevel; }
+  //! Get the parameter characterizing the minimal accepted quality of image
+  //! corners.
+  double getQuality() const { return m_qualityLevel; }
+  //! Get the window size used to track and refine the features.
+  int getWindowSize() const { return m_winSize; }
+
+  void initTracking(const vpImage<unsigned char> &I, const vpImage<bool> *mask = NULL);
+  void initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts);
+  void initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts,
+                    const std::vector<long> &ids);
+
+  void setBlockSize(int blockSize);
+  void setHarrisFreeParameter(double harris_k);
+  void setInitialGuess(const std::vector<vpImagePoint> &guess_pts);
+  void setInitialGuess(const std::vector<vpImagePoint> &init_pts, const std::vector<vpImagePoint> &guess_pts,
+                       const std::vector<long> &fid);
+  void setMaxFeatures(int maxCount);
+  void setMinDistance(double minDistance);
+  void setMinEigThreshold(double minEigThreshold);
+  void setNbThreads(unsigned int nbThreads);
+  void setPyramidLevels(int pyrMaxLevel);
+  void setQuality(double qualityLevel);
+  void setUseHarris(int useHarrisDetector);
+  void setWindowSize(int winSize);
+  void suppressFeature(const int &index);
+
+  void track(const vpImage<unsigned char> &I);
+  void track(const vpImagePyramid &pyramid);
+
+private:
+  void detectFeatures(const vpImage<unsigned char> &I, const vpImage<bool> *mask);
+  void refineFeatures(const vpImage<unsigned char> &I);
+  void setPreviousPyramid(const vpImagePyramid &pyramid);
+
+  //! Previous [0] and current [1] feature locations
+  std::vector<vpImagePoint> m_points[2];
+  //! Feature ids
+  std::vector<long> m_points_id;
+  int m_maxCount;
+  int m_winSize;
+  double m_qualityLevel;
+  double m_minDistance;
+  double m_minEigThreshold;
+  double m_harris_k;
+  int m_blockSize;
+  int m_useHarrisDetector;
+  int m_pyrMaxLevel;
+  long m_next_points_id;
+  bool m_initial_guess;
+  unsigned int m_nbThreads;
+  //! Pyramid of the current image when it is built by the tracker
+  vpImagePyramid m_pyramid;
+  //! Copy of the pyramid levels of the previous image
+  std::vector<vpImage<unsigned char> > m_prevLevels;
+};
+
+#endif
@@ -0,0 +1,1083 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Native KLT (Kanade-Lucas-Tomasi) feature tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpKltTracker.cpp
+
+  \brief Native KLT (Kanade-Lucas-Tomasi) feature tracker working on vpImage.
+*/
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include <visp3/core/vpDisplay.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpSimdDispatch.h>
+#include <visp3/core/vpTrackingException.h>
+#include <visp3/klt/vpKltTracker.h>
+
+#if defined _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Bilinear weights are integers summing to 2^weightBits. The interpolated
+// intensities keep intensityBits fractional bits, the derivatives are the ones
+// of the 3x3 Scharr operator, and the window sums are scaled by sumScale: the
+// eigenvalue threshold then has the same meaning as in OpenCV.
+const int weightBits = 14;
+const int intensityBits = 5;
+const int descaleBits = weightBits - intensityBits;
+const double sumScale = 1.0 / (1 << 20);
+const int maxIterations = 20;
+const double epsilon = 0.03;
+
+// Maximal window size, so that the SIMD partial sums of a window row fit in 32-bit integers
+const int maxWindowSize = 64;
+
+inline int reflect101(int x, int size)
+{
+  if (size == 1) {
+    return 0;
+  }
+  while (x < 0 || x >= size) {
+    x = x < 0 ? -x : 2 * size - 2 - x;
+  }
+  return x;
+}
+
+inline int clamp(int x, int size) { return x < 0 ? 0 : (x >= size ? size - 1 : x); }
+
+void bilinearWeights(double a, double b, int *w)
+{
+  const double one = static_cast<double>(1 << weightBits);
+  w[0] = vpMath::round((1. - a) * (1. - b) * one);
+  w[1] = vpMath::round(a * (1. - b) * one);
+  w[2] = vpMath::round((1. - a) * b * one);
+  w[3] = (1 << weightBits) - w[0] - w[1] - w[2];
+}
+
+// Copy the block [top, top + height) x [left, left + width) of I, replicating the border pixels
+void copyBlock(const vpImage<unsigned char> &I, int top, int left, int height, int width,
+               std::vector<unsigned char> &block)
+{
+  const int rows = static_cast<int>(I.getHeight()), cols = static_cast<int>(I.getWidth());
+  block.resize(static_cast<size_t>(height * width));
+  for (int y = 0; y < height; y++) {
+    const unsigned char *src = I[static_cast<unsigned int>(clamp(top + y, rows))];
+    unsigned char *dst = &block[static_cast<size_t>(y * width)];
+    if (left >= 0 && left + width <= cols) {
+      memcpy(dst, src + left, static_cast<size_t>(width));
+    } else {
+      for (int x = 0; x < width; x++) {
+        dst[x] = src[clamp(left + x, cols)];
+      }
+    }
+  }
+}
+
+// Sums over the window of (J - I) Ix and (J - I) Iy, where J is interpolated with the weights w. Ival, Ix and Iy
+// are stored with paddedWidth columns, J is read on winHeight + 1 rows and paddedWidth + 1 columns.
+typedef void (*LkSumsFunc)(const unsigned char *J, int stride, int winWidth, int winHeight, int paddedWidth,
+                           const int *w, const short *Ival, const short *Ix, const short *Iy, double &b1,
+                           double &b2);
+
+void lkSums_scalar(const unsigned char *J, int stride, int winWidth, int winHeight, int paddedWidth, const int *w,
+                   const short *Ival, const short *Ix, const short *Iy, double &b1, double &b2)
+{
+  const int round = 1 << (descaleBits - 1);
+  b1 = 0;
+  b2 = 0;
+  for (int y = 0; y < winHeight; y++) {
+    const unsigned char *J0 = J + y * stride;
+    const unsigned char *J1 = J0 + stride;
+    const short *iv = Ival + y * paddedWidth, *ix = Ix + y * paddedWidth, *iy = Iy + y * paddedWidth;
+    double s1 = 0, s2 = 0;
+    for (int x = 0; x < winWidth; x++) {
+      const int jval = (J0[x] * w[0] + J0[x + 1] * w[1] + J1[x] * w[2] + J1[x + 1] * w[3] + round) >> descaleBits;
+      const int diff = jval - iv[x];
+      s1 += diff * ix[x];
+      s2 += diff * iy[x];
+    }
+    b1 += s1;
+    b2 += s2;
+  }
+}
+
+#if VISP_HAVE_SIMD_DISPATCH
+// Interpolate 4 pixels of a row: the pairs (J[x], J[x+1]) are multiplied by (w0, w1) with madd
+VISP_SIMD_TARGET_SSE2 inline __m128i interpolateRow(__m128i row, __m128i rowNext, __m128i weights, bool high)
+{
+  return _mm_madd_epi16(high ? _mm_unpackhi_epi16(row, rowNext) : _mm_unpacklo_epi16(row, rowNext), weights);
+}
+
+VISP_SIMD_TARGET_SSE2 void lkSums_sse2(const unsigned char *J, int stride, int winWidth, int winHeight,
+                                       int paddedWidth, const int *w, const short *Ival, const short *Ix,
+                                       const short *Iy, double &b1, double &b2)
+{
+  (void)winWidth;
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i w01 = _mm_set1_epi32((w[1] << 16) | w[0]);
+  const __m128i w23 = _mm_set1_epi32((w[3] << 16) | w[2]);
+  const __m128i round = _mm_set1_epi32(1 << (descaleBits - 1));
+  int s[4];
+
+  b1 = 0;
+  b2 = 0;
+  for (int y = 0; y < winHeight; y++) {
+    const unsigned char *J0 = J + y * stride;
+    const unsigned char *J1 = J0 + stride;
+    const short *iv = Ival + y * paddedWidth, *ix = Ix + y * paddedWidth, *iy = Iy + y * paddedWidth;
+    __m128i s1 = zero, s2 = zero;
+    for (int x = 0; x < paddedWidth; x += 8) {
+      const __m128i r0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(J0 + x)), zero);
+      const __m128i r0n = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(J0 + x + 1)), zero);
+      const __m128i r1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(J1 + x)), zero);
+      const __m128i r1n = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(J1 + x + 1)), zero);
+
+      __m128i lo = _mm_add_epi32(interpolateRow(r0, r0n, w01, false), interpolateRow(r1, r1n, w23, false));
+      __m128i hi = _mm_add_epi32(interpolateRow(r0, r0n, w01, true), interpolateRow(r1, r1n, w23, true));
+      lo = _mm_srai_epi32(_mm_add_epi32(lo, round), descaleBits);
+      hi = _mm_srai_epi32(_mm_add_epi32(hi, round), descaleBits);
+
+      const __m128i diff = _mm_sub_epi16(_mm_packs_epi32(lo, hi), _mm_loadu_si128((const __m128i *)(iv + x)));
+      s1 = _mm_add_epi32(s1, _mm_madd_epi16(diff, _mm_loadu_si128((const __m128i *)(ix + x))));
+      s2 = _mm_add_epi32(s2, _mm_madd_epi16(diff, _mm_loadu_si128((const __m128i *)(iy + x))));
+    }
+    _mm_storeu_si128((__m128i *)s, s1);
+    b1 += (static_cast<double>(s[0]) + s[1]) + (static_cast<double>(s[2]) + s[3]);
+    _mm_storeu_si128((__m128i *)s, s2);
+    b2 += (static_cast<double>(s[0]) + s[1]) + (static_cast<double>(s[2]) + s[3]);
+  }
+}
+#endif
+
+const vpSimdDispatcher<LkSumsFunc> lkSums_dispatcher = vpSimdDispatcher<LkSumsFunc>(lkSums_scalar)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, lkSums_sse2)
+#endif
+    ;
+
+// Scratch buffers of one thread
+struct LkBuffers {
+  std::vector<unsigned char> block;
+  std::vector<int> interp;
+  std::vector<short> Ival, Ix, Iy;
+};
+
+struct LkParameters {
+  int winWidth, winHeight, paddedWidth;
+  double minEigThreshold;
+  bool useInitialFlow;
+  LkSumsFunc sums;
+};
+
+// Pyramidal Lucas-Kanade tracking of one feature, from prevPt in the previous
+// pyramid to nextPt in the current one. nextPt is the initial guess when
+// useInitialFlow is set. Return false when the feature is lost.
+bool trackFeature(const std::vector<const vpImage<unsigned char> *> &prevLevels,
+                  const std::vector<const vpImage<unsigned char> *> &nextLevels, const LkParameters &params,
+                  const vpImagePoint &prevPt, vpImagePoint &nextPt, LkBuffers &buf)
+{
+  const int winWidth = params.winWidth, winHeight = params.winHeight, paddedWidth = params.paddedWidth;
+  const double halfWinX = (winWidth - 1) * 0.5, halfWinY = (winHeight - 1) * 0.5;
+  const int maxLevel = static_cast<int>(prevLevels.size()) - 1;
+  const int round = 1 << (descaleBits - 1);
+  bool status = true;
+  double curX = 0, curY = 0;
+
+  buf.Ival.assign(static_cast<size_t>(winHeight * paddedWidth), 0);
+  buf.Ix.assign(buf.Ival.size(), 0);
+  buf.Iy.assign(buf.Ival.size(), 0);
+
+  for (int level = maxLevel; level >= 0; level--) {
+    const vpImage<unsigned char> &I = *prevLevels[static_cast<size_t>(level)];
+    const vpImage<unsigned char> &J = *nextLevels[static_cast<size_t>(level)];
+    const int rows = static_cast<int>(I.getHeight()), cols = static_cast<int>(I.getWidth());
+    const double levelScale = 1.0 / (1 << level);
+
+    if (level == maxLevel) {
+      const vpImagePoint &start = params.useInitialFlow ? nextPt : prevPt;
+      curX = start.get_j() * levelScale;
+      curY = start.get_i() * levelScale;
+    } else {
+      curX *= 2;
+      curY *= 2;
+    }
+
+    const double px = prevPt.get_j() * levelScale - halfWinX, py = prevPt.get_i() * levelScale - halfWinY;
+    const int ipx = static_cast<int>(std::floor(px)), ipy = static_cast<int>(std::floor(py));
+    if (ipx < -winWidth || ipx >= cols || ipy < -winHeight || ipy >= rows) {
+      if (level == 0) {
+        status = false;
+      }
+      continue;
+    }
+
+    // Interpolate the previous image on the window and its one pixel border, then compute the Scharr derivatives
+    int w[4];
+    bilinearWeights(px - ipx, py - ipy, w);
+    const int gridWidth = winWidth + 2, gridHeight = winHeight + 2;
+    copyBlock(I, ipy - 1, ipx - 1, gridHeight + 1, gridWidth + 1, buf.block);
+    buf.interp.resize(static_cast<size_t>(gridWidth * gridHeight));
+    for (int y = 0; y < gridHeight; y++) {
+      const unsigned char *b0 = &buf.block[static_cast<size_t>(y * (gridWidth + 1))];
+      const unsigned char *b1 = b0 + gridWidth + 1;
+      int *dst = &buf.interp[static_cast<size_t>(y * gridWidth)];
+      for (int x = 0; x < gridWidth; x++) {
+        dst[x] = (b0[x] * w[0] + b0[x + 1] * w[1] + b1[x] * w[2] + b1[x + 1] * w[3] + round) >> descaleBits;
+      }
+    }
+
+    double A11 = 0, A12 = 0, A22 = 0;
+    for (int y = 0; y < winHeight; y++) {
+      const int *g0 = &buf.interp[static_cast<size_t>(y * gridWidth)];
+      const int *g1 = g0 + gridWidth;
+      const int *g2 = g1 + gridWidth;
+      short *iv = &buf.Ival[static_cast<size_t>(y * paddedWidth)];
+      short *ix = &buf.Ix[static_cast<size_t>(y * paddedWidth)];
+      short *iy = &buf.Iy[static_cast<size_t>(y * paddedWidth)];
+      double a11 = 0, a12 = 0, a22 = 0;
+      for (int x = 0; x < winWidth; x++) {
+        const int gx = 3 * (g0[x + 2] - g0[x] + g2[x + 2] - g2[x]) + 10 * (g1[x + 2] - g1[x]);
+        const int gy = 3 * (g2[x] - g0[x] + g2[x + 2] - g0[x + 2]) + 10 * (g2[x + 1] - g0[x + 1]);
+        iv[x] = static_cast<short>(g1[x + 1]);
+        ix[x] = static_cast<short>((gx + (1 << (intensityBits - 1))) >> intensityBits);
+        iy[x] = static_cast<short>((gy + (1 << (intensityBits - 1))) >> intensityBits);
+        a11 += ix[x] * ix[x];
+        a12 += ix[x] * iy[x];
+        a22 += iy[x] * iy[x];
+      }
+      A11 += a11;
+      A12 += a12;
+      A22 += a22;
+    }
+    A11 *= sumScale;
+    A12 *= sumScale;
+    A22 *= sumScale;
+
+    double D = A11 * A22 - A12 * A12;
+    const double minEig =
+        (A22 + A11 - std::sqrt((A11 - A22) * (A11 - A22) + 4. * A12 * A12)) / (2 * winWidth * winHeight);
+    if (minEig < params.minEigThreshold || D < FLT_EPSILON) {
+      if (level == 0) {
+        status = false;
+      }
+      continue;
+    }
+    D = 1. / D;
+
+    // Gauss-Newton iterations on the current image
+    const int jRows = static_cast<int>(J.getHeight()), jCols = static_cast<int>(J.getWidth());
+    double nx = curX - halfWinX, ny = curY - halfWinY;
+    double prevDeltaX = 0, prevDeltaY = 0;
+    for (int iter = 0; iter < maxIterations; iter++) {
+      const int inx = static_cast<int>(std::floor(nx)), iny = static_cast<int>(std::floor(ny));
+      if (inx < -winWidth || inx >= jCols || iny < -winHeight || iny >= jRows) {
+        if (level == 0) {
+          status = false;
+        }
+        break;
+      }
+
+      bilinearWeights(nx - inx, ny - iny, w);
+      const unsigned char *Jptr = NULL;
+      int stride = 0;
+      if (inx >= 0 && iny >= 0 && inx + paddedWidth + 1 <= jCols && iny + winHeight + 1 <= jRows) {
+        Jptr = J[static_cast<unsigned int>(iny)] + inx;
+        stride = jCols;
+      } else {
+        copyBlock(J, iny, inx, winHeight + 1, paddedWidth + 1, buf.block);
+        Jptr = &buf.block[0];
+        stride = paddedWidth + 1;
+      }
+
+      double b1 = 0, b2 = 0;
+      params.sums(Jptr, stride, winWidth, winHeight, paddedWidth, w, &buf.Ival[0], &buf.Ix[0], &buf.Iy[0], b1, b2);
+      b1 *= sumScale;
+      b2 *= sumScale;
+
+      const double deltaX = (A12 * b2 - A22 * b1) * D;
+      const double deltaY = (A12 * b1 - A11 * b2) * D;
+      nx += deltaX;
+      ny += deltaY;
+      curX = nx + halfWinX;
+      curY = ny + halfWinY;
+
+      if (deltaX * deltaX + deltaY * deltaY <= epsilon * epsilon) {
+        break;
+      }
+      // Oscillation between two positions: keep the middle
+      if (iter > 0 && std::fabs(deltaX + prevDeltaX) < 0.01 && std::fabs(deltaY + prevDeltaY) < 0.01) {
+        curX -= deltaX * 0.5;
+        curY -= deltaY * 0.5;
+        break;
+      }
+      prevDeltaX = deltaX;
+      prevDeltaY = deltaY;
+    }
+  }
+
+  nextPt.set_ij(curY, curX);
+  return status;
+}
+
+struct Corner {
+  float response;
+  int index;
+  bool operator<(const Corner &other) const
+  {
+    // Decreasing response, then decreasing index as in OpenCV
+    return response > other.response || (response == other.response && index > other.index);
+  }
+};
+
+template <class Type>
+void displayFeatures(const vpImage<Type> &I, const std::vector<vpImagePoint> &features,
+                     const std::vector<long> &featuresid, const vpColor &color, unsigned int thickness)
+{
+  vpImagePoint ip;
+  for (size_t i = 0; i < features.size(); i++) {
+    ip.set_u(vpMath::round(features[i].get_u()));
+    ip.set_v(vpMath::round(features[i].get_v()));
+    vpDisplay::displayCross(I, ip, 10, color, thickness);
+
+    std::ostringstream id;
+    id << featuresid[i];
+    ip.set_u(vpMath::round(features[i].get_u() + 5));
+    vpDisplay::displayText(I, ip, id.str(), color);
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor. The default parameters are the ones of vpKltOpencv.
+*/
+vpKltTracker::vpKltTracker()
+  : m_points_id(), m_maxCount(500), m_winSize(10), m_qualityLevel(0.01), m_minDistance(15), m_minEigThreshold(1e-4),
+    m_harris_k(0.04), m_blockSize(3), m_useHarrisDetector(0), m_pyrMaxLevel(3), m_next_points_id(0),
+    m_initial_guess(false), m_nbThreads(0), m_pyramid(vpImagePyramid::GAUSSIAN), m_prevLevels()
+{
+}
+
+/*!
+  Add a feature at the end of the feature list. The id of the feature is set
+  to ensure that it is unique.
+
+  \param x,y : Coordinates of the feature in the image.
+*/
+void vpKltTracker::addFeature(const float &x, const float &y)
+{
+  m_points[1].push_back(vpImagePoint(y, x));
+  m_points_id.push_back(m_next_points_id++);
+}
+
+/*!
+  Add a feature at the end of the feature list.
+
+  \warning This function doesn't ensure that the id of the feature is unique.
+  You should rather use addFeature(const float &, const float &).
+
+  \param id : Feature id. Should be unique.
+  \param x,y : Coordinates of the feature in the image.
+*/
+void vpKltTracker::addFeature(const long &id, const float &x, const float &y)
+{
+  m_points[1].push_back(vpImagePoint(y, x));
+  m_points_id.push_back(id);
+  if (id >= m_next_points_id) {
+    m_next_points_id = id + 1;
+  }
+}
+
+/*!
+  Detect the Shi-Tomasi (or Harris) corners of an image, as
+  cv::goodFeaturesToTrack() does: the responses lower than getQuality() times
+  the best one are rejected, only the local maxima are kept, and the corners
+  are then selected by decreasing response, at least getMinDistance() apart.
+*/
+void vpKltTracker::detectFeatures(const vpImage<unsigned char> &I, const vpImage<bool> *mask)
+{
+  const int rows = static_cast<int>(I.getHeight()), cols = static_cast<int>(I.getWidth());
+  m_points[1].clear();
+  if (rows < 3 || cols < 3) {
+    return;
+  }
+
+  // Products of the Sobel derivatives, normalized as in cv::cornerMinEigenVal()
+  const float scale = 1.f / (4.f * m_blockSize * 255.f);
+  const size_t npixels = static_cast<size_t>(rows * cols);
+  std::vector<float> products(3 * npixels), sums(3 * npixels), response(npixels);
+  const int anchor = m_blockSize / 2;
+
+#if defined _OPENMP
+  if (m_nbThreads > 0) {
+    omp_set_num_threads(static_cast<int>(m_nbThreads));
+  }
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = 0; i < rows; i++) {
+    const unsigned char *r0 = I[static_cast<unsigned int>(reflect101(i - 1, rows))];
+    const unsigned char *r1 = I[static_cast<unsigned int>(i)];
+    const unsigned char *r2 = I[static_cast<unsigned int>(reflect101(i + 1, rows))];
+    float *p = &products[3 * static_cast<size_t>(i * cols)];
+    for (int j = 0; j < cols; j++, p += 3) {
+      const int jm = reflect101(j - 1, cols), jp = reflect101(j + 1, cols);
+      const float dx = scale * ((r0[jp] - r0[jm]) + 2 * (r1[jp] - r1[jm]) + (r2[jp] - r2[jm]));
+      const float dy = scale * ((r2[jm] - r0[jm]) + 2 * (r2[j] - r0[j]) + (r2[jp] - r0[jp]));
+      p[0] = dx * dx;
+      p[1] = dx * dy;
+      p[2] = dy * dy;
+    }
+  }
+
+  // Sums over blockSize x blockSize, first along the rows then along the columns
+#if defined _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      float s[3] = {0, 0, 0};
+      for (int k = -anchor; k < m_blockSize - anchor; k++) {
+        const float *p = &products[3 * static_cast<size_t>(i * cols + reflect101(j + k, cols))];
+        s[0] += p[0];
+        s[1] += p[1];
+        s[2] += p[2];
+      }
+      float *dst = &sums[3 * static_cast<size_t>(i * cols + j)];
+      dst[0] = s[0];
+      dst[1] = s[1];
+      dst[2] = s[2];
+    }
+  }
+
+#if defined _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      float s[3] = {0, 0, 0};
+      for (int k = -anchor; k < m_blockSize - anchor; k++) {
+        const float *p = &sums[3 * static_cast<size_t>(reflect101(i + k, rows) * cols + j)];
+        s[0] += p[0];
+        s[1] += p[1];
+        s[2] += p[2];
+      }
+      float &r = response[static_cast<size_t>(i * cols + j)];
+      if (m_useHarrisDetector) {
+        const float trace = s[0] + s[2];
+        r = s[0] * s[2] - s[1] * s[1] - static_cast<float>(m_harris_k) * trace * trace;
+      } else {
+        const float a = s[0] * 0.5f, b = s[1], c = s[2] * 0.5f;
+        r = (a + c) - std::sqrt((a - c) * (a - c) + b * b);
+      }
+    }
+  }
+
+  // Local maxima above the quality threshold
+  const float maxResponse = *std::max_element(response.begin(), response.end());
+  const float threshold = static_cast<float>(maxResponse * m_qualityLevel);
+  std::vector<Corner> corners;
+  for (int i = 1; i < rows - 1; i++) {
+    for (int j = 1; j < cols - 1; j++) {
+      const float r = response[static_cast<size_t>(i * cols + j)];
+      if (r <= threshold || r <= 0 || (mask != NULL && !(*mask)[i][j])) {
+        continue;
+      }
+      bool isMax = true;
+      for (int di = -1; di <= 1 && isMax; di++) {
+        for (int dj = -1; dj <= 1 && isMax; dj++) {
+          isMax = response[static_cast<size_t>((i + di) * cols + j + dj)] <= r;
+        }
+      }
+      if (isMax) {
+        Corner corner;
+        corner.response = r;
+        corner.index = i * cols + j;
+        corners.push_back(corner);
+      }
+    }
+  }
+  std::sort(corners.begin(), corners.end());
+
+  // Selection of the strongest corners at least minDistance apart, using a grid of cells of minDistance size
+  const size_t maxCount = m_maxCount > 0 ? static_cast<size_t>(m_maxCount) : corners.size();
+  const int cellSize = (std::max)(1, vpMath::round(m_minDistance));
+  const int gridWidth = (cols + cellSize - 1) / cellSize, gridHeight = (rows + cellSize - 1) / cellSize;
+  std::vector<std::vector<vpImagePoint> > grid(static_cast<size_t>(gridWidth * gridHeight));
+  const double minDistance2 = m_minDistance * m_minDistance;
+
+  for (size_t k = 0; k < corners.size() && m_points[1].size() < maxCount; k++) {
+    const int i = corners[k].index / cols, j = corners[k].index % cols;
+    const int ci = i / cellSize, cj = j / cellSize;
+    bool good = true;
+    if (m_minDistance >= 1) {
+      for (int gi = (std::max)(ci - 1, 0); gi <= (std::min)(ci + 1, gridHeight - 1) && good; gi++) {
+        for (int gj = (std::max)(cj - 1, 0); gj <= (std::min)(cj + 1, gridWidth - 1) && good; gj++) {
+          const std::vector<vpImagePoint> &cell = grid[static_cast<size_t>(gi * gridWidth + gj)];
+          for (size_t m = 0; m < cell.size() && good; m++) {
+            const double di = cell[m].get_i() - i, dj = cell[m].get_j() - j;
+            good = di * di + dj * dj >= minDistance2;
+          }
+        }
+      }
+    }
+    if (good) {
+      grid[static_cast<size_t>(ci * gridWidth + cj)].push_back(vpImagePoint(i, j));
+      m_points[1].push_back(vpImagePoint(i, j));
+    }
+  }
+}
+
+/*!
+  Refine the detected corners to sub-pixel accuracy, as cv::cornerSubPix()
+  does with a (2 getWindowSize() + 1) square window.
+*/
+void vpKltTracker::refineFeatures(const vpImage<unsigned char> &I)
+{
+  const int win = m_winSize;
+  const int size = 2 * win + 1;
+  std::vector<double> weights(static_cast<size_t>(size * size));
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      const double y = static_cast<double>(i - win) / win, x = static_cast<double>(j - win) / win;
+      weights[static_cast<size_t>(i * size + j)] = std::exp(-y * y) * std::exp(-x * x);
+    }
+  }
+
+  const int nbPoints = static_cast<int>(m_points[1].size());
+  const double rows = I.getHeight(), cols = I.getWidth();
+#if defined _OPENMP
+  if (m_nbThreads > 0) {
+    omp_set_num_threads(static_cast<int>(m_nbThreads));
+  }
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int k = 0; k < nbPoints; k++) {
+    const vpImagePoint start = m_points[1][static_cast<size_t>(k)];
+    double cy = start.get_i(), cx = start.get_j();
+    std::vector<double> patch(static_cast<size_t>((size + 2) * (size + 2)));
+    std::vector<unsigned char> block;
+
+    for (int iter = 0; iter < maxIterations; iter++) {
+      // All the samples share the same bilinear weights
+      const int ix = static_cast<int>(std::floor(cx)), iy = static_cast<int>(std::floor(cy));
+      const double ax = cx - ix, ay = cy - iy;
+      const double w00 = (1. - ax) * (1. - ay), w01 = ax * (1. - ay), w10 = (1. - ax) * ay, w11 = ax * ay;
+      copyBlock(I, iy - win - 1, ix - win - 1, size + 3, size + 3, block);
+      for (int i = 0; i < size + 2; i++) {
+        const unsigned char *b0 = &block[static_cast<size_t>(i * (size + 3))];
+        const unsigned char *b1 = b0 + size + 3;
+        double *dst = &patch[static_cast<size_t>(i * (size + 2))];
+        for (int j = 0; j < size + 2; j++) {
+          dst[j] = w00 * b0[j] + w01 * b0[j + 1] + w10 * b1[j] + w11 * b1[j + 1];
+        }
+      }
+
+      double a = 0, b = 0, c = 0, bb1 = 0, bb2 = 0;
+      for (int i = 0; i < size; i++) {
+        const double *p = &patch[static_cast<size_t>((i + 1) * (size + 2) + 1)];
+        const double py = i - win;
+        for (int j = 0; j < size; j++) {
+          const double m = weights[static_cast<size_t>(i * size + j)];
+          const double tgx = p[j + 1] - p[j - 1];
+          const double tgy = p[j + size + 2] - p[j - size - 2];
+          const double gxx = tgx * tgx * m, gxy = tgx * tgy * m, gyy = tgy * tgy * m;
+          const double px = j - win;
+          a += gxx;
+          b += gxy;
+          c += gyy;
+          bb1 += gxx * px + gxy * py;
+          bb2 += gxy * px + gyy * py;
+        }
+      }
+
+      const double det = a * c - b * b;
+      if (std::fabs(det) <= DBL_EPSILON * DBL_EPSILON) {
+        break;
+      }
+      const double ny = cy - b / det * bb1 + a / det * bb2;
+      const double nx = cx + c / det * bb1 - b / det * bb2;
+      const double err = (nx - cx) * (nx - cx) + (ny - cy) * (ny - cy);
+      cx = nx;
+      cy = ny;
+      if (cx < 0 || cx >= cols || cy < 0 || cy >= rows || err <= epsilon * epsilon) {
+        break;
+      }
+    }
+
+    // Reject the refinement if the corner moved out of the window
+    if (std::fabs(cx - start.get_j()) > win || std::fabs(cy - start.get_i()) > win) {
+      cx = start.get_j();
+      cy = start.get_i();
+    }
+    m_points[1][static_cast<size_t>(k)].set_ij(cy, cx);
+  }
+}
+
+/*!
+  Display features position and id.
+
+  \param I : Image used as background. Display should be initialized on it.
+  \param color : Color used to display the features.
+  \param thickness : Thickness of the drawings.
+*/
+void vpKltTracker::display(const vpImage<unsigned char> &I, const vpColor &color, unsigned int thickness)
+{
+  displayFeatures(I, m_points[1], m_points_id, color, thickness);
+}
+
+/*!
+  Display features position and id.
+
+  \param I : Image used as background. Display should be initialized on it.
+  \param color : Color used to display the features.
+  \param thickness : Thickness of the drawings.
+*/
+void vpKltTracker::display(const vpImage<vpRGBa> &I, const vpColor &color, unsigned int thickness)
+{
+  displayFeatures(I, m_points[1], m_points_id, color, thickness);
+}
+
+/*!
+  Get the 'index'th feature image coordinates. Beware that getFeature(i,...)
+  may not represent the same feature before and after a tracking iteration (if
+  a feature is lost, features are shifted in the array).
+
+  \param index : Index of feature.
+  \param id : id of the feature.
+  \param x : x coordinate.
+  \param y : y coordinate.
+*/
+void vpKltTracker::getFeature(const int &index, long &id, float &x, float &y) const
+{
+  if (index < 0 || (size_t)index >= m_points[1].size()) {
+    throw(vpException(vpException::badValue, "Feature [%d] doesn't exist", index));
+  }
+
+  x = static_cast<float>(m_points[1][(size_t)index].get_j());
+  y = static_cast<float>(m_points[1][(size_t)index].get_i());
+  id = m_points_id[(size_t)index];
+}
+
+/*!
+  Initialise the tracking by detecting features on the provided image.
+
+  \param I : Grey level image.
+  \param mask : Image mask used to restrict the feature detection area: only
+  the pixels set to true are considered. If NULL, all the image is considered.
+
+  \exception vpException::dimensionError : If the mask and the image do not
+  have the same size.
+*/
+void vpKltTracker::initTracking(const vpImage<unsigned char> &I, const vpImage<bool> *mask)
+{
+  if (mask != NULL && (mask->getHeight() != I.getHeight() || mask->getWidth() != I.getWidth())) {
+    throw(vpException(vpException::dimensionError, "The mask (%dx%d) and the image (%dx%d) do not have the same size",
+                      mask->getWidth(), mask->getHeight(), I.getWidth(), I.getHeight()));
+  }
+
+  m_next_points_id = 0;
+  m_initial_guess = false;
+  m_points[0].clear();
+  m_points_id.clear();
+
+  detectFeatures(I, mask);
+  if (!m_points[1].empty()) {
+    refineFeatures(I);
+  }
+  for (size_t i = 0; i < m_points[1].size(); i++) {
+    m_points_id.push_back(m_next_points_id++);
+  }
+
+  m_pyramid.build(I, static_cast<unsigned int>(m_pyrMaxLevel + 1));
+  setPreviousPyramid(m_pyramid);
+}
+
+/*!
+  Set the points that will be tracked from the provided image during the next
+  call to track().
+
+  \param I : Input image.
+  \param pts : Vector of points that should be tracked.
+*/
+void vpKltTracker::initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts)
+{
+  initTracking(I, pts, std::vector<long>());
+}
+
+/*!
+  Set the points that will be tracked from the provided image during the next
+  call to track().
+
+  \param I : Input image.
+  \param pts : Vector of points that should be tracked.
+  \param ids : Identifiers of the points. If the size of this vector differs
+  from the one of \e pts, the points are numbered from 0.
+*/
+void vpKltTracker::initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts,
+                                const std::vector<long> &ids)
+{
+  m_initial_guess = false;
+  m_points[0].clear();
+  m_points[1] = pts;
+  m_points_id.clear();
+
+  if (ids.size() != pts.size()) {
+    m_next_points_id = 0;
+    for (size_t i = 0; i < m_points[1].size(); i++) {
+      m_points_id.push_back(m_next_points_id++);
+    }
+  } else {
+    long max = 0;
+    for (size_t i = 0; i < m_points[1].size(); i++) {
+      m_points_id.push_back(ids[i]);
+      if (ids[i] > max) {
+        max = ids[i];
+      }
+    }
+    m_next_points_id = max + 1;
+  }
+
+  m_pyramid.build(I, static_cast<unsigned int>(m_pyrMaxLevel + 1));
+  setPreviousPyramid(m_pyramid);
+}
+
+/*!
+  Set the size of the averaging block used to detect the features.
+
+  \param blockSize : Size of an average block for computing a derivative
+  covariation matrix over each pixel neighborhood. Default value is set to 3.
+*/
+void vpKltTracker::setBlockSize(int blockSize)
+{
+  if (blockSize < 1) {
+    throw(vpException(vpException::badValue, "Bad block size %d", blockSize));
+  }
+  m_blockSize = blockSize;
+}
+
+/*!
+  Set the free parameter of the Harris detector.
+
+  \param harris_k : Free parameter of the Harris detector. Default value is
+  set to 0.04.
+*/
+void vpKltTracker::setHarrisFreeParameter(double harris_k) { m_harris_k = harris_k; }
+
+/*!
+  Set the points that will be used as initial guess during the next call to
+  track(). A typical usage of this function is to predict the position of the
+  features before the next call to track().
+
+  \param guess_pts : Vector of points that should be tracked. The size of this
+  vector should be the same as the one returned by getFeatures(). If this is
+  not the case, an exception is returned. Note also that the id of the points
+  is not modified.
+*/
+void vpKltTracker::setInitialGuess(const std::vector<vpImagePoint> &guess_pts)
+{
+  if (guess_pts.size() != m_points[1].size()) {
+    throw(vpException(vpException::badValue,
+                      "Cannot set initial guess: size feature vector [%d] "
+                      "and guess vector [%d] doesn't match",
+                      m_points[1].size(), guess_pts.size()));
+  }
+
+  m_points[0] = m_points[1];
+  m_points[1] = guess_pts;
+  m_initial_guess = true;
+}
+
+/*!
+  Set the points that will be used as initial guess during the next call to
+  track().
+
+  \param init_pts : Initial points (could be obtained from getPrevFeatures()
+  or getFeatures()).
+  \param guess_pts : Prediction of the new position of the initial points.
+  The size of this vector must be the same as the size of the vector of
+  initial points.
+  \param fid : Identifiers of the initial points.
+*/
+void vpKltTracker::setInitialGuess(const std::vector<vpImagePoint> &init_pts,
+                                   const std::vector<vpImagePoint> &guess_pts, const std::vector<long> &fid)
+{
+  if (guess_pts.size() != init_pts.size() || fid.size() != init_pts.size()) {
+    throw(vpException(vpException::badValue,
+                      "Cannot set initial guess: size init vector [%d], "
+                      "guess vector [%d] and id vector [%d] don't match",
+                      init_pts.size(), guess_pts.size(), fid.size()));
+  }
+
+  m_points[0] = init_pts;
+  m_points[1] = guess_pts;
+  m_points_id = fid;
+  m_initial_guess = true;
+}
+
+/*!
+  Set the maximum number of features to detect in the image.
+
+  \param maxCount : Maximum number of features to detect and track. Default
+  value is set to 500.
+*/
+void vpKltTracker::setMaxFeatures(int maxCount) { m_maxCount = maxCount; }
+
+/*!
+  Set the minimal Euclidean distance between detected corners during
+  initialization.
+
+  \param minDistance : Minimal possible Euclidean distance between the
+  detected corners. Default value is set to 15.
+*/
+void vpKltTracker::setMinDistance(double minDistance) { m_minDistance = minDistance; }
+
+/*!
+  Set the minimal eigenvalue threshold used to reject a feature during the
+  tracking.
+
+  \param minEigThreshold : Minimal eigenvalue threshold. Default value is set
+  to 1e-4.
+*/
+void vpKltTracker::setMinEigThreshold(double minEigThreshold) { m_minEigThreshold = minEigThreshold; }
+
+/*!
+  Set the number of threads used to detect and track the features.
+
+  \param nbThreads : Number of threads. If 0 is used, the number of threads is
+  the default one of OpenMP.
+*/
+void vpKltTracker::setNbThreads(unsigned int nbThreads) { m_nbThreads = nbThreads; }
+
+/*!
+  Set the maximal pyramid level. If the level is zero, then no pyramid is
+  computed for the optical flow.
+
+  \param pyrMaxLevel : 0-based maximal pyramid level number; if set to 0,
+  pyramids are not used (single level), if set to 1, two levels are used, and
+  so on. Default value is set to 3.
+*/
+void vpKltTracker::setPyramidLevels(int pyrMaxLevel)
+{
+  if (pyrMaxLevel < 0) {
+    throw(vpException(vpException::badValue, "Bad pyramid level %d", pyrMaxLevel));
+  }
+  m_pyrMaxLevel = pyrMaxLevel;
+}
+
+/*!
+  Set the parameter characterizing the minimal accepted quality of image
+  corners.
+
+  \param qualityLevel : Quality level parameter. Default value is set to 0.01.
+  The parameter value is multiplied by the best corner quality measure, which
+  is the minimal eigenvalue or the Harris function response. The corners with
+  the quality measure less than the product are rejected.
+*/
+void vpKltTracker::setQuality(double qualityLevel) { m_qualityLevel = qualityLevel; }
+
+/*!
+  Set the parameter indicating whether to use a Harris detector or the
+  minimal eigenvalue of gradient matrices for corner detection.
+
+  \param useHarrisDetector : If 0 (default value), use the minimal eigenvalue
+  as cv::goodFeaturesToTrack() called by vpKltOpencv. Otherwise use the Harris
+  detector.
+*/
+void vpKltTracker::setUseHarris(int useHarrisDetector) { m_useHarrisDetector = useHarrisDetector; }
+
+/*!
+  Set the window size used to track the features and to refine their
+  location at detection.
+
+  \param winSize : Size of the square tracking window, and half of the side
+  length of the refinement window. Default value is set to 10. It must be in
+  [3, 64].
+*/
+void vpKltTracker::setWindowSize(int winSize)
+{
+  if (winSize < 3 || winSize > maxWindowSize) {
+    throw(vpException(vpException::badValue, "Window size %d is not in [3, %d]", winSize, maxWindowSize));
+  }
+  m_winSize = winSize;
+}
+
+/*!
+  Copy the levels of a pyramid, used as previous image by the next call to
+  track().
+*/
+void vpKltTracker::setPreviousPyramid(const vpImagePyramid &pyramid)
+{
+  const unsigned int nbLevels = (std::min)(pyramid.getNbLevels(), static_cast<unsigned int>(m_pyrMaxLevel + 1));
+  m_prevLevels.resize(nbLevels);
+  for (unsigned int i = 0; i < nbLevels; i++) {
+    const vpImage<unsigned char> &level = pyramid[i];
+    if (m_prevLevels[i].getHeight() != level.getHeight() || m_prevLevels[i].getWidth() != level.getWidth()) {
+      m_prevLevels[i].resize(level.getHeight(), level.getWidth());
+    }
+    if (level.getSize() > 0) {
+      memcpy(m_prevLevels[i].bitmap, level.bitmap, level.getSize());
+    }
+  }
+}
+
+/*!
+  Remove the feature with the given index as parameter.
+
+  \param index : Index of the feature to remove.
+*/
+void vpKltTracker::suppressFeature(const int &index)
+{
+  if (index < 0 || (size_t)index >= m_points[1].size()) {
+    throw(vpException(vpException::badValue, "Feature [%d] doesn't exist", index));
+  }
+
+  m_points[1].erase(m_points[1].begin() + index);
+  m_points_id.erase(m_points_id.begin() + index);
+}
+
+/*!
+  Track the features in a new image using the iterative Lucas-Kanade method
+  with pyramids. The lost features are removed.
+
+  \param I : Input image.
+*/
+void vpKltTracker::track(const vpImage<unsigned char> &I)
+{
+  m_pyramid.build(I, static_cast<unsigned int>(m_pyrMaxLevel + 1));
+  track(m_pyramid);
+}
+
+/*!
+  Track the features in a new image whose pyramid has already been built,
+  for instance by another tracker. Only the first getPyramidLevels() + 1
+  levels are used. The lost features are removed.
+
+  \param pyramid : Pyramid of the new image, whose level 0 is the image itself. To
+  track as track(const vpImage<unsigned char> &) does, it should be built
+  with the vpImagePyramid::GAUSSIAN filter.
+
+  \exception vpTrackingException::fatalError : If there is no feature to
+  track.
+  \exception vpException::dimensionError : If the image size differs from the
+  previous one.
+*/
+void vpKltTracker::track(const vpImagePyramid &pyramid)
+{
+  if (m_points[1].empty()) {
+    throw vpTrackingException(vpTrackingException::fatalError, "Not enough key points to track.");
+  }
+  if (pyramid.getNbLevels() == 0) {
+    throw(vpException(vpException::dimensionError, "Cannot track features in an empty pyramid"));
+  }
+
+  const bool useInitialFlow = m_initial_guess;
+  if (m_initial_guess) {
+    m_initial_guess = false;
+  } else {
+    std::swap(m_points[1], m_points[0]);
+  }
+
+  if (m_prevLevels.empty()) {
+    setPreviousPyramid(pyramid);
+  }
+  if (m_prevLevels[0].getHeight() != pyramid[0].getHeight() || m_prevLevels[0].getWidth() != pyramid[0].getWidth()) {
+    throw(vpException(vpException::dimensionError, "Image size %dx%d differs from the previous one %dx%d",
+                      pyramid[0].getWidth(), pyramid[0].getHeight(), m_prevLevels[0].getWidth(),
+                      m_prevLevels[0].getHeight()));
+  }
+
+  const size_t nbLevels = (std::min)(static_cast<size_t>(pyramid.getNbLevels()), m_prevLevels.size());
+  std::vector<const vpImage<unsigned char> *> prevLevels(nbLevels), nextLevels(nbLevels);
+  for (size_t i = 0; i < nbLevels; i++) {
+    prevLevels[i] = &m_prevLevels[i];
+    nextLevels[i] = &pyramid[static_cast<unsigned int>(i)];
+  }
+
+  LkParameters params;
+  params.winWidth = m_winSize;
+  params.winHeight = m_winSize;
+  params.paddedWidth = (m_winSize + 7) / 8 * 8;
+  params.minEigThreshold = m_minEigThreshold;
+  params.useInitialFlow = useInitialFlow;
+  params.sums = lkSums_dispatcher.get();
+
+  const int nbPoints = static_cast<int>(m_points[0].size());
+  m_points[1].resize(m_points[0].size());
+  std::vector<unsigned char> status(m_points[0].size(), 1);
+
+#if defined _OPENMP
+  if (m_nbThreads > 0) {
+    omp_set_num_threads(static_cast<int>(m_nbThreads));
+  }
+#pragma omp parallel
+#endif
+  {
+    LkBuffers buffers;
+#if defined _OPENMP
+#pragma omp for schedule(dynamic, 8)
+#endif
+    for (int k = 0; k < nbPoints; k++) {
+      status[static_cast<size_t>(k)] = trackFeature(prevLevels, nextLevels, params, m_points[0][static_cast<size_t>(k)],
+                                                    m_points[1][static_cast<size_t>(k)], buffers)
+                                           ? 1
+                                           : 0;
+    }
+  }
+
+  // Remove the lost features
+  size_t nbTracked = 0;
+  for (size_t k = 0; k < status.size(); k++) {
+    if (status[k]) {
+      m_points[0][nbTracked] = m_points[0][k];
+      m_points[1][nbTracked] = m_points[1][k];
+      m_points_id[nbTracked] = m_points_id[k];
+      nbTracked++;
+    }
+  }
+  m_points[0].resize(nbTracked);
+  m_points[1].resize(nbTracked);
+  m_points_id.resize(nbTracked);
+
+  setPreviousPyramid(pyramid);
+}
@@ -0,0 +1,215 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compare the native KLT tracker with cv::calcOpticalFlowPyrLK().
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfKltTracker.cpp
+
+  Compare the accuracy of vpKltTracker and cv::calcOpticalFlowPyrLK() on
+  synthetic images translated by a known motion. With --benchmark, compare
+  also their computation times.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_OPENCV) &&          \
+    (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <iostream>
+
+#include <opencv2/video/tracking.hpp>
+
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/klt/vpKltTracker.h>
+
+namespace
+{
+static bool g_runBenchmark = false;
+
+// Same parameters for both trackers: the ones of vpKltOpencv
+const int g_winSize = 10;
+const int g_pyrMaxLevel = 3;
+
+// Smooth texture with blob-like corners, translated by (tx, ty)
+vpImage<unsigned char> createTexture(unsigned int height, unsigned int width, double tx, double ty)
+{
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      const double x = j - tx, y = i - ty;
+      const double v = 128 + 70 * std::sin(x / 6.0) * std::cos(y / 7.0) + 30 * std::sin((x + 2 * y) / 13.0);
+      I[i][j] = static_cast<unsigned char>(vpMath::round(v));
+    }
+  }
+  return I;
+}
+
+bool isInside(double u, double v, unsigned int height, unsigned int width)
+{
+  const double border = 2 * g_winSize;
+  return u >= border && v >= border && u < width - border && v < height - border;
+}
+
+// Mean error of the tracked points with respect to the translation of the initial points, for the points
+// tracked by both methods and whose window stays in the image
+void computeErrors(const std::vector<cv::Point2f> &first, const std::vector<vpImagePoint> &visp,
+                   const std::vector<long> &vispIds, const std::vector<cv::Point2f> &opencv,
+                   const std::vector<uchar> &status, double tx, double ty, unsigned int height, unsigned int width,
+                   double &vispError, double &opencvError, unsigned int &nbPoints)
+{
+  vispError = opencvError = 0;
+  nbPoints = 0;
+  for (size_t k = 0; k < visp.size(); k++) {
+    const size_t idx = static_cast<size_t>(vispIds[k]);
+    const double u = visp[k].get_j(), v = visp[k].get_i();
+    if (!status[idx] || !isInside(first[idx].x, first[idx].y, height, width) || !isInside(u, v, height, width)) {
+      continue;
+    }
+    vispError += std::sqrt(vpMath::sqr(u - first[idx].x - tx) + vpMath::sqr(v - first[idx].y - ty));
+    opencvError +=
+        std::sqrt(vpMath::sqr(opencv[idx].x - first[idx].x - tx) + vpMath::sqr(opencv[idx].y - first[idx].y - ty));
+    nbPoints++;
+  }
+  if (nbPoints > 0) {
+    vispError /= nbPoints;
+    opencvError /= nbPoints;
+  }
+}
+} // namespace
+
+TEST_CASE("vpKltTracker vs cv::calcOpticalFlowPyrLK", "[vpKltTracker]")
+{
+  const unsigned int height = 480, width = 640;
+  const vpImage<unsigned char> I0 = createTexture(height, width, 0, 0);
+  cv::Mat cvI0;
+  vpImageConvert::convert(I0, cvI0);
+
+  // Both trackers start from the features detected by vpKltTracker
+  vpKltTracker tracker;
+  tracker.setMaxFeatures(300);
+  tracker.setWindowSize(g_winSize);
+  tracker.setPyramidLevels(g_pyrMaxLevel);
+  tracker.initTracking(I0);
+  const std::vector<vpImagePoint> features = tracker.getFeatures();
+  const std::vector<long> ids = tracker.getFeaturesId();
+  REQUIRE(features.size() > 100);
+
+  std::vector<cv::Point2f> first(features.size());
+  for (size_t k = 0; k < features.size(); k++) {
+    first[k] = cv::Point2f(static_cast<float>(features[k].get_j()), static_cast<float>(features[k].get_i()));
+  }
+  const cv::TermCriteria termcrit(cv::TermCriteria::COUNT | cv::TermCriteria::EPS, 20, 0.03);
+
+  const double motions[][2] = {{0.4, -0.7}, {3.2, 2.1}, {9.3, 6.6}, {-14.5, 11.2}};
+  for (size_t m = 0; m < sizeof(motions) / sizeof(motions[0]); m++) {
+    const double tx = motions[m][0], ty = motions[m][1];
+    const vpImage<unsigned char> I1 = createTexture(height, width, tx, ty);
+    cv::Mat cvI1;
+    vpImageConvert::convert(I1, cvI1);
+
+    tracker.initTracking(I0, features, ids);
+    tracker.track(I1);
+
+    std::vector<cv::Point2f> tracked;
+    std::vector<uchar> status;
+    std::vector<float> err;
+    cv::calcOpticalFlowPyrLK(cvI0, cvI1, first, tracked, status, err, cv::Size(g_winSize, g_winSize), g_pyrMaxLevel,
+                             termcrit, 0, 1e-4);
+
+    double vispError = 0, opencvError = 0;
+    unsigned int nbPoints = 0;
+    computeErrors(first, tracker.getFeatures(), tracker.getFeaturesId(), tracked, status, tx, ty, height, width,
+                  vispError, opencvError, nbPoints);
+    std::cout << "Motion (" << tx << ", " << ty << "): " << nbPoints << " points, mean error vpKltTracker "
+              << vispError << " px, cv::calcOpticalFlowPyrLK " << opencvError << " px" << std::endl;
+
+    // The integer interpolation of vpKltTracker costs at most a few hundredths of pixel
+    CHECK(nbPoints > features.size() / 2);
+    CHECK(vispError < opencvError + 0.02);
+  }
+
+  if (g_runBenchmark) {
+    const vpImage<unsigned char> I1 = createTexture(height, width, 3.2, 2.1);
+    cv::Mat cvI1;
+    vpImageConvert::convert(I1, cvI1);
+
+    BENCHMARK("vpKltTracker::track()")
+    {
+      tracker.initTracking(I0, features, ids);
+      tracker.track(I1);
+      return tracker.getNbFeatures();
+    };
+
+    BENCHMARK("cv::calcOpticalFlowPyrLK()")
+    {
+      std::vector<cv::Point2f> tracked;
+      std::vector<uchar> status;
+      std::vector<float> err;
+      cv::calcOpticalFlowPyrLK(cvI0, cvI1, first, tracked, status, err, cv::Size(g_winSize, g_winSize),
+                               g_pyrMaxLevel, termcrit, 0, 1e-4);
+      return tracked.size();
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(g_runBenchmark)  // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark?");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
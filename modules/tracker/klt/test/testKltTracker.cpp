@@ -0,0 +1,307 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the native KLT tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testKltTracker.cpp
+
+  Test the detection and the tracking of vpKltTracker on synthetic images
+  translated by a known motion.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpTrackingException.h>
+#include <visp3/klt/vpKltTracker.h>
+
+namespace
+{
+// Smooth texture with blob-like corners, translated by (tx, ty)
+vpImage<unsigned char> createTexture(unsigned int height, unsigned int width, double tx, double ty)
+{
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      const double x = j - tx, y = i - ty;
+      const double v = 128 + 70 * std::sin(x / 6.0) * std::cos(y / 7.0) + 30 * std::sin((x + 2 * y) / 13.0);
+      I[i][j] = static_cast<unsigned char>(vpMath::round(v));
+    }
+  }
+  return I;
+}
+
+// Checkerboard of squares of 16 pixels, whose corners are at (16 k - 0.5, 16 l - 0.5)
+vpImage<unsigned char> createCheckerboard(unsigned int height, unsigned int width)
+{
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      I[i][j] = ((i / 16 + j / 16) % 2) ? 200 : 50;
+    }
+  }
+  return I;
+}
+
+// Maximal error of the tracked features with respect to the translation of the first ones. The features
+// whose window crosses the image border are not considered.
+double maxError(const vpKltTracker &tracker, const std::vector<vpImagePoint> &first,
+                const std::vector<long> &firstIds, double tx, double ty)
+{
+  double error = 0;
+  for (size_t k = 0; k < tracker.getFeatures().size(); k++) {
+    const size_t idx = static_cast<size_t>(tracker.getFeaturesId()[k] - firstIds[0]);
+    const vpImagePoint &p = tracker.getFeatures()[k];
+    const vpImagePoint &q = first[idx];
+    if ((std::min)(p.get_i(), q.get_i()) < 15 || (std::max)(p.get_i(), q.get_i()) > 225 ||
+        (std::min)(p.get_j(), q.get_j()) < 15 || (std::max)(p.get_j(), q.get_j()) > 305) {
+      continue;
+    }
+    error = (std::max)(error, std::fabs(p.get_j() - q.get_j() - tx));
+    error = (std::max)(error, std::fabs(p.get_i() - q.get_i() - ty));
+  }
+  return error;
+}
+} // namespace
+
+TEST_CASE("Detection", "[vpKltTracker]")
+{
+  const vpImage<unsigned char> I = createCheckerboard(240, 320);
+  vpKltTracker tracker;
+  tracker.setMaxFeatures(100);
+  tracker.setMinDistance(12);
+  tracker.setWindowSize(5);
+  tracker.initTracking(I);
+
+  // The features are refined on the checkerboard corners
+  const std::vector<vpImagePoint> &features = tracker.getFeatures();
+  CHECK(features.size() == 100);
+  for (size_t k = 0; k < features.size(); k++) {
+    CHECK(tracker.getFeaturesId()[k] == static_cast<long>(k));
+    CHECK(std::fabs(features[k].get_i() + 0.5 - 16 * vpMath::round((features[k].get_i() + 0.5) / 16)) < 0.1);
+    CHECK(std::fabs(features[k].get_j() + 0.5 - 16 * vpMath::round((features[k].get_j() + 0.5) / 16)) < 0.1);
+    for (size_t m = k + 1; m < features.size(); m++) {
+      CHECK(vpImagePoint::distance(features[k], features[m]) > 12);
+    }
+  }
+
+  SECTION("Mask")
+  {
+    vpImage<bool> mask(I.getHeight(), I.getWidth(), false);
+    for (unsigned int i = 60; i < 180; i++) {
+      for (unsigned int j = 80; j < 240; j++) {
+        mask[i][j] = true;
+      }
+    }
+    tracker.initTracking(I, &mask);
+    CHECK(tracker.getNbFeatures() > 0);
+    CHECK(tracker.getNbFeatures() < 100);
+    for (size_t k = 0; k < tracker.getFeatures().size(); k++) {
+      const vpImagePoint &p = tracker.getFeatures()[k];
+      CHECK(p.get_i() > 59);
+      CHECK(p.get_i() < 180);
+      CHECK(p.get_j() > 79);
+      CHECK(p.get_j() < 240);
+    }
+
+    vpImage<bool> wrongMask(10, 10, true);
+    CHECK_THROWS_AS(tracker.initTracking(I, &wrongMask), vpException);
+  }
+
+  SECTION("Harris")
+  {
+    tracker.setUseHarris(1);
+    tracker.initTracking(I);
+    CHECK(tracker.getNbFeatures() == 100);
+  }
+}
+
+TEST_CASE("Tracking", "[vpKltTracker]")
+{
+  const vpImage<unsigned char> I0 = createTexture(240, 320, 0, 0);
+  vpKltTracker tracker;
+  tracker.setMaxFeatures(100);
+  tracker.initTracking(I0);
+  const std::vector<vpImagePoint> first = tracker.getFeatures();
+  const std::vector<long> firstIds = tracker.getFeaturesId();
+  REQUIRE(first.size() > 30);
+
+  SECTION("Sub-pixel motion")
+  {
+    const vpImage<unsigned char> I1 = createTexture(240, 320, 0.4, -0.7);
+    tracker.track(I1);
+    CHECK(tracker.getNbFeatures() > static_cast<int>(first.size() * 9 / 10));
+    CHECK(tracker.getPrevFeatures().size() == tracker.getFeatures().size());
+    CHECK(maxError(tracker, first, firstIds, 0.4, -0.7) < 0.05);
+  }
+
+  SECTION("Large motion with the pyramid")
+  {
+    const vpImage<unsigned char> I1 = createTexture(240, 320, 9.3, 6.6);
+    tracker.track(I1);
+    CHECK(tracker.getNbFeatures() > static_cast<int>(first.size() * 3 / 4));
+    CHECK(maxError(tracker, first, firstIds, 9.3, 6.6) < 0.1);
+  }
+
+  SECTION("Sequence and shared pyramid")
+  {
+    vpImagePyramid pyramid(vpImagePyramid::GAUSSIAN);
+    for (int k = 1; k <= 5; k++) {
+      const vpImage<unsigned char> I = createTexture(240, 320, 1.5 * k, -k);
+      pyramid.build(I, 4);
+      tracker.track(pyramid);
+    }
+    CHECK(maxError(tracker, first, firstIds, 7.5, -5) < 0.1);
+  }
+
+  SECTION("Initial guess")
+  {
+    const vpImage<unsigned char> I1 = createTexture(240, 320, 25, 0);
+    std::vector<vpImagePoint> guess = first;
+    for (size_t k = 0; k < guess.size(); k++) {
+      guess[k].set_j(guess[k].get_j() + 24);
+    }
+    tracker.setPyramidLevels(0);
+    tracker.initTracking(I0, first, firstIds);
+    tracker.setInitialGuess(guess);
+    tracker.track(I1);
+    CHECK(tracker.getNbFeatures() > static_cast<int>(first.size() / 2));
+    CHECK(maxError(tracker, first, firstIds, 25, 0) < 0.05);
+  }
+
+  SECTION("Lost features")
+  {
+    // The first feature leaves the image
+    const vpImage<unsigned char> I1 = createTexture(240, 320, -20, 0);
+    std::vector<vpImagePoint> guess = first;
+    for (size_t k = 0; k < guess.size(); k++) {
+      guess[k].set_j(guess[k].get_j() - 20);
+    }
+    guess[0].set_j(-20);
+    tracker.setInitialGuess(guess);
+    tracker.track(I1);
+    CHECK(tracker.getNbFeatures() < static_cast<int>(first.size()));
+    CHECK(tracker.getFeaturesId()[0] != firstIds[0]);
+    CHECK(tracker.getFeatures().size() == tracker.getFeaturesId().size());
+
+    const vpImage<unsigned char> I2(240, 320, 128);
+    tracker.initTracking(I2);
+    CHECK(tracker.getNbFeatures() == 0);
+    CHECK_THROWS_AS(tracker.track(I2), vpTrackingException);
+  }
+
+  SECTION("Image size")
+  {
+    const vpImage<unsigned char> I1 = createTexture(120, 160, 0, 0);
+    CHECK_THROWS_AS(tracker.track(I1), vpException);
+  }
+}
+
+TEST_CASE("Threads and SIMD levels", "[vpKltTracker]")
+{
+  const vpImage<unsigned char> I0 = createTexture(240, 320, 0, 0);
+  const vpImage<unsigned char> I1 = createTexture(240, 320, 3.2, 2.1);
+
+  vpKltTracker tracker;
+  tracker.setNbThreads(1);
+  tracker.initTracking(I0);
+  tracker.track(I1);
+  const std::vector<vpImagePoint> reference = tracker.getFeatures();
+
+  tracker.setNbThreads(4);
+  tracker.initTracking(I0);
+  tracker.track(I1);
+  REQUIRE(tracker.getFeatures().size() == reference.size());
+  for (size_t k = 0; k < reference.size(); k++) {
+    CHECK(tracker.getFeatures()[k] == reference[k]);
+  }
+
+  // The integer window sums are the same for all the SIMD levels
+  const vpCPUFeatures::vpSimdLevel level = vpCPUFeatures::getSimdLevel();
+  vpCPUFeatures::setSimdLevel(vpCPUFeatures::SIMD_NONE);
+  tracker.initTracking(I0);
+  tracker.track(I1);
+  vpCPUFeatures::setSimdLevel(level);
+  REQUIRE(tracker.getFeatures().size() == reference.size());
+  for (size_t k = 0; k < reference.size(); k++) {
+    CHECK(tracker.getFeatures()[k] == reference[k]);
+  }
+}
+
+TEST_CASE("Parameters", "[vpKltTracker]")
+{
+  vpKltTracker tracker;
+  CHECK(tracker.getMaxFeatures() == 500);
+  CHECK(tracker.getWindowSize() == 10);
+  CHECK(tracker.getPyramidLevels() == 3);
+  CHECK_THROWS_AS(tracker.setWindowSize(2), vpException);
+  CHECK_THROWS_AS(tracker.setWindowSize(65), vpException);
+  CHECK_THROWS_AS(tracker.setPyramidLevels(-1), vpException);
+
+  tracker.addFeature(10.f, 20.f);
+  tracker.addFeature(7, 30.f, 40.f);
+  tracker.addFeature(50.f, 60.f);
+  REQUIRE(tracker.getNbFeatures() == 3);
+  CHECK(tracker.getFeaturesId()[2] == 8);
+  tracker.suppressFeature(0);
+  long id = 0;
+  float x = 0, y = 0;
+  tracker.getFeature(0, id, x, y);
+  CHECK(id == 7);
+  CHECK(x == 30.f);
+  CHECK(y == 40.f);
+  CHECK_THROWS_AS(tracker.suppressFeature(5), vpException);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
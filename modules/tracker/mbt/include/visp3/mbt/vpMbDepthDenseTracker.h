@@ -117,6 +117,8 @@ public:
   virtual void track(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud);
 #endif
   virtual void track(const std::vector<vpColVector> &point_cloud, unsigned int width, unsigned int height);
+  virtual void track(const vpPointCloud<float> &point_cloud);
+  virtual void track(const vpImage<uint16_t> &depth, double depthScale);
 
 protected:
   //! Set of faces describing the object used only for display with scan line.
@@ -141,6 +143,14 @@ protected:
   vpColVector m_w_depthDense;
   //! Weighted error
   vpColVector m_weightedError_depthDense;
+  //! Normalized coordinates (x, y) of each pixel of the depth image
+  std::vector<float> m_depthDenseRays;
+  //! Camera parameters used to compute the normalized coordinates of the depth image pixels
+  vpCameraParameters m_depthDenseRaysCam;
+  //! Height of the depth image whose pixel normalized coordinates are stored
+  unsigned int m_depthDenseRaysHeight;
+  //! Width of the depth image whose pixel normalized coordinates are stored
+  unsigned int m_depthDenseRaysWidth;
 #if DEBUG_DISPLAY_DEPTH_DENSE
   vpDisplay *m_debugDisp_depthDense;
   vpImage<unsigned char> m_debugImage_depthDense;
@@ -148,6 +158,8 @@ protected:
 
   void addFace(vpMbtPolygon &polygon, bool alreadyClose);
 
+  void computeDepthDenseRays(unsigned int width, unsigned int height);
+
   void computeVisibility(unsigned int width, unsigned int height);
 
   void computeVVS();
@@ -156,6 +168,10 @@ protected:
   virtual void computeVVSWeights();
   using vpMbTracker::computeVVSWeights;
 
+  void computeVVSNormalEquations(const vpColVector &w, vpMatrix &LTL, vpColVector &LTR, unsigned int nbThreads = 1);
+  void computeVVSResidu();
+  void computeVVSResiduInit();
+
   virtual void initCircle(const vpPoint &p1, const vpPoint &p2, const vpPoint &p3, double radius,
                           int idFace = 0, const std::string &name = "");
 
@@ -171,5 +187,9 @@ protected:
 #endif
   void segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
                          unsigned int height);
+  void segmentPointCloud(const vpPointCloud<float> &point_cloud);
+  void segmentPointCloud(const vpMbtDepthImagePointCloud &point_cloud);
+  template <class PointCloud>
+  void segmentPointCloudImpl(const PointCloud &point_cloud, unsigned int width, unsigned int height);
 };
 #endif
@@ -120,6 +120,7 @@ public:
   virtual void track(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud);
 #endif
   virtual void track(const std::vector<vpColVector> &point_cloud, unsigned int width, unsigned int height);
+  virtual void track(const vpPointCloud<float> &point_cloud);
 
 protected:
   //! Method to estimate the desired features
@@ -186,5 +187,8 @@ protected:
 #endif
   void segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
                          unsigned int height);
+  void segmentPointCloud(const vpPointCloud<float> &point_cloud);
+  template <class PointCloud>
+  void segmentPointCloudImpl(const PointCloud &point_cloud, unsigned int width, unsigned int height);
 };
 #endif
@@ -47,13 +47,17 @@
 
 #include <visp3/core/vpConfig.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 #include <visp3/core/vpExponentialMap.h>
 #include <visp3/core/vpPoseVector.h>
 #include <visp3/core/vpSubColVector.h>
 #include <visp3/core/vpSubMatrix.h>
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
 #include <visp3/klt/vpKltOpencv.h>
+#else
+#include <visp3/klt/vpKltTracker.h>
+#endif
 #include <visp3/mbt/vpMbEdgeTracker.h>
 #include <visp3/mbt/vpMbKltTracker.h>
 #include <visp3/mbt/vpMbTracker.h>
@@ -63,7 +67,8 @@
   \ingroup group_mbt_trackers
   \warning This class is deprecated for user usage. You should rather use the high level
   vpMbGenericTracker class.
-  \warning This class is only available if OpenCV is installed, and used.
+  \note The keypoints are tracked with vpKltOpencv when OpenCV is available,
+  and with the native vpKltTracker otherwise.
 
   \brief Hybrid tracker based on moving-edges and keypoints tracked using KLT
   tracker.
@@ -88,7 +93,7 @@
 
 int main()
 {
-#if defined VISP_HAVE_OPENCV
+#if defined VISP_HAVE_MODULE_KLT
   vpMbEdgeKltTracker tracker; // Create an hybrid model based tracker.
   vpImage<unsigned char> I;
   vpHomogeneousMatrix cMo; // Pose computed using the tracker.
@@ -139,7 +144,7 @@ computed using another method:
 
 int main()
 {
-#if defined VISP_HAVE_OPENCV
+#if defined VISP_HAVE_MODULE_KLT
   vpMbEdgeKltTracker tracker; // Create an hybrid model based tracker.
   vpImage<unsigned char> I;
   vpHomogeneousMatrix cMo; // Pose used in entry (has to be defined), then computed using the tracker.
@@ -176,7 +181,7 @@ a given pose:
 
 int main()
 {
-#if defined VISP_HAVE_OPENCV
+#if defined VISP_HAVE_MODULE_KLT
   vpMbEdgeKltTracker tracker; // Create an hybrid model based tracker.
   vpImage<unsigned char> I;
   vpHomogeneousMatrix cMo; // Pose used to display the model.
@@ -354,4 +359,4 @@ protected:
 
 #endif
 
-#endif // VISP_HAVE_OPENCV
+#endif // VISP_HAVE_MODULE_KLT
@@ -46,6 +46,7 @@
 #ifndef vpMbEdgeTracker_HH
 #define vpMbEdgeTracker_HH
 
+#include <visp3/core/vpImagePyramid.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtDistanceCircle.h>
@@ -290,6 +291,9 @@ protected:
   //! Pyramid of image associated to the current image. This pyramid is
   //! computed in the init() and in the track() methods.
   std::vector<const vpImage<unsigned char> *> Ipyramid;
+  //! Storage of the pyramid levels, kept from one frame to the next to avoid
+  //! reallocating them at each call to track().
+  vpImagePyramid m_pyramid;
 
   //! Current scale level used. This attribute must not be modified outside of
   //! the downScale() and upScale() methods, as it used to specify to some
@@ -322,6 +326,8 @@ protected:
   vpRobust m_robust_edge;
   //! Display features
   std::vector<std::vector<double> > m_featuresToBeDisplayedEdge;
+  //! Number of threads used to track the moving-edges sites
+  unsigned int m_meNbThreads;
 
 public:
   vpMbEdgeTracker();
@@ -358,6 +364,13 @@ public:
   */
   virtual inline vpMe getMovingEdge() const { return this->me; }
 
+  /*!
+    Return the number of threads used to track the moving-edges sites.
+
+    \sa setMovingEdgeNbThreads()
+  */
+  inline unsigned int getMovingEdgeNbThreads() const { return m_meNbThreads; }
+
   virtual unsigned int getNbPoints(unsigned int level = 0) const;
 
   /*!
@@ -366,6 +379,21 @@ public:
     \return The scales levels used for the tracking.
   */
   std::vector<bool> getScales() const { return scales; }
+
+  /*!
+    Return the filter used to compute the image pyramid.
+
+    \sa setPyramidFilterType()
+  */
+  vpImagePyramid::vpPyramidFilterType getPyramidFilterType() const { return m_pyramid.getFilterType(); }
+  /*!
+    Return the pyramid of the last image processed by the tracker. With the
+    vpImagePyramid::GAUSSIAN filter, it can be passed to
+    vpKltTracker::track(const vpImagePyramid &) to avoid building it twice.
+
+    \sa setPyramidFilterType()
+  */
+  const vpImagePyramid &getPyramid() const { return m_pyramid; }
   /*!
      \return The threshold value between 0 and 1 over good moving edges ratio.
      It allows to decide if the tracker has enough valid moving edges to
@@ -472,9 +500,40 @@ public:
 
   void setMovingEdge(const vpMe &me);
 
+  /*!
+    Set the number of threads used to track the moving-edges sites. The
+    sites of all the lines, cylinders and circles of a scale level are
+    tracked at once with vpMeTracker::trackBatch() and distributed over the
+    threads. The tracking result does not depend on the number of threads.
+
+    \param nbThreads : Number of threads. By default, 1 is used meaning that
+    the sites are tracked sequentially. If 0 is passed, OpenMP will choose
+    the number of threads.
+
+    \note This option has an effect only when ViSP is built with OpenMP.
+
+    \sa getMovingEdgeNbThreads()
+  */
+  void setMovingEdgeNbThreads(unsigned int nbThreads) { m_meNbThreads = nbThreads; }
+
   virtual void setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cdMo);
   virtual void setPose(const vpImage<vpRGBa> &I_color, const vpHomogeneousMatrix &cdMo);
 
+  /*!
+    Set the filter used to compute the image pyramid when several scales are
+    used. The default vpImagePyramid::SUBSAMPLING keeps one pixel out of two,
+    while vpImagePyramid::BOX and vpImagePyramid::GAUSSIAN smooth the image
+    before subsampling.
+
+    \param filterType : Filter used to compute a level from the previous one.
+
+    \sa setScales()
+  */
+  void setPyramidFilterType(const vpImagePyramid::vpPyramidFilterType &filterType)
+  {
+    m_pyramid.setFilterType(filterType);
+  }
+
   void setScales(const std::vector<bool> &_scales);
 
   void setUseEdgeTracking(const std::string &name, const bool &useEdgeTracking);
@@ -82,7 +82,7 @@ class VISP_EXPORT vpMbGenericTracker : public vpMbTracker
 public:
   enum vpTrackerType {
     EDGE_TRACKER = 1 << 0, /*!< Model-based tracking using moving edges features. */
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
     KLT_TRACKER = 1 << 1, /*!< Model-based tracking using KLT features. */
 #endif
     DEPTH_NORMAL_TRACKER = 1 << 2, /*!< Model-based tracking using depth normal features. */
@@ -141,7 +141,7 @@ public:
   virtual vpMbHiddenFaces<vpMbtPolygon> &getFaces();
   virtual vpMbHiddenFaces<vpMbtPolygon> &getFaces(const std::string &cameraName);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   virtual std::list<vpMbtDistanceCircle *> &getFeaturesCircle();
   virtual std::list<vpMbtDistanceKltCylinder *> &getFeaturesKltCylinder();
   virtual std::list<vpMbtDistanceKltPoints *> &getFeaturesKlt();
@@ -152,18 +152,24 @@ public:
 
   virtual double getGoodMovingEdgesRatioThreshold() const;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   virtual std::vector<vpImagePoint> getKltImagePoints() const;
   virtual std::map<int, vpImagePoint> getKltImagePointsWithId() const;
 
   virtual unsigned int getKltMaskBorder() const;
   virtual int getKltNbPoints() const;
 
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   virtual vpKltOpencv getKltOpencv() const;
   virtual void getKltOpencv(vpKltOpencv &klt1, vpKltOpencv &klt2) const;
   virtual void getKltOpencv(std::map<std::string, vpKltOpencv> &mapOfKlts) const;
+#else
+  virtual vpKltTracker getKltTracker() const;
+  virtual void getKltTracker(vpKltTracker &klt1, vpKltTracker &klt2) const;
+  virtual void getKltTracker(std::map<std::string, vpKltTracker> &mapOfKlts) const;
+#endif
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   virtual std::vector<cv::Point2f> getKltPoints() const;
 #endif
 
@@ -220,6 +226,13 @@ public:
   virtual unsigned int getNbPolygon() const;
   virtual void getNbPolygon(std::map<std::string, unsigned int> &mapOfNbPolygons) const;
 
+  /*!
+   * Return the number of threads used to process the cameras in parallel.
+   *
+   * \sa setNbThreads()
+   */
+  virtual inline unsigned int getNbThreads() const { return m_nbThreads; }
+
   virtual vpMbtPolygon *getPolygon(unsigned int index);
   virtual vpMbtPolygon *getPolygon(const std::string &cameraName, unsigned int index);
 
@@ -239,6 +252,13 @@ public:
 
   virtual inline vpColVector getRobustWeights() const { return m_w; }
 
+  /*!
+   * Return true if the pose is estimated from normal equations accumulated feature type by feature type.
+   *
+   * \sa setStreamNormalEquations()
+   */
+  virtual inline bool getStreamNormalEquations() const { return m_streamNormalEquations; }
+
   virtual int getTrackerType() const;
 
   virtual void init(const vpImage<unsigned char> &I);
@@ -381,14 +401,20 @@ public:
   virtual void setNbRayCastingAttemptsForVisibility(const unsigned int &attempts);
 #endif
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   virtual void setKltMaskBorder(const unsigned int &e);
   virtual void setKltMaskBorder(const unsigned int &e1, const unsigned int &e2);
   virtual void setKltMaskBorder(const std::map<std::string, unsigned int> &mapOfErosions);
 
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   virtual void setKltOpencv(const vpKltOpencv &t);
   virtual void setKltOpencv(const vpKltOpencv &t1, const vpKltOpencv &t2);
   virtual void setKltOpencv(const std::map<std::string, vpKltOpencv> &mapOfKlts);
+#else
+  virtual void setKltTracker(const vpKltTracker &t);
+  virtual void setKltTracker(const vpKltTracker &t1, const vpKltTracker &t2);
+  virtual void setKltTracker(const std::map<std::string, vpKltTracker> &mapOfKlts);
+#endif
 
   virtual void setKltThresholdAcceptation(double th);
 
@@ -405,6 +431,8 @@ public:
   virtual void setMovingEdge(const vpMe &me1, const vpMe &me2);
   virtual void setMovingEdge(const std::map<std::string, vpMe> &mapOfMe);
 
+  virtual void setNbThreads(unsigned int nbThreads);
+
   virtual void setNearClippingDistance(const double &dist);
   virtual void setNearClippingDistance(const double &dist1, const double &dist2);
   virtual void setNearClippingDistance(const std::map<std::string, double> &mapOfDists);
@@ -437,13 +465,29 @@ public:
 
   virtual void setScanLineVisibilityTest(const bool &v);
 
+  /*!
+   * Estimate the pose from the 6x6 normal equations \f$ \mathbf{L}^T \mathbf{W} \mathbf{L} \f$ and
+   * \f$ \mathbf{L}^T \mathbf{W} \mathbf{e} \f$, accumulated feature type by feature type, instead of
+   * stacking the interaction matrices of all the features of all the cameras. The dense depth faces are
+   * accumulated without building any interaction matrix, which saves the memory traffic of the
+   * N x 6 matrices when there are many depth points.
+   *
+   * The covariance matrix requires the full interaction matrix: when setCovarianceComputation() is
+   * turned on, the stacked formulation is used whatever this setting.
+   *
+   * \param stream : If true, the normal equations are accumulated. False by default.
+   *
+   * \sa getStreamNormalEquations()
+   */
+  virtual inline void setStreamNormalEquations(bool stream) { m_streamNormalEquations = stream; }
+
   virtual void setTrackerType(int type);
   virtual void setTrackerType(const std::map<std::string, int> &mapOfTrackerTypes);
 
   virtual void setUseDepthDenseTracking(const std::string &name, const bool &useDepthDenseTracking);
   virtual void setUseDepthNormalTracking(const std::string &name, const bool &useDepthNormalTracking);
   virtual void setUseEdgeTracking(const std::string &name, const bool &useEdgeTracking);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   virtual void setUseKltTracking(const std::string &name, const bool &useKltTracking);
 #endif
 
@@ -473,6 +517,10 @@ public:
                      std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
                      std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                      std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+  virtual void track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                     std::map<std::string, const vpPointCloud<float> *> &mapOfPointClouds);
+  virtual void track(std::map<std::string, const vpImage<vpRGBa> *> &mapOfColorImages,
+                     std::map<std::string, const vpPointCloud<float> *> &mapOfPointClouds);
 
 protected:
   virtual void computeProjectionError();
@@ -487,6 +535,10 @@ protected:
   using vpMbTracker::computeVVSWeights;
   virtual void computeVVSWeights();
 
+  void computeVVSNormalEquations(std::map<std::string, vpVelocityTwistMatrix> &mapOfVelocityTwist, bool weighted,
+                                 vpMatrix &LTL, vpColVector &LTR, double &num, double &den);
+  void computeVVSResidu(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages);
+
   virtual void initCircle(const vpPoint &p1, const vpPoint &p2, const vpPoint &p3, double radius,
                           int idFace = 0, const std::string &name = "");
 
@@ -505,10 +557,12 @@ protected:
                            std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
                            std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                            std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+  virtual void preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                           std::map<std::string, const vpPointCloud<float> *> &mapOfPointClouds);
 
 private:
   class TrackerWrapper : public vpMbEdgeTracker,
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                          public vpMbKltTracker,
 #endif
                          public vpMbDepthNormalTracker,
@@ -609,6 +663,13 @@ private:
     using vpMbTracker::computeVVSWeights;
     virtual void computeVVSWeights();
 
+    void computeVVSInitImpl(const vpImage<unsigned char> *const ptr_I, bool interactionMatrix);
+    void computeVVSNormalEquations(const std::map<vpTrackerType, double> &mapOfFeatureFactors, bool weighted,
+                                   vpMatrix &LTL, vpColVector &LTR, double &num, double &den,
+                                   unsigned int nbThreads);
+    void computeVVSResidu(const vpImage<unsigned char> *const ptr_I);
+    void computeVVSResiduInit(const vpImage<unsigned char> *const ptr_I);
+
     virtual void initCircle(const vpPoint &p1, const vpPoint &p2, const vpPoint &p3, double radius,
                             int idFace = 0, const std::string &name = "");
 
@@ -631,6 +692,8 @@ private:
     virtual void preTracking(const vpImage<unsigned char> *const ptr_I = NULL,
                              const std::vector<vpColVector> *const point_cloud = NULL,
                              const unsigned int pointcloud_width = 0, const unsigned int pointcloud_height = 0);
+    virtual void preTracking(const vpImage<unsigned char> *const ptr_I,
+                             const vpPointCloud<float> *const point_cloud);
 
     virtual void reInitModel(const vpImage<unsigned char> * const I, const vpImage<vpRGBa> * const I_color,
                              const std::string &cad_name, const vpHomogeneousMatrix &cMo, bool verbose = false,
@@ -682,6 +745,10 @@ protected:
   unsigned int m_nb_feat_depthNormal;
   //! Number of depth dense features
   unsigned int m_nb_feat_depthDense;
+  //! Number of threads used to process the cameras in parallel (1 for sequential processing)
+  unsigned int m_nbThreads;
+  //! If true, the pose is estimated from the accumulated normal equations
+  bool m_streamNormalEquations;
 
 };
 #endif
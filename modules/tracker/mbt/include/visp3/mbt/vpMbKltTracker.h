@@ -46,14 +46,18 @@
 
 #include <visp3/core/vpConfig.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 #include <visp3/core/vpExponentialMap.h>
 #include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpSubColVector.h>
 #include <visp3/core/vpSubMatrix.h>
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
 #include <visp3/klt/vpKltOpencv.h>
+#else
+#include <visp3/klt/vpKltTracker.h>
+#endif
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtDistanceCircle.h>
 #include <visp3/mbt/vpMbtDistanceKltCylinder.h>
@@ -65,7 +69,8 @@
   \ingroup group_mbt_trackers
   \warning This class is deprecated for user usage. You should rather use the high level
   vpMbGenericTracker class.
-  \warning This class is only available if OpenCV is installed, and used.
+  \note The points are tracked with vpKltOpencv when OpenCV is available, and
+  with the native vpKltTracker otherwise.
 
   \brief Model based tracker using only KLT.
 
@@ -89,7 +94,7 @@
 
 int main()
 {
-#if defined VISP_HAVE_OPENCV
+#if defined VISP_HAVE_MODULE_KLT
   vpMbKltTracker tracker; // Create a model based tracker via KLT points.
   vpImage<unsigned char> I;
   vpHomogeneousMatrix cMo; // Pose computed using the tracker.
@@ -138,7 +143,7 @@ computed using another method:
 
 int main()
 {
-#if defined VISP_HAVE_OPENCV
+#if defined VISP_HAVE_MODULE_KLT
   vpMbKltTracker tracker; // Create a model based tracker via Klt Points.
   vpImage<unsigned char> I;
   vpHomogeneousMatrix cMo; // Pose used in entry (has to be defined), then computed using the tracker.
@@ -175,7 +180,7 @@ a given pose:
 
 int main()
 {
-#if defined VISP_HAVE_OPENCV
+#if defined VISP_HAVE_MODULE_KLT
   vpMbKltTracker tracker; // Create a model based tracker via Klt Points.
   vpImage<unsigned char> I;
   vpHomogeneousMatrix cMo; // Pose used to display the model.
@@ -211,9 +216,9 @@ class VISP_EXPORT vpMbKltTracker : public virtual vpMbTracker
 {
 protected:
 //! Temporary OpenCV image for fast conversion.
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   cv::Mat cur;
-#else
+#elif defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   IplImage *cur;
 #endif
   //! Initial pose.
@@ -233,7 +238,11 @@ protected:
   //! the initial position.
   vpHomogeneousMatrix ctTc0;
   //! Points tracker.
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   vpKltOpencv tracker;
+#else
+  vpKltTracker tracker;
+#endif
   //!
   std::list<vpMbtDistanceKltPoints *> kltPolygons;
   //!
@@ -280,24 +289,36 @@ public:
 /*!
   Get the current list of KLT points.
 
-   \return the list of KLT points through vpKltOpencv.
+   \return the list of KLT points through vpKltOpencv, or vpKltTracker when
+   OpenCV is not available.
  */
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   inline std::vector<cv::Point2f> getKltPoints() const { return tracker.getFeatures(); }
-#else
+#elif defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   inline CvPoint2D32f *getKltPoints() { return tracker.getFeatures(); }
+#else
+  inline std::vector<vpImagePoint> getKltPoints() const { return tracker.getFeatures(); }
 #endif
 
   std::vector<vpImagePoint> getKltImagePoints() const;
 
   std::map<int, vpImagePoint> getKltImagePointsWithId() const;
 
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   /*!
     Get the klt tracker at the current state.
 
     \return klt tracker.
    */
   inline vpKltOpencv getKltOpencv() const { return tracker; }
+#else
+  /*!
+    Get the native klt tracker at the current state.
+
+    \return klt tracker.
+   */
+  inline vpKltTracker getKltTracker() const { return tracker; }
+#endif
 
   /*!
     Get the erosion of the mask used on the Model faces.
@@ -351,7 +372,11 @@ public:
     faces.getMbScanLineRenderer().setMaskBorder(maskBorder);
   }
 
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   virtual void setKltOpencv(const vpKltOpencv &t);
+#else
+  virtual void setKltTracker(const vpKltTracker &t);
+#endif
 
   /*!
     Set the threshold for the acceptation of a point.
@@ -487,4 +512,4 @@ protected:
 };
 
 #endif
-#endif // VISP_HAVE_OPENCV
+#endif // VISP_HAVE_MODULE_KLT
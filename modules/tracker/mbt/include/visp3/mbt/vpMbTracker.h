@@ -810,7 +810,13 @@ protected:
                                         vpColVector &R, const vpColVector &error, vpColVector &error_prev,
                                         vpColVector &LTR, double &mu, vpColVector &v, const vpColVector *const w = NULL,
                                         vpColVector *const m_w_prev = NULL);
+  void computeVVSPoseEstimationFromNormalEquations(const bool isoJoIdentity_, unsigned int iter, const vpMatrix &LTL,
+                                                   const vpColVector &LTR, const vpColVector &error,
+                                                   vpColVector &error_prev, double &mu, vpColVector &v);
   virtual void computeVVSWeights(vpRobust &robust, const vpColVector &error, vpColVector &w);
+  void solveVVSNormalEquations(unsigned int iter, const vpMatrix &LTL, const vpColVector &LTR,
+                               const vpColVector &error, vpColVector &error_prev, double &mu, vpColVector &v,
+                               const vpColVector *const w = NULL, vpColVector *const m_w_prev = NULL);
 
 #ifdef VISP_HAVE_COIN3D
   virtual void extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace);
@@ -41,7 +41,7 @@
 
 #include <visp3/core/vpConfig.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 #include <map>
 
@@ -51,7 +51,11 @@
 #include <visp3/core/vpGEMM.h>
 #include <visp3/core/vpPlane.h>
 #include <visp3/core/vpPolygon3D.h>
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
 #include <visp3/klt/vpKltOpencv.h>
+#else
+#include <visp3/klt/vpKltTracker.h>
+#endif
 #include <visp3/mbt/vpMbHiddenFaces.h>
 #include <visp3/vision/vpHomography.h>
 
@@ -137,7 +141,11 @@ public:
 
   void buildFrom(const vpPoint &p1, const vpPoint &p2, const double &r);
 
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   unsigned int computeNbDetectedCurrent(const vpKltOpencv &_tracker);
+#else
+  unsigned int computeNbDetectedCurrent(const vpKltTracker &_tracker);
+#endif
   void computeInteractionMatrixAndResidu(const vpHomogeneousMatrix &cMc0, vpColVector &_R, vpMatrix &_J);
 
   void display(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam,
@@ -195,7 +203,11 @@ public:
   */
   inline bool isTracked() const { return isTrackedKltCylinder; }
 
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   void init(const vpKltOpencv &_tracker, const vpHomogeneousMatrix &cMo);
+#else
+  void init(const vpKltTracker &_tracker, const vpHomogeneousMatrix &cMo);
+#endif
 
   void removeOutliers(const vpColVector &weight, const double &threshold_outlier);
 
@@ -213,13 +225,15 @@ public:
   */
   inline void setTracked(const bool &track) { this->isTrackedKltCylinder = track; }
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   void updateMask(cv::Mat &mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
-#else
+#elif defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   void updateMask(IplImage *mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
+#else
+  void updateMask(vpImage<unsigned char> &mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
 #endif
 };
 
 #endif
 
-#endif // VISP_HAVE_OPENCV
+#endif // VISP_HAVE_MODULE_KLT
@@ -42,7 +42,7 @@
 
 #include <visp3/core/vpConfig.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 #include <map>
 
@@ -50,7 +50,11 @@
 #include <visp3/core/vpGEMM.h>
 #include <visp3/core/vpPlane.h>
 #include <visp3/core/vpPolygon3D.h>
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
 #include <visp3/klt/vpKltOpencv.h>
+#else
+#include <visp3/klt/vpKltTracker.h>
+#endif
 #include <visp3/mbt/vpMbHiddenFaces.h>
 #include <visp3/vision/vpHomography.h>
 
@@ -60,7 +64,8 @@
   \brief Implementation of a polygon of the model containing points of
   interest. It is used by the model-based tracker KLT, and hybrid.
 
-  \warning This class is only available if OpenCV is installed, and used.
+  The points are tracked by vpKltOpencv when OpenCV is available, and by the
+  native vpKltTracker otherwise.
 
   \ingroup group_mbt_features
 */
@@ -137,7 +142,11 @@ public:
   vpMbtDistanceKltPoints();
   virtual ~vpMbtDistanceKltPoints();
 
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   unsigned int computeNbDetectedCurrent(const vpKltOpencv &_tracker, const vpImage<bool> *mask = NULL);
+#else
+  unsigned int computeNbDetectedCurrent(const vpKltTracker &_tracker, const vpImage<bool> *mask = NULL);
+#endif
   void computeHomography(const vpHomogeneousMatrix &_cTc0, vpHomography &cHc0);
   void computeInteractionMatrixAndResidu(vpColVector &_R, vpMatrix &_J);
 
@@ -190,7 +199,11 @@ public:
 
   inline bool hasEnoughPoints() const { return enoughPoints; }
 
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   void init(const vpKltOpencv &_tracker, const vpImage<bool> *mask = NULL);
+#else
+  void init(const vpKltTracker &_tracker, const vpImage<bool> *mask = NULL);
+#endif
 
   /*!
    Return if the klt points are used for tracking.
@@ -215,13 +228,15 @@ public:
   */
   inline void setTracked(const bool &track) { this->isTrackedKltPoints = track; }
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   void updateMask(cv::Mat &mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
-#else
+#elif defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   void updateMask(IplImage *mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
+#else
+  void updateMask(vpImage<unsigned char> &mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
 #endif
 };
 
 #endif
 
-#endif // VISP_HAVE_OPENCV
+#endif // VISP_HAVE_MODULE_KLT
@@ -260,7 +260,7 @@ public:
   */
   void setVisible(bool _isvisible) { isvisible = _isvisible; }
 
-  void trackMovingEdge(const vpImage<unsigned char> &I);
+  void trackMovingEdge(const vpImage<unsigned char> &I, bool sitesTracked = false);
 
   void updateMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo);
 
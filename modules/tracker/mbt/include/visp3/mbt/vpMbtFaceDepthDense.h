@@ -45,11 +45,67 @@
 #endif
 
 #include <visp3/core/vpPlane.h>
+#include <visp3/core/vpPointCloud.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtDistanceLine.h>
 
 #define DEBUG_DISPLAY_DEPTH_DENSE 0
 
+/*!
+  \class vpMbtDepthImagePointCloud
+  \ingroup group_mbt_faces
+
+  \brief Organized point cloud deprojected on the fly from a raw depth image.
+
+  The 3D point at index \e idx is \f$ Z (x, y, 1) \f$ where \f$ Z \f$ is the
+  raw depth multiplied by the depth scale, and \f$ (x, y) \f$ the normalized
+  coordinates of the pixel read from a precomputed ray look-up table. Only the
+  points that are accessed are deprojected.
+*/
+class VISP_EXPORT vpMbtDepthImagePointCloud
+{
+public:
+  /*!
+    \param depth : Raw depth image.
+    \param depthScale : Scale factor to convert a raw depth value into meter.
+    \param rays : Normalized coordinates (x, y) of each pixel of the depth
+    image, stored in row-major order.
+  */
+  vpMbtDepthImagePointCloud(const vpImage<uint16_t> &depth, double depthScale, const std::vector<float> &rays)
+    : m_depth(depth.bitmap), m_depthScale(depthScale), m_rays(rays.empty() ? NULL : &rays[0]),
+      m_height(depth.getHeight()), m_width(depth.getWidth())
+  {
+    if (rays.size() != 2 * static_cast<size_t>(m_height) * m_width) {
+      throw vpException(vpException::dimensionError, "Ray look-up table size (%d) differs from 2x%dx%d",
+                        static_cast<int>(rays.size()), m_height, m_width);
+    }
+  }
+
+  //! Return the height of the depth image.
+  inline unsigned int getHeight() const { return m_height; }
+  //! Return the width of the depth image.
+  inline unsigned int getWidth() const { return m_width; }
+
+  //! Return the X coordinate of the point at index \e idx.
+  inline double getX(unsigned int idx) const { return m_rays[2 * idx] * getZ(idx); }
+  //! Return the Y coordinate of the point at index \e idx.
+  inline double getY(unsigned int idx) const { return m_rays[2 * idx + 1] * getZ(idx); }
+  //! Return the Z coordinate of the point at index \e idx, 0 if the depth is not valid.
+  inline double getZ(unsigned int idx) const { return m_depth[idx] * m_depthScale; }
+
+private:
+  //! Raw depth values
+  const uint16_t *m_depth;
+  //! Scale factor to convert the raw depth values into meter
+  double m_depthScale;
+  //! Normalized coordinates of each pixel
+  const float *m_rays;
+  //! Number of rows
+  unsigned int m_height;
+  //! Number of columns
+  unsigned int m_width;
+};
+
 class VISP_EXPORT vpMbtFaceDepthDense
 {
 public:
@@ -108,8 +164,33 @@ public:
                               , const vpImage<bool> *mask = NULL
   );
 
+  bool computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
+                              const vpPointCloud<float> &point_cloud,
+                              unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                              ,
+                              vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                              , const vpImage<bool> *mask = NULL
+  );
+
+  bool computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
+                              const vpMbtDepthImagePointCloud &point_cloud,
+                              unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                              ,
+                              vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                              , const vpImage<bool> *mask = NULL
+  );
+
   void computeInteractionMatrixAndResidu(const vpHomogeneousMatrix &cMo, vpMatrix &L, vpColVector &error);
 
+  void computeNormalEquations(const vpHomogeneousMatrix &cMo, const double *const w, vpMatrix &LTL,
+                              vpColVector &LTR, unsigned int nbThreads = 1);
+
+  void computeResidu(const vpHomogeneousMatrix &cMo, vpColVector &error);
+
   void computeVisibility();
   void computeVisibilityDisplay();
 
@@ -222,10 +303,23 @@ protected:
   vpPlane m_planeCamera;
   //! List of depth points inside the face
   std::vector<double> m_pointCloudFace;
+  //! Flag set when the points of m_pointCloudFace are stored by pairs for the SIMD code
+  bool m_pairedPointCloudFace;
   //! Polygon lines used for scan-line visibility
   std::vector<PolygonLine> m_polygonLines;
 
 protected:
+  template <class PointCloud>
+  bool computeDesiredFeaturesImpl(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
+                                  const PointCloud &point_cloud, unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                  ,
+                                  vpImage<unsigned char> &debugImage,
+                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                  , const vpImage<bool> *mask
+  );
+
   void computeROI(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
                   std::vector<vpImagePoint> &roiPts
 #if DEBUG_DISPLAY_DEPTH_DENSE
@@ -45,6 +45,7 @@
 #endif
 
 #include <visp3/core/vpPlane.h>
+#include <visp3/core/vpPointCloud.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtDistanceLine.h>
 
@@ -109,6 +110,15 @@ public:
 #endif
                               , const vpImage<bool> *mask = NULL
   );
+  bool computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
+                              const vpPointCloud<float> &point_cloud,
+                              vpColVector &desired_features, unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                              ,
+                              vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                              , const vpImage<bool> *mask = NULL
+  );
 
   void computeInteractionMatrix(const vpHomogeneousMatrix &cMo, vpMatrix &L, vpColVector &features);
 
@@ -269,6 +279,17 @@ protected:
   //!
   std::vector<PolygonLine> m_polygonLines;
 
+  template <class PointCloud>
+  bool computeDesiredFeaturesImpl(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
+                                  const PointCloud &point_cloud, vpColVector &desired_features, unsigned int stepX,
+                                  unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                  ,
+                                  vpImage<unsigned char> &debugImage,
+                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                  , const vpImage<bool> *mask
+  );
 #ifdef VISP_HAVE_PCL
   bool computeDesiredFeaturesPCL(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud_face,
                                  vpColVector &desired_features, vpColVector &desired_normal,
@@ -277,7 +298,7 @@ protected:
   void computeDesiredFeaturesRobustFeatures(const std::vector<double> &point_cloud_face_custom,
                                             const std::vector<double> &point_cloud_face, const vpHomogeneousMatrix &cMo,
                                             vpColVector &desired_features, vpColVector &desired_normal,
-                                            vpColVector &centroid_point);
+                                            vpColVector &centroid_point, bool pairedLayout = false);
   void computeDesiredFeaturesSVD(const std::vector<double> &point_cloud_face, const vpHomogeneousMatrix &cMo,
                                  vpColVector &desired_features, vpColVector &desired_normal,
                                  vpColVector &centroid_point);
@@ -295,7 +316,7 @@ protected:
   );
 
   void estimateFeatures(const std::vector<double> &point_cloud_face, const vpHomogeneousMatrix &cMo,
-                        vpColVector &x_estimated, std::vector<double> &weights);
+                        vpColVector &x_estimated, std::vector<double> &weights, bool pairedLayout = false);
 
   void estimatePlaneEquationSVD(const std::vector<double> &point_cloud_face, const vpHomogeneousMatrix &cMo,
                                 vpColVector &plane_equation_estimated, vpColVector &centroid);
@@ -75,7 +75,7 @@ public:
                     const vpImagePoint &ic, double n20_p, double n11_p, double n02_p, bool doNotTrack,
                     vpImagePoint *pt1 = NULL, const vpImagePoint *pt2 = NULL);
 
-  void track(const vpImage<unsigned char> &I);
+  void track(const vpImage<unsigned char> &I, bool sitesTracked = false);
   void updateParameters(const vpImage<unsigned char> &I,
                         const vpImagePoint &center_p, double n20_p, double n11_p, double n02_p);
 
@@ -110,7 +110,7 @@ public:
   void initTracking(const vpImage<unsigned char> &I, const vpImagePoint &ip1, const vpImagePoint &ip2, double rho,
                     double theta, bool doNoTrack);
 
-  void track(const vpImage<unsigned char> &I);
+  void track(const vpImage<unsigned char> &I, bool sitesTracked = false);
 
   void updateParameters(const vpImage<unsigned char> &I, double rho, double theta);
   void updateParameters(const vpImage<unsigned char> &I, const vpImagePoint &ip1, const vpImagePoint &ip2, double rho,
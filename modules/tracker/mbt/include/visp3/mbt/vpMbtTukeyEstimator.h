@@ -50,13 +50,28 @@ public:
 private:
   T getMedian(std::vector<T> &vec);
   void MEstimator_impl(const std::vector<T> &residues, std::vector<T> &weights, const T NoiseThreshold);
-  void MEstimator_impl_ssse3(const std::vector<T> &residues, std::vector<T> &weights, const T NoiseThreshold);
   void psiTukey(const T sig, std::vector<T> &x, std::vector<T> &weights);
   void psiTukey(const T sig, std::vector<T> &x, vpColVector &weights);
 
   std::vector<T> m_normres;
   std::vector<T> m_residues;
 };
+
+/*
+ * Kernels of vpMbtTukeyEstimator, compiled in the library for several SIMD
+ * levels and selected from vpCPUFeatures::getSimdLevel(). All the versions
+ * return the same values as the scalar code.
+ */
+class VISP_EXPORT vpMbtTukeyKernels
+{
+public:
+  // y[i] = |x[i] - med|
+  static void absDiff(const float *x, float med, float *y, size_t n);
+  static void absDiff(const double *x, double med, double *y, size_t n);
+  // Tukey weights w[i] = (1 - (x[i] / C)^2)^2, 0 when |x[i]| > C
+  static void psiTukey(float C, const float *x, float *w, size_t n);
+  static void psiTukey(double C, const double *x, double *w, size_t n);
+};
 #endif //#ifndef DOXYGEN_SHOULD_SKIP_THIS
 
 
@@ -77,56 +92,11 @@ private:
 #include <cmath>
 #include <iostream>
 
-#include <visp3/core/vpCPUFeatures.h>
-
-#define USE_TRANSFORM 1
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && USE_TRANSFORM
-#define HAVE_TRANSFORM 1
-#endif
-
-#if HAVE_TRANSFORM
-#include <functional>
-#endif
-
-#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
-#include <emmintrin.h>
-#define VISP_HAVE_SSE2 1
-
-#if defined __SSE3__ || (defined _MSC_VER && _MSC_VER >= 1500)
-#include <pmmintrin.h>
-#define VISP_HAVE_SSE3 1
-#endif
-#if defined __SSSE3__ || (defined _MSC_VER && _MSC_VER >= 1500)
-#include <tmmintrin.h>
-#define VISP_HAVE_SSSE3 1
-#endif
-#endif
-
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
-#if HAVE_TRANSFORM
-namespace
-{
-template <typename T> struct AbsDiff : public std::binary_function<T, T, T> {
-  T operator()(const T a, const T b) const { return std::fabs(a - b); }
-};
-}
-#endif
-
 template class vpMbtTukeyEstimator<float>;
 template class vpMbtTukeyEstimator<double>;
 
-#if VISP_HAVE_SSSE3
-namespace
-{
-inline __m128 abs_ps(__m128 x)
-{
-  static const __m128 sign_mask = _mm_set1_ps(-0.f); // -0.f = 1 << 31
-  return _mm_andnot_ps(sign_mask, x);
-}
-}
-#endif
-
 template <typename T> T vpMbtTukeyEstimator<T>::getMedian(std::vector<T> &vec)
 {
   // Not the exact median when even number of elements
@@ -153,15 +123,7 @@ void vpMbtTukeyEstimator<T>::MEstimator_impl(const std::vector<T> &residues, std
 
   T med = getMedian(m_residues);
   m_normres.resize(residues.size());
-
-#if HAVE_TRANSFORM
-  std::transform(residues.begin(), residues.end(), m_normres.begin(),
-                 std::bind(AbsDiff<T>(), std::placeholders::_1, med));
-#else
-  for (size_t i = 0; i < m_residues.size(); i++) {
-    m_normres[i] = (std::fabs(residues[i] - med));
-  }
-#endif
+  vpMbtTukeyKernels::absDiff(&residues[0], med, &m_normres[0], residues.size());
 
   m_residues = m_normres;
   T normmedian = getMedian(m_residues);
@@ -178,100 +140,6 @@ void vpMbtTukeyEstimator<T>::MEstimator_impl(const std::vector<T> &residues, std
   psiTukey(sigma, m_normres, weights);
 }
 
-template <>
-inline void vpMbtTukeyEstimator<float>::MEstimator_impl_ssse3(const std::vector<float> &residues, std::vector<float> &weights,
-                                                              const float NoiseThreshold)
-{
-#if VISP_HAVE_SSSE3
-  if (residues.empty()) {
-    return;
-  }
-
-  m_residues = residues;
-
-  float med = getMedian(m_residues);
-  m_normres.resize(residues.size());
-
-  size_t i = 0;
-  __m128 med_128 = _mm_set_ps1(med);
-
-  if (m_residues.size() >= 4) {
-    for (i = 0; i <= m_residues.size() - 4; i += 4) {
-      __m128 residues_128 = _mm_loadu_ps(residues.data() + i);
-      _mm_storeu_ps(m_normres.data() + i, abs_ps(_mm_sub_ps(residues_128, med_128)));
-    }
-  }
-
-  for (; i < m_residues.size(); i++) {
-    m_normres[i] = (std::fabs(residues[i] - med));
-  }
-
-  m_residues = m_normres;
-  float normmedian = getMedian(m_residues);
-
-  // 1.48 keeps scale estimate consistent for a normal probability dist.
-  float sigma = 1.4826f * normmedian; // median Absolute Deviation
-
-  // Set a minimum threshold for sigma
-  // (when sigma reaches the level of noise in the image)
-  if (sigma < NoiseThreshold) {
-    sigma = NoiseThreshold;
-  }
-
-  psiTukey(sigma, m_normres, weights);
-#else
-  (void)residues;
-  (void)weights;
-  (void)NoiseThreshold;
-#endif
-}
-
-/*!
- * \relates vpMbtTukeyEstimator
- */
-template <>
-inline void vpMbtTukeyEstimator<double>::MEstimator_impl_ssse3(const std::vector<double> &residues,
-                                                               std::vector<double> &weights, const double NoiseThreshold)
-{
-#if VISP_HAVE_SSSE3
-  if (residues.empty()) {
-    return;
-  }
-
-  m_residues = residues;
-
-  double med = getMedian(m_residues);
-  m_normres.resize(residues.size());
-
-#if HAVE_TRANSFORM
-  std::transform(residues.begin(), residues.end(), m_normres.begin(),
-                 std::bind(AbsDiff<double>(), std::placeholders::_1, med));
-#else
-  for (size_t i = 0; i < m_residues.size(); i++) {
-    m_normres[i] = (std::fabs(residues[i] - med));
-  }
-#endif
-
-  m_residues = m_normres;
-  double normmedian = getMedian(m_residues);
-
-  // 1.48 keeps scale estimate consistent for a normal probability dist.
-  double sigma = 1.4826 * normmedian; // median Absolute Deviation
-
-  // Set a minimum threshold for sigma
-  // (when sigma reaches the level of noise in the image)
-  if (sigma < NoiseThreshold) {
-    sigma = NoiseThreshold;
-  }
-
-  psiTukey(sigma, m_normres, weights);
-#else
-  (void)residues;
-  (void)weights;
-  (void)NoiseThreshold;
-#endif
-}
-
 /*!
  * \relates vpMbtTukeyEstimator
  */
@@ -279,15 +147,7 @@ template <>
 inline void vpMbtTukeyEstimator<float>::MEstimator(const std::vector<float> &residues, std::vector<float> &weights,
                                                    const float NoiseThreshold)
 {
-  bool checkSSSE3 = vpCPUFeatures::checkSSSE3();
-#if !VISP_HAVE_SSSE3
-  checkSSSE3 = false;
-#endif
-
-  if (checkSSSE3)
-    MEstimator_impl_ssse3(residues, weights, NoiseThreshold);
-  else
-    MEstimator_impl(residues, weights, NoiseThreshold);
+  MEstimator_impl(residues, weights, NoiseThreshold);
 }
 
 /*!
@@ -297,15 +157,7 @@ template <>
 inline void vpMbtTukeyEstimator<double>::MEstimator(const std::vector<double> &residues, std::vector<double> &weights,
                                                     const double NoiseThreshold)
 {
-  bool checkSSSE3 = vpCPUFeatures::checkSSSE3();
-#if !VISP_HAVE_SSSE3
-  checkSSSE3 = false;
-#endif
-
-  if (checkSSSE3)
-    MEstimator_impl_ssse3(residues, weights, NoiseThreshold);
-  else
-    MEstimator_impl(residues, weights, NoiseThreshold);
+  MEstimator_impl(residues, weights, NoiseThreshold);
 }
 
 /*!
@@ -415,17 +267,8 @@ template <class T> void vpMbtTukeyEstimator<T>::psiTukey(const T sig, std::vecto
   weights.resize(x.size());
 
   // Here we consider that sig cannot be equal to 0
-  for (size_t i = 0; i < x.size(); i++) {
-    T xi = x[i] / C;
-    xi *= xi;
-
-    if (xi > 1.) {
-      weights[i] = 0;
-    } else {
-      xi = 1 - xi;
-      xi *= xi;
-      weights[i] = xi;
-    }
+  if (!x.empty()) {
+    vpMbtTukeyKernels::psiTukey(C, &x[0], &weights[0], x.size());
   }
 }
 #endif //#ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -33,6 +33,7 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 
 #include <visp3/core/vpConfig.h>
@@ -43,6 +44,7 @@
 
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/mbt/vpMbDepthDenseTracker.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
@@ -55,7 +57,8 @@
 vpMbDepthDenseTracker::vpMbDepthDenseTracker()
   : m_depthDenseHiddenFacesDisplay(), m_depthDenseListOfActiveFaces(),
     m_denseDepthNbFeatures(0), m_depthDenseFaces(), m_depthDenseSamplingStepX(2), m_depthDenseSamplingStepY(2),
-    m_error_depthDense(), m_L_depthDense(), m_robust_depthDense(), m_w_depthDense(), m_weightedError_depthDense()
+    m_error_depthDense(), m_L_depthDense(), m_robust_depthDense(), m_w_depthDense(), m_weightedError_depthDense(),
+    m_depthDenseRays(), m_depthDenseRaysCam(), m_depthDenseRaysHeight(0), m_depthDenseRaysWidth(0)
 #if DEBUG_DISPLAY_DEPTH_DENSE
     ,
     m_debugDisp_depthDense(NULL), m_debugImage_depthDense()
@@ -126,6 +129,37 @@ void vpMbDepthDenseTracker::addFace(vpMbtPolygon &polygon, bool alreadyClose)
   m_depthDenseFaces.push_back(normal_face);
 }
 
+/*!
+  Compute the normalized coordinates of each pixel of a depth image of size \e width x \e height with
+  the current camera parameters. The look-up table is only rebuilt when the image size or the camera
+  parameters change.
+*/
+void vpMbDepthDenseTracker::computeDepthDenseRays(unsigned int width, unsigned int height)
+{
+  if (m_depthDenseRaysHeight == height && m_depthDenseRaysWidth == width && m_depthDenseRaysCam == m_cam) {
+    return;
+  }
+
+  m_depthDenseRays.resize(2 * static_cast<size_t>(height) * width);
+  std::vector<double> u(width), v(width), x(width), y(width);
+  for (unsigned int j = 0; j < width; j++) {
+    u[j] = j;
+  }
+  size_t idx = 0;
+  for (unsigned int i = 0; i < height && width > 0; i++) {
+    std::fill(v.begin(), v.end(), static_cast<double>(i));
+    vpPixelMeterConversion::convertPoints(m_cam, &u[0], &v[0], &x[0], &y[0], width);
+    for (unsigned int j = 0; j < width; j++, idx += 2) {
+      m_depthDenseRays[idx] = static_cast<float>(x[j]);
+      m_depthDenseRays[idx + 1] = static_cast<float>(y[j]);
+    }
+  }
+
+  m_depthDenseRaysCam = m_cam;
+  m_depthDenseRaysHeight = height;
+  m_depthDenseRaysWidth = width;
+}
+
 void vpMbDepthDenseTracker::computeVisibility(unsigned int width, unsigned int height)
 {
   bool changed = false;
@@ -282,6 +316,84 @@ void vpMbDepthDenseTracker::computeVVSWeights()
   m_robust_depthDense.MEstimator(m_error_depthDense, m_w_depthDense, 1e-3);
 }
 
+/*!
+  Compute the normal equations \f$ (\mathbf{W} \mathbf{L})^T (\mathbf{W} \mathbf{L}) \f$ and
+  \f$ (\mathbf{W} \mathbf{L})^T (\mathbf{W} \mathbf{e}) \f$ of the dense depth features, without building
+  the interaction matrix.
+
+  \param w : Weight of each feature, or an empty vector to use unit weights.
+  \param LTL : 6x6 matrix.
+  \param LTR : 6-dim vector.
+  \param nbThreads : Number of threads used to process the points of a face.
+*/
+void vpMbDepthDenseTracker::computeVVSNormalEquations(const vpColVector &w, vpMatrix &LTL, vpColVector &LTR,
+                                                      unsigned int nbThreads)
+{
+  if (w.getRows() != 0 && w.getRows() != m_denseDepthNbFeatures) {
+    throw vpException(vpException::dimensionError, "Number of weights (%d) is not equal to the number of features (%d)",
+                      w.getRows(), m_denseDepthNbFeatures);
+  }
+
+  LTL.resize(6, 6);
+  LTR.resize(6);
+
+  vpMatrix LTL_face;
+  vpColVector LTR_face;
+  unsigned int start_index = 0;
+  for (std::vector<vpMbtFaceDepthDense *>::const_iterator it = m_depthDenseListOfActiveFaces.begin();
+       it != m_depthDenseListOfActiveFaces.end(); ++it) {
+    vpMbtFaceDepthDense *face = *it;
+
+    face->computeNormalEquations(m_cMo, w.getRows() == 0 ? NULL : w.data + start_index, LTL_face, LTR_face,
+                                 nbThreads);
+    LTL += LTL_face;
+    LTR += LTR_face;
+
+    start_index += face->getNbFeatures();
+  }
+}
+
+/*!
+  Compute only the residual of the dense depth features, for the pose estimation based on
+  computeVVSNormalEquations().
+*/
+void vpMbDepthDenseTracker::computeVVSResidu()
+{
+  unsigned int start_index = 0;
+  vpColVector error;
+  for (std::vector<vpMbtFaceDepthDense *>::const_iterator it = m_depthDenseListOfActiveFaces.begin();
+       it != m_depthDenseListOfActiveFaces.end(); ++it) {
+    vpMbtFaceDepthDense *face = *it;
+
+    face->computeResidu(m_cMo, error);
+    m_error_depthDense.insert(start_index, error);
+
+    start_index += error.getRows();
+  }
+}
+
+/*!
+  Same as computeVVSInit() without allocating the interaction matrix, for the pose estimation based on
+  computeVVSNormalEquations().
+*/
+void vpMbDepthDenseTracker::computeVVSResiduInit()
+{
+  m_denseDepthNbFeatures = 0;
+
+  for (std::vector<vpMbtFaceDepthDense *>::const_iterator it = m_depthDenseListOfActiveFaces.begin();
+       it != m_depthDenseListOfActiveFaces.end(); ++it) {
+    vpMbtFaceDepthDense *face = *it;
+    m_denseDepthNbFeatures += face->getNbFeatures();
+  }
+
+  m_L_depthDense.resize(0, 0);
+  m_error_depthDense.resize(m_denseDepthNbFeatures, false);
+  m_weightedError_depthDense.resize(0);
+
+  m_w_depthDense.resize(m_denseDepthNbFeatures, false);
+  m_w_depthDense = 1;
+}
+
 void vpMbDepthDenseTracker::display(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo,
                                     const vpCameraParameters &cam, const vpColor &col, unsigned int thickness,
                                     bool displayFullModel)
@@ -597,8 +709,8 @@ void vpMbDepthDenseTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointXY
 }
 #endif
 
-void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
-                                              unsigned int height)
+template <class PointCloud>
+void vpMbDepthDenseTracker::segmentPointCloudImpl(const PointCloud &point_cloud, unsigned int width, unsigned int height)
 {
   m_depthDenseListOfActiveFaces.clear();
 
@@ -655,6 +767,22 @@ void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &po
 #endif
 }
 
+void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
+                                              unsigned int height)
+{
+  segmentPointCloudImpl(point_cloud, width, height);
+}
+
+void vpMbDepthDenseTracker::segmentPointCloud(const vpPointCloud<float> &point_cloud)
+{
+  segmentPointCloudImpl(point_cloud, point_cloud.getWidth(), point_cloud.getHeight());
+}
+
+void vpMbDepthDenseTracker::segmentPointCloud(const vpMbtDepthImagePointCloud &point_cloud)
+{
+  segmentPointCloudImpl(point_cloud, point_cloud.getWidth(), point_cloud.getHeight());
+}
+
 void vpMbDepthDenseTracker::setOgreVisibilityTest(const bool &v)
 {
   vpMbTracker::setOgreVisibilityTest(v);
@@ -740,6 +868,42 @@ void vpMbDepthDenseTracker::track(const std::vector<vpColVector> &point_cloud, u
   computeVisibility(width, height);
 }
 
+/*!
+  Track the object using an organized point cloud whose X, Y, Z coordinates are stored
+  in contiguous planes.
+
+  \param point_cloud : Organized point cloud, possibly a view over the sensor buffers.
+*/
+void vpMbDepthDenseTracker::track(const vpPointCloud<float> &point_cloud)
+{
+  segmentPointCloud(point_cloud);
+
+  computeVVS();
+
+  computeVisibility(point_cloud.getWidth(), point_cloud.getHeight());
+}
+
+/*!
+  Track the object using directly a raw depth image, for instance the Z16 stream of a RealSense camera.
+  No point cloud is built: only the pixels sampled inside the visible faces are deprojected, using the
+  camera parameters of the tracker (see setCameraParameters()) that must be the depth camera ones.
+
+  \param depth : Raw depth image. A value of 0 means that the depth is not valid.
+  \param depthScale : Scale factor to convert a raw depth value into meter, e.g. 0.001 for a depth
+  expressed in millimeter.
+*/
+void vpMbDepthDenseTracker::track(const vpImage<uint16_t> &depth, double depthScale)
+{
+  computeDepthDenseRays(depth.getWidth(), depth.getHeight());
+  vpMbtDepthImagePointCloud point_cloud(depth, depthScale, m_depthDenseRays);
+
+  segmentPointCloud(point_cloud);
+
+  computeVVS();
+
+  computeVisibility(depth.getWidth(), depth.getHeight());
+}
+
 void vpMbDepthDenseTracker::initCircle(const vpPoint & /*p1*/, const vpPoint & /*p2*/, const vpPoint & /*p3*/,
                                        double /*radius*/, int /*idFace*/, const std::string & /*name*/)
 {
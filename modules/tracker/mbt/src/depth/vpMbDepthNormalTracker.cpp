@@ -645,8 +645,9 @@ void vpMbDepthNormalTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointX
 }
 #endif
 
-void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
-                                               unsigned int height)
+template <class PointCloud>
+void vpMbDepthNormalTracker::segmentPointCloudImpl(const PointCloud &point_cloud, unsigned int width,
+                                                   unsigned int height)
 {
   m_depthNormalListOfActiveFaces.clear();
   m_depthNormalListOfDesiredFeatures.clear();
@@ -708,6 +709,17 @@ void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &p
 #endif
 }
 
+void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
+                                               unsigned int height)
+{
+  segmentPointCloudImpl(point_cloud, width, height);
+}
+
+void vpMbDepthNormalTracker::segmentPointCloud(const vpPointCloud<float> &point_cloud)
+{
+  segmentPointCloudImpl(point_cloud, point_cloud.getWidth(), point_cloud.getHeight());
+}
+
 void vpMbDepthNormalTracker::setCameraParameters(const vpCameraParameters &cam)
 {
   m_cam = cam;
@@ -813,6 +825,21 @@ void vpMbDepthNormalTracker::track(const std::vector<vpColVector> &point_cloud,
   computeVisibility(width, height);
 }
 
+/*!
+  Track the object using an organized point cloud whose X, Y, Z coordinates are stored
+  in contiguous planes.
+
+  \param point_cloud : Organized point cloud, possibly a view over the sensor buffers.
+*/
+void vpMbDepthNormalTracker::track(const vpPointCloud<float> &point_cloud)
+{
+  segmentPointCloud(point_cloud);
+
+  computeVVS();
+
+  computeVisibility(point_cloud.getWidth(), point_cloud.getHeight());
+}
+
 void vpMbDepthNormalTracker::initCircle(const vpPoint & /*p1*/, const vpPoint & /*p2*/, const vpPoint & /*p3*/,
                                         double /*radius*/, int /*idFace*/, const std::string & /*name*/)
 {
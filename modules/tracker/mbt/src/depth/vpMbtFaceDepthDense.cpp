@@ -34,30 +34,182 @@
  *****************************************************************************/
 
 #include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpSimdDispatch.h>
 #include <visp3/mbt/vpMbtFaceDepthDense.h>
 
+#include "vpMbtFaceDepthSampling.h"
+
 #ifdef VISP_HAVE_PCL
 #include <pcl/common/point_tests.h>
 #endif
 
-#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
-#include <emmintrin.h>
-#define VISP_HAVE_SSE2 1
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
 #endif
 
-#define USE_SSE_CODE 1
-#if VISP_HAVE_SSE2 && USE_SSE_CODE
-#define USE_SSE 1
-#else
-#define USE_SSE 0
+namespace
+{
+using vpMbtFaceDepthSampling::getPointX;
+using vpMbtFaceDepthSampling::getPointY;
+using vpMbtFaceDepthSampling::getPointZ;
+using vpMbtFaceDepthSampling::getSampledRowSpans;
+using vpMbtFaceDepthSampling::getNbSampledPixels;
+using vpMbtFaceDepthSampling::usePairedLayout;
+using vpMbtFaceDepthSampling::vpFacePointGatherer;
+
+// Number of points whose moments are summed together by computeNormalEquations()
+const size_t g_normalEquationsBlockSize = 4096;
+
+// Number of points stored by pairs for the SIMD code at the beginning of the face point cloud. The layout is
+// decided when the face is sampled and kept with the point cloud, that can be read by the kernels of any SIMD level.
+inline size_t getNbPairedPoints(const std::vector<double> &pointCloudFace, bool paired)
+{
+  return paired ? (pointCloudFace.size() / 6) * 2 : 0;
+}
+
+// Coordinates of the point at index idx of the face point cloud. When filled for the SSE2 code, the first
+// nbPairedPoints points are stored by pairs (x0 x1 y0 y1 z0 z1), the remaining one as (x y z).
+inline void getFacePoint(const std::vector<double> &pointCloudFace, size_t nbPairedPoints, size_t idx, double &x,
+                         double &y, double &z)
+{
+  const double *ptr = NULL;
+  if (idx < nbPairedPoints) {
+    ptr = &pointCloudFace[(idx / 2) * 6 + idx % 2];
+    x = ptr[0];
+    y = ptr[2];
+    z = ptr[4];
+  } else {
+    ptr = &pointCloudFace[idx * 3];
+    x = ptr[0];
+    y = ptr[1];
+    z = ptr[2];
+  }
+}
+
+// Rows [begin, end) of the interaction matrix L (6 columns) and of the residual error of the points of the face
+// for the plane nx x + ny y + nz z + D = 0.
+void computeResidu(const std::vector<double> &pointCloudFace, size_t nbPairedPoints, size_t begin, size_t end,
+                   const double *plane, double *L, double *error)
+{
+  const double nx = plane[0], ny = plane[1], nz = plane[2], D = plane[3];
+  for (size_t idx = begin; idx < end; idx++) {
+    double x = 0, y = 0, z = 0;
+    getFacePoint(pointCloudFace, nbPairedPoints, idx, x, y, z);
+
+    double *ptr_L = L + 6 * idx;
+    ptr_L[0] = nx;
+    ptr_L[1] = ny;
+    ptr_L[2] = nz;
+    ptr_L[3] = (nz * y) - (ny * z);
+    ptr_L[4] = (nx * z) - (nz * x);
+    ptr_L[5] = (ny * x) - (nx * y);
+
+    error[idx] = D + (nx * x + ny * y + nz * z);
+  }
+}
+
+void computeResidu_scalar(const std::vector<double> &pointCloudFace, size_t nbPairedPoints, const double *plane,
+                          double *L, double *error)
+{
+  computeResidu(pointCloudFace, nbPairedPoints, 0, pointCloudFace.size() / 3, plane, L, error);
+}
+
+// Write the rows of two paired points whose a1, a2, a3 coefficients are given
+inline void storePairRows(double nx, double ny, double nz, const double *a1, const double *a2, const double *a3,
+                          double *ptr_L)
+{
+  for (int k = 0; k < 2; k++, ptr_L += 6) {
+    ptr_L[0] = nx;
+    ptr_L[1] = ny;
+    ptr_L[2] = nz;
+    ptr_L[3] = a1[k];
+    ptr_L[4] = a2[k];
+    ptr_L[5] = a3[k];
+  }
+}
+
+#if VISP_HAVE_SIMD_DISPATCH
+VISP_SIMD_TARGET_SSE2 void computeResidu_sse2(const std::vector<double> &pointCloudFace, size_t nbPairedPoints,
+                                              const double *plane, double *L, double *error)
+{
+  const double *ptr_point_cloud = pointCloudFace.empty() ? NULL : &pointCloudFace[0];
+  const __m128d vnx = _mm_set1_pd(plane[0]);
+  const __m128d vny = _mm_set1_pd(plane[1]);
+  const __m128d vnz = _mm_set1_pd(plane[2]);
+  const __m128d vd = _mm_set1_pd(plane[3]);
+
+  double tmp_a1[2], tmp_a2[2], tmp_a3[2];
+  for (size_t idx = 0; idx < nbPairedPoints; idx += 2, ptr_point_cloud += 6) {
+    const __m128d vx = _mm_loadu_pd(ptr_point_cloud);
+    const __m128d vy = _mm_loadu_pd(ptr_point_cloud + 2);
+    const __m128d vz = _mm_loadu_pd(ptr_point_cloud + 4);
+
+    _mm_storeu_pd(tmp_a1, _mm_sub_pd(_mm_mul_pd(vnz, vy), _mm_mul_pd(vny, vz)));
+    _mm_storeu_pd(tmp_a2, _mm_sub_pd(_mm_mul_pd(vnx, vz), _mm_mul_pd(vnz, vx)));
+    _mm_storeu_pd(tmp_a3, _mm_sub_pd(_mm_mul_pd(vny, vx), _mm_mul_pd(vnx, vy)));
+    storePairRows(plane[0], plane[1], plane[2], tmp_a1, tmp_a2, tmp_a3, L + 6 * idx);
+
+    const __m128d verror =
+        _mm_add_pd(_mm_add_pd(vd, _mm_mul_pd(vnx, vx)), _mm_add_pd(_mm_mul_pd(vny, vy), _mm_mul_pd(vnz, vz)));
+    _mm_storeu_pd(error + idx, verror);
+  }
+
+  computeResidu(pointCloudFace, nbPairedPoints, nbPairedPoints, pointCloudFace.size() / 3, plane, L, error);
+}
+#endif
+
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+// Two pairs x0 x1 y0 y1 z0 z1 x2 x3 y2 y3 z2 z3 are processed at once
+VISP_SIMD_TARGET_AVX2 void computeResidu_avx2(const std::vector<double> &pointCloudFace, size_t nbPairedPoints,
+                                              const double *plane, double *L, double *error)
+{
+  const double *ptr_point_cloud = pointCloudFace.empty() ? NULL : &pointCloudFace[0];
+  const __m256d vnx = _mm256_set1_pd(plane[0]);
+  const __m256d vny = _mm256_set1_pd(plane[1]);
+  const __m256d vnz = _mm256_set1_pd(plane[2]);
+  const __m256d vd = _mm256_set1_pd(plane[3]);
+
+  double tmp_a1[4], tmp_a2[4], tmp_a3[4];
+  size_t idx = 0;
+  for (; idx + 4 <= nbPairedPoints; idx += 4, ptr_point_cloud += 12) {
+    const __m256d vx =
+        _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(ptr_point_cloud)), _mm_loadu_pd(ptr_point_cloud + 6), 1);
+    const __m256d vy = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(ptr_point_cloud + 2)),
+                                            _mm_loadu_pd(ptr_point_cloud + 8), 1);
+    const __m256d vz = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(ptr_point_cloud + 4)),
+                                            _mm_loadu_pd(ptr_point_cloud + 10), 1);
+
+    _mm256_storeu_pd(tmp_a1, _mm256_fmsub_pd(vnz, vy, _mm256_mul_pd(vny, vz)));
+    _mm256_storeu_pd(tmp_a2, _mm256_fmsub_pd(vnx, vz, _mm256_mul_pd(vnz, vx)));
+    _mm256_storeu_pd(tmp_a3, _mm256_fmsub_pd(vny, vx, _mm256_mul_pd(vnx, vy)));
+    storePairRows(plane[0], plane[1], plane[2], tmp_a1, tmp_a2, tmp_a3, L + 6 * idx);
+    storePairRows(plane[0], plane[1], plane[2], tmp_a1 + 2, tmp_a2 + 2, tmp_a3 + 2, L + 6 * (idx + 2));
+
+    const __m256d verror = _mm256_add_pd(_mm256_fmadd_pd(vnx, vx, vd), _mm256_fmadd_pd(vny, vy, _mm256_mul_pd(vnz, vz)));
+    _mm256_storeu_pd(error + idx, verror);
+  }
+
+  computeResidu(pointCloudFace, nbPairedPoints, idx, pointCloudFace.size() / 3, plane, L, error);
+}
 #endif
 
+typedef void (*ResiduFunc)(const std::vector<double> &, size_t, const double *, double *, double *);
+const vpSimdDispatcher<ResiduFunc> residu_dispatcher = vpSimdDispatcher<ResiduFunc>(computeResidu_scalar)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, computeResidu_sse2)
+#endif
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+    .add(vpCPUFeatures::SIMD_AVX2, computeResidu_avx2)
+#endif
+    ;
+} // namespace
+
 vpMbtFaceDepthDense::vpMbtFaceDepthDense()
   : m_cam(), m_clippingFlag(vpPolygon3D::NO_CLIPPING), m_distFarClip(100), m_distNearClip(0.001), m_hiddenFace(NULL),
     m_planeObject(), m_polygon(NULL), m_useScanLine(false),
     m_depthDenseFilteringMethod(DEPTH_OCCUPANCY_RATIO_FILTERING), m_depthDenseFilteringMaxDist(3.0),
     m_depthDenseFilteringMinDist(0.8), m_depthDenseFilteringOccupancyRatio(0.3), m_isTrackedDepthDenseFace(true),
-    m_isVisible(false), m_listOfFaceLines(), m_planeCamera(), m_pointCloudFace(), m_polygonLines()
+    m_isVisible(false), m_listOfFaceLines(), m_planeCamera(), m_pointCloudFace(), m_pairedPointCloudFace(false), m_polygonLines()
 {
 }
 
@@ -201,66 +353,33 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
 
   m_pointCloudFace.reserve((size_t)(bb.getWidth() * bb.getHeight()));
 
-  bool checkSSE2 = vpCPUFeatures::checkSSE2();
-#if !USE_SSE
-  checkSSE2 = false;
-#else
-  bool push = false;
-  double prev_x = 0.0, prev_y = 0.0, prev_z = 0.0;
-#endif
+  m_pairedPointCloudFace = usePairedLayout();
+  vpFacePointGatherer gatherer(m_pointCloudFace, m_pairedPointCloudFace);
 
   int totalTheoreticalPoints = 0, totalPoints = 0;
+  std::vector<std::pair<int, int> > spans;
   for (unsigned int i = top; i < bottom; i += stepY) {
-    for (unsigned int j = left; j < right; j += stepX) {
-      if ((m_useScanLine ? (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
-                            j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
-                            m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-                         : polygon_2d.isInside(vpImagePoint(i, j)))) {
-        totalTheoreticalPoints++;
-
-        if (vpMeTracker::inMask(mask, i, j) && pcl::isFinite((*point_cloud)(j, i)) && (*point_cloud)(j, i).z > 0) {
-          totalPoints++;
-
-          if (checkSSE2) {
-#if USE_SSE
-            if (!push) {
-              push = true;
-              prev_x = (*point_cloud)(j, i).x;
-              prev_y = (*point_cloud)(j, i).y;
-              prev_z = (*point_cloud)(j, i).z;
-            } else {
-              push = false;
-              m_pointCloudFace.push_back(prev_x);
-              m_pointCloudFace.push_back((*point_cloud)(j, i).x);
-
-              m_pointCloudFace.push_back(prev_y);
-              m_pointCloudFace.push_back((*point_cloud)(j, i).y);
-
-              m_pointCloudFace.push_back(prev_z);
-              m_pointCloudFace.push_back((*point_cloud)(j, i).z);
-            }
-#endif
-          } else {
-            m_pointCloudFace.push_back((*point_cloud)(j, i).x);
-            m_pointCloudFace.push_back((*point_cloud)(j, i).y);
-            m_pointCloudFace.push_back((*point_cloud)(j, i).z);
-          }
+    getSampledRowSpans(polygon_2d, m_useScanLine, i, left, right, stepX, spans);
+    for (size_t s = 0; s < spans.size(); s++) {
+      for (unsigned int j = (unsigned int)spans[s].first; j < (unsigned int)spans[s].second; j += stepX) {
+        if (!m_useScanLine || (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
+                               j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
+                               m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())) {
+          totalTheoreticalPoints++;
+
+          if (vpMeTracker::inMask(mask, i, j) && pcl::isFinite((*point_cloud)(j, i)) && (*point_cloud)(j, i).z > 0) {
+            totalPoints++;
+            gatherer.add((*point_cloud)(j, i).x, (*point_cloud)(j, i).y, (*point_cloud)(j, i).z);
 
 #if DEBUG_DISPLAY_DEPTH_DENSE
-          debugImage[i][j] = 255;
+            debugImage[i][j] = 255;
 #endif
+          }
         }
       }
     }
   }
-
-#if USE_SSE
-  if (checkSSE2 && push) {
-    m_pointCloudFace.push_back(prev_x);
-    m_pointCloudFace.push_back(prev_y);
-    m_pointCloudFace.push_back(prev_z);
-  }
-#endif
+  gatherer.finish();
 
   if (totalPoints == 0 || ((m_depthDenseFilteringMethod & DEPTH_OCCUPANCY_RATIO_FILTERING) &&
                            totalPoints / (double)totalTheoreticalPoints < m_depthDenseFilteringOccupancyRatio)) {
@@ -271,15 +390,16 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
 }
 #endif
 
-bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
-                                                 unsigned int height, const std::vector<vpColVector> &point_cloud,
-                                                 unsigned int stepX, unsigned int stepY
+template <class PointCloud>
+bool vpMbtFaceDepthDense::computeDesiredFeaturesImpl(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                     unsigned int height, const PointCloud &point_cloud,
+                                                     unsigned int stepX, unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-                                                 ,
-                                                 vpImage<unsigned char> &debugImage,
-                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                                     ,
+                                                     vpImage<unsigned char> &debugImage,
+                                                     std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-                                                 , const vpImage<bool> *mask
+                                                     , const vpImage<bool> *mask
 )
 {
   m_pointCloudFace.clear();
@@ -324,66 +444,45 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
 
   m_pointCloudFace.reserve((size_t)(bb.getWidth() * bb.getHeight()));
 
-  bool checkSSE2 = vpCPUFeatures::checkSSE2();
-#if !USE_SSE
-  checkSSE2 = false;
-#else
-  bool push = false;
-  double prev_x = 0.0, prev_y = 0.0, prev_z = 0.0;
-#endif
+  m_pairedPointCloudFace = usePairedLayout();
+  vpFacePointGatherer gatherer(m_pointCloudFace, m_pairedPointCloudFace);
 
   int totalTheoreticalPoints = 0, totalPoints = 0;
+  std::vector<std::pair<int, int> > spans;
   for (unsigned int i = top; i < bottom; i += stepY) {
-    for (unsigned int j = left; j < right; j += stepX) {
-      if ((m_useScanLine ? (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
-                            j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
-                            m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-                         : polygon_2d.isInside(vpImagePoint(i, j)))) {
-        totalTheoreticalPoints++;
-
-        if (vpMeTracker::inMask(mask, i, j) && point_cloud[i * width + j][2] > 0) {
-          totalPoints++;
-
-          if (checkSSE2) {
-#if USE_SSE
-            if (!push) {
-              push = true;
-              prev_x = point_cloud[i * width + j][0];
-              prev_y = point_cloud[i * width + j][1];
-              prev_z = point_cloud[i * width + j][2];
-            } else {
-              push = false;
-              m_pointCloudFace.push_back(prev_x);
-              m_pointCloudFace.push_back(point_cloud[i * width + j][0]);
-
-              m_pointCloudFace.push_back(prev_y);
-              m_pointCloudFace.push_back(point_cloud[i * width + j][1]);
-
-              m_pointCloudFace.push_back(prev_z);
-              m_pointCloudFace.push_back(point_cloud[i * width + j][2]);
-            }
+    getSampledRowSpans(polygon_2d, m_useScanLine, i, left, right, stepX, spans);
+    for (size_t s = 0; s < spans.size(); s++) {
+#if !DEBUG_DISPLAY_DEPTH_DENSE
+      // Without scanline rendering, every sampled pixel of the span belongs to the face
+      if (!m_useScanLine) {
+        const unsigned int jmin = (unsigned int)spans[s].first, jmax = (unsigned int)spans[s].second;
+        totalTheoreticalPoints += (int)getNbSampledPixels(jmin, jmax, stepX);
+        totalPoints += (int)gatherer.addSpan(point_cloud, width, i, jmin, jmax, stepX, mask);
+        continue;
+      }
 #endif
-          } else {
-            m_pointCloudFace.push_back(point_cloud[i * width + j][0]);
-            m_pointCloudFace.push_back(point_cloud[i * width + j][1]);
-            m_pointCloudFace.push_back(point_cloud[i * width + j][2]);
-          }
+
+      for (unsigned int j = (unsigned int)spans[s].first; j < (unsigned int)spans[s].second; j += stepX) {
+        if (!m_useScanLine || (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
+                               j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
+                               m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())) {
+          totalTheoreticalPoints++;
+
+          if (vpMeTracker::inMask(mask, i, j) && getPointZ(point_cloud, i * width + j) > 0) {
+            totalPoints++;
+            gatherer.add(getPointX(point_cloud, i * width + j),
+                         getPointY(point_cloud, i * width + j),
+                         getPointZ(point_cloud, i * width + j));
 
 #if DEBUG_DISPLAY_DEPTH_DENSE
-          debugImage[i][j] = 255;
+            debugImage[i][j] = 255;
 #endif
+          }
         }
       }
     }
   }
-
-#if USE_SSE
-  if (checkSSE2 && push) {
-    m_pointCloudFace.push_back(prev_x);
-    m_pointCloudFace.push_back(prev_y);
-    m_pointCloudFace.push_back(prev_z);
-  }
-#endif
+  gatherer.finish();
 
   if (totalPoints == 0 || ((m_depthDenseFilteringMethod & DEPTH_OCCUPANCY_RATIO_FILTERING) &&
                            totalPoints / (double)totalTheoreticalPoints < m_depthDenseFilteringOccupancyRatio)) {
@@ -393,6 +492,77 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
   return true;
 }
 
+bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                 unsigned int height, const std::vector<vpColVector> &point_cloud,
+                                                 unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                                 ,
+                                                 vpImage<unsigned char> &debugImage,
+                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                 , const vpImage<bool> *mask
+)
+{
+  return computeDesiredFeaturesImpl(cMo, width, height, point_cloud, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                    ,
+                                    debugImage, roiPts_vec
+#endif
+                                    , mask);
+}
+
+bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                 unsigned int height, const vpPointCloud<float> &point_cloud,
+                                                 unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                                 ,
+                                                 vpImage<unsigned char> &debugImage,
+                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                 , const vpImage<bool> *mask
+)
+{
+  if (width != point_cloud.getWidth() || height != point_cloud.getHeight()) {
+    throw vpException(vpException::dimensionError, "Point cloud size (%dx%d) differs from %dx%d",
+                      point_cloud.getWidth(), point_cloud.getHeight(), width, height);
+  }
+
+  return computeDesiredFeaturesImpl(cMo, width, height, point_cloud, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                    ,
+                                    debugImage, roiPts_vec
+#endif
+                                    , mask);
+}
+
+/*!
+  Extract the depth points of the face from a depth image. Only the sampled pixels that lie inside
+  the face are deprojected.
+*/
+bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                 unsigned int height, const vpMbtDepthImagePointCloud &point_cloud,
+                                                 unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                                 ,
+                                                 vpImage<unsigned char> &debugImage,
+                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                 , const vpImage<bool> *mask
+)
+{
+  if (width != point_cloud.getWidth() || height != point_cloud.getHeight()) {
+    throw vpException(vpException::dimensionError, "Depth image size (%dx%d) differs from %dx%d",
+                      point_cloud.getWidth(), point_cloud.getHeight(), width, height);
+  }
+
+  return computeDesiredFeaturesImpl(cMo, width, height, point_cloud, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                    ,
+                                    debugImage, roiPts_vec
+#endif
+                                    , mask);
+}
+
 void vpMbtFaceDepthDense::computeVisibility() { m_isVisible = m_polygon->isVisible(); }
 
 void vpMbtFaceDepthDense::computeVisibilityDisplay()
@@ -444,139 +614,162 @@ void vpMbtFaceDepthDense::computeInteractionMatrixAndResidu(const vpHomogeneousM
   m_planeCamera = m_planeObject;
   m_planeCamera.changeFrame(cMo);
 
-  double nx = m_planeCamera.getA();
-  double ny = m_planeCamera.getB();
-  double nz = m_planeCamera.getC();
-  double D = m_planeCamera.getD();
+  const double plane[4] = {m_planeCamera.getA(), m_planeCamera.getB(), m_planeCamera.getC(), m_planeCamera.getD()};
+  residu_dispatcher.get()(m_pointCloudFace, getNbPairedPoints(m_pointCloudFace, m_pairedPointCloudFace), plane, L.data,
+                          error.data);
+}
 
-  bool checkSSE2 = vpCPUFeatures::checkSSE2();
-#if !USE_SSE
-  checkSSE2 = false;
-#endif
+/*!
+  Compute the contribution of the face to the normal equations of the pose estimation, without building the
+  interaction matrix. If row \e i of the interaction matrix \f$ \mathbf{L} \f$ and of the residual
+  \f$ \mathbf{e} \f$ computed by computeInteractionMatrixAndResidu() is weighted by \e w[i], \e LTL is set to
+  \f$ (\mathbf{W} \mathbf{L})^T (\mathbf{W} \mathbf{L}) \f$ and \e LTR to
+  \f$ (\mathbf{W} \mathbf{L})^T (\mathbf{W} \mathbf{e}) \f$.
+
+  As all the rows of a face share the same plane, only the weighted moments of the points are accumulated.
+  The points are split into blocks whose moments are computed in parallel, then summed in the block order,
+  so that the result does not depend on the number of threads.
+
+  \param cMo : Current pose.
+  \param w : Array of getNbFeatures() weights, or NULL to use unit weights.
+  \param LTL : 6x6 matrix \f$ (\mathbf{W} \mathbf{L})^T (\mathbf{W} \mathbf{L}) \f$.
+  \param LTR : 6-dim vector \f$ (\mathbf{W} \mathbf{L})^T (\mathbf{W} \mathbf{e}) \f$.
+  \param nbThreads : Number of threads used to process the blocks. If 0 is used, the number of threads is the
+  default one of OpenMP.
+*/
+void vpMbtFaceDepthDense::computeNormalEquations(const vpHomogeneousMatrix &cMo, const double *const w,
+                                                 vpMatrix &LTL, vpColVector &LTR, unsigned int nbThreads)
+{
+  LTL.resize(6, 6);
+  LTR.resize(6);
 
-  if (checkSSE2) {
-#if USE_SSE
-    size_t cpt = 0;
-    if (getNbFeatures() >= 2) {
-      double *ptr_point_cloud = &m_pointCloudFace[0];
-      double *ptr_L = L.data;
-      double *ptr_error = error.data;
-
-      const __m128d vnx = _mm_set1_pd(nx);
-      const __m128d vny = _mm_set1_pd(ny);
-      const __m128d vnz = _mm_set1_pd(nz);
-      const __m128d vd = _mm_set1_pd(D);
-
-      double tmp_a1[2], tmp_a2[2], tmp_a3[2];
-
-      for (; cpt <= m_pointCloudFace.size() - 6; cpt += 6, ptr_point_cloud += 6) {
-        const __m128d vx = _mm_loadu_pd(ptr_point_cloud);
-        const __m128d vy = _mm_loadu_pd(ptr_point_cloud + 2);
-        const __m128d vz = _mm_loadu_pd(ptr_point_cloud + 4);
-
-        const __m128d va1 = _mm_sub_pd(_mm_mul_pd(vnz, vy), _mm_mul_pd(vny, vz));
-        const __m128d va2 = _mm_sub_pd(_mm_mul_pd(vnx, vz), _mm_mul_pd(vnz, vx));
-        const __m128d va3 = _mm_sub_pd(_mm_mul_pd(vny, vx), _mm_mul_pd(vnx, vy));
-
-        _mm_storeu_pd(tmp_a1, va1);
-        _mm_storeu_pd(tmp_a2, va2);
-        _mm_storeu_pd(tmp_a3, va3);
-
-        *ptr_L = nx;
-        ptr_L++;
-        *ptr_L = ny;
-        ptr_L++;
-        *ptr_L = nz;
-        ptr_L++;
-        *ptr_L = tmp_a1[0];
-        ptr_L++;
-        *ptr_L = tmp_a2[0];
-        ptr_L++;
-        *ptr_L = tmp_a3[0];
-        ptr_L++;
-
-        *ptr_L = nx;
-        ptr_L++;
-        *ptr_L = ny;
-        ptr_L++;
-        *ptr_L = nz;
-        ptr_L++;
-        *ptr_L = tmp_a1[1];
-        ptr_L++;
-        *ptr_L = tmp_a2[1];
-        ptr_L++;
-        *ptr_L = tmp_a3[1];
-        ptr_L++;
-
-        const __m128d verror =
-            _mm_add_pd(_mm_add_pd(vd, _mm_mul_pd(vnx, vx)), _mm_add_pd(_mm_mul_pd(vny, vy), _mm_mul_pd(vnz, vz)));
-        _mm_storeu_pd(ptr_error, verror);
-        ptr_error += 2;
-      }
+  const size_t nbPoints = getNbFeatures();
+  if (nbPoints == 0) {
+    return;
+  }
+
+  m_planeCamera = m_planeObject;
+  m_planeCamera.changeFrame(cMo);
+
+  const double nx = m_planeCamera.getA();
+  const double ny = m_planeCamera.getB();
+  const double nz = m_planeCamera.getC();
+  const double D = m_planeCamera.getD();
+
+  const size_t nbPairedPoints = getNbPairedPoints(m_pointCloudFace, m_pairedPointCloudFace);
+  const int nbBlocks = static_cast<int>((nbPoints + g_normalEquationsBlockSize - 1) / g_normalEquationsBlockSize);
+
+  // Per block: sum(w^2), sum(w^2 p) (3), sum(w^2 p p^T) (6), sum(w^2 e), sum(w^2 e p) (3)
+  const int nbMoments = 14;
+  std::vector<double> moments(static_cast<size_t>(nbBlocks * nbMoments), 0.0);
+
+#ifdef VISP_HAVE_OPENMP
+  int nbTeam = nbThreads == 0 ? omp_get_max_threads() : static_cast<int>(nbThreads);
+#pragma omp parallel for num_threads(nbTeam) schedule(static) if (nbTeam > 1 && nbBlocks > 1)
+#else
+  (void)nbThreads;
+#endif
+  for (int b = 0; b < nbBlocks; b++) {
+    double m[nbMoments] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    const size_t begin = static_cast<size_t>(b) * g_normalEquationsBlockSize;
+    const size_t end = std::min(begin + g_normalEquationsBlockSize, nbPoints);
+    for (size_t idx = begin; idx < end; idx++) {
+      double x, y, z;
+      getFacePoint(m_pointCloudFace, nbPairedPoints, idx, x, y, z);
+      const double w2 = w == NULL ? 1.0 : w[idx] * w[idx];
+      const double e = D + nx * x + ny * y + nz * z;
+      const double wx = w2 * x, wy = w2 * y, wz = w2 * z;
+
+      m[0] += w2;
+      m[1] += wx;
+      m[2] += wy;
+      m[3] += wz;
+      m[4] += wx * x;
+      m[5] += wx * y;
+      m[6] += wx * z;
+      m[7] += wy * y;
+      m[8] += wy * z;
+      m[9] += wz * z;
+      m[10] += w2 * e;
+      m[11] += wx * e;
+      m[12] += wy * e;
+      m[13] += wz * e;
     }
+    std::copy(m, m + nbMoments, moments.begin() + b * nbMoments);
+  }
 
-    for (; cpt < m_pointCloudFace.size(); cpt += 3) {
-      double x = m_pointCloudFace[cpt];
-      double y = m_pointCloudFace[cpt + 1];
-      double z = m_pointCloudFace[cpt + 2];
-
-      double _a1 = (nz * y) - (ny * z);
-      double _a2 = (nx * z) - (nz * x);
-      double _a3 = (ny * x) - (nx * y);
-
-      // L
-      L[(unsigned int)(cpt / 3)][0] = nx;
-      L[(unsigned int)(cpt / 3)][1] = ny;
-      L[(unsigned int)(cpt / 3)][2] = nz;
-      L[(unsigned int)(cpt / 3)][3] = _a1;
-      L[(unsigned int)(cpt / 3)][4] = _a2;
-      L[(unsigned int)(cpt / 3)][5] = _a3;
-
-      vpColVector normal(3);
-      normal[0] = nx;
-      normal[1] = ny;
-      normal[2] = nz;
-
-      vpColVector pt(3);
-      pt[0] = x;
-      pt[1] = y;
-      pt[2] = z;
-
-      // Error
-      error[(unsigned int)(cpt / 3)] = D + (normal.t() * pt);
+  double m[nbMoments] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  for (int b = 0; b < nbBlocks; b++) {
+    for (int k = 0; k < nbMoments; k++) {
+      m[k] += moments[static_cast<size_t>(b * nbMoments + k)];
     }
-#endif
-  } else {
-    vpColVector normal(3);
-    normal[0] = nx;
-    normal[1] = ny;
-    normal[2] = nz;
-    vpColVector pt(3);
-
-    unsigned int idx = 0;
-    for (size_t i = 0; i < m_pointCloudFace.size(); i += 3, idx++) {
-      double x = m_pointCloudFace[i];
-      double y = m_pointCloudFace[i + 1];
-      double z = m_pointCloudFace[i + 2];
-
-      double _a1 = (nz * y) - (ny * z);
-      double _a2 = (nx * z) - (nz * x);
-      double _a3 = (ny * x) - (nx * y);
-
-      // L
-      L[idx][0] = nx;
-      L[idx][1] = ny;
-      L[idx][2] = nz;
-      L[idx][3] = _a1;
-      L[idx][4] = _a2;
-      L[idx][5] = _a3;
-
-      pt[0] = x;
-      pt[1] = y;
-      pt[2] = z;
-      // Error
-      error[idx] = D + (normal.t() * pt);
+  }
+
+  // A row of L is [n^T (p x n)^T] = [n^T (-[n]x p)^T]
+  vpColVector n(3), sp(3), sep(3);
+  n[0] = nx;
+  n[1] = ny;
+  n[2] = nz;
+  sp[0] = m[1];
+  sp[1] = m[2];
+  sp[2] = m[3];
+  sep[0] = m[11];
+  sep[1] = m[12];
+  sep[2] = m[13];
+
+  vpMatrix Spp(3, 3);
+  Spp[0][0] = m[4];
+  Spp[0][1] = Spp[1][0] = m[5];
+  Spp[0][2] = Spp[2][0] = m[6];
+  Spp[1][1] = m[7];
+  Spp[1][2] = Spp[2][1] = m[8];
+  Spp[2][2] = m[9];
+
+  vpMatrix nx_ = vpColVector::skew(n);
+  vpMatrix Saa = nx_ * Spp * nx_.t();
+  vpColVector sa = vpColVector::crossProd(sp, n);
+  vpColVector sea = vpColVector::crossProd(sep, n);
+
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++) {
+      LTL[i][j] += m[0] * n[i] * n[j];
+      LTL[i][j + 3] += n[i] * sa[j];
+      LTL[i + 3][j] += sa[i] * n[j];
+      LTL[i + 3][j + 3] += Saa[i][j];
     }
+    LTR[i] += m[10] * n[i];
+    LTR[i + 3] += sea[i];
+  }
+}
+
+/*!
+  Compute the residual of the face for the current pose, in the same order as
+  computeInteractionMatrixAndResidu(), without building the interaction matrix.
+
+  \param cMo : Current pose.
+  \param error : Residual of the getNbFeatures() points of the face.
+*/
+void vpMbtFaceDepthDense::computeResidu(const vpHomogeneousMatrix &cMo, vpColVector &error)
+{
+  const size_t nbPoints = getNbFeatures();
+  error.resize(static_cast<unsigned int>(nbPoints), false);
+  if (nbPoints == 0) {
+    return;
+  }
+
+  m_planeCamera = m_planeObject;
+  m_planeCamera.changeFrame(cMo);
+
+  const double nx = m_planeCamera.getA();
+  const double ny = m_planeCamera.getB();
+  const double nz = m_planeCamera.getC();
+  const double D = m_planeCamera.getD();
+
+  const size_t nbPairedPoints = getNbPairedPoints(m_pointCloudFace, m_pairedPointCloudFace);
+  for (size_t idx = 0; idx < nbPoints; idx++) {
+    double x, y, z;
+    getFacePoint(m_pointCloudFace, nbPairedPoints, idx, x, y, z);
+    error[static_cast<unsigned int>(idx)] = D + nx * x + ny * y + nz * z;
   }
 }
 
@@ -33,27 +33,26 @@
  *
  *****************************************************************************/
 
-#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/mbt/vpMbtFaceDepthNormal.h>
 #include <visp3/mbt/vpMbtTukeyEstimator.h>
 
+#include "vpMbtFaceDepthSampling.h"
+
 #ifdef VISP_HAVE_PCL
 #include <pcl/common/centroid.h>
 #include <pcl/filters/extract_indices.h>
 #include <pcl/segmentation/sac_segmentation.h>
 #endif
 
-#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
-#include <emmintrin.h>
-#define VISP_HAVE_SSE2 1
-#endif
-
-#define USE_SSE_CODE 1
-#if VISP_HAVE_SSE2 && USE_SSE_CODE
-#define USE_SSE 1
-#else
-#define USE_SSE 0
-#endif
+namespace
+{
+using vpMbtFaceDepthSampling::getPointX;
+using vpMbtFaceDepthSampling::getPointY;
+using vpMbtFaceDepthSampling::getPointZ;
+using vpMbtFaceDepthSampling::getSampledRowSpans;
+using vpMbtFaceDepthSampling::usePairedLayout;
+using vpMbtFaceDepthSampling::vpFacePointGatherer;
+} // namespace
 
 vpMbtFaceDepthNormal::vpMbtFaceDepthNormal()
   : m_cam(), m_clippingFlag(vpPolygon3D::NO_CLIPPING), m_distFarClip(100), m_distNearClip(0.001), m_hiddenFace(NULL),
@@ -209,76 +208,46 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
     point_cloud_face->reserve((size_t)(bb.getWidth() * bb.getHeight()));
   }
 
-  bool checkSSE2 = vpCPUFeatures::checkSSE2();
-#if !USE_SSE
-  checkSSE2 = false;
-#else
-  bool push = false;
-  double prev_x, prev_y, prev_z;
-#endif
+  // The points of the custom method are stored by pairs for the SSE2 code of estimateFeatures()
+  const bool pairedLayout = usePairedLayout();
+  vpFacePointGatherer gatherer(point_cloud_face_custom, pairedLayout);
 
   double x = 0.0, y = 0.0;
+  std::vector<std::pair<int, int> > spans;
   for (unsigned int i = top; i < bottom; i += stepY) {
-    for (unsigned int j = left; j < right; j += stepX) {
-      if (vpMeTracker::inMask(mask, i, j) && pcl::isFinite((*point_cloud)(j, i)) && (*point_cloud)(j, i).z > 0 &&
-          (m_useScanLine ? (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
-                            j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
-                            m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-                         : polygon_2d.isInside(vpImagePoint(i, j)))) {
-
-        if (m_featureEstimationMethod == PCL_PLANE_ESTIMATION) {
-          point_cloud_face->push_back((*point_cloud)(j, i));
-        } else if (m_featureEstimationMethod == ROBUST_SVD_PLANE_ESTIMATION ||
-                   m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
-          point_cloud_face_vec.push_back((*point_cloud)(j, i).x);
-          point_cloud_face_vec.push_back((*point_cloud)(j, i).y);
-          point_cloud_face_vec.push_back((*point_cloud)(j, i).z);
-
-          if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
-            // Add point for custom method for plane equation estimation
-            vpPixelMeterConversion::convertPoint(m_cam, j, i, x, y);
-
-            if (checkSSE2) {
-#if USE_SSE
-              if (!push) {
-                push = true;
-                prev_x = x;
-                prev_y = y;
-                prev_z = (*point_cloud)(j, i).z;
-              } else {
-                push = false;
-                point_cloud_face_custom.push_back(prev_x);
-                point_cloud_face_custom.push_back(x);
-
-                point_cloud_face_custom.push_back(prev_y);
-                point_cloud_face_custom.push_back(y);
-
-                point_cloud_face_custom.push_back(prev_z);
-                point_cloud_face_custom.push_back((*point_cloud)(j, i).z);
-              }
-#endif
-            } else {
-              point_cloud_face_custom.push_back(x);
-              point_cloud_face_custom.push_back(y);
-              point_cloud_face_custom.push_back((*point_cloud)(j, i).z);
+    getSampledRowSpans(polygon_2d, m_useScanLine, i, left, right, stepX, spans);
+    for (size_t s = 0; s < spans.size(); s++) {
+      for (unsigned int j = (unsigned int)spans[s].first; j < (unsigned int)spans[s].second; j += stepX) {
+        if (vpMeTracker::inMask(mask, i, j) && pcl::isFinite((*point_cloud)(j, i)) && (*point_cloud)(j, i).z > 0 &&
+            (!m_useScanLine || (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
+                                j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
+                                m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex()))) {
+
+          if (m_featureEstimationMethod == PCL_PLANE_ESTIMATION) {
+            point_cloud_face->push_back((*point_cloud)(j, i));
+          } else if (m_featureEstimationMethod == ROBUST_SVD_PLANE_ESTIMATION ||
+                     m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
+            point_cloud_face_vec.push_back((*point_cloud)(j, i).x);
+            point_cloud_face_vec.push_back((*point_cloud)(j, i).y);
+            point_cloud_face_vec.push_back((*point_cloud)(j, i).z);
+
+            if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
+              // Add point for custom method for plane equation estimation
+              vpPixelMeterConversion::convertPoint(m_cam, j, i, x, y);
+
+              gatherer.add(x, y, (*point_cloud)(j, i).z);
             }
           }
-        }
 
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-        debugImage[i][j] = 255;
+          debugImage[i][j] = 255;
 #endif
+        }
       }
     }
   }
 
-#if USE_SSE
-  if (checkSSE2 && push) {
-    point_cloud_face_custom.push_back(prev_x);
-    point_cloud_face_custom.push_back(prev_y);
-    point_cloud_face_custom.push_back(prev_z);
-  }
-#endif
+  gatherer.finish();
 
   if (point_cloud_face->empty() && point_cloud_face_custom.empty() && point_cloud_face_vec.empty()) {
     return false;
@@ -295,7 +264,7 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
     computeDesiredFeaturesSVD(point_cloud_face_vec, cMo, desired_features, desired_normal, centroid_point);
   } else if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
     computeDesiredFeaturesRobustFeatures(point_cloud_face_custom, point_cloud_face_vec, cMo, desired_features,
-                                         desired_normal, centroid_point);
+                                         desired_normal, centroid_point, pairedLayout);
   } else {
     throw vpException(vpException::badValue, "Unknown feature estimation method!");
   }
@@ -308,17 +277,17 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
 }
 #endif
 
-bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
-                                                  unsigned int height,
-                                                  const std::vector<vpColVector> &point_cloud,
-                                                  vpColVector &desired_features, unsigned int stepX,
-                                                  unsigned int stepY
+template <class PointCloud>
+bool vpMbtFaceDepthNormal::computeDesiredFeaturesImpl(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                      unsigned int height, const PointCloud &point_cloud,
+                                                      vpColVector &desired_features, unsigned int stepX,
+                                                      unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-                                                  ,
-                                                  vpImage<unsigned char> &debugImage,
-                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                                      ,
+                                                      vpImage<unsigned char> &debugImage,
+                                                      std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-                                                  , const vpImage<bool> *mask
+                                                      , const vpImage<bool> *mask
 )
 {
   m_faceActivated = false;
@@ -364,71 +333,41 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
     point_cloud_face_custom.reserve((size_t)(3 * bb.getWidth() * bb.getHeight()));
   }
 
-  bool checkSSE2 = vpCPUFeatures::checkSSE2();
-#if !USE_SSE
-  checkSSE2 = false;
-#else
-  bool push = false;
-  double prev_x, prev_y, prev_z;
-#endif
+  // The points of the custom method are stored by pairs for the SSE2 code of estimateFeatures()
+  const bool pairedLayout = usePairedLayout();
+  vpFacePointGatherer gatherer(point_cloud_face_custom, pairedLayout);
 
   double x = 0.0, y = 0.0;
+  std::vector<std::pair<int, int> > spans;
   for (unsigned int i = top; i < bottom; i += stepY) {
-    for (unsigned int j = left; j < right; j += stepX) {
-      if (vpMeTracker::inMask(mask, i, j) && point_cloud[i * width + j][2] > 0 &&
-          (m_useScanLine ? (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
-                            j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
-                            m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-                         : polygon_2d.isInside(vpImagePoint(i, j)))) {
-        // Add point
-        point_cloud_face.push_back(point_cloud[i * width + j][0]);
-        point_cloud_face.push_back(point_cloud[i * width + j][1]);
-        point_cloud_face.push_back(point_cloud[i * width + j][2]);
-
-        if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
-          // Add point for custom method for plane equation estimation
-          vpPixelMeterConversion::convertPoint(m_cam, j, i, x, y);
-
-          if (checkSSE2) {
-#if USE_SSE
-            if (!push) {
-              push = true;
-              prev_x = x;
-              prev_y = y;
-              prev_z = point_cloud[i * width + j][2];
-            } else {
-              push = false;
-              point_cloud_face_custom.push_back(prev_x);
-              point_cloud_face_custom.push_back(x);
-
-              point_cloud_face_custom.push_back(prev_y);
-              point_cloud_face_custom.push_back(y);
-
-              point_cloud_face_custom.push_back(prev_z);
-              point_cloud_face_custom.push_back(point_cloud[i * width + j][2]);
-            }
-#endif
-          } else {
-            point_cloud_face_custom.push_back(x);
-            point_cloud_face_custom.push_back(y);
-            point_cloud_face_custom.push_back(point_cloud[i * width + j][2]);
+    getSampledRowSpans(polygon_2d, m_useScanLine, i, left, right, stepX, spans);
+    for (size_t s = 0; s < spans.size(); s++) {
+      for (unsigned int j = (unsigned int)spans[s].first; j < (unsigned int)spans[s].second; j += stepX) {
+        if (vpMeTracker::inMask(mask, i, j) && getPointZ(point_cloud, i * width + j) > 0 &&
+            (!m_useScanLine || (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
+                                j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
+                                m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex()))) {
+          // Add point
+          point_cloud_face.push_back(getPointX(point_cloud, i * width + j));
+          point_cloud_face.push_back(getPointY(point_cloud, i * width + j));
+          point_cloud_face.push_back(getPointZ(point_cloud, i * width + j));
+
+          if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
+            // Add point for custom method for plane equation estimation
+            vpPixelMeterConversion::convertPoint(m_cam, j, i, x, y);
+
+            gatherer.add(x, y, getPointZ(point_cloud, i * width + j));
           }
-        }
 
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-        debugImage[i][j] = 255;
+          debugImage[i][j] = 255;
 #endif
+        }
       }
     }
   }
 
-#if USE_SSE
-  if (checkSSE2 && push) {
-    point_cloud_face_custom.push_back(prev_x);
-    point_cloud_face_custom.push_back(prev_y);
-    point_cloud_face_custom.push_back(prev_z);
-  }
-#endif
+  gatherer.finish();
 
   if (point_cloud_face.empty() && point_cloud_face_custom.empty()) {
     return false;
@@ -454,7 +393,7 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
     computeDesiredFeaturesSVD(point_cloud_face, cMo, desired_features, desired_normal, centroid_point);
   } else if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
     computeDesiredFeaturesRobustFeatures(point_cloud_face_custom, point_cloud_face, cMo, desired_features,
-                                         desired_normal, centroid_point);
+                                         desired_normal, centroid_point, pairedLayout);
   } else {
     throw vpException(vpException::badValue, "Unknown feature estimation method!");
   }
@@ -466,6 +405,52 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
   return true;
 }
 
+bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                  unsigned int height,
+                                                  const std::vector<vpColVector> &point_cloud,
+                                                  vpColVector &desired_features, unsigned int stepX,
+                                                  unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                  ,
+                                                  vpImage<unsigned char> &debugImage,
+                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                  , const vpImage<bool> *mask
+)
+{
+  return computeDesiredFeaturesImpl(cMo, width, height, point_cloud, desired_features, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                    ,
+                                    debugImage, roiPts_vec
+#endif
+                                    , mask);
+}
+
+bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                  unsigned int height, const vpPointCloud<float> &point_cloud,
+                                                  vpColVector &desired_features, unsigned int stepX,
+                                                  unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                  ,
+                                                  vpImage<unsigned char> &debugImage,
+                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                  , const vpImage<bool> *mask
+)
+{
+  if (width != point_cloud.getWidth() || height != point_cloud.getHeight()) {
+    throw vpException(vpException::dimensionError, "Point cloud size (%dx%d) differs from %dx%d",
+                      point_cloud.getWidth(), point_cloud.getHeight(), width, height);
+  }
+
+  return computeDesiredFeaturesImpl(cMo, width, height, point_cloud, desired_features, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                    ,
+                                    debugImage, roiPts_vec
+#endif
+                                    , mask);
+}
+
 #ifdef VISP_HAVE_PCL
 bool vpMbtFaceDepthNormal::computeDesiredFeaturesPCL(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud_face,
                                                      vpColVector &desired_features, vpColVector &desired_normal,
@@ -539,11 +524,11 @@ void vpMbtFaceDepthNormal::computeDesiredFeaturesRobustFeatures(const std::vecto
                                                                 const vpHomogeneousMatrix &cMo,
                                                                 vpColVector &desired_features,
                                                                 vpColVector &desired_normal,
-                                                                vpColVector &centroid_point)
+                                                                vpColVector &centroid_point, bool pairedLayout)
 {
   std::vector<double> weights;
   double den = 0.0;
-  estimateFeatures(point_cloud_face_custom, cMo, desired_features, weights);
+  estimateFeatures(point_cloud_face_custom, cMo, desired_features, weights, pairedLayout);
 
   // Compute face centroid
   for (size_t i = 0; i < point_cloud_face.size() / 3; i++) {
@@ -1043,7 +1028,7 @@ void vpMbtFaceDepthNormal::displayFeature(const vpImage<vpRGBa> &I, const vpHomo
 }
 
 void vpMbtFaceDepthNormal::estimateFeatures(const std::vector<double> &point_cloud_face, const vpHomogeneousMatrix &cMo,
-                                            vpColVector &x_estimated, std::vector<double> &w)
+                                            vpColVector &x_estimated, std::vector<double> &w, bool pairedLayout)
 {
   vpMbtTukeyEstimator<double> tukey_robust;
   std::vector<double> residues(point_cloud_face.size() / 3);
@@ -1056,13 +1041,10 @@ void vpMbtFaceDepthNormal::estimateFeatures(const std::vector<double> &point_clo
 
   Mat33<double> ATA_3x3;
 
-  bool checkSSE2 = vpCPUFeatures::checkSSE2();
-#if !USE_SSE
-  checkSSE2 = false;
-#endif
-
-  if (checkSSE2) {
-#if USE_SSE
+  // The SSE2 code reads the points stored by pairs (x0 x1 y0 y1 Z0 Z1), the remaining odd point being stored as
+  // (x y Z), see vpMbtFaceDepthSampling::usePairedLayout()
+  if (pairedLayout) {
+#if VP_MBT_FACE_DEPTH_SAMPLING_SSE2
     while (std::fabs(error - prev_error) > 1e-6 && (iter < max_iter)) {
       if (iter == 0) {
         // Transform the plane equation for the current pose
@@ -0,0 +1,285 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Sampling of the point cloud of a depth face (internal helpers).
+ *
+ *****************************************************************************/
+
+#ifndef _vpMbtFaceDepthSampling_h_
+#define _vpMbtFaceDepthSampling_h_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpPointCloud.h>
+#include <visp3/core/vpPolygon.h>
+#include <visp3/mbt/vpMbtFaceDepthDense.h>
+#include <visp3/me/vpMeTracker.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VP_MBT_FACE_DEPTH_SAMPLING_SSE2 1
+#else
+#define VP_MBT_FACE_DEPTH_SAMPLING_SSE2 0
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace vpMbtFaceDepthSampling
+{
+// Uniform access to the coordinates of the point at index idx of an organized point cloud
+inline double getPointX(const std::vector<vpColVector> &point_cloud, unsigned int idx) { return point_cloud[idx][0]; }
+inline double getPointY(const std::vector<vpColVector> &point_cloud, unsigned int idx) { return point_cloud[idx][1]; }
+inline double getPointZ(const std::vector<vpColVector> &point_cloud, unsigned int idx) { return point_cloud[idx][2]; }
+
+template <class Type> inline double getPointX(const vpPointCloud<Type> &point_cloud, unsigned int idx)
+{
+  return static_cast<double>(point_cloud.getX()[idx]);
+}
+template <class Type> inline double getPointY(const vpPointCloud<Type> &point_cloud, unsigned int idx)
+{
+  return static_cast<double>(point_cloud.getY()[idx]);
+}
+template <class Type> inline double getPointZ(const vpPointCloud<Type> &point_cloud, unsigned int idx)
+{
+  return static_cast<double>(point_cloud.getZ()[idx]);
+}
+
+inline double getPointX(const vpMbtDepthImagePointCloud &point_cloud, unsigned int idx)
+{
+  return point_cloud.getX(idx);
+}
+inline double getPointY(const vpMbtDepthImagePointCloud &point_cloud, unsigned int idx)
+{
+  return point_cloud.getY(idx);
+}
+inline double getPointZ(const vpMbtDepthImagePointCloud &point_cloud, unsigned int idx)
+{
+  return point_cloud.getZ(idx);
+}
+
+// True if the points of a face are stored by pairs for the SSE2 code. The layout follows the SIMD level of
+// vpCPUFeatures, so that VISP_SIMD=none or vpCPUFeatures::setSimdLevel() also disable the SSE2 code.
+inline bool usePairedLayout()
+{
+#if VP_MBT_FACE_DEPTH_SAMPLING_SSE2
+  return vpCPUFeatures::checkSimdLevel(vpCPUFeatures::SIMD_SSE2);
+#else
+  return false;
+#endif
+}
+
+// Restrict the sampling of row i to the columns of the face: the spans of the
+// polygon clipped to [left, right), starting on the grid left + k * stepX. When
+// the scanline renderer is used, visibility is tested per pixel instead.
+inline void getSampledRowSpans(const vpPolygon &polygon, bool useScanLine, unsigned int i, unsigned int left,
+                               unsigned int right, unsigned int stepX, std::vector<std::pair<int, int> > &spans)
+{
+  if (useScanLine) {
+    spans.assign(1, std::make_pair((int)left, (int)right));
+    return;
+  }
+
+  polygon.getRowSpans((int)i, spans);
+  size_t nbSpans = 0;
+  for (size_t k = 0; k < spans.size(); k++) {
+    int jmin = std::max(spans[k].first, (int)left);
+    int jmax = std::min(spans[k].second, (int)right);
+    jmin = (int)(left + ((unsigned int)jmin - left + stepX - 1) / stepX * stepX);
+    if (jmin < jmax) {
+      spans[nbSpans++] = std::make_pair(jmin, jmax);
+    }
+  }
+  spans.resize(nbSpans);
+}
+
+// Number of pixels of the span [jmin, jmax) sampled with a step of stepX
+inline unsigned int getNbSampledPixels(unsigned int jmin, unsigned int jmax, unsigned int stepX)
+{
+  return jmin < jmax ? (jmax - jmin + stepX - 1) / stepX : 0;
+}
+
+// Append the valid points (z > 0) of a face to its point cloud. With the paired
+// layout used by the SSE2 code, the points are stored by pairs (x0 x1 y0 y1 z0 z1)
+// and finish() stores the remaining odd point as (x y z). Otherwise each point is
+// stored as (x y z).
+class vpFacePointGatherer
+{
+public:
+  vpFacePointGatherer(std::vector<double> &points, bool paired)
+    : m_points(points), m_paired(paired), m_pending(false), m_prevX(0.0), m_prevY(0.0), m_prevZ(0.0)
+  {
+  }
+
+  inline void add(double x, double y, double z)
+  {
+    if (!m_paired) {
+      m_points.push_back(x);
+      m_points.push_back(y);
+      m_points.push_back(z);
+    } else if (!m_pending) {
+      m_pending = true;
+      m_prevX = x;
+      m_prevY = y;
+      m_prevZ = z;
+    } else {
+      m_pending = false;
+      m_points.push_back(m_prevX);
+      m_points.push_back(x);
+
+      m_points.push_back(m_prevY);
+      m_points.push_back(y);
+
+      m_points.push_back(m_prevZ);
+      m_points.push_back(z);
+    }
+  }
+
+  // Sample the span [jmin, jmax) of row i and return the number of valid points
+  template <class PointCloud>
+  unsigned int addSpan(const PointCloud &point_cloud, unsigned int width, unsigned int i, unsigned int jmin,
+                       unsigned int jmax, unsigned int stepX, const vpImage<bool> *mask)
+  {
+    return addSpanScalar(point_cloud, width, i, jmin, jmax, stepX, mask);
+  }
+
+  // The coordinates of a vpPointCloud<float> are contiguous along a row: without
+  // mask, the SSE2 code gathers four sampled pixels at once. It only runs with the
+  // paired layout, hence when usePairedLayout() is true.
+  unsigned int addSpan(const vpPointCloud<float> &point_cloud, unsigned int width, unsigned int i, unsigned int jmin,
+                       unsigned int jmax, unsigned int stepX, const vpImage<bool> *mask)
+  {
+#if VP_MBT_FACE_DEPTH_SAMPLING_SSE2
+    if (m_paired && mask == NULL) {
+      const size_t offset = (size_t)i * width;
+      const float *X = point_cloud.getX() + offset;
+      const float *Y = point_cloud.getY() + offset;
+      const float *Z = point_cloud.getZ() + offset;
+      const __m128 zero = _mm_setzero_ps();
+      unsigned int nbPoints = 0, j = jmin;
+
+      // The loads of stepX == 2 read up to j + 4 * stepX - 1
+      for (; j + 4 * stepX <= jmax; j += 4 * stepX) {
+        const __m128 z = load4(Z + j, stepX);
+        if (_mm_movemask_ps(_mm_cmpgt_ps(z, zero)) == 0xF) {
+          add4(load4(X + j, stepX), load4(Y + j, stepX), z);
+          nbPoints += 4;
+        } else {
+          nbPoints += addSpanScalar(point_cloud, width, i, j, j + 4 * stepX, stepX, mask);
+        }
+      }
+
+      return nbPoints + addSpanScalar(point_cloud, width, i, j, jmax, stepX, mask);
+    }
+#endif
+    return addSpanScalar(point_cloud, width, i, jmin, jmax, stepX, mask);
+  }
+
+  void finish()
+  {
+    if (m_pending) {
+      m_pending = false;
+      m_points.push_back(m_prevX);
+      m_points.push_back(m_prevY);
+      m_points.push_back(m_prevZ);
+    }
+  }
+
+private:
+  template <class PointCloud>
+  unsigned int addSpanScalar(const PointCloud &point_cloud, unsigned int width, unsigned int i, unsigned int jmin,
+                             unsigned int jmax, unsigned int stepX, const vpImage<bool> *mask)
+  {
+    unsigned int nbPoints = 0;
+    for (unsigned int j = jmin; j < jmax; j += stepX) {
+      if (vpMeTracker::inMask(mask, i, j) && getPointZ(point_cloud, i * width + j) > 0) {
+        nbPoints++;
+        add(getPointX(point_cloud, i * width + j), getPointY(point_cloud, i * width + j),
+            getPointZ(point_cloud, i * width + j));
+      }
+    }
+    return nbPoints;
+  }
+
+#if VP_MBT_FACE_DEPTH_SAMPLING_SSE2
+  static inline __m128 load4(const float *ptr, unsigned int stepX)
+  {
+    if (stepX == 1) {
+      return _mm_loadu_ps(ptr);
+    } else if (stepX == 2) {
+      return _mm_shuffle_ps(_mm_loadu_ps(ptr), _mm_loadu_ps(ptr + 4), _MM_SHUFFLE(2, 0, 2, 0));
+    }
+    return _mm_setr_ps(ptr[0], ptr[stepX], ptr[2 * stepX], ptr[3 * stepX]);
+  }
+
+  // Store the points a, b, c, d as the pairs (a b) (c d), or as (prev a) (b c)
+  // when a point is pending, d becoming the pending point
+  inline void add4(const __m128 &x, const __m128 &y, const __m128 &z)
+  {
+    __m128d lo[3] = {_mm_cvtps_pd(x), _mm_cvtps_pd(y), _mm_cvtps_pd(z)};
+    __m128d hi[3] = {_mm_cvtps_pd(_mm_movehl_ps(x, x)), _mm_cvtps_pd(_mm_movehl_ps(y, y)),
+                     _mm_cvtps_pd(_mm_movehl_ps(z, z))};
+
+    if (m_pending) {
+      double prev[3] = {m_prevX, m_prevY, m_prevZ};
+      for (int k = 0; k < 3; k++) {
+        const __m128d first = _mm_unpacklo_pd(_mm_set_sd(prev[k]), lo[k]);
+        const __m128d second = _mm_shuffle_pd(lo[k], hi[k], 1);
+        prev[k] = _mm_cvtsd_f64(_mm_unpackhi_pd(hi[k], hi[k]));
+        lo[k] = first;
+        hi[k] = second;
+      }
+      m_prevX = prev[0];
+      m_prevY = prev[1];
+      m_prevZ = prev[2];
+    }
+
+    const size_t size = m_points.size();
+    m_points.resize(size + 12);
+    double *ptr = &m_points[size];
+    for (int k = 0; k < 3; k++) {
+      _mm_storeu_pd(ptr + 2 * k, lo[k]);
+      _mm_storeu_pd(ptr + 6 + 2 * k, hi[k]);
+    }
+  }
+#endif
+
+  std::vector<double> &m_points;
+  bool m_paired;
+  bool m_pending;
+  double m_prevX, m_prevY, m_prevZ;
+};
+} // namespace vpMbtFaceDepthSampling
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
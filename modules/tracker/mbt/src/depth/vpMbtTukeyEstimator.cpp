@@ -0,0 +1,232 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * SIMD kernels of the Tukey M-estimator.
+ *
+ *****************************************************************************/
+
+#include <cmath>
+
+#include <visp3/core/vpSimdDispatch.h>
+#include <visp3/mbt/vpMbtTukeyEstimator.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+template <typename T> void absDiff_scalar(const T *x, T med, T *y, size_t n)
+{
+  for (size_t i = 0; i < n; i++) {
+    y[i] = std::fabs(x[i] - med);
+  }
+}
+
+template <typename T> void psiTukey_scalar(T C, const T *x, T *w, size_t n)
+{
+  for (size_t i = 0; i < n; i++) {
+    T xi = x[i] / C;
+    xi *= xi;
+
+    if (xi > 1.) {
+      w[i] = 0;
+    } else {
+      xi = 1 - xi;
+      xi *= xi;
+      w[i] = xi;
+    }
+  }
+}
+
+// The weights are computed with the same operations as the scalar code, without FMA, and set to 0 when
+// (x / C)^2 > 1 is true, so that NaN gives NaN as in the scalar code.
+#if VISP_HAVE_SIMD_DISPATCH
+VISP_SIMD_TARGET_SSE2 void absDiff_sse2(const float *x, float med, float *y, size_t n)
+{
+  const __m128 vmed = _mm_set1_ps(med);
+  const __m128 vsign = _mm_set1_ps(-0.f);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(y + i, _mm_andnot_ps(vsign, _mm_sub_ps(_mm_loadu_ps(x + i), vmed)));
+  }
+  absDiff_scalar(x + i, med, y + i, n - i);
+}
+
+VISP_SIMD_TARGET_SSE2 void absDiff_sse2(const double *x, double med, double *y, size_t n)
+{
+  const __m128d vmed = _mm_set1_pd(med);
+  const __m128d vsign = _mm_set1_pd(-0.0);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(y + i, _mm_andnot_pd(vsign, _mm_sub_pd(_mm_loadu_pd(x + i), vmed)));
+  }
+  absDiff_scalar(x + i, med, y + i, n - i);
+}
+
+VISP_SIMD_TARGET_SSE2 void psiTukey_sse2(float C, const float *x, float *w, size_t n)
+{
+  const __m128 vC = _mm_set1_ps(C);
+  const __m128 vone = _mm_set1_ps(1.f);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 xi = _mm_div_ps(_mm_loadu_ps(x + i), vC);
+    xi = _mm_mul_ps(xi, xi);
+    const __m128 inlier = _mm_cmpngt_ps(xi, vone);
+    xi = _mm_sub_ps(vone, xi);
+    _mm_storeu_ps(w + i, _mm_and_ps(inlier, _mm_mul_ps(xi, xi)));
+  }
+  psiTukey_scalar(C, x + i, w + i, n - i);
+}
+
+VISP_SIMD_TARGET_SSE2 void psiTukey_sse2(double C, const double *x, double *w, size_t n)
+{
+  const __m128d vC = _mm_set1_pd(C);
+  const __m128d vone = _mm_set1_pd(1.0);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d xi = _mm_div_pd(_mm_loadu_pd(x + i), vC);
+    xi = _mm_mul_pd(xi, xi);
+    const __m128d inlier = _mm_cmpngt_pd(xi, vone);
+    xi = _mm_sub_pd(vone, xi);
+    _mm_storeu_pd(w + i, _mm_and_pd(inlier, _mm_mul_pd(xi, xi)));
+  }
+  psiTukey_scalar(C, x + i, w + i, n - i);
+}
+#endif
+
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+VISP_SIMD_TARGET_AVX void absDiff_avx(const float *x, float med, float *y, size_t n)
+{
+  const __m256 vmed = _mm256_set1_ps(med);
+  const __m256 vsign = _mm256_set1_ps(-0.f);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(y + i, _mm256_andnot_ps(vsign, _mm256_sub_ps(_mm256_loadu_ps(x + i), vmed)));
+  }
+  absDiff_scalar(x + i, med, y + i, n - i);
+}
+
+VISP_SIMD_TARGET_AVX void absDiff_avx(const double *x, double med, double *y, size_t n)
+{
+  const __m256d vmed = _mm256_set1_pd(med);
+  const __m256d vsign = _mm256_set1_pd(-0.0);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(y + i, _mm256_andnot_pd(vsign, _mm256_sub_pd(_mm256_loadu_pd(x + i), vmed)));
+  }
+  absDiff_scalar(x + i, med, y + i, n - i);
+}
+
+VISP_SIMD_TARGET_AVX void psiTukey_avx(float C, const float *x, float *w, size_t n)
+{
+  const __m256 vC = _mm256_set1_ps(C);
+  const __m256 vone = _mm256_set1_ps(1.f);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 xi = _mm256_div_ps(_mm256_loadu_ps(x + i), vC);
+    xi = _mm256_mul_ps(xi, xi);
+    const __m256 inlier = _mm256_cmp_ps(xi, vone, _CMP_NGT_UQ);
+    xi = _mm256_sub_ps(vone, xi);
+    _mm256_storeu_ps(w + i, _mm256_and_ps(inlier, _mm256_mul_ps(xi, xi)));
+  }
+  psiTukey_scalar(C, x + i, w + i, n - i);
+}
+
+VISP_SIMD_TARGET_AVX void psiTukey_avx(double C, const double *x, double *w, size_t n)
+{
+  const __m256d vC = _mm256_set1_pd(C);
+  const __m256d vone = _mm256_set1_pd(1.0);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d xi = _mm256_div_pd(_mm256_loadu_pd(x + i), vC);
+    xi = _mm256_mul_pd(xi, xi);
+    const __m256d inlier = _mm256_cmp_pd(xi, vone, _CMP_NGT_UQ);
+    xi = _mm256_sub_pd(vone, xi);
+    _mm256_storeu_pd(w + i, _mm256_and_pd(inlier, _mm256_mul_pd(xi, xi)));
+  }
+  psiTukey_scalar(C, x + i, w + i, n - i);
+}
+#endif
+
+typedef void (*AbsDiffFloatFunc)(const float *, float, float *, size_t);
+typedef void (*AbsDiffDoubleFunc)(const double *, double, double *, size_t);
+typedef void (*PsiTukeyFloatFunc)(float, const float *, float *, size_t);
+typedef void (*PsiTukeyDoubleFunc)(double, const double *, double *, size_t);
+
+const vpSimdDispatcher<AbsDiffFloatFunc> absDiff_float = vpSimdDispatcher<AbsDiffFloatFunc>(absDiff_scalar<float>)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, absDiff_sse2)
+#endif
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+    .add(vpCPUFeatures::SIMD_AVX, absDiff_avx)
+#endif
+    ;
+
+const vpSimdDispatcher<AbsDiffDoubleFunc> absDiff_double = vpSimdDispatcher<AbsDiffDoubleFunc>(absDiff_scalar<double>)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, absDiff_sse2)
+#endif
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+    .add(vpCPUFeatures::SIMD_AVX, absDiff_avx)
+#endif
+    ;
+
+const vpSimdDispatcher<PsiTukeyFloatFunc> psiTukey_float = vpSimdDispatcher<PsiTukeyFloatFunc>(psiTukey_scalar<float>)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, psiTukey_sse2)
+#endif
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+    .add(vpCPUFeatures::SIMD_AVX, psiTukey_avx)
+#endif
+    ;
+
+const vpSimdDispatcher<PsiTukeyDoubleFunc> psiTukey_double = vpSimdDispatcher<PsiTukeyDoubleFunc>(psiTukey_scalar<double>)
+#if VISP_HAVE_SIMD_DISPATCH
+    .add(vpCPUFeatures::SIMD_SSE2, psiTukey_sse2)
+#endif
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+    .add(vpCPUFeatures::SIMD_AVX, psiTukey_avx)
+#endif
+    ;
+} // namespace
+
+void vpMbtTukeyKernels::absDiff(const float *x, float med, float *y, size_t n) { absDiff_float.get()(x, med, y, n); }
+
+void vpMbtTukeyKernels::absDiff(const double *x, double med, double *y, size_t n)
+{
+  absDiff_double.get()(x, med, y, n);
+}
+
+void vpMbtTukeyKernels::psiTukey(float C, const float *x, float *w, size_t n) { psiTukey_float.get()(C, x, w, n); }
+
+void vpMbtTukeyKernels::psiTukey(double C, const double *x, double *w, size_t n)
+{
+  psiTukey_double.get()(C, x, w, n);
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
@@ -68,10 +68,10 @@
 */
 vpMbEdgeTracker::vpMbEdgeTracker()
   : me(), lines(1), circles(1), cylinders(1), nline(0), ncircle(0), ncylinder(0), nbvisiblepolygone(0),
-    percentageGdPt(0.4), scales(1), Ipyramid(0), scaleLevel(0), nbFeaturesForProjErrorComputation(0), m_factor(),
+    percentageGdPt(0.4), scales(1), Ipyramid(0), m_pyramid(), scaleLevel(0), nbFeaturesForProjErrorComputation(0), m_factor(),
     m_robustLines(), m_robustCylinders(), m_robustCircles(), m_wLines(), m_wCylinders(), m_wCircles(), m_errorLines(),
     m_errorCylinders(), m_errorCircles(), m_L_edge(), m_error_edge(), m_w_edge(), m_weightedError_edge(),
-    m_robust_edge(), m_featuresToBeDisplayedEdge()
+    m_robust_edge(), m_featuresToBeDisplayedEdge(), m_meNbThreads(1)
 {
   scales[0] = true;
 
@@ -323,13 +323,13 @@ void vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char> &_I, uns
         }
       }
 
-      std::list<vpMeSite>::const_iterator itListLine;
+      std::vector<vpMeSite>::const_iterator itListLine;
 
       unsigned int indexFeature = 0;
 
       for (size_t a = 0; a < l->meline.size(); a++) {
         if (iter == 0 && l->meline[a] != NULL)
-          itListLine = l->meline[a]->getMeList().begin();
+          itListLine = l->meline[a]->getMeSites().begin();
 
         for (unsigned int i = 0; i < l->nbFeature[a]; i++) {
           for (unsigned int j = 0; j < 6; j++) {
@@ -396,11 +396,11 @@ void vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char> &_I, uns
       cy->computeInteractionMatrixError(m_cMo, _I);
       double fac = 1.0;
 
-      std::list<vpMeSite>::const_iterator itCyl1;
-      std::list<vpMeSite>::const_iterator itCyl2;
+      std::vector<vpMeSite>::const_iterator itCyl1;
+      std::vector<vpMeSite>::const_iterator itCyl2;
       if (iter == 0 && (cy->meline1 != NULL || cy->meline2 != NULL)) {
-        itCyl1 = cy->meline1->getMeList().begin();
-        itCyl2 = cy->meline2->getMeList().begin();
+        itCyl1 = cy->meline1->getMeSites().begin();
+        itCyl2 = cy->meline2->getMeSites().begin();
       }
 
       for (unsigned int i = 0; i < cy->nbFeature; i++) {
@@ -490,9 +490,9 @@ void vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char> &_I, uns
       ci->computeInteractionMatrixError(m_cMo);
       double fac = 1.0;
 
-      std::list<vpMeSite>::const_iterator itCir;
+      std::vector<vpMeSite>::const_iterator itCir;
       if (iter == 0 && (ci->meEllipse != NULL)) {
-        itCir = ci->meEllipse->getMeList().begin();
+        itCir = ci->meEllipse->getMeSites().begin();
       }
 
       for (unsigned int i = 0; i < ci->nbFeature; i++) {
@@ -581,9 +581,9 @@ void vpMbEdgeTracker::computeVVSFirstPhaseFactor(const vpImage<unsigned char> &I
 
       unsigned int indexFeature = 0;
       for (size_t a = 0; a < l->meline.size(); a++) {
-        std::list<vpMeSite>::const_iterator itListLine;
+        std::vector<vpMeSite>::const_iterator itListLine;
         if (l->meline[a] != NULL) {
-          itListLine = l->meline[a]->getMeList().begin();
+          itListLine = l->meline[a]->getMeSites().begin();
 
           for (unsigned int i = 0; i < l->nbFeature[a]; i++) {
             m_factor[n + i] = fac;
@@ -605,11 +605,11 @@ void vpMbEdgeTracker::computeVVSFirstPhaseFactor(const vpImage<unsigned char> &I
       cy = *it;
       cy->computeInteractionMatrixError(m_cMo, I);
 
-      std::list<vpMeSite>::const_iterator itCyl1;
-      std::list<vpMeSite>::const_iterator itCyl2;
+      std::vector<vpMeSite>::const_iterator itCyl1;
+      std::vector<vpMeSite>::const_iterator itCyl2;
       if ((cy->meline1 != NULL || cy->meline2 != NULL)) {
-        itCyl1 = cy->meline1->getMeList().begin();
-        itCyl2 = cy->meline2->getMeList().begin();
+        itCyl1 = cy->meline1->getMeSites().begin();
+        itCyl2 = cy->meline2->getMeSites().begin();
 
         double fac = 1.0;
         for (unsigned int i = 0; i < cy->nbFeature; i++) {
@@ -635,9 +635,9 @@ void vpMbEdgeTracker::computeVVSFirstPhaseFactor(const vpImage<unsigned char> &I
       ci = *it;
       ci->computeInteractionMatrixError(m_cMo);
 
-      std::list<vpMeSite>::const_iterator itCir;
+      std::vector<vpMeSite>::const_iterator itCir;
       if (ci->meEllipse != NULL) {
-        itCir = ci->meEllipse->getMeList().begin();
+        itCir = ci->meEllipse->getMeSites().begin();
         double fac = 1.0;
 
         for (unsigned int i = 0; i < ci->nbFeature; i++) {
@@ -706,7 +706,7 @@ void vpMbEdgeTracker::computeVVSFirstPhasePoseEstimation(unsigned int iter, bool
   vpColVector LTR;
 
   if (isoJoIdentity_) {
-    LTL = m_L_edge.AtA();
+    m_L_edge.AtA(LTL);
     computeJTR(m_L_edge, m_weightedError_edge, LTR);
     v = -0.7 * LTL.pseudoInverse(LTL.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
   } else {
@@ -949,8 +949,8 @@ void vpMbEdgeTracker::testTracking()
       for (size_t a = 0; a < l->meline.size(); a++) {
         if (l->meline[a] != NULL) {
           nbExpectedPoint += (int)l->meline[a]->expecteddensity;
-          for (std::list<vpMeSite>::const_iterator itme = l->meline[a]->getMeList().begin();
-               itme != l->meline[a]->getMeList().end(); ++itme) {
+          for (std::vector<vpMeSite>::const_iterator itme = l->meline[a]->getMeSites().begin();
+               itme != l->meline[a]->getMeSites().end(); ++itme) {
             vpMeSite pix = *itme;
             if (pix.getState() == vpMeSite::NO_SUPPRESSION)
               nbGoodPoint++;
@@ -967,8 +967,8 @@ void vpMbEdgeTracker::testTracking()
     vpMbtDistanceCylinder *cy = *it;
     if ((cy->meline1 != NULL && cy->meline2 != NULL) && cy->isVisible() && cy->isTracked()) {
       nbExpectedPoint += (int)cy->meline1->expecteddensity;
-      for (std::list<vpMeSite>::const_iterator itme1 = cy->meline1->getMeList().begin();
-           itme1 != cy->meline1->getMeList().end(); ++itme1) {
+      for (std::vector<vpMeSite>::const_iterator itme1 = cy->meline1->getMeSites().begin();
+           itme1 != cy->meline1->getMeSites().end(); ++itme1) {
         vpMeSite pix = *itme1;
         if (pix.getState() == vpMeSite::NO_SUPPRESSION)
           nbGoodPoint++;
@@ -976,8 +976,8 @@ void vpMbEdgeTracker::testTracking()
           nbBadPoint++;
       }
       nbExpectedPoint += (int)cy->meline2->expecteddensity;
-      for (std::list<vpMeSite>::const_iterator itme2 = cy->meline2->getMeList().begin();
-           itme2 != cy->meline2->getMeList().end(); ++itme2) {
+      for (std::vector<vpMeSite>::const_iterator itme2 = cy->meline2->getMeSites().begin();
+           itme2 != cy->meline2->getMeSites().end(); ++itme2) {
         vpMeSite pix = *itme2;
         if (pix.getState() == vpMeSite::NO_SUPPRESSION)
           nbGoodPoint++;
@@ -992,8 +992,8 @@ void vpMbEdgeTracker::testTracking()
     vpMbtDistanceCircle *ci = *it;
     if (ci->isVisible() && ci->isTracked() && ci->meEllipse != NULL) {
       nbExpectedPoint += ci->meEllipse->getExpectedDensity();
-      for (std::list<vpMeSite>::const_iterator itme = ci->meEllipse->getMeList().begin();
-           itme != ci->meEllipse->getMeList().end(); ++itme) {
+      for (std::vector<vpMeSite>::const_iterator itme = ci->meEllipse->getMeSites().begin();
+           itme != ci->meEllipse->getMeSites().end(); ++itme) {
         vpMeSite pix = *itme;
         if (pix.getState() == vpMeSite::NO_SUPPRESSION)
           nbGoodPoint++;
@@ -1634,6 +1634,11 @@ void vpMbEdgeTracker::initMovingEdge(const vpImage<unsigned char> &I, const vpHo
 void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
 {
   const bool doNotTrack = false;
+  const bool sitesTracked = true;
+
+  // Initialize the moving edges of the features that have none and gather
+  // the moving edges of all the features to track
+  std::vector<vpMeTracker *> meTrackers;
 
   for (std::list<vpMbtDistanceLine *>::const_iterator it = lines[scaleLevel].begin(); it != lines[scaleLevel].end();
        ++it) {
@@ -1642,7 +1647,7 @@ void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
       if (l->meline.empty()) {
         l->initMovingEdge(I, m_cMo, doNotTrack, m_mask);
       }
-      l->trackMovingEdge(I);
+      meTrackers.insert(meTrackers.end(), l->meline.begin(), l->meline.end());
     }
   }
 
@@ -1653,7 +1658,8 @@ void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
       if (cy->meline1 == NULL || cy->meline2 == NULL) {
         cy->initMovingEdge(I, m_cMo, doNotTrack, m_mask);
       }
-      cy->trackMovingEdge(I, m_cMo);
+      meTrackers.push_back(cy->meline1);
+      meTrackers.push_back(cy->meline2);
     }
   }
 
@@ -1664,7 +1670,35 @@ void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
       if (ci->meEllipse == NULL) {
         ci->initMovingEdge(I, m_cMo, doNotTrack, m_mask);
       }
-      ci->trackMovingEdge(I, m_cMo);
+      meTrackers.push_back(ci->meEllipse);
+    }
+  }
+
+  // Search the sites of all the features at once
+  vpMeTracker::trackBatch(I, meTrackers, m_meNbThreads);
+
+  // Update the features from their tracked sites
+  for (std::list<vpMbtDistanceLine *>::const_iterator it = lines[scaleLevel].begin(); it != lines[scaleLevel].end();
+       ++it) {
+    vpMbtDistanceLine *l = *it;
+    if (l->isVisible() && l->isTracked()) {
+      l->trackMovingEdge(I, sitesTracked);
+    }
+  }
+
+  for (std::list<vpMbtDistanceCylinder *>::const_iterator it = cylinders[scaleLevel].begin();
+       it != cylinders[scaleLevel].end(); ++it) {
+    vpMbtDistanceCylinder *cy = *it;
+    if (cy->isVisible() && cy->isTracked()) {
+      cy->trackMovingEdge(I, m_cMo, sitesTracked);
+    }
+  }
+
+  for (std::list<vpMbtDistanceCircle *>::const_iterator it = circles[scaleLevel].begin();
+       it != circles[scaleLevel].end(); ++it) {
+    vpMbtDistanceCircle *ci = *it;
+    if (ci->isVisible() && ci->isTracked()) {
+      ci->trackMovingEdge(I, m_cMo, sitesTracked);
     }
   }
 }
@@ -1726,8 +1760,8 @@ void vpMbEdgeTracker::updateMovingEdgeWeights()
       double wmean = 0;
       for (size_t a = 0; a < l->meline.size(); a++) {
         if (l->nbFeature[a] > 0) {
-          std::list<vpMeSite>::iterator itListLine;
-          itListLine = l->meline[a]->getMeList().begin();
+          std::vector<vpMeSite>::iterator itListLine;
+          itListLine = l->meline[a]->getMeSites().begin();
 
           for (unsigned int i = 0; i < l->nbFeature[a]; i++) {
             wmean += m_w_edge[n + indexLine];
@@ -1764,12 +1798,12 @@ void vpMbEdgeTracker::updateMovingEdgeWeights()
     if ((*it)->isTracked()) {
       cy = *it;
       double wmean = 0;
-      std::list<vpMeSite>::iterator itListCyl1;
-      std::list<vpMeSite>::iterator itListCyl2;
+      std::vector<vpMeSite>::iterator itListCyl1;
+      std::vector<vpMeSite>::iterator itListCyl2;
 
       if (cy->nbFeature > 0) {
-        itListCyl1 = cy->meline1->getMeList().begin();
-        itListCyl2 = cy->meline2->getMeList().begin();
+        itListCyl1 = cy->meline1->getMeSites().begin();
+        itListCyl2 = cy->meline2->getMeSites().begin();
 
         for (unsigned int i = 0; i < cy->nbFeaturel1; i++) {
           wmean += m_w_edge[n + i];
@@ -1830,10 +1864,10 @@ void vpMbEdgeTracker::updateMovingEdgeWeights()
     if ((*it)->isTracked()) {
       ci = *it;
       double wmean = 0;
-      std::list<vpMeSite>::iterator itListCir;
+      std::vector<vpMeSite>::iterator itListCir;
 
       if (ci->nbFeature > 0) {
-        itListCir = ci->meEllipse->getMeList().begin();
+        itListCir = ci->meEllipse->getMeSites().begin();
       }
 
       wmean = 0;
@@ -2524,8 +2558,8 @@ unsigned int vpMbEdgeTracker::getNbPoints(unsigned int level) const
     if (l->isVisible() && l->isTracked()) {
       for (size_t a = 0; a < l->meline.size(); a++) {
         if (l->nbFeature[a] != 0)
-          for (std::list<vpMeSite>::const_iterator itme = l->meline[a]->getMeList().begin();
-               itme != l->meline[a]->getMeList().end(); ++itme) {
+          for (std::vector<vpMeSite>::const_iterator itme = l->meline[a]->getMeSites().begin();
+               itme != l->meline[a]->getMeSites().end(); ++itme) {
             if (itme->getState() == vpMeSite::NO_SUPPRESSION)
               nbGoodPoints++;
           }
@@ -2538,13 +2572,13 @@ unsigned int vpMbEdgeTracker::getNbPoints(unsigned int level) const
        ++it) {
     cy = *it;
     if (cy->isVisible() && cy->isTracked() && (cy->meline1 != NULL || cy->meline2 != NULL)) {
-      for (std::list<vpMeSite>::const_iterator itme1 = cy->meline1->getMeList().begin();
-           itme1 != cy->meline1->getMeList().end(); ++itme1) {
+      for (std::vector<vpMeSite>::const_iterator itme1 = cy->meline1->getMeSites().begin();
+           itme1 != cy->meline1->getMeSites().end(); ++itme1) {
         if (itme1->getState() == vpMeSite::NO_SUPPRESSION)
           nbGoodPoints++;
       }
-      for (std::list<vpMeSite>::const_iterator itme2 = cy->meline2->getMeList().begin();
-           itme2 != cy->meline2->getMeList().end(); ++itme2) {
+      for (std::vector<vpMeSite>::const_iterator itme2 = cy->meline2->getMeSites().begin();
+           itme2 != cy->meline2->getMeSites().end(); ++itme2) {
         if (itme2->getState() == vpMeSite::NO_SUPPRESSION)
           nbGoodPoints++;
       }
@@ -2555,8 +2589,8 @@ unsigned int vpMbEdgeTracker::getNbPoints(unsigned int level) const
   for (std::list<vpMbtDistanceCircle *>::const_iterator it = circles[level].begin(); it != circles[level].end(); ++it) {
     ci = *it;
     if (ci->isVisible() && ci->isTracked() && ci->meEllipse != NULL) {
-      for (std::list<vpMeSite>::const_iterator itme = ci->meEllipse->getMeList().begin();
-           itme != ci->meEllipse->getMeList().end(); ++itme) {
+      for (std::vector<vpMeSite>::const_iterator itme = ci->meEllipse->getMeSites().begin();
+           itme != ci->meEllipse->getMeSites().end(); ++itme) {
         if (itme->getState() == vpMeSite::NO_SUPPRESSION)
           nbGoodPoints++;
       }
@@ -2711,14 +2745,14 @@ void vpMbEdgeTracker::setClipping(const unsigned int &flags)
 /*!
   Compute the pyramid of image associated to the image in parameter. The
   scales computed are the ones corresponding to the scales  attribute of the
-  class. If OpenCV is detected, the functions used to computed a smoothed
-  pyramid come from OpenCV, otherwise a simple subsampling (no smoothing, no
-  interpolation) is realized.
+  class. The levels are computed with the filter set by
+  setPyramidFilterType(), by default a simple subsampling (no smoothing, no
+  interpolation).
 
-  \warning The pyramid contains pointers to vpImage. To properly deallocate
-  the pyramid. All the element but the first (which is a pointer to the input
-  image) must be freed. A proper cleaning is implemented in the cleanPyramid()
-  method.
+  The images of the pyramid are stored in the tracker and reused from one
+  call to the next, so that no memory is allocated as long as the size of
+  the input image does not change. The pointers of the pyramid remain valid
+  until the next call to this method.
 
   \param _I : The input image.
   \param _pyramid : The pyramid of image to build from the input image.
@@ -2728,58 +2762,33 @@ void vpMbEdgeTracker::initPyramid(const vpImage<unsigned char> &_I,
 {
   _pyramid.resize(scales.size());
 
-  if (scales[0]) {
-    _pyramid[0] = &_I;
-  } else {
-    _pyramid[0] = NULL;
-  }
-
-  for (unsigned int i = 1; i < _pyramid.size(); i += 1) {
+  unsigned int nbLevels = 0;
+  for (unsigned int i = 0; i < scales.size(); i += 1) {
     if (scales[i]) {
-      unsigned int cScale = static_cast<unsigned int>(pow(2., (int)i));
-      vpImage<unsigned char> *I = new vpImage<unsigned char>(_I.getHeight() / cScale, _I.getWidth() / cScale);
-#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408))
-      IplImage *vpI0 = cvCreateImageHeader(cvSize((int)_I.getWidth(), (int)_I.getHeight()), IPL_DEPTH_8U, 1);
-      vpI0->imageData = (char *)(_I.bitmap);
-      IplImage *vpI =
-          cvCreateImage(cvSize((int)(_I.getWidth() / cScale), (int)(_I.getHeight() / cScale)), IPL_DEPTH_8U, 1);
-      cvResize(vpI0, vpI, CV_INTER_NN);
-      vpImageConvert::convert(vpI, *I);
-      cvReleaseImage(&vpI);
-      vpI0->imageData = NULL;
-      cvReleaseImageHeader(&vpI0);
-#else
-      for (unsigned int k = 0, ii = 0; k < I->getHeight(); k += 1, ii += cScale) {
-        for (unsigned int l = 0, jj = 0; l < I->getWidth(); l += 1, jj += cScale) {
-          (*I)[k][l] = _I[ii][jj];
-        }
-      }
-#endif
-      _pyramid[i] = I;
-    } else {
-      _pyramid[i] = NULL;
+      nbLevels = i + 1;
     }
   }
+  m_pyramid.build(_I, nbLevels);
+
+  for (unsigned int i = 0; i < _pyramid.size(); i += 1) {
+    _pyramid[i] = scales[i] ? &m_pyramid[i] : NULL;
+  }
 }
 
 /*!
-  Clean the pyramid of image allocated with the initPyramid() method. The
-  vector has a size equal to zero at the end of the method.
+  Clean the pyramid of image built with the initPyramid() method. The
+  vector has a size equal to zero at the end of the method. The images of
+  the pyramid are owned by the tracker and are not freed, so that they can
+  be reused for the next frame.
 
   \param _pyramid : The pyramid of image to clean.
 */
 void vpMbEdgeTracker::cleanPyramid(std::vector<const vpImage<unsigned char> *> &_pyramid)
 {
-  if (_pyramid.size() > 0) {
-    _pyramid[0] = NULL;
-    for (unsigned int i = 1; i < _pyramid.size(); i += 1) {
-      if (_pyramid[i] != NULL) {
-        delete _pyramid[i];
-        _pyramid[i] = NULL;
-      }
-    }
-    _pyramid.resize(0);
+  for (unsigned int i = 0; i < _pyramid.size(); i += 1) {
+    _pyramid[i] = NULL;
   }
+  _pyramid.resize(0);
 }
 
 /*!
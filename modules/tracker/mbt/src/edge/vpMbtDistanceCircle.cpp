@@ -185,12 +185,15 @@ bool vpMbtDistanceCircle::initMovingEdge(const vpImage<unsigned char> &I, const
 
   \param I : the image.
   \param cMo : The pose of the camera.
+  \param sitesTracked : If true, the sites have already been tracked with
+  vpMeTracker::trackBatch() and only the feature is updated.
 */
-void vpMbtDistanceCircle::trackMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix & /*cMo*/)
+void vpMbtDistanceCircle::trackMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix & /*cMo*/,
+                                          bool sitesTracked)
 {
   if (isvisible) {
     try {
-      meEllipse->track(I);
+      meEllipse->track(I, sitesTracked);
     } catch (...) {
       // std::cout << "Track meEllipse failed" << std::endl;
       meEllipse->reset();
@@ -198,7 +201,7 @@ void vpMbtDistanceCircle::trackMovingEdge(const vpImage<unsigned char> &I, const
     }
 
     // Update the number of features
-    nbFeature = (unsigned int)meEllipse->getMeList().size();
+    nbFeature = (unsigned int)meEllipse->getMeSites().size();
   }
 }
 
@@ -231,7 +234,7 @@ void vpMbtDistanceCircle::updateMovingEdge(const vpImage<unsigned char> &I, cons
     } catch (...) {
       Reinit = true;
     }
-    nbFeature = (unsigned int)meEllipse->getMeList().size();
+    nbFeature = (unsigned int)meEllipse->getMeSites().size();
   }
 }
 
@@ -315,7 +318,7 @@ std::vector<std::vector<double> > vpMbtDistanceCircle::getFeaturesForDisplay()
   std::vector<std::vector<double> > features;
 
   if (meEllipse != NULL) {
-    for (std::list<vpMeSite>::const_iterator it = meEllipse->getMeList().begin(); it != meEllipse->getMeList().end(); ++it) {
+    for (std::vector<vpMeSite>::const_iterator it = meEllipse->getMeSites().begin(); it != meEllipse->getMeSites().end(); ++it) {
       vpMeSite p_me = *it;
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
       std::vector<double> params = {0, //ME
@@ -412,7 +415,7 @@ void vpMbtDistanceCircle::displayMovingEdges(const vpImage<vpRGBa> &I)
 void vpMbtDistanceCircle::initInteractionMatrixError()
 {
   if (isvisible) {
-    nbFeature = (unsigned int)meEllipse->getMeList().size();
+    nbFeature = (unsigned int)meEllipse->getMeSites().size();
     L.resize(nbFeature, 6);
     error.resize(nbFeature);
   } else
@@ -450,7 +453,7 @@ void vpMbtDistanceCircle::computeInteractionMatrixError(const vpHomogeneousMatri
 
     unsigned int j = 0;
 
-    for (std::list<vpMeSite>::const_iterator it = meEllipse->getMeList().begin(); it != meEllipse->getMeList().end();
+    for (std::vector<vpMeSite>::const_iterator it = meEllipse->getMeSites().begin(); it != meEllipse->getMeSites().end();
          ++it) {
       vpPixelMeterConversion::convertPoint(cam, it->j, it->i, x, y);
       H[0] = 2 * (n11 * (y - yg) + n02 * (xg - x));
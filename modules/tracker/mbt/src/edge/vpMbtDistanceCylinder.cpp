@@ -319,19 +319,22 @@ bool vpMbtDistanceCylinder::initMovingEdge(const vpImage<unsigned char> &I, cons
 
   \param I : the image.
   \param cMo : The pose of the camera.
+  \param sitesTracked : If true, the sites have already been tracked with
+  vpMeTracker::trackBatch() and only the feature is updated.
 */
-void vpMbtDistanceCylinder::trackMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix & /*cMo*/)
+void vpMbtDistanceCylinder::trackMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix & /*cMo*/,
+                                            bool sitesTracked)
 {
   if (isvisible) {
     try {
-      meline1->track(I);
+      meline1->track(I, sitesTracked);
     } catch (...) {
       // std::cout << "Track meline1 failed" << std::endl;
       meline1->reset();
       Reinit = true;
     }
     try {
-      meline2->track(I);
+      meline2->track(I, sitesTracked);
     } catch (...) {
       // std::cout << "Track meline2 failed" << std::endl;
       meline2->reset();
@@ -339,8 +342,8 @@ void vpMbtDistanceCylinder::trackMovingEdge(const vpImage<unsigned char> &I, con
     }
 
     // Update the number of features
-    nbFeaturel1 = (unsigned int)meline1->getMeList().size();
-    nbFeaturel2 = (unsigned int)meline2->getMeList().size();
+    nbFeaturel1 = (unsigned int)meline1->getMeSites().size();
+    nbFeaturel2 = (unsigned int)meline2->getMeSites().size();
     nbFeature = nbFeaturel1 + nbFeaturel2;
   }
 }
@@ -470,8 +473,8 @@ void vpMbtDistanceCylinder::updateMovingEdge(const vpImage<unsigned char> &I, co
     }
 
     // Update the numbers of features
-    nbFeaturel1 = (unsigned int)meline1->getMeList().size();
-    nbFeaturel2 = (unsigned int)meline2->getMeList().size();
+    nbFeaturel1 = (unsigned int)meline1->getMeSites().size();
+    nbFeaturel2 = (unsigned int)meline2->getMeSites().size();
     nbFeature = nbFeaturel1 + nbFeaturel2;
   }
 }
@@ -562,7 +565,7 @@ std::vector<std::vector<double> > vpMbtDistanceCylinder::getFeaturesForDisplay()
   std::vector<std::vector<double> > features;
 
   if (meline1 != NULL) {
-    for (std::list<vpMeSite>::const_iterator it = meline1->getMeList().begin(); it != meline1->getMeList().end(); ++it) {
+    for (std::vector<vpMeSite>::const_iterator it = meline1->getMeSites().begin(); it != meline1->getMeSites().end(); ++it) {
       vpMeSite p_me = *it;
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
       std::vector<double> params = {0, //ME
@@ -581,7 +584,7 @@ std::vector<std::vector<double> > vpMbtDistanceCylinder::getFeaturesForDisplay()
   }
 
   if (meline2 != NULL) {
-    for (std::list<vpMeSite>::const_iterator it = meline2->getMeList().begin(); it != meline2->getMeList().end(); ++it) {
+    for (std::vector<vpMeSite>::const_iterator it = meline2->getMeSites().begin(); it != meline2->getMeSites().end(); ++it) {
       vpMeSite p_me = *it;
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
       std::vector<double> params = {0, //ME
@@ -738,8 +741,8 @@ void vpMbtDistanceCylinder::displayMovingEdges(const vpImage<vpRGBa> &I)
 void vpMbtDistanceCylinder::initInteractionMatrixError()
 {
   if (isvisible) {
-    nbFeaturel1 = (unsigned int)meline1->getMeList().size();
-    nbFeaturel2 = (unsigned int)meline2->getMeList().size();
+    nbFeaturel1 = (unsigned int)meline1->getMeSites().size();
+    nbFeaturel2 = (unsigned int)meline2->getMeSites().size();
     nbFeature = nbFeaturel1 + nbFeaturel2;
     L.resize(nbFeature, 6);
     error.resize(nbFeature);
@@ -805,7 +808,7 @@ void vpMbtDistanceCylinder::computeInteractionMatrixError(const vpHomogeneousMat
 
     vpMeSite p;
     unsigned int j = 0;
-    for (std::list<vpMeSite>::const_iterator it = meline1->getMeList().begin(); it != meline1->getMeList().end();
+    for (std::vector<vpMeSite>::const_iterator it = meline1->getMeSites().begin(); it != meline1->getMeSites().end();
          ++it) {
       double x = (double)it->j;
       double y = (double)it->i;
@@ -829,7 +832,7 @@ void vpMbtDistanceCylinder::computeInteractionMatrixError(const vpHomogeneousMat
       j++;
     }
 
-    for (std::list<vpMeSite>::const_iterator it = meline2->getMeList().begin(); it != meline2->getMeList().end();
+    for (std::vector<vpMeSite>::const_iterator it = meline2->getMeSites().begin(); it != meline2->getMeSites().end();
          ++it) {
       double x = (double)it->j;
       double y = (double)it->i;
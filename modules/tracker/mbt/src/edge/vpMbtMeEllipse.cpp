@@ -106,7 +106,7 @@ void vpMbtMeEllipse::computeProjectionError(const vpImage<unsigned char> &I, dou
   vpColVector vecSite(2);
   vpColVector vecGrad(2);
 
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
     double iSite = it->ifloat;
     double jSite = it->jfloat;
 
@@ -247,11 +247,17 @@ void vpMbtMeEllipse::initTracking(const vpImage<unsigned char> &I, const vpImage
   Track the ellipse in the image I.
 
   \param I : Image in which the ellipse appears.
+  \param sitesTracked : If true, the sites have already been tracked with
+  vpMeTracker::trackBatch().
 */
-void vpMbtMeEllipse::track(const vpImage<unsigned char> &I)
+void vpMbtMeEllipse::track(const vpImage<unsigned char> &I, bool sitesTracked)
 {
   try {
-    vpMeTracker::track(I);
+    if (sitesTracked) {
+      checkTracking();
+    } else {
+      vpMeTracker::track(I);
+    }
     if (m_mask != NULL) {
       // Expected density could be modified if some vpMeSite are no more tracked because they are outside the mask.
       m_expectedDensity = static_cast<unsigned int>(list.size());
@@ -376,16 +382,6 @@ void vpMbtMeEllipse::sample(const vpImage<unsigned char> &I, bool doNotTrack)
   Suppress the vpMeSite which are no more detected as point which belongs to
   the ellipse edge.
 */
-void vpMbtMeEllipse::suppressPoints()
-{
-  // Loop through list of sites to track
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end();) {
-    vpMeSite s = *it; // current reference pixel
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
-      it = list.erase(it);
-    else
-      ++it;
-  }
-}
+void vpMbtMeEllipse::suppressPoints() { removeSuppressedSites(); }
 
 #endif // #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -206,8 +206,8 @@ void vpMbtMeLine::sample(const vpImage<unsigned char> &I, bool doNoTrack)
 */
 void vpMbtMeLine::suppressPoints(const vpImage<unsigned char> &I)
 {
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end();) {
-    vpMeSite s = *it; // current reference pixel
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+    vpMeSite &s = *it; // current reference pixel
 
     if (fabs(sin(theta)) > 0.9) // Vertical line management
     {
@@ -232,12 +232,9 @@ void vpMbtMeLine::suppressPoints(const vpImage<unsigned char> &I)
     if (outOfImage(s.i, s.j, (int)(me->getRange() + me->getMaskSize() + 1), (int)I.getHeight(), (int)I.getWidth())) {
       s.setState(vpMeSite::TOO_NEAR);
     }
-
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
-      it = list.erase(it);
-    else
-      ++it;
   }
+
+  removeSuppressedSites();
 }
 
 /*!
@@ -370,7 +367,7 @@ void vpMbtMeLine::computeProjectionError(const vpImage<unsigned char> &_I, doubl
 
   double offset = std::floor(SobelX.getRows() / 2.0f);
 
-  for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
     if (iter != 0 && iter + 1 != list.size()) {
       double gradientX = 0;
       double gradientY = 0;
@@ -547,7 +544,7 @@ void vpMbtMeLine::updateDelta()
   delta = -theta + M_PI / 2.0;
   normalizeAngle(delta);
 
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
     p_me = *it;
     p_me.alpha = delta;
     p_me.mask_sign = sign;
@@ -560,11 +557,17 @@ void vpMbtMeLine::updateDelta()
   Track the line in the image I.
 
   \param I : Image in which the line appears.
+  \param sitesTracked : If true, the sites have already been tracked with
+  vpMeTracker::trackBatch().
 */
-void vpMbtMeLine::track(const vpImage<unsigned char> &I)
+void vpMbtMeLine::track(const vpImage<unsigned char> &I, bool sitesTracked)
 {
   try {
-    vpMeTracker::track(I);
+    if (sitesTracked) {
+      checkTracking();
+    } else {
+      vpMeTracker::track(I);
+    }
     if (m_mask != NULL) {
       // Expected density could be modified if some vpMeSite are no more tracked because they are outside the mask.
       expecteddensity = (double)list.size();
@@ -644,7 +647,7 @@ void vpMbtMeLine::setExtremities()
   double j_max = -1;
 
   // Loop through list of sites to track
-  for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
     vpMeSite s = *it; // current reference pixel
     if (s.ifloat < i_min) {
       i_min = s.ifloat;
@@ -665,7 +668,7 @@ void vpMbtMeLine::setExtremities()
   }
 
   if (fabs(i_min - i_max) < 25) {
-    for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+    for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
       vpMeSite s = *it; // current reference pixel
       if (s.jfloat < j_min) {
         i_min = s.ifloat;
@@ -711,7 +714,7 @@ void vpMbtMeLine::bubbleSortI()
     }
   }
 #endif
-  list.sort(sortByI);
+  std::stable_sort(list.begin(), list.end(), sortByI);
 }
 
 static bool sortByJ(const vpMeSite &s1, const vpMeSite &s2) { return (s1.jfloat > s2.jfloat); }
@@ -734,7 +737,7 @@ void vpMbtMeLine::bubbleSortJ()
     }
   }
 #endif
-  list.sort(sortByJ);
+  std::stable_sort(list.begin(), list.end(), sortByJ);
 }
 
 #endif
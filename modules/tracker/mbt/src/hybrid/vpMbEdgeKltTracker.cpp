@@ -45,7 +45,7 @@
 #include <visp3/mbt/vpMbEdgeKltTracker.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 vpMbEdgeKltTracker::vpMbEdgeKltTracker()
   : m_thresholdKLT(2.), m_thresholdMBT(2.), m_maxIterKlt(30), m_w_mbt(), m_w_klt(), m_error_hybrid(), m_w_hybrid()
@@ -489,9 +489,9 @@ void vpMbEdgeKltTracker::postTrackingMbt(vpColVector &w, unsigned int lvl)
       double wmean = 0;
 
       for (size_t a = 0; a < l->meline.size(); a++) {
-        std::list<vpMeSite>::iterator itListLine;
+        std::vector<vpMeSite>::iterator itListLine;
         if (l->nbFeature[a] > 0)
-          itListLine = l->meline[a]->getMeList().begin();
+          itListLine = l->meline[a]->getMeSites().begin();
 
         for (unsigned int i = 0; i < l->nbFeature[a]; i++) {
           wmean += w[n + indexLine];
@@ -527,11 +527,11 @@ void vpMbEdgeKltTracker::postTrackingMbt(vpColVector &w, unsigned int lvl)
     if ((*it)->isTracked()) {
       cy = *it;
       double wmean = 0;
-      std::list<vpMeSite>::iterator itListCyl1;
-      std::list<vpMeSite>::iterator itListCyl2;
+      std::vector<vpMeSite>::iterator itListCyl1;
+      std::vector<vpMeSite>::iterator itListCyl2;
       if (cy->nbFeature > 0) {
-        itListCyl1 = cy->meline1->getMeList().begin();
-        itListCyl2 = cy->meline2->getMeList().begin();
+        itListCyl1 = cy->meline1->getMeSites().begin();
+        itListCyl2 = cy->meline2->getMeSites().begin();
       }
 
       wmean = 0;
@@ -592,10 +592,10 @@ void vpMbEdgeKltTracker::postTrackingMbt(vpColVector &w, unsigned int lvl)
     if ((*it)->isTracked()) {
       ci = *it;
       double wmean = 0;
-      std::list<vpMeSite>::iterator itListCir;
+      std::vector<vpMeSite>::iterator itListCir;
 
       if (ci->nbFeature > 0) {
-        itListCir = ci->meEllipse->getMeList().begin();
+        itListCir = ci->meEllipse->getMeSites().begin();
       }
 
       wmean = 0;
@@ -1022,9 +1022,9 @@ unsigned int vpMbEdgeKltTracker::trackFirstLoop(const vpImage<unsigned char> &I,
 
       unsigned int indexFeature = 0;
       for (size_t a = 0; a < l->meline.size(); a++) {
-        std::list<vpMeSite>::const_iterator itListLine;
+        std::vector<vpMeSite>::const_iterator itListLine;
         if (l->meline[a] != NULL) {
-          itListLine = l->meline[a]->getMeList().begin();
+          itListLine = l->meline[a]->getMeSites().begin();
 
           for (unsigned int i = 0; i < l->nbFeature[a]; i++) {
             factor[n + i] = fac;
@@ -1047,11 +1047,11 @@ unsigned int vpMbEdgeKltTracker::trackFirstLoop(const vpImage<unsigned char> &I,
       cy->computeInteractionMatrixError(m_cMo, I);
       double fac = 1.0;
 
-      std::list<vpMeSite>::const_iterator itCyl1;
-      std::list<vpMeSite>::const_iterator itCyl2;
+      std::vector<vpMeSite>::const_iterator itCyl1;
+      std::vector<vpMeSite>::const_iterator itCyl2;
       if ((cy->meline1 != NULL || cy->meline2 != NULL)) {
-        itCyl1 = cy->meline1->getMeList().begin();
-        itCyl2 = cy->meline2->getMeList().begin();
+        itCyl1 = cy->meline1->getMeSites().begin();
+        itCyl2 = cy->meline2->getMeSites().begin();
       }
 
       for (unsigned int i = 0; i < cy->nbFeature; i++) {
@@ -1078,9 +1078,9 @@ unsigned int vpMbEdgeKltTracker::trackFirstLoop(const vpImage<unsigned char> &I,
       ci->computeInteractionMatrixError(m_cMo);
       double fac = 1.0;
 
-      std::list<vpMeSite>::const_iterator itCir;
+      std::vector<vpMeSite>::const_iterator itCir;
       if (ci->meEllipse != NULL) {
-        itCir = ci->meEllipse->getMeList().begin();
+        itCir = ci->meEllipse->getMeSites().begin();
       }
 
       for (unsigned int i = 0; i < ci->nbFeature; i++) {
@@ -1381,7 +1381,7 @@ void vpMbEdgeKltTracker::reInitModel(const vpImage<unsigned char> &I, const std:
                                      const vpHomogeneousMatrix &T)
 {
   // Reinit klt
-  #if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+  #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100) && (VISP_HAVE_OPENCV_VERSION < 0x020408)
     if (cur != NULL) {
       cvReleaseImage(&cur);
       cur = NULL;
@@ -1476,4 +1476,4 @@ void vpMbEdgeKltTracker::reInitModel(const vpImage<unsigned char> &I, const std:
 // Work arround to avoid warning: libvisp_mbt.a(vpMbEdgeKltTracker.cpp.o) has
 // no symbols
 void dummy_vpMbEdgeKltTracker(){};
-#endif // VISP_HAVE_OPENCV
+#endif // VISP_HAVE_MODULE_KLT
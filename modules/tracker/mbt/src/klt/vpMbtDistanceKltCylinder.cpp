@@ -40,7 +40,7 @@
 #include <visp3/mbt/vpMbtDistanceKltCylinder.h>
 #include <visp3/mbt/vpMbtDistanceKltPoints.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 #if defined(VISP_HAVE_CLIPPER)
 #include <clipper.hpp> // clipper private library
@@ -100,10 +100,14 @@ void vpMbtDistanceKltCylinder::buildFrom(const vpPoint &p1, const vpPoint &p2, c
   all the map detected in the image, are parsed in order to extract the id of
   the points that are indeed in the face.
 
-  \param _tracker : ViSP OpenCV KLT Tracker.
+  \param _tracker : ViSP KLT Tracker, vpKltOpencv or vpKltTracker when OpenCV is not available.
   \param cMo : Pose of the object in the camera frame at initialization.
 */
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
 void vpMbtDistanceKltCylinder::init(const vpKltOpencv &_tracker, const vpHomogeneousMatrix &cMo)
+#else
+void vpMbtDistanceKltCylinder::init(const vpKltTracker &_tracker, const vpHomogeneousMatrix &cMo)
+#endif
 {
   c0Mo = cMo;
   cylinder.changeFrame(cMo);
@@ -193,7 +197,11 @@ void vpMbtDistanceKltCylinder::init(const vpKltOpencv &_tracker, const vpHomogen
   \return the number of points that are tracked in this face and in this
   instanciation of the tracker
 */
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
 unsigned int vpMbtDistanceKltCylinder::computeNbDetectedCurrent(const vpKltOpencv &_tracker)
+#else
+unsigned int vpMbtDistanceKltCylinder::computeNbDetectedCurrent(const vpKltTracker &_tracker)
+#endif
 {
   long id;
   float x, y;
@@ -374,19 +382,24 @@ bool vpMbtDistanceKltCylinder::isTrackedFeature(int _id)
   built-in erosion) to avoid to consider pixels near the limits of the face.
 */
 void vpMbtDistanceKltCylinder::updateMask(
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
     cv::Mat &mask,
-#else
+#elif defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
     IplImage *mask,
+#else
+    vpImage<unsigned char> &mask,
 #endif
     unsigned char nb, unsigned int shiftBorder)
 {
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   int width = mask.cols;
   int height = mask.rows;
-#else
+#elif defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   int width = mask->width;
   int height = mask->height;
+#else
+  int width = (int)mask.getWidth();
+  int height = (int)mask.getHeight();
 #endif
 
   for (unsigned int kc = 0; kc < listIndicesCylinderBBox.size(); kc++) {
@@ -464,60 +477,65 @@ void vpMbtDistanceKltCylinder::updateMask(
         j_max = width;
       }
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100) && (VISP_HAVE_OPENCV_VERSION < 0x020408)
+      unsigned char *ptrData = (unsigned char *)mask->imageData + i_min * mask->widthStep + j_min;
       for (int i = i_min; i < i_max; i++) {
         double i_d = (double)i;
-
         for (int j = j_min; j < j_max; j++) {
           double j_d = (double)j;
-
-#if defined(VISP_HAVE_CLIPPER)
-          imPt.set_ij(i_d, j_d);
-          if (polygon_test.isInside(imPt)) {
-            mask.ptr<uchar>(i)[j] = nb;
-          }
-#else
           if (shiftBorder != 0) {
             if (vpPolygon::isInside(roi, i_d, j_d) &&
                 vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d + shiftBorder_d) &&
                 vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d + shiftBorder_d) &&
                 vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d - shiftBorder_d) &&
                 vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d - shiftBorder_d)) {
-              mask.at<unsigned char>(i, j) = nb;
+              *(ptrData++) = nb;
+            } else {
+              ptrData++;
             }
           } else {
             if (vpPolygon::isInside(roi, i, j)) {
-              mask.at<unsigned char>(i, j) = nb;
+              *(ptrData++) = nb;
+            } else {
+              ptrData++;
             }
           }
-#endif
         }
+        ptrData += mask->widthStep - j_max + j_min;
       }
 #else
-      unsigned char *ptrData = (unsigned char *)mask->imageData + i_min * mask->widthStep + j_min;
       for (int i = i_min; i < i_max; i++) {
         double i_d = (double)i;
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+        unsigned char *mask_row = mask.ptr<uchar>(i);
+#else
+        unsigned char *mask_row = mask[i];
+#endif
+
         for (int j = j_min; j < j_max; j++) {
           double j_d = (double)j;
+
+#if defined(VISP_HAVE_CLIPPER)
+          imPt.set_ij(i_d, j_d);
+          if (polygon_test.isInside(imPt)) {
+            mask_row[j] = nb;
+          }
+#else
           if (shiftBorder != 0) {
             if (vpPolygon::isInside(roi, i_d, j_d) &&
                 vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d + shiftBorder_d) &&
                 vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d + shiftBorder_d) &&
                 vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d - shiftBorder_d) &&
                 vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d - shiftBorder_d)) {
-              *(ptrData++) = nb;
-            } else {
-              ptrData++;
+              mask_row[j] = nb;
             }
           } else {
             if (vpPolygon::isInside(roi, i, j)) {
-              *(ptrData++) = nb;
-            } else {
-              ptrData++;
+              mask_row[j] = nb;
             }
           }
+#endif
         }
-        ptrData += mask->widthStep - j_max + j_min;
       }
 #endif
     }
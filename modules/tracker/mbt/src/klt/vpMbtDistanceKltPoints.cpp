@@ -41,7 +41,7 @@
 #include <visp3/mbt/vpMbtDistanceKltPoints.h>
 #include <visp3/me/vpMeTracker.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 #if defined(VISP_HAVE_CLIPPER)
 #include <clipper.hpp> // clipper private library
@@ -74,10 +74,14 @@ vpMbtDistanceKltPoints::~vpMbtDistanceKltPoints() {}
   the map detected in the image, are parsed in order to extract the id of the
   points that are indeed in the face.
 
-  \param _tracker : ViSP OpenCV KLT Tracker.
+  \param _tracker : ViSP KLT Tracker, vpKltOpencv or vpKltTracker when OpenCV is not available.
   \param mask: Mask image or NULL if not wanted. Mask values that are set to true are considered in the tracking. To disable a pixel, set false.
 */
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
 void vpMbtDistanceKltPoints::init(const vpKltOpencv &_tracker, const vpImage<bool> *mask)
+#else
+void vpMbtDistanceKltPoints::init(const vpKltTracker &_tracker, const vpImage<bool> *mask)
+#endif
 {
   // extract ids of the points in the face
   nbPointsInit = 0;
@@ -150,7 +154,11 @@ void vpMbtDistanceKltPoints::init(const vpKltOpencv &_tracker, const vpImage<boo
   instanciation of the tracker
   \param mask: Mask image or NULL if not wanted. Mask values that are set to true are considered in the tracking. To disable a pixel, set false.
 */
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
 unsigned int vpMbtDistanceKltPoints::computeNbDetectedCurrent(const vpKltOpencv &_tracker, const vpImage<bool> *mask)
+#else
+unsigned int vpMbtDistanceKltPoints::computeNbDetectedCurrent(const vpKltTracker &_tracker, const vpImage<bool> *mask)
+#endif
 {
   long id;
   float x, y;
@@ -352,19 +360,24 @@ bool vpMbtDistanceKltPoints::isTrackedFeature(int _id)
   built-in erosion) to avoid to consider pixels near the limits of the face.
 */
 void vpMbtDistanceKltPoints::updateMask(
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
     cv::Mat &mask,
-#else
+#elif defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
     IplImage *mask,
+#else
+    vpImage<unsigned char> &mask,
 #endif
     unsigned char nb, unsigned int shiftBorder)
 {
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   int width = mask.cols;
   int height = mask.rows;
-#else
+#elif defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   int width = mask->width;
   int height = mask->height;
+#else
+  int width = (int)mask.getWidth();
+  int height = (int)mask.getHeight();
 #endif
 
   int i_min, i_max, j_min, j_max;
@@ -440,58 +453,63 @@ void vpMbtDistanceKltPoints::updateMask(
     j_max = width;
   }
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100) && (VISP_HAVE_OPENCV_VERSION < 0x020408)
+  unsigned char *ptrData = (unsigned char *)mask->imageData + i_min * mask->widthStep + j_min;
   for (int i = i_min; i < i_max; i++) {
     double i_d = (double)i;
-
     for (int j = j_min; j < j_max; j++) {
       double j_d = (double)j;
-
-#if defined(VISP_HAVE_CLIPPER)
-      imPt.set_ij(i_d, j_d);
-      if (polygon_test.isInside(imPt)) {
-        mask.ptr<uchar>(i)[j] = nb;
-      }
-#else
       if (shiftBorder != 0) {
         if (vpPolygon::isInside(roi, i_d, j_d) && vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d + shiftBorder_d) &&
             vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d + shiftBorder_d) &&
             vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d - shiftBorder_d) &&
             vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d - shiftBorder_d)) {
-          mask.at<unsigned char>(i, j) = nb;
+          *(ptrData++) = nb;
+        } else {
+          ptrData++;
         }
       } else {
         if (vpPolygon::isInside(roi, i, j)) {
-          mask.at<unsigned char>(i, j) = nb;
+          *(ptrData++) = nb;
+        } else {
+          ptrData++;
         }
       }
-#endif
     }
+    ptrData += mask->widthStep - j_max + j_min;
   }
 #else
-  unsigned char *ptrData = (unsigned char *)mask->imageData + i_min * mask->widthStep + j_min;
   for (int i = i_min; i < i_max; i++) {
     double i_d = (double)i;
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+    unsigned char *mask_row = mask.ptr<uchar>(i);
+#else
+    unsigned char *mask_row = mask[i];
+#endif
+
     for (int j = j_min; j < j_max; j++) {
       double j_d = (double)j;
+
+#if defined(VISP_HAVE_CLIPPER)
+      imPt.set_ij(i_d, j_d);
+      if (polygon_test.isInside(imPt)) {
+        mask_row[j] = nb;
+      }
+#else
       if (shiftBorder != 0) {
         if (vpPolygon::isInside(roi, i_d, j_d) && vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d + shiftBorder_d) &&
             vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d + shiftBorder_d) &&
             vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d - shiftBorder_d) &&
             vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d - shiftBorder_d)) {
-          *(ptrData++) = nb;
-        } else {
-          ptrData++;
+          mask_row[j] = nb;
         }
       } else {
         if (vpPolygon::isInside(roi, i, j)) {
-          *(ptrData++) = nb;
-        } else {
-          ptrData++;
+          mask_row[j] = nb;
         }
       }
+#endif
     }
-    ptrData += mask->widthStep - j_max + j_min;
   }
 #endif
 }
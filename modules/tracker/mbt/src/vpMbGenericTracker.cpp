@@ -40,10 +40,66 @@
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <exception>
+#endif
+
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+/*!
+  Call \e func(i) for each camera index i in [0, nbCameras). When OpenMP is available and more than one
+  thread is requested, the calls are distributed over the OpenMP thread team, which is kept alive between
+  two parallel regions. The first exception raised by a camera is rethrown once all the cameras are done.
+*/
+template <typename Func> void runPerCamera(size_t nbCameras, unsigned int nbThreads, Func func)
+{
+#ifdef VISP_HAVE_OPENMP
+  if (nbCameras > 1 && nbThreads != 1) {
+    int nbCams = static_cast<int>(nbCameras);
+    int nbTeam = nbThreads == 0 ? omp_get_max_threads() : static_cast<int>(nbThreads);
+    nbTeam = std::min(nbTeam, nbCams);
+    std::exception_ptr error;
+
+#pragma omp parallel for num_threads(nbTeam) schedule(dynamic, 1)
+    for (int i = 0; i < nbCams; i++) {
+      try {
+        func(static_cast<size_t>(i));
+      } catch (...) {
+#pragma omp critical(vpMbGenericTracker_runPerCamera)
+        {
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+      }
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return;
+  }
+#else
+  (void)nbThreads;
+#endif
+
+  for (size_t i = 0; i < nbCameras; i++) {
+    func(i);
+  }
+}
+#endif
+} // namespace
+
 vpMbGenericTracker::vpMbGenericTracker()
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
     m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-    m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+    m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0), m_nbThreads(1),
+    m_streamNormalEquations(false)
 {
   m_mapOfTrackers["Camera"] = new TrackerWrapper(EDGE_TRACKER);
 
@@ -53,7 +109,7 @@ vpMbGenericTracker::vpMbGenericTracker()
   // Add default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -64,7 +120,8 @@ vpMbGenericTracker::vpMbGenericTracker()
 vpMbGenericTracker::vpMbGenericTracker(unsigned int nbCameras, int trackerType)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
     m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-    m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+    m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0), m_nbThreads(1),
+    m_streamNormalEquations(false)
 {
   if (nbCameras == 0) {
     throw vpException(vpTrackingException::fatalError, "Cannot use no camera!");
@@ -90,7 +147,7 @@ vpMbGenericTracker::vpMbGenericTracker(unsigned int nbCameras, int trackerType)
   // Add default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -101,7 +158,8 @@ vpMbGenericTracker::vpMbGenericTracker(unsigned int nbCameras, int trackerType)
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
     m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-    m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+    m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0), m_nbThreads(1),
+    m_streamNormalEquations(false)
 {
   if (trackerTypes.empty()) {
     throw vpException(vpException::badValue, "There is no camera!");
@@ -129,7 +187,7 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
   // Add default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -141,7 +199,8 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<std::string> &cameraNam
                                        const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
     m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-    m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+    m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0), m_nbThreads(1),
+    m_streamNormalEquations(false)
 {
   if (cameraNames.size() != trackerTypes.size() || cameraNames.empty()) {
     throw vpException(vpTrackingException::badValue,
@@ -161,7 +220,7 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<std::string> &cameraNam
   // Add default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -278,6 +337,9 @@ void vpMbGenericTracker::computeProjectionError()
 
 void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages)
 {
+  // The covariance matrix needs the stacked interaction matrix
+  const bool streamNormalEquations = m_streamNormalEquations && !computeCovariance;
+
   computeVVSInit(mapOfImages);
 
   if (m_error.getRows() < 4) {
@@ -311,7 +373,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
   }
 
   double factorEdge = m_mapOfFeatureFactors[EDGE_TRACKER];
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   double factorKlt = m_mapOfFeatureFactors[KLT_TRACKER];
 #endif
   double factorDepth = m_mapOfFeatureFactors[DEPTH_NORMAL_TRACKER];
@@ -323,7 +385,11 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
   m_nb_feat_depthDense = 0;
 
   while (std::fabs(normRes_1 - normRes) > m_stopCriteriaEpsilon && (iter < m_maxIter)) {
-    computeVVSInteractionMatrixAndResidu(mapOfImages, mapOfVelocityTwist);
+    if (streamNormalEquations) {
+      computeVVSResidu(mapOfImages);
+    } else {
+      computeVVSInteractionMatrixAndResidu(mapOfImages, mapOfVelocityTwist);
+    }
 
     bool reStartFromLastIncrement = false;
     computeVVSCheckLevenbergMarquardt(iter, m_error, error_prev, cMo_prev, mu, reStartFromLastIncrement);
@@ -334,7 +400,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
 
         tracker->m_cMo = m_mapOfCameraTransformationMatrix[it->first] * cMo_prev;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
         vpHomogeneousMatrix c_curr_tTc_curr0 =
             m_mapOfCameraTransformationMatrix[it->first] * cMo_prev * tracker->c0Mo.inverse();
         tracker->ctTc0 = c_curr_tTc_curr0;
@@ -367,7 +433,18 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
           cVo.buildFrom(m_cMo);
 
           vpMatrix K; // kernel
-          unsigned int rank = (m_L * cVo).kernel(K);
+          unsigned int rank = 0;
+          if (streamNormalEquations) {
+            // (L cVo)^T (L cVo) has the same kernel as L cVo, and squared singular values
+            vpMatrix LTL_unweighted;
+            vpColVector LTR_unweighted;
+            double num_unweighted = 0, den_unweighted = 0;
+            computeVVSNormalEquations(mapOfVelocityTwist, false, LTL_unweighted, LTR_unweighted, num_unweighted,
+                                      den_unweighted);
+            rank = (vpMatrix(cVo).t() * LTL_unweighted * cVo).kernel(K, 1e-12);
+          } else {
+            rank = (m_L * cVo).kernel(K);
+          }
           if (rank == 0) {
             throw vpException(vpException::fatalError, "Rank=0, cannot estimate the pose !");
           }
@@ -386,92 +463,100 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
       double num = 0;
       double den = 0;
 
-      unsigned int start_index = 0;
-      for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-           it != m_mapOfTrackers.end(); ++it) {
-        TrackerWrapper *tracker = it->second;
-
-        if (tracker->m_trackerType & EDGE_TRACKER) {
-          for (unsigned int i = 0; i < tracker->m_error_edge.getRows(); i++) {
-            double wi = tracker->m_w_edge[i] * tracker->m_factor[i] * factorEdge;
-            W_true[start_index + i] = wi;
-            m_weightedError[start_index + i] = wi * m_error[start_index + i];
-
-            num += wi * vpMath::sqr(m_error[start_index + i]);
-            den += wi;
-
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
+      if (streamNormalEquations) {
+        computeVVSNormalEquations(mapOfVelocityTwist, true, LTL, LTR, num, den);
+      } else {
+        unsigned int start_index = 0;
+        for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+             it != m_mapOfTrackers.end(); ++it) {
+          TrackerWrapper *tracker = it->second;
+
+          if (tracker->m_trackerType & EDGE_TRACKER) {
+            for (unsigned int i = 0; i < tracker->m_error_edge.getRows(); i++) {
+              double wi = tracker->m_w_edge[i] * tracker->m_factor[i] * factorEdge;
+              W_true[start_index + i] = wi;
+              m_weightedError[start_index + i] = wi * m_error[start_index + i];
+
+              num += wi * vpMath::sqr(m_error[start_index + i]);
+              den += wi;
+
+              for (unsigned int j = 0; j < m_L.getCols(); j++) {
+                m_L[start_index + i][j] *= wi;
+              }
             }
-          }
 
-          start_index += tracker->m_error_edge.getRows();
-        }
+            start_index += tracker->m_error_edge.getRows();
+          }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-        if (tracker->m_trackerType & KLT_TRACKER) {
-          for (unsigned int i = 0; i < tracker->m_error_klt.getRows(); i++) {
-            double wi = tracker->m_w_klt[i] * factorKlt;
-            W_true[start_index + i] = wi;
-            m_weightedError[start_index + i] = wi * m_error[start_index + i];
+#if defined(VISP_HAVE_MODULE_KLT)
+          if (tracker->m_trackerType & KLT_TRACKER) {
+            for (unsigned int i = 0; i < tracker->m_error_klt.getRows(); i++) {
+              double wi = tracker->m_w_klt[i] * factorKlt;
+              W_true[start_index + i] = wi;
+              m_weightedError[start_index + i] = wi * m_error[start_index + i];
 
-            num += wi * vpMath::sqr(m_error[start_index + i]);
-            den += wi;
+              num += wi * vpMath::sqr(m_error[start_index + i]);
+              den += wi;
 
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
+              for (unsigned int j = 0; j < m_L.getCols(); j++) {
+                m_L[start_index + i][j] *= wi;
+              }
             }
-          }
 
-          start_index += tracker->m_error_klt.getRows();
-        }
+            start_index += tracker->m_error_klt.getRows();
+          }
 #endif
 
-        if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-          for (unsigned int i = 0; i < tracker->m_error_depthNormal.getRows(); i++) {
-            double wi = tracker->m_w_depthNormal[i] * factorDepth;
-            W_true[start_index + i] = wi;
-            m_weightedError[start_index + i] = wi * m_error[start_index + i];
+          if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
+            for (unsigned int i = 0; i < tracker->m_error_depthNormal.getRows(); i++) {
+              double wi = tracker->m_w_depthNormal[i] * factorDepth;
+              W_true[start_index + i] = wi;
+              m_weightedError[start_index + i] = wi * m_error[start_index + i];
 
-            num += wi * vpMath::sqr(m_error[start_index + i]);
-            den += wi;
+              num += wi * vpMath::sqr(m_error[start_index + i]);
+              den += wi;
 
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
+              for (unsigned int j = 0; j < m_L.getCols(); j++) {
+                m_L[start_index + i][j] *= wi;
+              }
             }
-          }
 
-          start_index += tracker->m_error_depthNormal.getRows();
-        }
+            start_index += tracker->m_error_depthNormal.getRows();
+          }
 
-        if (tracker->m_trackerType & DEPTH_DENSE_TRACKER) {
-          for (unsigned int i = 0; i < tracker->m_error_depthDense.getRows(); i++) {
-            double wi = tracker->m_w_depthDense[i] * factorDepthDense;
-            W_true[start_index + i] = wi;
-            m_weightedError[start_index + i] = wi * m_error[start_index + i];
+          if (tracker->m_trackerType & DEPTH_DENSE_TRACKER) {
+            for (unsigned int i = 0; i < tracker->m_error_depthDense.getRows(); i++) {
+              double wi = tracker->m_w_depthDense[i] * factorDepthDense;
+              W_true[start_index + i] = wi;
+              m_weightedError[start_index + i] = wi * m_error[start_index + i];
 
-            num += wi * vpMath::sqr(m_error[start_index + i]);
-            den += wi;
+              num += wi * vpMath::sqr(m_error[start_index + i]);
+              den += wi;
 
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
+              for (unsigned int j = 0; j < m_L.getCols(); j++) {
+                m_L[start_index + i][j] *= wi;
+              }
             }
-          }
 
-          start_index += tracker->m_error_depthDense.getRows();
+            start_index += tracker->m_error_depthDense.getRows();
+          }
         }
       }
 
       normRes_1 = normRes;
       normRes = sqrt(num / den);
 
-      computeVVSPoseEstimation(isoJoIdentity_, iter, m_L, LTL, m_weightedError, m_error, error_prev, LTR, mu, v);
+      if (streamNormalEquations) {
+        computeVVSPoseEstimationFromNormalEquations(isoJoIdentity_, iter, LTL, LTR, m_error, error_prev, mu, v);
+      } else {
+        computeVVSPoseEstimation(isoJoIdentity_, iter, m_L, LTL, m_weightedError, m_error, error_prev, LTR, mu, v);
+      }
 
       cMo_prev = m_cMo;
 
       m_cMo = vpExponentialMap::direct(v).inverse() * m_cMo;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
            it != m_mapOfTrackers.end(); ++it) {
         TrackerWrapper *tracker = it->second;
@@ -500,7 +585,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
     if (tracker->m_trackerType & EDGE_TRACKER) {
       m_nb_feat_edge += tracker->m_error_edge.size();
     }
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
     if (tracker->m_trackerType & KLT_TRACKER) {
       m_nb_feat_klt += tracker->m_error_klt.size();
     }
@@ -532,20 +617,48 @@ void vpMbGenericTracker::computeVVSInit()
 
 void vpMbGenericTracker::computeVVSInit(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages)
 {
-  unsigned int nbFeatures = 0;
-
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->computeVVSInit(mapOfImages[it->first]);
+    trackers.push_back(it->second);
+    images.push_back(mapOfImages[it->first]);
+  }
+
+  const bool streamNormalEquations = m_streamNormalEquations && !computeCovariance;
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  runPerCamera(trackers.size(), m_nbThreads, [&](size_t i) {
+    if (streamNormalEquations) {
+      trackers[i]->computeVVSResiduInit(images[i]);
+    } else {
+      trackers[i]->computeVVSInit(images[i]);
+    }
+  });
+#else
+  for (size_t i = 0; i < trackers.size(); i++) {
+    if (streamNormalEquations) {
+      trackers[i]->computeVVSResiduInit(images[i]);
+    } else {
+      trackers[i]->computeVVSInit(images[i]);
+    }
+  }
+#endif
 
-    nbFeatures += tracker->m_error.getRows();
+  unsigned int nbFeatures = 0;
+  for (size_t i = 0; i < trackers.size(); i++) {
+    nbFeatures += trackers[i]->m_error.getRows();
   }
 
-  m_L.resize(nbFeatures, 6, false, false);
+  if (streamNormalEquations) {
+    m_L.resize(0, 0);
+    m_weightedError.resize(0);
+  } else {
+    m_L.resize(nbFeatures, 6, false, false);
+    m_weightedError.resize(nbFeatures, false);
+  }
   m_error.resize(nbFeatures, false);
 
-  m_weightedError.resize(nbFeatures, false);
   m_w.resize(nbFeatures, false);
   m_w = 1;
 }
@@ -561,19 +674,38 @@ void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu(
     std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
     std::map<std::string, vpVelocityTwistMatrix> &mapOfVelocityTwist)
 {
-  unsigned int start_index = 0;
-
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
 
     tracker->m_cMo = m_mapOfCameraTransformationMatrix[it->first] * m_cMo;
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
     vpHomogeneousMatrix c_curr_tTc_curr0 = m_mapOfCameraTransformationMatrix[it->first] * m_cMo * tracker->c0Mo.inverse();
     tracker->ctTc0 = c_curr_tTc_curr0;
 #endif
 
-    tracker->computeVVSInteractionMatrixAndResidu(mapOfImages[it->first]);
+    trackers.push_back(tracker);
+    images.push_back(mapOfImages[it->first]);
+  }
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  runPerCamera(trackers.size(), m_nbThreads,
+               [&](size_t i) { trackers[i]->computeVVSInteractionMatrixAndResidu(images[i]); });
+#else
+  for (size_t i = 0; i < trackers.size(); i++) {
+    trackers[i]->computeVVSInteractionMatrixAndResidu(images[i]);
+  }
+#endif
+
+  // Stack the features of each camera, always in the same order to keep the solution independent
+  // from the number of threads
+  unsigned int start_index = 0;
+  size_t idx = 0;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it, ++idx) {
+    TrackerWrapper *tracker = trackers[idx];
 
     m_L.insert(tracker->m_L * mapOfVelocityTwist[it->first], start_index, 0);
     m_error.insert(start_index, tracker->m_error);
@@ -584,15 +716,117 @@ void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu(
 
 void vpMbGenericTracker::computeVVSWeights()
 {
+  std::vector<TrackerWrapper *> trackers;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    trackers.push_back(it->second);
+  }
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  runPerCamera(trackers.size(), m_nbThreads, [&](size_t i) { trackers[i]->computeVVSWeights(); });
+#else
+  for (size_t i = 0; i < trackers.size(); i++) {
+    trackers[i]->computeVVSWeights();
+  }
+#endif
+
   unsigned int start_index = 0;
+  for (size_t i = 0; i < trackers.size(); i++) {
+    m_w.insert(start_index, trackers[i]->m_w);
+    start_index += trackers[i]->m_w.getRows();
+  }
+}
+
+/*!
+  Accumulate the normal equations of all the cameras, expressed in the reference camera frame.
 
+  \param mapOfVelocityTwist : Velocity twist matrix of each camera with respect to the reference camera.
+  \param weighted : If true, the features are weighted by the robust weights and the feature factors,
+  otherwise unit weights are used.
+  \param LTL : 6x6 matrix \f$ \mathbf{L}^T \mathbf{W} \mathbf{L} \f$.
+  \param LTR : 6-dim vector \f$ \mathbf{L}^T \mathbf{W} \mathbf{e} \f$.
+  \param num : Weighted sum of the squared residuals.
+  \param den : Sum of the weights.
+*/
+void vpMbGenericTracker::computeVVSNormalEquations(std::map<std::string, vpVelocityTwistMatrix> &mapOfVelocityTwist,
+                                                   bool weighted, vpMatrix &LTL, vpColVector &LTR, double &num,
+                                                   double &den)
+{
+  std::vector<TrackerWrapper *> trackers;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    trackers.push_back(it->second);
+  }
+
+  std::vector<vpMatrix> LTLs(trackers.size());
+  std::vector<vpColVector> LTRs(trackers.size());
+  std::vector<double> nums(trackers.size()), dens(trackers.size());
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  runPerCamera(trackers.size(), m_nbThreads, [&](size_t i) {
+    trackers[i]->computeVVSNormalEquations(m_mapOfFeatureFactors, weighted, LTLs[i], LTRs[i], nums[i], dens[i],
+                                           m_nbThreads);
+  });
+#else
+  for (size_t i = 0; i < trackers.size(); i++) {
+    trackers[i]->computeVVSNormalEquations(m_mapOfFeatureFactors, weighted, LTLs[i], LTRs[i], nums[i], dens[i],
+                                           m_nbThreads);
+  }
+#endif
+
+  // Sum the cameras always in the same order to keep the solution independent from the number of threads
+  LTL.resize(6, 6);
+  LTR.resize(6);
+  num = 0;
+  den = 0;
+  size_t idx = 0;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it, ++idx) {
+    const vpVelocityTwistMatrix &cVo = mapOfVelocityTwist[it->first];
+    vpMatrix cVoT = vpMatrix(cVo).t();
+
+    LTL += cVoT * LTLs[idx] * cVo;
+    LTR += cVoT * LTRs[idx];
+    num += nums[idx];
+    den += dens[idx];
+  }
+}
+
+/*!
+  Compute the residual of all the cameras, without the interaction matrix.
+
+  \param mapOfImages : Map of images.
+*/
+void vpMbGenericTracker::computeVVSResidu(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages)
+{
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
-    tracker->computeVVSWeights();
 
-    m_w.insert(start_index, tracker->m_w);
-    start_index += tracker->m_w.getRows();
+    tracker->m_cMo = m_mapOfCameraTransformationMatrix[it->first] * m_cMo;
+#if defined(VISP_HAVE_MODULE_KLT)
+    vpHomogeneousMatrix c_curr_tTc_curr0 = m_mapOfCameraTransformationMatrix[it->first] * m_cMo * tracker->c0Mo.inverse();
+    tracker->ctTc0 = c_curr_tTc_curr0;
+#endif
+
+    trackers.push_back(tracker);
+    images.push_back(mapOfImages[it->first]);
+  }
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  runPerCamera(trackers.size(), m_nbThreads, [&](size_t i) { trackers[i]->computeVVSResidu(images[i]); });
+#else
+  for (size_t i = 0; i < trackers.size(); i++) {
+    trackers[i]->computeVVSResidu(images[i]);
+  }
+#endif
+
+  unsigned int start_index = 0;
+  for (size_t i = 0; i < trackers.size(); i++) {
+    m_error.insert(start_index, trackers[i]->m_error);
+    start_index += trackers[i]->m_error.getRows();
   }
 }
 
@@ -932,7 +1166,7 @@ vpMbHiddenFaces<vpMbtPolygon> &vpMbGenericTracker::getFaces(const std::string &c
   return faces;
 }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 /*!
   Return the address of the circle feature list for the reference camera.
 */
@@ -1062,7 +1296,7 @@ void vpMbGenericTracker::getFeaturesForDisplay(std::map<std::string, std::vector
 */
 double vpMbGenericTracker::getGoodMovingEdgesRatioThreshold() const { return m_percentageGdPt; }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 /*!
   Get the current list of KLT points for the reference camera.
 
@@ -1141,6 +1375,7 @@ int vpMbGenericTracker::getKltNbPoints() const
   return 0;
 }
 
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
 /*!
   Get the klt tracker at the current state for the reference camera.
 
@@ -1198,8 +1433,67 @@ void vpMbGenericTracker::getKltOpencv(std::map<std::string, vpKltOpencv> &mapOfK
     mapOfKlts[it->first] = tracker->getKltOpencv();
   }
 }
+#else
+/*!
+  Get the native klt tracker at the current state for the reference camera.
+
+  \return klt tracker.
+*/
+vpKltTracker vpMbGenericTracker::getKltTracker() const
+{
+  std::map<std::string, TrackerWrapper *>::const_iterator it_tracker = m_mapOfTrackers.find(m_referenceCameraName);
+
+  if (it_tracker != m_mapOfTrackers.end()) {
+    TrackerWrapper *tracker;
+    tracker = it_tracker->second;
+    return tracker->getKltTracker();
+  } else {
+    std::cerr << "Cannot find the reference camera: " << m_referenceCameraName << "!" << std::endl;
+  }
+
+  return vpKltTracker();
+}
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+/*!
+  Get the native klt tracker at the current state.
+
+  \param klt1 : Klt tracker for the first camera.
+  \param klt2 : Klt tracker for the second camera.
+
+  \note This function assumes a stereo configuration of the generic tracker.
+*/
+void vpMbGenericTracker::getKltTracker(vpKltTracker &klt1, vpKltTracker &klt2) const
+{
+  if (m_mapOfTrackers.size() == 2) {
+    std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    klt1 = it->second->getKltTracker();
+    ++it;
+
+    klt2 = it->second->getKltTracker();
+  } else {
+    std::cerr << "The tracker is not set as a stereo configuration! There are " << m_mapOfTrackers.size() << " cameras!"
+              << std::endl;
+  }
+}
+
+/*!
+  Get the native klt tracker at the current state.
+
+  \param mapOfKlts : Map if klt trackers.
+*/
+void vpMbGenericTracker::getKltTracker(std::map<std::string, vpKltTracker> &mapOfKlts) const
+{
+  mapOfKlts.clear();
+
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    mapOfKlts[it->first] = tracker->getKltTracker();
+  }
+}
+#endif
+
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
 /*!
   Get the current list of KLT points for the reference camera.
 
@@ -3011,11 +3305,23 @@ void vpMbGenericTracker::loadModel(const std::map<std::string, std::string> &map
 void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
                                      std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds)
 {
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
+  std::vector<pcl::PointCloud<pcl::PointXYZ>::ConstPtr> pointClouds;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
+    trackers.push_back(it->second);
+    images.push_back(mapOfImages[it->first]);
+    pointClouds.push_back(mapOfPointClouds[it->first]);
+  }
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  runPerCamera(trackers.size(), m_nbThreads, [&](size_t i) { trackers[i]->preTracking(images[i], pointClouds[i]); });
+#else
+  for (size_t i = 0; i < trackers.size(); i++) {
+    trackers[i]->preTracking(images[i], pointClouds[i]);
   }
+#endif
 }
 #endif
 
@@ -3024,12 +3330,49 @@ void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigne
                                      std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                                      std::map<std::string, unsigned int> &mapOfPointCloudHeights)
 {
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
+  std::vector<const std::vector<vpColVector> *> pointClouds;
+  std::vector<unsigned int> widths, heights;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first], mapOfPointCloudWidths[it->first],
-                         mapOfPointCloudHeights[it->first]);
+    trackers.push_back(it->second);
+    images.push_back(mapOfImages[it->first]);
+    pointClouds.push_back(mapOfPointClouds[it->first]);
+    widths.push_back(mapOfPointCloudWidths[it->first]);
+    heights.push_back(mapOfPointCloudHeights[it->first]);
+  }
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  runPerCamera(trackers.size(), m_nbThreads,
+               [&](size_t i) { trackers[i]->preTracking(images[i], pointClouds[i], widths[i], heights[i]); });
+#else
+  for (size_t i = 0; i < trackers.size(); i++) {
+    trackers[i]->preTracking(images[i], pointClouds[i], widths[i], heights[i]);
   }
+#endif
+}
+
+void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                     std::map<std::string, const vpPointCloud<float> *> &mapOfPointClouds)
+{
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
+  std::vector<const vpPointCloud<float> *> pointClouds;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    trackers.push_back(it->second);
+    images.push_back(mapOfImages[it->first]);
+    pointClouds.push_back(mapOfPointClouds[it->first]);
+  }
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  runPerCamera(trackers.size(), m_nbThreads, [&](size_t i) { trackers[i]->preTracking(images[i], pointClouds[i]); });
+#else
+  for (size_t i = 0; i < trackers.size(); i++) {
+    trackers[i]->preTracking(images[i], pointClouds[i]);
+  }
+#endif
 }
 
 /*!
@@ -3379,7 +3722,7 @@ void vpMbGenericTracker::resetTracker()
   // Reset default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -4105,7 +4448,8 @@ void vpMbGenericTracker::setNbRayCastingAttemptsForVisibility(const unsigned int
 }
 #endif
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
 /*!
   Set the new value of the klt tracker.
 
@@ -4160,6 +4504,62 @@ void vpMbGenericTracker::setKltOpencv(const std::map<std::string, vpKltOpencv> &
     }
   }
 }
+#else
+/*!
+  Set the new value of the native klt tracker.
+
+  \param t : Klt tracker containing the new values.
+
+  \note This function will set the new parameter for all the cameras.
+*/
+void vpMbGenericTracker::setKltTracker(const vpKltTracker &t)
+{
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setKltTracker(t);
+  }
+}
+
+/*!
+  Set the new value of the native klt tracker.
+
+  \param t1 : Klt tracker containing the new values for the first camera.
+  \param t2 : Klt tracker containing the new values for the second camera.
+
+  \note This function assumes a stereo configuration of the generic tracker.
+*/
+void vpMbGenericTracker::setKltTracker(const vpKltTracker &t1, const vpKltTracker &t2)
+{
+  if (m_mapOfTrackers.size() == 2) {
+    std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it->second->setKltTracker(t1);
+
+    ++it;
+    it->second->setKltTracker(t2);
+  } else {
+    throw vpException(vpTrackingException::fatalError, "Require two cameras! There are %d cameras!",
+                      m_mapOfTrackers.size());
+  }
+}
+
+/*!
+  Set the new value of the native klt tracker.
+
+  \param mapOfKlts : Map of klt tracker containing the new values.
+*/
+void vpMbGenericTracker::setKltTracker(const std::map<std::string, vpKltTracker> &mapOfKlts)
+{
+  for (std::map<std::string, vpKltTracker>::const_iterator it = mapOfKlts.begin(); it != mapOfKlts.end(); ++it) {
+    std::map<std::string, TrackerWrapper *>::const_iterator it_tracker = m_mapOfTrackers.find(it->first);
+
+    if (it_tracker != m_mapOfTrackers.end()) {
+      TrackerWrapper *tracker = it_tracker->second;
+      tracker->setKltTracker(it->second);
+    }
+  }
+}
+#endif
 
 /*!
   Set the threshold for the acceptation of a point.
@@ -4201,7 +4601,7 @@ void vpMbGenericTracker::setLod(bool useLod, const std::string &name)
   }
 }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 /*!
   Set the erosion of the mask used on the Model faces.
 
@@ -4316,6 +4716,37 @@ void vpMbGenericTracker::setMinPolygonAreaThresh(double minPolygonAreaThresh, co
   }
 }
 
+/*!
+  Set the number of threads used to process the cameras in parallel.
+
+  When more than one thread is requested, the per-camera stages of the tracking (moving-edges and keypoints
+  tracking, depth features extraction, computation of the interaction matrix, residual and robust weights
+  at each virtual visual servoing iteration) run concurrently, one camera per thread. The features of all
+  the cameras are then stacked in the same order as in the sequential mode before solving for the pose, so
+  that the estimated pose does not depend on the number of threads.
+
+  \param nbThreads : Number of threads. By default, 1 is used meaning that the cameras are processed
+  sequentially. If 0 is passed, OpenMP will choose the number of threads.
+
+  The moving-edges sites of each camera are also distributed over \e nbThreads threads, see
+  vpMbEdgeTracker::setMovingEdgeNbThreads(). This is mostly useful with a single camera, since nested
+  parallel regions are by default run by a single thread.
+
+  \note This option has an effect only when ViSP is built with OpenMP and C++11 support.
+
+  \sa getNbThreads()
+*/
+void vpMbGenericTracker::setNbThreads(unsigned int nbThreads)
+{
+  m_nbThreads = nbThreads;
+
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setMovingEdgeNbThreads(nbThreads);
+  }
+}
+
 /*!
   Set the moving edge parameters.
 
@@ -4969,7 +5400,7 @@ void vpMbGenericTracker::setUseEdgeTracking(const std::string &name, const bool
   }
 }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 /*!
   Set if the polygon that has the given name has to be considered during
   the tracking phase.
@@ -5161,7 +5592,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     TrackerWrapper *tracker = it->second;
 
     if ((tracker->m_trackerType & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                    KLT_TRACKER |
 #endif
                                    DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
@@ -5169,7 +5600,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     }
 
     if (tracker->m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                   | KLT_TRACKER
 #endif
                                   ) &&
@@ -5205,7 +5636,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
 
     if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       if (tracker->m_trackerType & KLT_TRACKER) {
         tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
       }
@@ -5237,7 +5668,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
     TrackerWrapper *tracker = it->second;
 
     if ((tracker->m_trackerType & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                    KLT_TRACKER |
 #endif
                                    DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
@@ -5245,13 +5676,13 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
     }
 
     if (tracker->m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                   | KLT_TRACKER
 #endif
                                   ) && mapOfImages[it->first] == NULL) {
       throw vpException(vpException::fatalError, "Image pointer is NULL!");
     } else if (tracker->m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                   | KLT_TRACKER
 #endif
                                   ) && mapOfImages[it->first] != NULL) {
@@ -5287,7 +5718,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
     tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
 
     if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       if (tracker->m_trackerType & KLT_TRACKER) {
         tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
       }
@@ -5323,7 +5754,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     TrackerWrapper *tracker = it->second;
 
     if ((tracker->m_trackerType & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                    KLT_TRACKER |
 #endif
                                    DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
@@ -5331,7 +5762,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     }
 
     if (tracker->m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                   | KLT_TRACKER
 #endif
                                   ) &&
@@ -5367,7 +5798,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
 
     if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       if (tracker->m_trackerType & KLT_TRACKER) {
         tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
       }
@@ -5403,7 +5834,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
     TrackerWrapper *tracker = it->second;
 
     if ((tracker->m_trackerType & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                    KLT_TRACKER |
 #endif
                                    DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
@@ -5411,13 +5842,13 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
     }
 
     if (tracker->m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                   | KLT_TRACKER
 #endif
                                   ) && mapOfColorImages[it->first] == NULL) {
       throw vpException(vpException::fatalError, "Image pointer is NULL!");
     } else if (tracker->m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                   | KLT_TRACKER
 #endif
                                   ) && mapOfColorImages[it->first] != NULL) {
@@ -5453,7 +5884,88 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
     tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
 
     if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
+      if (tracker->m_trackerType & KLT_TRACKER) {
+        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
+      }
+#endif
+
+      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
+        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
+      }
+    }
+  }
+
+  computeProjectionError();
+}
+
+/*!
+  Realize the tracking of the object in the image.
+
+  \throw vpException : if the tracking is supposed to have failed
+
+  \param mapOfImages : Map of images.
+  \param mapOfPointClouds : Map of organized pointclouds, whose X, Y, Z coordinates are stored in contiguous
+  planes. Contrary to the std::vector<vpColVector> representation, no per-point memory allocation is needed
+  and the pointclouds can be views over the sensor buffers.
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                               std::map<std::string, const vpPointCloud<float> *> &mapOfPointClouds)
+{
+  std::map<std::string, unsigned int> mapOfPointCloudWidths, mapOfPointCloudHeights;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+
+    if ((tracker->m_trackerType & (EDGE_TRACKER |
+#if defined(VISP_HAVE_MODULE_KLT)
+                                   KLT_TRACKER |
+#endif
+                                   DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
+      throw vpException(vpException::fatalError, "Bad tracker type: %d", tracker->m_trackerType);
+    }
+
+    if (tracker->m_trackerType & (EDGE_TRACKER
+#if defined(VISP_HAVE_MODULE_KLT)
+                                  | KLT_TRACKER
+#endif
+                                  ) &&
+        mapOfImages[it->first] == NULL) {
+      throw vpException(vpException::fatalError, "Image pointer is NULL!");
+    }
+
+    const vpPointCloud<float> *point_cloud = mapOfPointClouds[it->first];
+    if (tracker->m_trackerType & (DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER) && (point_cloud == NULL)) {
+      throw vpException(vpException::fatalError, "Pointcloud is NULL!");
+    }
+
+    mapOfPointCloudWidths[it->first] = point_cloud != NULL ? point_cloud->getWidth() : 0;
+    mapOfPointCloudHeights[it->first] = point_cloud != NULL ? point_cloud->getHeight() : 0;
+  }
+
+  preTracking(mapOfImages, mapOfPointClouds);
+
+  try {
+    computeVVS(mapOfImages);
+  } catch (...) {
+    covarianceMatrix = -1;
+    throw; // throw the original exception
+  }
+
+  testTracking();
+
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+
+    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
+      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
+    }
+
+    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
+
+    if (displayFeatures) {
+#if defined(VISP_HAVE_MODULE_KLT)
       if (tracker->m_trackerType & KLT_TRACKER) {
         tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
       }
@@ -5468,6 +5980,39 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
   computeProjectionError();
 }
 
+/*!
+  Realize the tracking of the object in the image.
+
+  \throw vpException : if the tracking is supposed to have failed
+
+  \param mapOfColorImages : Map of color images.
+  \param mapOfPointClouds : Map of organized pointclouds, whose X, Y, Z coordinates are stored in contiguous
+  planes.
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &mapOfColorImages,
+                               std::map<std::string, const vpPointCloud<float> *> &mapOfPointClouds)
+{
+  std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+
+    if (tracker->m_trackerType & (EDGE_TRACKER
+#if defined(VISP_HAVE_MODULE_KLT)
+                                  | KLT_TRACKER
+#endif
+                                  )) {
+      if (mapOfColorImages[it->first] == NULL) {
+        throw vpException(vpException::fatalError, "Image pointer is NULL!");
+      }
+      vpImageConvert::convert(*mapOfColorImages[it->first], tracker->m_I);
+      mapOfImages[it->first] = &tracker->m_I; // update grayscale image buffer
+    }
+  }
+
+  track(mapOfImages, mapOfPointClouds);
+}
+
 /** TrackerWrapper **/
 vpMbGenericTracker::TrackerWrapper::TrackerWrapper()
   : m_error(), m_L(), m_trackerType(EDGE_TRACKER), m_w(), m_weightedError()
@@ -5486,7 +6031,7 @@ vpMbGenericTracker::TrackerWrapper::TrackerWrapper(int trackerType)
   : m_error(), m_L(), m_trackerType(trackerType), m_w(), m_weightedError()
 {
   if ((m_trackerType & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                         KLT_TRACKER |
 #endif
                         DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
@@ -5519,7 +6064,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
   unsigned int iter = 0;
 
   double factorEdge = 1.0;
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   double factorKlt = 1.0;
 #endif
   double factorDepth = 1.0;
@@ -5531,7 +6076,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
 
   double mu = m_initialMu;
   vpHomogeneousMatrix cMo_prev;
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   vpHomogeneousMatrix ctTc0_Prev; // Only for KLT
 #endif
   bool isoJoIdentity_ = true;
@@ -5541,7 +6086,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
   vpMatrix L_true, LVJ_true;
 
   unsigned int nb_edge_features = m_error_edge.getRows();
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   unsigned int nb_klt_features = m_error_klt.getRows();
 #endif
   unsigned int nb_depth_features = m_error_depthNormal.getRows();
@@ -5553,7 +6098,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
     bool reStartFromLastIncrement = false;
     computeVVSCheckLevenbergMarquardt(iter, m_error, error_prev, cMo_prev, mu, reStartFromLastIncrement);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
     if (reStartFromLastIncrement) {
       if (m_trackerType & KLT_TRACKER) {
         ctTc0 = ctTc0_Prev;
@@ -5623,7 +6168,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
         start_index += nb_edge_features;
       }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       if (m_trackerType & KLT_TRACKER) {
         for (unsigned int i = 0; i < nb_klt_features; i++) {
           double wi = m_w_klt[i] * factorKlt;
@@ -5679,7 +6224,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
       computeVVSPoseEstimation(isoJoIdentity_, iter, m_L, LTL, m_weightedError, m_error, error_prev, LTR, mu, v);
 
       cMo_prev = m_cMo;
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       if (m_trackerType & KLT_TRACKER) {
         ctTc0_Prev = ctTc0;
       }
@@ -5687,7 +6232,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
 
       m_cMo = vpExponentialMap::direct(v).inverse() * m_cMo;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       if (m_trackerType & KLT_TRACKER) {
         ctTc0 = vpExponentialMap::direct(v).inverse() * ctTc0;
       }
@@ -5715,6 +6260,16 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInit()
 }
 
 void vpMbGenericTracker::TrackerWrapper::computeVVSInit(const vpImage<unsigned char> *const ptr_I)
+{
+  computeVVSInitImpl(ptr_I, true);
+}
+
+/*!
+  Initialize the features of the camera and allocate the residual, and the interaction matrix if
+  \e interactionMatrix is true.
+*/
+void vpMbGenericTracker::TrackerWrapper::computeVVSInitImpl(const vpImage<unsigned char> *const ptr_I,
+                                                            bool interactionMatrix)
 {
   initMbtTracking(ptr_I);
 
@@ -5729,7 +6284,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInit(const vpImage<unsigned c
     m_w_edge.clear();
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     vpMbKltTracker::computeVVSInit();
     nbFeatures += m_error_klt.getRows();
@@ -5752,7 +6307,11 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInit(const vpImage<unsigned c
   }
 
   if (m_trackerType & DEPTH_DENSE_TRACKER) {
-    vpMbDepthDenseTracker::computeVVSInit();
+    if (interactionMatrix) {
+      vpMbDepthDenseTracker::computeVVSInit();
+    } else {
+      vpMbDepthDenseTracker::computeVVSResiduInit();
+    }
     nbFeatures += m_error_depthDense.getRows();
   } else {
     m_error_depthDense.clear();
@@ -5761,10 +6320,15 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInit(const vpImage<unsigned c
     m_w_depthDense.clear();
   }
 
-  m_L.resize(nbFeatures, 6, false, false);
+  if (interactionMatrix) {
+    m_L.resize(nbFeatures, 6, false, false);
+    m_weightedError.resize(nbFeatures, false);
+  } else {
+    m_L.resize(0, 0);
+    m_weightedError.resize(0);
+  }
   m_error.resize(nbFeatures, false);
 
-  m_weightedError.resize(nbFeatures, false);
   m_w.resize(nbFeatures, false);
   m_w = 1;
 }
@@ -5783,7 +6347,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInteractionMatrixAndResidu(co
     vpMbEdgeTracker::computeVVSInteractionMatrixAndResidu(*ptr_I);
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     vpMbKltTracker::computeVVSInteractionMatrixAndResidu();
   }
@@ -5805,7 +6369,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInteractionMatrixAndResidu(co
     start_index += m_error_edge.getRows();
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     m_L.insert(m_L_klt, start_index, 0);
     m_error.insert(start_index, m_error_klt);
@@ -5829,6 +6393,163 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInteractionMatrixAndResidu(co
   }
 }
 
+/*!
+  Compute the normal equations of the features of the camera, in the camera frame. The edge, KLT and depth
+  normal features use their interaction matrix, the dense depth features are accumulated face by face.
+
+  \param mapOfFeatureFactors : Ponderation between each feature type.
+  \param weighted : If true, the features are weighted by the robust weights and the feature factors,
+  otherwise unit weights are used.
+  \param LTL : 6x6 matrix \f$ \mathbf{L}^T \mathbf{W} \mathbf{L} \f$.
+  \param LTR : 6-dim vector \f$ \mathbf{L}^T \mathbf{W} \mathbf{e} \f$.
+  \param num : Weighted sum of the squared residuals.
+  \param den : Sum of the weights.
+  \param nbThreads : Number of threads used to process the dense depth features.
+*/
+void vpMbGenericTracker::TrackerWrapper::computeVVSNormalEquations(
+    const std::map<vpTrackerType, double> &mapOfFeatureFactors, bool weighted, vpMatrix &LTL, vpColVector &LTR,
+    double &num, double &den, unsigned int nbThreads)
+{
+  LTL.resize(6, 6);
+  LTR.resize(6);
+  num = 0;
+  den = 0;
+
+  vpMatrix LTL_;
+  vpColVector LTR_, w, w2;
+
+  // Normal equations of the features of a given type from their interaction matrix and weights,
+  // the rows being weighted by w as in the stacked formulation
+  std::vector<const vpMatrix *> listOfL;
+  std::vector<const vpColVector *> listOfError;
+  std::vector<vpColVector> listOfW;
+
+  if (m_trackerType & EDGE_TRACKER) {
+    double factor = mapOfFeatureFactors.find(EDGE_TRACKER)->second;
+    w.resize(m_error_edge.getRows(), false);
+    for (unsigned int i = 0; i < m_error_edge.getRows(); i++) {
+      w[i] = m_w_edge[i] * m_factor[i] * factor;
+    }
+    listOfL.push_back(&m_L_edge);
+    listOfError.push_back(&m_error_edge);
+    listOfW.push_back(w);
+  }
+
+#if defined(VISP_HAVE_MODULE_KLT)
+  if (m_trackerType & KLT_TRACKER) {
+    listOfL.push_back(&m_L_klt);
+    listOfError.push_back(&m_error_klt);
+    listOfW.push_back(m_w_klt * mapOfFeatureFactors.find(KLT_TRACKER)->second);
+  }
+#endif
+
+  if (m_trackerType & DEPTH_NORMAL_TRACKER) {
+    listOfL.push_back(&m_L_depthNormal);
+    listOfError.push_back(&m_error_depthNormal);
+    listOfW.push_back(m_w_depthNormal * mapOfFeatureFactors.find(DEPTH_NORMAL_TRACKER)->second);
+  }
+
+  for (size_t k = 0; k < listOfL.size(); k++) {
+    const vpColVector &error = *listOfError[k];
+    if (error.getRows() == 0) {
+      continue;
+    }
+
+    if (weighted) {
+      w2.resize(error.getRows(), false);
+      for (unsigned int i = 0; i < error.getRows(); i++) {
+        double wi = listOfW[k][i];
+        w2[i] = wi * wi;
+        num += wi * vpMath::sqr(error[i]);
+        den += wi;
+      }
+    } else {
+      w2.resize(error.getRows(), false);
+      w2 = 1;
+    }
+
+    listOfL[k]->AtA(w2, LTL_);
+    listOfL[k]->Atb(w2, error, LTR_);
+    LTL += LTL_;
+    LTR += LTR_;
+  }
+
+  if (m_trackerType & DEPTH_DENSE_TRACKER) {
+    if (weighted) {
+      double factor = mapOfFeatureFactors.find(DEPTH_DENSE_TRACKER)->second;
+      for (unsigned int i = 0; i < m_error_depthDense.getRows(); i++) {
+        double wi = m_w_depthDense[i] * factor;
+        num += wi * vpMath::sqr(m_error_depthDense[i]);
+        den += wi;
+      }
+
+      vpMbDepthDenseTracker::computeVVSNormalEquations(m_w_depthDense, LTL_, LTR_, nbThreads);
+      LTL += LTL_ * (factor * factor);
+      LTR += LTR_ * (factor * factor);
+    } else {
+      vpMbDepthDenseTracker::computeVVSNormalEquations(vpColVector(), LTL_, LTR_, nbThreads);
+      LTL += LTL_;
+      LTR += LTR_;
+    }
+  }
+}
+
+/*!
+  Compute the residual of the features of the camera. Only the edge, KLT and depth normal features compute
+  their interaction matrix.
+*/
+void vpMbGenericTracker::TrackerWrapper::computeVVSResidu(const vpImage<unsigned char> *const ptr_I)
+{
+  if (m_trackerType & EDGE_TRACKER) {
+    vpMbEdgeTracker::computeVVSInteractionMatrixAndResidu(*ptr_I);
+  }
+
+#if defined(VISP_HAVE_MODULE_KLT)
+  if (m_trackerType & KLT_TRACKER) {
+    vpMbKltTracker::computeVVSInteractionMatrixAndResidu();
+  }
+#endif
+
+  if (m_trackerType & DEPTH_NORMAL_TRACKER) {
+    vpMbDepthNormalTracker::computeVVSInteractionMatrixAndResidu();
+  }
+
+  if (m_trackerType & DEPTH_DENSE_TRACKER) {
+    vpMbDepthDenseTracker::computeVVSResidu();
+  }
+
+  unsigned int start_index = 0;
+  if (m_trackerType & EDGE_TRACKER) {
+    m_error.insert(start_index, m_error_edge);
+    start_index += m_error_edge.getRows();
+  }
+
+#if defined(VISP_HAVE_MODULE_KLT)
+  if (m_trackerType & KLT_TRACKER) {
+    m_error.insert(start_index, m_error_klt);
+    start_index += m_error_klt.getRows();
+  }
+#endif
+
+  if (m_trackerType & DEPTH_NORMAL_TRACKER) {
+    m_error.insert(start_index, m_error_depthNormal);
+    start_index += m_error_depthNormal.getRows();
+  }
+
+  if (m_trackerType & DEPTH_DENSE_TRACKER) {
+    m_error.insert(start_index, m_error_depthDense);
+  }
+}
+
+/*!
+  Same as computeVVSInit() without allocating the interaction matrices that are not needed by
+  computeVVSNormalEquations().
+*/
+void vpMbGenericTracker::TrackerWrapper::computeVVSResiduInit(const vpImage<unsigned char> *const ptr_I)
+{
+  computeVVSInitImpl(ptr_I, false);
+}
+
 void vpMbGenericTracker::TrackerWrapper::computeVVSWeights()
 {
   unsigned int start_index = 0;
@@ -5840,7 +6561,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSWeights()
     start_index += m_w_edge.getRows();
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     vpMbTracker::computeVVSWeights(m_robust_klt, m_error_klt, m_w_klt);
     m_w.insert(start_index, m_w_klt);
@@ -5936,7 +6657,7 @@ void vpMbGenericTracker::TrackerWrapper::display(const vpImage<unsigned char> &I
 
 #ifdef VISP_HAVE_OGRE
   if ((m_trackerType & EDGE_TRACKER)
-    #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+    #if defined(VISP_HAVE_MODULE_KLT)
       || (m_trackerType & KLT_TRACKER)
     #endif
       ) {
@@ -6016,7 +6737,7 @@ void vpMbGenericTracker::TrackerWrapper::display(const vpImage<vpRGBa> &I, const
 
 #ifdef VISP_HAVE_OGRE
   if ((m_trackerType & EDGE_TRACKER)
-    #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+    #if defined(VISP_HAVE_MODULE_KLT)
       || (m_trackerType & KLT_TRACKER)
     #endif
       ) {
@@ -6035,7 +6756,7 @@ std::vector<std::vector<double> > vpMbGenericTracker::TrackerWrapper::getFeature
     features.insert(features.end(), m_featuresToBeDisplayedEdge.begin(), m_featuresToBeDisplayedEdge.end());
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     //m_featuresToBeDisplayedKlt updated after postTracking()
     features.insert(features.end(), m_featuresToBeDisplayedKlt.begin(), m_featuresToBeDisplayedKlt.end());
@@ -6061,7 +6782,7 @@ std::vector<std::vector<double> > vpMbGenericTracker::TrackerWrapper::getModelFo
   if (m_trackerType == EDGE_TRACKER) {
     models = vpMbEdgeTracker::getModelForDisplay(width, height, cMo, cam, displayFullModel);
   }
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   else if (m_trackerType == KLT_TRACKER) {
     models = vpMbKltTracker::getModelForDisplay(width, height, cMo, cam, displayFullModel);
   }
@@ -6123,7 +6844,7 @@ void vpMbGenericTracker::TrackerWrapper::init(const vpImage<unsigned char> &I)
     faces.computeScanLineRender(m_cam, I.getWidth(), I.getHeight());
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::reinit(I);
 #endif
@@ -6150,7 +6871,7 @@ void vpMbGenericTracker::TrackerWrapper::initCircle(const vpPoint &p1, const vpP
   if (m_trackerType & EDGE_TRACKER)
     vpMbEdgeTracker::initCircle(p1, p2, p3, radius, idFace, name);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::initCircle(p1, p2, p3, radius, idFace, name);
 #endif
@@ -6162,7 +6883,7 @@ void vpMbGenericTracker::TrackerWrapper::initCylinder(const vpPoint &p1, const v
   if (m_trackerType & EDGE_TRACKER)
     vpMbEdgeTracker::initCylinder(p1, p2, radius, idFace, name);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::initCylinder(p1, p2, radius, idFace, name);
 #endif
@@ -6173,7 +6894,7 @@ void vpMbGenericTracker::TrackerWrapper::initFaceFromCorners(vpMbtPolygon &polyg
   if (m_trackerType & EDGE_TRACKER)
     vpMbEdgeTracker::initFaceFromCorners(polygon);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::initFaceFromCorners(polygon);
 #endif
@@ -6190,7 +6911,7 @@ void vpMbGenericTracker::TrackerWrapper::initFaceFromLines(vpMbtPolygon &polygon
   if (m_trackerType & EDGE_TRACKER)
     vpMbEdgeTracker::initFaceFromLines(polygon);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::initFaceFromLines(polygon);
 #endif
@@ -6232,7 +6953,7 @@ void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string &confi
   xmlp.setKltHarrisParam(0.01);
   xmlp.setKltBlockSize(3);
   xmlp.setKltPyramidLevels(3);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   xmlp.setKltMaskBorder(maskBorder);
 #endif
 
@@ -6256,7 +6977,7 @@ void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string &confi
     std::vector<std::string> tracker_names;
     if (m_trackerType & EDGE_TRACKER)
       tracker_names.push_back("Edge");
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
     if (m_trackerType & KLT_TRACKER)
       tracker_names.push_back("Klt");
 #endif
@@ -6316,7 +7037,7 @@ void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string &confi
   vpMbEdgeTracker::setMovingEdge(meParser);
 
 // KLT
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   tracker.setMaxFeatures((int)xmlp.getKltMaxFeatures());
   tracker.setWindowSize((int)xmlp.getKltWindowSize());
   tracker.setQuality(xmlp.getKltQuality());
@@ -6345,7 +7066,7 @@ void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string &confi
 void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned char> *const ptr_I,
                                                       const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud)
 {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   // KLT
   if (m_trackerType & KLT_TRACKER) {
     if (vpMbKltTracker::postTracking(*ptr_I, m_w_klt)) {
@@ -6399,7 +7120,7 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
     }
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     try {
       vpMbKltTracker::preTracking(*ptr_I);
@@ -6434,7 +7155,7 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
                                                       const unsigned int pointcloud_width,
                                                       const unsigned int pointcloud_height)
 {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   // KLT
   if (m_trackerType & KLT_TRACKER) {
     if (vpMbKltTracker::postTracking(*ptr_I, m_w_klt)) {
@@ -6490,7 +7211,7 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
     }
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     try {
       vpMbKltTracker::preTracking(*ptr_I);
@@ -6520,6 +7241,48 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
   }
 }
 
+void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char> *const ptr_I,
+                                                     const vpPointCloud<float> *const point_cloud)
+{
+  if (m_trackerType & EDGE_TRACKER) {
+    try {
+      vpMbEdgeTracker::trackMovingEdge(*ptr_I);
+    } catch (...) {
+      std::cerr << "Error in moving edge tracking" << std::endl;
+      throw;
+    }
+  }
+
+#if defined(VISP_HAVE_MODULE_KLT)
+  if (m_trackerType & KLT_TRACKER) {
+    try {
+      vpMbKltTracker::preTracking(*ptr_I);
+    } catch (const vpException &e) {
+      std::cerr << "Error in KLT tracking: " << e.what() << std::endl;
+      throw;
+    }
+  }
+#endif
+
+  if (m_trackerType & DEPTH_NORMAL_TRACKER) {
+    try {
+      vpMbDepthNormalTracker::segmentPointCloud(*point_cloud);
+    } catch (...) {
+      std::cerr << "Error in Depth tracking" << std::endl;
+      throw;
+    }
+  }
+
+  if (m_trackerType & DEPTH_DENSE_TRACKER) {
+    try {
+      vpMbDepthDenseTracker::segmentPointCloud(*point_cloud);
+    } catch (...) {
+      std::cerr << "Error in Depth dense tracking" << std::endl;
+      throw;
+    }
+  }
+}
+
 void vpMbGenericTracker::TrackerWrapper::reInitModel(const vpImage<unsigned char> * const I, const vpImage<vpRGBa> * const I_color,
                                                      const std::string &cad_name, const vpHomogeneousMatrix &cMo, bool verbose,
                                                      const vpHomogeneousMatrix &T)
@@ -6567,8 +7330,8 @@ void vpMbGenericTracker::TrackerWrapper::reInitModel(const vpImage<unsigned char
   nbvisiblepolygone = 0;
 
 // KLT
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+#if defined(VISP_HAVE_MODULE_KLT)
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100) && (VISP_HAVE_OPENCV_VERSION < 0x020408)
   if (cur != NULL) {
     cvReleaseImage(&cur);
     cur = NULL;
@@ -6650,7 +7413,7 @@ void vpMbGenericTracker::TrackerWrapper::reInitModel(const vpImage<vpRGBa> &I_co
 void vpMbGenericTracker::TrackerWrapper::resetTracker()
 {
   vpMbEdgeTracker::resetTracker();
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   vpMbKltTracker::resetTracker();
 #endif
   vpMbDepthNormalTracker::resetTracker();
@@ -6662,7 +7425,7 @@ void vpMbGenericTracker::TrackerWrapper::setCameraParameters(const vpCameraParam
   m_cam = cam;
 
   vpMbEdgeTracker::setCameraParameters(m_cam);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   vpMbKltTracker::setCameraParameters(m_cam);
 #endif
   vpMbDepthNormalTracker::setCameraParameters(m_cam);
@@ -6700,7 +7463,7 @@ void vpMbGenericTracker::TrackerWrapper::setPose(const vpImage<unsigned char> *
     vpImageConvert::convert(*I_color, m_I);
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     performKltSetPose = true;
 
@@ -6774,7 +7537,7 @@ void vpMbGenericTracker::TrackerWrapper::setProjectionErrorComputation(const boo
 void vpMbGenericTracker::TrackerWrapper::setScanLineVisibilityTest(const bool &v)
 {
   vpMbEdgeTracker::setScanLineVisibilityTest(v);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   vpMbKltTracker::setScanLineVisibilityTest(v);
 #endif
   vpMbDepthNormalTracker::setScanLineVisibilityTest(v);
@@ -6784,7 +7547,7 @@ void vpMbGenericTracker::TrackerWrapper::setScanLineVisibilityTest(const bool &v
 void vpMbGenericTracker::TrackerWrapper::setTrackerType(int type)
 {
   if ((type & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                KLT_TRACKER |
 #endif
                DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
@@ -6808,7 +7571,7 @@ void vpMbGenericTracker::TrackerWrapper::track(const vpImage<unsigned char> &
 )
 {
   if ((m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                         | KLT_TRACKER
 #endif
                         )) == 0) {
@@ -6831,7 +7594,7 @@ void vpMbGenericTracker::TrackerWrapper::track(const vpImage<unsigned char> *con
                                                const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud)
 {
   if ((m_trackerType & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                         KLT_TRACKER |
 #endif
                         DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
@@ -6840,7 +7603,7 @@ void vpMbGenericTracker::TrackerWrapper::track(const vpImage<unsigned char> *con
   }
 
   if (m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                        | KLT_TRACKER
 #endif
                        ) &&
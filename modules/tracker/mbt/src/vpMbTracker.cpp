@@ -47,8 +47,6 @@
 #include <iostream>
 #include <limits>
 
-#include <Simd/SimdLib.hpp>
-
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpMath.h>
@@ -2882,9 +2880,7 @@ void vpMbTracker::computeJTR(const vpMatrix &interaction, const vpColVector &err
     throw vpMatrixException(vpMatrixException::incorrectMatrixSizeError, "Incorrect matrices size in computeJTR.");
   }
 
-  JTR.resize(6, false);
-
-  SimdComputeJtR(interaction.data, interaction.getRows(), error.data, JTR.data);
+  interaction.Atb(error, JTR);
 }
 
 void vpMbTracker::computeVVSCheckLevenbergMarquardt(unsigned int iter, vpColVector &error,
@@ -2915,30 +2911,10 @@ void vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, unsigned i
                                            const vpColVector *const w, vpColVector *const m_w_prev)
 {
   if (isoJoIdentity_) {
-    LTL = L.AtA();
+    L.AtA(LTL);
     computeJTR(L, R, LTR);
 
-    switch (m_optimizationMethod) {
-    case vpMbTracker::LEVENBERG_MARQUARDT_OPT: {
-      vpMatrix LMA(LTL.getRows(), LTL.getCols());
-      LMA.eye();
-      vpMatrix LTLmuI = LTL + (LMA * mu);
-      v = -m_lambda * LTLmuI.pseudoInverse(LTLmuI.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
-
-      if (iter != 0)
-        mu /= 10.0;
-
-      error_prev = error;
-      if (w != NULL && m_w_prev != NULL)
-        *m_w_prev = *w;
-      break;
-    }
-
-    case vpMbTracker::GAUSS_NEWTON_OPT:
-    default:
-      v = -m_lambda * LTL.pseudoInverse(LTL.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
-      break;
-    }
+    solveVVSNormalEquations(iter, LTL, LTR, error, error_prev, mu, v, w, m_w_prev);
   } else {
     vpVelocityTwistMatrix cVo;
     cVo.buildFrom(m_cMo);
@@ -2947,28 +2923,42 @@ void vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, unsigned i
     vpColVector LVJTR;
     computeJTR(LVJ, R, LVJTR);
 
-    switch (m_optimizationMethod) {
-    case vpMbTracker::LEVENBERG_MARQUARDT_OPT: {
-      vpMatrix LMA(LVJTLVJ.getRows(), LVJTLVJ.getCols());
-      LMA.eye();
-      vpMatrix LTLmuI = LVJTLVJ + (LMA * mu);
-      v = -m_lambda * LTLmuI.pseudoInverse(LTLmuI.getRows() * std::numeric_limits<double>::epsilon()) * LVJTR;
-      v = cVo * v;
+    solveVVSNormalEquations(iter, LVJTLVJ, LVJTR, error, error_prev, mu, v, w, m_w_prev);
+    v = cVo * v;
+  }
+}
 
-      if (iter != 0)
-        mu /= 10.0;
+/*!
+  Compute the velocity from the normal equations of the virtual visual servoing
+  problem, without the interaction matrix.
+
+  \param isoJoIdentity_ : If false, only the degrees of freedom given by oJo are estimated.
+  \param iter : Current iteration.
+  \param LTL : 6x6 matrix \f$ \mathbf{L}^T \mathbf{W} \mathbf{L} \f$, where \f$ \mathbf{L} \f$ is the weighted
+  interaction matrix expressed in the object frame.
+  \param LTR : 6-dim vector \f$ \mathbf{L}^T \mathbf{W} \mathbf{e} \f$.
+  \param error : Current residual, saved in \e error_prev with the Levenberg-Marquardt method.
+  \param error_prev : Residual of the previous iteration.
+  \param mu : Levenberg-Marquardt damping factor.
+  \param v : Computed velocity.
+*/
+void vpMbTracker::computeVVSPoseEstimationFromNormalEquations(const bool isoJoIdentity_, unsigned int iter,
+                                                              const vpMatrix &LTL, const vpColVector &LTR,
+                                                              const vpColVector &error, vpColVector &error_prev,
+                                                              double &mu, vpColVector &v)
+{
+  if (isoJoIdentity_) {
+    solveVVSNormalEquations(iter, LTL, LTR, error, error_prev, mu, v);
+  } else {
+    vpVelocityTwistMatrix cVo;
+    cVo.buildFrom(m_cMo);
+    vpMatrix VJ = cVo * oJo;
+    vpMatrix VJT = VJ.t();
+    vpMatrix LVJTLVJ = VJT * LTL * VJ;
+    vpColVector LVJTR = VJT * LTR;
 
-      error_prev = error;
-      if (w != NULL && m_w_prev != NULL)
-        *m_w_prev = *w;
-      break;
-    }
-    case vpMbTracker::GAUSS_NEWTON_OPT:
-    default:
-      v = -m_lambda * LVJTLVJ.pseudoInverse(LVJTLVJ.getRows() * std::numeric_limits<double>::epsilon()) * LVJTR;
-      v = cVo * v;
-      break;
-    }
+    solveVVSNormalEquations(iter, LVJTLVJ, LVJTR, error, error_prev, mu, v);
+    v = cVo * v;
   }
 }
 
@@ -2978,6 +2968,33 @@ void vpMbTracker::computeVVSWeights(vpRobust &robust, const vpColVector &error,
     robust.MEstimator(vpRobust::TUKEY, error, w);
 }
 
+void vpMbTracker::solveVVSNormalEquations(unsigned int iter, const vpMatrix &LTL, const vpColVector &LTR,
+                                          const vpColVector &error, vpColVector &error_prev, double &mu,
+                                          vpColVector &v, const vpColVector *const w, vpColVector *const m_w_prev)
+{
+  switch (m_optimizationMethod) {
+  case vpMbTracker::LEVENBERG_MARQUARDT_OPT: {
+    vpMatrix LMA(LTL.getRows(), LTL.getCols());
+    LMA.eye();
+    vpMatrix LTLmuI = LTL + (LMA * mu);
+    v = -m_lambda * LTLmuI.pseudoInverse(LTLmuI.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
+
+    if (iter != 0)
+      mu /= 10.0;
+
+    error_prev = error;
+    if (w != NULL && m_w_prev != NULL)
+      *m_w_prev = *w;
+    break;
+  }
+
+  case vpMbTracker::GAUSS_NEWTON_OPT:
+  default:
+    v = -m_lambda * LTL.pseudoInverse(LTL.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
+    break;
+  }
+}
+
 /*!
   Get a 1x6 vpColVector representing the estimated degrees of freedom.
   vpColVector[0] = 1 if translation on X is estimated, 0 otherwise;
@@ -292,6 +292,133 @@ TEST_CASE("Benchmark generic tracker", "[benchmark]") {
         CHECK(sqrt(tu_err.sumSquare()) < max_rotation_error);
       }
     }
+
+    // Stereo MBT with the cameras processed in parallel
+    {
+      std::map<std::string, int> mapOfTrackerTypes;
+      mapOfTrackerTypes["Camera1"] = vpMbGenericTracker::EDGE_TRACKER;
+      mapOfTrackerTypes["Camera2"] = vpMbGenericTracker::DEPTH_DENSE_TRACKER;
+
+      std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+      mapOfWidths["Camera2"] = I_depth_raw.getWidth();
+      mapOfHeights["Camera2"] = I_depth_raw.getHeight();
+
+      std::vector<unsigned int> nbThreads = {1, 2};
+      std::vector<std::string> benchmarkNames = {
+        "Edge + Depth dense MBT, sequential cameras",
+        "Edge + Depth dense MBT, multithreaded cameras"
+      };
+
+      std::vector<vpHomogeneousMatrix> cMo_last;
+      for (size_t idx = 0; idx < nbThreads.size(); idx++) {
+        tracker.resetTracker();
+        tracker.setTrackerType(mapOfTrackerTypes);
+        tracker.setNbThreads(nbThreads[idx]);
+
+        tracker.loadConfigFile(configFileCam1, configFileCam2);
+        tracker.loadModel(input_directory + "/Models/chateau.cao", input_directory + "/Models/chateau.cao");
+        tracker.loadModel(input_directory + "/Models/cube.cao", false, T);
+        tracker.initFromPose(images.front(), cMo_truth_all.front());
+
+        vpHomogeneousMatrix cMo;
+        BENCHMARK(benchmarkNames[idx].c_str())
+        {
+          tracker.initFromPose(images.front(), cMo_truth_all.front());
+
+          for (size_t i = 0; i < images.size(); i++) {
+            std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+            mapOfImages["Camera1"] = &images[i];
+
+            std::map<std::string, const std::vector<vpColVector> *> mapOfPointclouds;
+            mapOfPointclouds["Camera2"] = &pointclouds[i];
+
+            tracker.track(mapOfImages, mapOfPointclouds, mapOfWidths, mapOfHeights);
+            cMo = tracker.getPose();
+          }
+
+          return cMo;
+        };
+
+        cMo_last.push_back(cMo);
+      }
+
+      // The pose must not depend on the number of threads
+      for (unsigned int i = 0; i < 3; i++) {
+        for (unsigned int j = 0; j < 4; j++) {
+          CHECK(cMo_last[0][i][j] == Approx(cMo_last[1][i][j]).epsilon(std::numeric_limits<double>::epsilon()));
+        }
+      }
+      tracker.setNbThreads(1);
+    }
+
+    // Depth dense MBT fed with std::vector<vpColVector> or vpPointCloud<float>
+    {
+      std::vector<vpPointCloud<float> > organized_pointclouds(pointclouds.size());
+      for (size_t i = 0; i < pointclouds.size(); i++) {
+        organized_pointclouds[i].buildFrom(pointclouds[i], I_depth_raw.getHeight(), I_depth_raw.getWidth());
+      }
+
+      std::map<std::string, int> mapOfTrackerTypes;
+      mapOfTrackerTypes["Camera1"] = vpMbGenericTracker::EDGE_TRACKER;
+      mapOfTrackerTypes["Camera2"] = vpMbGenericTracker::DEPTH_DENSE_TRACKER;
+
+      std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+      mapOfWidths["Camera2"] = I_depth_raw.getWidth();
+      mapOfHeights["Camera2"] = I_depth_raw.getHeight();
+
+      std::vector<std::string> benchmarkNames = {
+        "Edge + Depth dense MBT, std::vector<vpColVector> point cloud",
+        "Edge + Depth dense MBT, vpPointCloud<float> point cloud"
+      };
+
+      std::vector<vpHomogeneousMatrix> cMo_last;
+      for (size_t idx = 0; idx < benchmarkNames.size(); idx++) {
+        tracker.resetTracker();
+        tracker.setTrackerType(mapOfTrackerTypes);
+
+        tracker.loadConfigFile(configFileCam1, configFileCam2);
+        tracker.loadModel(input_directory + "/Models/chateau.cao", input_directory + "/Models/chateau.cao");
+        tracker.loadModel(input_directory + "/Models/cube.cao", false, T);
+        tracker.initFromPose(images.front(), cMo_truth_all.front());
+
+        vpHomogeneousMatrix cMo;
+        BENCHMARK(benchmarkNames[idx].c_str())
+        {
+          tracker.initFromPose(images.front(), cMo_truth_all.front());
+
+          for (size_t i = 0; i < images.size(); i++) {
+            std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+            mapOfImages["Camera1"] = &images[i];
+
+            if (idx == 0) {
+              std::map<std::string, const std::vector<vpColVector> *> mapOfPointclouds;
+              mapOfPointclouds["Camera2"] = &pointclouds[i];
+              tracker.track(mapOfImages, mapOfPointclouds, mapOfWidths, mapOfHeights);
+            } else {
+              std::map<std::string, const vpPointCloud<float> *> mapOfPointclouds;
+              mapOfPointclouds["Camera2"] = &organized_pointclouds[i];
+              tracker.track(mapOfImages, mapOfPointclouds);
+            }
+            cMo = tracker.getPose();
+          }
+
+          return cMo;
+        };
+
+        cMo_last.push_back(cMo);
+      }
+
+      // Coordinates are stored in single precision with vpPointCloud<float>
+      vpPoseVector pose_vector(cMo_last[0]);
+      vpPoseVector pose_organized(cMo_last[1]);
+      vpColVector t_err(3), tu_err(3);
+      for (unsigned int i = 0; i < 3; i++) {
+        t_err[i] = pose_vector[i] - pose_organized[i];
+        tu_err[i] = pose_vector[i+3] - pose_organized[i+3];
+      }
+      CHECK(sqrt(t_err.sumSquare()) < 1e-3);
+      CHECK(sqrt(tu_err.sumSquare()) < 1e-3);
+    }
   } //if (runBenchmark)
 }
 
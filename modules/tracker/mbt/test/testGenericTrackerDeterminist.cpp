@@ -227,6 +227,39 @@ TEST_CASE("Check Stereo MBT determinism parallel", "[MBT_determinism]") {
   checkPoses(cMo1, cMo2);
 }
 
+TEST_CASE("Check Stereo MBT determinism multithreaded cameras", "[MBT_determinism]") {
+  // Sequential processing of the cameras
+  vpMbGenericTracker tracker1(2);
+  vpCameraParameters cam;
+  configureTracker(tracker1, cam);
+
+  vpImage<unsigned char> I;
+  vpHomogeneousMatrix cMo1;
+  for (int cpt = 0; read_data(cpt, I); cpt++) {
+    tracker1.track(I, I);
+    tracker1.getPose(cMo1);
+  }
+
+  // One thread per camera
+  vpMbGenericTracker tracker2(2);
+  configureTracker(tracker2, cam);
+  tracker2.setNbThreads(2);
+  CHECK(tracker2.getNbThreads() == 2);
+
+  vpHomogeneousMatrix cMo2;
+  for (int cpt = 0; read_data(cpt, I); cpt++) {
+    tracker2.track(I, I);
+    tracker2.getPose(cMo2);
+  }
+
+  std::cout << "Run stereo trackers with sequential and multithreaded cameras processing" << std::endl;
+  std::cout << "Sequential tracker, final cMo:\n" << cMo1 << std::endl;
+  std::cout << "Multithreaded tracker, final cMo:\n" << cMo2 << std::endl;
+
+  // Check that both poses are identical
+  checkPoses(cMo1, cMo2);
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session; // There must be exactly one instance
@@ -0,0 +1,330 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the generic tracker pose estimation from accumulated normal equations.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testGenericTrackerNormalEquations.cpp
+
+  Check on synthetic images and point clouds of a cube that the pose estimated
+  from the accumulated normal equations (vpMbGenericTracker::setStreamNormalEquations())
+  is the same as the one estimated from the stacked interaction matrix.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <fstream>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+namespace
+{
+const double g_halfSize = 0.05;
+const unsigned int g_height = 480, g_width = 640;
+
+std::string writeCubeModel()
+{
+  std::string username;
+  vpIoTools::getUserName(username);
+#if defined(_WIN32)
+  std::string tmp_dir = "C:/temp/" + username;
+#else
+  std::string tmp_dir = "/tmp/" + username;
+#endif
+  vpIoTools::makeDirectory(tmp_dir);
+  std::string filename = vpIoTools::createFilePath(tmp_dir, "testGenericTrackerNormalEquations_cube.cao");
+
+  std::ofstream file(filename.c_str());
+  const double s = 2 * g_halfSize, h = g_halfSize;
+  file << "V1\n8\n";
+  file << h << " " << -h << " " << -h << "\n";
+  file << h - s << " " << -h << " " << -h << "\n";
+  file << h - s << " " << h << " " << -h << "\n";
+  file << h << " " << h << " " << -h << "\n";
+  file << h << " " << -h << " " << h << "\n";
+  file << h - s << " " << -h << " " << h << "\n";
+  file << h - s << " " << h << " " << h << "\n";
+  file << h << " " << h << " " << h << "\n";
+  file << "0\n0\n6\n";
+  file << "4 0 4 5 1\n4 1 5 6 2\n4 6 7 3 2\n4 3 7 4 0\n4 0 1 2 3\n4 7 6 5 4\n";
+  file << "0\n0\n";
+
+  return filename;
+}
+
+// Ray cast the cube: each face has its own gray level, the background is black
+void render(const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo, vpImage<unsigned char> &I,
+            vpPointCloud<float> &pointcloud)
+{
+  I.resize(g_height, g_width, 0);
+  pointcloud.resize(g_height, g_width);
+
+  vpHomogeneousMatrix oMc = cMo.inverse();
+  vpRotationMatrix oRc = oMc.getRotationMatrix();
+  vpTranslationVector oC = oMc.getTranslationVector();
+
+  for (unsigned int i = 0; i < g_height; i++) {
+    for (unsigned int j = 0; j < g_width; j++) {
+      vpColVector d(3, 1.0);
+      d[0] = (j - cam.get_u0()) / cam.get_px();
+      d[1] = (i - cam.get_v0()) / cam.get_py();
+      vpColVector od = oRc * d;
+
+      double t_min = -1;
+      int face_min = -1;
+      for (unsigned int k = 0; k < 3; k++) {
+        for (int sign = -1; sign <= 1; sign += 2) {
+          if (std::fabs(od[k]) < 1e-12) {
+            continue;
+          }
+          double t = (sign * g_halfSize - oC[k]) / od[k];
+          bool inside = t > 0;
+          for (unsigned int l = 0; l < 3 && inside; l++) {
+            inside = (l == k) || std::fabs(oC[l] + t * od[l]) <= g_halfSize;
+          }
+          if (inside && (t_min < 0 || t < t_min)) {
+            t_min = t;
+            face_min = static_cast<int>(2 * k) + (sign > 0 ? 1 : 0);
+          }
+        }
+      }
+
+      unsigned int idx = i * g_width + j;
+      if (face_min >= 0) {
+        I[i][j] = static_cast<unsigned char>(60 + 35 * face_min);
+        pointcloud.getX()[idx] = static_cast<float>(t_min * d[0]);
+        pointcloud.getY()[idx] = static_cast<float>(t_min * d[1]);
+        pointcloud.getZ()[idx] = static_cast<float>(t_min);
+      }
+    }
+  }
+}
+
+void checkPoses(const vpHomogeneousMatrix &cMo1, const vpHomogeneousMatrix &cMo2, double threshold)
+{
+  vpPoseVector p1(cMo1), p2(cMo2);
+  for (unsigned int i = 0; i < 6; i++) {
+    CHECK(p1[i] == Approx(p2[i]).margin(threshold));
+  }
+}
+
+vpHomogeneousMatrix trackOneCamera(int trackerType, bool stream, unsigned int nbThreads, bool covariance,
+                                   const std::string &model, const vpCameraParameters &cam,
+                                   const vpImage<unsigned char> &I, const vpPointCloud<float> &pointcloud,
+                                   const vpHomogeneousMatrix &cMo_init, vpMatrix &covarianceMatrix)
+{
+  vpMbGenericTracker tracker(1, trackerType);
+  tracker.setCameraParameters(cam);
+  tracker.setDepthDenseSamplingStep(2, 2);
+  tracker.setNbThreads(nbThreads);
+  tracker.setStreamNormalEquations(stream);
+  tracker.setCovarianceComputation(covariance);
+  tracker.loadModel(model);
+  tracker.initFromPose(I, cMo_init);
+
+  std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+  mapOfImages["Camera"] = &I;
+  std::map<std::string, const vpPointCloud<float> *> mapOfPointClouds;
+  mapOfPointClouds["Camera"] = &pointcloud;
+  tracker.track(mapOfImages, mapOfPointClouds);
+
+  if (covariance) {
+    covarianceMatrix = tracker.getCovarianceMatrix();
+  }
+  return tracker.getPose();
+}
+} // namespace
+
+TEST_CASE("Depth dense tracking from accumulated normal equations", "[vpMbGenericTracker]")
+{
+  const std::string model = writeCubeModel();
+  vpCameraParameters cam(600, 600, g_width / 2.0, g_height / 2.0);
+  const vpHomogeneousMatrix cMo_truth(0.01, -0.02, 0.45, vpMath::rad(30), vpMath::rad(-40), vpMath::rad(10));
+  const vpHomogeneousMatrix cMo_init = vpHomogeneousMatrix(0.005, 0.004, -0.01, 0.03, -0.02, 0.02) * cMo_truth;
+
+  vpImage<unsigned char> I;
+  vpPointCloud<float> pointcloud;
+  render(cam, cMo_truth, I, pointcloud);
+
+  vpMatrix covariance;
+  vpHomogeneousMatrix cMo_stacked = trackOneCamera(vpMbGenericTracker::DEPTH_DENSE_TRACKER, false, 1, false, model,
+                                                   cam, I, pointcloud, cMo_init, covariance);
+  vpHomogeneousMatrix cMo_stream = trackOneCamera(vpMbGenericTracker::DEPTH_DENSE_TRACKER, true, 1, false, model, cam,
+                                                  I, pointcloud, cMo_init, covariance);
+  checkPoses(cMo_stacked, cMo_truth, 5e-3);
+  checkPoses(cMo_stream, cMo_stacked, 1e-8);
+
+  SECTION("The pose does not depend on the number of threads")
+  {
+    vpHomogeneousMatrix cMo_stream_mt = trackOneCamera(vpMbGenericTracker::DEPTH_DENSE_TRACKER, true, 4, false, model,
+                                                       cam, I, pointcloud, cMo_init, covariance);
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 4; j++) {
+        CHECK(cMo_stream_mt[i][j] == cMo_stream[i][j]);
+      }
+    }
+  }
+
+  SECTION("The pose does not depend on the SIMD level")
+  {
+    const vpCPUFeatures::vpSimdLevel simdLevel = vpCPUFeatures::getSimdLevel();
+    for (int level = vpCPUFeatures::SIMD_NONE; level <= simdLevel; level++) {
+      vpCPUFeatures::setSimdLevel(static_cast<vpCPUFeatures::vpSimdLevel>(level));
+      INFO("SIMD level " << vpCPUFeatures::getSimdLevelName(vpCPUFeatures::getSimdLevel()));
+      vpHomogeneousMatrix cMo_level = trackOneCamera(vpMbGenericTracker::DEPTH_DENSE_TRACKER, false, 1, false, model,
+                                                     cam, I, pointcloud, cMo_init, covariance);
+      checkPoses(cMo_level, cMo_stacked, 1e-8);
+    }
+    vpCPUFeatures::setSimdLevel(simdLevel);
+  }
+
+  SECTION("The depth normal pose does not depend on the SIMD level")
+  {
+    const vpCPUFeatures::vpSimdLevel simdLevel = vpCPUFeatures::getSimdLevel();
+    const vpHomogeneousMatrix cMo_normal = trackOneCamera(vpMbGenericTracker::DEPTH_NORMAL_TRACKER, false, 1, false,
+                                                          model, cam, I, pointcloud, cMo_init, covariance);
+    for (int level = vpCPUFeatures::SIMD_NONE; level < simdLevel; level++) {
+      vpCPUFeatures::setSimdLevel(static_cast<vpCPUFeatures::vpSimdLevel>(level));
+      INFO("SIMD level " << vpCPUFeatures::getSimdLevelName(vpCPUFeatures::getSimdLevel()));
+      vpHomogeneousMatrix cMo_level = trackOneCamera(vpMbGenericTracker::DEPTH_NORMAL_TRACKER, false, 1, false, model,
+                                                     cam, I, pointcloud, cMo_init, covariance);
+      checkPoses(cMo_level, cMo_normal, 1e-8);
+    }
+    vpCPUFeatures::setSimdLevel(simdLevel);
+  }
+
+  SECTION("The stacked interaction matrix is used when the covariance is computed")
+  {
+    vpMatrix covariance_stacked, covariance_stream;
+    cMo_stacked = trackOneCamera(vpMbGenericTracker::DEPTH_DENSE_TRACKER, false, 1, true, model, cam, I, pointcloud,
+                                 cMo_init, covariance_stacked);
+    cMo_stream = trackOneCamera(vpMbGenericTracker::DEPTH_DENSE_TRACKER, true, 1, true, model, cam, I, pointcloud,
+                                cMo_init, covariance_stream);
+    REQUIRE(covariance_stream.getRows() == 6);
+    for (unsigned int i = 0; i < 6; i++) {
+      for (unsigned int j = 0; j < 6; j++) {
+        CHECK(covariance_stream[i][j] == covariance_stacked[i][j]);
+      }
+    }
+  }
+}
+
+TEST_CASE("Edge and depth dense tracking from accumulated normal equations", "[vpMbGenericTracker]")
+{
+  const std::string model = writeCubeModel();
+  vpCameraParameters cam(600, 600, g_width / 2.0, g_height / 2.0);
+  const vpHomogeneousMatrix cMo_truth(-0.01, 0.01, 0.5, vpMath::rad(-25), vpMath::rad(35), vpMath::rad(-5));
+  const vpHomogeneousMatrix cMo_init = vpHomogeneousMatrix(-0.003, 0.002, 0.005, -0.01, 0.015, 0.01) * cMo_truth;
+
+  vpImage<unsigned char> I;
+  vpPointCloud<float> pointcloud;
+  render(cam, cMo_truth, I, pointcloud);
+
+  SECTION("One camera")
+  {
+    const int trackerType = vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER;
+    vpMatrix covariance;
+    vpHomogeneousMatrix cMo_stacked =
+        trackOneCamera(trackerType, false, 1, false, model, cam, I, pointcloud, cMo_init, covariance);
+    vpHomogeneousMatrix cMo_stream =
+        trackOneCamera(trackerType, true, 1, false, model, cam, I, pointcloud, cMo_init, covariance);
+    checkPoses(cMo_stacked, cMo_truth, 5e-3);
+    checkPoses(cMo_stream, cMo_stacked, 1e-8);
+  }
+
+  SECTION("Edge camera and depth camera")
+  {
+    // The depth camera is shifted with respect to the color camera
+    vpHomogeneousMatrix depthMcolor(-0.05, 0.01, 0.0, 0.0, vpMath::rad(5), 0.0);
+    vpImage<unsigned char> I_depth;
+    vpPointCloud<float> pointcloud_depth;
+    render(cam, depthMcolor * cMo_truth, I_depth, pointcloud_depth);
+
+    std::vector<vpHomogeneousMatrix> cMo_tracked;
+    for (int stream = 0; stream < 2; stream++) {
+      std::vector<std::string> cameraNames;
+      cameraNames.push_back("Camera1");
+      cameraNames.push_back("Camera2");
+      std::vector<int> trackerTypes;
+      trackerTypes.push_back(vpMbGenericTracker::EDGE_TRACKER);
+      trackerTypes.push_back(vpMbGenericTracker::DEPTH_DENSE_TRACKER);
+      vpMbGenericTracker tracker(cameraNames, trackerTypes);
+      tracker.setCameraParameters(cam, cam);
+      tracker.setCameraTransformationMatrix("Camera2", depthMcolor);
+      tracker.setDepthDenseSamplingStep(2, 2);
+      tracker.setStreamNormalEquations(stream != 0);
+      tracker.loadModel(model, model);
+
+      std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+      mapOfImages["Camera1"] = &I;
+      mapOfImages["Camera2"] = &I_depth;
+      std::map<std::string, vpHomogeneousMatrix> mapOfInitPoses;
+      mapOfInitPoses["Camera1"] = cMo_init;
+      mapOfInitPoses["Camera2"] = depthMcolor * cMo_init;
+      tracker.initFromPose(mapOfImages, mapOfInitPoses);
+
+      std::map<std::string, const vpPointCloud<float> *> mapOfPointClouds;
+      mapOfPointClouds["Camera2"] = &pointcloud_depth;
+      mapOfImages.erase("Camera2");
+      tracker.track(mapOfImages, mapOfPointClouds);
+      cMo_tracked.push_back(tracker.getPose());
+    }
+
+    checkPoses(cMo_tracked[0], cMo_truth, 5e-3);
+    checkPoses(cMo_tracked[1], cMo_tracked[0], 1e-8);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
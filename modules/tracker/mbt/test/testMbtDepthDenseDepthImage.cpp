@@ -0,0 +1,217 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the dense depth tracker on raw depth images.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbtDepthDenseDepthImage.cpp
+
+  Check on a synthetic depth image of a cube that tracking directly on the raw
+  depth image (vpMbDepthDenseTracker::track(const vpImage<uint16_t> &, double))
+  gives the same pose as tracking on the corresponding point cloud.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <fstream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/mbt/vpMbDepthDenseTracker.h>
+
+namespace
+{
+const double g_halfSize = 0.05;
+const double g_depthScale = 0.0001;
+const unsigned int g_height = 480, g_width = 640;
+
+std::string writeCubeModel()
+{
+  std::string username;
+  vpIoTools::getUserName(username);
+#if defined(_WIN32)
+  std::string tmp_dir = "C:/temp/" + username;
+#else
+  std::string tmp_dir = "/tmp/" + username;
+#endif
+  vpIoTools::makeDirectory(tmp_dir);
+  std::string filename = vpIoTools::createFilePath(tmp_dir, "testMbtDepthDenseDepthImage_cube.cao");
+
+  std::ofstream file(filename.c_str());
+  const double h = g_halfSize;
+  file << "V1\n8\n";
+  file << h << " " << -h << " " << -h << "\n";
+  file << -h << " " << -h << " " << -h << "\n";
+  file << -h << " " << h << " " << -h << "\n";
+  file << h << " " << h << " " << -h << "\n";
+  file << h << " " << -h << " " << h << "\n";
+  file << -h << " " << -h << " " << h << "\n";
+  file << -h << " " << h << " " << h << "\n";
+  file << h << " " << h << " " << h << "\n";
+  file << "0\n0\n6\n";
+  file << "4 0 4 5 1\n4 1 5 6 2\n4 6 7 3 2\n4 3 7 4 0\n4 0 1 2 3\n4 7 6 5 4\n";
+  file << "0\n0\n";
+
+  return filename;
+}
+
+// Ray cast the cube into a raw depth image, the background has no valid depth
+void render(const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo, vpImage<uint16_t> &depth)
+{
+  depth.resize(g_height, g_width, 0);
+
+  vpHomogeneousMatrix oMc = cMo.inverse();
+  vpRotationMatrix oRc = oMc.getRotationMatrix();
+  vpTranslationVector oC = oMc.getTranslationVector();
+
+  for (unsigned int i = 0; i < g_height; i++) {
+    for (unsigned int j = 0; j < g_width; j++) {
+      vpColVector d(3, 1.0);
+      vpPixelMeterConversion::convertPoint(cam, j, i, d[0], d[1]);
+      vpColVector od = oRc * d;
+
+      double t_min = -1;
+      for (unsigned int k = 0; k < 3; k++) {
+        for (int sign = -1; sign <= 1; sign += 2) {
+          if (std::fabs(od[k]) < 1e-12) {
+            continue;
+          }
+          double t = (sign * g_halfSize - oC[k]) / od[k];
+          bool inside = t > 0;
+          for (unsigned int l = 0; l < 3 && inside; l++) {
+            inside = (l == k) || std::fabs(oC[l] + t * od[l]) <= g_halfSize;
+          }
+          if (inside && (t_min < 0 || t < t_min)) {
+            t_min = t;
+          }
+        }
+      }
+
+      if (t_min > 0) {
+        depth[i][j] = static_cast<uint16_t>(vpMath::round(t_min / g_depthScale));
+      }
+    }
+  }
+}
+
+// Point cloud deprojected from the whole depth image, as done by the sensor grabbers
+void deproject(const vpCameraParameters &cam, const vpImage<uint16_t> &depth, vpPointCloud<float> &pointcloud)
+{
+  pointcloud.resize(depth.getHeight(), depth.getWidth());
+  for (unsigned int i = 0; i < depth.getHeight(); i++) {
+    for (unsigned int j = 0; j < depth.getWidth(); j++) {
+      double x = 0, y = 0, Z = depth[i][j] * g_depthScale;
+      vpPixelMeterConversion::convertPoint(cam, j, i, x, y);
+      unsigned int idx = i * depth.getWidth() + j;
+      pointcloud.getX()[idx] = static_cast<float>(static_cast<float>(x) * Z);
+      pointcloud.getY()[idx] = static_cast<float>(static_cast<float>(y) * Z);
+      pointcloud.getZ()[idx] = static_cast<float>(Z);
+    }
+  }
+}
+
+void initTracker(vpMbDepthDenseTracker &tracker, const std::string &model, const vpCameraParameters &cam,
+                 const vpHomogeneousMatrix &cMo_init)
+{
+  tracker.setCameraParameters(cam);
+  tracker.setDepthDenseSamplingStep(2, 2);
+  tracker.loadModel(model);
+  vpImage<unsigned char> I(g_height, g_width);
+  tracker.initFromPose(I, cMo_init);
+}
+
+void checkPoses(const vpHomogeneousMatrix &cMo1, const vpHomogeneousMatrix &cMo2, double threshold)
+{
+  vpPoseVector p1(cMo1), p2(cMo2);
+  for (unsigned int i = 0; i < 6; i++) {
+    CHECK(p1[i] == Approx(p2[i]).margin(threshold));
+  }
+}
+} // namespace
+
+TEST_CASE("Depth dense tracking on a raw depth image", "[vpMbDepthDenseTracker]")
+{
+  const std::string model = writeCubeModel();
+  const vpHomogeneousMatrix cMo_truth(0.01, -0.02, 0.45, vpMath::rad(30), vpMath::rad(-40), vpMath::rad(10));
+  const vpHomogeneousMatrix cMo_init = vpHomogeneousMatrix(0.005, 0.004, -0.01, 0.03, -0.02, 0.02) * cMo_truth;
+
+  std::vector<vpCameraParameters> cams;
+  cams.push_back(vpCameraParameters(600, 600, g_width / 2.0, g_height / 2.0));
+  cams.push_back(vpCameraParameters(600, 600, g_width / 2.0, g_height / 2.0, -0.05, 0.05));
+
+  for (size_t k = 0; k < cams.size(); k++) {
+    const vpCameraParameters &cam = cams[k];
+    vpImage<uint16_t> depth;
+    render(cam, cMo_truth, depth);
+    vpPointCloud<float> pointcloud;
+    deproject(cam, depth, pointcloud);
+
+    vpMbDepthDenseTracker tracker_pcl, tracker_depth;
+    initTracker(tracker_pcl, model, cam, cMo_init);
+    initTracker(tracker_depth, model, cam, cMo_init);
+
+    // Track twice to also go through the cached ray look-up table
+    for (int iter = 0; iter < 2; iter++) {
+      tracker_pcl.track(pointcloud);
+      tracker_depth.track(depth, g_depthScale);
+
+      vpHomogeneousMatrix cMo_pcl, cMo_depth;
+      tracker_pcl.getPose(cMo_pcl);
+      tracker_depth.getPose(cMo_depth);
+      checkPoses(cMo_pcl, cMo_truth, 5e-3);
+      checkPoses(cMo_depth, cMo_pcl, 1e-6);
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
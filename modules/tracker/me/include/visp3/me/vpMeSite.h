@@ -48,9 +48,12 @@
 
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageView.h>
 #include <visp3/core/vpMatrix.h>
 #include <visp3/me/vpMe.h>
 
+#include <vector>
+
 /*!
   \class vpMeSite
   \ingroup module_me
@@ -121,6 +124,16 @@ public:
   vpMeSite *getQueryList(const vpImage<unsigned char> &I, const int range);
 
   void track(const vpImage<unsigned char> &im, const vpMe *me, bool test_contraste = true);
+  void track(const vpImageView<const unsigned char> &I, const vpMe *me, bool test_contraste = true);
+
+  static void trackBatch(const vpImage<unsigned char> &I, const vpMe *me, std::vector<vpMeSite> &sites,
+                         bool test_contraste = true, unsigned int nbThreads = 1);
+  static void trackBatch(const vpImage<unsigned char> &I, const vpMe *me, const std::vector<vpMeSite *> &sites,
+                         bool test_contraste = true, unsigned int nbThreads = 1);
+  static void trackBatch(const vpImageView<const unsigned char> &I, const vpMe *me, std::vector<vpMeSite> &sites,
+                         bool test_contraste = true, unsigned int nbThreads = 1);
+  static void trackBatch(const vpImageView<const unsigned char> &I, const vpMe *me,
+                         const std::vector<vpMeSite *> &sites, bool test_contraste = true, unsigned int nbThreads = 1);
 
   /*!
     Set the angle of tangent at site
@@ -241,6 +254,13 @@ public:
   static void display(const vpImage<vpRGBa> &I, const double &i, const double &j,
                       const vpMeSiteState &state = NO_SUPPRESSION);
 
+private:
+  void trackQueryRange(const vpImageView<const unsigned char> &I, const vpMe *me, bool test_contraste,
+                       std::vector<double> &buffer, std::vector<int> &pixels);
+  static bool trackSites(const vpImageView<const unsigned char> &I, const vpMe *me,
+                         const std::vector<vpMeSite *> &sites, bool test_contraste, unsigned int nbThreads,
+                         bool skipDisplayed);
+
 // Deprecated
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
 public:
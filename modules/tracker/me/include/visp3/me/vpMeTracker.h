@@ -50,9 +50,11 @@
 #include <visp3/me/vpMe.h>
 #include <visp3/me/vpMeSite.h>
 
+#include <algorithm>
 #include <iostream>
 #include <list>
 #include <math.h>
+#include <vector>
 
 /*!
   \class vpMeTracker
@@ -61,6 +63,20 @@
   \brief Contains abstract elements for a Distance to Feature type feature.
 
   2D state = list of points, 3D state = feature
+
+  The moving-edge sites are stored contiguously in a std::vector, so that
+  the tracking loop walks a single memory block and suppressed sites are
+  removed in one compaction pass. getMeSites() gives a direct access to this
+  storage. setMeList() is kept for backward compatibility and copies the
+  sites from a std::list, while the deprecated getMeList() returns a
+  list-like view, vpMeTracker::vpMeSiteList, that reads and modifies the
+  sites of the tracker.
+
+  \note The protected \e list member is a std::vector<vpMeSite>, it was a
+  std::list<vpMeSite> up to ViSP 3.4.0. The classes that inherit from
+  vpMeTracker and use std::list specific functions on it (push_front(),
+  splice(), remove_if()...) or keep iterators across insertions have to be
+  adapted.
 */
 class VISP_EXPORT vpMeTracker : public vpTracker
 {
@@ -74,8 +90,9 @@ protected:
   //@{
 #endif
   //! Tracking dependent variables/functions
-  //! List of tracked moving edges points.
-  std::list<vpMeSite> list;
+  //! Tracked moving edges points, stored contiguously. It was a
+  //! std::list<vpMeSite> up to ViSP 3.4.0.
+  std::vector<vpMeSite> list;
   //! Moving edges initialisation parameters
   vpMe *me;
   unsigned int init_range;
@@ -120,12 +137,18 @@ public:
   inline vpMe *getMe() { return me; }
 
   /*!
-    Return the list of moving edges
+    Return the moving edges sites.
+
+    \return Vector of Moving Edges.
+  */
+  inline std::vector<vpMeSite> &getMeSites() { return list; }
+
+  /*!
+    Return the moving edges sites.
 
-    \return List of Moving Edges.
+    \return Vector of Moving Edges.
   */
-  inline std::list<vpMeSite> &getMeList() { return list; }
-  inline std::list<vpMeSite> getMeList() const { return list; }
+  inline const std::vector<vpMeSite> &getMeSites() const { return list; }
 
   /*!
     Return the number of points that has not been suppressed.
@@ -177,12 +200,137 @@ public:
 
     \param l : list of Moving Edges.
   */
-  void setMeList(const std::list<vpMeSite> &l) { list = l; }
+  void setMeList(const std::list<vpMeSite> &l) { list.assign(l.begin(), l.end()); }
+
+  /*!
+    Set the moving edges sites.
+
+    \param sites : Vector of Moving Edges.
+  */
+  void setMeSites(const std::vector<vpMeSite> &sites) { list = sites; }
 
   unsigned int totalNumberOfSignal();
 
   //! Track sampled pixels.
   void track(const vpImage<unsigned char> &I);
+  //! Track sampled pixels in a view over an image.
+  void track(const vpImageView<const unsigned char> &I);
+  //@}
+
+#ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
+  /*!
+    \class vpMeSiteList
+
+    List-like view on the moving edges of a tracker, returned by the deprecated
+    getMeList(). It reads and modifies the std::vector<vpMeSite> of the tracker:
+    all the views of a tracker share the same sites, so that their iterators can
+    be compared and the changes made through them are applied to the tracker.
+
+    The iterators are std::vector<vpMeSite> iterators: code that stores them in
+    std::list<vpMeSite>::iterator does not compile anymore, and an insertion or
+    an erasure invalidates the iterators that follow it, as for a std::vector.
+    Converting the view to a std::list<vpMeSite> makes a copy.
+  */
+  class vpMeSiteList
+  {
+  public:
+    typedef vpMeSite value_type;
+    typedef vpMeSite &reference;
+    typedef const vpMeSite &const_reference;
+    typedef std::vector<vpMeSite>::size_type size_type;
+    typedef std::vector<vpMeSite>::iterator iterator;
+    typedef std::vector<vpMeSite>::const_iterator const_iterator;
+    typedef std::vector<vpMeSite>::reverse_iterator reverse_iterator;
+    typedef std::vector<vpMeSite>::const_reverse_iterator const_reverse_iterator;
+
+    explicit vpMeSiteList(std::vector<vpMeSite> &sites) : m_sites(&sites) {}
+
+    //! Copy the sites of another view, as the assignment of the std::list did.
+    vpMeSiteList &operator=(const vpMeSiteList &other)
+    {
+      if (m_sites != other.m_sites) {
+        *m_sites = *other.m_sites;
+      }
+      return *this;
+    }
+    //! Replace the sites of the tracker by the ones of \e l.
+    vpMeSiteList &operator=(const std::list<vpMeSite> &l)
+    {
+      m_sites->assign(l.begin(), l.end());
+      return *this;
+    }
+    //! Copy of the sites.
+    operator std::list<vpMeSite>() const { return std::list<vpMeSite>(m_sites->begin(), m_sites->end()); }
+
+    iterator begin() const { return m_sites->begin(); }
+    iterator end() const { return m_sites->end(); }
+    reverse_iterator rbegin() const { return m_sites->rbegin(); }
+    reverse_iterator rend() const { return m_sites->rend(); }
+
+    bool empty() const { return m_sites->empty(); }
+    size_type size() const { return m_sites->size(); }
+    reference front() const { return m_sites->front(); }
+    reference back() const { return m_sites->back(); }
+
+    void clear() const { m_sites->clear(); }
+    iterator erase(iterator pos) const { return m_sites->erase(pos); }
+    iterator erase(iterator first, iterator last) const { return m_sites->erase(first, last); }
+    iterator insert(iterator pos, const vpMeSite &site) const { return m_sites->insert(pos, site); }
+    void pop_back() const { m_sites->pop_back(); }
+    void pop_front() const { m_sites->erase(m_sites->begin()); }
+    void push_back(const vpMeSite &site) const { m_sites->push_back(site); }
+    void push_front(const vpMeSite &site) const { m_sites->insert(m_sites->begin(), site); }
+    template <class Predicate> void remove_if(Predicate pred) const
+    {
+      m_sites->erase(std::remove_if(m_sites->begin(), m_sites->end(), pred), m_sites->end());
+    }
+
+  private:
+    std::vector<vpMeSite> *m_sites;
+  };
+
+  /*!
+    @name Deprecated functions
+  */
+  //@{
+  /*!
+    \deprecated You should rather use getMeSites(), that gives access to the
+    moving edges without indirection.
+
+    Return a list-like view on the moving edges. The changes made through the
+    view are applied to the tracker.
+
+    \return View on the moving edges.
+
+    \sa vpMeSiteList
+  */
+  vp_deprecated inline vpMeSiteList getMeList() { return vpMeSiteList(list); }
+
+  /*!
+    \deprecated You should rather use getMeSites().
+
+    \return Copy of the moving edges, as in previous versions.
+  */
+  vp_deprecated inline std::list<vpMeSite> getMeList() const
+  {
+    return std::list<vpMeSite>(list.begin(), list.end());
+  }
+  //@}
+#endif
+
+  static void trackBatch(const vpImage<unsigned char> &I, const std::vector<vpMeTracker *> &trackers,
+                         unsigned int nbThreads = 1);
+  static void trackBatch(const vpImageView<const unsigned char> &I, const std::vector<vpMeTracker *> &trackers,
+                         unsigned int nbThreads = 1);
+
+protected:
+  /** @name Protected Member Functions Inherited from vpMeTracker */
+  //@{
+  void checkTracking() const;
+  void removeSuppressedSites();
+  void updateTrackedSites(const std::vector<vpMeSite *> &trackedSites, size_t &index);
+  static void trackBatch(const vpImage<unsigned char> *I, const vpImageView<const unsigned char> &view,
+                         const std::vector<vpMeTracker *> &trackers, unsigned int nbThreads);
   //@}
 
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
@@ -150,7 +150,7 @@ void vpMeEllipse::updateTheta()
 {
   vpMeSite p_me;
   vpImagePoint iP;
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
     p_me = *it;
     // (i,j) frame used for vpMESite
     iP.set_ij(p_me.ifloat, p_me.jfloat);
@@ -450,9 +450,10 @@ unsigned int vpMeEllipse::plugHoles(const vpImage<unsigned char> &I)
   // A different choice could be done.
   std::list<double>::iterator angleList = angle.begin();
   double ang = *angleList;
-  for (std::list<vpMeSite>::iterator meList = list.begin(); meList != list.end();) {
-    ++angleList;
-    ++meList;
+  // Index of the site following the current hole. Indices are used instead
+  // of iterators since inserting a site invalidates the iterators of the vector.
+  size_t meIdx = 1;
+  for (++angleList; meIdx < list.size(); ++angleList, ++meIdx) {
     double nextang = *angleList;
     // The minimal size of a hole (1 point lost for sure).
     // could be increased to reduce time processing
@@ -477,8 +478,9 @@ unsigned int vpMeEllipse::plugHoles(const vpImage<unsigned char> &I)
           else if ((ang - new_ang) > M_PI) {
             new_ang += 2.0 * M_PI;
           }
-          list.insert(meList,pix);
+          list.insert(list.begin() + static_cast<std::ptrdiff_t>(meIdx), pix);
           angle.insert(angleList,new_ang);
+          ++meIdx;
           if (vpDEBUG_ENABLE(3)) {
             vpDisplay::displayCross(I, iP, 5, vpColor::blue);
           }
@@ -511,7 +513,7 @@ unsigned int vpMeEllipse::plugHoles(const vpImage<unsigned char> &I)
         else if ((ang - new_ang) > M_PI) {
           new_ang += 2.0 * M_PI;
         }
-        list.push_front(pix);
+        list.insert(list.begin(), pix);
         angle.push_front(new_ang);
         if (vpDEBUG_ENABLE(3)) {
           vpDisplay::displayCross(I, iP, 5, vpColor::blue);
@@ -653,7 +655,7 @@ void vpMeEllipse::leastSquareRobust(const vpImage<unsigned char> &I)
   unsigned int k = 0;
   double um = I.getWidth() / 2.;
   double vm = I.getHeight() / 2.;
-  for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
     vpMeSite p_me = *it;
     if (p_me.getState() == vpMeSite::NO_SUPPRESSION) {
       // from (i,j) to (u,v) frame + normalization so that (u,v) in [-1;1]
@@ -747,9 +749,11 @@ void vpMeEllipse::leastSquareRobust(const vpImage<unsigned char> &I)
   double incr = vpMath::rad(me->getSampleStep());
   // Remove bad points, too near points, and outliers from the lists
   k = m_numberOfGoodPoints = 0;
+  // The kept sites are compacted to the front of the vector
+  size_t nbKept = 0;
   std::list<double>::iterator angleList = angle.begin();
-  for (std::list<vpMeSite>::iterator meList = list.begin(); meList != list.end();) {
-    vpMeSite p_me = *meList;
+  for (size_t meIdx = 0; meIdx < list.size(); meIdx++) {
+    vpMeSite p_me = list[meIdx];
     if (p_me.getState() == vpMeSite::NO_SUPPRESSION) {
       if (w[k] > thresholdWeight) { // inlier
         // Management of the angle to keep only the points in the interval
@@ -770,7 +774,7 @@ void vpMeEllipse::leastSquareRobust(const vpImage<unsigned char> &I)
           if ((new_ang - previous_ang) >= (0.6 * incr)) {
             *angleList = previous_ang = new_ang;
             m_numberOfGoodPoints++;
-            ++meList;
+            list[nbKept++] = p_me;
             ++angleList;
             if (vpDEBUG_ENABLE(3)) {
               vpDisplay::displayCross(I, iP, 10, vpColor::red, 1);
@@ -784,7 +788,6 @@ void vpMeEllipse::leastSquareRobust(const vpImage<unsigned char> &I)
               printf("too near : angle  %lf, i %.0f , j : %0.f\n",
                      vpMath::deg(new_ang), p_me.ifloat, p_me.jfloat);
             }
-            meList = list.erase(meList);
             angleList = angle.erase(angleList);
           }
         }
@@ -794,7 +797,6 @@ void vpMeEllipse::leastSquareRobust(const vpImage<unsigned char> &I)
             printf("not in interval: angle : %lf, i %.0f , j : %0.f\n",
                    vpMath::deg(new_ang), p_me.ifloat, p_me.jfloat);
           }
-          meList = list.erase(meList);
           angleList = angle.erase(angleList);
         }
       }
@@ -806,13 +808,11 @@ void vpMeEllipse::leastSquareRobust(const vpImage<unsigned char> &I)
                  k, p_me.ifloat, p_me.jfloat, w[k]);
           vpDisplay::displayCross(I, iP, 10, vpColor::cyan, 1);
         }
-        meList = list.erase(meList);
         angleList = angle.erase(angleList);
       }
       k++;
     }
     else {  // points not selected as me
-      meList = list.erase(meList);
       angleList = angle.erase(angleList);
       if (vpDEBUG_ENABLE(3)) {
         vpImagePoint iP;
@@ -822,6 +822,7 @@ void vpMeEllipse::leastSquareRobust(const vpImage<unsigned char> &I)
       }
     }
   }
+  list.resize(nbKept);
   // set extremities of the angle list
   m_alphamin = angle.front();
   m_alphamax = angle.back();
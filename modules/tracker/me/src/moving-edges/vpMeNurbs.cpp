@@ -44,7 +44,6 @@
 #include <cmath>  // std::fabs
 #include <limits> // numeric_limits
 #include <stdlib.h>
-#include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpImagePoint.h>
 #include <visp3/core/vpImageTools.h>
@@ -56,14 +55,6 @@
 #include <visp3/me/vpMeNurbs.h>
 #include <visp3/me/vpMeSite.h>
 #include <visp3/me/vpMeTracker.h>
-#ifdef VISP_HAVE_OPENCV
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020101) // Require opencv >= 2.1.1
-//#    include <opencv2/imgproc/imgproc.hpp>
-#include <opencv2/imgproc/imgproc_c.h>
-#else
-#include <cv.h>
-#endif
-#endif
 
 double computeDelta(double deltai, double deltaj);
 void findAngle(const vpImage<unsigned char> &I, const vpImagePoint &iP, vpMe *me, double &angle, double &convlt);
@@ -332,17 +323,7 @@ void vpMeNurbs::sample(const vpImage<unsigned char> &I, bool doNotTrack)
   - belong no more to the edge.
   - which are to closed to another point.
 */
-void vpMeNurbs::suppressPoints()
-{
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end();) {
-    vpMeSite s = *it; // current reference pixel
-
-    if (s.getState() != vpMeSite::NO_SUPPRESSION) {
-      it = list.erase(it);
-    } else
-      ++it;
-  }
-}
+void vpMeNurbs::suppressPoints() { removeSuppressedSites(); }
 
 /*!
   Set the alpha value (normal to the edge at this point)
@@ -353,7 +334,7 @@ void vpMeNurbs::updateDelta()
   double u = 0.0;
   double d = 1e6;
   double d_1 = 1e6;
-  std::list<vpMeSite>::iterator it = list.begin();
+  std::vector<vpMeSite>::iterator it = list.begin();
 
   vpImagePoint Cu;
   vpImagePoint *der = NULL;
@@ -439,7 +420,7 @@ void vpMeNurbs::seekExtremities(const vpImage<unsigned char> &I)
         P.track(I, me, false);
 
         if (P.getState() == vpMeSite::NO_SUPPRESSION) {
-          list.push_front(P);
+          list.insert(list.begin(), P);
           beginPtAdded = true;
           pt_max = pt;
           if (vpDEBUG_ENABLE(3)) {
@@ -493,7 +474,7 @@ void vpMeNurbs::seekExtremities(const vpImage<unsigned char> &I)
       endPtFound++;
     me->setRange(memory_range);
   } else {
-    list.pop_front();
+    list.erase(list.begin());
   }
   /*if(begin != NULL)*/ delete[] begin;
   /*if(end != NULL)  */ delete[] end;
@@ -506,17 +487,10 @@ void vpMeNurbs::seekExtremities(const vpImage<unsigned char> &I)
 
   This method is practicle when the edge is not smooth.
 
-  \note To use the canny detection, OpenCV has to be installed.
-
   \param I : Image in which the edge appears.
 */
-#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x030000))
 void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> &I)
-#else
-void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
-#endif
 {
-#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x030000))
   vpMeSite pt = list.front();
   vpImagePoint firstPoint(pt.ifloat, pt.jfloat);
   pt = list.back();
@@ -546,17 +520,7 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
     if (u > 0)
       lastPtInSubIm = nurbs.computeCurvePoint(u);
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
-    vpImageFilter::canny(Isub, Isub, 3, cannyTh1, 3);
-#else
-    IplImage *Ip = NULL;
-    vpImageConvert::convert(Isub, Ip);
-
-    IplImage *dst = cvCreateImage(cvSize((int)Isub.getWidth(), (int)Isub.getHeight()), 8, 1);
-    cvCanny(Ip, dst, cannyTh1, cannyTh2, 3);
-
-    vpImageConvert::convert(dst, Isub);
-#endif
+    vpImageFilter::canny(Isub, Isub, 3, cannyTh1, cannyTh2, 3);
 
     vpImagePoint firstBorder(-1, -1);
 
@@ -598,7 +562,7 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
     }
 
     if (findCenterPoint(&ip_edges_list)) {
-      for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end();
+      for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end();
            /*++it*/) {
         vpMeSite s = *it;
         vpImagePoint iP(s.ifloat, s.jfloat);
@@ -608,14 +572,14 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
           break;
       }
 
-      std::list<vpMeSite>::iterator itList = list.begin();
       double convlt;
       double delta = 0;
       int nbr = 0;
       std::list<vpMeSite> addedPt;
       for (std::list<vpImagePoint>::const_iterator itEdges = ip_edges_list.begin(); itEdges != ip_edges_list.end();
            ++itEdges) {
-        vpMeSite s = *itList;
+        // First site of the list before the added ones
+        vpMeSite s = list[static_cast<size_t>(nbr)];
         vpImagePoint iPtemp = *itEdges + topLeft;
         vpMeSite pix;
         pix.init(iPtemp.get_i(), iPtemp.get_j(), delta);
@@ -631,9 +595,7 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
             findAngle(I, iPtemp, me, delta, convlt);
             pix.init(iPtemp.get_i(), iPtemp.get_j(), delta, convlt);
             pix.setDisplay(selectDisplay);
-            --itList;
-            list.insert(itList, pix);
-            ++itList;
+            list.insert(list.begin(), pix);
             addedPt.push_front(pix);
             nbr++;
           }
@@ -642,12 +604,8 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
 
       unsigned int memory_range = me->getRange();
       me->setRange(3);
-      std::list<vpMeSite>::iterator itList2 = list.begin();
       for (int j = 0; j < nbr; j++) {
-        vpMeSite s = *itList2;
-        s.track(I, me, false);
-        *itList2 = s;
-        ++itList2;
+        list[static_cast<size_t>(j)].track(I, me, false);
       }
       me->setRange(memory_range);
     }
@@ -682,17 +640,7 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
     if (u < 1.0)
       lastPtInSubIm = nurbs.computeCurvePoint(u);
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
-    vpImageFilter::canny(Isub, Isub, 3, cannyTh1, 3);
-#else
-    IplImage *Ip = NULL;
-    vpImageConvert::convert(Isub, Ip);
-
-    IplImage *dst = cvCreateImage(cvSize((int)Isub.getWidth(), (int)Isub.getHeight()), 8, 1);
-    cvCanny(Ip, dst, cannyTh1, cannyTh2, 3);
-
-    vpImageConvert::convert(dst, Isub);
-#endif
+    vpImageFilter::canny(Isub, Isub, 3, cannyTh1, cannyTh2, 3);
 
     vpImagePoint firstBorder(-1, -1);
 
@@ -742,21 +690,21 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
         s = list.back(); // list.value() ;
         vpImagePoint iP(s.ifloat, s.jfloat);
         if (inRectangle(iP, rect)) {
-          list.erase(list.end());
+          list.pop_back();
           //          list.end();
         } else
           break;
       }
 
-      std::list<vpMeSite>::iterator itList = list.end();
-      --itList; // Move on the last element
+      // Last site of the list before the added ones
+      size_t last = list.size() - 1;
       double convlt;
       double delta;
       int nbr = 0;
       std::list<vpMeSite> addedPt;
       for (std::list<vpImagePoint>::const_iterator itEdges = ip_edges_list.begin(); itEdges != ip_edges_list.end();
            ++itEdges) {
-        s = *itList;
+        s = list[last];
         vpImagePoint iPtemp = *itEdges + topLeft;
         vpMeSite pix;
         pix.init(iPtemp.get_i(), iPtemp.get_j(), 0);
@@ -781,13 +729,8 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
 
       unsigned int memory_range = me->getRange();
       me->setRange(3);
-      std::list<vpMeSite>::iterator itList2 = list.end();
-      --itList2; // Move to the last element
       for (int j = 0; j < nbr; j++) {
-        vpMeSite me_s = *itList2;
-        me_s.track(I, me, false);
-        *itList2 = me_s;
-        --itList2;
+        list[list.size() - 1 - static_cast<size_t>(j)].track(I, me, false);
       }
       me->setRange(memory_range);
     }
@@ -795,9 +738,6 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
     /* if (end != NULL) */ delete[] end;
     endPtFound = 0;
   }
-#else
-  vpTRACE("To use the canny detection, OpenCV has to be installed.");
-#endif
 }
 
 /*!
@@ -836,17 +776,16 @@ void vpMeNurbs::localReSample(const vpImage<unsigned char> &I)
 
   int n = (int)numberOfSignal();
 
-  //  list.front();
-  std::list<vpMeSite>::iterator it = list.begin();
-  std::list<vpMeSite>::iterator itNext = list.begin();
-  ++itNext;
+  // Index of the current site. Indices are used instead of iterators since
+  // inserting a site invalidates the iterators of the vector.
+  size_t k = 0;
 
   unsigned int range_tmp = me->getRange();
   me->setRange(2);
 
-  while (itNext != list.end() && n <= me->getPointsToTrack()) {
-    vpMeSite s = *it;          // current reference pixel
-    vpMeSite s_next = *itNext; // current reference pixel
+  while (k + 1 < list.size() && n <= me->getPointsToTrack()) {
+    vpMeSite s = list[k];          // current reference pixel
+    vpMeSite s_next = list[k + 1]; // current reference pixel
 
     double d = vpMeSite::sqrDistance(s, s_next);
     if (d > 4 * vpMath::sqr(me->getSampleStep()) && d < 1600) {
@@ -896,7 +835,8 @@ void vpMeNurbs::localReSample(const vpImage<unsigned char> &I)
             pix.setDisplay(selectDisplay);
             pix.track(I, me, false);
             if (pix.getState() == vpMeSite::NO_SUPPRESSION) {
-              list.insert(it, pix);
+              list.insert(list.begin() + static_cast<std::ptrdiff_t>(k), pix);
+              k++;
               iP_1 = iP[0];
             }
           }
@@ -907,8 +847,7 @@ void vpMeNurbs::localReSample(const vpImage<unsigned char> &I)
         }
       }
     }
-    ++it;
-    ++itNext;
+    ++k;
   }
   me->setRange(range_tmp);
 }
@@ -940,8 +879,8 @@ void vpMeNurbs::supressNearPoints()
       list.next() ;
   }
 #endif
-  std::list<vpMeSite>::const_iterator it = list.begin();
-  std::list<vpMeSite>::iterator itNext = list.begin();
+  std::vector<vpMeSite>::const_iterator it = list.begin();
+  std::vector<vpMeSite>::iterator itNext = list.begin();
   ++itNext;
   for (; itNext != list.end();) {
     vpMeSite s = *it;          // current reference pixel
@@ -46,10 +46,27 @@
 #include <cmath>  // std::fabs
 #include <limits> // numeric_limits
 #include <stdlib.h>
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/me/vpMe.h>
 #include <visp3/me/vpMeSite.h>
 
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
+#endif
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#define USE_SSE_CODE 1
+#if VISP_HAVE_SSE2 && USE_SSE_CODE
+#define USE_SSE 1
+#else
+#define USE_SSE 0
+#endif
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 static bool horsImage(int i, int j, int half, int rows, int cols)
 {
@@ -586,6 +603,381 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, bool test_
   }
 }
 
+/*!
+  Same as track() for a site whose display is disabled, but the convolutions
+  along the normal are computed with SIMD instructions, two query sites at a
+  time. Each query site accumulates the mask products in the same order and
+  with the same double precision arithmetic as convolution(), so that the
+  result is exactly the one of track().
+
+  \param I : Image in which the site is tracked. Its rows may be padded.
+  \param me : Moving-edges parameters.
+  \param test_contraste : If true, the likelihood test uses the contrast
+  with the previous convolution.
+  \param buffer : Scratch buffer, reused between calls to avoid allocations.
+  \param pixels : Scratch buffer, reused between calls to avoid allocations.
+*/
+void vpMeSite::trackQueryRange(const vpImageView<const unsigned char> &I, const vpMe *me, bool test_contraste,
+                               std::vector<double> &buffer, std::vector<int> &pixels)
+{
+  const int range = static_cast<int>(me->getRange());
+  const unsigned int nbQuery = 2 * me->getRange() + 1;
+  const unsigned int msize = me->getMaskSize();
+  const int half = (static_cast<int>(msize) - 1) >> 1;
+  const int height_ = static_cast<int>(I.getHeight());
+  const unsigned int width_ = I.getWidth();
+  const size_t stride = I.getStep();
+
+  buffer.resize(3 * nbQuery + msize * msize);
+  pixels.resize(3 * nbQuery);
+  double *query_i = &buffer[0];
+  double *query_j = query_i + nbQuery;
+  double *conv = query_j + nbQuery;
+  double *coef = conv + nbQuery;
+  int *pixel_i = &pixels[0];
+  int *pixel_j = pixel_i + nbQuery;
+  int *inside = pixel_j + nbQuery;
+
+  // Query sites along the normal, as in getQueryList()
+  double salpha = sin(alpha);
+  double calpha = cos(alpha);
+  unsigned int nbInside = 0;
+  for (int k = -range, n = 0; k <= range; k++, n++) {
+    query_i[n] = (ifloat + k * salpha);
+    query_j[n] = (jfloat + k * calpha);
+    pixel_i[n] = static_cast<int>(query_i[n]);
+    pixel_j[n] = static_cast<int>(query_j[n]);
+
+    if (horsImage(pixel_i[n], pixel_j[n], half + me->getStrip(), height_, static_cast<int>(width_))) {
+      conv[n] = 0.0;
+      pixel_i[n] = 0;
+      pixel_j[n] = 0;
+    } else {
+      inside[nbInside++] = n;
+    }
+  }
+
+  if (nbInside > 0) {
+    // All the query sites share the direction of the normal, hence the mask
+    double theta = alpha + M_PI / 2;
+    while (theta < 0)
+      theta += M_PI;
+    while (theta > M_PI)
+      theta -= M_PI;
+
+    int thetadeg = vpMath::round(theta * 180 / M_PI);
+    if (abs(thetadeg) == 180) {
+      thetadeg = 0;
+    }
+
+    unsigned int index_mask = (unsigned int)(thetadeg / (double)me->getAngleStep());
+    const vpMatrix &mask = me->getMask()[index_mask];
+    for (unsigned int a = 0; a < msize; a++) {
+      for (unsigned int b = 0; b < msize; b++) {
+        coef[a * msize + b] = mask_sign * mask[a][b];
+      }
+    }
+  }
+
+  unsigned int q = 0;
+#if USE_SSE
+  if (vpCPUFeatures::checkSimdLevel(vpCPUFeatures::SIMD_SSE2)) {
+    for (; q + 2 <= nbInside; q += 2) {
+      int n0 = inside[q], n1 = inside[q + 1];
+      const unsigned char *row0 =
+          I[static_cast<unsigned int>(pixel_i[n0] - half)] + static_cast<unsigned int>(pixel_j[n0] - half);
+      const unsigned char *row1 =
+          I[static_cast<unsigned int>(pixel_i[n1] - half)] + static_cast<unsigned int>(pixel_j[n1] - half);
+      const double *c = coef;
+      __m128d acc = _mm_setzero_pd();
+      for (unsigned int a = 0; a < msize; a++, row0 += stride, row1 += stride) {
+        for (unsigned int b = 0; b < msize; b++, c++) {
+          acc = _mm_add_pd(acc, _mm_mul_pd(_mm_set1_pd(*c), _mm_set_pd(row1[b], row0[b])));
+        }
+      }
+      _mm_storel_pd(&conv[n0], acc);
+      _mm_storeh_pd(&conv[n1], acc);
+    }
+  }
+#endif
+  for (; q < nbInside; q++) {
+    int n = inside[q];
+    const unsigned char *row =
+        I[static_cast<unsigned int>(pixel_i[n] - half)] + static_cast<unsigned int>(pixel_j[n] - half);
+    const double *c = coef;
+    double acc = 0.0;
+    for (unsigned int a = 0; a < msize; a++, row += stride) {
+      for (unsigned int b = 0; b < msize; b++, c++) {
+        acc += *c * row[b];
+      }
+    }
+    conv[n] = acc;
+  }
+
+  // Likelihood test, as in track()
+  int max_rank = -1;
+  double max_convolution = 0;
+  double max = 0;
+  double contraste = 0;
+  double contraste_max = 1 + me->getMu2();
+  double contraste_min = 1 - me->getMu1();
+  double threshold = me->getThreshold();
+  double diff = 1e6;
+
+  int ii_1 = i;
+  int jj_1 = j;
+  i_1 = i;
+  j_1 = j;
+
+  for (unsigned int n = 0; n < nbQuery; n++) {
+    double convolution_ = conv[n];
+    if (test_contraste) {
+      double likelihood = fabs(convolution_ + convlt);
+      if (likelihood > threshold) {
+        contraste = convolution_ / convlt;
+        if ((contraste > contraste_min) && (contraste < contraste_max) && fabs(1 - contraste) < diff) {
+          diff = fabs(1 - contraste);
+          max_convolution = convolution_;
+          max = likelihood;
+          max_rank = (int)n;
+        }
+      }
+    } else {
+      double likelihood = fabs(2 * convolution_);
+      if (likelihood > max && likelihood > threshold) {
+        max_convolution = convolution_;
+        max = likelihood;
+        max_rank = (int)n;
+      }
+    }
+  }
+
+  if (max_rank >= 0) {
+    // The site is replaced by the query site of max likelihood
+    i = pixel_i[max_rank];
+    j = pixel_j[max_rank];
+    ifloat = query_i[max_rank];
+    jfloat = query_j[max_rank];
+    v = 0;
+    weight = 1;
+    setState(NO_SUPPRESSION);
+    normGradient = vpMath::sqr(max_convolution);
+
+    convlt = max_convolution;
+    i_1 = ii_1;
+    j_1 = jj_1;
+  } else {
+    normGradient = 0;
+    if (std::fabs(contraste) > std::numeric_limits<double>::epsilon())
+      setState(CONSTRAST);
+    else
+      setState(THRESHOLD);
+  }
+}
+
+/*!
+  Track the site in a view over an image, for instance a region of interest
+  or a buffer whose rows are padded. The result is the one of
+  track(const vpImage<unsigned char> &, const vpMe *, bool) on the viewed
+  pixels: the coordinates of the site are relative to the top left pixel of
+  the view. The display selected with setDisplay() is ignored.
+
+  \param I : View over the image in which the site is tracked.
+  \param me : Moving-edges parameters.
+  \param test_contraste : If true, the likelihood test uses the contrast
+  with the previous convolution.
+
+  \exception vpTrackingException::initializationError : Moving edges not
+  initialized.
+*/
+void vpMeSite::track(const vpImageView<const unsigned char> &I, const vpMe *me, bool test_contraste)
+{
+  if (me == NULL) {
+    throw(vpTrackingException(vpTrackingException::initializationError, "Moving edges not initialized"));
+  }
+
+  std::vector<double> buffer;
+  std::vector<int> pixels;
+  trackQueryRange(I, me, test_contraste, buffer, pixels);
+}
+
+/*!
+  Track a set of sites at once. This is equivalent to call track() on each
+  site of \e sites whose state is vpMeSite::NO_SUPPRESSION, the other sites
+  being left untouched.
+
+  \param I : Image in which the sites are tracked.
+  \param me : Moving-edges parameters.
+  \param sites : Sites to track.
+  \param test_contraste : If true, the likelihood test uses the contrast
+  with the previous convolution.
+  \param nbThreads : Number of threads used to track the sites. If 0 is
+  passed, OpenMP will choose the number of threads.
+
+  \sa track()
+*/
+void vpMeSite::trackBatch(const vpImage<unsigned char> &I, const vpMe *me, std::vector<vpMeSite> &sites,
+                          bool test_contraste, unsigned int nbThreads)
+{
+  std::vector<vpMeSite *> active_sites;
+  active_sites.reserve(sites.size());
+  for (size_t k = 0; k < sites.size(); k++) {
+    if (sites[k].getState() == NO_SUPPRESSION) {
+      active_sites.push_back(&sites[k]);
+    }
+  }
+
+  trackBatch(I, me, active_sites, test_contraste, nbThreads);
+}
+
+/*!
+  Track a set of sites at once, for instance all the sites of all the
+  moving-edges trackers that process the same image. This is equivalent to
+  call track() on each site of \e sites, whatever its state, but:
+  - the convolutions along the normal are computed with SIMD instructions
+    when available, with a result that is exactly the one of track(),
+  - the sites are distributed over \e nbThreads threads when OpenMP is
+    available.
+
+  The sites whose display is enabled with setDisplay() are tracked
+  sequentially with track(), after the other ones.
+
+  \param I : Image in which the sites are tracked.
+  \param me : Moving-edges parameters.
+  \param sites : Pointers to the sites to track. A site must not appear twice.
+  \param test_contraste : If true, the likelihood test uses the contrast
+  with the previous convolution.
+  \param nbThreads : Number of threads used to track the sites. If 0 is
+  passed, OpenMP will choose the number of threads.
+
+  \exception vpTrackingException::initializationError : Moving edges not
+  initialized.
+
+  \sa track()
+*/
+void vpMeSite::trackBatch(const vpImage<unsigned char> &I, const vpMe *me, const std::vector<vpMeSite *> &sites,
+                          bool test_contraste, unsigned int nbThreads)
+{
+  bool hasDisplay = trackSites(vpImageView<const unsigned char>(I), me, sites, test_contraste, nbThreads, true);
+
+  // Displays are not thread-safe
+  if (hasDisplay) {
+    for (size_t k = 0; k < sites.size(); k++) {
+      if (sites[k]->selectDisplay != NONE) {
+        sites[k]->track(I, me, test_contraste);
+      }
+    }
+  }
+}
+
+/*!
+  Track the sites of \e sites whose state is vpMeSite::NO_SUPPRESSION in a
+  view over an image, as trackBatch(const vpImage<unsigned char> &, const
+  vpMe *, std::vector<vpMeSite> &, bool, unsigned int) does. The coordinates
+  of the sites are relative to the top left pixel of the view.
+
+  \param I : View over the image in which the sites are tracked.
+  \param me : Moving-edges parameters.
+  \param sites : Sites to track.
+  \param test_contraste : If true, the likelihood test uses the contrast
+  with the previous convolution.
+  \param nbThreads : Number of threads used to track the sites. If 0 is
+  passed, OpenMP will choose the number of threads.
+*/
+void vpMeSite::trackBatch(const vpImageView<const unsigned char> &I, const vpMe *me, std::vector<vpMeSite> &sites,
+                          bool test_contraste, unsigned int nbThreads)
+{
+  std::vector<vpMeSite *> active_sites;
+  active_sites.reserve(sites.size());
+  for (size_t k = 0; k < sites.size(); k++) {
+    if (sites[k].getState() == NO_SUPPRESSION) {
+      active_sites.push_back(&sites[k]);
+    }
+  }
+
+  trackBatch(I, me, active_sites, test_contraste, nbThreads);
+}
+
+/*!
+  Track a set of sites at once in a view over an image, as
+  trackBatch(const vpImage<unsigned char> &, const vpMe *, const
+  std::vector<vpMeSite *> &, bool, unsigned int) does. The coordinates of
+  the sites are relative to the top left pixel of the view, and the display
+  selected with setDisplay() is ignored.
+
+  \param I : View over the image in which the sites are tracked.
+  \param me : Moving-edges parameters.
+  \param sites : Pointers to the sites to track. A site must not appear twice.
+  \param test_contraste : If true, the likelihood test uses the contrast
+  with the previous convolution.
+  \param nbThreads : Number of threads used to track the sites. If 0 is
+  passed, OpenMP will choose the number of threads.
+
+  \exception vpTrackingException::initializationError : Moving edges not
+  initialized.
+*/
+void vpMeSite::trackBatch(const vpImageView<const unsigned char> &I, const vpMe *me,
+                          const std::vector<vpMeSite *> &sites, bool test_contraste, unsigned int nbThreads)
+{
+  trackSites(I, me, sites, test_contraste, nbThreads, false);
+}
+
+/*!
+  Track the sites with trackQueryRange(), over \e nbThreads threads when
+  OpenMP is available.
+
+  \param skipDisplayed : If true, the sites whose display is enabled are not
+  tracked.
+  \return true if a site was skipped because its display is enabled.
+*/
+bool vpMeSite::trackSites(const vpImageView<const unsigned char> &I, const vpMe *me,
+                          const std::vector<vpMeSite *> &sites, bool test_contraste, unsigned int nbThreads,
+                          bool skipDisplayed)
+{
+  if (me == NULL) {
+    throw(vpTrackingException(vpTrackingException::initializationError, "Moving edges not initialized"));
+  }
+
+  int nbSites = static_cast<int>(sites.size());
+  bool hasDisplay = false;
+
+#ifdef VISP_HAVE_OPENMP
+  if (nbThreads != 1 && nbSites > 1) {
+    int nbTeam = nbThreads == 0 ? omp_get_max_threads() : static_cast<int>(nbThreads);
+
+#pragma omp parallel num_threads(nbTeam) reduction(|| : hasDisplay)
+    {
+      std::vector<double> buffer;
+      std::vector<int> pixels;
+
+#pragma omp for schedule(static)
+      for (int k = 0; k < nbSites; k++) {
+        if (!skipDisplayed || sites[k]->selectDisplay == NONE) {
+          sites[k]->trackQueryRange(I, me, test_contraste, buffer, pixels);
+        } else {
+          hasDisplay = true;
+        }
+      }
+    }
+  } else
+#else
+  (void)nbThreads;
+#endif
+  {
+    std::vector<double> buffer;
+    std::vector<int> pixels;
+    for (int k = 0; k < nbSites; k++) {
+      if (!skipDisplayed || sites[k]->selectDisplay == NONE) {
+        sites[k]->trackQueryRange(I, me, test_contraste, buffer, pixels);
+      } else {
+        hasDisplay = true;
+      }
+    }
+  }
+
+  return hasDisplay;
+}
+
 int vpMeSite::operator!=(const vpMeSite &m) { return ((m.i != i) || (m.j != j)); }
 
 VISP_EXPORT std::ostream &operator<<(std::ostream &os, vpMeSite &vpMeS)
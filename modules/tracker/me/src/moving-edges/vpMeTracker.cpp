@@ -117,6 +117,8 @@ vpMeTracker &vpMeTracker::operator=(vpMeTracker &p_me)
 
 static bool isSuppressZero(const vpMeSite &P) { return (P.getState() == vpMeSite::NO_SUPPRESSION); }
 
+static bool isSuppressed(const vpMeSite &P) { return (P.getState() != vpMeSite::NO_SUPPRESSION); }
+
 unsigned int vpMeTracker::numberOfSignal()
 {
   unsigned int number_signal = 0;
@@ -182,7 +184,7 @@ void vpMeTracker::initTracking(const vpImage<unsigned char> &I)
   int d = 0;
 
   // Loop through list of sites to track
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
     vpMeSite refp = *it; // current reference pixel
 
     d++;
@@ -239,15 +241,14 @@ void vpMeTracker::initTracking(const vpImage<unsigned char> &I)
 }
 
 /*!
-  Track moving-edges.
-
-  \param I : Image.
+  Check that the moving-edges can be tracked.
 
   \exception vpTrackingException::initializationError : Moving edges not
   initialized.
 
+  \exception vpTrackingException::notEnoughPointError : No site to track.
 */
-void vpMeTracker::track(const vpImage<unsigned char> &I)
+void vpMeTracker::checkTracking() const
 {
   if (!me) {
     vpDERROR_TRACE(2, "Tracking error: Moving edges not initialized");
@@ -258,54 +259,196 @@ void vpMeTracker::track(const vpImage<unsigned char> &I)
     vpDERROR_TRACE(2, "Tracking error: too few pixel to track");
     throw(vpTrackingException(vpTrackingException::notEnoughPointError, "Too few pixel to track"));
   }
+}
 
-  nGoodElement = 0;
+/*!
+  Track moving-edges.
 
-  // Loop through list of sites to track
-  std::list<vpMeSite>::iterator it = list.begin();
-  while (it != list.end()) {
-    vpMeSite s = *it; // current reference pixel
+  \param I : Image.
 
-    // If element hasn't been suppressed
-    if (s.getState() == vpMeSite::NO_SUPPRESSION) {
+  \exception vpTrackingException::initializationError : Moving edges not
+  initialized.
 
-      try {
-        s.track(I, me, true);
-      } catch (...) {
-        s.setState(vpMeSite::THRESHOLD);
-      }
-      
-      if (vpMeTracker::inMask(m_mask, s.i, s.j)) {
-        if (s.getState() != vpMeSite::THRESHOLD) {
-          nGoodElement++;
+  \exception vpTrackingException::notEnoughPointError : No site to track.
 
-#if (DEBUG_LEVEL2)
-          {
-            double a, b;
-            a = s.i_1 - s.i;
-            b = s.j_1 - s.j;
-            if (s.getState() == vpMeSite::NO_SUPPRESSION) {
-              ip1.set_i(s.i);
-              ip1.set_j(s.j);
-              ip2.set_i(s.i + a * 5);
-              ip2.set_j(s.j + b * 5);
-              vpDisplay::displayArrow(I, ip1, ip2, vpColor::black);
-            }
-          }
-#endif
-        }
-        *it = s;
-        ++it;
+  \sa trackBatch()
+*/
+void vpMeTracker::track(const vpImage<unsigned char> &I)
+{
+  checkTracking();
+
+  std::vector<vpMeTracker *> trackers(1, this);
+  trackBatch(I, trackers);
+}
+
+/*!
+  Track moving-edges in a view over an image, for instance a region of
+  interest or a buffer whose rows are padded, without copying the pixels.
+  The coordinates of the sites and the mask are relative to the top left
+  pixel of the view, and the display of the sites is ignored.
+
+  Only the search of the sites along their normal is done: the classes that
+  inherit from vpMeTracker, like vpMeLine or vpMeEllipse, fit and resample
+  their feature in their own track(const vpImage<unsigned char> &), that
+  only accepts an image.
+
+  \param I : View over the image.
+
+  \exception vpTrackingException::initializationError : Moving edges not
+  initialized.
+
+  \exception vpTrackingException::notEnoughPointError : No site to track.
+
+  \sa trackBatch()
+*/
+void vpMeTracker::track(const vpImageView<const unsigned char> &I)
+{
+  checkTracking();
+
+  std::vector<vpMeTracker *> trackers(1, this);
+  trackBatch(I, trackers);
+}
+
+/*!
+  Track the moving-edges of several trackers that process the same image.
+  This is equivalent to call track() on each tracker, but the sites of all
+  the trackers are searched at once with vpMeSite::trackBatch(), which uses
+  SIMD instructions and can distribute the sites over several threads.
+
+  The trackers that cannot be tracked, because their moving-edges
+  parameters are not set or because they have no site, are left untouched.
+  Calling track() on them raises the corresponding exception.
+
+  \param I : Image.
+  \param trackers : Trackers to update. A tracker must not appear twice.
+  \param nbThreads : Number of threads used to track the sites. If 0 is
+  passed, OpenMP will choose the number of threads.
+*/
+void vpMeTracker::trackBatch(const vpImage<unsigned char> &I, const std::vector<vpMeTracker *> &trackers,
+                             unsigned int nbThreads)
+{
+  trackBatch(&I, vpImageView<const unsigned char>(I), trackers, nbThreads);
+}
+
+/*!
+  Track the moving-edges of several trackers in a view over an image, as
+  trackBatch(const vpImage<unsigned char> &, const std::vector<vpMeTracker *> &, unsigned int)
+  does. The coordinates of the sites and the masks are relative to the top
+  left pixel of the view, and the display of the sites is ignored.
+
+  \param I : View over the image.
+  \param trackers : Trackers to update. A tracker must not appear twice.
+  \param nbThreads : Number of threads used to track the sites. If 0 is
+  passed, OpenMP will choose the number of threads.
+*/
+void vpMeTracker::trackBatch(const vpImageView<const unsigned char> &I, const std::vector<vpMeTracker *> &trackers,
+                             unsigned int nbThreads)
+{
+  trackBatch(NULL, I, trackers, nbThreads);
+}
+
+/*!
+  Implementation of trackBatch().
+
+  \param I : Image, used to display the sites whose display is enabled. If
+  NULL, the display is ignored.
+  \param view : View over the image in which the sites are tracked.
+  \param trackers : Trackers to update.
+  \param nbThreads : Number of threads used to track the sites.
+*/
+void vpMeTracker::trackBatch(const vpImage<unsigned char> *I, const vpImageView<const unsigned char> &view,
+                             const std::vector<vpMeTracker *> &trackers, unsigned int nbThreads)
+{
+  // Gather the sites to track, grouped by moving-edges parameters
+  std::vector<const vpMe *> mes;
+  std::vector<std::vector<vpMeSite *> > sites;
+  std::vector<size_t> groups(trackers.size());
+  for (size_t t = 0; t < trackers.size(); t++) {
+    vpMeTracker *tracker = trackers[t];
+    if (tracker == NULL || tracker->me == NULL || tracker->list.empty()) {
+      continue;
+    }
+
+    size_t g = static_cast<size_t>(std::find(mes.begin(), mes.end(), tracker->me) - mes.begin());
+    if (g == mes.size()) {
+      mes.push_back(tracker->me);
+      sites.push_back(std::vector<vpMeSite *>());
+    }
+    groups[t] = g;
+
+    for (size_t k = 0; k < tracker->list.size(); k++) {
+      // If element hasn't been suppressed
+      if (tracker->list[k].getState() == vpMeSite::NO_SUPPRESSION) {
+        sites[g].push_back(&tracker->list[k]);
       }
-      else {
+    }
+  }
+
+  for (size_t g = 0; g < mes.size(); g++) {
+    if (I != NULL) {
+      vpMeSite::trackBatch(*I, mes[g], sites[g], true, nbThreads);
+    } else {
+      vpMeSite::trackBatch(view, mes[g], sites[g], true, nbThreads);
+    }
+  }
+
+  std::vector<size_t> index(mes.size(), 0);
+  for (size_t t = 0; t < trackers.size(); t++) {
+    vpMeTracker *tracker = trackers[t];
+    if (tracker == NULL || tracker->me == NULL || tracker->list.empty()) {
+      continue;
+    }
+    tracker->updateTrackedSites(sites[groups[t]], index[groups[t]]);
+  }
+}
+
+/*!
+  Update the list of sites after their tracking: the tracked sites that are
+  outside the mask are removed, and the number of good sites is computed.
+
+  \param trackedSites : Pointers to the tracked sites, in the order of the
+  list. The sites that are not in \e trackedSites were not tracked and are
+  kept as is.
+  \param index : Index in \e trackedSites of the first site of this tracker.
+  On return, index of the first site of the next tracker.
+*/
+void vpMeTracker::updateTrackedSites(const std::vector<vpMeSite *> &trackedSites, size_t &index)
+{
+  nGoodElement = 0;
+
+  // Compact the sites that remain inside the mask to the front of the vector
+  size_t n = 0;
+  for (size_t k = 0; k < list.size(); k++) {
+    vpMeSite &s = list[k]; // current reference pixel
+
+    if (index < trackedSites.size() && trackedSites[index] == &s) {
+      index++;
+
+      if (!vpMeTracker::inMask(m_mask, s.i, s.j)) {
         // Site outside mask: it is no more tracked.
-        it = list.erase(it);
+        continue;
+      }
+
+      if (s.getState() != vpMeSite::THRESHOLD) {
+        nGoodElement++;
       }
     }
-    else {
-      ++it;
+
+    if (n != k) {
+      list[n] = s;
     }
+    n++;
   }
+  list.resize(n);
+}
+
+/*!
+  Remove from the tracked sites all the ones whose state is not
+  vpMeSite::NO_SUPPRESSION, preserving the order of the remaining sites.
+*/
+void vpMeTracker::removeSuppressedSites()
+{
+  list.erase(std::remove_if(list.begin(), list.end(), isSuppressed), list.end());
 }
 
 /*!
@@ -331,7 +474,7 @@ void vpMeTracker::display(const vpImage<unsigned char> &I)
     std::cout << " There are " << list.size() << " sites in the list " << std::endl;
   }
 #endif
-  for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
     vpMeSite p_me = *it;
     p_me.display(I);
   }
@@ -339,7 +482,7 @@ void vpMeTracker::display(const vpImage<unsigned char> &I)
 
 void vpMeTracker::display(const vpImage<vpRGBa> &I)
 {
-  for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
     vpMeSite p_me = *it;
     p_me.display(I);
   }
@@ -353,7 +496,7 @@ void vpMeTracker::display(const vpImage<vpRGBa> &I)
 */
 void vpMeTracker::display(const vpImage<unsigned char> &I, vpColVector &w, unsigned int &index_w)
 {
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
     vpMeSite P = *it;
 
     if (P.getState() == vpMeSite::NO_SUPPRESSION) {
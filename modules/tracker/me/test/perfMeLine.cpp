@@ -0,0 +1,143 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark moving-edges line tracking.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfMeLine.cpp
+
+  Benchmark the tracking of a few hundred vpMeLine on a synthetic image.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/me/vpMeLine.h>
+
+namespace
+{
+const unsigned int g_edgeStep = 20;
+const unsigned int g_segmentLength = 160;
+
+// Vertical black/white bands of width g_edgeStep, shifted by offset pixels
+void buildImage(vpImage<unsigned char> &I, unsigned int offset)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = (((j + offset) / g_edgeStep) % 2) ? 255 : 0;
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("Moving-edges line tracking", "[benchmark]")
+{
+  vpImage<unsigned char> I0(960, 1280), I1(960, 1280);
+  buildImage(I0, 0);
+  buildImage(I1, 1);
+
+  vpMe me;
+  me.setRange(6);
+  me.setSampleStep(4);
+  me.setMaskSize(5);
+  me.setMaskNumber(180);
+  me.setThreshold(10000);
+
+  // One vertical line per edge and per band of rows
+  std::vector<vpMeLine> lines;
+  for (unsigned int j = 2 * g_edgeStep; j + 2 * g_edgeStep < I0.getWidth(); j += g_edgeStep) {
+    for (unsigned int i = g_edgeStep; i + g_segmentLength + g_edgeStep < I0.getHeight(); i += g_segmentLength) {
+      lines.push_back(vpMeLine());
+      vpMeLine &line = lines.back();
+      line.setMe(&me);
+      line.setDisplay(vpMeSite::NONE);
+      line.initTracking(I0, vpImagePoint(i, j - 0.5), vpImagePoint(i + g_segmentLength - g_edgeStep, j - 0.5));
+    }
+  }
+  std::cout << lines.size() << " lines of " << lines.front().getMeSites().size() << " sites" << std::endl;
+
+  unsigned int frame = 0;
+  BENCHMARK("vpMeLine::track()")
+  {
+    const vpImage<unsigned char> &I = (frame++ % 2) ? I1 : I0;
+    int nbPoints = 0;
+    for (size_t k = 0; k < lines.size(); k++) {
+      lines[k].track(I);
+      nbPoints += lines[k].getNbPoints();
+    }
+    return nbPoints;
+  };
+
+  for (size_t k = 0; k < lines.size(); k++) {
+    CHECK(lines[k].getNbPoints() > 0);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  bool runBenchmark = false;
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli() // Get Catch's composite command line parser
+    | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+    ["--benchmark"]        // the option names it will respond to
+    ("run benchmark?");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  if (runBenchmark) {
+    int numFailed = session.run();
+
+    // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+    // This clamping has already been applied, so just return it here
+    // You can also do any post run clean-up here
+    return numFailed;
+  }
+
+  return EXIT_SUCCESS;
+}
+#else
+#include <iostream>
+
+int main() { return 0; }
+#endif
@@ -0,0 +1,223 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test batched moving-edges site tracking.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMeSiteTrackBatch.cpp
+
+  Test that vpMeSite::trackBatch() gives exactly the same result as
+  vpMeSite::track() called on each site, also on a view over a region of
+  interest of a larger image.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpUniRand.h>
+#include <visp3/me/vpMeSite.h>
+
+namespace
+{
+// Disks of random intensity, giving edges in all the directions
+void buildImage(vpImage<unsigned char> &I)
+{
+  vpUniRand rng(42);
+  I = 128;
+  for (int d = 0; d < 40; d++) {
+    double ic = rng.uniform(0.0, static_cast<double>(I.getHeight()));
+    double jc = rng.uniform(0.0, static_cast<double>(I.getWidth()));
+    double r = rng.uniform(5.0, 40.0);
+    unsigned char value = static_cast<unsigned char>(rng.uniform(0, 256));
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        if (vpMath::sqr(i - ic) + vpMath::sqr(j - jc) < r * r) {
+          I[i][j] = value;
+        }
+      }
+    }
+  }
+}
+
+void buildSites(const vpImage<unsigned char> &I, const vpMe &me, std::vector<vpMeSite> &sites)
+{
+  vpUniRand rng(1234);
+  sites.clear();
+  for (int k = 0; k < 2000; k++) {
+    // Some sites are close to the image border so that part of the query range is outside the image
+    double i = rng.uniform(-5.0, I.getHeight() + 5.0);
+    double j = rng.uniform(-5.0, I.getWidth() + 5.0);
+    double alpha = rng.uniform(-M_PI, M_PI);
+    double convlt = rng.uniform(-3000.0, 3000.0);
+    vpMeSite site;
+    site.init(i, j, alpha, convlt, rng.uniform(0, 2) ? 1 : -1);
+    // Initialize the previous convolution from the image when possible
+    if (k % 2 == 0 && i > 10 && j > 10 && i < I.getHeight() - 10 && j < I.getWidth() - 10) {
+      site.convlt = site.convolution(I, &me);
+      site.init(i, j, alpha, site.convlt, site.mask_sign);
+    }
+    sites.push_back(site);
+  }
+}
+
+void checkEqual(const std::vector<vpMeSite> &sites, const std::vector<vpMeSite> &sites_ref)
+{
+  REQUIRE(sites.size() == sites_ref.size());
+  for (size_t k = 0; k < sites.size(); k++) {
+    CHECK(sites[k].i == sites_ref[k].i);
+    CHECK(sites[k].j == sites_ref[k].j);
+    CHECK(sites[k].i_1 == sites_ref[k].i_1);
+    CHECK(sites[k].j_1 == sites_ref[k].j_1);
+    CHECK(sites[k].ifloat == sites_ref[k].ifloat);
+    CHECK(sites[k].jfloat == sites_ref[k].jfloat);
+    CHECK(sites[k].convlt == sites_ref[k].convlt);
+    CHECK(sites[k].normGradient == sites_ref[k].normGradient);
+    CHECK(sites[k].weight == sites_ref[k].weight);
+    CHECK(sites[k].getState() == sites_ref[k].getState());
+  }
+}
+} // namespace
+
+TEST_CASE("Batched site tracking is equal to site by site tracking", "[vpMeSite]")
+{
+  vpImage<unsigned char> I(240, 320);
+  buildImage(I);
+
+  vpMe me;
+  me.setRange(7);
+  me.setMaskSize(5);
+  me.setMaskNumber(180);
+  me.setThreshold(2000);
+  me.setMu1(0.5);
+  me.setMu2(0.5);
+
+  std::vector<vpMeSite> sites_init;
+  buildSites(I, me, sites_init);
+
+  for (int test_contraste = 0; test_contraste < 2; test_contraste++) {
+    std::vector<vpMeSite> sites_ref = sites_init;
+    for (size_t k = 0; k < sites_ref.size(); k++) {
+      sites_ref[k].track(I, &me, test_contraste != 0);
+    }
+
+    unsigned int nbThreads[] = {1, 3};
+    for (int t = 0; t < 2; t++) {
+      INFO("test_contraste: " << test_contraste << " nbThreads: " << nbThreads[t]);
+      std::vector<vpMeSite> sites = sites_init;
+      vpMeSite::trackBatch(I, &me, sites, test_contraste != 0, nbThreads[t]);
+      checkEqual(sites, sites_ref);
+    }
+  }
+}
+
+TEST_CASE("Batched site tracking only tracks the active sites", "[vpMeSite]")
+{
+  vpImage<unsigned char> I(240, 320);
+  buildImage(I);
+
+  vpMe me;
+  std::vector<vpMeSite> sites_init;
+  buildSites(I, me, sites_init);
+  for (size_t k = 0; k < sites_init.size(); k += 3) {
+    sites_init[k].setState(vpMeSite::M_ESTIMATOR);
+  }
+
+  std::vector<vpMeSite> sites_ref = sites_init;
+  for (size_t k = 0; k < sites_ref.size(); k++) {
+    if (sites_ref[k].getState() == vpMeSite::NO_SUPPRESSION) {
+      sites_ref[k].track(I, &me);
+    }
+  }
+
+  std::vector<vpMeSite> sites = sites_init;
+  vpMeSite::trackBatch(I, &me, sites);
+  checkEqual(sites, sites_ref);
+}
+
+TEST_CASE("Site tracking in a view is equal to site tracking in the cropped image", "[vpMeSite]")
+{
+  vpImage<unsigned char> I(240, 320);
+  buildImage(I);
+
+  // I is the region of interest (11, 17) of a larger image
+  const unsigned int top = 11, left = 17;
+  vpImage<unsigned char> I_large(I.getHeight() + 30, I.getWidth() + 40, 0);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I_large[top + i][left + j] = I[i][j];
+    }
+  }
+  vpImageView<const unsigned char> view(I_large, vpRect(left, top, I.getWidth(), I.getHeight()));
+
+  vpMe me;
+  me.setRange(7);
+  me.setThreshold(2000);
+  std::vector<vpMeSite> sites_init;
+  buildSites(I, me, sites_init);
+
+  std::vector<vpMeSite> sites_ref = sites_init;
+  for (size_t k = 0; k < sites_ref.size(); k++) {
+    sites_ref[k].track(I, &me);
+  }
+
+  std::vector<vpMeSite> sites = sites_init;
+  for (size_t k = 0; k < sites.size(); k++) {
+    sites[k].track(view, &me);
+  }
+  checkEqual(sites, sites_ref);
+
+  sites = sites_init;
+  vpMeSite::trackBatch(view, &me, sites, true, 3);
+  checkEqual(sites, sites_ref);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
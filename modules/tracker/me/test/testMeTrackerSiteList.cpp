@@ -0,0 +1,145 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the list-like view on the moving-edges sites of vpMeTracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMeTrackerSiteList.cpp
+
+  Test that the view returned by the deprecated vpMeTracker::getMeList()
+  reads and modifies the sites of the tracker.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/me/vpMeLine.h>
+
+// The deprecated API is tested on purpose
+#if defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+
+namespace
+{
+std::vector<vpMeSite> buildSites(unsigned int nbSites)
+{
+  std::vector<vpMeSite> sites(nbSites);
+  for (unsigned int k = 0; k < nbSites; k++) {
+    sites[k].init(10.0 + k, 20.0, 0.0);
+  }
+  return sites;
+}
+
+bool isSuppressed(const vpMeSite &site) { return site.getState() != vpMeSite::NO_SUPPRESSION; }
+} // namespace
+
+TEST_CASE("The site list view modifies the tracker", "[vpMeTracker]")
+{
+  vpMeLine line;
+  line.setMeSites(buildSites(10));
+
+  SECTION("Loop on two views")
+  {
+    unsigned int k = 0;
+    for (vpMeTracker::vpMeSiteList::iterator it = line.getMeList().begin(); it != line.getMeList().end(); ++it, k++) {
+      if (k % 2) {
+        it->setState(vpMeSite::THRESHOLD);
+      }
+    }
+    CHECK(k == 10);
+    for (size_t i = 0; i < line.getMeSites().size(); i++) {
+      CHECK(line.getMeSites()[i].getState() == (i % 2 ? vpMeSite::THRESHOLD : vpMeSite::NO_SUPPRESSION));
+    }
+
+    line.getMeList().remove_if(isSuppressed);
+    CHECK(line.getMeSites().size() == 5);
+  }
+
+  SECTION("Insertion and erasure")
+  {
+    vpMeSite site;
+    site.init(1.0, 2.0, 0.0);
+    line.getMeList().push_front(site);
+    line.getMeList().push_back(site);
+    REQUIRE(line.getMeSites().size() == 12);
+    CHECK(line.getMeSites().front().i == 1);
+    CHECK(line.getMeSites().back().i == 1);
+
+    for (vpMeTracker::vpMeSiteList::iterator it = line.getMeList().begin(); it != line.getMeList().end();) {
+      it = it->i == 1 ? line.getMeList().erase(it) : it + 1;
+    }
+    CHECK(line.getMeSites().size() == 10);
+    line.getMeList().clear();
+    CHECK(line.getMeSites().empty());
+  }
+
+  SECTION("Copies to and from std::list")
+  {
+    std::list<vpMeSite> l = line.getMeList();
+    CHECK(l.size() == 10);
+    l.pop_back();
+    CHECK(line.getMeSites().size() == 10);
+
+    line.getMeList() = l;
+    CHECK(line.getMeSites().size() == 9);
+
+    vpMeLine other;
+    other.getMeList() = line.getMeList();
+    CHECK(other.getMeSites().size() == 9);
+
+    const vpMeLine &constLine = line;
+    CHECK(constLine.getMeList().size() == 9);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
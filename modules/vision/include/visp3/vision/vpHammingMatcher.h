@@ -0,0 +1,159 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Nearest neighbor matching of binary descriptors.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpHammingMatcher.h
+  \brief Nearest neighbor matching of binary descriptors with the Hamming distance.
+*/
+
+#ifndef _vpHammingMatcher_h_
+#define _vpHammingMatcher_h_
+
+#include <stddef.h>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpHammingMatcher
+  \ingroup group_vision_keypoints
+
+  \brief Brute force matcher of binary descriptors (ORB, BRISK, FREAK, AKAZE...) with the Hamming distance, that
+  does not depend on OpenCV.
+
+  For each query descriptor, the two nearest train descriptors are searched at once, so that the distance ratio
+  test of Lowe can be applied without a second pass, see match(). The distances are computed with the POPCNT
+  instruction, when vpCPUFeatures::checkPOPCNT() is true, or with an AVX2 lookup table, depending on
+  vpCPUFeatures::getSimdLevel(), on blocks of train descriptors that stay in the cache while several queries are
+  processed. The queries are shared between the OpenMP threads, see setNbThreads().
+
+  For large databases, the multi-index hashing of \cite Norouzi12 avoids the linear scan, see
+  setUseMultiIndexHashing(). The search is still exact: the matches are the same as with the linear scan, except
+  when several train descriptors are at the same distance.
+
+  \code
+#include <visp3/vision/vpHammingMatcher.h>
+
+int main()
+{
+  // 32 bytes ORB descriptors, stored row by row
+  std::vector<unsigned char> trainDescriptors(32 * 1000), queryDescriptors(32 * 500);
+  // ...
+
+  vpHammingMatcher matcher;
+  matcher.add(&trainDescriptors[0], 1000, 32);
+
+  std::vector<vpHammingMatcher::vpMatch> matches;
+  matcher.match(&queryDescriptors[0], 500, 32, 0.8, matches);
+}
+  \endcode
+
+  \sa vpKeyPoint::setUseHammingMatcher()
+*/
+class VISP_EXPORT vpHammingMatcher
+{
+public:
+  /*!
+    Nearest train descriptor of a query descriptor.
+  */
+  struct vpMatch {
+    unsigned int queryIdx;       //!< Index of the query descriptor
+    unsigned int trainIdx;       //!< Index of the nearest train descriptor
+    unsigned int secondTrainIdx; //!< Index of the second nearest train descriptor
+    unsigned int distance;       //!< Distance to the nearest train descriptor
+    unsigned int secondDistance; //!< Distance to the second nearest one, UINT_MAX if there is only one
+  };
+
+  vpHammingMatcher();
+
+  void add(const unsigned char *descriptors, unsigned int nbDescriptors, unsigned int descriptorSize,
+           size_t stride = 0);
+  void clear();
+
+  static unsigned int distance(const unsigned char *a, const unsigned char *b, unsigned int descriptorSize);
+
+  /*!
+    Return the size in bytes of the descriptors, 0 if no descriptor was added.
+  */
+  unsigned int getDescriptorSize() const { return m_descriptorSize; }
+  /*!
+    Return the number of threads used to match the queries, 0 to use all the OpenMP threads.
+  */
+  unsigned int getNbThreads() const { return m_nbThreads; }
+  /*!
+    Return the number of train descriptors.
+  */
+  unsigned int getNbTrainDescriptors() const { return m_nbTrain; }
+  /*!
+    Return true if the multi-index hashing is used instead of the linear scan.
+  */
+  bool getUseMultiIndexHashing() const { return m_useMultiIndexHashing; }
+
+  void knnMatch(const unsigned char *queries, unsigned int nbQueries, size_t stride,
+                std::vector<vpMatch> &matches) const;
+  void match(const unsigned char *queries, unsigned int nbQueries, size_t stride, double ratio,
+             std::vector<vpMatch> &matches) const;
+
+  void setNbThreads(unsigned int nbThreads);
+  void setUseMultiIndexHashing(bool use);
+
+private:
+  void buildMultiIndex();
+  void matchQueries(const unsigned char *queries, unsigned int nbQueries, size_t stride, double ratio,
+                    std::vector<vpMatch> &matches) const;
+  bool searchMultiIndex(const unsigned char *query, double ratio, unsigned int *visited, unsigned int stamp,
+                        vpMatch &match) const;
+
+  //! Size in bytes of the descriptors
+  unsigned int m_descriptorSize;
+  //! Number of train descriptors
+  unsigned int m_nbTrain;
+  //! Number of threads, 0 for the OpenMP default
+  unsigned int m_nbThreads;
+  //! Size in bytes of a row of m_train, multiple of 32
+  size_t m_rowSize;
+  //! Train descriptors, padded with zeros up to m_rowSize
+  std::vector<unsigned char> m_train;
+  //! True to search the neighbors with the multi-index hashing
+  bool m_useMultiIndexHashing;
+  //! First bit and number of bits of the substrings of the hash tables
+  std::vector<unsigned int> m_substringFirst, m_substringLength;
+  //! For each hash table, first index in m_tableIds of each substring value, plus the end
+  std::vector<std::vector<unsigned int> > m_tableOffsets;
+  //! For each hash table, train descriptors sorted by substring value
+  std::vector<std::vector<unsigned int> > m_tableIds;
+};
+
+#endif
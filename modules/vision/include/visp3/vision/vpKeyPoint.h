@@ -55,6 +55,8 @@
 #include <visp3/core/vpPlane.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/vision/vpBasicKeyPoint.h>
+#include <visp3/vision/vpHammingMatcher.h>
+#include <visp3/vision/vpKeyPointDatabase.h>
 #include <visp3/vision/vpPose.h>
 #ifdef VISP_HAVE_MODULE_IO
 #  include <visp3/io/vpImageIo.h>
@@ -588,6 +590,14 @@ public:
   */
   inline std::map<vpFeatureDescriptorType, std::string> getExtractorNames() const { return m_mapOfDescriptorNames; }
 
+  /*!
+    Get the native matcher of the binary descriptors, for instance to set
+    its number of threads or to enable the multi-index hashing.
+
+    \return The matcher used when setUseHammingMatcher() is enabled.
+  */
+  inline vpHammingMatcher &getHammingMatcher() { return m_hammingMatcher; }
+
   /*!
     Get the image format to use when saving training images.
 
@@ -684,6 +694,10 @@ public:
 
      \return : Matrix with descriptors values at each row for each train
      keypoints (or reference keypoints).
+
+     \warning When the learning data are loaded from a learning database, the
+     matrix points to the mapped file, that is released by the next call to
+     buildReference(), loadLearningData() or reset(): clone the matrix to keep it.
    */
   inline cv::Mat getTrainDescriptors() const { return m_trainDescriptors; }
 
@@ -746,6 +760,7 @@ public:
 
   void saveLearningData(const std::string &filename, bool binaryMode = false,
                         bool saveTrainingImages = true);
+  void saveLearningDatabase(const std::string &filename, bool saveTrainingImages = true);
 
   /*!
     Set if the covariance matrix has to be computed in the Virtual Visual
@@ -1139,6 +1154,8 @@ public:
   }
 #endif
 
+  void setUseHammingMatcher(bool useHammingMatcher);
+
   /*!
     Set if we want to match the train keypoints to the query keypoints.
 
@@ -1177,6 +1194,13 @@ public:
   inline void setUseSingleMatchFilter(bool singleMatchFilter) { m_useSingleMatchFilter = singleMatchFilter; }
 
 private:
+  //! Training image of a learning database, decoded on first use
+  struct vpEncodedImage {
+    vpKeyPointDatabase database; //!< Database that holds the image
+    unsigned int index;          //!< Index of the image in the database
+    std::string filename;        //!< Path of the database
+  };
+
   //! If true, compute covariance matrix if the user select the pose
   //! estimation method using ViSP
   bool m_computeCovariance;
@@ -1212,11 +1236,19 @@ private:
   std::vector<cv::DMatch> m_filteredMatches;
   //! Chosen method of filtering to eliminate false matching.
   vpFilterMatchingType m_filterType;
+  //! Native matcher of the binary train descriptors, see setUseHammingMatcher()
+  vpHammingMatcher m_hammingMatcher;
   //! Image format to use when saving the training images
   vpImageFormatType m_imageFormat;
+  //! Training images of the learning databases that are not decoded yet, by
+  //! image id. m_mapOfImages holds an empty image for them until
+  //! decodeTrainingImages().
+  std::map<int, vpEncodedImage> m_encodedImages;
   //! List of k-nearest neighbors for each detected keypoints (if the method
   //! chosen is based upon on knn).
   std::vector<std::vector<cv::DMatch> > m_knnMatches;
+  //! Memory mapped learning database, that holds the train descriptors
+  vpKeyPointDatabase m_learningDatabase;
   //! Map descriptor enum type to string.
   std::map<vpFeatureDescriptorType, std::string> m_mapOfDescriptorNames;
   //! Map detector enum type to string.
@@ -1301,6 +1333,9 @@ private:
   //! Flag set if a percentage value is used to determine the number of
   //! inliers for the Ransac method.
   bool m_useConsensusPercentage;
+  //! Flag set if the binary descriptors are matched with m_hammingMatcher
+  //! instead of the OpenCV matcher.
+  bool m_useHammingMatcher;
   //! Flag set if a knn matching method must be used.
   bool m_useKnn;
   //! Flag set if we want to match the train keypoints to the query keypoints,
@@ -1323,6 +1358,10 @@ private:
   double computePoseEstimationError(const std::vector<std::pair<cv::KeyPoint, cv::Point3f> > &matchKeyPoints,
                                     const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo_est);
 
+  void decodeTrainingImages();
+
+  void detachLearningDatabase();
+
   void filterMatches();
 
   void init();
@@ -1334,6 +1373,8 @@ private:
 
   void initFeatureNames();
 
+  void updateHammingMatcher();
+
   inline size_t myKeypointHash(const cv::KeyPoint &kp)
   {
     size_t _Val = 2166136261U, scale = 16777619U;
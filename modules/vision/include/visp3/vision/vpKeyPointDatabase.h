@@ -0,0 +1,173 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Memory mapped learning database of keypoints.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpKeyPointDatabase.h
+  \brief Memory mapped learning database of keypoints.
+*/
+
+#ifndef _vpKeyPointDatabase_h_
+#define _vpKeyPointDatabase_h_
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpKeyPointDatabase
+  \ingroup group_vision_keypoints
+
+  \brief Learning database of keypoints in a binary file that is memory mapped and used in place.
+
+  The file holds the keypoints with their class and training image ids, their 3D coordinates, their descriptors,
+  and optionally the encoded training images (PNG, JPEG...). Each section starts on a 64 bytes boundary and is
+  stored as in memory, so that open() only maps the file and checks its header: the pages are loaded on demand,
+  and shared between the processes that open the same file. The copies of a vpKeyPointDatabase share the same
+  mapping, that is released with the last one.
+
+  The values are little-endian: on a big-endian machine open() throws an exception. The format is versioned, a
+  file written by a newer version of ViSP is rejected, see getVersion().
+
+  \code
+#include <visp3/vision/vpKeyPointDatabase.h>
+
+int main()
+{
+  std::vector<vpKeyPointDatabase::vpKeyPointRecord> keyPoints(100);
+  std::vector<float> points3D(3 * 100);
+  std::vector<unsigned char> orb(100 * 32);
+  // ...
+
+  vpKeyPointDatabase::vpDescriptors descriptors;
+  descriptors.data = &orb[0];
+  descriptors.rows = 100;
+  descriptors.cols = 32;
+  descriptors.type = 0; // CV_8U
+  descriptors.rowSize = descriptors.stride = 32;
+  vpKeyPointDatabase::save("learning.kpdb", keyPoints, points3D, descriptors);
+
+  vpKeyPointDatabase database;
+  database.open("learning.kpdb");
+  const vpKeyPointDatabase::vpKeyPointRecord *kp = database.getKeyPoints();
+  const unsigned char *row = database.getDescriptors().data;
+}
+  \endcode
+
+  \sa vpKeyPoint::saveLearningDatabase()
+*/
+class VISP_EXPORT vpKeyPointDatabase
+{
+public:
+  /*!
+    Keypoint as stored in the file, 32 bytes.
+  */
+  struct vpKeyPointRecord {
+    float x;        //!< Column of the keypoint
+    float y;        //!< Row of the keypoint
+    float size;     //!< Diameter of the neighborhood
+    float angle;    //!< Orientation in degrees, -1 if not computed
+    float response; //!< Detector response
+    int octave;     //!< Pyramid octave
+    int classId;    //!< Class id, the training image of the keypoint
+    int imageId;    //!< Id of the training image in the database, -1 if it was not saved
+  };
+
+  /*!
+    Matrix of descriptors, one per row.
+  */
+  struct vpDescriptors {
+    vpDescriptors() : data(NULL), rows(0), cols(0), type(0), rowSize(0), stride(0) {}
+
+    const unsigned char *data; //!< First row
+    unsigned int rows;         //!< Number of descriptors
+    unsigned int cols;         //!< Number of elements of a descriptor
+    int type;                  //!< Type of the elements, for instance the OpenCV type
+    size_t rowSize;            //!< Size in bytes of a descriptor
+    size_t stride;             //!< Number of bytes between two rows
+  };
+
+  /*!
+    Encoded training image.
+  */
+  struct vpTrainingImage {
+    int imageId;                     //!< Id of the image, referenced by vpKeyPointRecord::imageId
+    std::string format;              //!< Extension of the image format, at most 7 characters, like "png"
+    std::vector<unsigned char> data; //!< Content of the image file
+  };
+
+  vpKeyPointDatabase();
+  vpKeyPointDatabase(const vpKeyPointDatabase &database);
+  ~vpKeyPointDatabase();
+
+  void close();
+
+  vpDescriptors getDescriptors() const;
+  const unsigned char *getImageData(unsigned int index, size_t &size) const;
+  std::string getImageFormat(unsigned int index) const;
+  int getImageId(unsigned int index) const;
+  const vpKeyPointRecord *getKeyPoints() const;
+  unsigned int getNbImages() const;
+  unsigned int getNbKeyPoints() const;
+  const float *getPoints3D() const;
+  unsigned int getVersion() const;
+
+  static bool isDatabaseFile(const std::string &filename);
+  bool isMemoryMapped() const;
+  /*!
+    Return true if a database is open.
+  */
+  bool isOpen() const { return m_mapping != NULL; }
+
+  void open(const std::string &filename);
+
+  vpKeyPointDatabase &operator=(const vpKeyPointDatabase &database);
+
+  static void save(const std::string &filename, const std::vector<vpKeyPointRecord> &keyPoints,
+                   const std::vector<float> &points3D, const vpDescriptors &descriptors,
+                   const std::vector<vpTrainingImage> &images = std::vector<vpTrainingImage>());
+
+  //! Version of the file format written by save()
+  static const unsigned int VERSION = 1;
+
+private:
+  struct vpMapping;
+
+  //! Mapping of the file shared by the copies, NULL if no database is open
+  vpMapping *m_mapping;
+};
+
+#endif
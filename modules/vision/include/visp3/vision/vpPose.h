@@ -48,6 +48,7 @@
 
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpPoint.h>
+#include <visp3/core/vpPointCloud.h>
 #include <visp3/core/vpRGBa.h>
 #include <visp3/vision/vpHomography.h>
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
@@ -96,8 +97,13 @@ public:
                              initialization from Lagrange or Dementhon aproach */
     DEMENTHON_VIRTUAL_VS, /*!< Non linear virtual visual servoing approach
                              initialized by Dementhon approach */
-    LAGRANGE_VIRTUAL_VS   /*!< Non linear virtual visual servoing approach
+    LAGRANGE_VIRTUAL_VS,  /*!< Non linear virtual visual servoing approach
                              initialized by Lagrange approach */
+    P3P,                  /*!< Closed-form solution from the three first points, the other
+                             points selecting among the up to four solutions (doesn't need an
+                             initialization). With only 3 points, the pose is one of these
+                             solutions. */
+    EPNP                  /*!< Linear EPnP approach, in O(n) (doesn't need an initialization) */
   } vpPoseMethodType;
 
   enum RANSAC_FILTER_FLAGS {
@@ -106,6 +112,13 @@ public:
     CHECK_DEGENERATE_POINTS      /*!< Check for degenerate points during the RANSAC. */
   };
 
+  //! Methods used to compute the pose of the random samples drawn by the RANSAC.
+  enum RANSAC_MINIMAL_SOLVER {
+    RANSAC_LAGRANGE_DEMENTHON, /*!< Samples of 4 points, best pose of the Lagrange and Dementhon approaches. */
+    RANSAC_P3P /*!< Samples of 3 points solved with P3P, a 4th point selects among the solutions. The consensus set
+                  is then refined with EPnP instead of Lagrange and Dementhon. */
+  };
+
   unsigned int npt;         //!< Number of point used in pose computation
   std::list<vpPoint> listP; //!< Array of point (use here class vpPoint)
 
@@ -146,53 +159,14 @@ private:
   bool useParallelRansac;
   //! Number of threads to spawn for the parallel RANSAC implementation
   int nbParallelRansacThreads;
+  //! Probability used to reduce the number of RANSAC trials, 0 to disable
+  double ransacProbability;
+  //! Method used to compute the pose of the RANSAC samples
+  RANSAC_MINIMAL_SOLVER ransacMinimalSolver;
   //! Stop the optimization loop when the residual change (|r-r_prec|) <=
   //! epsilon
   double vvsEpsilon;
 
-  // For parallel RANSAC
-  class RansacFunctor
-  {
-  public:
-    RansacFunctor(const vpHomogeneousMatrix &cMo_, unsigned int ransacNbInlierConsensus_,
-                  const int ransacMaxTrials_, double ransacThreshold_, unsigned int initial_seed_,
-                  bool checkDegeneratePoints_, const std::vector<vpPoint> &listOfUniquePoints_,
-                  bool (*func_)(const vpHomogeneousMatrix &))
-      :
-        m_best_consensus(), m_checkDegeneratePoints(checkDegeneratePoints_), m_cMo(cMo_), m_foundSolution(false),
-        m_func(func_), m_listOfUniquePoints(listOfUniquePoints_), m_nbInliers(0),
-        m_ransacMaxTrials(ransacMaxTrials_), m_ransacNbInlierConsensus(ransacNbInlierConsensus_),
-        m_ransacThreshold(ransacThreshold_), m_uniRand(initial_seed_)
-    {
-    }
-
-    void operator()() { m_foundSolution = poseRansacImpl(); }
-
-    // Access the return value.
-    bool getResult() const { return m_foundSolution; }
-
-    std::vector<unsigned int> getBestConsensus() const { return m_best_consensus; }
-
-    vpHomogeneousMatrix getEstimatedPose() const { return m_cMo; }
-
-    unsigned int getNbInliers() const { return m_nbInliers; }
-
-  private:
-    std::vector<unsigned int> m_best_consensus;
-    bool m_checkDegeneratePoints;
-    vpHomogeneousMatrix m_cMo;
-    bool m_foundSolution;
-    bool (*m_func)(const vpHomogeneousMatrix &);
-    std::vector<vpPoint> m_listOfUniquePoints;
-    unsigned int m_nbInliers;
-    int m_ransacMaxTrials;
-    unsigned int m_ransacNbInlierConsensus;
-    double m_ransacThreshold;
-    vpUniRand m_uniRand;
-
-    bool poseRansacImpl();
-  };
-
 protected:
   double computeResidualDementhon(const vpHomogeneousMatrix &cMo);
 
@@ -215,9 +189,11 @@ public:
 
   void poseDementhonPlan(vpHomogeneousMatrix &cMo);
   void poseDementhonNonPlan(vpHomogeneousMatrix &cMo);
+  void poseEPnP(vpHomogeneousMatrix &cMo);
   void poseLagrangePlan(vpHomogeneousMatrix &cMo);
   void poseLagrangeNonPlan(vpHomogeneousMatrix &cMo);
   void poseLowe(vpHomogeneousMatrix &cMo);
+  void poseP3P(vpHomogeneousMatrix &cMo);
   bool poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneousMatrix &) = NULL);
   void poseVirtualVSrobust(vpHomogeneousMatrix &cMo);
   void poseVirtualVS(vpHomogeneousMatrix &cMo);
@@ -319,6 +295,45 @@ public:
   */
   inline void setUseParallelRansac(bool use) { useParallelRansac = use; }
 
+  /*!
+    Get the probability used to reduce the number of RANSAC trials.
+
+    \sa setRansacProbability
+  */
+  inline double getRansacProbability() const { return ransacProbability; }
+
+  /*!
+    Reduce the number of RANSAC trials as soon as the ratio of inliers of the
+    best consensus set ensures, with probability \e p, that a sample free of
+    outliers has been drawn (see computeRansacIterations()). With the parallel
+    version, the number of trials is shared by all the threads.
+
+    \param p : Probability, typically 0.99. The default value 0 disables the
+    reduction: the RANSAC stops after the maximum number of trials (see
+    setRansacMaxTrials()) or when the consensus is reached (see
+    setRansacNbInliersToReachConsensus()).
+  */
+  inline void setRansacProbability(double p) { ransacProbability = p; }
+
+  /*!
+    Get the method used to compute the pose of the RANSAC samples.
+
+    \sa setRansacMinimalSolver
+  */
+  inline RANSAC_MINIMAL_SOLVER getRansacMinimalSolver() const { return ransacMinimalSolver; }
+
+  /*!
+    Set the method used to compute the pose of the RANSAC samples.
+
+    With RANSAC_P3P, a sample free of outliers needs 3 points instead of 4,
+    which reduces the number of trials when there are many outliers, and each
+    trial is much cheaper. The fourth point of the sample selects among the
+    solutions of the P3P; when it is an outlier, all the solutions are scored.
+
+    \note By default the solver is RANSAC_LAGRANGE_DEMENTHON.
+  */
+  inline void setRansacMinimalSolver(const RANSAC_MINIMAL_SOLVER &solver) { ransacMinimalSolver = solver; }
+
   /*!
     Get the vector of points.
 
@@ -349,6 +364,9 @@ public:
   static bool computePlanarObjectPoseFromRGBD(const vpImage<float> &depthMap, const std::vector<vpImagePoint> &corners,
                                               const vpCameraParameters &colorIntrinsics, const std::vector<vpPoint> &point3d, vpHomogeneousMatrix &cMo,
                                               double *confidence_index = NULL);
+  static bool computePlanarObjectPoseFromRGBD(const vpPointCloud<float> &pointcloud, const std::vector<vpImagePoint> &corners,
+                                              const vpCameraParameters &colorIntrinsics, const std::vector<vpPoint> &point3d, vpHomogeneousMatrix &cMo,
+                                              double *confidence_index = NULL);
 
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
   /*!
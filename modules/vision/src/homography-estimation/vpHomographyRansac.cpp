@@ -38,6 +38,7 @@
 
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpRansac.h>
+#include <visp3/core/vpRansacEngine.h>
 #include <visp3/vision/vpHomography.h>
 
 #include <visp3/core/vpDisplay.h>
@@ -273,6 +274,128 @@ double vpHomography::computeResidual(vpColVector &x, vpColVector &M, vpColVector
 }
 #endif //#ifndef DOXYGEN_SHOULD_SKIP_THIS
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Homography of random samples of 4 matched points for vpRansacEngine
+class RansacHomographyModel
+{
+public:
+  struct Hypothesis {
+    double H[9];
+  };
+
+  RansacHomographyModel(const std::vector<double> &xb, const std::vector<double> &yb, const std::vector<double> &xa,
+                        const std::vector<double> &ya, double threshold)
+    : m_xb(&xb[0]), m_yb(&yb[0]), m_xa(&xa[0]), m_ya(&ya[0]), m_n(static_cast<unsigned int>(xb.size())),
+      m_threshold(threshold)
+  {
+  }
+
+  unsigned int getNbData() const { return m_n; }
+  unsigned int getSampleSize() const { return 4; }
+  unsigned int getMinimalSampleSize() const { return 4; }
+  unsigned int getMaxNbHypotheses() const { return 1; }
+
+  // No 3 points of the sample are colinear, in both images
+  bool isDegenerate(const unsigned int *sample, unsigned int size, unsigned int index) const
+  {
+    for (unsigned int i = 0; i < size; i++) {
+      for (unsigned int j = i + 1; j < size; j++) {
+        if (colinear(m_xa, m_ya, sample[i], sample[j], index) || colinear(m_xb, m_yb, sample[i], sample[j], index)) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Exact homography of the 4 points, with H[8] = 1, kept if its residual on the sample is below the threshold
+  unsigned int computeHypotheses(const unsigned int *sample, Hypothesis *hypotheses) const
+  {
+    double A[8][9];
+    for (unsigned int i = 0; i < 4; i++) {
+      const unsigned int k = sample[i];
+      const double xb = m_xb[k], yb = m_yb[k], xa = m_xa[k], ya = m_ya[k];
+      double *r0 = A[2 * i], *r1 = A[2 * i + 1];
+      r0[0] = xb, r0[1] = yb, r0[2] = 1, r0[3] = 0, r0[4] = 0, r0[5] = 0, r0[6] = -xb * xa, r0[7] = -yb * xa;
+      r0[8] = xa;
+      r1[0] = 0, r1[1] = 0, r1[2] = 0, r1[3] = xb, r1[4] = yb, r1[5] = 1, r1[6] = -xb * ya, r1[7] = -yb * ya;
+      r1[8] = ya;
+    }
+
+    // Gaussian elimination with partial pivoting
+    for (unsigned int c = 0; c < 8; c++) {
+      unsigned int pivot = c;
+      for (unsigned int r = c + 1; r < 8; r++) {
+        if (std::fabs(A[r][c]) > std::fabs(A[pivot][c])) {
+          pivot = r;
+        }
+      }
+      if (std::fabs(A[pivot][c]) < 1e-12) {
+        return 0;
+      }
+      if (pivot != c) {
+        for (unsigned int k = c; k < 9; k++) {
+          std::swap(A[c][k], A[pivot][k]);
+        }
+      }
+      for (unsigned int r = c + 1; r < 8; r++) {
+        const double f = A[r][c] / A[c][c];
+        for (unsigned int k = c; k < 9; k++) {
+          A[r][k] -= f * A[c][k];
+        }
+      }
+    }
+
+    double *H = hypotheses[0].H;
+    for (int r = 7; r >= 0; r--) {
+      double v = A[r][8];
+      for (unsigned int k = static_cast<unsigned int>(r) + 1; k < 8; k++) {
+        v -= A[r][k] * H[k];
+      }
+      H[r] = v / A[r][r];
+    }
+    H[8] = 1;
+
+    double r = 0;
+    for (unsigned int i = 0; i < 4; i++) {
+      double e = 0;
+      computeResiduals(hypotheses[0], sample[i], sample[i] + 1, &e);
+      r += e;
+    }
+    return sqrt(r / 4) < m_threshold ? 1 : 0;
+  }
+
+  // Squared transfer errors in image a
+  void computeResiduals(const Hypothesis &hypothesis, unsigned int begin, unsigned int end, double *residuals) const
+  {
+    const double *H = hypothesis.H;
+    for (unsigned int i = begin; i < end; i++) {
+      const double w = H[6] * m_xb[i] + H[7] * m_yb[i] + H[8];
+      const double dx = (H[0] * m_xb[i] + H[1] * m_yb[i] + H[2]) / w - m_xa[i];
+      const double dy = (H[3] * m_xb[i] + H[4] * m_yb[i] + H[5]) / w - m_ya[i];
+      residuals[i - begin] = dx * dx + dy * dy;
+    }
+  }
+
+  void filterInliers(std::vector<unsigned int> &) const {}
+
+private:
+  // Same criterion as iscolinear()
+  static bool colinear(const double *x, const double *y, unsigned int i, unsigned int j, unsigned int k)
+  {
+    const double cross = (x[j] - x[i]) * (y[k] - y[i]) - (y[j] - y[i]) * (x[k] - x[i]);
+    return cross * cross < vpEps;
+  }
+
+  const double *m_xb, *m_yb, *m_xa, *m_ya;
+  unsigned int m_n;
+  double m_threshold;
+};
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 void vpHomography::initRansac(unsigned int n, double *xb, double *yb, double *xa, double *ya, vpColVector &x)
 {
   x.resize(4 * n);
@@ -327,174 +450,62 @@ bool vpHomography::ransac(const std::vector<double> &xb, const std::vector<doubl
   if (n < 4)
     throw(vpException(vpException::fatalError, "There must be at least 4 matched points"));
 
-  vpUniRand random((long)time(NULL));
+  const RansacHomographyModel model(xb, yb, xa, ya, threshold);
+  vpRansacEngine<RansacHomographyModel> ransac(model);
+  ransac.setSeed(static_cast<uint64_t>(time(NULL)));
+  ransac.setThreshold(threshold);
+  ransac.setMaxTrials(1000);
+  ransac.setProbability(0);
+  ransac.setNbInliersToReachConsensus(nbInliersConsensus);
+  ransac.setScoring(vpRansacEngine<RansacHomographyModel>::PREEMPTIVE_SCORING);
 
+  RansacHomographyModel::Hypothesis H;
   std::vector<unsigned int> best_consensus;
-  std::vector<unsigned int> cur_consensus;
-  std::vector<unsigned int> cur_outliers;
-  std::vector<unsigned int> cur_randoms;
-
-  std::vector<unsigned int> rand_ind;
-
-  unsigned int nbMinRandom = 4;
-  unsigned int ransacMaxTrials = 1000;
-  unsigned int maxDegenerateIter = 1000;
-
-  unsigned int nbTrials = 0;
-  unsigned int nbDegenerateIter = 0;
-  unsigned int nbInliers = 0;
-
-  bool foundSolution = false;
-
-  std::vector<double> xa_rand(nbMinRandom);
-  std::vector<double> ya_rand(nbMinRandom);
-  std::vector<double> xb_rand(nbMinRandom);
-  std::vector<double> yb_rand(nbMinRandom);
-
-  if (inliers.size() != n)
-    inliers.resize(n);
-
-  while (nbTrials < ransacMaxTrials && nbInliers < nbInliersConsensus) {
-    cur_outliers.clear();
-    cur_randoms.clear();
-
-    bool degenerate = true;
-    while (degenerate == true) {
-      std::vector<bool> usedPt(n, false);
-
-      rand_ind.clear();
-      for (unsigned int i = 0; i < nbMinRandom; i++) {
-        // Generate random indicies in the range 0..n
-        unsigned int r = (unsigned int)ceil(random() * n) - 1;
-        while (usedPt[r]) {
-          r = (unsigned int)ceil(random() * n) - 1;
-        }
-        usedPt[r] = true;
-        rand_ind.push_back(r);
-
-        xa_rand[i] = xa[r];
-        ya_rand[i] = ya[r];
-        xb_rand[i] = xb[r];
-        yb_rand[i] = yb[r];
-      }
-
-      try {
-        if (!vpHomography::degenerateConfiguration(xb_rand, yb_rand, xa_rand, ya_rand)) {
-          vpHomography::DLT(xb_rand, yb_rand, xa_rand, ya_rand, aHb, normalization);
-          degenerate = false;
-        }
-      } catch (...) {
-        degenerate = true;
-      }
-
-      nbDegenerateIter++;
-
-      if (nbDegenerateIter > maxDegenerateIter) {
-        vpERROR_TRACE("Unable to select a nondegenerate data set");
-        throw(vpException(vpException::fatalError, "Unable to select a nondegenerate data set"));
-      }
-    }
-
-    aHb /= aHb[2][2];
+  ransac.estimate(H, best_consensus);
+  if (ransac.getNbHypotheses() == 0) {
+    vpERROR_TRACE("Unable to select a nondegenerate data set");
+    throw(vpException(vpException::fatalError, "Unable to select a nondegenerate data set"));
+  }
 
-    // Computing Residual
-    double r = 0;
-    vpColVector a(3), b(3), c(3);
-    for (unsigned int i = 0; i < nbMinRandom; i++) {
-      a[0] = xa_rand[i];
-      a[1] = ya_rand[i];
-      a[2] = 1;
-      b[0] = xb_rand[i];
-      b[1] = yb_rand[i];
-      b[2] = 1;
-
-      c = aHb * b;
-      c /= c[2];
-      r += (a - c).sumSquare();
-      // cout << "point " <<i << "  " << (a-c).sumSquare()  <<endl ;;
-    }
+  inliers.assign(n, false);
+  for (size_t i = 0; i < best_consensus.size(); i++) {
+    inliers[best_consensus[i]] = true;
+  }
 
-    // Finding inliers & ouliers
-    r = sqrt(r / nbMinRandom);
-    // std::cout << "Candidate residual: " << r << std::endl;
-    if (r < threshold) {
-      unsigned int nbInliersCur = 0;
-      for (unsigned int i = 0; i < n; i++) {
-        a[0] = xa[i];
-        a[1] = ya[i];
-        a[2] = 1;
-        b[0] = xb[i];
-        b[1] = yb[i];
-        b[2] = 1;
-
-        c = aHb * b;
-        c /= c[2];
-        double error = sqrt((a - c).sumSquare());
-        if (error <= threshold) {
-          nbInliersCur++;
-          cur_consensus.push_back(i);
-          inliers[i] = true;
-        } else {
-          cur_outliers.push_back(i);
-          inliers[i] = false;
-        }
-      }
-      // std::cout << "nb inliers that matches: " << nbInliersCur <<
-      // std::endl;
-      if (nbInliersCur > nbInliers) {
-        foundSolution = true;
-        best_consensus = cur_consensus;
-        nbInliers = nbInliersCur;
-      }
+  if (ransac.getNbInliers() < nbInliersConsensus) {
+    return false;
+  }
 
-      cur_consensus.clear();
-    }
+  std::vector<double> xa_best(best_consensus.size());
+  std::vector<double> ya_best(best_consensus.size());
+  std::vector<double> xb_best(best_consensus.size());
+  std::vector<double> yb_best(best_consensus.size());
 
-    nbTrials++;
-    if (nbTrials >= ransacMaxTrials) {
-      vpERROR_TRACE("Ransac reached the maximum number of trials");
-      foundSolution = true;
-    }
+  for (unsigned i = 0; i < best_consensus.size(); i++) {
+    xa_best[i] = xa[best_consensus[i]];
+    ya_best[i] = ya[best_consensus[i]];
+    xb_best[i] = xb[best_consensus[i]];
+    yb_best[i] = yb[best_consensus[i]];
   }
 
-  if (foundSolution) {
-    if (nbInliers >= nbInliersConsensus) {
-      std::vector<double> xa_best(best_consensus.size());
-      std::vector<double> ya_best(best_consensus.size());
-      std::vector<double> xb_best(best_consensus.size());
-      std::vector<double> yb_best(best_consensus.size());
-
-      for (unsigned i = 0; i < best_consensus.size(); i++) {
-        xa_best[i] = xa[best_consensus[i]];
-        ya_best[i] = ya[best_consensus[i]];
-        xb_best[i] = xb[best_consensus[i]];
-        yb_best[i] = yb[best_consensus[i]];
-      }
-
-      vpHomography::DLT(xb_best, yb_best, xa_best, ya_best, aHb, normalization);
-      aHb /= aHb[2][2];
-
-      residual = 0;
-      vpColVector a(3), b(3), c(3);
-      for (unsigned int i = 0; i < best_consensus.size(); i++) {
-        a[0] = xa_best[i];
-        a[1] = ya_best[i];
-        a[2] = 1;
-        b[0] = xb_best[i];
-        b[1] = yb_best[i];
-        b[2] = 1;
-
-        c = aHb * b;
-        c /= c[2];
-        residual += (a - c).sumSquare();
-      }
+  vpHomography::DLT(xb_best, yb_best, xa_best, ya_best, aHb, normalization);
+  aHb /= aHb[2][2];
 
-      residual = sqrt(residual / best_consensus.size());
-      return true;
-    } else {
-      return false;
-    }
-  } else {
-    return false;
+  residual = 0;
+  vpColVector a(3), b(3), c(3);
+  for (unsigned int i = 0; i < best_consensus.size(); i++) {
+    a[0] = xa_best[i];
+    a[1] = ya_best[i];
+    a[2] = 1;
+    b[0] = xb_best[i];
+    b[1] = yb_best[i];
+    b[2] = 1;
+
+    c = aHb * b;
+    c /= c[2];
+    residual += (a - c).sumSquare();
   }
+
+  residual = sqrt(residual / best_consensus.size());
+  return true;
 }
@@ -0,0 +1,627 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Nearest neighbor matching of binary descriptors.
+ *
+ *****************************************************************************/
+
+#include <visp3/vision/vpHammingMatcher.h>
+
+#include <algorithm>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpSimdDispatch.h>
+
+#if defined _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Number of queries compared to a block of train descriptors while it is in the cache
+const unsigned int QUERY_TILE = 8;
+// Size in bytes of a block of train descriptors, half of a usual L1 data cache
+const size_t TRAIN_BLOCK_BYTES = 16384;
+// Maximum number of bits of the substrings indexed by the multi-index hashing
+const unsigned int MAX_SUBSTRING_BITS = 16;
+// Costs of probing a bucket and of a candidate found in a bucket, in distances computed by the linear scan
+const double PROBE_COST = 4;
+const double CANDIDATE_COST = 32;
+
+inline unsigned int popcount64(uint64_t x)
+{
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return static_cast<unsigned int>((x * 0x0101010101010101ULL) >> 56);
+}
+
+// Distances between a query and nbTrain consecutive train descriptors. The row size is a multiple of 32, known at
+// compile time for the usual descriptors when ROW_SIZE is not 0.
+template <size_t ROW_SIZE>
+void hammingRows_scalar(const unsigned char *query, const unsigned char *train, size_t rowSize, unsigned int nbTrain,
+                        unsigned int *distances)
+{
+  const size_t size = ROW_SIZE ? ROW_SIZE : rowSize;
+  for (unsigned int t = 0; t < nbTrain; t++, train += size) {
+    unsigned int d = 0;
+    for (size_t k = 0; k < size; k += 8) {
+      uint64_t a, b;
+      memcpy(&a, query + k, 8);
+      memcpy(&b, train + k, 8);
+      d += popcount64(a ^ b);
+    }
+    distances[t] = d;
+  }
+}
+
+void hamming_scalar(const unsigned char *query, const unsigned char *train, size_t rowSize, unsigned int nbTrain,
+                    unsigned int *distances)
+{
+  if (rowSize == 32) {
+    hammingRows_scalar<32>(query, train, rowSize, nbTrain, distances);
+  } else if (rowSize == 64) {
+    hammingRows_scalar<64>(query, train, rowSize, nbTrain, distances);
+  } else {
+    hammingRows_scalar<0>(query, train, rowSize, nbTrain, distances);
+  }
+}
+
+// POPCNT has its own CPUID bit, the kernel is registered at the SSE4.1 level but only used when
+// vpCPUFeatures::checkPOPCNT() is true, see getHammingFunc()
+#if VISP_HAVE_SIMD_DISPATCH && (defined(__x86_64__) || defined(_M_X64))
+#define VISP_HAVE_HAMMING_POPCNT 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#define VISP_HAMMING_TARGET_POPCNT
+#else
+#define VISP_HAMMING_TARGET_POPCNT __attribute__((target("popcnt")))
+#endif
+
+template <size_t ROW_SIZE>
+VISP_HAMMING_TARGET_POPCNT void hammingRows_popcnt(const unsigned char *query, const unsigned char *train,
+                                                   size_t rowSize, unsigned int nbTrain, unsigned int *distances)
+{
+  const size_t size = ROW_SIZE ? ROW_SIZE : rowSize;
+  for (unsigned int t = 0; t < nbTrain; t++, train += size) {
+    uint64_t d = 0;
+    for (size_t k = 0; k < size; k += 16) {
+      uint64_t a0, a1, b0, b1;
+      memcpy(&a0, query + k, 8);
+      memcpy(&a1, query + k + 8, 8);
+      memcpy(&b0, train + k, 8);
+      memcpy(&b1, train + k + 8, 8);
+      d += static_cast<uint64_t>(_mm_popcnt_u64(a0 ^ b0)) + static_cast<uint64_t>(_mm_popcnt_u64(a1 ^ b1));
+    }
+    distances[t] = static_cast<unsigned int>(d);
+  }
+}
+
+VISP_HAMMING_TARGET_POPCNT void hamming_popcnt(const unsigned char *query, const unsigned char *train, size_t rowSize,
+                                               unsigned int nbTrain, unsigned int *distances)
+{
+  if (rowSize == 32) {
+    hammingRows_popcnt<32>(query, train, rowSize, nbTrain, distances);
+  } else if (rowSize == 64) {
+    hammingRows_popcnt<64>(query, train, rowSize, nbTrain, distances);
+  } else {
+    hammingRows_popcnt<0>(query, train, rowSize, nbTrain, distances);
+  }
+}
+#endif
+
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+// Bit count of each byte, with a lookup table on the two nibbles
+VISP_SIMD_TARGET_AVX2 inline __m256i popcount8_avx2(__m256i x, __m256i lut, __m256i low)
+{
+  const __m256i lo = _mm256_and_si256(x, low);
+  const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), low);
+  return _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo), _mm256_shuffle_epi8(lut, hi));
+}
+
+// Distance between a query and a row, split in the four 64-bit lanes
+template <size_t ROW_SIZE>
+VISP_SIMD_TARGET_AVX2 inline __m256i rowDistance_avx2(const unsigned char *query, const unsigned char *row,
+                                                      size_t rowSize, __m256i lut, __m256i low)
+{
+  const size_t size = ROW_SIZE ? ROW_SIZE : rowSize;
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i sum = zero, bytes = zero;
+  unsigned int n = 0;
+  for (size_t k = 0; k < size; k += 32) {
+    const __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(query + k)),
+                                       _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + k)));
+    bytes = _mm256_add_epi8(bytes, popcount8_avx2(x, lut, low));
+    // A byte counter reaches at most 8 * 31 bits
+    if (++n == 31) {
+      sum = _mm256_add_epi64(sum, _mm256_sad_epu8(bytes, zero));
+      bytes = zero;
+      n = 0;
+    }
+  }
+  return _mm256_add_epi64(sum, _mm256_sad_epu8(bytes, zero));
+}
+
+template <size_t ROW_SIZE>
+VISP_SIMD_TARGET_AVX2 void hammingRows_avx2(const unsigned char *query, const unsigned char *train, size_t rowSize,
+                                            unsigned int nbTrain, unsigned int *distances)
+{
+  const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2,
+                                       3, 2, 3, 3, 4);
+  const __m256i low = _mm256_set1_epi8(0x0f);
+  unsigned int t = 0;
+  for (; t + 4 <= nbTrain; t += 4, train += 4 * rowSize) {
+    const __m256i s0 = rowDistance_avx2<ROW_SIZE>(query, train, rowSize, lut, low);
+    const __m256i s1 = rowDistance_avx2<ROW_SIZE>(query, train + rowSize, rowSize, lut, low);
+    const __m256i s2 = rowDistance_avx2<ROW_SIZE>(query, train + 2 * rowSize, rowSize, lut, low);
+    const __m256i s3 = rowDistance_avx2<ROW_SIZE>(query, train + 3 * rowSize, rowSize, lut, low);
+    // Transpose the partial sums of the four rows to add them together
+    const __m256i s01 = _mm256_or_si256(s0, _mm256_slli_epi64(s1, 32));
+    const __m256i s23 = _mm256_or_si256(s2, _mm256_slli_epi64(s3, 32));
+    const __m256i s = _mm256_add_epi32(_mm256_unpacklo_epi64(s01, s23), _mm256_unpackhi_epi64(s01, s23));
+    const __m128i d = _mm_add_epi32(_mm256_castsi256_si128(s), _mm256_extracti128_si256(s, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(distances + t), d);
+  }
+  for (; t < nbTrain; t++, train += rowSize) {
+    const __m256i s = rowDistance_avx2<ROW_SIZE>(query, train, rowSize, lut, low);
+    __m128i d = _mm_add_epi64(_mm256_castsi256_si128(s), _mm256_extracti128_si256(s, 1));
+    d = _mm_add_epi64(d, _mm_unpackhi_epi64(d, d));
+    distances[t] = static_cast<unsigned int>(_mm_cvtsi128_si32(d));
+  }
+}
+
+VISP_SIMD_TARGET_AVX2 void hamming_avx2(const unsigned char *query, const unsigned char *train, size_t rowSize,
+                                        unsigned int nbTrain, unsigned int *distances)
+{
+  if (rowSize == 32) {
+    hammingRows_avx2<32>(query, train, rowSize, nbTrain, distances);
+  } else if (rowSize == 64) {
+    hammingRows_avx2<64>(query, train, rowSize, nbTrain, distances);
+  } else {
+    hammingRows_avx2<0>(query, train, rowSize, nbTrain, distances);
+  }
+}
+#endif
+
+typedef void (*HammingFunc)(const unsigned char *, const unsigned char *, size_t, unsigned int, unsigned int *);
+const vpSimdDispatcher<HammingFunc> hamming_dispatcher = vpSimdDispatcher<HammingFunc>(hamming_scalar)
+#if VISP_HAVE_HAMMING_POPCNT
+                                                             .add(vpCPUFeatures::SIMD_SSE41, hamming_popcnt)
+#endif
+#if VISP_HAVE_SIMD_DISPATCH_AVX
+                                                             .add(vpCPUFeatures::SIMD_AVX2, hamming_avx2)
+#endif
+    ;
+
+inline HammingFunc getHammingFunc()
+{
+  const HammingFunc hamming = hamming_dispatcher.get();
+#if VISP_HAVE_HAMMING_POPCNT
+  if (hamming == hamming_popcnt && !vpCPUFeatures::checkPOPCNT()) {
+    return hamming_scalar;
+  }
+#endif
+  return hamming;
+}
+
+inline void resetMatch(vpHammingMatcher::vpMatch &match)
+{
+  match.trainIdx = 0;
+  match.secondTrainIdx = 0;
+  match.distance = UINT_MAX;
+  match.secondDistance = UINT_MAX;
+}
+
+// Keep the two nearest neighbors, the first train descriptor wins in case of equality
+inline void updateMatch(vpHammingMatcher::vpMatch &match, unsigned int d, unsigned int trainIdx)
+{
+  if (d < match.secondDistance) {
+    if (d < match.distance) {
+      match.secondDistance = match.distance;
+      match.secondTrainIdx = match.trainIdx;
+      match.distance = d;
+      match.trainIdx = trainIdx;
+    } else {
+      match.secondDistance = d;
+      match.secondTrainIdx = trainIdx;
+    }
+  }
+}
+
+void scanTrain(HammingFunc hamming, const unsigned char *query, const unsigned char *train, size_t rowSize,
+               unsigned int first, unsigned int last, unsigned int *distances, vpHammingMatcher::vpMatch &match)
+{
+  hamming(query, train + first * rowSize, rowSize, last - first, distances);
+  // On a local copy, that cannot alias the distances
+  vpHammingMatcher::vpMatch m = match;
+  for (unsigned int t = first; t < last; t++) {
+    updateMatch(m, distances[t - first], t);
+  }
+  match = m;
+}
+
+// Value of the substring [first, first + length) of the bits of a descriptor, length <= 16
+inline uint32_t substring(const unsigned char *descriptor, unsigned int first, unsigned int length)
+{
+  const unsigned int byte = first >> 3, shift = first & 7, nbBytes = (shift + length + 7) >> 3;
+  uint32_t w = 0;
+  for (unsigned int k = 0; k < nbBytes; k++) {
+    w |= static_cast<uint32_t>(descriptor[byte + k]) << (8 * k);
+  }
+  return (w >> shift) & ((1u << length) - 1u);
+}
+
+// Next integer with the same number of bits set (Gosper's hack), mask must not be 0
+inline uint32_t nextCombination(uint32_t mask)
+{
+  const uint32_t c = mask & (~mask + 1u);
+  const uint32_t r = mask + c;
+  return (((r ^ mask) >> 2) / c) | r;
+}
+
+double binomial(unsigned int n, unsigned int k)
+{
+  if (k > n) {
+    return 0;
+  }
+  double c = 1;
+  for (unsigned int i = 0; i < k; i++) {
+    c = c * (n - i) / (i + 1);
+  }
+  return c;
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor, without train descriptor.
+*/
+vpHammingMatcher::vpHammingMatcher()
+  : m_descriptorSize(0), m_nbTrain(0), m_nbThreads(0), m_rowSize(0), m_train(), m_useMultiIndexHashing(false),
+    m_substringFirst(), m_substringLength(), m_tableOffsets(), m_tableIds()
+{
+}
+
+/*!
+  Append train descriptors. Their indexes follow the ones of the descriptors that were already added.
+
+  \param descriptors : Descriptors, stored row by row.
+  \param nbDescriptors : Number of descriptors.
+  \param descriptorSize : Size in bytes of a descriptor, the same for all the calls until clear().
+  \param stride : Number of bytes between two rows of \e descriptors, 0 if they are contiguous.
+*/
+void vpHammingMatcher::add(const unsigned char *descriptors, unsigned int nbDescriptors, unsigned int descriptorSize,
+                           size_t stride)
+{
+  if (descriptorSize == 0 || (m_descriptorSize != 0 && descriptorSize != m_descriptorSize)) {
+    throw(vpException(vpException::dimensionError, "Cannot add descriptors of %u bytes to descriptors of %u bytes",
+                      descriptorSize, m_descriptorSize));
+  }
+  if (stride == 0) {
+    stride = descriptorSize;
+  } else if (stride < descriptorSize) {
+    throw(vpException(vpException::badValue, "The stride %u is smaller than the descriptor size %u",
+                      static_cast<unsigned int>(stride), descriptorSize));
+  }
+  if (nbDescriptors == 0) {
+    return;
+  }
+
+  m_descriptorSize = descriptorSize;
+  m_rowSize = (static_cast<size_t>(descriptorSize) + 31) / 32 * 32;
+  m_train.resize((static_cast<size_t>(m_nbTrain) + nbDescriptors) * m_rowSize, 0);
+  for (unsigned int i = 0; i < nbDescriptors; i++) {
+    memcpy(&m_train[(m_nbTrain + i) * m_rowSize], descriptors + i * stride, descriptorSize);
+  }
+  m_nbTrain += nbDescriptors;
+
+  buildMultiIndex();
+}
+
+/*!
+  Build the hash tables of the multi-index hashing: the descriptors are split in m substrings of about log2(N)
+  bits, N being the number of train descriptors, and each substring is used as the key of a table.
+*/
+void vpHammingMatcher::buildMultiIndex()
+{
+  m_substringFirst.clear();
+  m_substringLength.clear();
+  m_tableOffsets.clear();
+  m_tableIds.clear();
+  if (!m_useMultiIndexHashing || m_nbTrain == 0) {
+    return;
+  }
+
+  const unsigned int nbBits = 8 * m_descriptorSize;
+  unsigned int bits = 0;
+  while (bits < MAX_SUBSTRING_BITS && (2u << bits) <= m_nbTrain) {
+    bits++;
+  }
+  bits = std::min(std::max(bits, 8u), nbBits);
+  const unsigned int nbTables = (nbBits + bits - 1) / bits;
+
+  m_tableOffsets.resize(nbTables);
+  m_tableIds.resize(nbTables);
+  unsigned int first = 0;
+  for (unsigned int j = 0; j < nbTables; j++) {
+    const unsigned int length = nbBits / nbTables + (j < nbBits % nbTables ? 1 : 0);
+    m_substringFirst.push_back(first);
+    m_substringLength.push_back(length);
+
+    // Counting sort of the train descriptors on the value of the substring
+    std::vector<unsigned int> &offsets = m_tableOffsets[j];
+    std::vector<unsigned int> &ids = m_tableIds[j];
+    offsets.assign((1u << length) + 1, 0);
+    ids.resize(m_nbTrain);
+    for (unsigned int t = 0; t < m_nbTrain; t++) {
+      offsets[substring(&m_train[t * m_rowSize], first, length) + 1]++;
+    }
+    for (size_t v = 1; v < offsets.size(); v++) {
+      offsets[v] += offsets[v - 1];
+    }
+    std::vector<unsigned int> next(offsets.begin(), offsets.end() - 1);
+    for (unsigned int t = 0; t < m_nbTrain; t++) {
+      ids[next[substring(&m_train[t * m_rowSize], first, length)]++] = t;
+    }
+    first += length;
+  }
+}
+
+/*!
+  Remove all the train descriptors.
+*/
+void vpHammingMatcher::clear()
+{
+  m_descriptorSize = 0;
+  m_nbTrain = 0;
+  m_rowSize = 0;
+  m_train.clear();
+  buildMultiIndex();
+}
+
+/*!
+  Return the Hamming distance between two descriptors.
+
+  \param a, b : Descriptors.
+  \param descriptorSize : Size in bytes of the descriptors.
+*/
+unsigned int vpHammingMatcher::distance(const unsigned char *a, const unsigned char *b, unsigned int descriptorSize)
+{
+  unsigned int d = 0, k = 0;
+  for (; k + 8 <= descriptorSize; k += 8) {
+    uint64_t x, y;
+    memcpy(&x, a + k, 8);
+    memcpy(&y, b + k, 8);
+    d += popcount64(x ^ y);
+  }
+  for (; k < descriptorSize; k++) {
+    d += popcount64(static_cast<uint64_t>(a[k] ^ b[k]));
+  }
+  return d;
+}
+
+/*!
+  Search the two nearest train descriptors of each query descriptor.
+
+  \param queries : Query descriptors, stored row by row, with the size of the train descriptors.
+  \param nbQueries : Number of query descriptors.
+  \param stride : Number of bytes between two rows of \e queries, 0 if they are contiguous.
+  \param matches : One match per query descriptor, in the order of the queries. Empty if there is no train
+  descriptor.
+*/
+void vpHammingMatcher::knnMatch(const unsigned char *queries, unsigned int nbQueries, size_t stride,
+                                std::vector<vpMatch> &matches) const
+{
+  matchQueries(queries, nbQueries, stride, 0, matches);
+}
+
+/*!
+  Search the nearest train descriptor of each query descriptor, and keep it only if it passes the distance ratio
+  test of Lowe: its distance is lower than \e ratio times the distance to the second nearest train descriptor.
+
+  With the multi-index hashing, the search of a query stops as soon as the test can be decided. In that case the
+  vpMatch::secondDistance of the kept matches may be larger than the exact one.
+
+  \param queries : Query descriptors, stored row by row, with the size of the train descriptors.
+  \param nbQueries : Number of query descriptors.
+  \param stride : Number of bytes between two rows of \e queries, 0 if they are contiguous.
+  \param ratio : Distance ratio threshold, in ]0, 1].
+  \param matches : Matches that pass the test, sorted by query index.
+*/
+void vpHammingMatcher::match(const unsigned char *queries, unsigned int nbQueries, size_t stride, double ratio,
+                             std::vector<vpMatch> &matches) const
+{
+  if (ratio <= 0) {
+    throw(vpException(vpException::badValue, "The distance ratio threshold must be positive"));
+  }
+  matchQueries(queries, nbQueries, stride, ratio, matches);
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+void vpHammingMatcher::matchQueries(const unsigned char *queries, unsigned int nbQueries, size_t stride, double ratio,
+                                    std::vector<vpMatch> &matches) const
+{
+  matches.clear();
+  if (nbQueries == 0 || m_nbTrain == 0) {
+    return;
+  }
+  if (stride == 0) {
+    stride = m_descriptorSize;
+  } else if (stride < m_descriptorSize) {
+    throw(vpException(vpException::badValue, "The stride %u is smaller than the descriptor size %u",
+                      static_cast<unsigned int>(stride), m_descriptorSize));
+  }
+
+  const HammingFunc hamming = getHammingFunc();
+  const unsigned int blockSize = static_cast<unsigned int>(std::max<size_t>(64, TRAIN_BLOCK_BYTES / m_rowSize));
+  const int nbTiles = static_cast<int>((nbQueries + QUERY_TILE - 1) / QUERY_TILE);
+  std::vector<vpMatch> knn(nbQueries);
+
+#if defined _OPENMP
+  const int nbThreads = m_nbThreads > 0 ? static_cast<int>(m_nbThreads) : omp_get_max_threads();
+#pragma omp parallel num_threads(nbThreads)
+#endif
+  {
+    // The queries are copied in rows padded with zeros, as the train descriptors
+    std::vector<unsigned char> tile(QUERY_TILE * m_rowSize, 0);
+    std::vector<unsigned int> distances(blockSize);
+    std::vector<unsigned int> visited(m_useMultiIndexHashing ? m_nbTrain : 0, 0);
+    unsigned int stamp = 0;
+
+#if defined _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (int i = 0; i < nbTiles; i++) {
+      const unsigned int first = static_cast<unsigned int>(i) * QUERY_TILE;
+      const unsigned int n = std::min(QUERY_TILE, nbQueries - first);
+      for (unsigned int q = 0; q < n; q++) {
+        memcpy(&tile[q * m_rowSize], queries + (first + q) * stride, m_descriptorSize);
+        knn[first + q].queryIdx = first + q;
+        resetMatch(knn[first + q]);
+      }
+
+      // The queries without close neighbor in the hash tables are matched with the linear scan
+      unsigned int pending[QUERY_TILE], nbPending = 0;
+      for (unsigned int q = 0; q < n; q++) {
+        if (!m_useMultiIndexHashing ||
+            !searchMultiIndex(&tile[q * m_rowSize], ratio, &visited[0], ++stamp, knn[first + q])) {
+          resetMatch(knn[first + q]);
+          pending[nbPending++] = q;
+        }
+      }
+      for (unsigned int b = 0; b < m_nbTrain && nbPending > 0; b += blockSize) {
+        const unsigned int last = std::min(m_nbTrain, b + blockSize);
+        for (unsigned int p = 0; p < nbPending; p++) {
+          scanTrain(hamming, &tile[pending[p] * m_rowSize], &m_train[0], m_rowSize, b, last, &distances[0],
+                    knn[first + pending[p]]);
+        }
+      }
+    }
+  }
+
+  if (ratio <= 0) {
+    matches.swap(knn);
+  } else {
+    for (unsigned int q = 0; q < nbQueries; q++) {
+      if (knn[q].distance < ratio * knn[q].secondDistance) {
+        matches.push_back(knn[q]);
+      }
+    }
+  }
+}
+
+/*
+  Probe the buckets of the hash tables at an increasing Hamming distance s of the substrings of the query. When all
+  the buckets at the distance s are probed, the train descriptors that were not found have all their m substrings
+  at a distance larger than s, thus a distance to the query of at least m (s + 1). As the buckets and the candidates
+  are read in random order, the search is given up as soon as the expected cost of the probes is the one of the
+  linear scan, which is the case for the queries without close neighbor.
+*/
+bool vpHammingMatcher::searchMultiIndex(const unsigned char *query, double ratio, unsigned int *visited,
+                                        unsigned int stamp, vpMatch &match) const
+{
+  const HammingFunc hamming = getHammingFunc();
+  const unsigned int nbTables = static_cast<unsigned int>(m_substringLength.size());
+  const unsigned int maxLength = *std::max_element(m_substringLength.begin(), m_substringLength.end());
+  double cost = 0;
+
+  for (unsigned int s = 0; s <= maxLength; s++) {
+    for (unsigned int j = 0; j < nbTables; j++) {
+      const unsigned int length = m_substringLength[j];
+      if (s > length) {
+        continue;
+      }
+      const uint32_t key = substring(query, m_substringFirst[j], length);
+      const std::vector<unsigned int> &offsets = m_tableOffsets[j];
+      const std::vector<unsigned int> &ids = m_tableIds[j];
+      for (uint32_t mask = (1u << s) - 1u; mask < (1u << length); mask = nextCombination(mask)) {
+        const uint32_t bucket = key ^ mask;
+        for (unsigned int k = offsets[bucket]; k < offsets[bucket + 1]; k++) {
+          const unsigned int id = ids[k];
+          if (visited[id] != stamp) {
+            visited[id] = stamp;
+            unsigned int d;
+            hamming(query, &m_train[id * m_rowSize], m_rowSize, 1, &d);
+            updateMatch(match, d, id);
+          }
+        }
+        if (mask == 0) {
+          break;
+        }
+      }
+    }
+
+    const double bound = static_cast<double>(nbTables) * (s + 1);
+    if (match.distance <= bound && (match.secondDistance <= bound || ratio * bound > match.distance)) {
+      return true;
+    }
+
+    // Expected cost of the probes up to the next distance, in distances of the linear scan
+    double nbProbes = 0, nbNewCandidates = 0;
+    for (unsigned int j = 0; j < nbTables; j++) {
+      const double probes = binomial(m_substringLength[j], s + 1);
+      nbProbes += probes;
+      nbNewCandidates += probes * m_nbTrain / static_cast<double>(1u << m_substringLength[j]);
+    }
+    cost += PROBE_COST * nbProbes + CANDIDATE_COST * nbNewCandidates;
+    if (cost > m_nbTrain) {
+      break;
+    }
+  }
+
+  return false;
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Set the number of OpenMP threads used to match the queries.
+
+  \param nbThreads : Number of threads, 0 to use the OpenMP default.
+*/
+void vpHammingMatcher::setNbThreads(unsigned int nbThreads) { m_nbThreads = nbThreads; }
+
+/*!
+  Use the multi-index hashing of \cite Norouzi12 instead of the linear scan. It is faster when the train
+  descriptors are numerous (more than about 10000) and the queries have close neighbors, and needs 4 bytes per
+  train descriptor and per substring of about log2(N) bits.
+
+  \param use : True to build the hash tables, false to release them.
+*/
+void vpHammingMatcher::setUseMultiIndexHashing(bool use)
+{
+  if (use != m_useMultiIndexHashing) {
+    m_useMultiIndexHashing = use;
+    buildMultiIndex();
+  }
+}
@@ -37,7 +37,14 @@
  *****************************************************************************/
 
 #include <iomanip>
+#include <iterator>
 #include <limits>
+#include <sstream>
+#if defined(_WIN32)
+#include <process.h> // _getpid
+#else
+#include <unistd.h> // getpid
+#endif
 
 #include <visp3/core/vpIoTools.h>
 #include <visp3/vision/vpKeyPoint.h>
@@ -67,6 +74,159 @@ inline vpImagePoint matchRansacToVpImage(const std::pair<cv::KeyPoint, cv::Point
   return vpImagePoint(pair.first.pt.y, pair.first.pt.x);
 }
 
+// Two nearest neighbors of the query descriptors found by vpHammingMatcher, in the OpenCV format. With swapIndexes,
+// the query descriptors are the train descriptors of vpKeyPoint.
+void hammingKnnMatch(const vpHammingMatcher &matcher, const cv::Mat &queryDescriptors, bool swapIndexes,
+                     std::vector<std::vector<cv::DMatch> > &knnMatches)
+{
+  std::vector<vpHammingMatcher::vpMatch> matches;
+  matcher.knnMatch(queryDescriptors.ptr<unsigned char>(0), static_cast<unsigned int>(queryDescriptors.rows),
+                   queryDescriptors.step[0], matches);
+
+  knnMatches.resize(matches.size());
+  for (size_t i = 0; i < matches.size(); i++) {
+    const vpHammingMatcher::vpMatch &m = matches[i];
+    const int queryIdx = static_cast<int>(m.queryIdx), trainIdx = static_cast<int>(m.trainIdx);
+    const int secondTrainIdx = static_cast<int>(m.secondTrainIdx);
+    knnMatches[i].clear();
+    knnMatches[i].push_back(swapIndexes ? cv::DMatch(trainIdx, queryIdx, static_cast<float>(m.distance))
+                                        : cv::DMatch(queryIdx, trainIdx, static_cast<float>(m.distance)));
+    if (m.secondDistance != std::numeric_limits<unsigned int>::max()) {
+      knnMatches[i].push_back(swapIndexes
+                                  ? cv::DMatch(secondTrainIdx, queryIdx, static_cast<float>(m.secondDistance))
+                                  : cv::DMatch(queryIdx, secondTrainIdx, static_cast<float>(m.secondDistance)));
+    }
+  }
+}
+
+// Training image in the binary PGM format, that the learning database stores when the visp_io module is not available
+void encodePgm(const vpImage<unsigned char> &I, std::vector<unsigned char> &data)
+{
+  std::ostringstream header;
+  header << "P5\n" << I.getWidth() << " " << I.getHeight() << "\n255\n";
+  const std::string str = header.str();
+  data.assign(str.begin(), str.end());
+  data.insert(data.end(), I.bitmap, I.bitmap + I.getSize());
+}
+
+bool decodePgm(const unsigned char *data, size_t size, vpImage<unsigned char> &I)
+{
+  std::istringstream header(std::string(reinterpret_cast<const char *>(data), std::min<size_t>(size, 64)));
+  std::string magic;
+  unsigned int width = 0, height = 0, maxValue = 0;
+  header >> magic >> width >> height >> maxValue;
+  if (!header || magic != "P5" || maxValue != 255) {
+    return false;
+  }
+  // A single whitespace separates the header from the pixels
+  const std::streamoff position = header.tellg();
+  const size_t offset = static_cast<size_t>(position) + 1;
+  if (position < 0 || offset + static_cast<size_t>(width) * height > size) {
+    return false;
+  }
+  I.resize(height, width);
+  std::copy(data + offset, data + offset + I.getSize(), I.bitmap);
+  return true;
+}
+
+#ifdef VISP_HAVE_MODULE_IO
+// vpImageIo only reads and writes files: the images are encoded and decoded in a file next to the learning database,
+// whose name is unique among the processes and the images being converted
+std::string getTemporaryImageFilename(const std::string &filename, const std::string &format, const void *image)
+{
+  std::ostringstream ss;
+#if defined(_WIN32)
+  ss << filename << "." << _getpid() << "." << image << "." << format;
+#else
+  ss << filename << "." << getpid() << "." << image << "." << format;
+#endif
+  return ss.str();
+}
+#endif
+
+// Training image of the learning database filename, in the format of vpKeyPoint::setImageFormat() that vpImageIo
+// encodes, or in the binary PGM format without the visp_io module
+void encodeTrainingImage(const vpImage<unsigned char> &I, vpKeyPoint::vpImageFormatType imageFormat,
+                         const std::string &filename, vpKeyPointDatabase::vpTrainingImage &image)
+{
+#ifdef VISP_HAVE_MODULE_IO
+  switch (imageFormat) {
+  case vpKeyPoint::jpgImageFormat:
+    image.format = "jpg";
+    break;
+
+  case vpKeyPoint::ppmImageFormat:
+    image.format = "ppm";
+    break;
+
+  case vpKeyPoint::pgmImageFormat:
+    image.format = "pgm";
+    break;
+
+  case vpKeyPoint::pngImageFormat:
+  default:
+    image.format = "png";
+    break;
+  }
+
+  if (image.format != "pgm") {
+    const std::string tmpFilename = getTemporaryImageFilename(filename, image.format, &I);
+    vpImageIo::write(I, tmpFilename);
+    std::ifstream file(tmpFilename.c_str(), std::ifstream::binary);
+    image.data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    file.close();
+    vpIoTools::remove(tmpFilename);
+    if (image.data.empty()) {
+      throw vpException(vpException::ioError, "Cannot encode the training image %d.", image.imageId);
+    }
+    return;
+  }
+#else
+  (void)imageFormat;
+  (void)filename;
+#endif
+  image.format = "pgm";
+  encodePgm(I, image.data);
+}
+
+// Decode the image at index of the learning database filename, see encodeTrainingImage()
+void decodeTrainingImage(const vpKeyPointDatabase &database, unsigned int index, const std::string &filename,
+                         vpImage<unsigned char> &I)
+{
+  size_t size = 0;
+  const unsigned char *data = database.getImageData(index, size);
+  const std::string format = database.getImageFormat(index);
+  if (format == "pgm") {
+    if (!decodePgm(data, size, I)) {
+      throw vpException(vpException::ioError, "Cannot decode the training image %d.", database.getImageId(index));
+    }
+    return;
+  }
+
+#ifdef VISP_HAVE_MODULE_IO
+  const std::string tmpFilename = getTemporaryImageFilename(filename, format, &I);
+  std::ofstream file(tmpFilename.c_str(), std::ofstream::binary);
+  file.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+  file.close();
+  if (!file) {
+    vpIoTools::remove(tmpFilename);
+    throw vpException(vpException::ioError, "Cannot decode the training image %d in %s.", database.getImageId(index),
+                      tmpFilename.c_str());
+  }
+  try {
+    vpImageIo::read(I, tmpFilename);
+  } catch (...) {
+    vpIoTools::remove(tmpFilename);
+    throw;
+  }
+  vpIoTools::remove(tmpFilename);
+#else
+  (void)filename;
+  (void)I;
+  throw vpException(vpException::ioError, "Cannot decode the training image %d in the %s format without visp_io.",
+                    database.getImageId(index), format.c_str());
+#endif
+}
 }
 
 /*!
@@ -83,10 +243,12 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
   : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(), m_detectors(),
     m_extractionTime(0.), m_extractorNames(), m_extractors(), m_filteredMatches(), m_filterType(filterType),
-    m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(), m_matcher(),
-    m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85),
-    m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100),
-    m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
+    m_hammingMatcher(), m_imageFormat(jpgImageFormat), m_encodedImages(), m_knnMatches(), m_learningDatabase(),
+    m_mapOfImageId(), m_mapOfImages(), m_matcher(), m_matcherName(matcherName), m_matches(),
+    m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85), m_matchingTime(0.),
+    m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200),
+    m_nbRansacMinInlierCount(100), m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(),
+    m_queryFilteredKeyPoints(), m_queryKeyPoints(),
     m_ransacConsensusPercentage(20.0), m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(), m_ransacOutliers(),
     m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0),
     m_ransacThreshold(0.01), m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(), m_trainVpPoints(),
@@ -94,8 +256,8 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
     m_useBruteForceCrossCheck(true),
 #endif
-    m_useConsensusPercentage(false), m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true),
-    m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
+    m_useConsensusPercentage(false), m_useHammingMatcher(false), m_useKnn(false), m_useMatchTrainToQuery(false),
+    m_useRansacVVS(true), m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
 {
   initFeatureNames();
 
@@ -119,10 +281,12 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
   : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(), m_detectors(),
     m_extractionTime(0.), m_extractorNames(), m_extractors(), m_filteredMatches(), m_filterType(filterType),
-    m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(), m_matcher(),
-    m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85),
-    m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100),
-    m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
+    m_hammingMatcher(), m_imageFormat(jpgImageFormat), m_encodedImages(), m_knnMatches(), m_learningDatabase(),
+    m_mapOfImageId(), m_mapOfImages(), m_matcher(), m_matcherName(matcherName), m_matches(),
+    m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85), m_matchingTime(0.),
+    m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200),
+    m_nbRansacMinInlierCount(100), m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(),
+    m_queryFilteredKeyPoints(), m_queryKeyPoints(),
     m_ransacConsensusPercentage(20.0), m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(), m_ransacOutliers(),
     m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0),
     m_ransacThreshold(0.01), m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(), m_trainVpPoints(),
@@ -130,8 +294,8 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
     m_useBruteForceCrossCheck(true),
 #endif
-    m_useConsensusPercentage(false), m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true),
-    m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
+    m_useConsensusPercentage(false), m_useHammingMatcher(false), m_useKnn(false), m_useMatchTrainToQuery(false),
+    m_useRansacVVS(true), m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
 {
   initFeatureNames();
 
@@ -155,9 +319,10 @@ vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std:
   : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(detectorNames),
     m_detectors(), m_extractionTime(0.), m_extractorNames(extractorNames), m_extractors(), m_filteredMatches(),
-    m_filterType(filterType), m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
-    m_matcher(), m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0),
-    m_matchingRatioThreshold(0.85), m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200),
+    m_filterType(filterType), m_hammingMatcher(), m_imageFormat(jpgImageFormat), m_encodedImages(), m_knnMatches(),
+    m_learningDatabase(), m_mapOfImageId(), m_mapOfImages(), m_matcher(), m_matcherName(matcherName), m_matches(),
+    m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85), m_matchingTime(0.),
+    m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200),
     m_nbRansacMinInlierCount(100), m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(),
     m_queryFilteredKeyPoints(), m_queryKeyPoints(), m_ransacConsensusPercentage(20.0), m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(),
     m_ransacOutliers(), m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0), m_ransacThreshold(0.01),
@@ -165,8 +330,8 @@ vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std:
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
     m_useBruteForceCrossCheck(true),
 #endif
-    m_useConsensusPercentage(false), m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true),
-    m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
+    m_useConsensusPercentage(false), m_useHammingMatcher(false), m_useKnn(false), m_useMatchTrainToQuery(false),
+    m_useRansacVVS(true), m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
 {
   initFeatureNames();
   init();
@@ -289,7 +454,10 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const v
   m_trainPoints.clear();
   m_mapOfImageId.clear();
   m_mapOfImages.clear();
+  m_encodedImages.clear();
   m_currentImageId = 1;
+  m_trainDescriptors = cv::Mat();
+  m_learningDatabase.close();
 
   if (m_useAffineDetection) {
     std::vector<std::vector<cv::KeyPoint> > listOfTrainKeyPoints;
@@ -336,6 +504,7 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const v
   // Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  updateHammingMatcher();
 
   return static_cast<unsigned int>(m_trainKeyPoints.size());
 }
@@ -460,10 +629,12 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const s
                                         const cv::Mat &trainDescriptors, const std::vector<cv::Point3f> &points3f,
                                         bool append, int class_id)
 {
+  detachLearningDatabase();
   if (!append) {
     m_trainPoints.clear();
     m_mapOfImageId.clear();
     m_mapOfImages.clear();
+    m_encodedImages.clear();
     m_currentImageId = 0;
     m_trainKeyPoints.clear();
   }
@@ -503,6 +674,7 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const s
   // Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  updateHammingMatcher();
 
   _reference_computed = true;
 
@@ -1164,6 +1336,8 @@ void vpKeyPoint::createImageMatching(vpImage<unsigned char> &IRef, vpImage<vpRGB
  */
 void vpKeyPoint::createImageMatching(vpImage<unsigned char> &ICurrent, vpImage<unsigned char> &IMatching)
 {
+  decodeTrainingImages();
+
   // Nb images in the training database + the current image we want to detect
   // the object
   unsigned int nbImg = (unsigned int)(m_mapOfImages.size() + 1);
@@ -1219,6 +1393,8 @@ void vpKeyPoint::createImageMatching(vpImage<unsigned char> &ICurrent, vpImage<u
  */
 void vpKeyPoint::createImageMatching(vpImage<vpRGBa> &ICurrent, vpImage<vpRGBa> &IMatching)
 {
+  decodeTrainingImages();
+
   // Nb images in the training database + the current image we want to detect
   // the object
   unsigned int nbImg = (unsigned int)(m_mapOfImages.size() + 1);
@@ -1263,6 +1439,30 @@ void vpKeyPoint::createImageMatching(vpImage<vpRGBa> &ICurrent, vpImage<vpRGBa>
   }
 }
 
+/*!
+   Decode the training images of the learning databases loaded by
+   loadLearningData() that are not decoded yet.
+ */
+void vpKeyPoint::decodeTrainingImages()
+{
+  for (std::map<int, vpEncodedImage>::const_iterator it = m_encodedImages.begin(); it != m_encodedImages.end(); ++it) {
+    decodeTrainingImage(it->second.database, it->second.index, it->second.filename, m_mapOfImages[it->first]);
+  }
+  m_encodedImages.clear();
+}
+
+/*!
+   Copy the train descriptors that point to the pages of the learning database loaded by loadLearningData(), so
+   that they can be modified, and close the database.
+ */
+void vpKeyPoint::detachLearningDatabase()
+{
+  if (m_learningDatabase.isOpen()) {
+    m_trainDescriptors = m_trainDescriptors.clone();
+    m_learningDatabase.close();
+  }
+}
+
 /*!
    Detect keypoints in the image.
 
@@ -1583,6 +1783,8 @@ void vpKeyPoint::displayMatching(const vpImage<unsigned char> &ICurrent, vpImage
                                  const std::vector<vpImagePoint> &ransacInliers, unsigned int crossSize,
                                  unsigned int lineThickness)
 {
+  decodeTrainingImages();
+
   if (m_mapOfImages.empty() || m_mapOfImageId.empty()) {
     // No training images so return
     std::cerr << "There is no training image loaded !" << std::endl;
@@ -1704,6 +1906,8 @@ void vpKeyPoint::displayMatching(const vpImage<vpRGBa> &ICurrent, vpImage<vpRGBa
                                  const std::vector<vpImagePoint> &ransacInliers, unsigned int crossSize,
                                  unsigned int lineThickness)
 {
+  decodeTrainingImages();
+
   if (m_mapOfImages.empty() || m_mapOfImageId.empty()) {
     // No training images so return
     std::cerr << "There is no training image loaded !" << std::endl;
@@ -2808,6 +3012,8 @@ void vpKeyPoint::insertImageMatching(const vpImage<vpRGBa> &IRef, const vpImage<
  */
 void vpKeyPoint::insertImageMatching(const vpImage<unsigned char> &ICurrent, vpImage<unsigned char> &IMatching)
 {
+  decodeTrainingImages();
+
   // Nb images in the training database + the current image we want to detect
   // the object
   int nbImg = (int)(m_mapOfImages.size() + 1);
@@ -2878,6 +3084,8 @@ void vpKeyPoint::insertImageMatching(const vpImage<unsigned char> &ICurrent, vpI
  */
 void vpKeyPoint::insertImageMatching(const vpImage<vpRGBa> &ICurrent, vpImage<vpRGBa> &IMatching)
 {
+  decodeTrainingImages();
+
   // Nb images in the training database + the current image we want to detect
   // the object
   int nbImg = (int)(m_mapOfImages.size() + 1);
@@ -3019,6 +3227,13 @@ void vpKeyPoint::loadConfigFile(const std::string &configFile)
 /*!
    Load learning data saved on disk.
 
+   A learning database written by saveLearningDatabase() is detected whatever
+   \e binaryMode: the file is memory mapped and, if \e append is false, the
+   train descriptors are used in place, see vpKeyPointDatabase. Its training
+   images are only decoded when they are first displayed or saved in another
+   file: the compressed ones are decoded by vpImageIo through a temporary file
+   written next to the learning database.
+
    \param filename : Path of the learning file.
    \param binaryMode : If true, the learning file is in a binary mode,
    otherwise it is in XML mode.
@@ -3033,7 +3248,12 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
     m_trainPoints.clear();
     m_mapOfImageId.clear();
     m_mapOfImages.clear();
+    m_encodedImages.clear();
+    m_trainDescriptors = cv::Mat();
+    m_learningDatabase.close();
   } else {
+    detachLearningDatabase();
+
     // In append case, find the max index of keypoint class Id
     for (std::map<int, int>::const_iterator it = m_mapOfImageId.begin(); it != m_mapOfImageId.end(); ++it) {
       if (startClassId < it->first) {
@@ -3056,7 +3276,69 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
     parent += "/";
   }
 
-  if (binaryMode) {
+  if (vpKeyPointDatabase::isDatabaseFile(filename)) {
+    vpKeyPointDatabase database;
+    database.open(filename);
+
+    const vpKeyPointDatabase::vpKeyPointRecord *keyPoints = database.getKeyPoints();
+    const unsigned int nbKeyPoints = database.getNbKeyPoints();
+    const size_t startIndex = m_trainKeyPoints.size();
+    m_trainKeyPoints.resize(startIndex + nbKeyPoints);
+    for (unsigned int i = 0; i < nbKeyPoints; i++) {
+      const vpKeyPointDatabase::vpKeyPointRecord &kp = keyPoints[i];
+      cv::KeyPoint &trainKeyPoint = m_trainKeyPoints[startIndex + i];
+      trainKeyPoint.pt.x = kp.x;
+      trainKeyPoint.pt.y = kp.y;
+      trainKeyPoint.size = kp.size;
+      trainKeyPoint.angle = kp.angle;
+      trainKeyPoint.response = kp.response;
+      trainKeyPoint.octave = kp.octave;
+      trainKeyPoint.class_id = kp.classId + startClassId;
+      // No training images if image_id == -1. The keypoints of a training image are consecutive, the map is only
+      // updated when the class changes.
+      if (kp.imageId != -1 && (i == 0 || kp.classId != keyPoints[i - 1].classId)) {
+        m_mapOfImageId[trainKeyPoint.class_id] = kp.imageId + startImageId;
+      }
+    }
+
+    // The 3D points are stored as cv::Point3f, three floats per point
+    const float *points3D = database.getPoints3D();
+    if (points3D != NULL) {
+      const cv::Point3f *first = reinterpret_cast<const cv::Point3f *>(points3D);
+      m_trainPoints.insert(m_trainPoints.end(), first, first + nbKeyPoints);
+    }
+
+    // The training images are decoded on first use, by the functions that display them or save them in another
+    // format, see decodeTrainingImages()
+    for (unsigned int i = 0; i < database.getNbImages(); i++) {
+      const int id = database.getImageId(i) + startImageId;
+      vpEncodedImage &image = m_encodedImages[id];
+      image.database = database;
+      image.index = i;
+      image.filename = filename;
+      m_mapOfImages[id] = vpImage<unsigned char>();
+    }
+
+    const vpKeyPointDatabase::vpDescriptors descriptors = database.getDescriptors();
+    cv::Mat trainDescriptorsTmp;
+    if (descriptors.rows > 0) {
+      if (descriptors.rowSize != descriptors.cols * CV_ELEM_SIZE(descriptors.type)) {
+        throw vpException(vpException::badValue, "The type of the descriptors is not supported.");
+      }
+      // The matrix points to the pages of the file, that are read only
+      trainDescriptorsTmp = cv::Mat(static_cast<int>(descriptors.rows), static_cast<int>(descriptors.cols),
+                                    descriptors.type, const_cast<unsigned char *>(descriptors.data),
+                                    descriptors.stride);
+    }
+
+    if (!append || m_trainDescriptors.empty()) {
+      // Keep the file mapped while the train descriptors point to it
+      m_trainDescriptors = trainDescriptorsTmp;
+      m_learningDatabase = database;
+    } else {
+      cv::vconcat(m_trainDescriptors, trainDescriptorsTmp, m_trainDescriptors);
+    }
+  } else if (binaryMode) {
     std::ifstream file(filename.c_str(), std::ifstream::binary);
     if (!file.is_open()) {
       throw vpException(vpException::ioError, "Cannot open the file.");
@@ -3402,6 +3684,7 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
   // Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  updateHammingMatcher();
 
   // Set _reference_computed to true as we load a learning file
   _reference_computed = true;
@@ -3423,6 +3706,13 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
 {
   double t = vpTime::measureTimeMs();
 
+  // The native matcher needs binary descriptors, and the train ones when they are not the ones it holds
+  const bool useHammingMatcher =
+      m_useHammingMatcher && queryDescriptors.type() == CV_8UC1 && !queryDescriptors.empty() &&
+      trainDescriptors.type() == CV_8UC1 && trainDescriptors.cols == queryDescriptors.cols &&
+      (m_useMatchTrainToQuery ||
+       m_hammingMatcher.getNbTrainDescriptors() == static_cast<unsigned int>(trainDescriptors.rows));
+
   if (m_useKnn) {
     m_knnMatches.clear();
 
@@ -3430,8 +3720,16 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
       std::vector<std::vector<cv::DMatch> > knnMatchesTmp;
 
       // Match train descriptors to query descriptors
-      cv::Ptr<cv::DescriptorMatcher> matcherTmp = m_matcher->clone(true);
-      matcherTmp->knnMatch(trainDescriptors, queryDescriptors, knnMatchesTmp, 2);
+      if (useHammingMatcher) {
+        vpHammingMatcher matcherTmp;
+        matcherTmp.setNbThreads(m_hammingMatcher.getNbThreads());
+        matcherTmp.add(queryDescriptors.ptr<unsigned char>(0), static_cast<unsigned int>(queryDescriptors.rows),
+                       static_cast<unsigned int>(queryDescriptors.cols), queryDescriptors.step[0]);
+        hammingKnnMatch(matcherTmp, trainDescriptors, false, knnMatchesTmp);
+      } else {
+        cv::Ptr<cv::DescriptorMatcher> matcherTmp = m_matcher->clone(true);
+        matcherTmp->knnMatch(trainDescriptors, queryDescriptors, knnMatchesTmp, 2);
+      }
 
       for (std::vector<std::vector<cv::DMatch> >::const_iterator it1 = knnMatchesTmp.begin();
            it1 != knnMatchesTmp.end(); ++it1) {
@@ -3446,10 +3744,28 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
       std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
     } else {
       // Match query descriptors to train descriptors
-      m_matcher->knnMatch(queryDescriptors, m_knnMatches, 2);
+      if (useHammingMatcher) {
+        hammingKnnMatch(m_hammingMatcher, queryDescriptors, false, m_knnMatches);
+      } else {
+        m_matcher->knnMatch(queryDescriptors, m_knnMatches, 2);
+      }
       matches.resize(m_knnMatches.size());
       std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
     }
+  } else if (useHammingMatcher) {
+    // The nearest of the two nearest neighbors
+    std::vector<std::vector<cv::DMatch> > knnMatchesTmp;
+    if (m_useMatchTrainToQuery) {
+      vpHammingMatcher matcherTmp;
+      matcherTmp.setNbThreads(m_hammingMatcher.getNbThreads());
+      matcherTmp.add(queryDescriptors.ptr<unsigned char>(0), static_cast<unsigned int>(queryDescriptors.rows),
+                     static_cast<unsigned int>(queryDescriptors.cols), queryDescriptors.step[0]);
+      hammingKnnMatch(matcherTmp, trainDescriptors, true, knnMatchesTmp);
+    } else {
+      hammingKnnMatch(m_hammingMatcher, queryDescriptors, false, knnMatchesTmp);
+    }
+    matches.resize(knnMatchesTmp.size());
+    std::transform(knnMatchesTmp.begin(), knnMatchesTmp.end(), matches.begin(), knnToDMatch);
   } else {
     matches.clear();
 
@@ -4260,8 +4576,10 @@ void vpKeyPoint::reset()
   m_filterType = ratioDistanceThreshold;
   m_imageFormat = jpgImageFormat;
   m_knnMatches.clear();
+  m_learningDatabase.close();
   m_mapOfImageId.clear();
   m_mapOfImages.clear();
+  m_encodedImages.clear();
   m_matcher = cv::Ptr<cv::DescriptorMatcher>();
   m_matcherName = "BruteForce-Hamming";
   m_matches.clear();
@@ -4293,6 +4611,8 @@ void vpKeyPoint::reset()
   m_useBruteForceCrossCheck = true;
 #endif
   m_useConsensusPercentage = false;
+  m_useHammingMatcher = false;
+  m_hammingMatcher.clear();
   m_useKnn = true; // as m_filterType == ratioDistanceThreshold
   m_useMatchTrainToQuery = false;
   m_useRansacVVS = true;
@@ -4322,6 +4642,8 @@ void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode,
   std::map<int, std::string> mapOfImgPath;
   if (saveTrainingImages) {
 #ifdef VISP_HAVE_MODULE_IO
+    decodeTrainingImages();
+
     // Save the training image files in the same directory
     unsigned int cpt = 0;
 
@@ -4634,6 +4956,116 @@ void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode,
   }
 }
 
+/*!
+   Save the learning data in a learning database, that loadLearningData()
+   memory maps instead of parsing it, so that the train descriptors are
+   available at once and shared between the processes that load the same file,
+   see vpKeyPointDatabase.
+
+   \param filename : Path of the learning database.
+   \param saveTrainingImages : If true, save also the training images in the
+   learning database, compressed by vpImageIo in the format chosen with
+   setImageFormat(), or in the PGM format without the visp_io module.
+
+   \warning On Windows, \e filename cannot be the learning database loaded by
+   loadLearningData(), that stays mapped, see vpKeyPointDatabase::save().
+ */
+void vpKeyPoint::saveLearningDatabase(const std::string &filename, bool saveTrainingImages)
+{
+  bool have3DInfo = m_trainPoints.size() > 0;
+  if (have3DInfo && m_trainPoints.size() != m_trainKeyPoints.size()) {
+    throw vpException(vpException::fatalError, "List of keypoints and list of 3D points have different size !");
+  }
+
+  std::string parent = vpIoTools::getParent(filename);
+  if (!parent.empty()) {
+    vpIoTools::makeDirectory(parent);
+  }
+
+  std::vector<vpKeyPointDatabase::vpKeyPointRecord> keyPoints(m_trainKeyPoints.size());
+  for (size_t i = 0; i < m_trainKeyPoints.size(); i++) {
+    const cv::KeyPoint &trainKeyPoint = m_trainKeyPoints[i];
+    vpKeyPointDatabase::vpKeyPointRecord &kp = keyPoints[i];
+    kp.x = trainKeyPoint.pt.x;
+    kp.y = trainKeyPoint.pt.y;
+    kp.size = trainKeyPoint.size;
+    kp.angle = trainKeyPoint.angle;
+    kp.response = trainKeyPoint.response;
+    kp.octave = trainKeyPoint.octave;
+    kp.classId = trainKeyPoint.class_id;
+    std::map<int, int>::const_iterator it_findImgId = m_mapOfImageId.find(trainKeyPoint.class_id);
+    kp.imageId = (saveTrainingImages && it_findImgId != m_mapOfImageId.end()) ? it_findImgId->second : -1;
+  }
+
+  std::vector<float> points3D;
+  points3D.reserve(3 * m_trainPoints.size());
+  for (size_t i = 0; i < m_trainPoints.size(); i++) {
+    points3D.push_back(m_trainPoints[i].x);
+    points3D.push_back(m_trainPoints[i].y);
+    points3D.push_back(m_trainPoints[i].z);
+  }
+
+  vpKeyPointDatabase::vpDescriptors descriptors;
+  descriptors.data = m_trainDescriptors.data;
+  descriptors.rows = static_cast<unsigned int>(m_trainDescriptors.rows);
+  descriptors.cols = static_cast<unsigned int>(m_trainDescriptors.cols);
+  descriptors.type = m_trainDescriptors.type();
+  descriptors.rowSize = m_trainDescriptors.cols * m_trainDescriptors.elemSize();
+  descriptors.stride = m_trainDescriptors.step[0];
+
+  std::vector<vpKeyPointDatabase::vpTrainingImage> images;
+  if (saveTrainingImages) {
+    images.resize(m_mapOfImages.size());
+    size_t cpt = 0;
+    for (std::map<int, vpImage<unsigned char> >::const_iterator it = m_mapOfImages.begin(); it != m_mapOfImages.end();
+         ++it, cpt++) {
+      vpKeyPointDatabase::vpTrainingImage &image = images[cpt];
+      image.imageId = it->first;
+      std::map<int, vpEncodedImage>::const_iterator it_encoded = m_encodedImages.find(it->first);
+      if (it_encoded != m_encodedImages.end()) {
+        // The image of a loaded learning database is saved as it is, without decoding it
+        size_t size = 0;
+        const unsigned char *data = it_encoded->second.database.getImageData(it_encoded->second.index, size);
+        image.format = it_encoded->second.database.getImageFormat(it_encoded->second.index);
+        image.data.assign(data, data + size);
+      } else {
+        encodeTrainingImage(it->second, m_imageFormat, filename, image);
+      }
+    }
+  }
+
+  vpKeyPointDatabase::save(filename, keyPoints, points3D, descriptors, images);
+}
+
+/*!
+  Match the binary descriptors (ORB, BRISK, FREAK, AKAZE...) with
+  vpHammingMatcher instead of the OpenCV matcher. The train descriptors,
+  including the ones of a learning file loaded with loadLearningData(), are
+  copied in this matcher, that searches the two nearest neighbors of all the
+  query descriptors at once, with the POPCNT or AVX2 instructions and several
+  threads, see getHammingMatcher(). The OpenCV matcher is still used for the
+  floating point descriptors (SIFT, SURF...).
+
+  \param useHammingMatcher : True to use the native matcher.
+*/
+void vpKeyPoint::setUseHammingMatcher(bool useHammingMatcher)
+{
+  m_useHammingMatcher = useHammingMatcher;
+  updateHammingMatcher();
+}
+
+/*!
+  Copy the train descriptors in the native matcher when it is used.
+*/
+void vpKeyPoint::updateHammingMatcher()
+{
+  m_hammingMatcher.clear();
+  if (m_useHammingMatcher && m_trainDescriptors.type() == CV_8UC1 && !m_trainDescriptors.empty()) {
+    m_hammingMatcher.add(m_trainDescriptors.ptr<unsigned char>(0), static_cast<unsigned int>(m_trainDescriptors.rows),
+                         static_cast<unsigned int>(m_trainDescriptors.cols), m_trainDescriptors.step[0]);
+  }
+}
+
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000)
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 // From OpenCV 2.4.11 source code.
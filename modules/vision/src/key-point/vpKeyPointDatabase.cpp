@@ -0,0 +1,609 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Memory mapped learning database of keypoints.
+ *
+ *****************************************************************************/
+
+#include <visp3/vision/vpKeyPointDatabase.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdint.h>
+#include <string.h>
+
+#include <visp3/core/vpEndian.h>
+#include <visp3/core/vpException.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <atomic>
+#endif
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VP_KEYPOINT_DATABASE_MMAP 1
+#elif defined(_WIN32) && !defined(WINRT)
+#include <windows.h>
+#define VP_KEYPOINT_DATABASE_MAP_VIEW 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/*
+  Layout of the file, all the values are little-endian and all the sections start on a 64 bytes boundary:
+  - header of 128 bytes, see the *_OFFSET constants,
+  - keypoints, 32 bytes vpKeyPointRecord per keypoint,
+  - 3D points, 3 floats per keypoint, if the FLAG_POINTS3D flag is set,
+  - descriptors, one row per keypoint,
+  - table of the training images, 32 bytes per image: id (int32), reserved (uint32), format (8 chars), offset and
+    size of the image file content (uint64),
+  - content of the image files.
+*/
+const char MAGIC[8] = {'V', 'i', 'S', 'P', 'K', 'P', 'D', 'B'};
+const uint32_t ENDIAN_TAG = 0x01020304;
+const size_t ALIGNMENT = 64;
+const size_t HEADER_SIZE = 128;
+const size_t KEYPOINT_SIZE = 32;
+const size_t IMAGE_ENTRY_SIZE = 32;
+const uint32_t FLAG_POINTS3D = 1;
+
+const size_t VERSION_OFFSET = 8;
+const size_t ENDIAN_TAG_OFFSET = 12;
+const size_t HEADER_SIZE_OFFSET = 16;
+const size_t NB_KEYPOINTS_OFFSET = 20;
+const size_t DESCRIPTOR_TYPE_OFFSET = 24;
+const size_t DESCRIPTOR_COLS_OFFSET = 28;
+const size_t DESCRIPTOR_ROW_SIZE_OFFSET = 32;
+const size_t DESCRIPTOR_STRIDE_OFFSET = 40;
+const size_t NB_IMAGES_OFFSET = 48;
+const size_t FLAGS_OFFSET = 52;
+const size_t KEYPOINTS_OFFSET = 56;
+const size_t POINTS3D_OFFSET = 64;
+const size_t DESCRIPTORS_OFFSET = 72;
+const size_t IMAGES_OFFSET = 80;
+const size_t FILE_SIZE_OFFSET = 88;
+
+template <typename T> void put(std::vector<unsigned char> &buffer, size_t offset, T value)
+{
+  memcpy(&buffer[offset], &value, sizeof(T));
+}
+
+template <typename T> T get(const unsigned char *data, size_t offset)
+{
+  T value;
+  memcpy(&value, data + offset, sizeof(T));
+  return value;
+}
+
+uint64_t align(uint64_t offset) { return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+
+void checkLittleEndian()
+{
+#if !defined(VISP_LITTLE_ENDIAN)
+  throw(vpException(vpException::notImplementedError,
+                    "The learning database can only be used in place on little-endian machines"));
+#endif
+}
+
+// Write zeros up to the offset of the next section
+void writePadding(std::ofstream &file, uint64_t &position, uint64_t offset)
+{
+  const char zeros[ALIGNMENT] = {0};
+  while (position < offset) {
+    const size_t n = static_cast<size_t>(std::min<uint64_t>(offset - position, ALIGNMENT));
+    file.write(zeros, static_cast<std::streamsize>(n));
+    position += n;
+  }
+}
+
+void writeData(std::ofstream &file, uint64_t &position, const void *data, size_t size)
+{
+  if (size > 0) {
+    file.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+    position += size;
+  }
+}
+} // namespace
+
+const unsigned int vpKeyPointDatabase::VERSION;
+
+struct vpKeyPointDatabase::vpMapping {
+  vpMapping()
+    : data(NULL), size(0), mapped(false), buffer(), refCount(1), version(0), nbImages(0), keyPoints(NULL),
+      points3D(NULL), descriptors(), images(NULL)
+  {
+  }
+
+  void map(const std::string &filename);
+  void parse();
+  void unmap();
+
+  //! Content of the file
+  const unsigned char *data;
+  size_t size;
+  //! True if the file is memory mapped, false if it is read in buffer
+  bool mapped;
+  std::vector<unsigned char> buffer;
+  //! Number of vpKeyPointDatabase that share the mapping
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  std::atomic<int> refCount;
+#else
+  int refCount;
+#endif
+
+  // Sections of the file
+  unsigned int version;
+  unsigned int nbImages;
+  const vpKeyPointRecord *keyPoints;
+  const float *points3D;
+  vpDescriptors descriptors;
+  const unsigned char *images;
+};
+
+void vpKeyPointDatabase::vpMapping::map(const std::string &filename)
+{
+#if defined(VP_KEYPOINT_DATABASE_MMAP)
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw(vpException(vpException::ioError, "Cannot open the learning database %s", filename.c_str()));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    throw(vpException(vpException::ioError, "Cannot read the size of the learning database %s", filename.c_str()));
+  }
+  // The pages are only read, they are shared with the other processes that map the file
+  void *addr = mmap(NULL, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    throw(vpException(vpException::ioError, "Cannot map the learning database %s", filename.c_str()));
+  }
+  data = static_cast<const unsigned char *>(addr);
+  size = static_cast<size_t>(st.st_size);
+  mapped = true;
+#elif defined(VP_KEYPOINT_DATABASE_MAP_VIEW)
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw(vpException(vpException::ioError, "Cannot open the learning database %s", filename.c_str()));
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+    CloseHandle(file);
+    throw(vpException(vpException::ioError, "Cannot read the size of the learning database %s", filename.c_str()));
+  }
+  // The view keeps the file and the mapping open
+  HANDLE fileMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(file);
+  void *addr = fileMapping != NULL ? MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+  if (fileMapping != NULL) {
+    CloseHandle(fileMapping);
+  }
+  if (addr == NULL) {
+    throw(vpException(vpException::ioError, "Cannot map the learning database %s", filename.c_str()));
+  }
+  data = static_cast<const unsigned char *>(addr);
+  size = static_cast<size_t>(fileSize.QuadPart);
+  mapped = true;
+#else
+  std::ifstream file(filename.c_str(), std::ifstream::binary);
+  if (!file.is_open()) {
+    throw(vpException(vpException::ioError, "Cannot open the learning database %s", filename.c_str()));
+  }
+  file.seekg(0, std::ios::end);
+  const std::streamoff fileSize = file.tellg();
+  file.seekg(0, std::ios::beg);
+  if (fileSize <= 0) {
+    throw(vpException(vpException::ioError, "Cannot read the size of the learning database %s", filename.c_str()));
+  }
+  buffer.resize(static_cast<size_t>(fileSize));
+  file.read(reinterpret_cast<char *>(&buffer[0]), fileSize);
+  if (!file) {
+    throw(vpException(vpException::ioError, "Cannot read the learning database %s", filename.c_str()));
+  }
+  data = &buffer[0];
+  size = buffer.size();
+  mapped = false;
+#endif
+}
+
+void vpKeyPointDatabase::vpMapping::parse()
+{
+  if (size < HEADER_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+    throw(vpException(vpException::badValue, "The file is not a learning database"));
+  }
+  version = get<uint32_t>(data, VERSION_OFFSET);
+  if (version == 0 || version > VERSION) {
+    throw(vpException(vpException::badValue, "The learning database version %u is not supported (version <= %u)",
+                      version, VERSION));
+  }
+  if (get<uint32_t>(data, ENDIAN_TAG_OFFSET) != ENDIAN_TAG) {
+    throw(vpException(vpException::badValue, "The learning database was written with another endianness"));
+  }
+  if (get<uint32_t>(data, HEADER_SIZE_OFFSET) < HEADER_SIZE || get<uint64_t>(data, FILE_SIZE_OFFSET) != size) {
+    throw(vpException(vpException::badValue, "The learning database is truncated or corrupted"));
+  }
+
+  const uint64_t nbKeyPoints = get<uint32_t>(data, NB_KEYPOINTS_OFFSET);
+  const uint32_t flags = get<uint32_t>(data, FLAGS_OFFSET);
+  descriptors.rows = static_cast<unsigned int>(nbKeyPoints);
+  descriptors.type = get<int32_t>(data, DESCRIPTOR_TYPE_OFFSET);
+  descriptors.cols = get<uint32_t>(data, DESCRIPTOR_COLS_OFFSET);
+  const uint64_t rowSize = get<uint64_t>(data, DESCRIPTOR_ROW_SIZE_OFFSET);
+  const uint64_t stride = get<uint64_t>(data, DESCRIPTOR_STRIDE_OFFSET);
+  nbImages = get<uint32_t>(data, NB_IMAGES_OFFSET);
+
+  // Offset and size in bytes of the sections, that must be aligned and inside the file
+  const uint64_t offsets[4] = {get<uint64_t>(data, KEYPOINTS_OFFSET), get<uint64_t>(data, POINTS3D_OFFSET),
+                               get<uint64_t>(data, DESCRIPTORS_OFFSET), get<uint64_t>(data, IMAGES_OFFSET)};
+  // The stride and the row size come from the file: check that the last row ends inside the file before computing
+  // the size of the descriptors, that could wrap around
+  const uint64_t available = offsets[2] < size ? size - offsets[2] : 0;
+  if (nbKeyPoints > 0 && (rowSize > stride || stride > available ||
+                          (stride > 0 && nbKeyPoints - 1 > (available - rowSize) / stride))) {
+    throw(vpException(vpException::badValue, "The learning database is truncated or corrupted"));
+  }
+  const uint64_t sizes[4] = {nbKeyPoints * KEYPOINT_SIZE, (flags & FLAG_POINTS3D) ? nbKeyPoints * 3 * sizeof(float) : 0,
+                             nbKeyPoints > 0 ? (nbKeyPoints - 1) * stride + rowSize : 0,
+                             static_cast<uint64_t>(nbImages) * IMAGE_ENTRY_SIZE};
+  for (int i = 0; i < 4; i++) {
+    if (sizes[i] > 0 && (offsets[i] % ALIGNMENT != 0 || offsets[i] > size || sizes[i] > size - offsets[i])) {
+      throw(vpException(vpException::badValue, "The learning database is truncated or corrupted"));
+    }
+  }
+  keyPoints = reinterpret_cast<const vpKeyPointRecord *>(data + offsets[0]);
+  points3D = (flags & FLAG_POINTS3D) ? reinterpret_cast<const float *>(data + offsets[1]) : NULL;
+  descriptors.data = data + offsets[2];
+  descriptors.rowSize = static_cast<size_t>(rowSize);
+  descriptors.stride = static_cast<size_t>(stride);
+  images = data + offsets[3];
+
+  for (unsigned int i = 0; i < nbImages; i++) {
+    const uint64_t offset = get<uint64_t>(images, i * IMAGE_ENTRY_SIZE + 16);
+    const uint64_t length = get<uint64_t>(images, i * IMAGE_ENTRY_SIZE + 24);
+    if (offset > size || length > size - offset) {
+      throw(vpException(vpException::badValue, "The learning database is truncated or corrupted"));
+    }
+  }
+}
+
+void vpKeyPointDatabase::vpMapping::unmap()
+{
+  if (mapped) {
+#if defined(VP_KEYPOINT_DATABASE_MMAP)
+    munmap(const_cast<unsigned char *>(data), size);
+#elif defined(VP_KEYPOINT_DATABASE_MAP_VIEW)
+    UnmapViewOfFile(data);
+#endif
+  }
+  data = NULL;
+  size = 0;
+  mapped = false;
+  std::vector<unsigned char>().swap(buffer);
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor, without open database.
+*/
+vpKeyPointDatabase::vpKeyPointDatabase() : m_mapping(NULL) {}
+
+/*!
+  Copy constructor, the copy shares the mapping of \e database.
+*/
+vpKeyPointDatabase::vpKeyPointDatabase(const vpKeyPointDatabase &database) : m_mapping(database.m_mapping)
+{
+  if (m_mapping != NULL) {
+    ++m_mapping->refCount;
+  }
+}
+
+/*!
+  Destructor, that releases the mapping if it is not shared with a copy.
+*/
+vpKeyPointDatabase::~vpKeyPointDatabase() { close(); }
+
+/*!
+  Close the database. The mapping is released when no copy uses it.
+*/
+void vpKeyPointDatabase::close()
+{
+  if (m_mapping != NULL && --m_mapping->refCount == 0) {
+    m_mapping->unmap();
+    delete m_mapping;
+  }
+  m_mapping = NULL;
+}
+
+/*!
+  Return the descriptors, stored in the mapped file. Empty if no database is open.
+*/
+vpKeyPointDatabase::vpDescriptors vpKeyPointDatabase::getDescriptors() const
+{
+  return m_mapping != NULL ? m_mapping->descriptors : vpDescriptors();
+}
+
+/*!
+  Return the content of the file of a training image, stored in the mapped file.
+
+  \param index : Index of the image, lower than getNbImages().
+  \param size : Size in bytes of the content.
+*/
+const unsigned char *vpKeyPointDatabase::getImageData(unsigned int index, size_t &size) const
+{
+  if (index >= getNbImages()) {
+    throw(vpException(vpException::badValue, "The training image %u does not exist", index));
+  }
+  const unsigned char *entry = m_mapping->images + index * IMAGE_ENTRY_SIZE;
+  size = static_cast<size_t>(get<uint64_t>(entry, 24));
+  return m_mapping->data + get<uint64_t>(entry, 16);
+}
+
+/*!
+  Return the extension of the format of a training image, like "png".
+
+  \param index : Index of the image, lower than getNbImages().
+*/
+std::string vpKeyPointDatabase::getImageFormat(unsigned int index) const
+{
+  if (index >= getNbImages()) {
+    throw(vpException(vpException::badValue, "The training image %u does not exist", index));
+  }
+  const char *format = reinterpret_cast<const char *>(m_mapping->images + index * IMAGE_ENTRY_SIZE + 8);
+  return std::string(format, strnlen(format, 8));
+}
+
+/*!
+  Return the id of a training image, referenced by vpKeyPointRecord::imageId.
+
+  \param index : Index of the image, lower than getNbImages().
+*/
+int vpKeyPointDatabase::getImageId(unsigned int index) const
+{
+  if (index >= getNbImages()) {
+    throw(vpException(vpException::badValue, "The training image %u does not exist", index));
+  }
+  return get<int32_t>(m_mapping->images, index * IMAGE_ENTRY_SIZE);
+}
+
+/*!
+  Return the getNbKeyPoints() keypoints, stored in the mapped file.
+*/
+const vpKeyPointDatabase::vpKeyPointRecord *vpKeyPointDatabase::getKeyPoints() const
+{
+  return m_mapping != NULL ? m_mapping->keyPoints : NULL;
+}
+
+/*!
+  Return the number of training images.
+*/
+unsigned int vpKeyPointDatabase::getNbImages() const { return m_mapping != NULL ? m_mapping->nbImages : 0; }
+
+/*!
+  Return the number of keypoints, which is also the number of descriptors.
+*/
+unsigned int vpKeyPointDatabase::getNbKeyPoints() const
+{
+  return m_mapping != NULL ? m_mapping->descriptors.rows : 0;
+}
+
+/*!
+  Return the 3D coordinates (X, Y, Z) of the keypoints, stored in the mapped file, or NULL if they were not
+  saved.
+*/
+const float *vpKeyPointDatabase::getPoints3D() const { return m_mapping != NULL ? m_mapping->points3D : NULL; }
+
+/*!
+  Return the version of the format of the open file, 0 if no database is open.
+*/
+unsigned int vpKeyPointDatabase::getVersion() const { return m_mapping != NULL ? m_mapping->version : 0; }
+
+/*!
+  Return true if \e filename starts with the signature of a learning database.
+*/
+bool vpKeyPointDatabase::isDatabaseFile(const std::string &filename)
+{
+  std::ifstream file(filename.c_str(), std::ifstream::binary);
+  char magic[sizeof(MAGIC)];
+  return file.read(magic, sizeof(magic)) && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+/*!
+  Return true if the open database is memory mapped, false if it was read in memory because the platform does not
+  support memory mapping.
+*/
+bool vpKeyPointDatabase::isMemoryMapped() const { return m_mapping != NULL && m_mapping->mapped; }
+
+/*!
+  Map a learning database written by save() and check its header. The previous database is closed.
+
+  \param filename : Path of the file.
+*/
+void vpKeyPointDatabase::open(const std::string &filename)
+{
+  checkLittleEndian();
+  close();
+
+  vpMapping *mapping = new vpMapping;
+  try {
+    mapping->map(filename);
+    mapping->parse();
+  } catch (...) {
+    mapping->unmap();
+    delete mapping;
+    throw;
+  }
+  m_mapping = mapping;
+}
+
+/*!
+  Share the mapping of \e database.
+*/
+vpKeyPointDatabase &vpKeyPointDatabase::operator=(const vpKeyPointDatabase &database)
+{
+  if (m_mapping != database.m_mapping) {
+    close();
+    m_mapping = database.m_mapping;
+    if (m_mapping != NULL) {
+      ++m_mapping->refCount;
+    }
+  }
+  return *this;
+}
+
+/*!
+  Write a learning database. The file is first written next to \e filename, then renamed, so that the processes
+  that map the previous file keep a valid content.
+
+  \warning On Windows, a file cannot be replaced while it is mapped: save() throws an exception if \e filename is
+  opened by a vpKeyPointDatabase, in this process or another one, and the previous file is kept.
+
+  \param filename : Path of the file.
+  \param keyPoints : Keypoints.
+  \param points3D : 3D coordinates (X, Y, Z) of the keypoints, or an empty vector.
+  \param descriptors : Descriptors of the keypoints, one per keypoint.
+  \param images : Encoded training images, referenced by vpKeyPointRecord::imageId.
+*/
+void vpKeyPointDatabase::save(const std::string &filename, const std::vector<vpKeyPointRecord> &keyPoints,
+                              const std::vector<float> &points3D, const vpDescriptors &descriptors,
+                              const std::vector<vpTrainingImage> &images)
+{
+  checkLittleEndian();
+  const uint64_t nbKeyPoints = keyPoints.size();
+  if (descriptors.rows != nbKeyPoints || (!points3D.empty() && points3D.size() != 3 * nbKeyPoints)) {
+    throw(vpException(vpException::dimensionError, "The keypoints, 3D points and descriptors have different sizes"));
+  }
+  if (nbKeyPoints > 0 && (descriptors.data == NULL || descriptors.rowSize > descriptors.stride)) {
+    throw(vpException(vpException::badValue, "Invalid descriptors"));
+  }
+  for (size_t i = 0; i < images.size(); i++) {
+    if (images[i].format.size() > 7) {
+      throw(vpException(vpException::badValue, "The image format %s is too long", images[i].format.c_str()));
+    }
+  }
+
+  // Layout of the file, the descriptors are stored contiguously
+  const uint64_t keyPointsOffset = HEADER_SIZE;
+  const uint64_t points3DOffset = align(keyPointsOffset + nbKeyPoints * KEYPOINT_SIZE);
+  const uint64_t descriptorsOffset = align(points3DOffset + points3D.size() * sizeof(float));
+  const uint64_t imagesOffset = align(descriptorsOffset + nbKeyPoints * descriptors.rowSize);
+  std::vector<uint64_t> imageOffsets(images.size());
+  uint64_t fileSize = align(imagesOffset + images.size() * IMAGE_ENTRY_SIZE);
+  for (size_t i = 0; i < images.size(); i++) {
+    imageOffsets[i] = fileSize;
+    fileSize = align(fileSize + images[i].data.size());
+  }
+
+  std::vector<unsigned char> header(HEADER_SIZE, 0);
+  memcpy(&header[0], MAGIC, sizeof(MAGIC));
+  put<uint32_t>(header, VERSION_OFFSET, VERSION);
+  put<uint32_t>(header, ENDIAN_TAG_OFFSET, ENDIAN_TAG);
+  put<uint32_t>(header, HEADER_SIZE_OFFSET, static_cast<uint32_t>(HEADER_SIZE));
+  put<uint32_t>(header, NB_KEYPOINTS_OFFSET, static_cast<uint32_t>(nbKeyPoints));
+  put<int32_t>(header, DESCRIPTOR_TYPE_OFFSET, descriptors.type);
+  put<uint32_t>(header, DESCRIPTOR_COLS_OFFSET, descriptors.cols);
+  put<uint64_t>(header, DESCRIPTOR_ROW_SIZE_OFFSET, descriptors.rowSize);
+  put<uint64_t>(header, DESCRIPTOR_STRIDE_OFFSET, descriptors.rowSize);
+  put<uint32_t>(header, NB_IMAGES_OFFSET, static_cast<uint32_t>(images.size()));
+  put<uint32_t>(header, FLAGS_OFFSET, points3D.empty() ? 0 : FLAG_POINTS3D);
+  put<uint64_t>(header, KEYPOINTS_OFFSET, keyPointsOffset);
+  put<uint64_t>(header, POINTS3D_OFFSET, points3D.empty() ? 0 : points3DOffset);
+  put<uint64_t>(header, DESCRIPTORS_OFFSET, descriptorsOffset);
+  put<uint64_t>(header, IMAGES_OFFSET, imagesOffset);
+  put<uint64_t>(header, FILE_SIZE_OFFSET, fileSize);
+
+  const std::string tmpFilename = filename + ".tmp";
+  std::ofstream file(tmpFilename.c_str(), std::ofstream::binary);
+  if (!file.is_open()) {
+    throw(vpException(vpException::ioError, "Cannot create the learning database %s", tmpFilename.c_str()));
+  }
+
+  try {
+    uint64_t position = 0;
+    writeData(file, position, &header[0], header.size());
+    if (nbKeyPoints > 0) {
+      writeData(file, position, &keyPoints[0], keyPoints.size() * KEYPOINT_SIZE);
+    }
+    writePadding(file, position, points3DOffset);
+    if (!points3D.empty()) {
+      writeData(file, position, &points3D[0], points3D.size() * sizeof(float));
+    }
+    writePadding(file, position, descriptorsOffset);
+    for (uint64_t i = 0; i < nbKeyPoints; i++) {
+      writeData(file, position, descriptors.data + i * descriptors.stride, descriptors.rowSize);
+    }
+    writePadding(file, position, imagesOffset);
+    for (size_t i = 0; i < images.size(); i++) {
+      std::vector<unsigned char> entry(IMAGE_ENTRY_SIZE, 0);
+      put<int32_t>(entry, 0, images[i].imageId);
+      memcpy(&entry[8], images[i].format.c_str(), images[i].format.size());
+      put<uint64_t>(entry, 16, imageOffsets[i]);
+      put<uint64_t>(entry, 24, images[i].data.size());
+      writeData(file, position, &entry[0], entry.size());
+    }
+    for (size_t i = 0; i < images.size(); i++) {
+      writePadding(file, position, imageOffsets[i]);
+      if (!images[i].data.empty()) {
+        writeData(file, position, &images[i].data[0], images[i].data.size());
+      }
+    }
+    writePadding(file, position, fileSize);
+
+    file.close();
+    if (!file) {
+      throw(vpException(vpException::ioError, "Cannot write the learning database %s", tmpFilename.c_str()));
+    }
+  } catch (...) {
+    // Do not leave a partial file
+    file.close();
+    std::remove(tmpFilename.c_str());
+    throw;
+  }
+
+#if defined(VP_KEYPOINT_DATABASE_MAP_VIEW)
+  // std::rename() does not replace an existing file on Windows
+  const bool renamed = MoveFileExA(tmpFilename.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+#if defined(_WIN32)
+  std::remove(filename.c_str());
+#endif
+  const bool renamed = std::rename(tmpFilename.c_str(), filename.c_str()) == 0;
+#endif
+  if (!renamed) {
+    std::remove(tmpFilename.c_str());
+    throw(vpException(vpException::ioError, "Cannot write the learning database %s", filename.c_str()));
+  }
+}
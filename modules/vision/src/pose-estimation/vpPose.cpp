@@ -84,6 +84,8 @@ void vpPose::init()
   listOfPoints.clear();
   useParallelRansac = false;
   nbParallelRansacThreads = 0;
+  ransacProbability = 0;
+  ransacMinimalSolver = RANSAC_LAGRANGE_DEMENTHON;
   vvsEpsilon = 1e-8;
 
 #if (DEBUG_LEVEL1)
@@ -99,7 +101,7 @@ vpPose::vpPose()
     distanceToPlaneForCoplanarityTest(0.001), ransacFlag(vpPose::NO_FILTER), listOfPoints(),
     useParallelRansac(false),
     nbParallelRansacThreads(0), // 0 means that we use C++11 (if available) to get the number of threads
-    vvsEpsilon(1e-8)
+    ransacProbability(0), ransacMinimalSolver(vpPose::RANSAC_LAGRANGE_DEMENTHON), vvsEpsilon(1e-8)
 {
 }
 
@@ -109,7 +111,7 @@ vpPose::vpPose(const std::vector<vpPoint>& lP)
     ransacInlierIndex(), ransacThreshold(0.0001), distanceToPlaneForCoplanarityTest(0.001), ransacFlag(vpPose::NO_FILTER),
     listOfPoints(lP), useParallelRansac(false),
     nbParallelRansacThreads(0), // 0 means that we use C++11 (if available) to get the number of threads
-    vvsEpsilon(1e-8)
+    ransacProbability(0), ransacMinimalSolver(vpPose::RANSAC_LAGRANGE_DEMENTHON), vvsEpsilon(1e-8)
 {
 }
 
@@ -369,11 +371,19 @@ double vpPose::computeResidual(const vpHomogeneousMatrix &cMo) const
   - vpPose::LAGRANGE_VIRTUAL_VS: Non linear virtual visual servoing approach
   initialized by Lagrange approach
   - vpPose::RANSAC: Robust Ransac aproach (doesn't need an initialization)
-
+  - vpPose::P3P: Closed-form solution from the three first points, the other
+  points selecting among the solutions (doesn't need an initialization). It is
+  the only method that accepts 3 points: up to four poses then fit the points
+  exactly, and the returned one is arbitrary among them.
+  - vpPose::EPNP: Linear EPnP approach (doesn't need an initialization)
+
+  \exception vpPoseException::notEnoughPointError : If there are less than 4
+  points, or less than 3 points with vpPose::P3P.
 */
 bool vpPose::computePose(vpPoseMethodType method, vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneousMatrix &))
 {
-  if (npt < 4) {
+  const unsigned int minNbPoints = (method == P3P) ? 3 : 4;
+  if (npt < minNbPoints) {
     throw(vpPoseException(vpPoseException::notEnoughPointError,
                           "Not enough point (%d) to compute the pose  ", npt));
   }
@@ -439,6 +449,12 @@ bool vpPose::computePose(vpPoseMethodType method, vpHomogeneousMatrix &cMo, bool
     }
       return poseRansac(cMo, func);
     break;
+  case P3P:
+    poseP3P(cMo);
+    break;
+  case EPNP:
+    poseEPnP(cMo);
+    break;
   case LOWE:
   case VIRTUAL_VS:
     break;
@@ -448,6 +464,8 @@ bool vpPose::computePose(vpPoseMethodType method, vpHomogeneousMatrix &cMo, bool
   case LAGRANGE:
   case DEMENTHON:
   case RANSAC:
+  case P3P:
+  case EPNP:
     break;
   case VIRTUAL_VS:
   case LAGRANGE_VIRTUAL_VS:
@@ -0,0 +1,523 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Pose computation with the EPnP method.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpPoseEPnP.cpp
+  \brief Pose computation from n points with the EPnP method.
+*/
+
+#include <algorithm> // std::max
+#include <float.h>   // DBL_MAX
+#include <vector>
+
+#include <visp3/vision/vpPose.h>
+#include <visp3/vision/vpPoseException.h>
+
+#include "vpPoseSolvers_impl.h"
+
+namespace
+{
+// Solve the m x m system A x = b (m <= 6) by Gaussian elimination with partial pivoting. A and b are destroyed.
+bool solveLinear(double A[6][6], double b[6], int m, double x[6])
+{
+  for (int k = 0; k < m; k++) {
+    int pivot = k;
+    for (int i = k + 1; i < m; i++) {
+      if (std::fabs(A[i][k]) > std::fabs(A[pivot][k])) {
+        pivot = i;
+      }
+    }
+    if (std::fabs(A[pivot][k]) < 1e-300) {
+      return false;
+    }
+    if (pivot != k) {
+      for (int j = 0; j < m; j++) {
+        const double tmp = A[k][j];
+        A[k][j] = A[pivot][j];
+        A[pivot][j] = tmp;
+      }
+      const double tmp = b[k];
+      b[k] = b[pivot];
+      b[pivot] = tmp;
+    }
+    for (int i = k + 1; i < m; i++) {
+      const double f = A[i][k] / A[k][k];
+      for (int j = k; j < m; j++) {
+        A[i][j] -= f * A[k][j];
+      }
+      b[i] -= f * b[k];
+    }
+  }
+  for (int i = m - 1; i >= 0; i--) {
+    double s = b[i];
+    for (int j = i + 1; j < m; j++) {
+      s -= A[i][j] * x[j];
+    }
+    x[i] = s / A[i][i];
+  }
+  return true;
+}
+
+// Points given as contiguous arrays, optionally indexed
+struct EPnPPoints {
+  EPnPPoints(const double *oX_, const double *oY_, const double *oZ_, const double *x_, const double *y_,
+             const unsigned int *index_, unsigned int n_)
+    : oX(oX_), oY(oY_), oZ(oZ_), x(x_), y(y_), index(index_), n(n_)
+  {
+  }
+
+  unsigned int operator[](unsigned int i) const { return index ? index[i] : i; }
+
+  const double *oX, *oY, *oZ, *x, *y;
+  const unsigned int *index;
+  unsigned int n;
+};
+
+/*
+  EPnP with NC control points: 4 in the general case, 3 when the points are planar. The control points are the
+  centroid of the points and the centroid moved along their principal axes, so that the barycentric coordinates are
+  projections on these axes.
+*/
+template <int NC> class EPnPSolver
+{
+public:
+  EPnPSolver(const EPnPPoints &pts, const double centroid[3], const double axes[3][3], const double scales[3])
+    : m_pts(pts)
+  {
+    for (int j = 0; j < 3; j++) {
+      m_c0[j] = centroid[j];
+      m_cw[0][j] = centroid[j];
+    }
+    for (int k = 1; k < NC; k++) {
+      m_scale[k] = scales[k - 1];
+      for (int j = 0; j < 3; j++) {
+        m_axis[k][j] = axes[k - 1][j];
+        m_cw[k][j] = centroid[j] + scales[k - 1] * axes[k - 1][j];
+      }
+    }
+  }
+
+  bool compute(double cMo[3][4]);
+
+private:
+  void alphas(unsigned int i, double a[NC]) const;
+  void linearizedBetas(int N, double betas[NC]) const;
+  void refineBetas(double betas[NC]) const;
+  double computePose(const double betas[NC], double cMo[3][4]) const;
+
+  static const int NP = NC * (NC - 1) / 2;
+
+  const EPnPPoints &m_pts;
+  double m_c0[3];
+  double m_cw[NC][3];
+  double m_axis[NC][3];
+  double m_scale[NC];
+  //! Null space of M, the coordinates of the control points in the camera frame are a combination of its vectors
+  double m_v[NC][3 * NC];
+  //! Squared distance between each pair of control points in the object frame
+  double m_rho[NP];
+  //! Dot products of the differences of control points of the null space vectors, for each pair
+  double m_D[NP][NC][NC];
+};
+
+template <int NC> void EPnPSolver<NC>::alphas(unsigned int i, double a[NC]) const
+{
+  const unsigned int k = m_pts[i];
+  const double d[3] = {m_pts.oX[k] - m_c0[0], m_pts.oY[k] - m_c0[1], m_pts.oZ[k] - m_c0[2]};
+  a[0] = 1.0;
+  for (int j = 1; j < NC; j++) {
+    a[j] = (d[0] * m_axis[j][0] + d[1] * m_axis[j][1] + d[2] * m_axis[j][2]) / m_scale[j];
+    a[0] -= a[j];
+  }
+}
+
+// Initial betas of a null space of dimension N, from the linearized distance constraints
+template <int NC> void EPnPSolver<NC>::linearizedBetas(int N, double betas[NC]) const
+{
+  // Unknowns are the products betas[a] * betas[b] for a <= b < N. When there are more products than constraints, only
+  // the products betas[0] * betas[b] are kept, as in the original EPnP
+  const bool allProducts = N * (N + 1) / 2 <= NP;
+  int ia[6], ib[6], m = 0;
+  for (int a = 0; a < (allProducts ? N : 1); a++) {
+    for (int b = a; b < N; b++) {
+      ia[m] = a;
+      ib[m] = b;
+      m++;
+    }
+  }
+
+  double LtL[6][6], Ltr[6], prod[6];
+  for (int u = 0; u < m; u++) {
+    Ltr[u] = 0;
+    for (int v = 0; v < m; v++) {
+      LtL[u][v] = 0;
+    }
+  }
+  for (int k = 0; k < NP; k++) {
+    double L[6];
+    for (int u = 0; u < m; u++) {
+      L[u] = (ia[u] == ib[u] ? 1.0 : 2.0) * m_D[k][ia[u]][ib[u]];
+    }
+    for (int u = 0; u < m; u++) {
+      Ltr[u] += L[u] * m_rho[k];
+      for (int v = 0; v < m; v++) {
+        LtL[u][v] += L[u] * L[v];
+      }
+    }
+  }
+
+  for (int a = 0; a < NC; a++) {
+    betas[a] = 0;
+  }
+  if (!solveLinear(LtL, Ltr, m, prod)) {
+    return;
+  }
+
+  // prod[0] is betas[0]^2, the global sign of the solution is fixed later
+  const double sign = prod[0] < 0 ? -1.0 : 1.0;
+  betas[0] = std::sqrt(sign * prod[0]);
+  for (int b = 1; b < N; b++) {
+    // prod[b] is betas[0] * betas[b]
+    betas[b] = betas[0] > 0 ? sign * prod[b] / betas[0] : 0.0;
+  }
+}
+
+// Gauss-Newton minimization of the errors on the distances between the control points
+template <int NC> void EPnPSolver<NC>::refineBetas(double betas[NC]) const
+{
+  for (int iter = 0; iter < 10; iter++) {
+    double JtJ[6][6], Jtr[6], delta[6];
+    for (int a = 0; a < NC; a++) {
+      Jtr[a] = 0;
+      for (int b = 0; b < NC; b++) {
+        JtJ[a][b] = 0;
+      }
+    }
+
+    double cost = 0;
+    for (int k = 0; k < NP; k++) {
+      double J[NC], r = -m_rho[k];
+      for (int a = 0; a < NC; a++) {
+        double Db = 0;
+        for (int b = 0; b < NC; b++) {
+          Db += m_D[k][a][b] * betas[b];
+        }
+        r += betas[a] * Db;
+        J[a] = 2.0 * Db;
+      }
+      cost += r * r;
+      for (int a = 0; a < NC; a++) {
+        Jtr[a] -= J[a] * r;
+        for (int b = 0; b < NC; b++) {
+          JtJ[a][b] += J[a] * J[b];
+        }
+      }
+    }
+
+    if (cost < 1e-30 || !solveLinear(JtJ, Jtr, NC, delta)) {
+      break;
+    }
+    for (int a = 0; a < NC; a++) {
+      betas[a] += delta[a];
+    }
+  }
+}
+
+// Pose from the coordinates of the control points in the camera frame, return the sum of the squared reprojection
+// errors
+template <int NC> double EPnPSolver<NC>::computePose(const double betas[NC], double cMo[3][4]) const
+{
+  double cc[NC][3];
+  for (int j = 0; j < NC; j++) {
+    for (int c = 0; c < 3; c++) {
+      cc[j][c] = 0;
+      for (int a = 0; a < NC; a++) {
+        cc[j][c] += betas[a] * m_v[a][3 * j + c];
+      }
+    }
+  }
+
+  // The centroid of the points is the first control point, it must be in front of the camera
+  if (cc[0][2] < 0) {
+    for (int j = 0; j < NC; j++) {
+      for (int c = 0; c < 3; c++) {
+        cc[j][c] = -cc[j][c];
+      }
+    }
+  }
+
+  // Since the barycentric coordinates are orthogonal projections, the absolute orientation of the points is the one
+  // of the control points: Horn's quaternion method on the control points centered on the first one
+  double S[3][3];
+  for (int r = 0; r < 3; r++) {
+    for (int c = 0; c < 3; c++) {
+      S[r][c] = 0;
+      for (int j = 1; j < NC; j++) {
+        S[r][c] += (m_cw[j][r] - m_cw[0][r]) * (cc[j][c] - cc[0][c]);
+      }
+    }
+  }
+  double N[4][4] = {{S[0][0] + S[1][1] + S[2][2], S[1][2] - S[2][1], S[2][0] - S[0][2], S[0][1] - S[1][0]},
+                    {S[1][2] - S[2][1], S[0][0] - S[1][1] - S[2][2], S[0][1] + S[1][0], S[2][0] + S[0][2]},
+                    {S[2][0] - S[0][2], S[0][1] + S[1][0], -S[0][0] + S[1][1] - S[2][2], S[1][2] + S[2][1]},
+                    {S[0][1] - S[1][0], S[2][0] + S[0][2], S[1][2] + S[2][1], -S[0][0] - S[1][1] + S[2][2]}};
+  double w[4], V[4][4];
+  vp_pose_sym_eigen_impl<4>(N, w, V);
+  const double q0 = V[0][3], qx = V[1][3], qy = V[2][3], qz = V[3][3];
+
+  cMo[0][0] = q0 * q0 + qx * qx - qy * qy - qz * qz;
+  cMo[0][1] = 2.0 * (qx * qy - q0 * qz);
+  cMo[0][2] = 2.0 * (qx * qz + q0 * qy);
+  cMo[1][0] = 2.0 * (qy * qx + q0 * qz);
+  cMo[1][1] = q0 * q0 - qx * qx + qy * qy - qz * qz;
+  cMo[1][2] = 2.0 * (qy * qz - q0 * qx);
+  cMo[2][0] = 2.0 * (qz * qx - q0 * qy);
+  cMo[2][1] = 2.0 * (qz * qy + q0 * qx);
+  cMo[2][2] = q0 * q0 - qx * qx - qy * qy + qz * qz;
+  for (int r = 0; r < 3; r++) {
+    cMo[r][3] = cc[0][r] - (cMo[r][0] * m_cw[0][0] + cMo[r][1] * m_cw[0][1] + cMo[r][2] * m_cw[0][2]);
+  }
+
+  double error = 0;
+  for (unsigned int i = 0; i < m_pts.n; i++) {
+    const unsigned int k = m_pts[i];
+    const double X = cMo[0][0] * m_pts.oX[k] + cMo[0][1] * m_pts.oY[k] + cMo[0][2] * m_pts.oZ[k] + cMo[0][3];
+    const double Y = cMo[1][0] * m_pts.oX[k] + cMo[1][1] * m_pts.oY[k] + cMo[1][2] * m_pts.oZ[k] + cMo[1][3];
+    const double Z = cMo[2][0] * m_pts.oX[k] + cMo[2][1] * m_pts.oY[k] + cMo[2][2] * m_pts.oZ[k] + cMo[2][3];
+    const double dx = X / Z - m_pts.x[k];
+    const double dy = Y / Z - m_pts.y[k];
+    error += dx * dx + dy * dy;
+  }
+  return error;
+}
+
+template <int NC> bool EPnPSolver<NC>::compute(double cMo[3][4])
+{
+  // M^T M, with two rows of M per point: (a_j, 0, -a_j x) and (0, a_j, -a_j y) for each control point j. The 3x3 block
+  // (j, k) is the sum of a_j a_k [1 0 -x; 0 1 -y; -x -y x^2+y^2], so that only 4 sums are needed per pair
+  double Sw[NC][NC], Sx[NC][NC], Sy[NC][NC], Sr[NC][NC];
+  for (int j = 0; j < NC; j++) {
+    for (int k = 0; k < NC; k++) {
+      Sw[j][k] = Sx[j][k] = Sy[j][k] = Sr[j][k] = 0;
+    }
+  }
+  for (unsigned int i = 0; i < m_pts.n; i++) {
+    double a[NC];
+    alphas(i, a);
+    const unsigned int idx = m_pts[i];
+    const double x = m_pts.x[idx], y = m_pts.y[idx], r = x * x + y * y;
+    for (int j = 0; j < NC; j++) {
+      for (int k = j; k < NC; k++) {
+        const double w = a[j] * a[k];
+        Sw[j][k] += w;
+        Sx[j][k] += w * x;
+        Sy[j][k] += w * y;
+        Sr[j][k] += w * r;
+      }
+    }
+  }
+
+  double MtM[3 * NC][3 * NC];
+  for (int j = 0; j < NC; j++) {
+    for (int k = j; k < NC; k++) {
+      const double B[3][3] = {{Sw[j][k], 0.0, -Sx[j][k]}, {0.0, Sw[j][k], -Sy[j][k]}, {-Sx[j][k], -Sy[j][k], Sr[j][k]}};
+      for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) {
+          MtM[3 * j + r][3 * k + c] = B[r][c];
+          MtM[3 * k + c][3 * j + r] = B[r][c];
+        }
+      }
+    }
+  }
+
+  double w[3 * NC], V[3 * NC][3 * NC];
+  vp_pose_sym_eigen_impl<3 * NC>(MtM, w, V);
+  for (int a = 0; a < NC; a++) {
+    for (int r = 0; r < 3 * NC; r++) {
+      m_v[a][r] = V[r][a];
+    }
+  }
+
+  int k = 0;
+  for (int i = 0; i < NC; i++) {
+    for (int j = i + 1; j < NC; j++, k++) {
+      m_rho[k] = 0;
+      for (int c = 0; c < 3; c++) {
+        m_rho[k] += (m_cw[i][c] - m_cw[j][c]) * (m_cw[i][c] - m_cw[j][c]);
+      }
+      for (int a = 0; a < NC; a++) {
+        for (int b = 0; b < NC; b++) {
+          m_D[k][a][b] = 0;
+          for (int c = 0; c < 3; c++) {
+            m_D[k][a][b] += (m_v[a][3 * i + c] - m_v[a][3 * j + c]) * (m_v[b][3 * i + c] - m_v[b][3 * j + c]);
+          }
+        }
+      }
+    }
+  }
+
+  // Null space of dimension N = 1, ..., NC
+  double bestError = DBL_MAX;
+  for (int N = 1; N <= NC; N++) {
+    double betas[NC], pose[3][4];
+    linearizedBetas(N, betas);
+    refineBetas(betas);
+    const double error = computePose(betas, pose);
+    if (error < bestError) {
+      bestError = error;
+      for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 4; c++) {
+          cMo[r][c] = pose[r][c];
+        }
+      }
+    }
+  }
+
+  return bestError < DBL_MAX;
+}
+} // namespace
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+bool vp_pose_epnp_impl(const double *oX, const double *oY, const double *oZ, const double *x, const double *y,
+                       const unsigned int *index, unsigned int n, bool planar, double cMo[3][4])
+{
+  const EPnPPoints pts(oX, oY, oZ, x, y, index, n);
+  if (n < 4) {
+    return false;
+  }
+
+  // Principal axes of the points
+  double centroid[3] = {0, 0, 0};
+  for (unsigned int i = 0; i < n; i++) {
+    const unsigned int k = pts[i];
+    centroid[0] += oX[k];
+    centroid[1] += oY[k];
+    centroid[2] += oZ[k];
+  }
+  for (int c = 0; c < 3; c++) {
+    centroid[c] /= n;
+  }
+
+  double C[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+  for (unsigned int i = 0; i < n; i++) {
+    const unsigned int k = pts[i];
+    const double d[3] = {oX[k] - centroid[0], oY[k] - centroid[1], oZ[k] - centroid[2]};
+    for (int r = 0; r < 3; r++) {
+      for (int c = 0; c < 3; c++) {
+        C[r][c] += d[r] * d[c];
+      }
+    }
+  }
+  double lambda[3], E[3][3];
+  vp_pose_sym_eigen_impl<3>(C, lambda, E);
+
+  // Axes sorted by decreasing variance
+  double axes[3][3], scales[3];
+  for (int a = 0; a < 3; a++) {
+    scales[a] = std::sqrt((std::max)(lambda[2 - a], 0.0) / n);
+    for (int c = 0; c < 3; c++) {
+      axes[a][c] = E[c][2 - a];
+    }
+  }
+
+  if (planar) {
+    if (scales[1] <= 1e-12 * scales[0]) {
+      return false;
+    }
+    EPnPSolver<3> solver(pts, centroid, axes, scales);
+    return solver.compute(cMo);
+  }
+
+  if (scales[2] <= 1e-12 * scales[0]) {
+    return false;
+  }
+  EPnPSolver<4> solver(pts, centroid, axes, scales);
+  return solver.compute(cMo);
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Compute the pose with the EPnP method \cite Lepetit09: the points are
+  expressed as weighted sums of 4 control points, or 3 control points when the
+  points are coplanar (see coplanar()), whose coordinates in the camera frame
+  are found in the null space of a 12x12 (or 9x9) matrix. The cost of the
+  method is linear in the number of points.
+
+  \warning With only 4 non coplanar points, the null space has dimension 4
+  and the solution may be a local minimum. In that case, prefer the P3P
+  method.
+
+  \param cMo : Computed pose.
+
+  \exception vpPoseException::notEnoughPointError : If there are less than 4
+  points or if the points are collinear.
+*/
+void vpPose::poseEPnP(vpHomogeneousMatrix &cMo)
+{
+  const unsigned int n = static_cast<unsigned int>(listP.size());
+  if (n < 4) {
+    throw(vpPoseException(vpPoseException::notEnoughPointError,
+                          "EPnP method requires at least 4 points. Not enough point (%d) to compute the pose", n));
+  }
+
+  std::vector<double> oX(n), oY(n), oZ(n), x(n), y(n);
+  unsigned int i = 0;
+  for (std::list<vpPoint>::const_iterator it = listP.begin(); it != listP.end(); ++it, i++) {
+    oX[i] = it->get_oX();
+    oY[i] = it->get_oY();
+    oZ[i] = it->get_oZ();
+    x[i] = it->get_x();
+    y[i] = it->get_y();
+  }
+
+  int coplanar_plane_type = 0;
+  const bool plan = coplanar(coplanar_plane_type);
+  if (plan && coplanar_plane_type == 4) {
+    throw(vpPoseException(vpPoseException::notEnoughPointError,
+                          "EPnP method cannot be used in that case (points are collinear)"));
+  }
+
+  double pose[3][4];
+  if (!vp_pose_epnp_impl(&oX[0], &oY[0], &oZ[0], &x[0], &y[0], NULL, n, plan, pose)) {
+    throw(vpPoseException(vpPoseException::notEnoughPointError,
+                          "EPnP method cannot be used in that case (degenerate points)"));
+  }
+
+  for (unsigned int r = 0; r < 3; r++) {
+    for (unsigned int c = 0; c < 4; c++) {
+      cMo[r][c] = pose[r][c];
+    }
+  }
+}
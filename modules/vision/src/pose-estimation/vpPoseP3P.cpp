@@ -0,0 +1,378 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Pose computation from 3 points.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpPoseP3P.cpp
+  \brief Closed-form pose computation from 3 points.
+*/
+
+#include <float.h> // DBL_MAX
+#include <limits>  // numeric_limits
+
+#include <visp3/core/vpMath.h>
+#include <visp3/vision/vpPose.h>
+#include <visp3/vision/vpPoseException.h>
+
+#include "vpPoseSolvers_impl.h"
+
+namespace
+{
+// Real roots of a x^2 + b x + c = 0
+unsigned int solveQuadratic(double a, double b, double c, double roots[2])
+{
+  if (std::fabs(a) <= 1e-14 * (std::fabs(b) + std::fabs(c))) {
+    if (b == 0.0) {
+      return 0;
+    }
+    roots[0] = -c / b;
+    return 1;
+  }
+
+  const double delta = b * b - 4.0 * a * c;
+  if (delta < 0) {
+    return 0;
+  }
+  // Avoid the cancellation of b and sqrt(delta)
+  const double q = -0.5 * (b + (b < 0 ? -std::sqrt(delta) : std::sqrt(delta)));
+  if (q == 0.0) {
+    roots[0] = 0;
+    return 1;
+  }
+  roots[0] = q / a;
+  roots[1] = c / q;
+  return 2;
+}
+
+// Real roots of c3 x^3 + c2 x^2 + c1 x + c0 = 0, refined by Newton iterations
+unsigned int solveCubic(double c3, double c2, double c1, double c0, double roots[3])
+{
+  if (std::fabs(c3) <= 1e-14 * (std::fabs(c2) + std::fabs(c1) + std::fabs(c0))) {
+    return solveQuadratic(c2, c1, c0, roots);
+  }
+
+  const double a = c2 / c3, b = c1 / c3, c = c0 / c3;
+  const double Q = (a * a - 3.0 * b) / 9.0;
+  const double R = (2.0 * a * a * a - 9.0 * a * b + 27.0 * c) / 54.0;
+  const double Q3 = Q * Q * Q;
+  unsigned int n = 0;
+  if (R * R < Q3) {
+    const double theta = std::acos(R / std::sqrt(Q3));
+    const double sqrtQ = std::sqrt(Q);
+    roots[0] = -2.0 * sqrtQ * std::cos(theta / 3.0) - a / 3.0;
+    roots[1] = -2.0 * sqrtQ * std::cos((theta + 2.0 * M_PI) / 3.0) - a / 3.0;
+    roots[2] = -2.0 * sqrtQ * std::cos((theta - 2.0 * M_PI) / 3.0) - a / 3.0;
+    n = 3;
+  } else {
+    double A = std::pow(std::fabs(R) + std::sqrt(R * R - Q3), 1.0 / 3.0);
+    if (R > 0) {
+      A = -A;
+    }
+    const double B = (A == 0.0) ? 0.0 : Q / A;
+    roots[0] = A + B - a / 3.0;
+    n = 1;
+  }
+
+  for (unsigned int i = 0; i < n; i++) {
+    double r = roots[i];
+    for (int iter = 0; iter < 3; iter++) {
+      const double f = ((r + a) * r + b) * r + c;
+      const double df = (3.0 * r + 2.0 * a) * r + b;
+      if (df == 0.0) {
+        break;
+      }
+      r -= f / df;
+    }
+    roots[i] = r;
+  }
+
+  return n;
+}
+
+double det3(const double M[3][3])
+{
+  return M[0][0] * (M[1][1] * M[2][2] - M[1][2] * M[2][1]) - M[0][1] * (M[1][0] * M[2][2] - M[1][2] * M[2][0]) +
+         M[0][2] * (M[1][0] * M[2][1] - M[1][1] * M[2][0]);
+}
+
+// Determinant of D1 + g D2
+double detPencil(const double D1[3][3], const double D2[3][3], double g)
+{
+  double M[3][3];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      M[i][j] = D1[i][j] + g * D2[i][j];
+    }
+  }
+  return det3(M);
+}
+
+// Inverse of a 3x3 matrix, false if it is singular
+bool inverse3(const double M[3][3], double Minv[3][3])
+{
+  const double det = det3(M);
+  if (std::fabs(det) < std::numeric_limits<double>::epsilon()) {
+    return false;
+  }
+  const double invDet = 1.0 / det;
+  Minv[0][0] = (M[1][1] * M[2][2] - M[1][2] * M[2][1]) * invDet;
+  Minv[0][1] = (M[0][2] * M[2][1] - M[0][1] * M[2][2]) * invDet;
+  Minv[0][2] = (M[0][1] * M[1][2] - M[0][2] * M[1][1]) * invDet;
+  Minv[1][0] = (M[1][2] * M[2][0] - M[1][0] * M[2][2]) * invDet;
+  Minv[1][1] = (M[0][0] * M[2][2] - M[0][2] * M[2][0]) * invDet;
+  Minv[1][2] = (M[0][2] * M[1][0] - M[0][0] * M[1][2]) * invDet;
+  Minv[2][0] = (M[1][0] * M[2][1] - M[1][1] * M[2][0]) * invDet;
+  Minv[2][1] = (M[0][1] * M[2][0] - M[0][0] * M[2][1]) * invDet;
+  Minv[2][2] = (M[0][0] * M[1][1] - M[0][1] * M[1][0]) * invDet;
+  return true;
+}
+
+// Gauss-Newton refinement of the depths on the three distance equations
+void refineDepths(double l[3], double a12, double a13, double a23, double b12, double b13, double b23)
+{
+  for (int iter = 0; iter < 5; iter++) {
+    const double r[3] = {l[0] * l[0] + l[1] * l[1] + b12 * l[0] * l[1] - a12,
+                         l[0] * l[0] + l[2] * l[2] + b13 * l[0] * l[2] - a13,
+                         l[1] * l[1] + l[2] * l[2] + b23 * l[1] * l[2] - a23};
+    if (std::fabs(r[0]) + std::fabs(r[1]) + std::fabs(r[2]) < 1e-15 * (a12 + a13 + a23)) {
+      break;
+    }
+    const double J[3][3] = {{2.0 * l[0] + b12 * l[1], 2.0 * l[1] + b12 * l[0], 0.0},
+                            {2.0 * l[0] + b13 * l[2], 0.0, 2.0 * l[2] + b13 * l[0]},
+                            {0.0, 2.0 * l[1] + b23 * l[2], 2.0 * l[2] + b23 * l[1]}};
+    double Jinv[3][3];
+    if (!inverse3(J, Jinv)) {
+      break;
+    }
+    for (int i = 0; i < 3; i++) {
+      l[i] -= Jinv[i][0] * r[0] + Jinv[i][1] * r[1] + Jinv[i][2] * r[2];
+    }
+  }
+}
+} // namespace
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+unsigned int vp_pose_p3p_impl(const double oP[3][3], const double p[3][2], double cMo[4][3][4])
+{
+  // Unit vectors along the lines of sight
+  double u[3][3];
+  for (int i = 0; i < 3; i++) {
+    const double norm = std::sqrt(p[i][0] * p[i][0] + p[i][1] * p[i][1] + 1.0);
+    u[i][0] = p[i][0] / norm;
+    u[i][1] = p[i][1] / norm;
+    u[i][2] = 1.0 / norm;
+  }
+
+  const double d12[3] = {oP[0][0] - oP[1][0], oP[0][1] - oP[1][1], oP[0][2] - oP[1][2]};
+  const double d13[3] = {oP[0][0] - oP[2][0], oP[0][1] - oP[2][1], oP[0][2] - oP[2][2]};
+  const double d23[3] = {oP[1][0] - oP[2][0], oP[1][1] - oP[2][1], oP[1][2] - oP[2][2]};
+
+  // Object frame: two edges of the triangle and their cross product
+  const double X[3][3] = {{d12[0], d13[0], d12[1] * d13[2] - d12[2] * d13[1]},
+                          {d12[1], d13[1], d12[2] * d13[0] - d12[0] * d13[2]},
+                          {d12[2], d13[2], d12[0] * d13[1] - d12[1] * d13[0]}};
+  double Xinv[3][3];
+  if (!inverse3(X, Xinv)) {
+    // Collinear points
+    return 0;
+  }
+
+  // With l the depths along the lines of sight, the distances give
+  // l1^2 + l2^2 + b12 l1 l2 = a12, l1^2 + l3^2 + b13 l1 l3 = a13, l2^2 + l3^2 + b23 l2 l3 = a23
+  const double a12 = d12[0] * d12[0] + d12[1] * d12[1] + d12[2] * d12[2];
+  const double a13 = d13[0] * d13[0] + d13[1] * d13[1] + d13[2] * d13[2];
+  const double a23 = d23[0] * d23[0] + d23[1] * d23[1] + d23[2] * d23[2];
+  const double b12 = -2.0 * (u[0][0] * u[1][0] + u[0][1] * u[1][1] + u[0][2] * u[1][2]);
+  const double b13 = -2.0 * (u[0][0] * u[2][0] + u[0][1] * u[2][1] + u[0][2] * u[2][2]);
+  const double b23 = -2.0 * (u[1][0] * u[2][0] + u[1][1] * u[2][1] + u[1][2] * u[2][2]);
+
+  // Homogeneous conics l^T D1 l = 0 (a23 eq12 - a12 eq23) and l^T D2 l = 0 (a13 eq23 - a23 eq13)
+  const double D1[3][3] = {{a23, 0.5 * a23 * b12, 0.0},
+                           {0.5 * a23 * b12, a23 - a12, -0.5 * a12 * b23},
+                           {0.0, -0.5 * a12 * b23, -a12}};
+  const double D2[3][3] = {{-a23, 0.0, -0.5 * a23 * b13},
+                           {0.0, a13, 0.5 * a13 * b23},
+                           {-0.5 * a23 * b13, 0.5 * a13 * b23, a13 - a23}};
+
+  // Degenerate members of the pencil D1 + g D2: det(D1 + g D2) is a cubic polynomial in g
+  const double c0 = det3(D1);
+  const double c3 = det3(D2);
+  const double fp = detPencil(D1, D2, 1.0);
+  const double fm = detPencil(D1, D2, -1.0);
+  const double c2 = 0.5 * (fp + fm) - c0;
+  const double c1 = 0.5 * (fp - fm) - c3;
+  double gammas[3];
+  const unsigned int nbGammas = solveCubic(c3, c2, c1, c0, gammas);
+
+  unsigned int nbSolutions = 0;
+  double depths[4][3];
+  for (unsigned int k = 0; k < nbGammas && nbSolutions == 0; k++) {
+    double D0[3][3], w[3], V[3][3];
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        D0[i][j] = D1[i][j] + gammas[k] * D2[i][j];
+      }
+    }
+    vp_pose_sym_eigen_impl<3>(D0, w, V);
+
+    // The conic is a pair of lines when the two non zero eigenvalues have opposite signs
+    int i0 = 0, i1 = 2;
+    if (std::fabs(w[0]) < std::fabs(w[2])) {
+      i0 = 2;
+      i1 = 0;
+    }
+    if (std::fabs(w[1]) > std::fabs(w[i1])) {
+      i1 = 1;
+    }
+    if (w[i0] * w[i1] >= 0) {
+      continue;
+    }
+
+    const double s0 = std::sqrt(-w[i1] / w[i0]);
+    for (int sign = 0; sign < 2; sign++) {
+      // Line (v0 - s v1) . l = 0, that is l1 = w0 l2 + w1 l3
+      const double s = sign == 0 ? s0 : -s0;
+      const double den = V[0][i0] - s * V[0][i1];
+      if (std::fabs(den) < std::numeric_limits<double>::epsilon()) {
+        continue;
+      }
+      const double w0 = -(V[1][i0] - s * V[1][i1]) / den;
+      const double w1 = -(V[2][i0] - s * V[2][i1]) / den;
+
+      // a13 eq12 - a12 eq13 gives a quadratic equation in tau = l3 / l2
+      const double qa = (a13 - a12) * w1 * w1 - a12 * b13 * w1 - a12;
+      const double qb = 2.0 * (a13 - a12) * w0 * w1 + a13 * b12 * w1 - a12 * b13 * w0;
+      const double qc = (a13 - a12) * w0 * w0 + a13 * b12 * w0 + a13;
+      double taus[2];
+      const unsigned int nbTaus = solveQuadratic(qa, qb, qc, taus);
+      for (unsigned int t = 0; t < nbTaus; t++) {
+        const double tau = taus[t];
+        if (tau <= 0) {
+          continue;
+        }
+        const double d = a23 / (tau * (tau + b23) + 1.0);
+        if (d <= 0) {
+          continue;
+        }
+        const double l2 = std::sqrt(d);
+        const double l3 = tau * l2;
+        const double l1 = w0 * l2 + w1 * l3;
+        if (l1 > 0) {
+          depths[nbSolutions][0] = l1;
+          depths[nbSolutions][1] = l2;
+          depths[nbSolutions][2] = l3;
+          nbSolutions++;
+        }
+      }
+    }
+  }
+
+  for (unsigned int k = 0; k < nbSolutions; k++) {
+    double *l = depths[k];
+    refineDepths(l, a12, a13, a23, b12, b13, b23);
+
+    // Points in the camera frame, and the same frame as X built from them
+    double cP[3][3];
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        cP[i][j] = l[i] * u[i][j];
+      }
+    }
+    const double e12[3] = {cP[0][0] - cP[1][0], cP[0][1] - cP[1][1], cP[0][2] - cP[1][2]};
+    const double e13[3] = {cP[0][0] - cP[2][0], cP[0][1] - cP[2][1], cP[0][2] - cP[2][2]};
+    const double Y[3][3] = {{e12[0], e13[0], e12[1] * e13[2] - e12[2] * e13[1]},
+                            {e12[1], e13[1], e12[2] * e13[0] - e12[0] * e13[2]},
+                            {e12[2], e13[2], e12[0] * e13[1] - e12[1] * e13[0]}};
+
+    // R X = Y and t = cP1 - R oP1
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        cMo[k][i][j] = Y[i][0] * Xinv[0][j] + Y[i][1] * Xinv[1][j] + Y[i][2] * Xinv[2][j];
+      }
+      cMo[k][i][3] = cP[0][i] - (cMo[k][i][0] * oP[0][0] + cMo[k][i][1] * oP[0][1] + cMo[k][i][2] * oP[0][2]);
+    }
+  }
+
+  return nbSolutions;
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Compute the pose with the P3P closed-form solution \cite Persson18, using
+  the three first points to compute up to four poses. The other points select the pose that
+  has the smallest residual (see computeResidual()).
+
+  \param cMo : Computed pose.
+
+  \exception vpPoseException::notEnoughPointError : If the three first points
+  are collinear or if no pose is found.
+*/
+void vpPose::poseP3P(vpHomogeneousMatrix &cMo)
+{
+  if (listP.size() < 3) {
+    throw(vpPoseException(vpPoseException::notEnoughPointError, "P3P method requires at least 3 points"));
+  }
+
+  double oP[3][3], p[3][2];
+  std::list<vpPoint>::const_iterator it = listP.begin();
+  for (unsigned int i = 0; i < 3; i++, ++it) {
+    oP[i][0] = it->get_oX();
+    oP[i][1] = it->get_oY();
+    oP[i][2] = it->get_oZ();
+    p[i][0] = it->get_x();
+    p[i][1] = it->get_y();
+  }
+
+  double poses[4][3][4];
+  const unsigned int nbPoses = vp_pose_p3p_impl(oP, p, poses);
+  if (nbPoses == 0) {
+    throw(vpPoseException(vpPoseException::notEnoughPointError,
+                          "P3P method cannot be used in that case (no solution from the three first points)"));
+  }
+
+  double bestResidual = DBL_MAX;
+  vpHomogeneousMatrix cMo_k;
+  for (unsigned int k = 0; k < nbPoses; k++) {
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 4; j++) {
+        cMo_k[i][j] = poses[k][i][j];
+      }
+    }
+    const double r = computeResidual(cMo_k);
+    if (r < bestResidual) {
+      bestResidual = r;
+      cMo = cMo_k;
+    }
+  }
+}
@@ -225,6 +225,61 @@ bool validPose(const vpHomogeneousMatrix& cMo) {
 
   return valid;
 }
+
+bool computePlanarObjectPoseFromPoints(const std::vector<double> &points_3d, const vpPolygon &polygon,
+                                       const std::vector<vpImagePoint> &corners,
+                                       const vpCameraParameters &colorIntrinsics, const std::vector<vpPoint> &point3d,
+                                       vpHomogeneousMatrix &cMo, double *confidence_index)
+{
+  std::vector<vpPoint> pose_points;
+  for (size_t i = 0; i < point3d.size(); i ++) {
+    pose_points.push_back(point3d[i]);
+  }
+
+  unsigned int nb_points_3d = static_cast<unsigned int>(points_3d.size() / 3);
+
+  if (nb_points_3d > 4) {
+      std::vector<vpPoint> p, q;
+
+      // Plane equation
+      vpColVector plane_equation, centroid;
+      double normalized_weights = 0;
+      estimatePlaneEquationSVD(points_3d, plane_equation, centroid, normalized_weights);
+
+      for (size_t j = 0; j < corners.size(); j++) {
+          const vpImagePoint& imPt = corners[j];
+          double x = 0, y = 0;
+          vpPixelMeterConversion::convertPoint(colorIntrinsics, imPt.get_u(), imPt.get_v(), x, y);
+          double Z = computeZMethod1(plane_equation, x, y);
+          if (Z < 0) {
+              Z = -Z;
+          }
+          p.push_back(vpPoint(x*Z, y*Z, Z));
+
+          pose_points[j].set_x(x);
+          pose_points[j].set_y(y);
+      }
+
+      for (size_t i = 0; i < point3d.size(); i ++) {
+        q.push_back(point3d[i]);
+      }
+
+      cMo = compute3d3dTransformation(p, q);
+
+      if (validPose(cMo)) {
+          vpPose pose;
+          pose.addPoints(pose_points);
+          if (pose.computePose(vpPose::VIRTUAL_VS, cMo)) {
+            if (confidence_index != NULL) {
+              *confidence_index = std::min(1.0, normalized_weights * static_cast<double>(nb_points_3d) / polygon.getArea());
+            }
+            return true;
+          }
+      }
+  }
+
+  return false;
+}
 }
 
 /*!
@@ -255,15 +310,10 @@ bool vpPose::computePlanarObjectPoseFromRGBD(const vpImage<float> &depthMap, con
     throw(vpException(vpException::fatalError, "Cannot compute pose from RGBD, 3D (%d) and 2D (%d) data doesn't have the same size",
                       point3d.size(), corners.size()));
   }
-  std::vector<vpPoint> pose_points;
   if (confidence_index != NULL) {
     *confidence_index = 0.0;
   }
 
-  for (size_t i = 0; i < point3d.size(); i ++) {
-    pose_points.push_back(point3d[i]);
-  }
-
   vpPolygon polygon(corners);
   vpRect bb = polygon.getBoundingBox();
   unsigned int top = static_cast<unsigned int>(std::max( 0, static_cast<int>(bb.getTop()) ));
@@ -287,47 +337,62 @@ bool vpPose::computePlanarObjectPoseFromRGBD(const vpImage<float> &depthMap, con
       }
   }
 
-  unsigned int nb_points_3d = static_cast<unsigned int>(points_3d.size() / 3);
-
-  if (nb_points_3d > 4) {
-      std::vector<vpPoint> p, q;
+  return computePlanarObjectPoseFromPoints(points_3d, polygon, corners, colorIntrinsics, point3d, cMo,
+                                           confidence_index);
+}
 
-      // Plane equation
-      vpColVector plane_equation, centroid;
-      double normalized_weights = 0;
-      estimatePlaneEquationSVD(points_3d, plane_equation, centroid, normalized_weights);
+/*!
+  Compute the pose of a planar object from corresponding 2D-3D point coordinates and an organized point cloud.
+  The point cloud is here used to estimate the 3D plane of the object.
 
-      for (size_t j = 0; j < corners.size(); j++) {
-          const vpImagePoint& imPt = corners[j];
-          double x = 0, y = 0;
-          vpPixelMeterConversion::convertPoint(colorIntrinsics, imPt.get_u(), imPt.get_v(), x, y);
-          double Z = computeZMethod1(plane_equation, x, y);
-          if (Z < 0) {
-              Z = -Z;
-          }
-          p.push_back(vpPoint(x*Z, y*Z, Z));
+  \param[in] pointcloud : Organized point cloud aligned to the color image from where \e corners are extracted.
+  Points with a Z coordinate lower or equal to 0 are considered as invalid.
+  \param[in] corners : Vector of 2D pixel coordinates of the object in an image.
+  \param[in] colorIntrinsics : Camera parameters used to convert \e corners from pixel to meters.
+  \param[in] point3d : Vector of 3D points corresponding to the model of the planar object.
+  \param[out] cMo : Computed pose.
+  \param[out] confidence_index : Confidence index in range [0, 1]. When values are close to 1, it means
+  that pose estimation confidence is high. Values close to 0 indicate that pose is not well estimated.
 
-          pose_points[j].set_x(x);
-          pose_points[j].set_y(y);
-      }
+  \return true if pose estimation succeed, false otherwise.
 
-      for (size_t i = 0; i < point3d.size(); i ++) {
-        q.push_back(point3d[i]);
-      }
+  \sa computePlanarObjectPoseFromRGBD(const vpImage<float> &, const std::vector<vpImagePoint> &, const vpCameraParameters &, const std::vector<vpPoint> &, vpHomogeneousMatrix &, double *)
+ */
+bool vpPose::computePlanarObjectPoseFromRGBD(const vpPointCloud<float> &pointcloud, const std::vector<vpImagePoint> &corners,
+                                             const vpCameraParameters &colorIntrinsics, const std::vector<vpPoint> &point3d,
+                                             vpHomogeneousMatrix &cMo, double *confidence_index)
+{
+  if (corners.size() != point3d.size()) {
+    throw(vpException(vpException::fatalError, "Cannot compute pose from RGBD, 3D (%d) and 2D (%d) data doesn't have the same size",
+                      point3d.size(), corners.size()));
+  }
+  if (confidence_index != NULL) {
+    *confidence_index = 0.0;
+  }
 
-      cMo = compute3d3dTransformation(p, q);
+  vpPolygon polygon(corners);
+  vpRect bb = polygon.getBoundingBox();
+  unsigned int top = static_cast<unsigned int>(std::max( 0, static_cast<int>(bb.getTop()) ));
+  unsigned int bottom = static_cast<unsigned int>(std::min( static_cast<int>(pointcloud.getHeight())-1, static_cast<int>(bb.getBottom()) ));
+  unsigned int left = static_cast<unsigned int>(std::max( 0, static_cast<int>(bb.getLeft()) ));
+  unsigned int right = static_cast<unsigned int>(std::min( static_cast<int>(pointcloud.getWidth())-1, static_cast<int>(bb.getRight()) ));
 
-      if (validPose(cMo)) {
-          vpPose pose;
-          pose.addPoints(pose_points);
-          if (pose.computePose(vpPose::VIRTUAL_VS, cMo)) {
-            if (confidence_index != NULL) {
-              *confidence_index = std::min(1.0, normalized_weights * static_cast<double>(nb_points_3d) / polygon.getArea());
-            }
-            return true;
-          }
+  const float *X = pointcloud.getX();
+  const float *Y = pointcloud.getY();
+  const float *Z = pointcloud.getZ();
+  std::vector<double> points_3d;
+  points_3d.reserve( (bottom-top)*(right-left) );
+  for (unsigned int idx_i = top; idx_i < bottom; idx_i++) {
+    unsigned int idx = idx_i * pointcloud.getWidth() + left;
+    for (unsigned int idx_j = left; idx_j < right; idx_j++, idx++) {
+      if (Z[idx] > 0 && polygon.isInside(vpImagePoint(idx_i, idx_j))) {
+        points_3d.push_back(X[idx]);
+        points_3d.push_back(Y[idx]);
+        points_3d.push_back(Z[idx]);
       }
+    }
   }
 
-  return false;
+  return computePlanarObjectPoseFromPoints(points_3d, polygon, corners, colorIntrinsics, point3d, cMo,
+                                           confidence_index);
 }
@@ -52,13 +52,11 @@
 
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpMath.h>
-#include <visp3/core/vpRansac.h>
+#include <visp3/core/vpRansacEngine.h>
 #include <visp3/vision/vpPose.h>
 #include <visp3/vision/vpPoseException.h>
 
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-#include <thread>
-#endif
+#include "vpPoseSolvers_impl.h"
 
 #define eps 1e-6
 
@@ -119,199 +117,243 @@ struct CompareImagePointDegenerate {
   }
 };
 
-// std::find_if
-struct FindDegeneratePoint {
-  explicit FindDegeneratePoint(const vpPoint &pt) : m_pt(pt) {}
+// Points of the RANSAC stored as contiguous arrays, shared by the threads
+struct RansacPoints {
+  explicit RansacPoints(const std::vector<vpPoint> &points)
+    : oX(points.size()), oY(points.size()), oZ(points.size()), x(points.size()), y(points.size())
+  {
+    for (size_t i = 0; i < points.size(); i++) {
+      oX[i] = points[i].get_oX();
+      oY[i] = points[i].get_oY();
+      oZ[i] = points[i].get_oZ();
+      x[i] = points[i].get_x();
+      y[i] = points[i].get_y();
+    }
+  }
 
-  bool operator()(const vpPoint &pt)
+  // True if the points have the same 3D or the same 2D coordinates
+  bool degenerate(unsigned int i, unsigned int j) const
   {
-    return ((std::fabs(m_pt.oP[0] - pt.oP[0]) < eps && std::fabs(m_pt.oP[1] - pt.oP[1]) < eps &&
-             std::fabs(m_pt.oP[2] - pt.oP[2]) < eps) ||
-            (std::fabs(m_pt.p[0] - pt.p[0]) < eps && std::fabs(m_pt.p[1] - pt.p[1]) < eps));
+    return (std::fabs(oX[i] - oX[j]) < eps && std::fabs(oY[i] - oY[j]) < eps && std::fabs(oZ[i] - oZ[j]) < eps) ||
+           (std::fabs(x[i] - x[j]) < eps && std::fabs(y[i] - y[j]) < eps);
   }
 
-  vpPoint m_pt;
+  size_t size() const { return x.size(); }
+
+  std::vector<double> oX, oY, oZ, x, y;
 };
-}
 
-bool vpPose::RansacFunctor::poseRansacImpl()
+// Pose of random samples for vpRansacEngine. The samples have 4 points, whose pose is computed with Lagrange and
+// Dementhon, or with P3P on the 3 first points.
+class RansacPoseModel
 {
-  const unsigned int size = (unsigned int)m_listOfUniquePoints.size();
-  unsigned int nbMinRandom = 4;
-  int nbTrials = 0;
-
-  vpPoint p; // Point used to project using the estimated pose
-
-  bool foundSolution = false;
-  while (nbTrials < m_ransacMaxTrials && m_nbInliers < m_ransacNbInlierConsensus) {
-    // Hold the list of the index of the inliers (points in the consensus set)
-    std::vector<unsigned int> cur_consensus;
-    // Hold the list of the index of the outliers
-    std::vector<unsigned int> cur_outliers;
-    // Hold the list of the index of the points randomly picked
-    std::vector<unsigned int> cur_randoms;
-    // Hold the list of the current inliers points to avoid to add a
-    // degenerate point if the flag is set
-    std::vector<vpPoint> cur_inliers;
-
-    vpHomogeneousMatrix cMo_lagrange, cMo_dementhon;
-    // Use a temporary variable because if not, the cMo passed in parameters
-    // will be modified when
-    // we compute the pose for the minimal sample sets but if the pose is not
-    // correct when we pass a function pointer we do not want to modify the
-    // cMo passed in parameters
-    vpHomogeneousMatrix cMo_tmp;
-
-    // Vector of used points, initialized at false for all points
-    std::vector<bool> usedPt(size, false);
-
-    vpPose poseMin;
-    for (unsigned int i = 0; i < nbMinRandom;) {
-      if ((size_t)std::count(usedPt.begin(), usedPt.end(), true) == usedPt.size()) {
-        // All points was picked once, break otherwise we stay in an infinite loop
-        break;
-      }
+public:
+  typedef vpHomogeneousMatrix Hypothesis;
+
+  RansacPoseModel(const std::vector<vpPoint> &points, const RansacPoints &soa, double threshold,
+                  bool checkDegeneratePoints, vpPose::RANSAC_MINIMAL_SOLVER solver,
+                  bool (*func)(const vpHomogeneousMatrix &))
+    : m_points(&points), m_soa(&soa), m_threshold(threshold), m_checkDegeneratePoints(checkDegeneratePoints),
+      m_solver(solver), m_func(func), m_poseMin(), m_cMo_lagrange(), m_cMo_dementhon(), m_consensus()
+  {
+  }
 
-      // Pick a point randomly
-      unsigned int r_ = m_uniRand.uniform(0, size);
+  unsigned int getNbData() const { return static_cast<unsigned int>(m_soa->size()); }
+  unsigned int getSampleSize() const { return 4; }
+  unsigned int getMinimalSampleSize() const { return m_solver == vpPose::RANSAC_P3P ? 3 : 4; }
+  unsigned int getMaxNbHypotheses() const { return m_solver == vpPose::RANSAC_P3P ? 4 : 1; }
 
-      while (usedPt[r_]) {
-        // If already picked, pick another point randomly
-        r_ = m_uniRand.uniform(0, size);
+  bool isDegenerate(const unsigned int *sample, unsigned int size, unsigned int index) const
+  {
+    bool degenerate = false;
+    if (m_checkDegeneratePoints) {
+      for (unsigned int k = 0; k < size && !degenerate; k++) {
+        degenerate = m_soa->degenerate(index, sample[k]);
       }
-      // Mark this point as already picked
-      usedPt[r_] = true;
-      vpPoint pt = m_listOfUniquePoints[r_];
+    }
+    return degenerate;
+  }
+
+  unsigned int computeHypotheses(const unsigned int *sample, vpHomogeneousMatrix *hypotheses)
+  {
+    if (m_solver == vpPose::RANSAC_P3P) {
+      return hypothesesP3P(sample, hypotheses);
+    }
+    return hypothesesLagrangeDementhon(sample, hypotheses);
+  }
+
+  // Squared reprojection errors, in a loop without branch that the compiler can vectorize
+  void computeResiduals(const vpHomogeneousMatrix &cMo, unsigned int begin, unsigned int end, double *errors) const
+  {
+    const double *oX = &m_soa->oX[begin], *oY = &m_soa->oY[begin], *oZ = &m_soa->oZ[begin];
+    const double *x = &m_soa->x[begin], *y = &m_soa->y[begin];
+    const double r00 = cMo[0][0], r01 = cMo[0][1], r02 = cMo[0][2], tx = cMo[0][3];
+    const double r10 = cMo[1][0], r11 = cMo[1][1], r12 = cMo[1][2], ty = cMo[1][3];
+    const double r20 = cMo[2][0], r21 = cMo[2][1], r22 = cMo[2][2], tz = cMo[2][3];
+    const unsigned int size = end - begin;
+    for (unsigned int i = 0; i < size; i++) {
+      const double X = r00 * oX[i] + r01 * oY[i] + r02 * oZ[i] + tx;
+      const double Y = r10 * oX[i] + r11 * oY[i] + r12 * oZ[i] + ty;
+      const double Z = r20 * oX[i] + r21 * oY[i] + r22 * oZ[i] + tz;
+      const double dx = X / Z - x[i];
+      const double dy = Y / Z - y[i];
+      errors[i] = dx * dx + dy * dy;
+    }
+  }
+
+  // The degenerate points of the consensus set are counted once
+  void filterInliers(std::vector<unsigned int> &inliers)
+  {
+    if (!m_checkDegeneratePoints) {
+      return;
+    }
 
+    m_consensus.clear();
+    for (size_t i = 0; i < inliers.size(); i++) {
       bool degenerate = false;
-      if (m_checkDegeneratePoints) {
-        if (std::find_if(poseMin.listOfPoints.begin(), poseMin.listOfPoints.end(), FindDegeneratePoint(pt)) !=
-            poseMin.listOfPoints.end()) {
-          degenerate = true;
-        }
+      for (size_t k = 0; k < m_consensus.size() && !degenerate; k++) {
+        degenerate = m_soa->degenerate(inliers[i], m_consensus[k]);
       }
 
       if (!degenerate) {
-        poseMin.addPoint(pt);
-        cur_randoms.push_back(r_);
-        // Increment the number of points picked
-        i++;
+        m_consensus.push_back(inliers[i]);
       }
     }
+    inliers.swap(m_consensus);
+  }
 
-    if (poseMin.npt < nbMinRandom) {
-      nbTrials++;
-      continue;
-    }
+private:
+  unsigned int hypothesesLagrangeDementhon(const unsigned int *sample, vpHomogeneousMatrix *hypotheses);
+  unsigned int hypothesesP3P(const unsigned int *sample, vpHomogeneousMatrix *hypotheses);
+
+  const std::vector<vpPoint> *m_points;
+  const RansacPoints *m_soa;
+  double m_threshold;
+  bool m_checkDegeneratePoints;
+  vpPose::RANSAC_MINIMAL_SOLVER m_solver;
+  bool (*m_func)(const vpHomogeneousMatrix &);
+  // Buffers reused by the trials
+  vpPose m_poseMin;
+  vpHomogeneousMatrix m_cMo_lagrange, m_cMo_dementhon;
+  std::vector<unsigned int> m_consensus;
+};
 
-    // Flags set if pose computation is OK
-    bool is_valid_lagrange = false;
-    bool is_valid_dementhon = false;
-
-    // Set maximum value for residuals
-    double r_lagrange = DBL_MAX;
-    double r_dementhon = DBL_MAX;
-
-    try {
-      poseMin.computePose(vpPose::LAGRANGE, cMo_lagrange);
-      r_lagrange = poseMin.computeResidual(cMo_lagrange);
-      is_valid_lagrange = true;
-    } catch (...) { }
-
-    try {
-      poseMin.computePose(vpPose::DEMENTHON, cMo_dementhon);
-      r_dementhon = poseMin.computeResidual(cMo_dementhon);
-      is_valid_dementhon = true;
-    } catch (...) { }
-
-    // If residual returned is not a number (NAN), set valid to false
-    if (vpMath::isNaN(r_lagrange)) {
-      is_valid_lagrange = false;
-      r_lagrange = DBL_MAX;
-    }
+// Pose of the 4 sampled points with the Lagrange and Dementhon approaches, the best one is kept if its residual on
+// the sample is below the threshold
+unsigned int RansacPoseModel::hypothesesLagrangeDementhon(const unsigned int *sample, vpHomogeneousMatrix *hypotheses)
+{
+  const unsigned int nbMinRandom = 4;
+  m_poseMin.clearPoint();
+  for (unsigned int i = 0; i < nbMinRandom; i++) {
+    m_poseMin.addPoint((*m_points)[sample[i]]);
+  }
 
-    if (vpMath::isNaN(r_dementhon)) {
-      is_valid_dementhon = false;
-      r_dementhon = DBL_MAX;
-    }
+  // Flags set if pose computation is OK
+  bool is_valid_lagrange = false;
+  bool is_valid_dementhon = false;
+
+  // Set maximum value for residuals
+  double r_lagrange = DBL_MAX;
+  double r_dementhon = DBL_MAX;
+
+  try {
+    m_poseMin.computePose(vpPose::LAGRANGE, m_cMo_lagrange);
+    r_lagrange = m_poseMin.computeResidual(m_cMo_lagrange);
+    is_valid_lagrange = true;
+  } catch (...) { }
+
+  try {
+    m_poseMin.computePose(vpPose::DEMENTHON, m_cMo_dementhon);
+    r_dementhon = m_poseMin.computeResidual(m_cMo_dementhon);
+    is_valid_dementhon = true;
+  } catch (...) { }
+
+  // If residual returned is not a number (NAN), set valid to false
+  if (vpMath::isNaN(r_lagrange)) {
+    is_valid_lagrange = false;
+    r_lagrange = DBL_MAX;
+  }
 
-    // If at least one pose computation is OK,
-    // we can continue, otherwise pick another random set
-    if (is_valid_lagrange || is_valid_dementhon) {
-      double r;
-      if (r_lagrange < r_dementhon) {
-        r = r_lagrange;
-        cMo_tmp = cMo_lagrange;
-      } else {
-        r = r_dementhon;
-        cMo_tmp = cMo_dementhon;
-      }
-      r = sqrt(r) / (double)nbMinRandom; // FS should be r = sqrt(r / (double)nbMinRandom);
-      // Filter the pose using some criterion (orientation angles,
-      // translations, etc.)
-      bool isPoseValid = true;
-      if (m_func != NULL) {
-        isPoseValid = m_func(cMo_tmp);
-        if (isPoseValid) {
-          m_cMo = cMo_tmp;
-        }
-      } else {
-        // No post filtering on pose, so copy cMo_temp to cMo
-        m_cMo = cMo_tmp;
-      }
+  if (vpMath::isNaN(r_dementhon)) {
+    is_valid_dementhon = false;
+    r_dementhon = DBL_MAX;
+  }
 
-      if (isPoseValid && r < m_ransacThreshold) {
-        unsigned int nbInliersCur = 0;
-        unsigned int iter = 0;
-        for (std::vector<vpPoint>::const_iterator it = m_listOfUniquePoints.begin(); it != m_listOfUniquePoints.end();
-             ++it, iter++) {
-          p.setWorldCoordinates(it->get_oX(), it->get_oY(), it->get_oZ());
-          p.track(m_cMo);
-
-          double error = sqrt(vpMath::sqr(p.get_x() - it->get_x()) + vpMath::sqr(p.get_y() - it->get_y()));
-          if (error < m_ransacThreshold) {
-            bool degenerate = false;
-            if (m_checkDegeneratePoints) {
-              if (std::find_if(cur_inliers.begin(), cur_inliers.end(), FindDegeneratePoint(*it)) != cur_inliers.end()) {
-                degenerate = true;
-              }
-            }
-
-            if (!degenerate) {
-              // the point is considered as inlier if the error is below the
-              // threshold
-              nbInliersCur++;
-              cur_consensus.push_back(iter);
-              cur_inliers.push_back(*it);
-            } else {
-              cur_outliers.push_back(iter);
-            }
-          } else {
-            cur_outliers.push_back(iter);
-          }
-        }
+  // If at least one pose computation is OK,
+  // we can continue, otherwise pick another random set
+  if (!is_valid_lagrange && !is_valid_dementhon) {
+    return 0;
+  }
 
-        if (nbInliersCur > m_nbInliers) {
-          foundSolution = true;
-          m_best_consensus = cur_consensus;
-          m_nbInliers = nbInliersCur;
-        }
+  const vpHomogeneousMatrix &cMo = r_lagrange < r_dementhon ? m_cMo_lagrange : m_cMo_dementhon;
+  double r = r_lagrange < r_dementhon ? r_lagrange : r_dementhon;
+  r = sqrt(r) / (double)nbMinRandom; // FS should be r = sqrt(r / (double)nbMinRandom);
 
-        nbTrials++;
+  // Filter the pose using some criterion (orientation angles,
+  // translations, etc.)
+  if (r < m_threshold && (m_func == NULL || m_func(cMo))) {
+    hypotheses[0] = cMo;
+    return 1;
+  }
+  return 0;
+}
 
-        if (nbTrials >= m_ransacMaxTrials) {
-          foundSolution = true;
-        }
-      } else {
-        nbTrials++;
+// Poses of the 3 first sampled points with P3P. The 4th point selects the pose to score; when it is not an inlier of
+// any of them, all the poses are scored so that a sample is good as soon as its 3 first points are inliers.
+unsigned int RansacPoseModel::hypothesesP3P(const unsigned int *sample, vpHomogeneousMatrix *hypotheses)
+{
+  double oP[3][3], p[3][2];
+  for (unsigned int i = 0; i < 3; i++) {
+    const unsigned int k = sample[i];
+    oP[i][0] = m_soa->oX[k];
+    oP[i][1] = m_soa->oY[k];
+    oP[i][2] = m_soa->oZ[k];
+    p[i][0] = m_soa->x[k];
+    p[i][1] = m_soa->y[k];
+  }
+
+  double poses[4][3][4];
+  const unsigned int nbPoses = vp_pose_p3p_impl(oP, p, poses);
+
+  const unsigned int k = sample[3];
+  const double oX = m_soa->oX[k], oY = m_soa->oY[k], oZ = m_soa->oZ[k];
+  unsigned int best = 0;
+  double bestError = DBL_MAX;
+  for (unsigned int i = 0; i < nbPoses; i++) {
+    const double(*M)[4] = poses[i];
+    const double X = M[0][0] * oX + M[0][1] * oY + M[0][2] * oZ + M[0][3];
+    const double Y = M[1][0] * oX + M[1][1] * oY + M[1][2] * oZ + M[1][3];
+    const double Z = M[2][0] * oX + M[2][1] * oY + M[2][2] * oZ + M[2][3];
+    if (Z > 0) {
+      const double dx = X / Z - m_soa->x[k];
+      const double dy = Y / Z - m_soa->y[k];
+      const double error = dx * dx + dy * dy;
+      if (error < bestError) {
+        bestError = error;
+        best = i;
       }
-    } else {
-      nbTrials++;
     }
   }
 
-  return foundSolution;
+  const bool selected = bestError < m_threshold * m_threshold;
+  unsigned int nbHypotheses = 0;
+  for (unsigned int i = 0; i < nbPoses; i++) {
+    if (selected && i != best) {
+      continue;
+    }
+    vpHomogeneousMatrix &cMo = hypotheses[nbHypotheses];
+    for (unsigned int r = 0; r < 3; r++) {
+      for (unsigned int c = 0; c < 4; c++) {
+        cMo[r][c] = poses[i][r][c];
+      }
+    }
+    if (m_func == NULL || m_func(cMo)) {
+      nbHypotheses++;
+    }
+  }
+  return nbHypotheses;
 }
+} // namespace
 
 /*!
   Compute the pose using the Ransac approach.
@@ -324,6 +366,9 @@ bool vpPose::RansacFunctor::poseRansacImpl()
   error below ransacThreshold.
   \note You can enable a multithreaded version if you have C++11 enabled using setUseParallelRansac().
   The number of threads used can then be set with setNbParallelRansacThreads().
+  The threads share the maximum number of trials and the best consensus set: they all stop as soon as one of them
+  reaches the consensus. The number of trials can also be reduced with setRansacProbability().
+  The pose of the random samples is computed as set by setRansacMinimalSolver().
   Filter flag can be used  with setRansacFilterFlag().
 */
 bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneousMatrix &))
@@ -341,7 +386,7 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneo
   std::vector<unsigned int> best_consensus;
   unsigned int nbInliers = 0;
 
-  vpHomogeneousMatrix cMo_lagrange, cMo_dementhon;
+  vpHomogeneousMatrix cMo_lagrange, cMo_dementhon, cMo_epnp;
 
   if (listOfPoints.size() < 4) {
     throw(vpPoseException(vpPoseException::notInitializedError, "Not enough point to compute the pose"));
@@ -390,84 +435,24 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneo
     throw(vpPoseException(vpPoseException::notInitializedError, "Not enough point to compute the pose"));
   }
 
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-  unsigned int nbThreads = 1;
-  bool executeParallelVersion = useParallelRansac;
-#else
-  bool executeParallelVersion = false;
-#endif
-
-  if (executeParallelVersion) {
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-    if (nbParallelRansacThreads <= 0) {
-      // Get number of CPU threads
-      nbThreads = std::thread::hardware_concurrency();
-      if (nbThreads <= 1) {
-        nbThreads = 1;
-        executeParallelVersion = false;
-      }
-    } else {
-      nbThreads = nbParallelRansacThreads;
-    }
-#endif
+  // The threads share the points and the best consensus set, and draw the trials from a common budget
+  const RansacPoints soa(listOfUniquePoints);
+  const RansacPoseModel model(listOfUniquePoints, soa, ransacThreshold, checkDegeneratePoints, ransacMinimalSolver,
+                              func);
+  vpRansacEngine<RansacPoseModel> ransac(model);
+  ransac.setThreshold(ransacThreshold);
+  ransac.setMaxTrials(ransacMaxTrials);
+  ransac.setNbInliersToReachConsensus(ransacNbInlierConsensus);
+  ransac.setProbability(ransacProbability);
+  // Same result as the full scoring, but the hypotheses that cannot beat the best one are not fully scored
+  ransac.setScoring(vpRansacEngine<RansacPoseModel>::PREEMPTIVE_SCORING);
+  if (useParallelRansac) {
+    ransac.setNbThreads(nbParallelRansacThreads > 0 ? static_cast<unsigned int>(nbParallelRansacThreads) : 0);
   }
 
-  bool foundSolution = false;
-
-  if (executeParallelVersion) {
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-    std::vector<std::thread> threadpool;
-    std::vector<RansacFunctor> ransacWorkers;
-
-    int splitTrials = ransacMaxTrials / nbThreads;
-    for (size_t i = 0; i < (size_t)nbThreads; i++) {
-      unsigned int initial_seed = (unsigned int)i; //((unsigned int) time(NULL) ^ i);
-      if (i < (size_t)nbThreads - 1) {
-        ransacWorkers.emplace_back(cMo, ransacNbInlierConsensus, splitTrials, ransacThreshold, initial_seed,
-                                   checkDegeneratePoints, listOfUniquePoints, func);
-      } else {
-        int maxTrialsRemainder = ransacMaxTrials - splitTrials * (nbThreads - 1);
-        ransacWorkers.emplace_back(cMo, ransacNbInlierConsensus, maxTrialsRemainder, ransacThreshold, initial_seed,
-                                   checkDegeneratePoints, listOfUniquePoints, func);
-      }
-    }
-
-    for (auto& worker : ransacWorkers) {
-      threadpool.emplace_back(&RansacFunctor::operator(), &worker);
-    }
-
-    for (auto& th : threadpool) {
-      th.join();
-    }
-
-    bool successRansac = false;
-    size_t best_consensus_size = 0;
-    for (auto &worker : ransacWorkers) {
-      if (worker.getResult()) {
-        successRansac = true;
-
-        if (worker.getBestConsensus().size() > best_consensus_size) {
-          nbInliers = worker.getNbInliers();
-          best_consensus = worker.getBestConsensus();
-          best_consensus_size = worker.getBestConsensus().size();
-        }
-      }
-    }
-
-    foundSolution = successRansac;
-#endif
-  } else {
-    // Sequential RANSAC
-    RansacFunctor sequentialRansac(cMo, ransacNbInlierConsensus, ransacMaxTrials, ransacThreshold, 0,
-                                   checkDegeneratePoints, listOfUniquePoints, func);
-    sequentialRansac();
-    foundSolution = sequentialRansac.getResult();
-
-    if (foundSolution) {
-      nbInliers = sequentialRansac.getNbInliers();
-      best_consensus = sequentialRansac.getBestConsensus();
-    }
-  }
+  vpHomogeneousMatrix cMo_ransac;
+  const bool foundSolution = ransac.estimate(cMo_ransac, best_consensus);
+  nbInliers = ransac.getNbInliers();
 
   if (foundSolution) {
     unsigned int nbMinRandom = 4;
@@ -515,22 +500,40 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneo
       // Flags set if pose computation is OK
       bool is_valid_lagrange = false;
       bool is_valid_dementhon = false;
+      bool is_valid_epnp = false;
 
       // Set maximum value for residuals
       double r_lagrange = DBL_MAX;
       double r_dementhon = DBL_MAX;
+      double r_epnp = DBL_MAX;
+
+      if (ransacMinimalSolver == RANSAC_P3P) {
+        // EPnP is linear in the number of inliers
+        try {
+          pose.computePose(vpPose::EPNP, cMo_epnp);
+          r_epnp = pose.computeResidual(cMo_epnp);
+          is_valid_epnp = true;
+        } catch (...) { }
+
+        if (vpMath::isNaN(r_epnp)) {
+          is_valid_epnp = false;
+          r_epnp = DBL_MAX;
+        }
+      }
 
-      try {
-        pose.computePose(vpPose::LAGRANGE, cMo_lagrange);
-        r_lagrange = pose.computeResidual(cMo_lagrange);
-        is_valid_lagrange = true;
-      } catch (...) { }
-
-      try {
-        pose.computePose(vpPose::DEMENTHON, cMo_dementhon);
-        r_dementhon = pose.computeResidual(cMo_dementhon);
-        is_valid_dementhon = true;
-      } catch (...) { }
+      if (!is_valid_epnp) {
+        try {
+          pose.computePose(vpPose::LAGRANGE, cMo_lagrange);
+          r_lagrange = pose.computeResidual(cMo_lagrange);
+          is_valid_lagrange = true;
+        } catch (...) { }
+
+        try {
+          pose.computePose(vpPose::DEMENTHON, cMo_dementhon);
+          r_dementhon = pose.computeResidual(cMo_dementhon);
+          is_valid_dementhon = true;
+        } catch (...) { }
+      }
 
       // If residual returned is not a number (NAN), set valid to false
       if (vpMath::isNaN(r_lagrange)) {
@@ -543,8 +546,10 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneo
         r_dementhon = DBL_MAX;
       }
 
-      if (is_valid_lagrange || is_valid_dementhon) {
-        if (r_lagrange < r_dementhon) {
+      if (is_valid_lagrange || is_valid_dementhon || is_valid_epnp) {
+        if (is_valid_epnp) {
+          cMo = cMo_epnp;
+        } else if (r_lagrange < r_dementhon) {
           cMo = cMo_lagrange;
         } else {
           cMo = cMo_dementhon;
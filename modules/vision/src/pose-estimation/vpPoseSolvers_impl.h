@@ -0,0 +1,148 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Closed-form pose solvers working on fixed-size arrays.
+ *
+ *****************************************************************************/
+
+#ifndef vpPoseSolvers_impl_h
+#define vpPoseSolvers_impl_h
+
+#include <cmath>
+
+#include <visp3/core/vpConfig.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+/*
+  Eigen decomposition of the N x N symmetric matrix A with the cyclic Jacobi method. A is destroyed, the eigenvalues
+  are sorted in ascending order in w and the corresponding eigenvectors are the columns of V.
+*/
+template <int N> void vp_pose_sym_eigen_impl(double A[N][N], double w[N], double V[N][N])
+{
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      V[i][j] = (i == j) ? 1.0 : 0.0;
+    }
+  }
+
+  for (int sweep = 0; sweep < 50; sweep++) {
+    double off = 0, diag = 0;
+    for (int p = 0; p < N; p++) {
+      diag += A[p][p] * A[p][p];
+      for (int q = p + 1; q < N; q++) {
+        off += A[p][q] * A[p][q];
+      }
+    }
+    if (off <= 1e-30 * diag || off == 0.0) {
+      break;
+    }
+
+    for (int p = 0; p < N - 1; p++) {
+      for (int q = p + 1; q < N; q++) {
+        if (A[p][q] == 0.0) {
+          continue;
+        }
+        const double theta = (A[q][q] - A[p][p]) / (2.0 * A[p][q]);
+        double t = 1.0 / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+        if (theta < 0) {
+          t = -t;
+        }
+        const double c = 1.0 / std::sqrt(t * t + 1.0);
+        const double s = t * c;
+
+        for (int k = 0; k < N; k++) {
+          const double akp = A[k][p], akq = A[k][q];
+          A[k][p] = c * akp - s * akq;
+          A[k][q] = s * akp + c * akq;
+        }
+        for (int k = 0; k < N; k++) {
+          const double apk = A[p][k], aqk = A[q][k];
+          A[p][k] = c * apk - s * aqk;
+          A[q][k] = s * apk + c * aqk;
+        }
+        for (int k = 0; k < N; k++) {
+          const double vkp = V[k][p], vkq = V[k][q];
+          V[k][p] = c * vkp - s * vkq;
+          V[k][q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+
+  for (int i = 0; i < N; i++) {
+    w[i] = A[i][i];
+  }
+
+  // Selection sort of the eigen pairs
+  for (int i = 0; i < N - 1; i++) {
+    int k = i;
+    for (int j = i + 1; j < N; j++) {
+      if (w[j] < w[k]) {
+        k = j;
+      }
+    }
+    if (k != i) {
+      const double tmp = w[i];
+      w[i] = w[k];
+      w[k] = tmp;
+      for (int j = 0; j < N; j++) {
+        const double v = V[j][i];
+        V[j][i] = V[j][k];
+        V[j][k] = v;
+      }
+    }
+  }
+}
+
+/*
+  P3P solver in the spirit of Lambda Twist (Persson and Nordberg, ECCV 2018): the three distance equations are
+  combined in a pencil of conics, whose degenerate member gives the depth ratios by a quadratic equation.
+
+  oP: coordinates of the 3 points in the object frame.
+  p: normalized coordinates (x, y) of the 3 points in the image.
+  cMo: the 3 first rows of each pose found.
+  Return the number of poses, between 0 and 4.
+*/
+unsigned int vp_pose_p3p_impl(const double oP[3][3], const double p[3][2], double cMo[4][3][4]);
+
+/*
+  EPnP solver (Lepetit, Moreno-Noguer and Fua, IJCV 2009) that uses 4 control points, or 3 control points when the
+  points are planar. The points are given as contiguous arrays of coordinates, indexed by index if it is not NULL.
+
+  Return false if the pose cannot be computed, for instance when the points are collinear.
+*/
+bool vp_pose_epnp_impl(const double *oX, const double *oY, const double *oZ, const double *x, const double *y,
+                       const unsigned int *index, unsigned int n, bool planar, double cMo[3][4]);
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
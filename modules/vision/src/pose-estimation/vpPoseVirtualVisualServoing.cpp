@@ -41,6 +41,8 @@
   \brief Compute the pose using virtual visual servoing approach
 */
 
+#include <limits>
+
 #include <visp3/core/vpExponentialMap.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/core/vpRobust.h>
@@ -69,6 +71,8 @@ void vpPose::poseVirtualVS(vpHomogeneousMatrix &cMo)
     vpColVector err(2 * nb);
     vpColVector sd(2 * nb), s(2 * nb);
     vpColVector v;
+    vpMatrix LTL;
+    vpColVector LTe;
 
     vpPoint P;
     std::list<vpPoint> lP;
@@ -123,12 +127,10 @@ void vpPose::poseVirtualVS(vpHomogeneousMatrix &cMo)
       // compute the residual
       r = err.sumSquare();
 
-      // compute the pseudo inverse of the interaction matrix
-      vpMatrix Lp;
-      L.pseudoInverse(Lp, 1e-16);
-
-      // compute the VVS control law
-      v = -lambda * Lp * err;
+      // compute the VVS control law from the normal equations
+      L.AtA(LTL);
+      L.Atb(err, LTe);
+      v = -lambda * LTL.pseudoInverse(LTL.getRows() * std::numeric_limits<double>::epsilon()) * LTe;
 
       // std::cout << "r=" << r <<std::endl ;
       // update the pose
@@ -166,7 +168,6 @@ void vpPose::poseVirtualVSrobust(vpHomogeneousMatrix &cMo)
     double r = 1e8 - 1;
 
     // we stop the minimization when the error is bellow 1e-8
-    vpMatrix W;
     vpRobust robust;
     robust.setMinMedianAbsoluteDeviation(0.00001);
     vpColVector w, res;
@@ -176,6 +177,8 @@ void vpPose::poseVirtualVSrobust(vpHomogeneousMatrix &cMo)
     vpColVector error(2 * nb);
     vpColVector sd(2 * nb), s(2 * nb);
     vpColVector v;
+    vpMatrix LTWL;
+    vpColVector LTWe, W2(2 * nb);
 
     listP.front();
     vpPoint P;
@@ -193,7 +196,6 @@ void vpPose::poseVirtualVSrobust(vpHomogeneousMatrix &cMo)
     int iter = 0;
     res.resize(s.getRows() / 2);
     w.resize(s.getRows() / 2);
-    W.resize(s.getRows(), s.getRows());
     w = 1;
 
     // while((int)((residu_1 - r)*1e12) !=0)
@@ -238,28 +240,29 @@ void vpPose::poseVirtualVSrobust(vpHomogeneousMatrix &cMo)
       }
       robust.MEstimator(vpRobust::TUKEY, res, w);
 
-      // compute the pseudo inverse of the interaction matrix
       for (unsigned int k = 0; k < error.getRows() / 2; k++) {
-        W[2 * k][2 * k] = w[k];
-        W[2 * k + 1][2 * k + 1] = w[k];
+        W2[2 * k] = W2[2 * k + 1] = w[k] * w[k];
       }
-      // compute the pseudo inverse of the interaction matrix
-      vpMatrix Lp;
-      (W * L).pseudoInverse(Lp, 1e-6);
 
-      // compute the VVS control law
-      v = -lambda * Lp * W * error;
+      // compute the VVS control law from the weighted normal equations,
+      // (W L)^+ W e = (L^T W^2 L)^+ L^T W^2 e
+      L.AtA(W2, LTWL);
+      L.Atb(W2, error, LTWe);
+      v = -lambda * LTWL.pseudoInverse(1e-12) * LTWe;
 
       cMo = vpExponentialMap::direct(v).inverse() * cMo;
       if (iter++ > vvsIterMax)
         break;
     }
 
-    if (computeCovariance)
-      covarianceMatrix =
-          vpMatrix::computeCovarianceMatrix(L, v, -lambda * error, W * W); // Remark: W*W = W*W.t() since the
-                                                                           // matrix is diagonale, but using W*W
-                                                                           // is more efficient.
+    if (computeCovariance) {
+      // The weighting matrix W*W is diagonal: it is only built when the covariance is requested
+      vpMatrix WW(W2.getRows(), W2.getRows());
+      for (unsigned int k = 0; k < W2.getRows(); k++) {
+        WW[k][k] = W2[k];
+      }
+      covarianceMatrix = vpMatrix::computeCovarianceMatrix(L, v, -lambda * error, WW);
+    }
   } catch (...) {
     vpERROR_TRACE(" ");
     throw;
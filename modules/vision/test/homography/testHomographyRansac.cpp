@@ -0,0 +1,121 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the robust homography estimation.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testHomographyRansac.cpp
+
+  Test vpHomography::ransac() on matched points of a plane with outliers.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) &&                                       \
+    (defined(VISP_HAVE_LAPACK) || defined(VISP_HAVE_EIGEN3) || defined(VISP_HAVE_OPENCV))
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpHomography.h>
+
+TEST_CASE("Homography RANSAC", "[homography]")
+{
+  const vpHomogeneousMatrix bMo(0, 0, 1, 0, 0, 0);
+  const vpHomogeneousMatrix aMb(0.1, 0.1, 0.1, vpMath::rad(10), 0, vpMath::rad(40));
+
+  // Points of the plane Z = 0 of the object frame, every third one with a wrong match
+  vpUniRand rng(7);
+  const unsigned int n = 300;
+  std::vector<double> xa(n), ya(n), xb(n), yb(n);
+  for (unsigned int i = 0; i < n; i++) {
+    vpPoint P(rng.uniform(-0.3, 0.3), rng.uniform(-0.3, 0.3), 0);
+    P.project(bMo);
+    xb[i] = P.get_x();
+    yb[i] = P.get_y();
+    P.project(aMb * bMo);
+    xa[i] = i % 3 == 0 ? rng.uniform(-0.5, 0.5) : P.get_x();
+    ya[i] = i % 3 == 0 ? rng.uniform(-0.5, 0.5) : P.get_y();
+  }
+
+  vpHomography aHb;
+  std::vector<bool> inliers;
+  double residual = 0;
+  REQUIRE(vpHomography::ransac(xb, yb, xa, ya, aHb, inliers, residual, 2 * n / 3, 2. / 1000));
+  CHECK(residual < 1e-8);
+
+  REQUIRE(inliers.size() == n);
+  for (unsigned int i = 0; i < n; i++) {
+    if (i % 3 != 0) {
+      CHECK(inliers[i]);
+    }
+  }
+
+  // Transfer of a point of the plane that was not used
+  vpPoint P(0.05, -0.1, 0);
+  P.project(bMo);
+  const vpPoint Pb = P;
+  P.project(aMb * bMo);
+  const vpPoint Pa = vpHomography::project(aHb, Pb);
+  CHECK(Pa.get_x() == Approx(P.get_x()).margin(1e-9));
+  CHECK(Pa.get_y() == Approx(P.get_y()).margin(1e-9));
+
+  // The consensus cannot be reached
+  CHECK_FALSE(vpHomography::ransac(xb, yb, xa, ya, aHb, inliers, residual, n, 2. / 1000));
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,314 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test and benchmark the matching of binary descriptors.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfHammingMatcher.cpp
+
+  Check that vpHammingMatcher finds the same neighbors as a naive search at
+  all the SIMD levels, with several threads and with the multi-index hashing.
+  With --benchmark, print the number of matched queries per second.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <iomanip>
+#include <limits.h>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpHammingMatcher.h>
+
+namespace
+{
+static bool g_runBenchmark = false;
+
+std::vector<unsigned char> randomDescriptors(vpUniRand &rng, unsigned int n, unsigned int size)
+{
+  std::vector<unsigned char> descriptors(static_cast<size_t>(n) * size);
+  for (size_t i = 0; i < descriptors.size(); i++) {
+    descriptors[i] = static_cast<unsigned char>(rng.next());
+  }
+  return descriptors;
+}
+
+// Every other query is a train descriptor with up to maxFlips flipped bits, the other ones are random
+std::vector<unsigned char> queryDescriptors(vpUniRand &rng, const std::vector<unsigned char> &train, unsigned int n,
+                                            unsigned int size, unsigned int maxFlips)
+{
+  const unsigned int nbTrain = static_cast<unsigned int>(train.size() / size);
+  std::vector<unsigned char> queries = randomDescriptors(rng, n, size);
+  for (unsigned int q = 0; q < n; q += 2) {
+    const unsigned int t = rng.next() % nbTrain;
+    std::copy(train.begin() + t * size, train.begin() + (t + 1) * size, queries.begin() + q * size);
+    const unsigned int nbFlips = rng.next() % (maxFlips + 1);
+    for (unsigned int k = 0; k < nbFlips; k++) {
+      const unsigned int bit = rng.next() % (8 * size);
+      queries[q * size + bit / 8] ^= static_cast<unsigned char>(1 << (bit % 8));
+    }
+  }
+  return queries;
+}
+
+std::vector<vpHammingMatcher::vpMatch> naiveKnnMatch(const std::vector<unsigned char> &train,
+                                                     const std::vector<unsigned char> &queries, unsigned int size)
+{
+  std::vector<vpHammingMatcher::vpMatch> matches(queries.size() / size);
+  for (unsigned int q = 0; q < matches.size(); q++) {
+    vpHammingMatcher::vpMatch &m = matches[q];
+    m.queryIdx = q;
+    m.trainIdx = m.secondTrainIdx = 0;
+    m.distance = m.secondDistance = UINT_MAX;
+    for (unsigned int t = 0; t < train.size() / size; t++) {
+      const unsigned int d = vpHammingMatcher::distance(&queries[q * size], &train[t * size], size);
+      if (d < m.distance) {
+        m.secondDistance = m.distance;
+        m.secondTrainIdx = m.trainIdx;
+        m.distance = d;
+        m.trainIdx = t;
+      } else if (d < m.secondDistance) {
+        m.secondDistance = d;
+        m.secondTrainIdx = t;
+      }
+    }
+  }
+  return matches;
+}
+
+void checkKnnMatches(const std::vector<unsigned char> &train, const std::vector<unsigned char> &queries,
+                     unsigned int size, const std::vector<vpHammingMatcher::vpMatch> &ref,
+                     const std::vector<vpHammingMatcher::vpMatch> &matches)
+{
+  REQUIRE(matches.size() == ref.size());
+  for (size_t q = 0; q < ref.size(); q++) {
+    INFO("query: " << q);
+    CHECK(matches[q].queryIdx == ref[q].queryIdx);
+    CHECK(matches[q].distance == ref[q].distance);
+    CHECK(matches[q].secondDistance == ref[q].secondDistance);
+    if (ref[q].distance < ref[q].secondDistance) {
+      CHECK(matches[q].trainIdx == ref[q].trainIdx);
+    }
+    if (ref[q].secondDistance != UINT_MAX) {
+      CHECK(vpHammingMatcher::distance(&queries[q * size], &train[matches[q].secondTrainIdx * size], size) ==
+            ref[q].secondDistance);
+    }
+  }
+}
+
+void checkRatioMatches(const std::vector<vpHammingMatcher::vpMatch> &ref,
+                       const std::vector<vpHammingMatcher::vpMatch> &matches, double ratio)
+{
+  size_t k = 0;
+  for (size_t q = 0; q < ref.size(); q++) {
+    if (ref[q].distance < ratio * ref[q].secondDistance) {
+      INFO("query: " << q);
+      REQUIRE(k < matches.size());
+      CHECK(matches[k].queryIdx == ref[q].queryIdx);
+      CHECK(matches[k].trainIdx == ref[q].trainIdx);
+      CHECK(matches[k].distance == ref[q].distance);
+      k++;
+    }
+  }
+  CHECK(k == matches.size());
+}
+} // namespace
+
+TEST_CASE("Hamming matcher at all the SIMD levels", "[hamming]")
+{
+  const vpCPUFeatures::vpSimdLevel hardwareLevel = vpCPUFeatures::getSimdLevel();
+  vpUniRand rng(3);
+  // ORB, BRISK, and a size that is not a multiple of 8
+  const unsigned int sizes[] = {32, 64, 61};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    const std::vector<unsigned char> train = randomDescriptors(rng, 1500, sizes[s]);
+    const std::vector<unsigned char> queries = queryDescriptors(rng, train, 301, sizes[s], 40);
+    const std::vector<vpHammingMatcher::vpMatch> ref = naiveKnnMatch(train, queries, sizes[s]);
+
+    // Add the train descriptors in two times, from a buffer with a larger stride
+    const unsigned int stride = sizes[s] + 3;
+    std::vector<unsigned char> strided(1500 * stride, 0xff);
+    for (unsigned int t = 0; t < 1500; t++) {
+      std::copy(train.begin() + t * sizes[s], train.begin() + (t + 1) * sizes[s], strided.begin() + t * stride);
+    }
+    vpHammingMatcher matcher;
+    matcher.add(&strided[0], 1000, sizes[s], stride);
+    matcher.add(&strided[1000 * stride], 500, sizes[s], stride);
+    CHECK(matcher.getNbTrainDescriptors() == 1500);
+    CHECK(matcher.getDescriptorSize() == sizes[s]);
+
+    for (int level = vpCPUFeatures::SIMD_NONE; level <= hardwareLevel; level++) {
+      vpCPUFeatures::setSimdLevel(static_cast<vpCPUFeatures::vpSimdLevel>(level));
+      for (int mih = 0; mih < 2; mih++) {
+        matcher.setUseMultiIndexHashing(mih == 1);
+        for (unsigned int nbThreads = 1; nbThreads <= 2; nbThreads++) {
+          matcher.setNbThreads(nbThreads);
+          INFO("size: " << sizes[s] << " ; level: " << vpCPUFeatures::getSimdLevelName(vpCPUFeatures::getSimdLevel())
+                        << " ; multi-index hashing: " << mih << " ; threads: " << nbThreads);
+          std::vector<vpHammingMatcher::vpMatch> matches;
+          matcher.knnMatch(&queries[0], 301, 0, matches);
+          checkKnnMatches(train, queries, sizes[s], ref, matches);
+
+          matcher.match(&queries[0], 301, 0, 0.8, matches);
+          checkRatioMatches(ref, matches, 0.8);
+        }
+      }
+    }
+    vpCPUFeatures::setSimdLevel(hardwareLevel);
+  }
+}
+
+TEST_CASE("Hamming matcher with a large database", "[hamming]")
+{
+  vpUniRand rng(5);
+  const std::vector<unsigned char> train = randomDescriptors(rng, 20000, 32);
+  const std::vector<unsigned char> queries = queryDescriptors(rng, train, 200, 32, 20);
+  const std::vector<vpHammingMatcher::vpMatch> ref = naiveKnnMatch(train, queries, 32);
+
+  vpHammingMatcher matcher;
+  matcher.setUseMultiIndexHashing(true);
+  matcher.add(&train[0], 20000, 32);
+  std::vector<vpHammingMatcher::vpMatch> matches;
+  matcher.knnMatch(&queries[0], 200, 0, matches);
+  checkKnnMatches(train, queries, 32, ref, matches);
+  matcher.match(&queries[0], 200, 0, 0.7, matches);
+  checkRatioMatches(ref, matches, 0.7);
+
+  // The planted queries pass the ratio test
+  CHECK(matches.size() >= 100);
+}
+
+TEST_CASE("Hamming matcher invalid inputs", "[hamming]")
+{
+  std::vector<unsigned char> descriptors(64, 0);
+  vpHammingMatcher matcher;
+  std::vector<vpHammingMatcher::vpMatch> matches(1);
+  matcher.knnMatch(&descriptors[0], 2, 0, matches);
+  CHECK(matches.empty());
+
+  matcher.add(&descriptors[0], 2, 32);
+  CHECK_THROWS_AS(matcher.add(&descriptors[0], 1, 64), vpException);
+  CHECK_THROWS_AS(matcher.add(&descriptors[0], 1, 32, 16), vpException);
+  CHECK_THROWS_AS(matcher.match(&descriptors[0], 1, 0, 0, matches), vpException);
+
+  // Only one train descriptor
+  matcher.clear();
+  CHECK(matcher.getNbTrainDescriptors() == 0);
+  matcher.add(&descriptors[0], 1, 32);
+  matcher.knnMatch(&descriptors[32], 1, 0, matches);
+  REQUIRE(matches.size() == 1);
+  CHECK(matches[0].distance == 0);
+  CHECK(matches[0].secondDistance == UINT_MAX);
+}
+
+TEST_CASE("Benchmark Hamming matcher", "[benchmark]")
+{
+  if (g_runBenchmark) {
+    const vpCPUFeatures::vpSimdLevel hardwareLevel = vpCPUFeatures::getSimdLevel();
+    vpUniRand rng(7);
+    const unsigned int nbQueries = 2000;
+
+    std::cout << std::setw(8) << "bytes" << std::setw(10) << "train" << std::setw(8) << "SIMD" << std::setw(8)
+              << "MIH" << std::setw(10) << "threads" << std::setw(14) << "matches/s" << std::setw(12) << "time (ms)"
+              << std::endl;
+    const unsigned int sizes[] = {32, 64};
+    const unsigned int nbTrains[] = {10000, 100000};
+    for (size_t s = 0; s < 2; s++) {
+      for (size_t n = 0; n < 2; n++) {
+        const std::vector<unsigned char> train = randomDescriptors(rng, nbTrains[n], sizes[s]);
+        const std::vector<unsigned char> queries = queryDescriptors(rng, train, nbQueries, sizes[s], 20);
+        vpHammingMatcher matcher;
+        matcher.add(&train[0], nbTrains[n], sizes[s]);
+
+        for (int level = vpCPUFeatures::SIMD_NONE; level <= hardwareLevel; level++) {
+          vpCPUFeatures::setSimdLevel(static_cast<vpCPUFeatures::vpSimdLevel>(level));
+          for (int mih = 0; mih < 2; mih++) {
+            matcher.setUseMultiIndexHashing(mih == 1);
+            for (unsigned int nbThreads = 1; nbThreads <= 4; nbThreads *= 2) {
+              matcher.setNbThreads(nbThreads);
+              std::vector<vpHammingMatcher::vpMatch> matches;
+              const double t = vpTime::measureTimeMs();
+              matcher.match(&queries[0], nbQueries, 0, 0.8, matches);
+              const double elapsed = vpTime::measureTimeMs() - t;
+
+              std::cout << std::setw(8) << sizes[s] << std::setw(10) << nbTrains[n] << std::setw(8)
+                        << vpCPUFeatures::getSimdLevelName(vpCPUFeatures::getSimdLevel()) << std::setw(8) << mih
+                        << std::setw(10) << nbThreads << std::setw(14)
+                        << static_cast<int>(1000.0 * nbQueries / elapsed) << std::setw(12) << elapsed << std::endl;
+            }
+          }
+        }
+        vpCPUFeatures::setSimdLevel(hardwareLevel);
+      }
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(g_runBenchmark)  // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark?");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,312 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the memory mapped learning database of keypoints.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testKeyPointDatabase.cpp
+
+  Check that a learning database written by vpKeyPointDatabase::save() is read
+  back unchanged, and that the truncated, corrupted or newer files are rejected.
+*/
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpEndian.h>
+
+#if defined(VISP_HAVE_CATCH2) && defined(VISP_LITTLE_ENDIAN)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <fstream>
+#include <limits>
+#include <string.h>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpKeyPointDatabase.h>
+
+namespace
+{
+std::string tempFilename(const std::string &name)
+{
+#if defined(_WIN32)
+  std::string tmp_dir = "C:/temp/";
+#else
+  std::string tmp_dir = "/tmp/";
+#endif
+  tmp_dir += vpIoTools::getUserName();
+  vpIoTools::makeDirectory(tmp_dir);
+  return tmp_dir + "/" + name;
+}
+
+std::vector<unsigned char> readFile(const std::string &filename)
+{
+  std::ifstream file(filename.c_str(), std::ifstream::binary);
+  return std::vector<unsigned char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string &filename, const std::vector<unsigned char> &content)
+{
+  std::ofstream file(filename.c_str(), std::ofstream::binary);
+  file.write(reinterpret_cast<const char *>(&content[0]), static_cast<std::streamsize>(content.size()));
+}
+
+struct vpLearningData {
+  std::vector<vpKeyPointDatabase::vpKeyPointRecord> keyPoints;
+  std::vector<float> points3D;
+  std::vector<unsigned char> descriptors;
+  vpKeyPointDatabase::vpDescriptors header;
+  std::vector<vpKeyPointDatabase::vpTrainingImage> images;
+};
+
+// Descriptors of 32 bytes stored with a stride of 40 bytes, to check that the padding is not saved
+vpLearningData randomLearningData(unsigned int nbKeyPoints)
+{
+  vpUniRand rng(42);
+  vpLearningData data;
+  data.keyPoints.resize(nbKeyPoints);
+  for (unsigned int i = 0; i < nbKeyPoints; i++) {
+    vpKeyPointDatabase::vpKeyPointRecord &kp = data.keyPoints[i];
+    kp.x = static_cast<float>(rng.uniform(0.0, 640.0));
+    kp.y = static_cast<float>(rng.uniform(0.0, 480.0));
+    kp.size = 31.0f;
+    kp.angle = static_cast<float>(rng.uniform(0.0, 360.0));
+    kp.response = static_cast<float>(rng.uniform(0.0, 1.0));
+    kp.octave = static_cast<int>(i % 8);
+    kp.classId = static_cast<int>(i % 3);
+    kp.imageId = static_cast<int>(i % 2);
+  }
+  data.points3D.resize(3 * nbKeyPoints);
+  for (size_t i = 0; i < data.points3D.size(); i++) {
+    data.points3D[i] = static_cast<float>(rng.uniform(-1.0, 1.0));
+  }
+  data.descriptors.resize(40 * nbKeyPoints);
+  for (size_t i = 0; i < data.descriptors.size(); i++) {
+    data.descriptors[i] = static_cast<unsigned char>(rng.next());
+  }
+  data.header.data = data.descriptors.empty() ? NULL : &data.descriptors[0];
+  data.header.rows = nbKeyPoints;
+  data.header.cols = 32;
+  data.header.type = 0;
+  data.header.rowSize = 32;
+  data.header.stride = 40;
+
+  data.images.resize(2);
+  for (size_t i = 0; i < data.images.size(); i++) {
+    data.images[i].imageId = static_cast<int>(i);
+    data.images[i].format = i == 0 ? "png" : "jpg";
+    data.images[i].data.resize(1000 + 77 * i);
+    for (size_t j = 0; j < data.images[i].data.size(); j++) {
+      data.images[i].data[j] = static_cast<unsigned char>(rng.next());
+    }
+  }
+  return data;
+}
+
+void checkLearningData(const vpKeyPointDatabase &database, const vpLearningData &data)
+{
+  REQUIRE(database.isOpen());
+  CHECK(database.getVersion() == vpKeyPointDatabase::VERSION);
+  REQUIRE(database.getNbKeyPoints() == data.keyPoints.size());
+
+  for (unsigned int i = 0; i < database.getNbKeyPoints(); i++) {
+    CHECK(memcmp(&database.getKeyPoints()[i], &data.keyPoints[i], sizeof(vpKeyPointDatabase::vpKeyPointRecord)) == 0);
+  }
+  REQUIRE(database.getPoints3D() != NULL);
+  CHECK(std::equal(data.points3D.begin(), data.points3D.end(), database.getPoints3D()));
+
+  const vpKeyPointDatabase::vpDescriptors descriptors = database.getDescriptors();
+  CHECK(descriptors.rows == data.header.rows);
+  CHECK(descriptors.cols == data.header.cols);
+  CHECK(descriptors.type == data.header.type);
+  CHECK(descriptors.rowSize == data.header.rowSize);
+  // The sections are aligned for SIMD loads
+  CHECK(reinterpret_cast<size_t>(descriptors.data) % 64 == 0);
+  CHECK(reinterpret_cast<size_t>(database.getKeyPoints()) % 64 == 0);
+  for (unsigned int i = 0; i < descriptors.rows; i++) {
+    CHECK(memcmp(descriptors.data + i * descriptors.stride, &data.descriptors[i * data.header.stride],
+                 descriptors.rowSize) == 0);
+  }
+
+  REQUIRE(database.getNbImages() == data.images.size());
+  for (unsigned int i = 0; i < database.getNbImages(); i++) {
+    size_t size = 0;
+    const unsigned char *content = database.getImageData(i, size);
+    CHECK(database.getImageId(i) == data.images[i].imageId);
+    CHECK(database.getImageFormat(i) == data.images[i].format);
+    REQUIRE(size == data.images[i].data.size());
+    CHECK(std::equal(data.images[i].data.begin(), data.images[i].data.end(), content));
+  }
+  CHECK_THROWS_AS(database.getImageId(database.getNbImages()), vpException);
+}
+} // namespace
+
+TEST_CASE("Save and open a learning database", "[vpKeyPointDatabase]")
+{
+  const std::string filename = tempFilename("testKeyPointDatabase.kpdb");
+  const vpLearningData data = randomLearningData(1001);
+  vpKeyPointDatabase::save(filename, data.keyPoints, data.points3D, data.header, data.images);
+  CHECK(vpKeyPointDatabase::isDatabaseFile(filename));
+  CHECK(!vpIoTools::checkFilename(filename + ".tmp"));
+
+  vpKeyPointDatabase database;
+  CHECK(!database.isOpen());
+  CHECK(database.getNbKeyPoints() == 0);
+  database.open(filename);
+  checkLearningData(database, data);
+
+  SECTION("Copies share the mapping")
+  {
+    vpKeyPointDatabase copy(database), assigned;
+    assigned = copy;
+    CHECK(copy.getKeyPoints() == database.getKeyPoints());
+    CHECK(assigned.getDescriptors().data == database.getDescriptors().data);
+
+    database.close();
+    CHECK(!database.isOpen());
+    copy.close();
+    checkLearningData(assigned, data);
+  }
+
+  SECTION("Saving again does not change the open database")
+  {
+    const vpLearningData other = randomLearningData(10);
+    vpKeyPointDatabase::save(filename, other.keyPoints, other.points3D, other.header);
+    checkLearningData(database, data);
+
+    vpKeyPointDatabase reopened;
+    reopened.open(filename);
+    CHECK(reopened.getNbKeyPoints() == 10);
+    CHECK(reopened.getNbImages() == 0);
+  }
+
+  database.close();
+  vpIoTools::remove(filename);
+}
+
+TEST_CASE("Save a learning database without 3D points", "[vpKeyPointDatabase]")
+{
+  const std::string filename = tempFilename("testKeyPointDatabase.kpdb");
+  const vpLearningData data = randomLearningData(0);
+  vpKeyPointDatabase::save(filename, data.keyPoints, std::vector<float>(), data.header);
+
+  vpKeyPointDatabase database;
+  database.open(filename);
+  CHECK(database.getNbKeyPoints() == 0);
+  CHECK(database.getPoints3D() == NULL);
+  CHECK(database.getNbImages() == 0);
+
+  database.close();
+  vpIoTools::remove(filename);
+}
+
+TEST_CASE("Reject invalid learning databases", "[vpKeyPointDatabase]")
+{
+  const std::string filename = tempFilename("testKeyPointDatabase.kpdb");
+  const vpLearningData data = randomLearningData(100);
+  vpKeyPointDatabase database;
+
+  SECTION("Different number of descriptors and keypoints")
+  {
+    vpKeyPointDatabase::vpDescriptors descriptors = data.header;
+    descriptors.rows = 99;
+    CHECK_THROWS_AS(vpKeyPointDatabase::save(filename, data.keyPoints, data.points3D, descriptors), vpException);
+  }
+
+  SECTION("Missing file") { CHECK_THROWS_AS(database.open(filename + ".missing"), vpException); }
+
+  vpKeyPointDatabase::save(filename, data.keyPoints, data.points3D, data.header, data.images);
+  std::vector<unsigned char> content = readFile(filename);
+
+  SECTION("Bad signature")
+  {
+    content[0] = 'X';
+    writeFile(filename, content);
+    CHECK(!vpKeyPointDatabase::isDatabaseFile(filename));
+    CHECK_THROWS_AS(database.open(filename), vpException);
+  }
+
+  SECTION("Truncated file")
+  {
+    content.resize(content.size() - 64);
+    writeFile(filename, content);
+    CHECK_THROWS_AS(database.open(filename), vpException);
+  }
+
+  SECTION("Newer version")
+  {
+    const unsigned int version = vpKeyPointDatabase::VERSION + 1;
+    memcpy(&content[8], &version, sizeof(version));
+    writeFile(filename, content);
+    CHECK_THROWS_AS(database.open(filename), vpException);
+  }
+
+  SECTION("Descriptors size that wraps around")
+  {
+    // 99 * stride + 32 overflows to a few bytes, that would fit in the file
+    const unsigned long long stride = std::numeric_limits<unsigned long long>::max() / 99 + 1;
+    memcpy(&content[40], &stride, sizeof(stride));
+    writeFile(filename, content);
+    CHECK_THROWS_AS(database.open(filename), vpException);
+  }
+
+  SECTION("Section outside of the file")
+  {
+    const unsigned long long offset = content.size();
+    memcpy(&content[72], &offset, sizeof(offset));
+    writeFile(filename, content);
+    CHECK_THROWS_AS(database.open(filename), vpException);
+  }
+
+  CHECK(!database.isOpen());
+  vpIoTools::remove(filename);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
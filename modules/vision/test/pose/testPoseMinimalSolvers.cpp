@@ -0,0 +1,305 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the P3P and EPnP pose estimation methods.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testPoseMinimalSolvers.cpp
+
+  Test the P3P and EPnP pose estimation methods, alone and as the minimal
+  solver of the RANSAC. With --benchmark, compare their cost with the
+  Lagrange and Dementhon approaches.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpGaussRand.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpPose.h>
+
+namespace
+{
+static bool g_runBenchmark = false;
+
+vpHomogeneousMatrix randomPose(vpUniRand &rng)
+{
+  return vpHomogeneousMatrix(rng.uniform(-0.1, 0.1), rng.uniform(-0.1, 0.1), rng.uniform(0.5, 1.5),
+                             vpMath::rad(rng.uniform(-30.0, 30.0)), vpMath::rad(rng.uniform(-30.0, 30.0)),
+                             vpMath::rad(rng.uniform(-180.0, 180.0)));
+}
+
+std::vector<vpPoint> randomPoints(vpUniRand &rng, const vpHomogeneousMatrix &cMo, unsigned int n, bool planar)
+{
+  std::vector<vpPoint> points;
+  for (unsigned int i = 0; i < n; i++) {
+    vpPoint pt(rng.uniform(-0.2, 0.2), rng.uniform(-0.2, 0.2), planar ? 0.0 : rng.uniform(-0.2, 0.2));
+    pt.project(cMo);
+    points.push_back(pt);
+  }
+  return points;
+}
+
+void checkPose(const vpHomogeneousMatrix &cMo_ref, const vpHomogeneousMatrix &cMo, double tolerance)
+{
+  const vpHomogeneousMatrix cdMc = cMo_ref * cMo.inverse();
+  CHECK(cdMc.getTranslationVector().frobeniusNorm() < tolerance);
+  CHECK(vpThetaUVector(cdMc.getRotationMatrix()).getTheta() < tolerance);
+}
+
+// Points in front of the camera, 30% of them with a random image location
+std::vector<vpPoint> pointsWithOutliers(const vpHomogeneousMatrix &cMo_ref, unsigned int nbPoints)
+{
+  vpUniRand rng(42);
+  std::vector<vpPoint> points;
+  for (unsigned int i = 0; i < nbPoints; i++) {
+    vpPoint pt(rng.uniform(-0.1, 0.1), rng.uniform(-0.1, 0.1), rng.uniform(-0.05, 0.05));
+    pt.project(cMo_ref);
+    if (i % 10 < 3) {
+      pt.set_x(rng.uniform(-0.3, 0.3));
+      pt.set_y(rng.uniform(-0.3, 0.3));
+    }
+    points.push_back(pt);
+  }
+  return points;
+}
+} // namespace
+
+TEST_CASE("P3P and EPnP without noise", "[pose]")
+{
+  vpUniRand rng(1234);
+  const unsigned int sizes[] = {4, 5, 10, 100};
+  for (int planar = 0; planar < 2; planar++) {
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+      for (int trial = 0; trial < 50; trial++) {
+        const vpHomogeneousMatrix cMo_ref = randomPose(rng);
+        vpPose pose(randomPoints(rng, cMo_ref, sizes[s], planar == 1));
+
+        INFO("planar: " << planar << " ; points: " << sizes[s] << " ; trial: " << trial);
+        vpHomogeneousMatrix cMo;
+        REQUIRE(pose.computePose(vpPose::P3P, cMo));
+        checkPose(cMo_ref, cMo, 1e-6);
+
+        // With 4 non coplanar points, EPnP may end in a local minimum
+        if (planar == 1 || sizes[s] > 4) {
+          REQUIRE(pose.computePose(vpPose::EPNP, cMo));
+          checkPose(cMo_ref, cMo, 1e-6);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("EPnP with noise", "[pose]")
+{
+  vpUniRand rng(4321);
+  vpGaussRand noise(1e-3, 0, 4321);
+  for (int planar = 0; planar < 2; planar++) {
+    for (int trial = 0; trial < 20; trial++) {
+      const vpHomogeneousMatrix cMo_ref = randomPose(rng);
+      std::vector<vpPoint> points = randomPoints(rng, cMo_ref, 100, planar == 1);
+      for (size_t i = 0; i < points.size(); i++) {
+        points[i].set_x(points[i].get_x() + noise());
+        points[i].set_y(points[i].get_y() + noise());
+      }
+      vpPose pose(points);
+
+      INFO("planar: " << planar << " ; trial: " << trial);
+      vpHomogeneousMatrix cMo_epnp, cMo_vvs;
+      REQUIRE(pose.computePose(vpPose::EPNP, cMo_epnp));
+      REQUIRE(pose.computePose(vpPose::DEMENTHON_VIRTUAL_VS, cMo_vvs));
+
+      // EPnP is close to the minimum of the reprojection error
+      CHECK(pose.computeResidual(cMo_epnp) < 1.1 * pose.computeResidual(cMo_vvs));
+
+      // And it is a good initialization for the virtual visual servoing
+      pose.computePose(vpPose::VIRTUAL_VS, cMo_epnp);
+      checkPose(cMo_vvs, cMo_epnp, 1e-5);
+    }
+  }
+}
+
+TEST_CASE("P3P with collinear points", "[pose]")
+{
+  const vpHomogeneousMatrix cMo_ref(0, 0, 1, 0, 0, 0);
+  vpPose pose;
+  for (int i = 0; i < 4; i++) {
+    vpPoint pt(0.1 * i, 0.05 * i, 0);
+    pt.project(cMo_ref);
+    pose.addPoint(pt);
+  }
+
+  vpHomogeneousMatrix cMo;
+  CHECK_THROWS_AS(pose.computePose(vpPose::P3P, cMo), vpException);
+  CHECK_THROWS_AS(pose.computePose(vpPose::EPNP, cMo), vpException);
+}
+
+TEST_CASE("P3P with 3 points", "[pose]")
+{
+  vpUniRand rng(2468);
+  for (int trial = 0; trial < 20; trial++) {
+    const vpHomogeneousMatrix cMo_ref = randomPose(rng);
+    vpPose pose(randomPoints(rng, cMo_ref, 3, false));
+
+    // One of the up to four poses that fit the points
+    INFO("trial: " << trial);
+    vpHomogeneousMatrix cMo;
+    REQUIRE(pose.computePose(vpPose::P3P, cMo));
+    CHECK(pose.computeResidual(cMo) < 1e-12);
+    CHECK_THROWS_AS(pose.computePose(vpPose::EPNP, cMo), vpException);
+  }
+}
+
+TEST_CASE("RANSAC with P3P samples", "[pose]")
+{
+  const vpHomogeneousMatrix cMo_ref(0.05, -0.02, 0.6, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(5));
+  const unsigned int nbPoints = 2000;
+  const std::vector<vpPoint> points = pointsWithOutliers(cMo_ref, nbPoints);
+
+  for (int parallel = 0; parallel < 2; parallel++) {
+    vpPose pose(points);
+    pose.setRansacMinimalSolver(vpPose::RANSAC_P3P);
+    pose.setRansacThreshold(0.001);
+    pose.setRansacMaxTrials(1000);
+    pose.setRansacNbInliersToReachConsensus(nbPoints);
+    pose.setRansacProbability(0.99);
+    pose.setUseParallelRansac(parallel == 1);
+    pose.setNbParallelRansacThreads(4);
+
+    vpHomogeneousMatrix cMo;
+    REQUIRE(pose.computePose(vpPose::RANSAC, cMo));
+    CHECK(pose.getRansacNbInliers() >= nbPoints / 2);
+    CHECK(pose.getRansacNbInliers() <= 7 * nbPoints / 10);
+    checkPose(cMo_ref, cMo, 1e-6);
+
+    const std::vector<unsigned int> inlierIndex = pose.getRansacInlierIndex();
+    for (size_t i = 0; i < inlierIndex.size(); i++) {
+      CHECK(inlierIndex[i] % 10 >= 3);
+    }
+  }
+}
+
+TEST_CASE("Benchmark minimal solvers", "[benchmark]")
+{
+  if (g_runBenchmark) {
+    vpUniRand rng(1);
+    const vpHomogeneousMatrix cMo_ref = randomPose(rng);
+    vpPose pose4(randomPoints(rng, cMo_ref, 4, false));
+    vpPose pose100(randomPoints(rng, cMo_ref, 100, false));
+    vpHomogeneousMatrix cMo;
+
+    // The RANSAC tries both Lagrange and Dementhon, Lagrange needs 6 non coplanar points
+    BENCHMARK("Dementhon, 4 points")
+    {
+      pose4.computePose(vpPose::DEMENTHON, cMo);
+      return cMo;
+    };
+
+    BENCHMARK("P3P, 4 points")
+    {
+      pose4.computePose(vpPose::P3P, cMo);
+      return cMo;
+    };
+
+    BENCHMARK("Dementhon, 100 points")
+    {
+      pose100.computePose(vpPose::DEMENTHON, cMo);
+      return cMo;
+    };
+
+    BENCHMARK("EPnP, 100 points")
+    {
+      pose100.computePose(vpPose::EPNP, cMo);
+      return cMo;
+    };
+
+    const vpHomogeneousMatrix cMo_ransac(0.05, -0.02, 0.6, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(5));
+    const std::vector<vpPoint> points = pointsWithOutliers(cMo_ransac, 2000);
+    const vpPose::RANSAC_MINIMAL_SOLVER solvers[] = {vpPose::RANSAC_LAGRANGE_DEMENTHON, vpPose::RANSAC_P3P};
+    const std::string names[] = {"RANSAC Lagrange and Dementhon, 2000 points", "RANSAC P3P, 2000 points"};
+    for (int s = 0; s < 2; s++) {
+      vpPose pose(points);
+      pose.setRansacMinimalSolver(solvers[s]);
+      pose.setRansacThreshold(0.001);
+      pose.setRansacMaxTrials(1000);
+      pose.setRansacNbInliersToReachConsensus(2000);
+      pose.setRansacProbability(0.99);
+
+      BENCHMARK(names[s].c_str())
+      {
+        pose.computePose(vpPose::RANSAC, cMo);
+        return cMo;
+      };
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(g_runBenchmark)  // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark?");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -47,6 +47,7 @@
 #include <visp3/core/vpIoTools.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpPoint.h>
+#include <visp3/core/vpUniRand.h>
 #include <visp3/vision/vpPose.h>
 
 namespace
@@ -508,6 +509,50 @@ TEST_CASE("Print RANSAC number of iterations", "[ransac_pose]") {
   std::cout << std::endl;
 }
 
+TEST_CASE("Parallel RANSAC with early termination", "[ransac_pose]") {
+  // Points in front of the camera, 30% of them with a random image location
+  const vpHomogeneousMatrix cMo_ref(0.05, -0.02, 0.6, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(5));
+  vpUniRand rng(42);
+  std::vector<vpPoint> points;
+  const unsigned int nbPoints = 2000;
+  for (unsigned int i = 0; i < nbPoints; i++) {
+    vpPoint pt(rng.uniform(-0.1, 0.1), rng.uniform(-0.1, 0.1), rng.uniform(-0.05, 0.05));
+    pt.project(cMo_ref);
+    if (i % 10 < 3) {
+      pt.set_x(rng.uniform(-0.3, 0.3));
+      pt.set_y(rng.uniform(-0.3, 0.3));
+    }
+    points.push_back(pt);
+  }
+
+  for (int parallel = 0; parallel < 2; parallel++) {
+    for (int adaptive = 0; adaptive < 2; adaptive++) {
+      vpPose pose(points);
+      pose.setRansacThreshold(0.001);
+      pose.setRansacMaxTrials(1000);
+      pose.setUseParallelRansac(parallel == 1);
+      pose.setNbParallelRansacThreads(4);
+      // The consensus can not be reached without the reduction of the number of trials
+      pose.setRansacNbInliersToReachConsensus(adaptive == 1 ? nbPoints : nbPoints / 2);
+      pose.setRansacProbability(adaptive == 1 ? 0.99 : 0);
+
+      vpHomogeneousMatrix cMo;
+      REQUIRE(pose.computePose(vpPose::RANSAC, cMo));
+      CHECK(pose.getRansacNbInliers() >= nbPoints / 2);
+      CHECK(pose.getRansacNbInliers() <= 7 * nbPoints / 10);
+
+      const vpHomogeneousMatrix cdMc = cMo_ref * cMo.inverse();
+      CHECK(cdMc.getTranslationVector().frobeniusNorm() < 1e-6);
+      CHECK(vpThetaUVector(cdMc.getRotationMatrix()).getTheta() < 1e-6);
+
+      const std::vector<unsigned int> inlierIndex = pose.getRansacInlierIndex();
+      for (size_t i = 0; i < inlierIndex.size(); i++) {
+        CHECK(inlierIndex[i] % 10 >= 3);
+      }
+    }
+  }
+}
+
 TEST_CASE("RANSAC pose estimation tests", "[ransac_pose]") {
   const std::vector<size_t> model_sizes = {10, 20, 50, 100, 200, 500, 1000, 0, 0};
   const std::vector<bool> duplicates = {false, false, false, false, false, false, false, false, true};